@@ -0,0 +1,281 @@
+#!/usr/bin/env python3
+"""
+klog_decode.py [LOG]
+
+Expand HimuOS binary klog records (HO_ENABLE_BINARY_LOG=1) in a serial
+capture back into text. Each binary record arrives as one line
+
+  @KLOG <hex of KE_KLOG_BINARY_HEADER + arguments>
+
+and its FormatId indexes the KE_KLOG_FORMAT descriptors in the .klog_fmt
+section of the kernel ELF, whose Format pointers are resolved against the
+loaded sections of the same file. Every other line (text records, and the
+WARNING-and-above lines of the mixed mode) is passed through unchanged, so
+the output reads like a text-mode serial log. The kernel must be the exact
+build that produced the capture.
+
+Usage:
+  python scripts/klog_decode.py /tmp/qemu_output.log
+  python scripts/klog_decode.py --kernel build/kernel/bin/kernel.bin < serial.log
+"""
+
+from __future__ import annotations
+
+import argparse
+import pathlib
+import struct
+import sys
+from dataclasses import dataclass
+from typing import Dict, List, Optional, TextIO, Tuple
+
+
+DEFAULT_KERNEL = "build/kernel/bin/kernel.bin"
+BINARY_TAG = "@KLOG "
+FORMAT_SECTION = ".klog_fmt"
+FORMAT_DESCRIPTOR = struct.Struct("<IIQ")  # KE_KLOG_FORMAT
+RECORD_HEADER = struct.Struct("<IIQ")  # KE_KLOG_BINARY_HEADER
+NO_TIME = 0xFFFFFFFFFFFFFFFF
+ARGS_CUT = 1 << 0
+LEVEL_PREFIX = {0: "[DBG] ", 1: "[INF] ", 2: "[WRN] ", 3: "[ERR] "}
+
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+
+@dataclass
+class Section:
+    name: str
+    addr: int
+    offset: int
+    size: int
+    loaded: bool
+
+
+class KernelImage:
+    def __init__(self, path: pathlib.Path):
+        self.data = path.read_bytes()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 2 or self.data[5] != 1:
+            raise ValueError(f"{path}: not a little-endian ELF64 image")
+        self.sections = self._read_sections()
+        self.formats = self._read_formats()
+
+    def _read_sections(self) -> List[Section]:
+        shoff, = struct.unpack_from("<Q", self.data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x3A)
+        raw = []
+        for index in range(shnum):
+            name, kind, flags, addr, offset, size = struct.unpack_from("<IIQQQQ", self.data, shoff + index * shentsize)
+            raw.append((name, kind, flags, addr, offset, size))
+        strtab_offset = raw[shstrndx][4]
+        sections = []
+        for name, kind, flags, addr, offset, size in raw:
+            sections.append(
+                Section(
+                    name=self._cstring(strtab_offset + name),
+                    addr=addr,
+                    offset=offset,
+                    size=size,
+                    loaded=bool(flags & SHF_ALLOC) and kind != SHT_NOBITS,
+                )
+            )
+        return sections
+
+    def _cstring(self, offset: int) -> str:
+        end = self.data.index(b"\0", offset)
+        return self.data[offset:end].decode("utf-8", errors="replace")
+
+    def _string_at(self, va: int) -> Optional[str]:
+        for section in self.sections:
+            if section.loaded and section.addr <= va < section.addr + section.size:
+                return self._cstring(section.offset + va - section.addr)
+        return None
+
+    def _read_formats(self) -> List[Tuple[int, str]]:
+        section = next((s for s in self.sections if s.name == FORMAT_SECTION), None)
+        if section is None:
+            raise ValueError(f"kernel image has no {FORMAT_SECTION} section")
+        formats = []
+        for offset in range(0, section.size - FORMAT_DESCRIPTOR.size + 1, FORMAT_DESCRIPTOR.size):
+            level, _, format_va = FORMAT_DESCRIPTOR.unpack_from(self.data, section.offset + offset)
+            text = self._string_at(format_va)
+            formats.append((level, text if text is not None else f"<format @ 0x{format_va:x} not in image>\n"))
+        return formats
+
+
+class ArgReader:
+    def __init__(self, payload: bytes):
+        self.payload = payload
+        self.offset = 0
+
+    def value(self) -> Optional[int]:
+        if self.offset + 8 > len(self.payload):
+            return None
+        value, = struct.unpack_from("<Q", self.payload, self.offset)
+        self.offset += 8
+        return value
+
+    def string(self) -> Optional[str]:
+        if self.offset + 2 > len(self.payload):
+            return None
+        length, = struct.unpack_from("<H", self.payload, self.offset)
+        start = self.offset + 2
+        self.offset = start + length
+        return self.payload[start:self.offset].decode("utf-8", errors="replace")
+
+
+def pad(text: str, width: int, pad_char: str, left_align: bool) -> str:
+    if len(text) >= width:
+        return text
+    if left_align:
+        return text + " " * (width - len(text))
+    return pad_char * (width - len(text)) + text
+
+
+def signed(value: int, bits: int) -> int:
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >> (bits - 1) else value
+
+
+def format_number(value: int, width: int, pad_char: str, left_align: bool) -> str:
+    # Int64ToStringEx pads the magnitude and puts the sign in front of the padding.
+    if left_align or value >= 0:
+        return pad(str(value), width, pad_char, left_align)
+    return "-" + pad(str(-value), width - 1, pad_char, False)
+
+
+def render(fmt: str, args: ArgReader) -> str:
+    """Mirror ConsoleWriteVFmtInternal for the conversions klog accepts."""
+    out: List[str] = []
+    index = 0
+    while index < len(fmt):
+        char = fmt[index]
+        index += 1
+        if char != "%":
+            out.append(char)
+            continue
+        if index < len(fmt) and fmt[index] == "%":
+            out.append("%")
+            index += 1
+            continue
+
+        left_align = index < len(fmt) and fmt[index] == "-"
+        index += 1 if left_align else 0
+        pad_char = ""
+        if index < len(fmt) and fmt[index] == "0":
+            pad_char = "" if left_align else "0"
+            index += 1
+        width = 0
+        while index < len(fmt) and fmt[index].isdigit():
+            width = width * 10 + int(fmt[index])
+            index += 1
+        if width > 0 and not pad_char:
+            pad_char = " "
+
+        conversion = fmt[index:index + 2]
+        if conversion[:1] in ("l", "k"):
+            index += 2
+        else:
+            conversion = conversion[:1]
+            index += 1
+
+        if conversion in ("s", "ke"):
+            text = args.string()
+        else:
+            value = args.value()
+            text = None if value is None else ""
+        if text is None:
+            out.append("<?>")
+            continue
+
+        if conversion == "s":
+            out.append(pad(text, width, pad_char, left_align))
+        elif conversion == "ke":
+            out.append(text)
+        elif conversion == "ks":
+            out.append("OK" if value == 0 else "FAILED")
+        elif conversion == "c":
+            out.append(chr(value & 0xFF))
+        elif conversion in ("d", "i"):
+            out.append(format_number(signed(value, 32), width, pad_char, left_align))
+        elif conversion in ("ld", "li"):
+            out.append(format_number(signed(value, 64), width, pad_char, left_align))
+        elif conversion == "u":
+            out.append(pad(str(value & 0xFFFFFFFF), width, pad_char, left_align))
+        elif conversion == "lu":
+            out.append(pad(str(value), width, pad_char, left_align))
+        elif conversion in ("x", "X", "lx", "lX"):
+            out.append(pad(f"{value:X}", width, pad_char, left_align))
+        elif conversion == "p":
+            out.append(f"0X{value:016X}")
+        else:
+            out.append(f"<%{conversion}?>")
+    return "".join(out)
+
+
+def decode_record(image: KernelImage, hex_text: str) -> str:
+    try:
+        payload = bytes.fromhex(hex_text.strip())
+    except ValueError:
+        return f"[klog_decode] malformed record: {hex_text.strip()}\n"
+    if len(payload) < RECORD_HEADER.size:
+        return f"[klog_decode] short record: {hex_text.strip()}\n"
+
+    format_id, flags, timestamp_us = RECORD_HEADER.unpack_from(payload)
+    if format_id >= len(image.formats):
+        return f"[klog_decode] unknown format id {format_id} (kernel image mismatch?)\n"
+
+    level, fmt = image.formats[format_id]
+    if timestamp_us == NO_TIME:
+        stamp = "[+----.------] "
+    else:
+        stamp = f"[+{timestamp_us // 1000000:04d}.{timestamp_us % 1000000:06d}] "
+    text = render(fmt, ArgReader(payload[RECORD_HEADER.size:]))
+    if flags & ARGS_CUT:
+        text = text.rstrip("\n") + " <args cut>\n"
+    return LEVEL_PREFIX.get(level, "[UNK] ") + stamp + text
+
+
+def decode_stream(image: KernelImage, source: TextIO, sink: TextIO) -> Dict[str, int]:
+    counts = {"binary": 0, "text": 0}
+    for line in source:
+        position = line.find(BINARY_TAG)
+        if position < 0:
+            sink.write(line)
+            counts["text"] += 1
+            continue
+        sink.write(line[:position])
+        sink.write(decode_record(image, line[position + len(BINARY_TAG):]))
+        counts["binary"] += 1
+    return counts
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Decode HimuOS binary klog records")
+    parser.add_argument("log", nargs="?", help="Serial capture (default: stdin)")
+    parser.add_argument("--kernel", default=DEFAULT_KERNEL, help="Kernel ELF that produced the capture")
+    parser.add_argument("--stats", action="store_true", help="Print record counts to stderr")
+    return parser.parse_args()
+
+
+def main() -> int:
+    args = parse_args()
+    try:
+        image = KernelImage(pathlib.Path(args.kernel))
+    except (OSError, ValueError) as exc:
+        print(f"klog_decode: {exc}", file=sys.stderr)
+        return 1
+
+    if args.log:
+        with open(args.log, "r", encoding="utf-8", errors="replace", newline="") as source:
+            counts = decode_stream(image, source, sys.stdout)
+    else:
+        counts = decode_stream(image, sys.stdin, sys.stdout)
+
+    if args.stats:
+        print(f"klog_decode: {counts['binary']} binary, {counts['text']} text lines, "
+              f"{len(image.formats)} formats", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,385 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: scripts/libc_string_host.c
+ * Description: Host-side equivalence fuzz test and microbenchmark for the
+ *              kernel libc strlen, strcmp and memcmp and for CountDecDigit.
+ *              libc_string_host.sh builds the kernel sources twice, once on
+ *              general registers (the SWAR paths the kernel runs) and once with
+ *              SSE2 (the paths the EFI loader runs), and links both here under
+ *              renamed symbols. Every string and buffer ends flush against a
+ *              PROT_NONE guard page, so an over-read faults instead of passing.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#define HOST_MAX_LENGTH   300U
+#define HOST_BENCH_BUDGET (64U * 1024U * 1024U) // Bytes scanned per timing sample
+
+typedef size_t (*HOST_STRLEN)(const char *);
+typedef int (*HOST_STRCMP)(const char *, const char *);
+typedef int (*HOST_MEMCMP)(const void *, const void *, size_t);
+
+size_t HoSwarStrlen(const char *str);
+int HoSwarStrcmp(const char *a, const char *b);
+int HoSwarMemcmp(const void *s1, const void *s2, size_t n);
+size_t HoSse2Strlen(const char *str);
+int HoSse2Strcmp(const char *a, const char *b);
+int HoSse2Memcmp(const void *s1, const void *s2, size_t n);
+uint8_t CountDecDigit(uint64_t n);
+
+typedef struct HOST_VARIANT
+{
+    const char *Name;
+    HOST_STRLEN Strlen;
+    HOST_STRCMP Strcmp;
+    HOST_MEMCMP Memcmp;
+} HOST_VARIANT;
+
+typedef struct HOST_PAGE
+{
+    char *Base; // One read-write page; the next page is PROT_NONE
+    size_t Size;
+} HOST_PAGE;
+
+static const HOST_VARIANT gVariants[] = {
+    {"swar", HoSwarStrlen, HoSwarStrcmp, HoSwarMemcmp},
+    {"sse2", HoSse2Strlen, HoSse2Strcmp, HoSse2Memcmp},
+};
+
+static uint64_t gSeed = 0x9E3779B97F4A7C15ULL;
+static unsigned long gFailures;
+static volatile uint64_t gSink;
+
+static uint64_t
+HostRandom(void)
+{
+    gSeed ^= gSeed << 13;
+    gSeed ^= gSeed >> 7;
+    gSeed ^= gSeed << 17;
+    return gSeed;
+}
+
+static int
+HostSign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+// Bytewise references, kept out of line so the benchmark times the loop and not a folded call.
+__attribute__((noinline)) static size_t
+HostByteStrlen(const char *str)
+{
+    const char *s = str;
+    while (*s)
+        s++;
+    return (size_t)(s - str);
+}
+
+__attribute__((noinline)) static int
+HostByteStrcmp(const char *a, const char *b)
+{
+    while (*a && *a == *b)
+    {
+        a++;
+        b++;
+    }
+    return (unsigned char)*a - (unsigned char)*b;
+}
+
+__attribute__((noinline)) static int
+HostByteMemcmp(const void *s1, const void *s2, size_t n)
+{
+    const unsigned char *p1 = s1;
+    const unsigned char *p2 = s2;
+
+    for (; n != 0; --n, ++p1, ++p2)
+    {
+        if (*p1 != *p2)
+            return *p1 - *p2;
+    }
+    return 0;
+}
+
+static uint8_t
+HostCountDecDigit(uint64_t n)
+{
+    uint8_t digits = 1;
+    while (n >= 10)
+    {
+        n /= 10;
+        digits++;
+    }
+    return digits;
+}
+
+static void
+HostMapPage(HOST_PAGE *page, size_t size)
+{
+    long pageSize = sysconf(_SC_PAGESIZE);
+    size = (size + (size_t)pageSize - 1U) & ~((size_t)pageSize - 1U);
+
+    char *base = mmap(NULL, size + (size_t)pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        perror("mmap");
+        exit(2);
+    }
+    if (mprotect(base + size, (size_t)pageSize, PROT_NONE) != 0)
+    {
+        perror("mprotect");
+        exit(2);
+    }
+    page->Base = base;
+    page->Size = size;
+}
+
+// Random bytes ending flush against the guard page, or a little short of it on
+// every third call so the start alignment and the page-end distance both vary.
+static char *
+HostPlace(const HOST_PAGE *page, size_t length, const char *prefix, size_t prefixLength, int terminate)
+{
+    size_t slack = HostRandom() % 3U == 0 ? (size_t)(HostRandom() % 64U) : 0;
+    size_t total = length + (terminate ? 1U : 0U);
+    char *str = page->Base + page->Size - total - slack;
+
+    for (size_t index = 0; index < length; ++index)
+        str[index] = index < prefixLength ? prefix[index] : (char)(1U + HostRandom() % 255U);
+    if (terminate)
+        str[length] = '\0';
+    return str;
+}
+
+static void
+HostFail(const char *variant, const char *routine, size_t length, long expected, long actual)
+{
+    if (gFailures++ < 16U)
+    {
+        fprintf(stderr, "FAIL %s %s length=%zu expected=%ld actual=%ld (seed to reproduce printed above)\n",
+                variant, routine, length, expected, actual);
+    }
+}
+
+static void
+HostFuzzStrings(const HOST_PAGE pages[2], unsigned long rounds)
+{
+    for (unsigned long round = 0; round < rounds; ++round)
+    {
+        size_t length = (size_t)(HostRandom() % (HOST_MAX_LENGTH + 1U));
+        const char *a = HostPlace(&pages[0], length, NULL, 0, 1);
+
+        // b shares a random prefix of a and then either ends, differs, or matches to the end.
+        size_t shared = length == 0 ? 0 : (size_t)(HostRandom() % (length + 1U));
+        size_t lengthB = HostRandom() % 4U == 0 ? length : shared + (size_t)(HostRandom() % 32U);
+        if (lengthB < shared)
+            lengthB = shared;
+        const char *b = HostPlace(&pages[1], lengthB, a, lengthB == length ? length : shared, 1);
+
+        size_t expectedLength = HostByteStrlen(a);
+        int expectedCompare = HostSign(HostByteStrcmp(a, b));
+
+        for (size_t index = 0; index < sizeof(gVariants) / sizeof(gVariants[0]); ++index)
+        {
+            const HOST_VARIANT *variant = &gVariants[index];
+            size_t actualLength = variant->Strlen(a);
+            if (actualLength != expectedLength)
+                HostFail(variant->Name, "strlen", length, (long)expectedLength, (long)actualLength);
+
+            int actualCompare = HostSign(variant->Strcmp(a, b));
+            if (actualCompare != expectedCompare)
+                HostFail(variant->Name, "strcmp", length, expectedCompare, actualCompare);
+            actualCompare = HostSign(variant->Strcmp(b, a));
+            if (actualCompare != -expectedCompare)
+                HostFail(variant->Name, "strcmp(swapped)", length, -expectedCompare, actualCompare);
+        }
+
+        // The buffers reuse the pages, so they are placed only once the strings are done. Copying all n bytes
+        // covers the equal case; a shorter shared prefix diverges at a random offset.
+        size_t n = (size_t)(HostRandom() % (HOST_MAX_LENGTH + 1U));
+        const char *m1 = HostPlace(&pages[0], n, NULL, 0, 0);
+        size_t same = HostRandom() % 2U == 0 ? n : (size_t)(HostRandom() % (n + 1U));
+        const char *m2 = HostPlace(&pages[1], n, m1, same, 0);
+        int expectedMemcmp = HostSign(HostByteMemcmp(m1, m2, n));
+
+        for (size_t index = 0; index < sizeof(gVariants) / sizeof(gVariants[0]); ++index)
+        {
+            const HOST_VARIANT *variant = &gVariants[index];
+            int actualMemcmp = HostSign(variant->Memcmp(m1, m2, n));
+            if (actualMemcmp != expectedMemcmp)
+                HostFail(variant->Name, "memcmp", n, expectedMemcmp, actualMemcmp);
+        }
+    }
+}
+
+static void
+HostFuzzDigits(unsigned long rounds)
+{
+    uint64_t power = 1;
+    for (int exponent = 0; exponent < 20; ++exponent)
+    {
+        uint64_t probes[3] = {power - 1U, power, power + 1U};
+        for (int index = 0; index < 3; ++index)
+        {
+            if (CountDecDigit(probes[index]) != HostCountDecDigit(probes[index]))
+                HostFail("host", "CountDecDigit", (size_t)probes[index], HostCountDecDigit(probes[index]),
+                         CountDecDigit(probes[index]));
+        }
+        if (exponent < 19)
+            power *= 10U;
+    }
+
+    for (unsigned long round = 0; round < rounds; ++round)
+    {
+        // Uniform bit length first, so short numbers are as common as long ones.
+        uint64_t value = HostRandom() >> (HostRandom() % 64U);
+        if (CountDecDigit(value) != HostCountDecDigit(value))
+            HostFail("host", "CountDecDigit", (size_t)value, HostCountDecDigit(value), CountDecDigit(value));
+    }
+    if (CountDecDigit(UINT64_MAX) != 20U)
+        HostFail("host", "CountDecDigit", 0, 20, CountDecDigit(UINT64_MAX));
+}
+
+static uint64_t
+HostNowNs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static void
+HostReport(const char *routine, const char *variant, size_t length, uint64_t calls, uint64_t elapsedNs,
+           uint64_t baselineNs)
+{
+    if (elapsedNs == 0)
+        elapsedNs = 1;
+    printf("%-7s %-5s len=%-5zu ns/call=%-8.2f MB/s=%-7lu x%.2f\n", routine, variant, length,
+           (double)elapsedNs / (double)calls, (unsigned long)(length * calls * 1000ULL / elapsedNs),
+           (double)baselineNs / (double)elapsedNs);
+}
+
+static void
+HostBench(const HOST_PAGE pages[2])
+{
+    static const size_t lengths[] = {7, 16, 64, 256, 1024, 3000};
+
+    for (size_t lengthIndex = 0; lengthIndex < sizeof(lengths) / sizeof(lengths[0]); ++lengthIndex)
+    {
+        size_t length = lengths[lengthIndex];
+        uint64_t calls = HOST_BENCH_BUDGET / (length + 1U);
+        char *a = pages[0].Base + pages[0].Size - length - 1U;
+        char *b = pages[1].Base + pages[1].Size - length - 1U;
+        memset(a, 'x', length);
+        memset(b, 'x', length);
+        a[length] = b[length] = '\0';
+
+        uint64_t start = HostNowNs();
+        for (uint64_t call = 0; call < calls; ++call)
+            gSink += HostByteStrlen(a);
+        uint64_t baselineNs = HostNowNs() - start;
+        HostReport("strlen", "byte", length, calls, baselineNs, baselineNs);
+        for (size_t index = 0; index < sizeof(gVariants) / sizeof(gVariants[0]); ++index)
+        {
+            start = HostNowNs();
+            for (uint64_t call = 0; call < calls; ++call)
+                gSink += gVariants[index].Strlen(a);
+            HostReport("strlen", gVariants[index].Name, length, calls, HostNowNs() - start, baselineNs);
+        }
+
+        start = HostNowNs();
+        for (uint64_t call = 0; call < calls; ++call)
+            gSink += (uint64_t)HostByteStrcmp(a, b);
+        baselineNs = HostNowNs() - start;
+        HostReport("strcmp", "byte", length, calls, baselineNs, baselineNs);
+        for (size_t index = 0; index < sizeof(gVariants) / sizeof(gVariants[0]); ++index)
+        {
+            start = HostNowNs();
+            for (uint64_t call = 0; call < calls; ++call)
+                gSink += (uint64_t)gVariants[index].Strcmp(a, b);
+            HostReport("strcmp", gVariants[index].Name, length, calls, HostNowNs() - start, baselineNs);
+        }
+
+        start = HostNowNs();
+        for (uint64_t call = 0; call < calls; ++call)
+            gSink += (uint64_t)HostByteMemcmp(a, b, length);
+        baselineNs = HostNowNs() - start;
+        HostReport("memcmp", "byte", length, calls, baselineNs, baselineNs);
+        for (size_t index = 0; index < sizeof(gVariants) / sizeof(gVariants[0]); ++index)
+        {
+            start = HostNowNs();
+            for (uint64_t call = 0; call < calls; ++call)
+                gSink += (uint64_t)gVariants[index].Memcmp(a, b, length);
+            HostReport("memcmp", gVariants[index].Name, length, calls, HostNowNs() - start, baselineNs);
+        }
+    }
+
+    uint64_t calls = HOST_BENCH_BUDGET / 8U;
+    uint64_t start = HostNowNs();
+    for (uint64_t call = 0; call < calls; ++call)
+        gSink += HostCountDecDigit(HostRandom());
+    uint64_t baselineNs = HostNowNs() - start;
+    start = HostNowNs();
+    for (uint64_t call = 0; call < calls; ++call)
+        gSink += CountDecDigit(HostRandom());
+    uint64_t elapsedNs = HostNowNs() - start;
+    printf("digits  loop  ns/call=%-8.2f\ndigits  est   ns/call=%-8.2f x%.2f\n", (double)baselineNs / (double)calls,
+           (double)elapsedNs / (double)calls, (double)baselineNs / (double)(elapsedNs != 0 ? elapsedNs : 1));
+}
+
+static void
+HostUsage(const char *argv0)
+{
+    fprintf(stderr, "usage: %s [--rounds N] [--seed S] [--bench]\n", argv0);
+    exit(2);
+}
+
+int
+main(int argc, char **argv)
+{
+    unsigned long rounds = 200000;
+    int bench = 0;
+
+    for (int index = 1; index < argc; ++index)
+    {
+        if (strcmp(argv[index], "--rounds") == 0 && index + 1 < argc)
+            rounds = strtoul(argv[++index], NULL, 0);
+        else if (strcmp(argv[index], "--seed") == 0 && index + 1 < argc)
+            gSeed = strtoull(argv[++index], NULL, 0);
+        else if (strcmp(argv[index], "--bench") == 0)
+            bench = 1;
+        else
+            HostUsage(argv[0]);
+    }
+    if (gSeed == 0)
+        gSeed = 1;
+    printf("seed=0x%llx rounds=%lu\n", (unsigned long long)gSeed, rounds);
+    fflush(stdout); // A guard-page fault kills the process before stdio would flush
+
+    // Both pages leave room for the longest benchmark string.
+    HOST_PAGE pages[2];
+    HostMapPage(&pages[0], 4096U);
+    HostMapPage(&pages[1], 4096U);
+
+    HostFuzzStrings(pages, rounds);
+    HostFuzzDigits(rounds);
+    if (gFailures != 0)
+    {
+        fprintf(stderr, "libc string host check FAILED: %lu mismatches\n", gFailures);
+        return 1;
+    }
+    printf("libc string host check passed\n");
+
+    if (bench)
+        HostBench(pages);
+    return 0;
+}
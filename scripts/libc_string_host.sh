@@ -0,0 +1,44 @@
+#!/bin/bash
+# Host equivalence fuzz test and microbenchmark for the kernel libc string routines.
+# Usage: ./scripts/libc_string_host.sh [--rounds N] [--seed S] [--bench]
+# Optional env: HOST_CC (default: cc), HOST_OPT (default: -O0, as the kernel builds),
+#               OUT_DIR (default: build/host/libc_string)
+#
+# strlen.c, strcmp.c and memcmp.c are compiled twice with the kernel's include
+# paths: on general registers only (the SWAR paths the kernel runs) and with
+# SSE2 (the paths the EFI loader runs). Their symbols are renamed so they link
+# next to the host libc. hostdlib.c supplies CountDecDigit.
+
+set -eu
+
+ROOT_DIR=$(cd "$(dirname "$0")/.." && pwd)
+HOST_CC=${HOST_CC:-cc}
+HOST_OPT=${HOST_OPT:--O0}
+OUT_DIR=${OUT_DIR:-${ROOT_DIR}/build/host/libc_string}
+
+KERNEL_FLAGS=(-Wall -Wextra -Werror -ffreestanding -fno-builtin -nostdinc -fno-stack-protector -m64 -g "${HOST_OPT}"
+              -I"${ROOT_DIR}/src" -I"${ROOT_DIR}/src/include" -I"${ROOT_DIR}/src/include/libc")
+
+mkdir -p "${OUT_DIR}"
+
+build_variant() {
+    local prefix=$1
+    shift
+    local routine
+    for routine in strlen strcmp memcmp; do
+        local source="${ROOT_DIR}/src/libc/string/${routine}.c"
+        "${HOST_CC}" "${KERNEL_FLAGS[@]}" "$@" -Dstrlen="Ho${prefix}Strlen" -Dstrcmp="Ho${prefix}Strcmp" \
+            -Dmemcmp="Ho${prefix}Memcmp" -c "${source}" -o "${OUT_DIR}/${prefix,,}_${routine}.o"
+    done
+}
+
+build_variant Swar -mgeneral-regs-only
+build_variant Sse2 -msse2
+"${HOST_CC}" "${KERNEL_FLAGS[@]}" -c "${ROOT_DIR}/src/libc/stdlib/hostdlib.c" -o "${OUT_DIR}/hostdlib.o"
+
+# The harness uses the host libc. It builds at the same level as the routines so the bytewise baselines are
+# comparable, and GCC must not turn its reference loops into library calls.
+"${HOST_CC}" -Wall -Wextra -Werror "${HOST_OPT}" -g -fno-builtin -fno-tree-loop-distribute-patterns \
+    "${ROOT_DIR}/scripts/libc_string_host.c" "${OUT_DIR}"/*.o -o "${OUT_DIR}/libc_string_host"
+
+exec "${OUT_DIR}/libc_string_host" "$@"
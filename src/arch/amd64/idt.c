@@ -1,5 +1,6 @@
 #include "arch/amd64/idt.h"
 #include "arch/amd64/pm.h"
+#include "arch/amd64/asm.h"
 #include "kernel/hodbg.h"
 #include <kernel/ex/user_syscall_abi.h>
 #include <kernel/init.h>
@@ -18,6 +19,7 @@ typedef struct IDT_IRQ_HANDLER_ENTRY
 } IDT_IRQ_HANDLER_ENTRY;
 
 static IDT_IRQ_HANDLER_ENTRY kInterruptHandlers[256];
+static IDT_VECTOR_STATS kVectorStats[256];
 
 extern void *gIsrStubTable[];
 
@@ -227,8 +229,29 @@ IdtExceptionHandler(void *frame)
     }
 
     KeEnterInterruptContext();
+
+    uint64_t startTsc = rdtsc();
     HandleRegisteredVector(dump);
-    KeLeaveInterruptContext();
+    uint64_t handlerCycles = rdtsc() - startTsc;
+
+    IDT_VECTOR_STATS *stats = &kVectorStats[vectorNumber];
+    stats->Count++;
+    stats->TotalHandlerCycles += handlerCycles;
+    if (handlerCycles > stats->MaxHandlerCycles)
+        stats->MaxHandlerCycles = handlerCycles;
+
+    // Retires the DPCs queued by the handler before returning to PASSIVE. Interrupts stay disabled throughout, so
+    // the drain is part of the interrupt-off span.
+    if (!KeLeaveInterruptContext())
+    {
+        stats->SwitchedCount++;
+        return;
+    }
+
+    uint64_t offCycles = rdtsc() - startTsc;
+    stats->TotalInterruptOffCycles += offCycles;
+    if (offCycles > stats->MaxInterruptOffCycles)
+        stats->MaxInterruptOffCycles = offCycles;
 }
 
 HO_PUBLIC_API const char *
@@ -289,10 +312,29 @@ IdtRegisterInterruptHandler(uint8_t vectorNumber, IDT_INTERRUPT_HANDLER handler,
     return EC_SUCCESS;
 }
 
+HO_PUBLIC_API BOOL
+IdtIsInterruptHandlerRegistered(uint8_t vectorNumber)
+{
+    return kInterruptHandlers[vectorNumber].Handler != NULL;
+}
+
+HO_PUBLIC_API HO_STATUS
+IdtQueryVectorStats(uint8_t vectorNumber, IDT_VECTOR_STATS *outStats)
+{
+    if (outStats == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    *outStats = kVectorStats[vectorNumber];
+    ArchRestoreInterruptState(interruptState);
+    return EC_SUCCESS;
+}
+
 HO_PUBLIC_API HO_STATUS
 IdtInit(void)
 {
     memset(kInterruptHandlers, 0, sizeof(kInterruptHandlers));
+    memset(kVectorStats, 0, sizeof(kVectorStats));
 
     for (int i = 0; i < 256; i++)
     {
@@ -37,6 +37,9 @@ CommonIsrStub:
     push r14
     push r15
 
+    ; User mode may trap with DF set; C code, and rep movsb/stosb in
+    ; memcpy/memset, assume it is clear. iretq restores the caller's DF.
+    cld
     mov rdi, rsp
     call IdtExceptionHandler
 
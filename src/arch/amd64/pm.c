@@ -1,7 +1,12 @@
 #include "arch/amd64/pm.h"
+#include "arch/amd64/asm.h"
+
+#define CPUID_FEATURE_EDX_PAT (1U << 16)
 
 static void SetTssEntry(void *base, uint64_t tss);
 
+static BOOL gPatProgrammed = FALSE;
+
 void
 LoadCR3(HO_PHYSICAL_ADDRESS pml4PhysAddr)
 {
@@ -9,6 +14,27 @@ LoadCR3(HO_PHYSICAL_ADDRESS pml4PhysAddr)
     __asm__ __volatile__("mov %0, %%cr3" ::"r"(cr3) : "memory");
 }
 
+HO_KERNEL_API BOOL
+InitPat(void)
+{
+    uint32_t eax, ebx, ecx, edx;
+    cpuid(0x1, &eax, &ebx, &ecx, &edx);
+    if ((edx & CPUID_FEATURE_EDX_PAT) == 0)
+        return FALSE;
+
+    // Only PA4 changes and no mapping selects it yet, so there is nothing cached
+    // or in the TLB under the old type to flush.
+    wrmsr(IA32_PAT_MSR, HO_PAT_VALUE);
+    gPatProgrammed = TRUE;
+    return TRUE;
+}
+
+HO_KERNEL_API BOOL
+IsPatProgrammed(void)
+{
+    return gPatProgrammed;
+}
+
 HO_KERNEL_API uint64_t
 CalcPagesToStoreEntries(uint64_t entries, uint64_t entrySize, uint64_t pageSize)
 {
@@ -184,6 +184,9 @@ StagingKernel(const CHAR16 *path)
         LOG_WARNING(L"ACPI RSDP not found in UEFI configuration tables\r\n");
     }
 
+    if (ReadBootOptions(BOOT_OPTIONS_FILE, capsule->BootOptions, sizeof(capsule->BootOptions)) == EFI_SUCCESS)
+        LOG_INFO(L"Boot options loaded from %s\r\n", BOOT_OPTIONS_FILE);
+
     kBootUseNx = CpuSupportsNx();
     if (!kBootUseNx)
         LOG_WARNING(L"CPU does not support NX bit; boot mappings will be executable\r\n");
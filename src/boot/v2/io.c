@@ -521,3 +521,44 @@ ReadKernelImage(IN const CHAR16 *path, OUT void **outImage, OUT UINT64 *outSize)
     *outSize = kernelFileSize;
     return EFI_SUCCESS;
 }
+
+EFI_STATUS
+ReadBootOptions(IN const CHAR16 *path, OUT char *buffer, IN UINTN capacity)
+{
+    EFI_STATUS status;
+    EFI_FILE_PROTOCOL *rootDir = NULL;
+    EFI_FILE_PROTOCOL *optionsFile = NULL;
+
+    if (buffer == NULL || capacity == 0)
+        return EFI_INVALID_PARAMETER;
+    buffer[0] = '\0';
+
+    status = g_FSP->OpenVolume(g_FSP, &rootDir);
+    if (EFI_ERROR(status))
+        return status;
+
+    status = rootDir->Open(rootDir, &optionsFile, (CHAR16 *)path, EFI_FILE_MODE_READ, EFI_FILE_READ_ONLY);
+    if (EFI_ERROR(status))
+    {
+        rootDir->Close(rootDir);
+        return status;
+    }
+
+    UINTN readSize = capacity - 1;
+    status = optionsFile->Read(optionsFile, &readSize, buffer);
+    optionsFile->Close(optionsFile);
+    rootDir->Close(rootDir);
+    if (EFI_ERROR(status) || readSize >= capacity)
+    {
+        buffer[0] = '\0';
+        return EFI_ERROR(status) ? status : EFI_DEVICE_ERROR;
+    }
+
+    for (UINTN index = 0; index < readSize; ++index)
+    {
+        if (buffer[index] == '\r' || buffer[index] == '\n' || buffer[index] == '\t')
+            buffer[index] = ' ';
+    }
+    buffer[readSize] = '\0';
+    return EFI_SUCCESS;
+}
@@ -39,3 +39,10 @@ void PrintCapsule(const BOOT_CAPSULE *capsule, const CHAR16 *tag);
 EFI_STATUS GetFileSize(EFI_FILE_PROTOCOL *file, UINT64 *outSize);
 
 EFI_STATUS ReadKernelImage(IN const CHAR16 *path, OUT void **outImage, OUT UINT64 *outSize);
+
+/**
+ * @brief Read a small text file from the boot volume into a NUL-terminated
+ *        buffer, cutting it at capacity - 1 bytes and turning line breaks into
+ *        spaces. The buffer is left empty on any failure.
+ */
+EFI_STATUS ReadBootOptions(IN const CHAR16 *path, OUT char *buffer, IN UINTN capacity);
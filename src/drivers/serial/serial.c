@@ -2,6 +2,10 @@
 #include <arch/amd64/asm.h>
 #include <kernel/ke/console.h>
 
+#define PIC1_COMMAND_PORT 0x20U
+#define PIC1_DATA_PORT    0x21U
+#define PIC_EOI           0x20U
+
 void
 SerialInit(uint16_t port)
 {
@@ -18,7 +22,7 @@ SerialInit(uint16_t port)
 void
 SerialWriteByte(uint16_t port, char byte)
 {
-    while ((inb(SERIAL_LINE_STATUS_PORT(port)) & 0x20) == 0)
+    while ((inb(SERIAL_LINE_STATUS_PORT(port)) & SERIAL_LSR_THRE) == 0)
         ;
     outb(SERIAL_DATA_PORT(port), byte);
 }
@@ -26,7 +30,8 @@ SerialWriteByte(uint16_t port, char byte)
 void
 SerialDrain(uint16_t port)
 {
-    while ((inb(SERIAL_LINE_STATUS_PORT(port)) & 0x60) != 0x60)
+    while ((inb(SERIAL_LINE_STATUS_PORT(port)) & (SERIAL_LSR_THRE | SERIAL_LSR_TEMT)) !=
+           (SERIAL_LSR_THRE | SERIAL_LSR_TEMT))
         ;
 }
 
@@ -38,3 +43,45 @@ SerialWriteStr(const char *s)
         SerialWriteByte(COM1_PORT, *s++);
     }
 }
+
+BOOL
+SerialIsTransmitReady(uint16_t port)
+{
+    return (inb(SERIAL_LINE_STATUS_PORT(port)) & SERIAL_LSR_THRE) != 0;
+}
+
+void
+SerialWriteFifo(uint16_t port, const char *bytes, uint32_t count)
+{
+    if (count > SERIAL_FIFO_DEPTH)
+        count = SERIAL_FIFO_DEPTH;
+
+    for (uint32_t index = 0; index < count; ++index)
+        outb(SERIAL_DATA_PORT(port), bytes[index]);
+}
+
+void
+SerialSetTransmitInterrupt(uint16_t port, BOOL enable)
+{
+    // MCR OUT2 (set by SerialInit) gates the IRQ line on PC-compatible UARTs.
+    outb(SERIAL_INTR_ENABLE_PORT(port), enable ? SERIAL_IER_THRE : 0x00);
+}
+
+uint8_t
+SerialReadInterruptId(uint16_t port)
+{
+    return inb(SERIAL_INTR_ID_PORT(port));
+}
+
+void
+SerialUnmaskIrq(uint8_t irqLine)
+{
+    uint8_t mask = inb(PIC1_DATA_PORT);
+    outb(PIC1_DATA_PORT, (uint8_t)(mask & (uint8_t)~(1U << irqLine)));
+}
+
+void
+SerialAcknowledgeIrq(void)
+{
+    outb(PIC1_COMMAND_PORT, PIC_EOI);
+}
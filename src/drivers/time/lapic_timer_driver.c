@@ -179,3 +179,37 @@ LapicTimerGetCurrentCount(HO_VIRTUAL_ADDRESS baseVirt)
 {
     return LapicReadReg(baseVirt, LAPIC_REG_CURRENT_COUNT);
 }
+
+BOOL
+LapicTimerSupportsTscDeadline(void)
+{
+    uint32_t featureEcx;
+    uint32_t featureEdx;
+
+    if (LapicGetCpuidFeatureBits(&featureEcx, &featureEdx) != EC_SUCCESS)
+        return FALSE;
+
+    return (featureEcx & (1U << 24)) != 0;
+}
+
+void
+LapicTimerConfigureTscDeadline(HO_VIRTUAL_ADDRESS baseVirt, uint8_t vectorNumber, BOOL masked)
+{
+    uint32_t lvt = (uint32_t)vectorNumber | LAPIC_LVT_MODE_TSC_DEADLINE;
+
+    if (masked)
+        lvt |= LAPIC_LVT_MASKED;
+
+    LapicWriteReg(baseVirt, LAPIC_REG_LVT_TIMER, lvt);
+
+    // SDM 10.5.4.1: the xAPIC MMIO write must be ordered before the first
+    // IA32_TSC_DEADLINE write, which is not serialized against it.
+    if (gLapicAccessMode == LAPIC_ACCESS_XAPIC_MMIO)
+        __asm__ __volatile__("mfence" ::: "memory");
+}
+
+void
+LapicTimerSetTscDeadline(uint64_t deadlineTsc)
+{
+    wrmsr(IA32_TSC_DEADLINE_MSR, deadlineTsc);
+}
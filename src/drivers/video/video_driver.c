@@ -3,6 +3,10 @@
 #include <kernel/hodbg.h>
 #include "efi/video_efi.h"
 #include "kernel/hodefs.h"
+#include <arch/amd64/asm.h>
+#include <kernel/ke/mm.h>
+
+static void VdStreamRow(uint32_t *dst, const uint32_t *src, uint32_t pixels);
 
 void HO_KERNEL_API
 VdInit(KE_VIDEO_DRIVER *pd, STAGING_BLOCK *info)
@@ -28,7 +32,9 @@ VdInit(KE_VIDEO_DRIVER *pd, STAGING_BLOCK *info)
     pd->PixelsPerScanLine = info->PixelsPerScanLine;
     pd->FrameBuffer = (void *)MMIO_BASE_VA;
     pd->FrameBufferSize = info->FramebufferSize;
+    pd->FrameBufferPhys = info->FramebufferPhys;
     pd->Methods = VdEfiGetVTable();
+    pd->ScanoutBuffer = pd->FrameBuffer;
 }
 
 HO_STATUS HO_KERNEL_API
@@ -39,7 +45,10 @@ VdRenderPixel(KE_VIDEO_DRIVER *device, uint32_t x, uint32_t y, COLOR32 color)
     if (device->Methods->RenderPixel == NULL)
         return EC_NOT_SUPPORTED;
 
-    return device->Methods->RenderPixel(device, x, y, color);
+    HO_STATUS status = device->Methods->RenderPixel(device, x, y, color);
+    if (status == EC_SUCCESS)
+        VdMarkDirty(device, x, y, 1, 1);
+    return status;
 }
 
 HO_STATUS HO_KERNEL_API
@@ -50,7 +59,10 @@ VdRenderRect(KE_VIDEO_DRIVER *device, VD_RENDER_RECT_PARAMS *params)
     if (device->Methods->RenderRect == NULL)
         return EC_NOT_SUPPORTED;
 
-    return device->Methods->RenderRect(device, params);
+    // A rectangle clipped at the screen edge fails part way; mark it either way.
+    HO_STATUS status = device->Methods->RenderRect(device, params);
+    VdMarkDirty(device, params->X, params->Y, params->Width, params->Height);
+    return status;
 }
 
 HO_STATUS HO_KERNEL_API
@@ -61,5 +73,156 @@ VdClearScreen(KE_VIDEO_DRIVER *device, uint32_t color)
     if (device->Methods->ClearScreen == NULL)
         return EC_NOT_SUPPORTED;
 
-    return device->Methods->ClearScreen(device, color);
-}
\ No newline at end of file
+    HO_STATUS status = device->Methods->ClearScreen(device, color);
+    if (status == EC_SUCCESS)
+        VdMarkDirty(device, 0, 0, device->HorizontalResolution, device->VerticalResolution);
+    return status;
+}
+
+HO_STATUS HO_KERNEL_API
+VdMapScanoutWriteCombining(KE_VIDEO_DRIVER *device)
+{
+    if (device == NULL || device->ScanoutBuffer == NULL || device->FrameBufferSize == 0)
+        return EC_ILLEGAL_ARGUMENT;
+    if (device->ScanoutWriteCombining)
+        return EC_SUCCESS;
+    if (!IsPatProgrammed())
+        return EC_NOT_SUPPORTED;
+
+    HO_PHYSICAL_ADDRESS physBase = HO_ALIGN_DOWN(device->FrameBufferPhys, PAGE_4KB);
+    uint64_t offset = device->FrameBufferPhys - physBase;
+    uint64_t pageCount = HO_ALIGN_UP(offset + device->FrameBufferSize, PAGE_4KB) / PAGE_4KB;
+
+    KE_KVA_RANGE range = {0};
+    HO_STATUS status = KeKvaAllocRange(KE_KVA_ARENA_HEAP, pageCount, 0, 0, FALSE, &range);
+    if (status != EC_SUCCESS)
+        return status;
+
+    for (uint64_t index = 0; index < pageCount; ++index)
+    {
+        status = KeKvaMapPage(&range, index, physBase + index * PAGE_4KB, PTE_WRITABLE | PTE_GLOBAL | PTE_NO_EXECUTE,
+                              KE_MEMORY_TYPE_WRITE_COMBINING);
+        if (status != EC_SUCCESS)
+        {
+            HO_STATUS cleanupStatus = KeKvaReleaseRangeHandle(&range);
+            if (cleanupStatus != EC_SUCCESS)
+                return cleanupStatus;
+            return status;
+        }
+    }
+
+    // Two live mappings of one frame with different memory types are undefined under the PAT, so the uncached
+    // boot mapping is retired before anything touches the new alias. If that fails the alias goes instead.
+    HO_VIRTUAL_ADDRESS uncachedBase = HO_ALIGN_DOWN((HO_VIRTUAL_ADDRESS)device->ScanoutBuffer, PAGE_4KB);
+    status = KePtUnmapRange(KeGetKernelAddressSpace(), uncachedBase, pageCount * PAGE_4KB);
+    if (status != EC_SUCCESS)
+    {
+        HO_STATUS cleanupStatus = KeKvaReleaseRangeHandle(&range);
+        if (cleanupStatus != EC_SUCCESS)
+            return cleanupStatus;
+        return status;
+    }
+
+    void *scanout = (void *)(range.UsableBase + offset);
+    if (device->FrameBuffer == device->ScanoutBuffer)
+        device->FrameBuffer = scanout;
+    device->ScanoutBuffer = scanout;
+    device->ScanoutWriteCombining = TRUE;
+    return EC_SUCCESS;
+}
+
+HO_STATUS HO_KERNEL_API
+VdEnableShadowBuffer(KE_VIDEO_DRIVER *device)
+{
+    if (device == NULL || device->ScanoutBuffer == NULL || device->FrameBufferSize == 0)
+        return EC_ILLEGAL_ARGUMENT;
+    if (device->ShadowBuffer != NULL)
+        return EC_SUCCESS;
+
+    HO_VIRTUAL_ADDRESS shadow = 0;
+    HO_STATUS status = KeHeapAllocPages(HO_ALIGN_UP(device->FrameBufferSize, PAGE_4KB) / PAGE_4KB, &shadow);
+    if (status != EC_SUCCESS)
+        return status;
+
+    // The only read of video memory: seed the shadow with what is on screen.
+    memcpy((void *)shadow, device->ScanoutBuffer, device->FrameBufferSize);
+    device->ShadowBuffer = (void *)shadow;
+    device->FrameBuffer = device->ShadowBuffer;
+    device->DirtyLeft = device->DirtyTop = device->DirtyRight = device->DirtyBottom = 0;
+    memset(&device->ShadowStats, 0, sizeof(device->ShadowStats));
+    return EC_SUCCESS;
+}
+
+void HO_KERNEL_API
+VdMarkDirty(KE_VIDEO_DRIVER *device, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    if (device == NULL || device->ShadowBuffer == NULL)
+        return;
+    if (x >= device->HorizontalResolution || y >= device->VerticalResolution || width == 0 || height == 0)
+        return;
+
+    uint32_t right = width > device->HorizontalResolution - x ? device->HorizontalResolution : x + width;
+    uint32_t bottom = height > device->VerticalResolution - y ? device->VerticalResolution : y + height;
+
+    if (device->DirtyLeft >= device->DirtyRight)
+    {
+        device->DirtyLeft = x;
+        device->DirtyTop = y;
+        device->DirtyRight = right;
+        device->DirtyBottom = bottom;
+    }
+    else
+    {
+        if (x < device->DirtyLeft)
+            device->DirtyLeft = x;
+        if (y < device->DirtyTop)
+            device->DirtyTop = y;
+        if (right > device->DirtyRight)
+            device->DirtyRight = right;
+        if (bottom > device->DirtyBottom)
+            device->DirtyBottom = bottom;
+    }
+    device->ShadowStats.DirtyMarks++;
+}
+
+// Copy one row span with 8-byte non-temporal stores, peeling a leading and
+// trailing pixel when the span is not 8-byte aligned.
+static void
+VdStreamRow(uint32_t *dst, const uint32_t *src, uint32_t pixels)
+{
+    uint32_t index = 0;
+    if (pixels != 0 && ((HO_VIRTUAL_ADDRESS)dst & 7U) != 0)
+    {
+        x64_Movnti32(dst, src[0]);
+        index = 1;
+    }
+
+    for (; index + 2 <= pixels; index += 2)
+        x64_Movnti64(dst + index, *(const uint64_t *)(src + index));
+
+    if (index < pixels)
+        x64_Movnti32(dst + index, src[index]);
+}
+
+void HO_KERNEL_API
+VdFlush(KE_VIDEO_DRIVER *device)
+{
+    if (device == NULL || device->ShadowBuffer == NULL || device->DirtyLeft >= device->DirtyRight)
+        return;
+
+    uint64_t startTsc = rdtsc();
+    uint32_t stride = device->HorizontalResolution;
+    uint32_t pixels = device->DirtyRight - device->DirtyLeft;
+    uint64_t offset = (uint64_t)device->DirtyTop * stride + device->DirtyLeft;
+    const uint32_t *src = (const uint32_t *)device->ShadowBuffer + offset;
+    uint32_t *dst = (uint32_t *)device->ScanoutBuffer + offset;
+
+    for (uint32_t row = device->DirtyTop; row < device->DirtyBottom; ++row, src += stride, dst += stride)
+        VdStreamRow(dst, src, pixels);
+    x64_Sfence();
+
+    device->ShadowStats.FlushCount++;
+    device->ShadowStats.FlushedBytes += (uint64_t)pixels * (device->DirtyBottom - device->DirtyTop) * sizeof(uint32_t);
+    device->ShadowStats.FlushCycles += rdtsc() - startTsc;
+    device->DirtyLeft = device->DirtyTop = device->DirtyRight = device->DirtyBottom = 0;
+}
@@ -24,6 +24,10 @@
 #define HO_ENABLE_SCHED_SWITCH_LOG 0
 #endif
 
+#ifndef HO_ENABLE_LOCK_PROFILE
+#define HO_ENABLE_LOCK_PROFILE 0
+#endif
+
 #define HO_NULL_DETECTION_ENABLED ((HO_ENABLE_NULL_DETECTION) != 0)
 
 typedef uint8_t BOOL;
@@ -98,3 +98,23 @@ x64_Sti(void)
 {
     __asm__ __volatile__("sti" : : : "memory");
 }
+
+// Non-temporal stores through general registers (SSE2 movnti, no vector state).
+// Order them against later stores with x64_Sfence().
+MAYBE_UNUSED static inline void
+x64_Movnti64(void *dst, uint64_t value)
+{
+    __asm__ __volatile__("movnti %1, %0" : "=m"(*(uint64_t *)dst) : "r"(value));
+}
+
+MAYBE_UNUSED static inline void
+x64_Movnti32(void *dst, uint32_t value)
+{
+    __asm__ __volatile__("movnti %1, %0" : "=m"(*(uint32_t *)dst) : "r"(value));
+}
+
+MAYBE_UNUSED static inline void
+x64_Sfence(void)
+{
+    __asm__ __volatile__("sfence" : : : "memory");
+}
@@ -54,8 +54,23 @@ typedef X64_INTERRUPT_FRAME CPU_DUMP_CONTEXT;
 typedef struct IDT_PTR IDT_PTR;
 typedef void (*IDT_INTERRUPT_HANDLER)(void *frame, void *context);
 
+// Per-vector ISR cost in TSC ticks. Handler cycles cover the registered handler alone. DPCs retire in the
+// interrupt epilogue with interrupts still disabled, so the interrupt-off span covers the handler plus that drain.
+// An epilogue that switches threads ends the span on another thread; it is counted in SwitchedCount instead.
+typedef struct IDT_VECTOR_STATS
+{
+    uint64_t Count;
+    uint64_t TotalHandlerCycles;
+    uint64_t MaxHandlerCycles;
+    uint64_t TotalInterruptOffCycles;
+    uint64_t MaxInterruptOffCycles;
+    uint64_t SwitchedCount;
+} IDT_VECTOR_STATS;
+
 HO_PUBLIC_API void IdtSetEntry(int vn, uint64_t isrAddr, uint16_t selector, uint8_t attributes, uint8_t ist);
 HO_PUBLIC_API HO_STATUS IdtInit(void);
 HO_PUBLIC_API void IdtExceptionHandler(void *frame);
 HO_PUBLIC_API const char *IdtGetExceptionMessage(uint8_t vectorNumber);
 HO_PUBLIC_API HO_STATUS IdtRegisterInterruptHandler(uint8_t vectorNumber, IDT_INTERRUPT_HANDLER handler, void *context);
+HO_PUBLIC_API BOOL IdtIsInterruptHandlerRegistered(uint8_t vectorNumber);
+HO_PUBLIC_API HO_STATUS IdtQueryVectorStats(uint8_t vectorNumber, IDT_VECTOR_STATS *outStats);
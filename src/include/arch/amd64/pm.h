@@ -128,6 +128,28 @@ typedef uint64_t PAGE_TABLE_ENTRY;
 #define IA32_EFER_MSR     0xC0000080U
 #define IA32_EFER_NXE     (1ULL << 11)
 
+// In a 4KB PTE bit 7 selects the upper half of the PAT; with PWT and PCD it forms
+// the 3-bit PAT index. (Bit 7 of a PDE/PDPTE is PTE_PAGE_SIZE instead.)
+#define PTE_PAT_4KB       (1ULL << 7)
+#define PTE_CACHE_MASK    (PTE_WRITETHROUGH | PTE_CACHE_DISABLE)
+
+#define IA32_PAT_MSR      0x277U
+#define PAT_TYPE_UC       0x00ULL
+#define PAT_TYPE_WC       0x01ULL
+#define PAT_TYPE_WT       0x04ULL
+#define PAT_TYPE_WP       0x05ULL
+#define PAT_TYPE_WB       0x06ULL
+#define PAT_TYPE_UC_MINUS 0x07ULL
+#define PAT_ENTRY(index, type) ((type) << ((index) * 8))
+
+// Power-on layout with PA4 switched to write-combining. PA0-PA3 keep WB/WT/UC-/UC,
+// so every PWT/PCD combination the boot loader used still means the same thing.
+#define HO_PAT_VALUE                                                                                                   \
+    (PAT_ENTRY(0, PAT_TYPE_WB) | PAT_ENTRY(1, PAT_TYPE_WT) | PAT_ENTRY(2, PAT_TYPE_UC_MINUS) |                         \
+     PAT_ENTRY(3, PAT_TYPE_UC) | PAT_ENTRY(4, PAT_TYPE_WC) | PAT_ENTRY(5, PAT_TYPE_WT) |                               \
+     PAT_ENTRY(6, PAT_TYPE_UC_MINUS) | PAT_ENTRY(7, PAT_TYPE_UC))
+#define HO_PAT_WC_PTE_BITS PTE_PAT_4KB // PAT index 4
+
 #define PML4_SHIFT        39
 #define PDPT_SHIFT        30
 #define PD_SHIFT          21
@@ -160,6 +182,14 @@ HO_KERNEL_API uint64_t CalcPagesToStoreEntries(uint64_t entries, uint64_t entryS
 
 HO_KERNEL_API void LoadCR3(HO_PHYSICAL_ADDRESS pml4PhysAddr);
 
+/**
+ * Program IA32_PAT with HO_PAT_VALUE. Returns FALSE when the CPU has no PAT, in
+ * which case write-combining mappings are unavailable.
+ */
+HO_KERNEL_API BOOL InitPat(void);
+
+HO_KERNEL_API BOOL IsPatProgrammed(void);
+
 /**
  * @brief Initialize the local data area (Core-Local Data) for a CPU core.
  *
@@ -24,6 +24,8 @@
 #define BOOT_HANDOFF_ALIGNMENT  8ULL
 
 #define BOOT_CAPSULE_MAGIC      0x214F5348 // 'HOS!'
+#define BOOT_OPTIONS_MAX        256U       // BootOptions bytes, NUL included
+#define BOOT_OPTIONS_FILE       L"boot_options.txt"
 
 typedef struct BOOT_CAPSULE_LAYOUT
 {
@@ -87,6 +89,10 @@ typedef struct BOOT_CAPSULE
 
     PAGE_TABLE_INFO PageTableInfo;
     CPU_CORE_LOCAL_DATA CpuInfo;
+
+    // Space-separated "key=value" options from BOOT_OPTIONS_FILE on the ESP,
+    // NUL-terminated; empty when the file is absent.
+    char BootOptions[BOOT_OPTIONS_MAX];
 } BOOT_CAPSULE, STAGING_BLOCK, BOOT_INFO_HEADER;
 
 static inline uint64_t
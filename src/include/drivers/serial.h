@@ -21,6 +21,16 @@
 #define SERIAL_LINE_CTRL_PORT(base)   (base + 3)
 #define SERIAL_MODEM_CTRL_PORT(base)  (base + 4)
 #define SERIAL_LINE_STATUS_PORT(base) (base + 5)
+#define SERIAL_INTR_ID_PORT(base)     (base + 2) // Read side of the FIFO control register
+
+#define SERIAL_IER_THRE       0x02 // Transmitter holding register empty interrupt
+#define SERIAL_LSR_THRE       0x20
+#define SERIAL_LSR_TEMT       0x40
+#define SERIAL_IIR_NO_PENDING 0x01
+#define SERIAL_IIR_ID_MASK    0x0E
+#define SERIAL_IIR_ID_THRE    0x02
+#define SERIAL_FIFO_DEPTH     16U // 16550A transmit FIFO, refilled whole on each THRE
+#define COM1_IRQ_LINE         4U
 
 void SerialInit(uint16_t port);
 
@@ -29,3 +39,14 @@ void SerialWriteByte(uint16_t port, char byte);
 void SerialDrain(uint16_t port);
 
 void SerialWriteStr(const char *s);
+
+// Interrupt-driven transmit support. SerialWriteFifo expects THRE to be set and
+// writes at most SERIAL_FIFO_DEPTH bytes without polling between them.
+BOOL SerialIsTransmitReady(uint16_t port);
+void SerialWriteFifo(uint16_t port, const char *bytes, uint32_t count);
+void SerialSetTransmitInterrupt(uint16_t port, BOOL enable);
+uint8_t SerialReadInterruptId(uint16_t port);
+
+// Legacy 8259 routing for the COM IRQ line. The PIC must already be remapped.
+void SerialUnmaskIrq(uint8_t irqLine);
+void SerialAcknowledgeIrq(void);
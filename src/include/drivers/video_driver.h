@@ -25,6 +25,15 @@ typedef struct
     BOOL Filled;
 } VD_RENDER_RECT_PARAMS;
 
+// Shadow buffer accounting. Cycles are TSC ticks spent copying dirty rows out.
+typedef struct
+{
+    uint64_t DirtyMarks;
+    uint64_t FlushCount;
+    uint64_t FlushedBytes;
+    uint64_t FlushCycles;
+} VD_SHADOW_STATS;
+
 struct _VIDEO_DRIVER;
 
 typedef struct
@@ -49,9 +58,18 @@ typedef struct _VIDEO_DRIVER
     uint32_t HorizontalResolution; // Horizontal resolution in pixels
     uint32_t VerticalResolution;   // Vertical resolution in pixels
     uint32_t PixelsPerScanLine;    // Number of pixels per scan line
-    void *FrameBuffer;
-    uint64_t FrameBufferSize; // Size of the framebuffer in bytes
+    void *FrameBuffer;             // Render target: the shadow once enabled, else the scanout buffer
+    uint64_t FrameBufferSize;      // Size of the framebuffer in bytes
+    HO_PHYSICAL_ADDRESS FrameBufferPhys;
     const VD_VTABLE *Methods;
+
+    // Cached RAM copy of the screen. Renderers never read video memory; dirty
+    // pixels are bounded by one rectangle and streamed out by VdFlush.
+    void *ScanoutBuffer; // Firmware framebuffer mapping, or the write-combining mapping that replaced it
+    void *ShadowBuffer;  // NULL until VdEnableShadowBuffer
+    uint32_t DirtyLeft, DirtyTop, DirtyRight, DirtyBottom; // Right/bottom exclusive; empty when left >= right
+    VD_SHADOW_STATS ShadowStats;
+    BOOL ScanoutWriteCombining; // ScanoutBuffer is the VdMapScanoutWriteCombining mapping
 } KE_VIDEO_DRIVER;
 
 /**
@@ -100,3 +118,46 @@ HO_STATUS HO_KERNEL_API VdRenderRect(KE_VIDEO_DRIVER *device, VD_RENDER_RECT_PAR
  * @return HO_STATUS indicating success or failure of the operation.
  */
 HO_STATUS HO_KERNEL_API VdClearScreen(KE_VIDEO_DRIVER *device, uint32_t color);
+
+/**
+ * @brief Remap the framebuffer write-combining for scanout writes.
+ *
+ * The boot loader maps video memory uncached, so every store is its own bus
+ * transaction. This maps the same physical range again through a kernel heap
+ * KVA range with the PAT write-combining type and moves ScanoutBuffer (and
+ * FrameBuffer while no shadow is in use) onto it. The uncached boot mapping is
+ * then unmapped so video memory is never reachable through two memory types;
+ * if that fails the alias is released and the boot mapping stays in use.
+ *
+ * @param device Video device, after the kernel heap is up.
+ * @return EC_SUCCESS (also when already mapped), EC_NOT_SUPPORTED without a PAT,
+ *         or the KVA allocation, mapping or boot-mapping retirement failure.
+ */
+HO_STATUS HO_KERNEL_API VdMapScanoutWriteCombining(KE_VIDEO_DRIVER *device);
+
+/**
+ * @brief Move rendering onto a cached RAM shadow of the framebuffer.
+ *
+ * Allocates the shadow from the kernel heap, seeds it with the current screen and
+ * points FrameBuffer at it. From then on nothing reaches the display until VdFlush.
+ *
+ * @param device Video device, after the kernel heap is up.
+ * @return EC_SUCCESS (also when already enabled), or the heap allocation failure.
+ */
+HO_STATUS HO_KERNEL_API VdEnableShadowBuffer(KE_VIDEO_DRIVER *device);
+
+/**
+ * @brief Record that a rectangle of the render target was written.
+ *
+ * The VdRender* and VdClearScreen entry points mark on their own; code that
+ * stores to FrameBuffer directly calls this. A no-op without a shadow buffer.
+ */
+void HO_KERNEL_API VdMarkDirty(KE_VIDEO_DRIVER *device, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+/**
+ * @brief Copy the dirty rectangle from the shadow to the framebuffer.
+ *
+ * Rows are written with non-temporal stores so the copy neither reads video
+ * memory nor evicts the caller's cache lines. A no-op when nothing is dirty.
+ */
+void HO_KERNEL_API VdFlush(KE_VIDEO_DRIVER *device);
@@ -0,0 +1,48 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ex/futex.h
+ * Description:
+ * Ex Layer - Wait-on-address for user synchronization. Waiters park on a hashed
+ * table keyed by (address space root, user VA) and sleep on an ordinary KEVENT,
+ * so user locks only enter the kernel when they are contended.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include <_hobase.h>
+
+#include <kernel/ex/user_sysinfo_abi.h>
+
+#define EX_FUTEX_HASH_BUCKETS 64U
+
+HO_KERNEL_API HO_NODISCARD HO_STATUS ExFutexInit(void);
+
+/**
+ * @brief Sleep while the 32-bit user word at userAddress still holds expected.
+ *
+ * The value check and the enqueue happen atomically with respect to
+ * ExFutexWake, so a wake that follows the user-side store cannot be lost.
+ *
+ * @return EC_SUCCESS when woken (including by a kill request),
+ *         EC_INVALID_STATE when the word no longer matches expected,
+ *         EC_TIMEOUT when timeoutNs elapsed first.
+ */
+HO_KERNEL_API HO_NODISCARD HO_STATUS ExFutexWait(HO_VIRTUAL_ADDRESS userAddress, uint32_t expected, uint64_t timeoutNs);
+
+/**
+ * @brief Wake up to maxWake threads waiting on userAddress in the current
+ *        address space.
+ */
+HO_KERNEL_API HO_NODISCARD HO_STATUS ExFutexWake(HO_VIRTUAL_ADDRESS userAddress,
+                                                 uint32_t maxWake,
+                                                 uint32_t *outWoken);
+
+HO_KERNEL_API HO_NODISCARD HO_STATUS ExQueryFutexStats(EX_SYSINFO_FUTEX_STATS *outStats);
+
+/**
+ * @brief Wake every waiter parked in an address space. Called after a kill
+ *        request so blocked threads return to the syscall exit path and observe it.
+ */
+uint32_t ExFutexWakeAddressSpace(HO_PHYSICAL_ADDRESS rootPageTablePhys);
@@ -12,9 +12,22 @@
 
 #include <kernel/ex/ex_process.h>
 #include <kernel/ex/user_image_abi.h>
+#include <kernel/ex/user_sysinfo_abi.h>
 
 #define EX_PROGRAM_NAME_MAX_LENGTH 16U
 
+// Long-lived Ex spawn workers; overridable from the build (HO_EX_SPAWN_WORKERS=N).
+#ifndef HO_EX_SPAWN_WORKERS
+#define HO_EX_SPAWN_WORKERS 2
+#endif
+
+#if HO_EX_SPAWN_WORKERS < 1
+#error HO_EX_SPAWN_WORKERS must be at least 1; a pool without workers never serves a spawn.
+#endif
+
+#define EX_SPAWN_WORKER_COUNT ((uint32_t)(HO_EX_SPAWN_WORKERS))
+#define EX_SPAWN_BATCH_LIMIT  4U
+
 typedef enum EX_PROGRAM_ID
 {
     EX_PROGRAM_ID_NONE = 0,
@@ -28,6 +41,11 @@ typedef enum EX_PROGRAM_ID
     EX_PROGRAM_ID_USER_CAPS = 8,
     EX_PROGRAM_ID_INPUT_PROBE = 9,
     EX_PROGRAM_ID_LINE_ECHO = 10,
+    EX_PROGRAM_ID_FUTEX_PROBE = 11,
+    EX_PROGRAM_ID_DEADLINE_PROBE = 12,
+    EX_PROGRAM_ID_TIMER_SLACK_PROBE = 13,
+    EX_PROGRAM_ID_TIME_PROBE = 14,
+    EX_PROGRAM_ID_LOGLEVEL = 15,
 } EX_PROGRAM_ID;
 
 typedef enum EX_USER_IMAGE_KIND
@@ -57,6 +75,10 @@ HO_KERNEL_API HO_NODISCARD HO_STATUS ExLookupProgramImageByName(const char *name
                                                                 const EX_USER_IMAGE **outImage);
 HO_KERNEL_API HO_NODISCARD HO_STATUS ExLookupProgramImageById(uint32_t programId, const EX_USER_IMAGE **outImage);
 HO_KERNEL_API HO_NODISCARD HO_STATUS ExSpawnProgramImage(const EX_USER_IMAGE *image, uint32_t flags, uint32_t *outPid);
+HO_KERNEL_API HO_NODISCARD HO_STATUS ExSpawnPoolInit(void);
+HO_KERNEL_API HO_NODISCARD HO_STATUS ExQuerySpawnStats(EX_SYSINFO_SPAWN_STATS *outStats);
+// Requests served by each spawn worker so far; capacity must be at least EX_SPAWN_WORKER_COUNT.
+HO_KERNEL_API HO_NODISCARD HO_STATUS ExQuerySpawnWorkerLoad(uint64_t *outServedCounts, uint32_t capacity);
 HO_KERNEL_API HO_NODISCARD HO_STATUS ExProgramBuildRuntimeCreateParams(const EX_USER_IMAGE *image,
                                                                        uint32_t parentProcessId,
                                                                        EX_RUNTIME_PROCESS_CREATE_PARAMS *outParams);
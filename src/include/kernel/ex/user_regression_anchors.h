@@ -29,6 +29,11 @@
 #define EX_USER_REGRESSION_LOG_KILL_PID_REJECTED        "[DEMOSHELL] SYS_KILL_PID rejected"
 #define EX_USER_REGRESSION_LOG_QUERY_SYSINFO_SUCCEEDED  "[SYSINFO] SYS_QUERY_SYSINFO succeeded"
 #define EX_USER_REGRESSION_LOG_QUERY_SYSINFO_REJECTED   "[SYSINFO] SYS_QUERY_SYSINFO rejected"
+#define EX_USER_REGRESSION_LOG_FUTEX_REJECTED           "[FUTEX] futex syscall rejected"
+#define EX_USER_REGRESSION_LOG_DEADLINE_REJECTED        "[DEADLINE] deadline syscall rejected"
+#define EX_USER_REGRESSION_LOG_TIMER_SLACK_REJECTED     "[TIMERSLACK] timer slack syscall rejected"
+#define EX_USER_REGRESSION_LOG_SET_LOG_LEVEL_SUCCEEDED  "[KLOG] SYS_SET_LOG_LEVEL succeeded"
+#define EX_USER_REGRESSION_LOG_SET_LOG_LEVEL_REJECTED   "[KLOG] SYS_SET_LOG_LEVEL rejected"
 #define EX_USER_REGRESSION_LOG_KILL_EXIT                "[DEMOSHELL] kill exit"
 #define EX_USER_REGRESSION_LOG_INVALID_USER_BUFFER      "[USERRT] invalid user buffer"
 #define EX_USER_REGRESSION_LOG_TEARDOWN_FAILED          "[USERRT] runtime teardown failed"
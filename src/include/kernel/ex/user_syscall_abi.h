@@ -21,21 +21,68 @@
 
 #define EX_USER_SYSCALL_BASE 0x100U
 
-#define EX_USER_SYS_WRITE         (EX_USER_SYSCALL_BASE + 0U)
-#define EX_USER_SYS_CLOSE         (EX_USER_SYSCALL_BASE + 1U)
-#define EX_USER_SYS_WAIT_ONE      (EX_USER_SYSCALL_BASE + 2U)
-#define EX_USER_SYS_EXIT          (EX_USER_SYSCALL_BASE + 3U)
-#define EX_USER_SYS_READLINE      (EX_USER_SYSCALL_BASE + 4U)
-#define EX_USER_SYS_SPAWN_PROGRAM (EX_USER_SYSCALL_BASE + 5U)
-#define EX_USER_SYS_WAIT_PID      (EX_USER_SYSCALL_BASE + 6U)
-#define EX_USER_SYS_SLEEP_MS      (EX_USER_SYSCALL_BASE + 7U)
-#define EX_USER_SYS_KILL_PID      (EX_USER_SYSCALL_BASE + 8U)
-#define EX_USER_SYS_QUERY_SYSINFO (EX_USER_SYSCALL_BASE + 9U)
+#define EX_USER_SYS_WRITE           (EX_USER_SYSCALL_BASE + 0U)
+#define EX_USER_SYS_CLOSE           (EX_USER_SYSCALL_BASE + 1U)
+#define EX_USER_SYS_WAIT_ONE        (EX_USER_SYSCALL_BASE + 2U)
+#define EX_USER_SYS_EXIT            (EX_USER_SYSCALL_BASE + 3U)
+#define EX_USER_SYS_READLINE        (EX_USER_SYSCALL_BASE + 4U)
+#define EX_USER_SYS_SPAWN_PROGRAM   (EX_USER_SYSCALL_BASE + 5U)
+#define EX_USER_SYS_WAIT_PID        (EX_USER_SYSCALL_BASE + 6U)
+#define EX_USER_SYS_SLEEP_MS        (EX_USER_SYSCALL_BASE + 7U)
+#define EX_USER_SYS_KILL_PID        (EX_USER_SYSCALL_BASE + 8U)
+#define EX_USER_SYS_QUERY_SYSINFO   (EX_USER_SYSCALL_BASE + 9U)
+#define EX_USER_SYS_FUTEX_WAIT      (EX_USER_SYSCALL_BASE + 10U)
+#define EX_USER_SYS_FUTEX_WAKE      (EX_USER_SYSCALL_BASE + 11U)
+#define EX_USER_SYS_SET_DEADLINE    (EX_USER_SYSCALL_BASE + 12U)
+#define EX_USER_SYS_WAIT_PERIOD     (EX_USER_SYSCALL_BASE + 13U)
+#define EX_USER_SYS_SET_TIMER_SLACK (EX_USER_SYSCALL_BASE + 14U)
+#define EX_USER_SYS_SET_LOG_LEVEL   (EX_USER_SYSCALL_BASE + 15U)
 
 #define EX_USER_WAIT_ONE_TIMEOUT_MAX_MS    0xFFFFFFFFULL
 #define EX_USER_WAIT_ONE_TIMEOUT_NS_PER_MS 1000000ULL
 #define EX_USER_SLEEP_MS_MAX               0xFFFFFFFFULL
 #define EX_USER_SLEEP_NS_PER_MS            1000000ULL
 
+/*
+ * SYS_FUTEX_WAIT(addr, expected, timeout_ms) sleeps while the naturally aligned
+ * 32-bit word at addr equals expected. It fails with EC_INVALID_STATE when the
+ * word already differs and with EC_TIMEOUT when timeout_ms elapses first.
+ * SYS_FUTEX_WAKE(addr, count) wakes up to count waiters and returns how many
+ * were woken.
+ */
+#define EX_USER_FUTEX_TIMEOUT_INFINITE  0xFFFFFFFFFFFFFFFFULL
+#define EX_USER_FUTEX_TIMEOUT_MAX_MS    0xFFFFFFFFULL
+#define EX_USER_FUTEX_TIMEOUT_NS_PER_MS 1000000ULL
+#define EX_USER_FUTEX_WAKE_ALL          0xFFFFFFFFULL
+
+/*
+ * SYS_SET_DEADLINE(runtime_us, period_us, deadline_us) moves the calling thread
+ * into the deadline scheduling class; runtime_us == 0 returns it to the RR class
+ * and deadline_us == 0 means "equal to the period". Admission failures return
+ * EC_OUT_OF_RESOURCE. SYS_WAIT_PERIOD() ends the current job and sleeps until
+ * the next period boundary; it fails with EC_INVALID_STATE outside the class.
+ */
+#define EX_USER_DEADLINE_MAX_US    10000000ULL
+#define EX_USER_DEADLINE_NS_PER_US 1000ULL
+
+/*
+ * SYS_SET_TIMER_SLACK(slack_us) sets how late the calling thread's sleeps and
+ * timed waits may expire so nearby timeouts can share one timer interrupt.
+ * slack_us == 0 asks for exact expiry; EX_USER_TIMER_SLACK_DEFAULT restores the
+ * kernel's proportional default.
+ */
+#define EX_USER_TIMER_SLACK_DEFAULT   0xFFFFFFFFFFFFFFFFULL
+#define EX_USER_TIMER_SLACK_MAX_US    100000ULL
+#define EX_USER_TIMER_SLACK_NS_PER_US 1000ULL
+
+/*
+ * SYS_SET_LOG_LEVEL(spec, length) applies a kernel log level spec
+ * "TAG:level[,TAG:level...]" (levels debug, info, warning, error, off; TAG "*"
+ * means every category) and returns the number of entries applied. A malformed
+ * spec changes nothing and fails with EC_ILLEGAL_ARGUMENT. The current levels
+ * are read back through EX_SYSINFO_CLASS_LOG_LEVELS_TEXT.
+ */
+#define EX_USER_LOG_LEVEL_SPEC_MAX_LENGTH 256U
+
 #define EX_USER_SPAWN_FLAG_NONE       0U
 #define EX_USER_SPAWN_FLAG_FOREGROUND 0x00000001U
@@ -34,6 +34,9 @@ typedef enum EX_SYSINFO_CLASS
     EX_SYSINFO_CLASS_MEMMAP_TEXT = 5,
     EX_SYSINFO_CLASS_PROCESS_LIST = 6,
     EX_SYSINFO_CLASS_PROCESS_LIST_TEXT = 7,
+    EX_SYSINFO_CLASS_SPAWN_STATS = 8,
+    EX_SYSINFO_CLASS_FUTEX_STATS = 9,
+    EX_SYSINFO_CLASS_LOG_LEVELS_TEXT = 10,
 } EX_SYSINFO_CLASS;
 
 #define EX_SYSINFO_THREAD_LIST_VERSION     1U
@@ -140,3 +143,46 @@ typedef struct EX_SYSINFO_OVERVIEW
     char BuildDate[12];
     char BuildTime[10];
 } EX_SYSINFO_OVERVIEW;
+
+#define EX_SYSINFO_SPAWN_STATS_VERSION 1U
+
+typedef struct EX_SYSINFO_SPAWN_STATS
+{
+    uint32_t Version;
+    uint32_t Size;
+    uint32_t WorkerCount;
+    uint32_t BatchLimit;
+    uint32_t PendingDepth;
+    uint32_t MaxPendingDepth;
+    uint64_t CompletedCount;
+    uint64_t FailedCount;
+    uint64_t BatchCount;
+    uint32_t MaxBatchSize;
+    uint32_t Reserved;
+    uint64_t QueueWaitTotalNs;
+    uint64_t QueueWaitMaxNs;
+    uint64_t StagingTotalNs;
+    uint64_t StagingMaxNs;
+    uint64_t FirstUserEntryCount;
+    uint64_t FirstUserEntryTotalNs;
+    uint64_t FirstUserEntryMaxNs;
+} EX_SYSINFO_SPAWN_STATS;
+
+#define EX_SYSINFO_FUTEX_STATS_VERSION 1U
+
+typedef struct EX_SYSINFO_FUTEX_STATS
+{
+    uint32_t Version;
+    uint32_t Size;
+    uint32_t BucketCount;
+    uint32_t ActiveWaiters;
+    uint32_t MaxActiveWaiters;
+    uint32_t MaxBucketDepth;
+    uint64_t WaitCount;     // SYS_FUTEX_WAIT calls that passed validation
+    uint64_t BlockCount;    // Waits that actually slept
+    uint64_t MismatchCount; // Waits refused because the word had already changed
+    uint64_t TimeoutCount;
+    uint64_t WakeCount;     // SYS_FUTEX_WAKE calls that passed validation
+    uint64_t WokenCount;    // Waiters released by wake calls
+    uint64_t KillWakeCount; // Waiters released by a kill request
+} EX_SYSINFO_FUTEX_STATS;
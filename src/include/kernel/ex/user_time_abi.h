@@ -0,0 +1,38 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ex/user_time_abi.h
+ * Description: Read-only time page mapped into every user process.
+ *              The kernel publishes a TSC-to-nanosecond conversion under a
+ *              sequence counter so user code can read uptime without a syscall:
+ *
+ *                  ns = BaseNs + (((tsc - BaseTick) * Mult) >> Shift)
+ *
+ *              with a 128-bit product. Readers must retry while Sequence is odd
+ *              or changed across the read, and must fall back to
+ *              EX_USER_SYS_QUERY_SYSINFO when EX_USER_TIME_PAGE_FLAG_TSC is clear.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include <_hobase.h>
+#include <kernel/ex/user_image_abi.h>
+
+// One unmapped page separates the time page from the stack top.
+#define EX_USER_TIME_PAGE_BASE    (EX_USER_IMAGE_WINDOW_END_EXCLUSIVE + EX_USER_IMAGE_PAGE_SIZE)
+#define EX_USER_TIME_PAGE_VERSION 1U
+
+#define EX_USER_TIME_PAGE_FLAG_TSC (1U << 0) // Active source is an invariant TSC; the fast path is valid
+
+typedef struct EX_USER_TIME_PAGE
+{
+    uint32_t Version;
+    uint32_t Sequence; // Odd while the kernel is updating the fields below
+    uint32_t Flags;
+    uint32_t Shift;
+    uint64_t TscFrequencyHz;
+    uint64_t Mult;
+    uint64_t BaseTick;
+    uint64_t BaseNs; // Uptime at BaseTick
+} EX_USER_TIME_PAGE;
@@ -13,8 +13,21 @@
 #include <kernel/log.h>
 // #include "arch/amd64/idt.h"
 
-#if HO_ENABLE_TIMESTAMP_LOG
-#define klog(level, fmt, ...) KLogWriteFmt(level, fmt, ##__VA_ARGS__)
+#if HO_ENABLE_TIMESTAMP_LOG && HO_ENABLE_BINARY_LOG
+// Each call site gets its own format descriptor; see KE_KLOG_FORMAT.
+#define klog(level, fmt, ...)                                                                                          \
+    ({                                                                                                                 \
+        static const KE_KLOG_FORMAT __klogFormat __attribute__((section(".klog_fmt"), used)) = {(level), 0, (fmt)};    \
+        static KE_KLOG_SITE __klogSite;                                                                                \
+        KLogSiteEnabled(&__klogSite, (level), (fmt)) ? KLogWriteBinary(&__klogFormat, ##__VA_ARGS__) : 0;              \
+    })
+#elif HO_ENABLE_TIMESTAMP_LOG
+// The category check stays inline so a disabled line never evaluates its arguments.
+#define klog(level, fmt, ...)                                                                                          \
+    ({                                                                                                                 \
+        static KE_KLOG_SITE __klogSite;                                                                                \
+        KLogSiteEnabled(&__klogSite, (level), (fmt)) ? KLogWriteFmt((level), (fmt), ##__VA_ARGS__) : 0;                \
+    })
 #else
 #define klog(level, fmt, ...)
 #endif
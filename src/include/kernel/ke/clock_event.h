@@ -30,6 +30,12 @@ typedef struct KE_CLOCK_EVENT_PERCPU_STATE
 {
     BOOL Initialized;
     uint64_t InterruptCount;
+    uint64_t TimeoutExpiryCount;  // Timed waits retired by expiry interrupts
+    uint64_t SavedInterruptCount; // Timeout deadlines retired inside their slack window by another expiry
+    uint64_t LatenessSampleCount; // Interrupts matched to a known target TSC
+    uint64_t TotalLatenessCycles; // TSC cycles from target to interrupt entry
+    uint64_t MaxLatenessCycles;
+    uint64_t EarlyFireCount; // Interrupts that arrived before their target TSC
 } KE_CLOCK_EVENT_PERCPU_STATE;
 
 typedef struct KE_CLOCK_EVENT_DEVICE
@@ -51,6 +57,49 @@ HO_KERNEL_API BOOL KeClockEventIsReady(void);
 HO_KERNEL_API uint64_t KeClockEventGetInterruptCount(void);
 HO_KERNEL_API void KeClockEventOnInterrupt(void);
 
+/**
+ * @brief Account one expiry pass of the scheduler timeout queue.
+ * @param expiredCount Timed waits retired by this pass.
+ * @param savedCount   Distinct deadlines among them retired before their own
+ *                     deadline plus slack; each would have needed its own
+ *                     interrupt without coalescing. Deadlines served late are
+ *                     not counted.
+ */
+HO_KERNEL_API void KeClockEventRecordTimeoutExpiry(uint32_t expiredCount, uint32_t savedCount);
+HO_KERNEL_API uint64_t KeClockEventGetTimeoutExpiryCount(void);
+HO_KERNEL_API uint64_t KeClockEventGetSavedInterruptCount(void);
+
+/**
+ * @brief Snapshot timer lateness: interrupt arrival minus the TSC the event was due at.
+ *        Only sampled while the TSC is the calibrated time source.
+ */
+HO_KERNEL_API void KeClockEventGetLateness(uint64_t *sampleCount, uint64_t *totalCycles, uint64_t *maxCycles,
+                                           uint64_t *earlyCount);
+
+/**
+ * @brief Get the active programming mode of the clock event device.
+ */
+HO_KERNEL_API KE_CLOCK_EVENT_MODE KeClockEventGetMode(void);
+
+/**
+ * @brief Whether the LAPIC timer can run in TSC-deadline mode on this machine.
+ *        Requires CPUID.01H:ECX[24] and an invariant TSC as the time source.
+ */
+HO_KERNEL_API BOOL KeClockEventIsTscDeadlineSupported(void);
+
+/**
+ * @brief Switch the clock event device between one-shot and TSC-deadline programming.
+ *        Any armed event is cancelled and replaced by one at the minimum delta so the
+ *        scheduler re-arms in the new mode.
+ * @return EC_SUCCESS; EC_NOT_SUPPORTED if TSC-deadline mode is unavailable.
+ */
+HO_KERNEL_API HO_STATUS KeClockEventSetMode(KE_CLOCK_EVENT_MODE mode);
+
+/**
+ * @brief Refresh the ns->TSC conversion after the time source recalibrated the TSC.
+ */
+HO_KERNEL_API void KeClockEventUpdateTscRate(uint64_t tscFreqHz);
+
 /**
  * @brief Get the frequency of the clock event device.
  * @return Frequency in Hz, or 0 if not initialized.
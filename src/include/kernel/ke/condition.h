@@ -0,0 +1,62 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/condition.h
+ * Description:
+ * Ke Layer - Kernel condition variable object (KCONDITION).
+ * Stateless dispatcher object: a signal wakes the highest-priority waiter,
+ * a broadcast wakes all of them, and nobody waiting means the signal is lost.
+ * KeWaitForCondition releases a KMUTEX or exclusively held KRWLOCK and
+ * queues on the condition atomically, then reacquires the lock before
+ * returning (Mesa semantics: re-check the predicate after every wakeup).
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include <_hobase.h>
+#include <kernel/ke/dispatcher.h>
+
+// ─────────────────────────────────────────────────────────────
+// KCONDITION structure
+// ─────────────────────────────────────────────────────────────
+
+typedef struct KCONDITION
+{
+    KDISPATCHER_HEADER Header; // SignalState is always 0
+} KCONDITION;
+
+// ─────────────────────────────────────────────────────────────
+// KCONDITION API
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * @brief Initialize a kernel condition variable.
+ * @param condition Pointer to KCONDITION to initialize.
+ */
+HO_KERNEL_API void KeInitializeCondition(KCONDITION *condition);
+
+/**
+ * @brief Release a lock, wait for the condition, and reacquire the lock.
+ * @param condition Pointer to the KCONDITION.
+ * @param lock      KMUTEX owned by the caller or KRWLOCK held exclusively by the caller.
+ * @param timeoutNs Relative timeout for the condition wait; the lock reacquire
+ *                  afterwards always waits without a timeout.
+ * @return EC_SUCCESS when signaled; EC_TIMEOUT on timeout (the lock is held again in both cases);
+ *         EC_ILLEGAL_ARGUMENT on invalid arguments; EC_INVALID_STATE if the caller does not own the lock.
+ */
+HO_KERNEL_API HO_STATUS KeWaitForCondition(KCONDITION *condition, void *lock, uint64_t timeoutNs);
+
+/**
+ * @brief Wake the highest-priority thread waiting on a condition variable.
+ * @param condition Pointer to the KCONDITION.
+ * @return Number of threads woken (0 or 1).
+ */
+HO_KERNEL_API uint32_t KeSignalCondition(KCONDITION *condition);
+
+/**
+ * @brief Wake every thread waiting on a condition variable.
+ * @param condition Pointer to the KCONDITION.
+ * @return Number of threads woken.
+ */
+HO_KERNEL_API uint32_t KeBroadcastCondition(KCONDITION *condition);
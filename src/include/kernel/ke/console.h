@@ -71,6 +71,91 @@
 #define ANSI_BG_WHITE   "\x1B[47m"
 #endif
 
+// Serial transmit counters (debug builds, where COM1 mirrors the console).
+typedef struct CONSOLE_SERIAL_TX_STATS
+{
+    BOOL InterruptDriven;
+    uint32_t RingSize;
+    uint32_t QueueDepth;
+    uint32_t MaxQueueDepth;
+    uint64_t QueuedBytes;    // Accepted into the transmit ring
+    uint64_t FifoBytes;      // Sent in FIFO bursts from the THRE interrupt or an idle kick
+    uint64_t PolledBytes;    // Sent while the CPU spun on LSR (polled mode, ring full, flush)
+    uint64_t InterruptCount; // COM1 interrupts taken
+    uint64_t KickCount;      // Bursts started by a producer on an idle transmitter
+    uint64_t RingFullCount;  // Producer stalls on a full ring
+} CONSOLE_SERIAL_TX_STATS;
+
+// Framebuffer glyph rendering counters.
+typedef struct CONSOLE_GLYPH_STATS
+{
+    BOOL Enabled;          // Glyph cache in use; otherwise glyphs go through VdRenderPixel
+    uint32_t Slots;        // Colour pairs kept expanded
+    uint64_t CachedGlyphs; // Drawn by copying pre-expanded rows
+    uint64_t PixelGlyphs;  // Drawn pixel by pixel through the video driver
+    uint64_t SlotHits;
+    uint64_t SlotFills; // Colour pair expanded into a slot (first use or eviction)
+} CONSOLE_GLYPH_STATS;
+
+// When the framebuffer shadow reaches the screen.
+typedef enum CONSOLE_FLUSH_POLICY
+{
+    CONSOLE_FLUSH_IMMEDIATE = 0, // At the end of every console call
+    CONSOLE_FLUSH_ON_NEWLINE,    // At the end of a call that wrote '\n'; partial lines wait
+    CONSOLE_FLUSH_PERIODIC,      // From a periodic timer DPC; output in between is coalesced
+} CONSOLE_FLUSH_POLICY;
+
+typedef struct CONSOLE_FRAMEBUFFER_STATS
+{
+    BOOL Shadowed; // Rendering goes to a RAM shadow; FALSE means straight to video memory
+    BOOL DirtyPending;
+    CONSOLE_FLUSH_POLICY Policy;
+    uint64_t PeriodNs;
+    VD_SHADOW_STATS Shadow;
+} CONSOLE_FRAMEBUFFER_STATS;
+
+typedef struct CONSOLE_GRID_STATS
+{
+    BOOL Enabled; // Scrolls move the line ring instead of framebuffer pixels
+    uint16_t Columns;
+    uint16_t Rows;
+    uint64_t Scrolls;
+    uint64_t RepaintedRows;
+    uint64_t SkippedRows; // Dirty rows that were blank before and after
+} CONSOLE_GRID_STATS;
+
+// Sinks behind the debug-build mux, in the order ConsoleInit adds them.
+typedef enum CONSOLE_SINK_ID
+{
+    CONSOLE_SINK_FRAMEBUFFER = 0,
+    CONSOLE_SINK_SERIAL,
+    CONSOLE_SINK_COUNT,
+} CONSOLE_SINK_ID;
+
+// How a mux sink takes console output. Queued sinks are drained by their own
+// thread; the policy says what happens to an operation that finds the queue full.
+typedef enum CONSOLE_SINK_QUEUE_POLICY
+{
+    CONSOLE_SINK_QUEUE_DIRECT = 0, // No queue: the writer calls the sink itself (boot, panic)
+    CONSOLE_SINK_QUEUE_BLOCK,      // The writer applies the oldest queued operation to make room
+    CONSOLE_SINK_QUEUE_DROP,       // The new operation is dropped
+    CONSOLE_SINK_QUEUE_COALESCE,   // Queued operations a later one overwrites are removed; drop if none are
+} CONSOLE_SINK_QUEUE_POLICY;
+
+// Submitted == Applied + Dropped + Coalesced + Pending.
+typedef struct CONSOLE_SINK_QUEUE_STATS
+{
+    CONSOLE_SINK_QUEUE_POLICY Policy;
+    uint32_t Capacity;   // Operations; 0 until ConsoleStartSinkQueues
+    uint32_t Pending;    // Queued and not yet applied: how far the sink lags the console
+    uint32_t MaxPending;
+    uint64_t Submitted;  // Operations the sink implements, direct ones included
+    uint64_t Applied;
+    uint64_t Dropped;
+    uint64_t Coalesced;  // Removed because a later queued operation overwrote them
+    uint64_t BlockCount; // Writer stalls on a full BLOCK queue
+} CONSOLE_SINK_QUEUE_STATS;
+
 struct KE_CONSOLE_DEVICE; // Opaque
 typedef struct KE_CONSOLE_DEVICE KE_CONSOLE_DEVICE;
 
@@ -86,5 +171,45 @@ HO_PUBLIC_API uint64_t ConsoleWrite(const char *str);
 HO_PUBLIC_API uint64_t ConsoleWriteFmt(const char *fmt, ...);
 HO_PUBLIC_API uint64_t ConsoleWriteVFmt(const char *fmt, VA_LIST args);
 
+// Format into buffer with the console printf rules. Output is truncated to capacity - 1 characters and always
+// NUL-terminated; returns the untruncated length, so a result >= capacity means the text was cut.
+HO_PUBLIC_API uint64_t ConsoleFormatVFmt(char *buffer, uint64_t capacity, const char *fmt, VA_LIST args);
+
 HO_PUBLIC_API void ConsoleClearScreen(COLOR32 color);
 HO_PUBLIC_API void ConsoleFlush(void);
+
+// Route COM1 transmit through a ring drained by the UART THRE interrupt (TRUE) or
+// back to per-byte polling (FALSE). Enabling needs the 8259 already remapped, so
+// it is called after KeInputInit. EC_NOT_SUPPORTED in release builds.
+HO_PUBLIC_API HO_STATUS ConsoleSetSerialTxMode(BOOL interruptDriven);
+HO_PUBLIC_API HO_STATUS ConsoleQuerySerialTxStats(CONSOLE_SERIAL_TX_STATS *stats);
+
+// Write bytes to the serial sink only, bypassing the screen. Pass whole CRLF-terminated lines.
+HO_PUBLIC_API uint64_t ConsoleWriteSerial(const char *buffer, uint64_t length);
+
+// Switch the framebuffer sink between the glyph cache and the per-pixel driver path.
+HO_PUBLIC_API HO_STATUS ConsoleSetGlyphCache(BOOL enable);
+HO_PUBLIC_API HO_STATUS ConsoleQueryGlyphStats(CONSOLE_GLYPH_STATS *stats);
+
+// Render into a cached RAM shadow of the framebuffer from now on. Needs the kernel heap.
+HO_PUBLIC_API HO_STATUS ConsoleEnableShadowBuffer(void);
+// periodNs is only used by CONSOLE_FLUSH_PERIODIC. Pending output is flushed on every switch.
+HO_PUBLIC_API HO_STATUS ConsoleSetFlushPolicy(CONSOLE_FLUSH_POLICY policy, uint64_t periodNs);
+HO_PUBLIC_API HO_STATUS ConsoleQueryFramebufferStats(CONSOLE_FRAMEBUFFER_STATS *stats);
+
+// Character grid behind the screen. Rows it repaints follow the flush policy:
+// they are drawn right before the framebuffer flush that would show them.
+HO_PUBLIC_API HO_STATUS ConsoleSetCellGrid(BOOL enable);
+HO_PUBLIC_API HO_STATUS ConsoleQueryGridStats(CONSOLE_GRID_STATS *stats);
+
+// Give every mux sink a bounded queue and a drain thread, so a slow sink no longer
+// paces the others. Needs the scheduler; until then, and after a panic, sinks are
+// direct. Stats queries and ConsoleFlush wait for the queues they look at.
+// EC_NOT_SUPPORTED in release builds, which have no mux.
+HO_PUBLIC_API HO_STATUS ConsoleStartSinkQueues(void);
+HO_PUBLIC_API HO_STATUS ConsoleSetSinkQueuePolicy(CONSOLE_SINK_ID sink, CONSOLE_SINK_QUEUE_POLICY policy);
+HO_PUBLIC_API HO_STATUS ConsoleQuerySinkQueueStats(CONSOLE_SINK_ID sink, CONSOLE_SINK_QUEUE_STATS *stats);
+
+// Panic path: back to polled serial output with the ring flushed and to immediate framebuffer
+// flushes. Safe with interrupts disabled.
+HO_PUBLIC_API void ConsoleEnterPanicMode(void);
@@ -17,8 +17,19 @@ typedef struct KE_CRITICAL_SECTION
     KE_IRQL_GUARD IrqlGuard;
     uint32_t EnterDepth;
     BOOL Active;
+#if HO_ENABLE_LOCK_PROFILE
+    const char *SiteFunction; // Call site recorded by KeEnterCriticalSection
+    uint32_t SiteLine;
+    uint64_t EnterTsc;
+#endif
 } KE_CRITICAL_SECTION;
 
+#if HO_ENABLE_LOCK_PROFILE
+// The lock profiler attributes hold time to the caller's function and line.
+HO_KERNEL_API void KeEnterCriticalSectionAt(KE_CRITICAL_SECTION *guard, const char *function, uint32_t line);
+#define KeEnterCriticalSection(guard) KeEnterCriticalSectionAt((guard), __func__, (uint32_t)__LINE__)
+#else
 HO_KERNEL_API void KeEnterCriticalSection(KE_CRITICAL_SECTION *guard);
+#endif
 HO_KERNEL_API void KeLeaveCriticalSection(KE_CRITICAL_SECTION *guard);
 HO_KERNEL_API uint32_t KeGetCriticalSectionDepth(void);
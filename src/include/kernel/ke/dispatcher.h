@@ -22,6 +22,9 @@ typedef enum KDISPATCHER_OBJECT_TYPE
     DISPATCHER_TYPE_EVENT = 0,
     DISPATCHER_TYPE_SEMAPHORE,
     DISPATCHER_TYPE_MUTEX,
+    DISPATCHER_TYPE_RWLOCK,
+    DISPATCHER_TYPE_CONDITION,
+    DISPATCHER_TYPE_TIMER,
 } KDISPATCHER_OBJECT_TYPE;
 
 // ─────────────────────────────────────────────────────────────
@@ -34,6 +37,9 @@ typedef struct KDISPATCHER_HEADER
     KDISPATCHER_OBJECT_TYPE Type;
     int32_t SignalState;
     LINKED_LIST_TAG WaitListHead;
+#if HO_ENABLE_LOCK_PROFILE
+    struct KE_LOCK_PROFILE_ENTRY *Profile; // Set by KeRegisterLockProfile, NULL when not profiled
+#endif
 } KDISPATCHER_HEADER;
 
 // ─────────────────────────────────────────────────────────────
@@ -46,8 +52,11 @@ typedef struct KWAIT_BLOCK
     LINKED_LIST_TAG WaitListLink;          // Link in dispatcher object's wait list
     LINKED_LIST_TAG TimeoutLink;           // Link in global timeout queue
     uint64_t DeadlineNs;                   // Absolute timeout deadline (0 = no timeout)
+    uint64_t SlackNs;                      // Tolerated expiry delay past DeadlineNs
     HO_STATUS CompletionStatus;            // EC_SUCCESS or EC_TIMEOUT
     BOOL Completed;                        // Prevents double completion
+    BOOL SharedAcquire;                    // KRWLOCK wait wants shared rather than exclusive access
+    struct KTIMER *Timer;                  // Owning KTIMER when this is a timer's queue entry, NULL for threads
 } KWAIT_BLOCK;
 
 // ─────────────────────────────────────────────────────────────
@@ -0,0 +1,95 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/dpc.h
+ * Description:
+ * Ke Layer - Deferred procedure calls (KDPC).
+ * ISRs queue a KDPC after the minimal hardware acknowledge; the per-CPU queue
+ * is retired at DISPATCH_LEVEL when the IRQL drops out of interrupt context or
+ * out of the outermost IRQL guard. DISPATCH_LEVEL means interrupts disabled in
+ * this kernel, so a drain in the interrupt epilogue extends that interrupt's
+ * interrupt-off window: deferral makes ISRs shorter, not the time interrupts
+ * stay masked. IDT_VECTOR_STATS reports both spans per vector.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include <_hobase.h>
+#include <lib/common/linked_list.h>
+
+#define KDPC_SIGNATURE 0x4B445043U // 'KDPC'
+
+typedef struct KDPC KDPC;
+
+typedef void (*KDPC_ROUTINE)(KDPC *dpc, void *context);
+
+// ─────────────────────────────────────────────────────────────
+// KDPC structure
+// ─────────────────────────────────────────────────────────────
+
+struct KDPC
+{
+    uint32_t Signature;
+    BOOL Queued;
+    LINKED_LIST_TAG QueueLink;
+    KDPC_ROUTINE Routine;
+    void *Context;
+    uint64_t InsertTsc; // TSC stamp of the last insertion, for queue-latency accounting
+};
+
+typedef struct KE_DPC_STATS
+{
+    uint64_t QueuedCount;        // Successful KeInsertQueueDpc calls
+    uint64_t ExecutedCount;      // DPC routines run
+    uint64_t RetireCount;        // Non-empty queue retirements
+    uint64_t TotalRoutineCycles; // TSC cycles spent inside DPC routines
+    uint64_t MaxRoutineCycles;
+    uint64_t TotalQueueCycles; // TSC cycles between insertion and execution
+    uint64_t MaxQueueCycles;
+    uint32_t QueueDepth; // DPCs currently queued
+    uint32_t MaxQueueDepth;
+} KE_DPC_STATS;
+
+// ─────────────────────────────────────────────────────────────
+// KDPC API
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * @brief Initialize a DPC object.
+ * @param dpc     DPC to initialize.
+ * @param routine Routine invoked at DISPATCH_LEVEL with interrupts disabled.
+ * @param context Opaque context handed to the routine.
+ */
+HO_KERNEL_API void KeInitializeDpc(KDPC *dpc, KDPC_ROUTINE routine, void *context);
+
+/**
+ * @brief Queue a DPC on the current CPU.
+ * @return TRUE if the DPC was queued; FALSE if it was already pending.
+ *
+ * Callable from ISRs and from any IRQL. The DPC runs before this function
+ * returns only when the call is made outside interrupt context and outside
+ * every IRQL guard with interrupts enabled, so that the internal critical
+ * section is the outermost guard. Otherwise it runs when the outermost guard
+ * that re-enables interrupts is released or the outermost interrupt context
+ * unwinds.
+ */
+HO_KERNEL_API BOOL KeInsertQueueDpc(KDPC *dpc);
+
+/**
+ * @brief Remove a pending DPC from the queue.
+ * @return TRUE if the DPC was pending and has been removed.
+ */
+HO_KERNEL_API BOOL KeRemoveQueueDpc(KDPC *dpc);
+
+/**
+ * @brief Snapshot DPC queue counters.
+ */
+HO_KERNEL_API void KeQueryDpcStats(KE_DPC_STATS *out);
+
+/**
+ * @brief Run every pending DPC. Caller must be at DISPATCH_LEVEL with interrupts disabled.
+ *        Invoked by the IRQL layer; not meant for drivers.
+ * @return FALSE if a routine switched to another thread before the queue was empty.
+ */
+BOOL KiRetireDpcQueue(void);
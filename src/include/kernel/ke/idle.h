@@ -0,0 +1,64 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/idle.h
+ * Description:
+ * Ke Layer - Idle driver. Halts the CPU with MONITOR/MWAIT armed on the per-CPU
+ * need-resched word when CPUID allows it, falling back to HLT otherwise, and
+ * records idle residency and exit latency.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include <_hobase.h>
+
+// Residency buckets are decades: <10us, <100us, <1ms, <10ms, <100ms, >=100ms.
+#define KE_IDLE_RESIDENCY_BUCKETS 6U
+
+typedef enum KE_IDLE_METHOD
+{
+    KE_IDLE_METHOD_HLT = 0,
+    KE_IDLE_METHOD_MWAIT,
+} KE_IDLE_METHOD;
+
+typedef struct KE_IDLE_STATS
+{
+    uint32_t Method;                                      // KE_IDLE_METHOD
+    uint32_t MonitorLineSize;                             // CPUID.5 largest monitor line (0 for HLT)
+    uint64_t EntryCount;                                  // Times the CPU was halted
+    uint64_t SkippedCount;                                // Entries aborted because need-resched was already set
+    uint64_t InterruptWakeCount;                          // Wakes caused by an interrupt
+    uint64_t MonitorWakeCount;                            // Wakes caused by a store to the need-resched word
+    uint64_t TotalResidencyNs;                            // Halted time, entry to wake event
+    uint64_t MaxResidencyNs;
+    uint64_t ResidencyHistogram[KE_IDLE_RESIDENCY_BUCKETS];
+    uint64_t ExitLatencySamples;                          // Wakes whose exit was measured
+    uint64_t TotalExitLatencyCycles;                      // TSC ticks from wake event to leaving idle
+    uint64_t MaxExitLatencyCycles;
+} KE_IDLE_STATS;
+
+/**
+ * @brief Snapshot the idle driver counters.
+ */
+HO_KERNEL_API void KeQueryIdleStats(KE_IDLE_STATS *out);
+
+/**
+ * @brief Mark that a thread became ready while this CPU idles.
+ *
+ * A plain store to the need-resched word; with MWAIT armed on it this wakes the
+ * CPU without an interrupt.
+ */
+void KiRequestIdleReschedule(void);
+
+/**
+ * @brief Record the wake event for an interrupt that arrives while halted.
+ *        Called by the IRQL layer on entry to the outermost interrupt context.
+ */
+void KiIdleNoteInterrupt(void);
+
+/**
+ * @brief Close a pending exit-latency sample when the CPU leaves the idle thread.
+ *        Called by the dispatcher when switching away from IdleThread.
+ */
+void KiIdleNoteExit(void);
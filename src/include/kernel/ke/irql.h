@@ -45,4 +45,5 @@ HO_KERNEL_API void KeAcquireIrqlGuard(KE_IRQL_GUARD *guard, KE_IRQL targetLevel)
 HO_KERNEL_API void KeReleaseIrqlGuard(KE_IRQL_GUARD *guard);
 
 HO_KERNEL_API void KeEnterInterruptContext(void);
-HO_KERNEL_API void KeLeaveInterruptContext(void);
+// Returns FALSE when the DPC drain on leaving the outermost interrupt switched to another thread.
+HO_KERNEL_API BOOL KeLeaveInterruptContext(void);
@@ -79,7 +79,28 @@ typedef struct KTHREAD_CONTEXT
 // KTHREAD structure
 // ─────────────────────────────────────────────────────────────
 
-#define KTHREAD_FLAG_IDLE (1U << 0)
+#define KTHREAD_FLAG_IDLE      (1U << 0)
+#define KTHREAD_FLAG_LOG_QUIET (1U << 1) // Its DEBUG klog lines wait for the next line instead of waking the drain
+
+// Deadline (EDF) class state. Inactive threads are scheduled by the RR priority queues.
+typedef struct KTHREAD_DEADLINE
+{
+    BOOL Active;
+    BOOL Throttled;      // Budget exhausted; parked until NextReplenishNs
+    BOOL PeriodicWait;   // Blocked in KeThreadWaitNextPeriod; the next job releases on the period boundary
+    uint32_t DensityPpm; // RuntimeNs / RelativeDeadlineNs, charged against admission control
+    uint64_t RuntimeNs;
+    uint64_t PeriodNs;
+    uint64_t RelativeDeadlineNs;
+    uint64_t RemainingNs;        // Budget left until the next replenishment
+    uint64_t AbsoluteDeadlineNs; // EDF ordering key; pushed back one period per replenishment
+    uint64_t JobDeadlineNs;      // Deadline of the current job, used to judge misses
+    uint64_t NextReplenishNs;
+    uint64_t JobCount;
+    uint64_t MissCount;
+    uint64_t ThrottleCount;
+    uint64_t MaxLatenessNs;
+} KTHREAD_DEADLINE;
 
 typedef struct KTHREAD
 {
@@ -93,9 +114,13 @@ typedef struct KTHREAD
     BOOL StackOwnedByKva;
     KE_KVA_RANGE StackRange;
 
-    uint8_t Priority; // KTHREAD_PRIORITY value
-    uint64_t Quantum; // Time slice remaining (nanoseconds)
+    uint8_t Priority;     // Effective KTHREAD_PRIORITY value (includes mutex inheritance boost)
+    uint8_t BasePriority; // Assigned KTHREAD_PRIORITY value before inheritance
+    uint64_t Quantum;     // Time slice remaining (nanoseconds)
+    KTHREAD_DEADLINE Deadline;
+    uint64_t TimerSlackNs; // Slack for sleeps and timed waits, or KE_TIMER_SLACK_DEFAULT
     uint32_t OwnedMutexCount;
+    LINKED_LIST_TAG OwnedMutexList; // KMUTEX objects owned by this thread (inheritance sources)
     KE_IRQL_STATE IrqlState;
 
     KWAIT_BLOCK WaitBlock; // Embedded wait record for unified wait model
@@ -104,6 +129,7 @@ typedef struct KTHREAD
     KTHREAD_TERMINATION_CLAIM_STATE TerminationClaimState;
 
     LINKED_LIST_TAG ReadyLink; // Ready queue / terminated list intrusive node
+    uint64_t ReapQueuedNs;     // KiNowNs() when the thread entered the terminated list
 
     KTHREAD_ENTRY EntryPoint;
     void *EntryArg;
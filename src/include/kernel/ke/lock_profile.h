@@ -0,0 +1,149 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/lock_profile.h
+ * Description:
+ * Ke Layer - Lock contention and hold-time profiler. Built only with
+ * HO_ENABLE_LOCK_PROFILE=1; otherwise every hook compiles to nothing and the
+ * dispatcher header and critical section carry no extra fields.
+ *
+ * Named dispatcher objects report acquisitions, contended acquisitions,
+ * timeouts and TSC wait time. KMUTEX and exclusive KRWLOCK holds also report
+ * hold time; events, semaphores, conditions and shared rwlock holds have no
+ * single owner and report waits only. KE_CRITICAL_SECTION hold time is tracked
+ * per call site (function and line) and includes nested sections.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include <_hobase.h>
+#include <kernel/ke/dispatcher.h>
+
+#define KE_LOCK_PROFILE_NAME_LEN   32U
+#define KE_LOCK_PROFILE_OBJECT_MAX 32U
+#define KE_LOCK_PROFILE_SITE_MAX   64U
+
+typedef enum KE_LOCK_PROFILE_KIND
+{
+    KE_LOCK_PROFILE_KIND_OBJECT = 0,      // Registered dispatcher object
+    KE_LOCK_PROFILE_KIND_CRITICAL_SECTION // KeEnterCriticalSection call site
+} KE_LOCK_PROFILE_KIND;
+
+typedef struct KE_LOCK_PROFILE_RECORD
+{
+    uint32_t Kind;                       // KE_LOCK_PROFILE_KIND
+    uint32_t ObjectType;                 // KDISPATCHER_OBJECT_TYPE, objects only
+    char Name[KE_LOCK_PROFILE_NAME_LEN]; // Registered name, or the enclosing function of a site
+    uint32_t Line;                       // Source line of a critical section site, 0 for objects
+    uint64_t AcquireCount;               // Successful acquisitions / critical section entries
+    uint64_t ContendedCount;             // Acquisitions that had to block first
+    uint64_t TimeoutCount;               // Waits that gave up (including zero-timeout poll misses)
+    uint64_t TotalWaitCycles;            // TSC cycles spent blocked
+    uint64_t MaxWaitCycles;
+    uint64_t TotalHoldCycles;            // TSC cycles owned (mutex, exclusive rwlock, section)
+    uint64_t MaxHoldCycles;
+} KE_LOCK_PROFILE_RECORD;
+
+typedef struct KE_LOCK_PROFILE_SUMMARY
+{
+    BOOL Enabled;                  // FALSE when built without HO_ENABLE_LOCK_PROFILE
+    uint32_t ObjectCount;          // Registered objects
+    uint32_t SiteCount;            // Critical section sites seen so far
+    uint32_t DroppedRegistrations; // Registrations refused because the object table was full
+    uint32_t DroppedSiteEntries;   // Site entries not counted because the site table was full
+} KE_LOCK_PROFILE_SUMMARY;
+
+#if HO_ENABLE_LOCK_PROFILE
+
+/**
+ * @brief Start profiling a dispatcher object under a name.
+ *        The object must stay valid for the rest of the boot (static storage);
+ *        the name pointer is kept, not copied. Re-initializing the object detaches
+ *        it; registering it again resumes its existing entry.
+ * @param object Initialized dispatcher object (KEVENT, KSEMAPHORE, KMUTEX, ...).
+ * @param name   Display name.
+ * @return EC_SUCCESS; EC_ILLEGAL_ARGUMENT on invalid arguments; EC_INVALID_STATE if
+ *         the object is already registered; EC_OUT_OF_RESOURCE if the table is full.
+ *         EC_NOT_SUPPORTED when the profiler is compiled out.
+ */
+HO_KERNEL_API HO_STATUS KeRegisterLockProfile(void *object, const char *name);
+
+static inline void
+KiInitLockProfileHeader(KDISPATCHER_HEADER *header)
+{
+    header->Profile = NULL;
+}
+
+uint64_t KiLockProfileWaitBegin(const KDISPATCHER_HEADER *header);
+void KiLockProfileWaitEnd(KDISPATCHER_HEADER *header, uint64_t startTsc, BOOL blocked, HO_STATUS status);
+void KiLockProfileHoldBegin(KDISPATCHER_HEADER *header);
+void KiLockProfileHoldEnd(KDISPATCHER_HEADER *header);
+void KiLockProfileSiteLeave(const char *function, uint32_t line, uint64_t enterTsc);
+
+#else
+
+static inline void
+KiInitLockProfileHeader(KDISPATCHER_HEADER *header)
+{
+    (void)header;
+}
+
+static inline HO_STATUS
+KeRegisterLockProfile(void *object, const char *name)
+{
+    (void)object;
+    (void)name;
+    return EC_NOT_SUPPORTED;
+}
+
+static inline uint64_t
+KiLockProfileWaitBegin(const KDISPATCHER_HEADER *header)
+{
+    (void)header;
+    return 0;
+}
+
+static inline void
+KiLockProfileWaitEnd(KDISPATCHER_HEADER *header, uint64_t startTsc, BOOL blocked, HO_STATUS status)
+{
+    (void)header;
+    (void)startTsc;
+    (void)blocked;
+    (void)status;
+}
+
+static inline void
+KiLockProfileHoldBegin(KDISPATCHER_HEADER *header)
+{
+    (void)header;
+}
+
+static inline void
+KiLockProfileHoldEnd(KDISPATCHER_HEADER *header)
+{
+    (void)header;
+}
+
+#endif
+
+/**
+ * @brief Snapshot the top offenders, ranked by total wait plus hold cycles.
+ * @param records    Output array, may be NULL when maxRecords is 0.
+ * @param maxRecords Capacity of records.
+ * @param summary    Optional table summary.
+ * @return Number of records written.
+ */
+HO_KERNEL_API uint32_t KeQueryLockProfile(KE_LOCK_PROFILE_RECORD *records, uint32_t maxRecords,
+                                          KE_LOCK_PROFILE_SUMMARY *summary);
+
+/**
+ * @brief Clear all counters. Registrations and known sites are kept.
+ */
+HO_KERNEL_API void KeResetLockProfile(void);
+
+/**
+ * @brief Print the top offenders to the kernel log.
+ * @param maxEntries Number of records to print.
+ */
+HO_KERNEL_API void KeDumpLockProfile(uint32_t maxEntries);
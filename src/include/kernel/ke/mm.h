@@ -71,6 +71,16 @@ typedef struct KE_PT_MAPPING
     uint64_t Attributes;
 } KE_PT_MAPPING;
 
+// Caching type of a 4KB leaf, encoded through PWT/PCD/PAT against HO_PAT_VALUE.
+typedef enum KE_MEMORY_TYPE
+{
+    KE_MEMORY_TYPE_WRITE_BACK = 0,
+    KE_MEMORY_TYPE_WRITE_THROUGH,
+    KE_MEMORY_TYPE_UNCACHED,
+    KE_MEMORY_TYPE_WRITE_COMBINING, // Needs a programmed PAT
+    KE_MEMORY_TYPE_MAX,
+} KE_MEMORY_TYPE;
+
 typedef enum KE_KVA_ARENA_TYPE
 {
     KE_KVA_ARENA_STACK = 0,
@@ -111,6 +121,7 @@ typedef struct KE_KVA_USAGE_INFO
 } KE_KVA_USAGE_INFO;
 
 #define KE_KVA_ACTIVE_RANGE_SNAPSHOT_MAX 16U
+#define KE_KVA_BATCH_FLUSH_ALL_PAGES     32U
 
 typedef struct KE_KVA_ACTIVE_RANGE_ENTRY
 {
@@ -285,11 +296,15 @@ HO_KERNEL_API HO_NODISCARD HO_STATUS KePtQueryPage(const KE_KERNEL_ADDRESS_SPACE
  *
  * Missing intermediate tables are allocated from PMM and accessed through HHDM. Phase one only supports eager 4KB
  * mappings and rejects requests that would require splitting an existing imported large leaf.
+ *
+ * @memoryType selects the caching type; PWT/PCD in @attributes are ignored. KE_MEMORY_TYPE_WRITE_COMBINING fails
+ * with EC_NOT_SUPPORTED when the CPU has no PAT.
  */
 HO_KERNEL_API HO_NODISCARD HO_STATUS KePtMapPage(const KE_KERNEL_ADDRESS_SPACE *space,
                                                  HO_VIRTUAL_ADDRESS virtAddr,
                                                  HO_PHYSICAL_ADDRESS physAddr,
-                                                 uint64_t attributes);
+                                                 uint64_t attributes,
+                                                 KE_MEMORY_TYPE memoryType);
 
 /**
  * Remove an existing 4KB leaf from the imported root page table.
@@ -299,16 +314,56 @@ HO_KERNEL_API HO_NODISCARD HO_STATUS KePtMapPage(const KE_KERNEL_ADDRESS_SPACE *
  */
 HO_KERNEL_API HO_NODISCARD HO_STATUS KePtUnmapPage(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAddr);
 
+/**
+ * Remove an existing 4KB leaf without invalidating its TLB entry.
+ *
+ * Batch teardown paths clear many leaves and then invalidate once through KeFlushTlbPage() or KeFlushTlbAll(). The
+ * caller must complete that flush before the backing frames can be reused.
+ */
+HO_KERNEL_API HO_NODISCARD HO_STATUS KePtUnmapPageDeferred(const KE_KERNEL_ADDRESS_SPACE *space,
+                                                           HO_VIRTUAL_ADDRESS virtAddr);
+
+/**
+ * Invalidate the local TLB entry for one page.
+ */
+HO_KERNEL_API void KeFlushTlbPage(HO_VIRTUAL_ADDRESS virtAddr);
+
+/**
+ * Invalidate every local TLB entry, including global kernel mappings.
+ */
+HO_KERNEL_API void KeFlushTlbAll(void);
+
 /**
  * Update the protection bits of an existing 4KB leaf while preserving its translation.
  *
  * The PT HAL only supports protection updates for 4KB leaves in this phase. Requests that would require large-leaf
- * splitting are rejected with EC_NOT_SUPPORTED.
+ * splitting are rejected with EC_NOT_SUPPORTED. The memory type chosen at map time is kept.
  */
 HO_KERNEL_API HO_NODISCARD HO_STATUS KePtProtectPage(const KE_KERNEL_ADDRESS_SPACE *space,
                                                      HO_VIRTUAL_ADDRESS virtAddr,
                                                      uint64_t attributes);
 
+/**
+ * Change the caching type of an existing 4KB leaf while preserving its translation and protection.
+ *
+ * The caller must make sure no other mapping of the frame uses a different type and must drain anything buffered
+ * under the old type (SFENCE for write-combining) first. Large leaves are rejected with EC_NOT_SUPPORTED.
+ */
+HO_KERNEL_API HO_NODISCARD HO_STATUS KePtRetypePage(const KE_KERNEL_ADDRESS_SPACE *space,
+                                                    HO_VIRTUAL_ADDRESS virtAddr,
+                                                    KE_MEMORY_TYPE memoryType);
+
+/**
+ * Remove every leaf of any size inside a page-aligned range, then flush the TLB once.
+ *
+ * Used to retire imported boot mappings, which may use 2MB or 1GB leaves. A large leaf that extends past either end
+ * of the range fails the call with EC_NOT_SUPPORTED before anything is cleared. Holes are skipped and intermediate
+ * tables are not reclaimed.
+ */
+HO_KERNEL_API HO_NODISCARD HO_STATUS KePtUnmapRange(const KE_KERNEL_ADDRESS_SPACE *space,
+                                                    HO_VIRTUAL_ADDRESS virtAddr,
+                                                    uint64_t size);
+
 /**
  * Run boot-time imported-root and private-root PT self-tests.
  *
@@ -346,7 +401,8 @@ HO_KERNEL_API HO_NODISCARD HO_STATUS KeKvaAllocRange(KE_KVA_ARENA_TYPE arena,
 HO_KERNEL_API HO_NODISCARD HO_STATUS KeKvaMapPage(const KE_KVA_RANGE *range,
                                                   uint64_t usablePageIndex,
                                                   HO_PHYSICAL_ADDRESS physAddr,
-                                                  uint64_t attributes);
+                                                  uint64_t attributes,
+                                                  KE_MEMORY_TYPE memoryType);
 
 /**
  * Map freshly allocated physical backing for a KVA-owned range.
@@ -363,6 +419,15 @@ HO_KERNEL_API HO_NODISCARD HO_STATUS KeKvaMapOwnedPages(const KE_KVA_RANGE *rang
  */
 HO_KERNEL_API HO_NODISCARD HO_STATUS KeKvaReleaseRangeHandle(const KE_KVA_RANGE *range);
 
+/**
+ * Release several ranges under one critical section with a single TLB pass.
+ *
+ * Every handle is validated like `KeKvaReleaseRangeHandle()`. Leaves are cleared without per-page invalidation and
+ * flushed together before the critical section ends: one `invlpg` per page, or a full flush once the batch exceeds
+ * KE_KVA_BATCH_FLUSH_ALL_PAGES. Returns the first failure; ranges after a failing handle are still released.
+ */
+HO_KERNEL_API HO_NODISCARD HO_STATUS KeKvaReleaseRangeHandles(const KE_KVA_RANGE *const *ranges, uint32_t count);
+
 /**
  * Release the current range that owns @usableBase.
  *
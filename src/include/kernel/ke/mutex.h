@@ -5,6 +5,8 @@
  * Description:
  * Ke Layer - Kernel mutex object (KMUTEX).
  * Owner-aware dispatcher object backed by the unified wait model.
+ * Waiters are queued by priority and lend it to the owner chain
+ * (transitive priority inheritance) until the mutex is released.
  * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
  */
 
@@ -23,6 +25,7 @@ typedef struct KMUTEX
 {
     KDISPATCHER_HEADER Header;
     struct KTHREAD *OwnerThread;
+    LINKED_LIST_TAG OwnerLink; // Link in OwnerThread->OwnedMutexList while owned
 } KMUTEX;
 
 // ─────────────────────────────────────────────────────────────
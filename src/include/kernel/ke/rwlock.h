@@ -0,0 +1,98 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/rwlock.h
+ * Description:
+ * Ke Layer - Kernel reader-writer lock object (KRWLOCK).
+ * Writer-preferring dispatcher object backed by the unified wait model:
+ * any number of shared holders or one exclusive owner. Once a writer is
+ * queued, new shared requests wait behind it. A shared holder may upgrade
+ * in place; pending upgrades are served ahead of queued writers.
+ * Unlike KMUTEX, waiters do not lend priority to the holders.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include <_hobase.h>
+#include <kernel/ke/dispatcher.h>
+
+struct KTHREAD;
+
+// ─────────────────────────────────────────────────────────────
+// KRWLOCK structure
+// ─────────────────────────────────────────────────────────────
+
+// Header.SignalState: 0 = free, N > 0 = N shared holders, -1 = exclusively owned.
+typedef struct KRWLOCK
+{
+    KDISPATCHER_HEADER Header;
+    struct KTHREAD *OwnerThread;   // Exclusive owner, NULL otherwise
+    uint32_t ExclusiveWaiterCount; // Queued exclusive waiters (blocks new shared grants)
+    struct KTHREAD *UpgradeWaiter; // Shared holder waiting to upgrade, NULL if none
+} KRWLOCK;
+
+// ─────────────────────────────────────────────────────────────
+// KRWLOCK API
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * @brief Initialize a kernel reader-writer lock in the free state.
+ * @param lock Pointer to KRWLOCK to initialize.
+ */
+HO_KERNEL_API void KeInitializeRwLock(KRWLOCK *lock);
+
+/**
+ * @brief Acquire a reader-writer lock for shared access.
+ *        KeWaitForSingleObject on a KRWLOCK is equivalent to KeAcquireRwLockExclusive.
+ * @param lock      Pointer to the KRWLOCK.
+ * @param timeoutNs Relative timeout; 0 polls, KE_WAIT_INFINITE waits forever.
+ * @return EC_SUCCESS when granted; EC_TIMEOUT on timeout; EC_ILLEGAL_ARGUMENT on invalid arguments;
+ *         EC_INVALID_STATE if the current thread owns the lock exclusively.
+ */
+HO_KERNEL_API HO_STATUS KeAcquireRwLockShared(KRWLOCK *lock, uint64_t timeoutNs);
+
+/**
+ * @brief Acquire a reader-writer lock for exclusive access.
+ * @param lock      Pointer to the KRWLOCK.
+ * @param timeoutNs Relative timeout; 0 polls, KE_WAIT_INFINITE waits forever.
+ * @return EC_SUCCESS when granted; EC_TIMEOUT on timeout; EC_ILLEGAL_ARGUMENT on invalid arguments;
+ *         EC_INVALID_STATE if the current thread already owns the lock exclusively.
+ */
+HO_KERNEL_API HO_STATUS KeAcquireRwLockExclusive(KRWLOCK *lock, uint64_t timeoutNs);
+
+/**
+ * @brief Release one shared hold on a reader-writer lock.
+ * @param lock Pointer to the KRWLOCK.
+ * @return EC_SUCCESS on success; EC_ILLEGAL_ARGUMENT on invalid arguments;
+ *         EC_INVALID_STATE if the lock is not held shared.
+ */
+HO_KERNEL_API HO_STATUS KeReleaseRwLockShared(KRWLOCK *lock);
+
+/**
+ * @brief Release exclusive ownership of a reader-writer lock.
+ * @param lock Pointer to the KRWLOCK.
+ * @return EC_SUCCESS on success; EC_ILLEGAL_ARGUMENT on invalid arguments;
+ *         EC_INVALID_STATE if the current thread does not own the lock exclusively.
+ */
+HO_KERNEL_API HO_STATUS KeReleaseRwLockExclusive(KRWLOCK *lock);
+
+/**
+ * @brief Convert the caller's shared hold into exclusive ownership.
+ *        The caller keeps its shared hold while it waits for the other holders
+ *        to drain, and still holds it shared if the wait times out.
+ * @param lock      Pointer to the KRWLOCK, held shared by the caller.
+ * @param timeoutNs Relative timeout; 0 polls, KE_WAIT_INFINITE waits forever.
+ * @return EC_SUCCESS when upgraded; EC_TIMEOUT on timeout; EC_ILLEGAL_ARGUMENT on invalid arguments;
+ *         EC_INVALID_STATE if the lock is not held shared or another upgrade is already pending.
+ */
+HO_KERNEL_API HO_STATUS KeUpgradeRwLock(KRWLOCK *lock, uint64_t timeoutNs);
+
+/**
+ * @brief Convert the caller's exclusive ownership into a shared hold. Queued
+ *        shared waiters join it unless a writer is also queued.
+ * @param lock Pointer to the KRWLOCK.
+ * @return EC_SUCCESS on success; EC_ILLEGAL_ARGUMENT on invalid arguments;
+ *         EC_INVALID_STATE if the current thread does not own the lock exclusively.
+ */
+HO_KERNEL_API HO_STATUS KeDowngradeRwLock(KRWLOCK *lock);
@@ -14,6 +14,10 @@
 #include <kernel/ke/event.h>
 #include <kernel/ke/mutex.h>
 #include <kernel/ke/semaphore.h>
+#include <kernel/ke/rwlock.h>
+#include <kernel/ke/condition.h>
+#include <kernel/ke/timer.h>
+#include <kernel/ke/idle.h>
 
 // ─────────────────────────────────────────────────────────────
 // Constants
@@ -24,6 +28,30 @@
 #define KE_THREAD_STACK_PAGES 4
 #define KE_THREAD_STACK_SIZE  (KE_THREAD_STACK_PAGES * 0x1000ULL)
 
+// Reaper thread: woken once this many detached threads await teardown, boosted
+// to NORMAL priority past the boost threshold so sustained load cannot starve it,
+// and reclaims at most one batch per critical section / TLB flush.
+#define KE_REAPER_WAKE_THRESHOLD  4U
+#define KE_REAPER_BOOST_THRESHOLD 16U
+#define KE_REAPER_BATCH_SIZE      8U
+
+// Deadline class: parameter bounds and the EDF admission cap. Admission sums
+// runtime/deadline density, so constrained deadlines are tested conservatively;
+// the share above the cap is left to the RR priority queues.
+#define KE_DEADLINE_MIN_RUNTIME_NS  100000ULL      // 100 us
+#define KE_DEADLINE_MIN_PERIOD_NS   1000000ULL     // 1 ms
+#define KE_DEADLINE_MAX_PERIOD_NS   10000000000ULL // 10 s
+#define KE_DEADLINE_PPM_SCALE       1000000ULL
+#define KE_DEADLINE_MAX_DENSITY_PPM 900000U
+
+// Timer slack: how far past its deadline a sleep or timed wait may expire so that
+// nearby timeouts share one clock-event interrupt. Threads start on the default
+// policy (a percentage of each wait, capped); deadline-class threads take none.
+#define KE_TIMER_SLACK_DEFAULT         0xFFFFFFFFFFFFFFFFULL
+#define KE_TIMER_SLACK_DEFAULT_PERCENT 1U
+#define KE_TIMER_SLACK_DEFAULT_MAX_NS  1000000ULL   // 1 ms
+#define KE_TIMER_SLACK_MAX_NS          100000000ULL // 100 ms
+
 // ─────────────────────────────────────────────────────────────
 // Scheduler statistics (returned via sysinfo)
 // ─────────────────────────────────────────────────────────────
@@ -36,6 +64,24 @@ typedef struct KE_SCHEDULER_STATS
     uint64_t YieldCount;
     uint64_t SleepWakeCount;
     uint64_t TotalThreadsCreated;
+    uint64_t PriorityBoostCount;
+    uint32_t ReaperBacklogDepth;
+    uint32_t MaxReaperBacklogDepth;
+    uint64_t ReaperWakeCount;
+    uint64_t ReaperHandOffCount;
+    uint64_t ReaperBatchCount;
+    uint64_t ReapedThreadCount;
+    uint64_t ReclaimLatencyTotalNs;
+    uint64_t ReclaimLatencyMaxNs;
+    uint32_t DeadlineThreadCount;
+    uint32_t DeadlineDensityPpm;
+    uint64_t DeadlineAdmitCount;
+    uint64_t DeadlineRejectCount;
+    uint64_t DeadlineJobCount;
+    uint64_t DeadlineMissCount;
+    uint64_t DeadlineThrottleCount;
+    uint64_t DeadlineReplenishCount;
+    uint64_t DeadlinePreemptionCount;
 } KE_SCHEDULER_STATS;
 
 typedef struct KE_SYSINFO_SCHEDULER_DATA
@@ -54,8 +100,50 @@ typedef struct KE_SYSINFO_SCHEDULER_DATA
     uint64_t YieldCount;
     uint64_t SleepWakeCount;
     uint64_t TotalThreadsCreated;
+    uint64_t PriorityBoostCount;
+    uint32_t ReaperThreadId;
+    uint32_t ReaperBacklogDepth;
+    uint32_t MaxReaperBacklogDepth;
+    uint64_t ReaperWakeCount;
+    uint64_t ReaperHandOffCount;
+    uint64_t ReaperBatchCount;
+    uint64_t ReapedThreadCount;
+    uint64_t ReclaimLatencyTotalNs;
+    uint64_t ReclaimLatencyMaxNs;
+    uint32_t DeadlineThreadCount;
+    uint32_t DeadlineDensityPpm;
+    uint32_t DeadlineReadyDepth;
+    uint32_t DeadlineThrottledDepth;
+    uint64_t DeadlineAdmitCount;
+    uint64_t DeadlineRejectCount;
+    uint64_t DeadlineJobCount;
+    uint64_t DeadlineMissCount;
+    uint64_t DeadlineThrottleCount;
+    uint64_t DeadlineReplenishCount;
+    uint64_t DeadlinePreemptionCount;
+    KE_IDLE_STATS Idle;
 } KE_SYSINFO_SCHEDULER_DATA;
 
+// Deadline class parameters. RuntimeNs == 0 returns the thread to the RR class.
+typedef struct KE_DEADLINE_PARAMS
+{
+    uint64_t RuntimeNs;
+    uint64_t PeriodNs;
+    uint64_t DeadlineNs; // Relative deadline; RuntimeNs <= DeadlineNs <= PeriodNs
+} KE_DEADLINE_PARAMS;
+
+typedef struct KE_DEADLINE_THREAD_STATS
+{
+    BOOL Active;
+    BOOL Throttled;
+    uint64_t JobCount;
+    uint64_t MissCount;
+    uint64_t ThrottleCount;
+    uint64_t MaxLatenessNs;
+    uint64_t RemainingNs;
+    uint64_t AbsoluteDeadlineNs;
+} KE_DEADLINE_THREAD_STATS;
+
 // ─────────────────────────────────────────────────────────────
 // Scheduler API
 // ─────────────────────────────────────────────────────────────
@@ -72,6 +160,54 @@ HO_KERNEL_API HO_NORETURN void KeThreadExit(void);
 HO_KERNEL_API HO_STATUS KeThreadJoin(KTHREAD *thread, uint64_t timeoutNs);
 HO_KERNEL_API HO_STATUS KeThreadDetach(KTHREAD *thread);
 
+/**
+ * @brief Set the base priority of a thread.
+ * @param thread   Target thread (must not be IdleThread or terminated).
+ * @param priority New KTHREAD_PRIORITY value.
+ * @return EC_SUCCESS on success; EC_ILLEGAL_ARGUMENT on invalid arguments;
+ *         EC_INVALID_STATE for IdleThread or terminated threads.
+ *
+ * The effective priority never drops below the highest priority waiting on a
+ * mutex the thread owns; the base value is restored once those mutexes are released.
+ */
+HO_KERNEL_API HO_STATUS KeThreadSetPriority(KTHREAD *thread, uint8_t priority);
+
+/**
+ * @brief Move a thread into (or out of) the deadline scheduling class.
+ * @param thread Target thread (must not be IdleThread or terminated).
+ * @param params Runtime/period/deadline; NULL or RuntimeNs == 0 leaves the class.
+ * @return EC_SUCCESS on success; EC_ILLEGAL_ARGUMENT when the parameters are out
+ *         of bounds; EC_OUT_OF_RESOURCE when admission would push the total
+ *         deadline density past KE_DEADLINE_MAX_DENSITY_PPM; EC_INVALID_STATE for
+ *         IdleThread or terminated threads.
+ *
+ * Ready deadline threads run ahead of every RR priority queue in earliest-deadline
+ * order. Each period grants RuntimeNs of CPU; a thread that exhausts it is throttled
+ * until the next replenishment, which is programmed on the one-shot clock event.
+ */
+HO_KERNEL_API HO_STATUS KeThreadSetDeadline(KTHREAD *thread, const KE_DEADLINE_PARAMS *params);
+
+/**
+ * @brief Set the timer slack applied to a thread's sleeps and timed waits.
+ * @param thread  Target thread (must not be IdleThread or terminated).
+ * @param slackNs Tolerated expiry delay, up to KE_TIMER_SLACK_MAX_NS; 0 asks for
+ *                exact expiry, KE_TIMER_SLACK_DEFAULT restores the default policy.
+ * @return EC_SUCCESS on success; EC_ILLEGAL_ARGUMENT on invalid arguments;
+ *         EC_INVALID_STATE for IdleThread or terminated threads.
+ *
+ * Slack only ever delays a wakeup. The new value applies from the next wait.
+ */
+HO_KERNEL_API HO_STATUS KeThreadSetTimerSlack(KTHREAD *thread, uint64_t slackNs);
+
+/**
+ * @brief Complete the current job of a deadline thread and sleep until the next
+ *        period boundary. A job finishing after its deadline is charged as a miss.
+ * @return EC_SUCCESS; EC_INVALID_STATE when the caller is not a deadline thread.
+ */
+HO_KERNEL_API HO_STATUS KeThreadWaitNextPeriod(void);
+
+HO_KERNEL_API HO_STATUS KeThreadQueryDeadline(KTHREAD *thread, KE_DEADLINE_THREAD_STATS *outStats);
+
 /**
  * @brief Wait for a single dispatcher object to become signaled.
  * @param object    Pointer to a dispatcher object (KEVENT, KSEMAPHORE, KMUTEX, etc.).
@@ -89,7 +225,14 @@ HO_KERNEL_API KTHREAD *KeGetCurrentThread(void);
 HO_KERNEL_API HO_STATUS KeQuerySchedulerInfo(KE_SYSINFO_SCHEDULER_DATA *out);
 
 /**
- * @brief Idle loop — reaps terminated threads and halts the CPU.
+ * @brief Create and start the low-priority reaper thread. Called once during kernel init.
+ *
+ * Until the reaper runs, detached threads are reclaimed only by the idle loop.
+ */
+HO_KERNEL_API HO_STATUS KeReaperInit(void);
+
+/**
+ * @brief Idle loop — reaps terminated threads and halts the CPU through the idle driver.
  *        Called from kmain after scheduler setup; never returns.
  */
 HO_KERNEL_API HO_NORETURN void KeIdleLoop(void);
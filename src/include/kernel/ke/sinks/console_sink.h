@@ -19,10 +19,23 @@ typedef struct
     uint16_t GridHeight;
 } CONSOLE_SINK_INFO;
 
+// One character cell of the console device's grid.
+typedef struct KE_CONSOLE_CELL
+{
+    char Char;
+    COLOR32 Foreground, Background;
+} KE_CONSOLE_CELL;
+
 typedef struct KE_CONSOLE_SINK
 {
     HO_STATUS (*GetInfo)(void *self, CONSOLE_SINK_INFO *info);
     HO_STATUS (*PutChar)(void *self, uint16_t x, uint16_t y, char c, COLOR32 fg, COLOR32 bg);
     HO_STATUS (*Scroll)(void *self, uint16_t count, COLOR32 fillColor);
     HO_STATUS (*Clear)(void *self, COLOR32 fillColor);
+    // Optional: repaint screen row y from count cells, then fill the rest of the
+    // row. Only sinks that keep pixels implement it; a stream sink leaves it NULL.
+    HO_STATUS (*DrawRow)(void *self, uint16_t y, const KE_CONSOLE_CELL *cells, uint16_t count, COLOR32 fillColor);
+    // Optional: push what the sink has buffered out to its device. The console calls
+    // it once per visible update; a sink that writes through leaves it NULL.
+    HO_STATUS (*Flush)(void *self);
 } KE_CONSOLE_SINK;
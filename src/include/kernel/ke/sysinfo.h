@@ -13,6 +13,9 @@
 #include <arch/amd64/pm.h>
 #include <arch/arch.h>
 #include <kernel/ke/mm.h>
+#include <kernel/ke/dpc.h>
+#include <kernel/ke/lock_profile.h>
+#include <kernel/log.h>
 
 // ─────────────────────────────────────────────────────────────
 // Information Class Enumeration
@@ -36,6 +39,9 @@ typedef enum KE_SYSINFO_CLASS
     KE_SYSINFO_SCHEDULER = 13,
     KE_SYSINFO_VMM_OVERVIEW = 14,
     KE_SYSINFO_ACTIVE_KVA_RANGES = 15,
+    KE_SYSINFO_INTERRUPT = 16,
+    KE_SYSINFO_LOCK_PROFILE = 17,
+    KE_SYSINFO_KLOG = 18,
     KE_SYSINFO_MAX
 } KE_SYSINFO_CLASS;
 
@@ -141,11 +147,15 @@ typedef struct SYSINFO_IDT
 // KE_SYSINFO_TIME_SOURCE
 #define SYSINFO_TIME_SOURCE_NAME_LEN 32
 
+#define SYSINFO_TIME_SOURCE_FEATURE_USER_TIME_PAGE (1U << 0) // User time page serves TSC reads without a syscall
+
 typedef struct SYSINFO_TIME_SOURCE
 {
     char Name[SYSINFO_TIME_SOURCE_NAME_LEN];
     uint64_t Frequency;
     uint32_t Features;
+    uint64_t RecalibrationCount;         // Accepted KeTimeSourceRecalibrate() calls
+    uint64_t RejectedRecalibrationCount; // Measurements dropped by the drift check
 } SYSINFO_TIME_SOURCE;
 
 // KE_SYSINFO_UPTIME
@@ -165,17 +175,82 @@ typedef struct SYSINFO_SYSTEM_VERSION
 } SYSINFO_SYSTEM_VERSION;
 
 // KE_SYSINFO_CLOCK_EVENT
+#define SYSINFO_CLOCK_EVENT_MODE_ONE_SHOT     0U // LAPIC initial-count through the divider
+#define SYSINFO_CLOCK_EVENT_MODE_TSC_DEADLINE 1U // Absolute TSC written to IA32_TSC_DEADLINE
+
 typedef struct SYSINFO_CLOCK_EVENT
 {
     BOOL Ready;
-    uint64_t FreqHz;
+    uint32_t Mode; // SYSINFO_CLOCK_EVENT_MODE_*
+    BOOL TscDeadlineSupported;
+    uint64_t FreqHz; // Counter rate of the active mode (LAPIC divider rate or TSC rate)
     uint64_t InterruptCount;
+    uint64_t TimeoutExpiryCount;  // Timed waits retired by expiry interrupts
+    uint64_t SavedInterruptCount; // Expiry interrupts avoided by timer-slack coalescing
     uint64_t MinDeltaNs;
     uint64_t MaxDeltaNs;
+    uint64_t LatenessSampleCount; // Interrupts matched to the TSC they were due at
+    uint64_t TotalLatenessCycles; // TSC cycles from due time to interrupt entry
+    uint64_t MaxLatenessCycles;
+    uint64_t EarlyFireCount; // Interrupts that arrived before they were due
     uint8_t VectorNumber;
     char SourceName[SYSINFO_TIME_SOURCE_NAME_LEN];
 } SYSINFO_CLOCK_EVENT;
 
+// KE_SYSINFO_INTERRUPT
+#define SYSINFO_INTERRUPT_VECTOR_MAX    16U
+#define SYSINFO_WORK_QUEUE_LANE_COUNT   3U
+
+typedef struct SYSINFO_INTERRUPT_VECTOR
+{
+    uint8_t VectorNumber;
+    uint64_t Count;
+    uint64_t TotalHandlerCycles; // TSC cycles in the ISR body
+    uint64_t MaxHandlerCycles;
+    uint64_t TotalInterruptOffCycles; // ISR body plus the epilogue DPC drain, all with interrupts disabled
+    uint64_t MaxInterruptOffCycles;
+    uint64_t SwitchedCount; // Epilogues that switched threads; not in the interrupt-off totals
+} SYSINFO_INTERRUPT_VECTOR;
+
+typedef struct SYSINFO_WORK_QUEUE_LANE
+{
+    uint64_t QueuedCount;
+    uint64_t ExecutedCount;
+    uint32_t PendingDepth;
+    uint32_t MaxPendingDepth;
+    uint32_t WorkerCount;
+} SYSINFO_WORK_QUEUE_LANE;
+
+typedef struct SYSINFO_INTERRUPT
+{
+    uint32_t ReturnedVectorCount;
+    BOOL Truncated;
+    SYSINFO_INTERRUPT_VECTOR Vectors[SYSINFO_INTERRUPT_VECTOR_MAX];
+    KE_DPC_STATS Dpc;
+    BOOL WorkQueueReady;
+    SYSINFO_WORK_QUEUE_LANE WorkQueueLanes[SYSINFO_WORK_QUEUE_LANE_COUNT]; // Indexed by KTHREAD_PRIORITY
+} SYSINFO_INTERRUPT;
+
+// KE_SYSINFO_LOCK_PROFILE
+#define SYSINFO_LOCK_PROFILE_ENTRY_MAX 16U
+
+typedef struct SYSINFO_LOCK_PROFILE
+{
+    KE_LOCK_PROFILE_SUMMARY Summary; // Summary.Enabled is FALSE without HO_ENABLE_LOCK_PROFILE
+    uint32_t ReturnedCount;
+    KE_LOCK_PROFILE_RECORD Entries[SYSINFO_LOCK_PROFILE_ENTRY_MAX]; // Worst first (wait + hold cycles)
+} SYSINFO_LOCK_PROFILE;
+
+// KE_SYSINFO_KLOG
+#define SYSINFO_KLOG_TEXT_MAX 4096U
+
+typedef struct SYSINFO_KLOG
+{
+    KE_KLOG_STATS Stats;
+    uint32_t TextLength;
+    char Text[SYSINFO_KLOG_TEXT_MAX]; // Most recent ring text, oldest first, NUL-terminated
+} SYSINFO_KLOG;
+
 // ─────────────────────────────────────────────────────────────
 // API Function
 // ─────────────────────────────────────────────────────────────
@@ -0,0 +1,57 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/time_convert.h
+ * Description:
+ * Ke Layer - Division-free frequency conversion.
+ * A conversion from a fromHz counter to a toHz unit is precomputed as
+ *
+ *     out = (value * Mult) >> Shift,  Mult = floor((toHz << Shift) / fromHz)
+ *
+ * using a 128-bit product, so the hot path is one mul and one shift instead of
+ * a 128-by-64 divide. Mult is truncated, so a converted value never exceeds the
+ * exact quotient and trails it by at most one unit for results below 2^62.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include <_hobase.h>
+
+typedef struct KE_TIME_CONVERSION
+{
+    uint64_t Mult;
+    uint32_t Shift;
+} KE_TIME_CONVERSION;
+
+/**
+ * @brief Convert a value with a precomputed conversion.
+ *        The caller guarantees the result fits in 64 bits.
+ */
+static inline uint64_t
+KeTimeConvert(const KE_TIME_CONVERSION *conversion, uint64_t value)
+{
+    return (uint64_t)(((__uint128_t)value * conversion->Mult) >> conversion->Shift);
+}
+
+/**
+ * @brief Precompute the conversion from fromHz units to toHz units.
+ *        Picks the largest shift (at most 63) that keeps Mult below 2^63.
+ * @return EC_SUCCESS; EC_ILLEGAL_ARGUMENT if either frequency is 0 or the ratio
+ *         is too large to represent.
+ */
+HO_KERNEL_API HO_STATUS KeTimeConversionInit(KE_TIME_CONVERSION *conversion, uint64_t fromHz, uint64_t toHz);
+
+/**
+ * @brief Reference slow path: (value * mul) / div with a 128-bit intermediate.
+ *        The quotient must fit in 64 bits.
+ */
+HO_KERNEL_API uint64_t KeTimeMulDiv(uint64_t value, uint64_t mul, uint64_t div);
+
+/**
+ * @brief Check a conversion against KeTimeMulDiv over a spread of inputs up to maxValue.
+ * @return EC_SUCCESS if every fast result equals the exact one or trails it by one;
+ *         EC_FAILURE otherwise.
+ */
+HO_KERNEL_API HO_STATUS KeTimeConversionCheck(const KE_TIME_CONVERSION *conversion, uint64_t fromHz, uint64_t toHz,
+                                              uint64_t maxValue);
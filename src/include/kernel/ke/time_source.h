@@ -12,6 +12,7 @@
 
 #include "_hobase.h"
 #include <kernel/ke/sinks/time_sink.h>
+#include <kernel/ke/time_convert.h>
 
 typedef enum TIME_SOURCE_KIND
 {
@@ -32,6 +33,13 @@ typedef struct KE_TIME_DEVICE
     uint64_t StartTick;
     BOOL Initialized;
     TIME_SOURCE_KIND Kind;
+    uint32_t Sequence;                   // Odd while a recalibration rebases the fields below
+    uint64_t BaseTick;                   // Counter value at BaseNs
+    uint64_t BaseNs;                     // Uptime at BaseTick
+    KE_TIME_CONVERSION TickToNs;         // Counter ticks -> ns, no divide on the read path
+    KE_TIME_CONVERSION UsToTick;         // us -> counter ticks for KeBusyWaitUs
+    uint64_t RecalibrationCount;         // Accepted KeTimeSourceRecalibrate() calls
+    uint64_t RejectedRecalibrationCount; // Measurements dropped by the drift check
 } KE_TIME_DEVICE;
 
 /**
@@ -47,6 +55,12 @@ HO_KERNEL_API HO_NODISCARD HO_STATUS KeTimeSourceInit(HO_PHYSICAL_ADDRESS acpiRs
  */
 HO_KERNEL_API uint64_t KeGetSystemUpRealTime(void);
 
+/**
+ * @brief Get system uptime in nanoseconds.
+ * @return Uptime in ns, or 0 before the time source is ready.
+ */
+HO_KERNEL_API uint64_t KeGetSystemUpTimeNs(void);
+
 /**
  * @brief Query whether time source is initialized and usable.
  * @return TRUE if the active time source is ready.
@@ -70,3 +84,41 @@ HO_KERNEL_API void KeBusyWaitUs(uint64_t us);
  * @return Frequency in Hz, or 0 if not initialized.
  */
 HO_KERNEL_API uint64_t KeGetTimeSourceFrequency(void);
+
+
+/**
+ * @brief Re-measure the TSC against the PM timer or HPET and switch to the new
+ *        frequency without a jump in uptime. Busy-waits for roughly 60 ms.
+ *        A result more than 1% away from the current frequency is rejected.
+ * @return EC_SUCCESS if the new frequency was applied; EC_NOT_SUPPORTED if the
+ *         active source is not the TSC or no reference exists; EC_FAILURE if the
+ *         measurement was rejected; EC_INVALID_STATE before initialization.
+ */
+HO_KERNEL_API HO_STATUS KeTimeSourceRecalibrate(void);
+
+/**
+ * @brief Get recalibration counters.
+ * @param acceptedCount Optional, receives the number of applied recalibrations.
+ * @param rejectedCount Optional, receives the number of rejected measurements.
+ */
+HO_KERNEL_API void KeQueryTimeSourceRecalibration(uint64_t *acceptedCount, uint64_t *rejectedCount);
+
+/**
+ * @brief Check the precomputed conversions against the divide path and the
+ *        uptime clock for monotonicity.
+ * @return EC_SUCCESS, or EC_FAILURE on a mismatch.
+ */
+HO_KERNEL_API HO_NODISCARD HO_STATUS KeTimeSourceSelfTest(void);
+
+/**
+ * @brief Query whether the user time page carries a valid TSC conversion.
+ * @return TRUE if the source is an invariant TSC and user code may skip the syscall.
+ */
+HO_KERNEL_API BOOL KeIsUserTimePageFastPath(void);
+
+/**
+ * @brief Get the physical page backing the read-only user time page.
+ *        Every process maps this same page at EX_USER_TIME_PAGE_BASE.
+ * @return Physical address, or 0 before KeTimeSourceInit() succeeds.
+ */
+HO_KERNEL_API HO_PHYSICAL_ADDRESS KeGetUserTimePagePhys(void);
@@ -0,0 +1,80 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/timer.h
+ * Description:
+ * Ke Layer - Kernel timer object (KTIMER).
+ * A waitable dispatcher object that becomes signaled at a due time, once or
+ * periodically, and can queue a KDPC on each expiry. An armed timer sits in the
+ * scheduler's timeout queue next to sleeps and timed waits, so one clock-event
+ * programming covers timers, timeouts and quantum expiry alike.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include <_hobase.h>
+#include <kernel/ke/dispatcher.h>
+#include <kernel/ke/dpc.h>
+
+// ─────────────────────────────────────────────────────────────
+// KTIMER structure
+// ─────────────────────────────────────────────────────────────
+
+typedef enum KTIMER_TYPE
+{
+    KTIMER_NOTIFICATION = 0, // Expiry releases every waiter; stays signaled until set again or cancelled
+    KTIMER_SYNCHRONIZATION,  // Expiry releases one waiter; the signal is consumed by that wait
+} KTIMER_TYPE;
+
+#define KTIMER_FLAG_NONE     0U
+#define KTIMER_FLAG_ABSOLUTE (1U << 0) // Due time is an absolute KeGetSystemUpTimeNs() value
+
+typedef struct KTIMER
+{
+    KDISPATCHER_HEADER Header;
+    KTIMER_TYPE Type;
+    KWAIT_BLOCK TimeoutEntry; // Entry in the scheduler timeout queue while armed
+    uint64_t PeriodNs;        // 0 for one-shot
+    KDPC *Dpc;                // Queued at DISPATCH_LEVEL on every expiry, may be NULL
+    BOOL Armed;
+    uint64_t ExpiryCount;
+} KTIMER;
+
+// ─────────────────────────────────────────────────────────────
+// KTIMER API
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * @brief Initialize a kernel timer in the non-signaled, disarmed state.
+ * @param timer Pointer to KTIMER to initialize.
+ * @param type  KTIMER_NOTIFICATION or KTIMER_SYNCHRONIZATION.
+ */
+HO_KERNEL_API void KeInitializeTimer(KTIMER *timer, KTIMER_TYPE type);
+
+/**
+ * @brief Arm a timer. A timer that is already armed is re-armed; either way the
+ *        timer becomes non-signaled until the new due time.
+ * @param timer     Pointer to the KTIMER.
+ * @param dueTimeNs Relative delay, or absolute uptime with KTIMER_FLAG_ABSOLUTE.
+ *                  A due time already in the past expires on the next clock event.
+ * @param periodNs  Re-arm interval after each expiry, 0 for one-shot.
+ * @param dpc       Optional DPC queued on each expiry.
+ * @param flags     KTIMER_FLAG_*.
+ * @return EC_SUCCESS; EC_ILLEGAL_ARGUMENT on invalid arguments.
+ *
+ * Callable at any IRQL up to DISPATCH_LEVEL, including from the timer's own DPC.
+ */
+HO_KERNEL_API HO_STATUS KeSetTimer(KTIMER *timer, uint64_t dueTimeNs, uint64_t periodNs, KDPC *dpc, uint32_t flags);
+
+/**
+ * @brief Disarm a timer. Its signal state is left as it is, and a DPC already
+ *        queued by an earlier expiry still runs.
+ * @return TRUE if the timer was armed.
+ */
+HO_KERNEL_API BOOL KeCancelTimer(KTIMER *timer);
+
+/**
+ * @brief Read whether a timer is currently signaled.
+ */
+HO_KERNEL_API BOOL KeReadStateTimer(KTIMER *timer);
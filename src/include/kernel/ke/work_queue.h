@@ -0,0 +1,100 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/work_queue.h
+ * Description:
+ * Ke Layer - Kernel work queue backed by a small pool of worker threads.
+ * One lane per KTHREAD_PRIORITY; each lane is served by its own workers
+ * running at the lane priority, so work items execute at PASSIVE_LEVEL with
+ * interrupts enabled.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include <_hobase.h>
+#include <lib/common/linked_list.h>
+#include <kernel/ke/kthread.h>
+
+#define KE_WORK_ITEM_SIGNATURE          0x4B574B49U // 'KWKI'
+#define KE_WORK_QUEUE_WORKERS_PER_LANE  1U
+#define KE_WORK_QUEUE_LANE_COUNT        ((uint32_t)KTHREAD_PRIORITY_COUNT)
+
+typedef struct KWORK_ITEM KWORK_ITEM;
+
+typedef void (*KWORK_ROUTINE)(KWORK_ITEM *item, void *context);
+
+// ─────────────────────────────────────────────────────────────
+// KWORK_ITEM structure
+// ─────────────────────────────────────────────────────────────
+
+struct KWORK_ITEM
+{
+    uint32_t Signature;
+    BOOL Queued;
+    uint8_t Lane;
+    LINKED_LIST_TAG QueueLink;
+    KWORK_ROUTINE Routine;
+    void *Context;
+};
+
+typedef struct KE_WORK_QUEUE_LANE_STATS
+{
+    uint64_t QueuedCount;
+    uint64_t ExecutedCount;
+    uint32_t PendingDepth;
+    uint32_t MaxPendingDepth;
+    uint32_t WorkerCount;
+} KE_WORK_QUEUE_LANE_STATS;
+
+// ─────────────────────────────────────────────────────────────
+// Work queue API
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * @brief Create and start the worker pool. Called once during kernel init.
+ */
+HO_KERNEL_API HO_STATUS KeWorkQueueInit(void);
+
+/**
+ * @brief Query whether the worker pool is running.
+ */
+HO_KERNEL_API BOOL KeWorkQueueIsReady(void);
+
+/**
+ * @brief Initialize a work item.
+ * @param item    Work item to initialize.
+ * @param routine Routine invoked by a worker thread at PASSIVE_LEVEL.
+ * @param context Opaque context handed to the routine.
+ */
+HO_KERNEL_API void KeInitializeWorkItem(KWORK_ITEM *item, KWORK_ROUTINE routine, void *context);
+
+/**
+ * @brief Queue a work item on a priority lane.
+ * @param item     Initialized work item.
+ * @param priority Lane selector (KTHREAD_PRIORITY value).
+ * @return EC_SUCCESS when queued; EC_INVALID_STATE if already pending or the pool
+ *         is not running; EC_ILLEGAL_ARGUMENT on invalid arguments.
+ *
+ * Callable at any IRQL; never blocks. At PASSIVE_LEVEL the worker is woken
+ * at once, which may switch to it. Above PASSIVE_LEVEL (ISRs, DPCs, IRQL
+ * guards) the wake is deferred until the DPC queue has drained on the way
+ * back down, so the call itself never switches threads.
+ */
+HO_KERNEL_API HO_STATUS KeQueueWorkItem(KWORK_ITEM *item, uint8_t priority);
+
+/**
+ * @brief Snapshot the counters of one lane.
+ */
+HO_KERNEL_API HO_STATUS KeQueryWorkQueueLaneStats(uint8_t priority, KE_WORK_QUEUE_LANE_STATS *out);
+
+/**
+ * @brief TRUE while worker wakes deferred above PASSIVE_LEVEL are waiting. Called by the DPC drain.
+ */
+BOOL KiWorkQueueHasDeferredWakes(void);
+
+/**
+ * @brief Wake the workers for items queued above PASSIVE_LEVEL. Called at DISPATCH_LEVEL with interrupts
+ *        disabled once the DPC queue is empty; may switch threads.
+ */
+void KiWorkQueueFlushDeferredWakes(void);
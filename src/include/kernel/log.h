@@ -2,7 +2,13 @@
  * HimuOperatingSystem PUBLIC HEADER
  *
  * File: log.h
- * Description: Kernel log APIs with optional uptime timestamp prefix.
+ * Description: Kernel log APIs with optional uptime timestamp prefix. Lines are
+ *              formatted into a per-CPU ring and pushed to the console by a
+ *              low-priority drain thread once it runs; before that, and after a
+ *              panic, klog writes synchronously. With HO_ENABLE_BINARY_LOG, klog
+ *              stores a format ID and raw arguments instead of text. Each line
+ *              belongs to the category named by its "[TAG]" prefix, and each
+ *              category has its own runtime level.
  * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
  */
 
@@ -16,10 +22,173 @@ enum KE_LOG_LEVEL
     KLOG_LEVEL_INFO,
     KLOG_LEVEL_WARNING,
     KLOG_LEVEL_ERROR,
+    KLOG_LEVEL_OFF, // Category threshold only; never passed to klog
 };
 
 #ifndef HO_LOG_MIN_LEVEL
 #define HO_LOG_MIN_LEVEL KLOG_LEVEL_DEBUG
 #endif
 
+#ifndef HO_ENABLE_BINARY_LOG
+#define HO_ENABLE_BINARY_LOG 0
+#endif
+
+#ifndef HO_BINARY_LOG_MIXED
+#define HO_BINARY_LOG_MIXED 1 // Binary mode still formats WARNING and above as text
+#endif
+
+/**
+ * @brief Format and queue one line. Only HO_LOG_MIN_LEVEL applies here; the
+ *        category level is checked by klog before the call.
+ */
 HO_KERNEL_API uint64_t KLogWriteFmt(enum KE_LOG_LEVEL level, const char *fmt, ...);
+
+// ─────────────────────────────────────────────────────────────
+// Log categories
+// ─────────────────────────────────────────────────────────────
+
+#define KE_KLOG_CATEGORY_MAX   64U  // Registered tags; later tags share the default level
+#define KE_KLOG_TAG_MAX        15U  // Longest tag, brackets excluded
+#define KE_KLOG_UNTAGGED       "-"  // Category of lines without a "[TAG]" prefix
+#define KE_KLOG_ALL_TAGS       "*"  // KLogSetCategoryLevel: every category and the default
+#define KE_KLOG_LEVEL_SPEC_MAX 256U // Longest spec accepted by KLogApplyLevelSpec
+
+// One per klog call site. Threshold points at the level byte of the site's
+// category once the first call has resolved the "[TAG]" prefix, so a disabled
+// line costs two loads and a compare and never reaches the varargs call.
+typedef struct KE_KLOG_SITE
+{
+    const volatile uint8_t *Threshold;
+} KE_KLOG_SITE;
+
+/**
+ * @brief Bind a call site to the category named by its format prefix,
+ *        registering the category at the default level if it is new. Called
+ *        through KLogSiteEnabled, never directly.
+ */
+HO_KERNEL_API const volatile uint8_t *KLogResolveSite(KE_KLOG_SITE *site, const char *fmt);
+
+static inline BOOL
+KLogSiteEnabled(KE_KLOG_SITE *site, enum KE_LOG_LEVEL level, const char *fmt)
+{
+    if (level < HO_LOG_MIN_LEVEL)
+        return FALSE;
+
+    const volatile uint8_t *threshold = site->Threshold;
+    if (__builtin_expect(threshold == NULL, 0))
+        threshold = KLogResolveSite(site, fmt);
+    return (uint8_t)level >= *threshold;
+}
+
+/**
+ * @brief Set the runtime level of one category, registering it if needed so a
+ *        level set at boot applies to call sites that have not run yet.
+ *        KE_KLOG_ALL_TAGS sets every category and the default for new ones.
+ *        Levels below HO_LOG_MIN_LEVEL are accepted but stay compiled out.
+ */
+HO_KERNEL_API HO_STATUS KLogSetCategoryLevel(const char *tag, uint32_t tagLength, enum KE_LOG_LEVEL level);
+
+/**
+ * @brief Apply a level spec "TAG:level[,TAG:level...]", where level is one of
+ *        debug, info, warning, error or off and TAG may be KE_KLOG_ALL_TAGS.
+ *        The whole spec is checked before any level changes.
+ * @param outUpdated Optional; receives the number of entries applied.
+ */
+HO_KERNEL_API HO_STATUS KLogApplyLevelSpec(const char *spec, uint32_t length, uint32_t *outUpdated);
+
+/**
+ * @brief Write "default=<level>" and one "<TAG> <level>" line per category.
+ * @return Bytes written, excluding the terminating NUL.
+ */
+HO_KERNEL_API uint32_t KLogFormatCategoryLevels(char *buffer, uint32_t capacity);
+
+// ─────────────────────────────────────────────────────────────
+// Binary log records
+// ─────────────────────────────────────────────────────────────
+
+// One per klog call site, collected by the linker into the .klog_fmt output
+// section. A record's format ID is the descriptor's index in that section;
+// scripts/klog_decode.py reads the section back out of kernel.bin.
+typedef struct KE_KLOG_FORMAT
+{
+    uint32_t Level; // enum KE_LOG_LEVEL
+    uint32_t Reserved;
+    const char *Format;
+} KE_KLOG_FORMAT;
+
+#define KE_KLOG_BINARY_TAG      "@KLOG "  // Serial line prefix of a hex-encoded binary record
+#define KE_KLOG_BINARY_NO_TIME  (~0ULL)   // TimestampUs before the time source is ready
+#define KE_KLOG_BINARY_ARGS_CUT (1U << 0) // Arguments did not fit in KE_KLOG_LINE_MAX
+
+// Record payload. Arguments follow in format order: %s and %ke as a uint16_t
+// length and the bytes (no NUL), everything else as a uint64_t.
+typedef struct KE_KLOG_BINARY_HEADER
+{
+    uint32_t FormatId;
+    uint32_t Flags; // KE_KLOG_BINARY_*
+    uint64_t TimestampUs;
+} KE_KLOG_BINARY_HEADER;
+
+/**
+ * @brief Queue a binary record for a klog call site. Only the format ID, the
+ *        uptime and the raw arguments are stored; the host decoder formats them.
+ *        Falls back to text in panic mode and, with HO_BINARY_LOG_MIXED, for
+ *        WARNING and above. Called through klog, never directly.
+ */
+HO_KERNEL_API uint64_t KLogWriteBinary(const KE_KLOG_FORMAT *format, ...);
+
+// ─────────────────────────────────────────────────────────────
+// Log ring
+// ─────────────────────────────────────────────────────────────
+
+#define KE_KLOG_RING_SIZE (64U * 1024U) // Per-CPU ring bytes, power of two
+#define KE_KLOG_LINE_MAX  256U          // Longest formatted line, prefix included; longer lines are cut
+
+typedef enum KE_KLOG_MODE
+{
+    KE_KLOG_MODE_SYNC = 0, // Early boot: the producer drains the ring itself
+    KE_KLOG_MODE_ASYNC,    // The drain thread pushes records to the console
+    KE_KLOG_MODE_PANIC,    // Halting: every line is written through immediately
+} KE_KLOG_MODE;
+
+typedef struct KE_KLOG_STATS
+{
+    uint32_t Mode;             // KE_KLOG_MODE
+    uint32_t RingSize;
+    uint64_t RecordCount;      // Lines committed to the ring
+    uint64_t DroppedCount;     // Lines lost because undrained text filled the ring
+    uint64_t TruncatedCount;   // Lines cut at KE_KLOG_LINE_MAX
+    uint64_t DirectWriteCount; // Lines that bypassed the ring (no room in sync or panic mode)
+    uint64_t DrainedCount;     // Records pushed to the console
+    uint64_t DrainWakeCount;   // Drain thread wakeups
+    uint64_t BinaryCount;      // Records committed in binary form (HO_ENABLE_BINARY_LOG)
+    uint32_t PendingBytes;     // Committed or reserved bytes not yet drained
+    uint32_t MaxPendingBytes;
+} KE_KLOG_STATS;
+
+/**
+ * @brief Start the log drain thread and switch klog to asynchronous mode.
+ *        Requires the scheduler; lines logged before this were written synchronously.
+ */
+HO_KERNEL_API HO_STATUS KLogStartDrainThread(void);
+
+/**
+ * @brief Push every committed record to the console on the caller. No-op while
+ *        another context is draining.
+ */
+HO_KERNEL_API void KLogFlush(void);
+
+/**
+ * @brief Flush the ring regardless of a drain in progress and make all later
+ *        klog calls synchronous. Called by KernelHalt before the stop screen.
+ */
+HO_KERNEL_API void KLogEnterPanicMode(void);
+
+HO_KERNEL_API void KLogQueryStats(KE_KLOG_STATS *out);
+
+/**
+ * @brief Copy the most recent ring text, drained or not, oldest first. Binary
+ *        records are skipped.
+ * @return Bytes copied, excluding the terminating NUL.
+ */
+HO_KERNEL_API uint32_t KLogReadRecent(char *buffer, uint32_t capacity);
@@ -35,4 +35,33 @@ HO_PUBLIC_API BOOL IsValidBase(int base);
  * @param ...: Additional arguments to format.
  * @returns: The length of the formatted string actually required (not including the null terminator).
  */
-// HO_PUBLIC_API size_t FormatString(char *buffer, size_t len, const char *format, ...);
\ No newline at end of file
+// HO_PUBLIC_API size_t FormatString(char *buffer, size_t len, const char *format, ...);
+
+// memcpy, memmove and memset pick their strategy from these CPU features, detected on first use.
+#define MEM_FEATURE_DETECTED    (1U << 0)
+#define MEM_FEATURE_ERMS        (1U << 1) // Enhanced rep movsb/stosb
+#define MEM_FEATURE_FSRM        (1U << 2) // Fast short rep movsb
+#define MEM_FEATURE_NONTEMPORAL (1U << 3) // Streaming stores for copies and fills past the threshold
+#define MEM_FEATURE_SSE2        (1U << 4) // 16-byte loops; only in builds that may touch vector registers
+#define MEM_FEATURE_AVX2        (1U << 5) // 32-byte loops; also needs the OS to have enabled YMM state
+
+/**
+ * MemQueryFeatures: Report the features the memory routines currently use.
+ * @param outDetected: Optional; receives everything the CPU and the build support.
+ * @returns: The enabled subset (always includes MEM_FEATURE_DETECTED).
+ */
+HO_PUBLIC_API uint32_t MemQueryFeatures(uint32_t *outDetected);
+
+/**
+ * MemRestrictFeatures: Limit the memory routines to the detected features in mask. Meant for benchmarks and
+ * bring-up; pass ~0U to enable everything again.
+ * @returns: The previously enabled features.
+ */
+HO_PUBLIC_API uint32_t MemRestrictFeatures(uint32_t mask);
+
+/**
+ * MemSetNonTemporalThreshold: Set the size from which copies and fills use streaming stores.
+ * @param bytes: New threshold, or 0 for the one derived from the last-level cache size.
+ * @returns: The previous threshold.
+ */
+HO_PUBLIC_API size_t MemSetNonTemporalThreshold(size_t bytes);
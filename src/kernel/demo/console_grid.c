@@ -0,0 +1,161 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/console_grid.c
+ * Description: Console cell grid profile. Floods the screen with the same
+ *              block of lines with the grid off (every scroll moves framebuffer
+ *              pixels) and on (every scroll bumps the line ring), once as a
+ *              single console write and once line by line under the periodic
+ *              flush policy, and reports cycles per line for each. Also checks
+ *              that an ANSI erase repaints only its own row.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <libc/string.h>
+
+#define CONSOLE_GRID_DEMO_LINES     128U
+#define CONSOLE_GRID_DEMO_PERIOD_NS 20000000ULL // 20 ms
+#define CONSOLE_GRID_DEMO_LINE      "[GRID] 0123456789abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ\n"
+
+// The single-write flood: CONSOLE_GRID_DEMO_LINES copies of the line.
+static char gConsoleGridDemoBlock[CONSOLE_GRID_DEMO_LINES * (sizeof(CONSOLE_GRID_DEMO_LINE) - 1U) + 1U];
+
+typedef struct CONSOLE_GRID_DEMO_RESULT
+{
+    uint64_t BlockCycles;
+    uint64_t LineCycles;
+    CONSOLE_GRID_STATS Delta;
+} CONSOLE_GRID_DEMO_RESULT;
+
+static void
+KiConsoleGridDemoQuery(CONSOLE_GRID_STATS *stats)
+{
+    HO_STATUS status = ConsoleQueryGridStats(stats);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "console_grid: failed to query grid stats");
+}
+
+static void
+KiConsoleGridDemoSetPolicy(CONSOLE_FLUSH_POLICY policy, uint64_t periodNs)
+{
+    HO_STATUS status = ConsoleSetFlushPolicy(policy, periodNs);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "console_grid: failed to set flush policy");
+}
+
+static void
+KiConsoleGridDemoRun(BOOL grid, CONSOLE_GRID_DEMO_RESULT *result)
+{
+    HO_STATUS status = ConsoleSetCellGrid(grid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "console_grid: failed to switch the cell grid");
+
+    ConsoleClearScreen(HO_CONSOLE_DEFAULT_BACKGROUND);
+    CONSOLE_GRID_STATS before = {0};
+    KiConsoleGridDemoQuery(&before);
+
+    uint64_t startTsc = rdtsc();
+    (void)ConsoleWrite(gConsoleGridDemoBlock);
+    result->BlockCycles = rdtsc() - startTsc;
+
+    KiConsoleGridDemoSetPolicy(CONSOLE_FLUSH_PERIODIC, CONSOLE_GRID_DEMO_PERIOD_NS);
+    startTsc = rdtsc();
+    for (uint32_t index = 0; index < CONSOLE_GRID_DEMO_LINES; ++index)
+        (void)ConsoleWrite(CONSOLE_GRID_DEMO_LINE);
+    result->LineCycles = rdtsc() - startTsc;
+    KiConsoleGridDemoSetPolicy(CONSOLE_FLUSH_IMMEDIATE, 0);
+
+    CONSOLE_GRID_STATS after = {0};
+    KiConsoleGridDemoQuery(&after);
+    result->Delta = after;
+    result->Delta.Scrolls -= before.Scrolls;
+    result->Delta.RepaintedRows -= before.RepaintedRows;
+    result->Delta.SkippedRows -= before.SkippedRows;
+}
+
+static void
+KiConsoleGridDemoReport(const char *mode, const CONSOLE_GRID_DEMO_RESULT *result)
+{
+    klog(KLOG_LEVEL_INFO, "[GRID] %s: block cycles/line=%lu periodic cycles/line=%lu scrolls=%lu repainted=%lu\n",
+         mode, (unsigned long)(result->BlockCycles / CONSOLE_GRID_DEMO_LINES),
+         (unsigned long)(result->LineCycles / CONSOLE_GRID_DEMO_LINES), (unsigned long)result->Delta.Scrolls,
+         (unsigned long)result->Delta.RepaintedRows);
+}
+
+static void
+KiConsoleGridDemoCheckErase(void)
+{
+    ConsoleClearScreen(HO_CONSOLE_DEFAULT_BACKGROUND);
+    (void)ConsoleWrite("[GRID] erase me\n[GRID] keep me");
+
+    CONSOLE_GRID_STATS before = {0};
+    KiConsoleGridDemoQuery(&before);
+    (void)ConsoleWrite("\r" ANSI_FG_GREEN "\x1B[2K[GRID] erased and rewritten" ANSI_RESET "\n");
+    CONSOLE_GRID_STATS after = {0};
+    KiConsoleGridDemoQuery(&after);
+
+    if (after.RepaintedRows - before.RepaintedRows != 1 || after.Scrolls != before.Scrolls)
+        HO_KPANIC(EC_INVALID_STATE, "console_grid: erase-in-line did not repaint exactly its row");
+}
+
+static void
+KiConsoleGridDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    // Time the framebuffer sink itself, not the queue in front of it.
+    CONSOLE_SINK_QUEUE_STATS queue = {0};
+    (void)ConsoleQuerySinkQueueStats(CONSOLE_SINK_FRAMEBUFFER, &queue);
+    (void)ConsoleSetSinkQueuePolicy(CONSOLE_SINK_FRAMEBUFFER, CONSOLE_SINK_QUEUE_DIRECT);
+
+    CONSOLE_GRID_STATS boot = {0};
+    KiConsoleGridDemoQuery(&boot);
+    if (!boot.Enabled || boot.Rows == 0 || boot.Columns == 0)
+        HO_KPANIC(EC_INVALID_STATE, "console_grid: cell grid is not enabled after boot");
+    if (boot.Rows >= CONSOLE_GRID_DEMO_LINES)
+        HO_KPANIC(EC_INVALID_STATE, "console_grid: screen too tall for the flood to scroll");
+
+    uint64_t lineLength = sizeof(CONSOLE_GRID_DEMO_LINE) - 1U;
+    for (uint32_t index = 0; index < CONSOLE_GRID_DEMO_LINES; ++index)
+        memcpy(gConsoleGridDemoBlock + index * lineLength, CONSOLE_GRID_DEMO_LINE, lineLength);
+    gConsoleGridDemoBlock[CONSOLE_GRID_DEMO_LINES * lineLength] = '\0';
+
+    CONSOLE_GRID_DEMO_RESULT pixels = {0};
+    CONSOLE_GRID_DEMO_RESULT grid = {0};
+    KiConsoleGridDemoRun(FALSE, &pixels);
+    KiConsoleGridDemoRun(TRUE, &grid);
+
+    if (pixels.Delta.Scrolls != 0 || pixels.Delta.RepaintedRows != 0)
+        HO_KPANIC(EC_INVALID_STATE, "console_grid: disabled grid still scrolled the ring");
+    if (grid.Delta.Scrolls < 2U * (CONSOLE_GRID_DEMO_LINES - boot.Rows))
+        HO_KPANIC(EC_INVALID_STATE, "console_grid: grid flood did not scroll through the ring");
+    if (grid.BlockCycles >= pixels.BlockCycles || grid.LineCycles >= pixels.LineCycles)
+        HO_KPANIC(EC_INVALID_STATE, "console_grid: grid scrolling is not faster than moving pixels");
+
+    KiConsoleGridDemoCheckErase();
+
+    KiConsoleGridDemoReport("pixels", &pixels);
+    KiConsoleGridDemoReport("grid", &grid);
+    klog(KLOG_LEVEL_INFO, "[GRID] grid %ux%u skipped blank rows=%lu\n", boot.Columns, boot.Rows,
+         (unsigned long)grid.Delta.SkippedRows);
+    (void)ConsoleSetSinkQueuePolicy(CONSOLE_SINK_FRAMEBUFFER, queue.Policy);
+    klog(KLOG_LEVEL_INFO, "[GRID] console grid regression passed\n");
+}
+
+void
+RunConsoleGridDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiConsoleGridDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create console grid controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start console grid controller thread");
+}
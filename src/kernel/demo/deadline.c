@@ -0,0 +1,302 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/deadline.c
+ * Description: Deadline class profile. Checks admission control, then runs the
+ *              same periodic workload as an RR thread and as a deadline thread
+ *              against CPU-bound hogs and compares deadline misses. A final
+ *              overrunning job must be throttled and replenished, and the
+ *              deadline_probe payload covers the user syscall surface.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <kernel/ex/ex_process.h>
+#include <kernel/ke/time_source.h>
+
+#define DEADLINE_DEMO_HOG_COUNT     2U
+#define DEADLINE_DEMO_JOB_COUNT     50U
+#define DEADLINE_DEMO_PERIOD_NS     20000000ULL // 20 ms
+#define DEADLINE_DEMO_DEADLINE_NS   10000000ULL // 10 ms
+#define DEADLINE_DEMO_RUNTIME_NS    4000000ULL  // 4 ms budget
+#define DEADLINE_DEMO_WORK_US       2000ULL     // 2 ms of work per job
+#define DEADLINE_DEMO_OVERRUN_JOBS  5U
+#define DEADLINE_DEMO_OVERRUN_RT_NS 1000000ULL // 1 ms budget against 3 ms of work
+#define DEADLINE_DEMO_OVERRUN_US    3000ULL
+
+typedef struct DEADLINE_DEMO_RESULT
+{
+    uint64_t RuntimeNs;
+    uint64_t WorkUs;
+    uint32_t JobTarget;
+    uint32_t JobCount;
+    uint32_t MissCount;
+    uint64_t MaxLatenessNs;
+    KE_DEADLINE_THREAD_STATS Stats;
+} DEADLINE_DEMO_RESULT;
+
+static volatile BOOL gDeadlineDemoStopHogs;
+static volatile uint64_t gDeadlineDemoHogLoops;
+
+static void KiDeadlineDemoControllerThread(void *arg);
+
+static void
+KiDeadlineDemoQuery(KE_SYSINFO_SCHEDULER_DATA *out)
+{
+    HO_STATUS status = KeQuerySchedulerInfo(out);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "deadline: failed to query scheduler info");
+}
+
+static void
+KiDeadlineDemoHogThread(void *arg)
+{
+    (void)arg;
+
+    while (!gDeadlineDemoStopHogs)
+        gDeadlineDemoHogLoops++;
+}
+
+static void
+KiDeadlineDemoSpin(uint64_t us)
+{
+    uint64_t endUs = KeGetSystemUpRealTime() + us;
+    while (KeGetSystemUpRealTime() < endUs)
+        ;
+}
+
+// Periodic RR baseline: same work and deadline, released by absolute sleeps.
+static void
+KiDeadlineDemoRrWorker(void *arg)
+{
+    DEADLINE_DEMO_RESULT *result = (DEADLINE_DEMO_RESULT *)arg;
+    uint64_t releaseNs = KeGetSystemUpTimeNs();
+
+    for (uint32_t job = 0; job < result->JobTarget; ++job)
+    {
+        KiDeadlineDemoSpin(result->WorkUs);
+
+        uint64_t finishNs = KeGetSystemUpTimeNs();
+        uint64_t jobDeadlineNs = releaseNs + DEADLINE_DEMO_DEADLINE_NS;
+        if (finishNs > jobDeadlineNs)
+        {
+            result->MissCount++;
+            if (finishNs - jobDeadlineNs > result->MaxLatenessNs)
+                result->MaxLatenessNs = finishNs - jobDeadlineNs;
+        }
+        result->JobCount++;
+
+        releaseNs += DEADLINE_DEMO_PERIOD_NS;
+        uint64_t nowNs = KeGetSystemUpTimeNs();
+        if (releaseNs > nowNs)
+            KeSleep(releaseNs - nowNs);
+    }
+}
+
+static void
+KiDeadlineDemoEdfWorker(void *arg)
+{
+    DEADLINE_DEMO_RESULT *result = (DEADLINE_DEMO_RESULT *)arg;
+
+    for (uint32_t job = 0; job < result->JobTarget; ++job)
+    {
+        KiDeadlineDemoSpin(result->WorkUs);
+
+        HO_STATUS status = KeThreadWaitNextPeriod();
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "deadline: worker left the deadline class");
+        result->JobCount++;
+    }
+
+    HO_STATUS status = KeThreadQueryDeadline(KeGetCurrentThread(), &result->Stats);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "deadline: failed to query worker stats");
+}
+
+static void
+KiDeadlineDemoRun(KTHREAD_ENTRY entry, DEADLINE_DEMO_RESULT *result, BOOL deadlineClass)
+{
+    KTHREAD *worker = NULL;
+
+    HO_STATUS status = KeThreadCreateJoinable(&worker, entry, result);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "deadline: failed to create worker");
+
+    if (deadlineClass)
+    {
+        KE_DEADLINE_PARAMS params = {
+            .RuntimeNs = result->RuntimeNs,
+            .PeriodNs = DEADLINE_DEMO_PERIOD_NS,
+            .DeadlineNs = DEADLINE_DEMO_DEADLINE_NS,
+        };
+
+        status = KeThreadSetDeadline(worker, &params);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "deadline: worker admission failed");
+    }
+
+    status = KeThreadStart(worker);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "deadline: failed to start worker");
+
+    status = KeThreadJoin(worker, KE_WAIT_INFINITE);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "deadline: failed to join worker");
+}
+
+static void
+KiDeadlineDemoCheckAdmission(void)
+{
+    KE_SYSINFO_SCHEDULER_DATA before = {0};
+    KE_SYSINFO_SCHEDULER_DATA after = {0};
+    KTHREAD *self = KeGetCurrentThread();
+    KTHREAD *probe = NULL;
+
+    KiDeadlineDemoQuery(&before);
+
+    // Half the CPU for the controller leaves no room for another 45%.
+    KE_DEADLINE_PARAMS half = {.RuntimeNs = 5000000ULL, .PeriodNs = 10000000ULL, .DeadlineNs = 0};
+    KE_DEADLINE_PARAMS tooMuch = {.RuntimeNs = 4500000ULL, .PeriodNs = 10000000ULL, .DeadlineNs = 0};
+    KE_DEADLINE_PARAMS inverted = {.RuntimeNs = 6000000ULL, .PeriodNs = 10000000ULL, .DeadlineNs = 5000000ULL};
+
+    HO_STATUS status = KeThreadCreateJoinable(&probe, KiDeadlineDemoHogThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "deadline: failed to create admission probe");
+
+    if (KeThreadSetDeadline(self, &half) != EC_SUCCESS)
+        HO_KPANIC(EC_INVALID_STATE, "deadline: controller admission failed");
+    if (KeThreadSetDeadline(probe, &tooMuch) != EC_OUT_OF_RESOURCE)
+        HO_KPANIC(EC_INVALID_STATE, "deadline: overload was admitted");
+    if (KeThreadSetDeadline(probe, &inverted) != EC_ILLEGAL_ARGUMENT)
+        HO_KPANIC(EC_INVALID_STATE, "deadline: runtime above deadline was accepted");
+    if (KeThreadSetDeadline(self, NULL) != EC_SUCCESS)
+        HO_KPANIC(EC_INVALID_STATE, "deadline: controller failed to leave the class");
+    if (KeThreadSetDeadline(probe, &tooMuch) != EC_SUCCESS || KeThreadSetDeadline(probe, NULL) != EC_SUCCESS)
+        HO_KPANIC(EC_INVALID_STATE, "deadline: released bandwidth was not reusable");
+
+    // The probe never ran; start it with the stop flag set so it exits at once.
+    gDeadlineDemoStopHogs = TRUE;
+    status = KeThreadStart(probe);
+    if (status == EC_SUCCESS)
+        status = KeThreadJoin(probe, KE_WAIT_INFINITE);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "deadline: failed to retire admission probe");
+    gDeadlineDemoStopHogs = FALSE;
+
+    KiDeadlineDemoQuery(&after);
+    if (after.DeadlineThreadCount != before.DeadlineThreadCount ||
+        after.DeadlineDensityPpm != before.DeadlineDensityPpm ||
+        after.DeadlineRejectCount - before.DeadlineRejectCount != 1U)
+    {
+        HO_KPANIC(EC_INVALID_STATE, "deadline: admission accounting mismatch");
+    }
+
+    klog(KLOG_LEVEL_INFO, "[DEADLINE] admission ok cap=%u ppm\n", KE_DEADLINE_MAX_DENSITY_PPM);
+}
+
+static void
+KiDeadlineDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    KE_SYSINFO_SCHEDULER_DATA before = {0};
+    KE_SYSINFO_SCHEDULER_DATA after = {0};
+    KTHREAD *hogs[DEADLINE_DEMO_HOG_COUNT] = {0};
+    DEADLINE_DEMO_RESULT rr = {.WorkUs = DEADLINE_DEMO_WORK_US, .JobTarget = DEADLINE_DEMO_JOB_COUNT};
+    DEADLINE_DEMO_RESULT edf = {
+        .RuntimeNs = DEADLINE_DEMO_RUNTIME_NS,
+        .WorkUs = DEADLINE_DEMO_WORK_US,
+        .JobTarget = DEADLINE_DEMO_JOB_COUNT,
+    };
+    DEADLINE_DEMO_RESULT overrun = {
+        .RuntimeNs = DEADLINE_DEMO_OVERRUN_RT_NS,
+        .WorkUs = DEADLINE_DEMO_OVERRUN_US,
+        .JobTarget = DEADLINE_DEMO_OVERRUN_JOBS,
+    };
+
+    KiDeadlineDemoCheckAdmission();
+
+    for (uint32_t index = 0; index < DEADLINE_DEMO_HOG_COUNT; ++index)
+    {
+        HO_STATUS status = KeThreadCreateJoinable(&hogs[index], KiDeadlineDemoHogThread, NULL);
+        if (status == EC_SUCCESS)
+            status = KeThreadStart(hogs[index]);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "deadline: failed to start hog");
+    }
+
+    // Same workload, same priority as the hogs: RR queues it behind them.
+    KiDeadlineDemoRun(KiDeadlineDemoRrWorker, &rr, FALSE);
+    klog(KLOG_LEVEL_INFO, "[DEADLINE] rr misses=%u/%u max_lateness=%luns\n", rr.MissCount, rr.JobCount,
+         (unsigned long)rr.MaxLatenessNs);
+
+    KiDeadlineDemoQuery(&before);
+    KiDeadlineDemoRun(KiDeadlineDemoEdfWorker, &edf, TRUE);
+    KiDeadlineDemoQuery(&after);
+
+    if (edf.JobCount != DEADLINE_DEMO_JOB_COUNT || edf.Stats.JobCount < DEADLINE_DEMO_JOB_COUNT)
+        HO_KPANIC(EC_INVALID_STATE, "deadline: edf job accounting mismatch");
+    if (edf.Stats.MissCount != 0 || edf.Stats.ThrottleCount != 0)
+        HO_KPANIC(EC_INVALID_STATE, "deadline: edf worker missed a deadline under load");
+
+    klog(KLOG_LEVEL_INFO, "[DEADLINE] edf misses=%lu/%u throttles=%lu preemptions=%lu\n",
+         (unsigned long)edf.Stats.MissCount, edf.JobCount, (unsigned long)edf.Stats.ThrottleCount,
+         (unsigned long)(after.DeadlinePreemptionCount - before.DeadlinePreemptionCount));
+
+    // An overrunning job is throttled, so the hogs keep running while it waits.
+    before = after;
+    uint64_t hogLoopsBefore = gDeadlineDemoHogLoops;
+    KiDeadlineDemoRun(KiDeadlineDemoEdfWorker, &overrun, TRUE);
+    KiDeadlineDemoQuery(&after);
+
+    if (overrun.Stats.ThrottleCount == 0 || after.DeadlineReplenishCount == before.DeadlineReplenishCount ||
+        overrun.Stats.MissCount == 0 || gDeadlineDemoHogLoops == hogLoopsBefore)
+    {
+        HO_KPANIC(EC_INVALID_STATE, "deadline: overrun was not throttled");
+    }
+
+    klog(KLOG_LEVEL_INFO, "[DEADLINE] overrun throttles=%lu replenishments=%lu misses=%lu max_lateness=%luns\n",
+         (unsigned long)overrun.Stats.ThrottleCount,
+         (unsigned long)(after.DeadlineReplenishCount - before.DeadlineReplenishCount),
+         (unsigned long)overrun.Stats.MissCount, (unsigned long)overrun.Stats.MaxLatenessNs);
+
+    gDeadlineDemoStopHogs = TRUE;
+    for (uint32_t index = 0; index < DEADLINE_DEMO_HOG_COUNT; ++index)
+    {
+        HO_STATUS status = KeThreadJoin(hogs[index], KE_WAIT_INFINITE);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "deadline: failed to join hog");
+    }
+
+    uint32_t pid = 0;
+    HO_STATUS status =
+        ExSpawnProgram("deadline_probe", sizeof("deadline_probe") - 1U, EX_USER_SPAWN_FLAG_NONE, &pid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "deadline: failed to spawn deadline_probe");
+
+    status = ExWaitProcess(pid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "deadline: failed to wait deadline_probe");
+
+    KiDeadlineDemoQuery(&after);
+    if (after.DeadlineThreadCount != 0 || after.DeadlineDensityPpm != 0)
+        HO_KPANIC(EC_INVALID_STATE, "deadline: bandwidth leaked after exit");
+
+    klog(KLOG_LEVEL_INFO, "[DEADLINE] deadline regression passed\n");
+}
+
+void
+RunDeadlineDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiDeadlineDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create deadline controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start deadline controller thread");
+}
@@ -46,6 +46,144 @@ RunKernelDemos(void)
         return;
     }
 
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_SPAWN_POOL)
+    {
+        RunSpawnPoolDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_REAPER)
+    {
+        RunReaperDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_FUTEX)
+    {
+        RunFutexDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_DEADLINE)
+    {
+        RunDeadlineDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_TIMER_SLACK)
+    {
+        RunTimerSlackDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_RWLOCK)
+    {
+        RunRwLockDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_LOCK_PROFILE)
+    {
+        RunLockProfileDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_TIME_PAGE)
+    {
+        RunTimePageDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_TIME_CONVERT)
+    {
+        RunTimeConvertDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_TSC_DEADLINE)
+    {
+        RunTscDeadlineDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_KTIMER)
+    {
+        RunKtimerDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_KLOG_ASYNC)
+    {
+        RunKlogAsyncDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_SERIAL_TX)
+    {
+        RunSerialTxDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_GFX_GLYPH)
+    {
+        RunGfxGlyphDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_FB_SHADOW)
+    {
+        RunFbShadowDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_CONSOLE_GRID)
+    {
+        RunConsoleGridDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_FB_WC)
+    {
+        RunFbWcDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_KLOG_BINARY)
+    {
+        RunKlogBinaryDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_KLOG_LEVELS)
+    {
+        RunKlogLevelsDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_SINK_QUEUE)
+    {
+        RunSinkQueueDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_LIBC_MEM)
+    {
+        RunLibcMemDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_LIBC_STRING)
+    {
+        RunLibcStringDemo();
+        return;
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_IDLE)
+    {
+        RunIdleDemo();
+        return;
+    }
+
     if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_USER_INPUT)
     {
         RunUserInputDemo();
@@ -144,6 +282,16 @@ RunKernelDemos(void)
     {
         RunKthreadPoolRaceDemo();
     }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_PRIO_INHERIT)
+    {
+        RunPrioInheritDemo();
+    }
+
+    if (HO_DEMO_TEST_SELECTION == HO_DEMO_TEST_DPC)
+    {
+        RunDpcDemo();
+    }
 }
 
 void
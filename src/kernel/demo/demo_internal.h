@@ -44,6 +44,31 @@
 #define HO_DEMO_TEST_USER_INPUT        20
 #define HO_DEMO_TEST_DEMO_SHELL        21
 #define HO_DEMO_TEST_USER_FAULT        22
+#define HO_DEMO_TEST_PRIO_INHERIT      23
+#define HO_DEMO_TEST_DPC               24
+#define HO_DEMO_TEST_SPAWN_POOL        25
+#define HO_DEMO_TEST_REAPER            26
+#define HO_DEMO_TEST_FUTEX             27
+#define HO_DEMO_TEST_DEADLINE          28
+#define HO_DEMO_TEST_TIMER_SLACK       29
+#define HO_DEMO_TEST_RWLOCK            30
+#define HO_DEMO_TEST_LOCK_PROFILE      31
+#define HO_DEMO_TEST_TIME_PAGE         32
+#define HO_DEMO_TEST_TIME_CONVERT      33
+#define HO_DEMO_TEST_TSC_DEADLINE      34
+#define HO_DEMO_TEST_KTIMER            35
+#define HO_DEMO_TEST_KLOG_ASYNC        36
+#define HO_DEMO_TEST_SERIAL_TX         37
+#define HO_DEMO_TEST_GFX_GLYPH         38
+#define HO_DEMO_TEST_FB_SHADOW         39
+#define HO_DEMO_TEST_CONSOLE_GRID      40
+#define HO_DEMO_TEST_FB_WC             41
+#define HO_DEMO_TEST_KLOG_BINARY       42
+#define HO_DEMO_TEST_KLOG_LEVELS       43
+#define HO_DEMO_TEST_SINK_QUEUE        44
+#define HO_DEMO_TEST_LIBC_MEM          45
+#define HO_DEMO_TEST_LIBC_STRING       46
+#define HO_DEMO_TEST_IDLE              47
 
 #ifndef HO_DEMO_TEST_SELECTION
 #define HO_DEMO_TEST_SELECTION HO_DEMO_TEST_NONE
@@ -106,8 +131,33 @@ void RunPageFaultGuardDemo(void);
 void RunPageFaultFixmapDemo(void);
 void RunPageFaultHeapDemo(void);
 void RunKthreadPoolRaceDemo(void);
+void RunPrioInheritDemo(void);
+void RunDpcDemo(void);
 void RunUserHelloDemo(void);
 void RunUserCapsDemo(void);
 void RunUserDualDemo(void);
+void RunSpawnPoolDemo(void);
+void RunReaperDemo(void);
+void RunFutexDemo(void);
+void RunDeadlineDemo(void);
+void RunTimerSlackDemo(void);
+void RunRwLockDemo(void);
+void RunLockProfileDemo(void);
+void RunTimePageDemo(void);
+void RunTimeConvertDemo(void);
+void RunTscDeadlineDemo(void);
+void RunKtimerDemo(void);
+void RunKlogAsyncDemo(void);
+void RunSerialTxDemo(void);
+void RunGfxGlyphDemo(void);
+void RunFbShadowDemo(void);
+void RunConsoleGridDemo(void);
+void RunFbWcDemo(void);
+void RunKlogBinaryDemo(void);
+void RunKlogLevelsDemo(void);
+void RunSinkQueueDemo(void);
+void RunLibcMemDemo(void);
+void RunLibcStringDemo(void);
+void RunIdleDemo(void);
 void RunUserInputDemo(void);
 void RunDemoShellDemo(void);
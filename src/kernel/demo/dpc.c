@@ -0,0 +1,330 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/dpc.c
+ * Description: Regression suite for the DPC queue, the kernel work queue and interrupt cost accounting.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+#include <kernel/ke/clock_event.h>
+#include <kernel/ke/dpc.h>
+#include <kernel/ke/sysinfo.h>
+#include <kernel/ke/work_queue.h>
+
+#define DPC_WAIT_TIMEOUT_NS 200000000ULL
+#define DPC_SETTLE_SLEEP_NS 20000000ULL
+#define DPC_MAX_SEQUENCE    8U
+
+typedef struct KI_DPC_SEQUENCE
+{
+    char Tokens[DPC_MAX_SEQUENCE + 1];
+    uint32_t Length;
+} KI_DPC_SEQUENCE;
+
+typedef struct KI_DPC_WORK_CONTEXT
+{
+    KI_DPC_SEQUENCE *Sequence;
+    KSEMAPHORE *DoneSemaphore;
+    char Token;
+} KI_DPC_WORK_CONTEXT;
+
+static uint32_t gDpcRoutineRunCount;
+static KWORK_ITEM gDpcChainWorkItem;
+static KEVENT gDpcChainDoneEvent;
+
+static void KiAssertDpcStatus(HO_STATUS actual, HO_STATUS expected, const char *reason);
+static void KiAssertDpcCondition(BOOL condition, const char *reason);
+static void KiDpcAppendToken(KI_DPC_SEQUENCE *sequence, char token);
+static void KiCountingDpcRoutine(KDPC *dpc, void *context);
+static void KiChainDpcRoutine(KDPC *dpc, void *context);
+static void KiChainWorkRoutine(KWORK_ITEM *item, void *context);
+static void KiLaneWorkRoutine(KWORK_ITEM *item, void *context);
+static void KiRunDpcPassiveScenario(void);
+static void KiRunDpcGuardScenario(void);
+static void KiRunWorkQueueLaneScenario(void);
+static void KiRunDpcChainScenario(void);
+static void KiRunInterruptStatsScenario(void);
+static void DpcControllerThread(void *arg);
+
+void
+RunDpcDemo(void)
+{
+    KTHREAD *controller = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controller, DpcControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create DPC regression controller");
+
+    status = KeThreadStart(controller);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start DPC regression controller");
+}
+
+static void
+KiAssertDpcStatus(HO_STATUS actual, HO_STATUS expected, const char *reason)
+{
+    if (actual == expected)
+        return;
+
+    klog(KLOG_LEVEL_ERROR, "[DPC] %s failed (expected=%d actual=%d)\n", reason, expected, actual);
+    HO_KPANIC(actual, "DPC regression assertion failed");
+}
+
+static void
+KiAssertDpcCondition(BOOL condition, const char *reason)
+{
+    if (condition)
+        return;
+
+    klog(KLOG_LEVEL_ERROR, "[DPC] %s\n", reason);
+    HO_KPANIC(EC_INVALID_STATE, "DPC regression assertion failed");
+}
+
+static void
+KiDpcAppendToken(KI_DPC_SEQUENCE *sequence, char token)
+{
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (sequence->Length >= DPC_MAX_SEQUENCE)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        HO_KPANIC(EC_OUT_OF_RESOURCE, "DPC regression sequence overflow");
+    }
+
+    sequence->Tokens[sequence->Length++] = token;
+    sequence->Tokens[sequence->Length] = '\0';
+
+    KeLeaveCriticalSection(&criticalSection);
+}
+
+static void
+KiCountingDpcRoutine(KDPC *dpc, void *context)
+{
+    (void)dpc;
+    (void)context;
+
+    KiAssertDpcCondition(KeGetCurrentIrql() == KE_IRQL_DISPATCH_LEVEL, "DPC routine ran below DISPATCH_LEVEL");
+    KiAssertDpcCondition(!ArchGetInterruptState().MaskableInterruptEnabled, "DPC routine ran with interrupts on");
+    gDpcRoutineRunCount++;
+}
+
+static void
+KiChainDpcRoutine(KDPC *dpc, void *context)
+{
+    (void)dpc;
+    (void)context;
+
+    HO_STATUS status = KeQueueWorkItem(&gDpcChainWorkItem, KTHREAD_PRIORITY_NORMAL);
+    KiAssertDpcStatus(status, EC_SUCCESS, "queue work item from DPC");
+    // The worker must not be woken (and possibly switched to) in the middle of the drain.
+    KiAssertDpcCondition(KiWorkQueueHasDeferredWakes(), "work item wake not deferred past the DPC drain");
+}
+
+static void
+KiChainWorkRoutine(KWORK_ITEM *item, void *context)
+{
+    (void)item;
+    (void)context;
+
+    KiAssertDpcCondition(KeIsBlockingAllowed(), "work item ran above PASSIVE_LEVEL");
+    KiAssertDpcCondition(ArchGetInterruptState().MaskableInterruptEnabled, "work item ran with interrupts off");
+    KeSetEvent(&gDpcChainDoneEvent);
+}
+
+static void
+KiLaneWorkRoutine(KWORK_ITEM *item, void *context)
+{
+    KI_DPC_WORK_CONTEXT *workContext = (KI_DPC_WORK_CONTEXT *)context;
+
+    KiAssertDpcCondition(KeGetCurrentThread()->Priority == item->Lane, "work item ran on a foreign lane");
+    KiDpcAppendToken(workContext->Sequence, workContext->Token);
+
+    HO_STATUS status = KeReleaseSemaphore(workContext->DoneSemaphore, 1);
+    KiAssertDpcStatus(status, EC_SUCCESS, "release lane completion");
+}
+
+// A DPC queued at PASSIVE_LEVEL with interrupts enabled retires before the insert returns.
+static void
+KiRunDpcPassiveScenario(void)
+{
+    KDPC dpc;
+
+    gDpcRoutineRunCount = 0;
+    KeInitializeDpc(&dpc, KiCountingDpcRoutine, NULL);
+
+    KiAssertDpcCondition(KeInsertQueueDpc(&dpc), "passive insert rejected");
+    KiAssertDpcCondition(gDpcRoutineRunCount == 1U, "passive insert did not retire immediately");
+    KiAssertDpcCondition(!dpc.Queued, "retired DPC still marked queued");
+
+    klog(KLOG_LEVEL_INFO, "[DPC] passive retire passed\n");
+}
+
+// Under an IRQL guard the DPC stays pending, coalesces duplicate inserts, can be
+// removed, and retires exactly once when the guard drops back to PASSIVE_LEVEL.
+static void
+KiRunDpcGuardScenario(void)
+{
+    KDPC dpc;
+    KDPC removedDpc;
+    KE_IRQL_GUARD guard = {0};
+
+    gDpcRoutineRunCount = 0;
+    KeInitializeDpc(&dpc, KiCountingDpcRoutine, NULL);
+    KeInitializeDpc(&removedDpc, KiCountingDpcRoutine, NULL);
+
+    KeAcquireIrqlGuard(&guard, KE_IRQL_DISPATCH_LEVEL);
+    KiAssertDpcCondition(KeInsertQueueDpc(&dpc), "guarded insert rejected");
+    KiAssertDpcCondition(!KeInsertQueueDpc(&dpc), "duplicate insert was not coalesced");
+    KiAssertDpcCondition(KeInsertQueueDpc(&removedDpc), "second guarded insert rejected");
+    KiAssertDpcCondition(KeRemoveQueueDpc(&removedDpc), "pending DPC could not be removed");
+    KiAssertDpcCondition(!KeRemoveQueueDpc(&removedDpc), "removed DPC still reported pending");
+    KiAssertDpcCondition(gDpcRoutineRunCount == 0U, "DPC retired while the guard was held");
+    KeReleaseIrqlGuard(&guard);
+
+    KiAssertDpcCondition(gDpcRoutineRunCount == 1U, "guard release did not retire exactly one DPC");
+    klog(KLOG_LEVEL_INFO, "[DPC] guard retire passed\n");
+}
+
+// Items queued on all three lanes run on workers of matching priority, highest lane first.
+static void
+KiRunWorkQueueLaneScenario(void)
+{
+    static const char kLaneTokens[KTHREAD_PRIORITY_COUNT] = {'L', 'N', 'H'};
+    KI_DPC_SEQUENCE sequence = {0};
+    KSEMAPHORE doneSemaphore;
+    KWORK_ITEM items[KTHREAD_PRIORITY_COUNT];
+    KI_DPC_WORK_CONTEXT contexts[KTHREAD_PRIORITY_COUNT];
+    KE_IRQL_GUARD guard = {0};
+    uint32_t lane;
+
+    KiAssertDpcCondition(KeWorkQueueIsReady(), "work queue is not running");
+    KiAssertDpcStatus(KeInitializeSemaphore(&doneSemaphore, 0, KTHREAD_PRIORITY_COUNT), EC_SUCCESS,
+                      "initialize lane completion");
+
+    KeAcquireIrqlGuard(&guard, KE_IRQL_DISPATCH_LEVEL);
+    for (lane = 0; lane < (uint32_t)KTHREAD_PRIORITY_COUNT; ++lane)
+    {
+        contexts[lane].Sequence = &sequence;
+        contexts[lane].DoneSemaphore = &doneSemaphore;
+        contexts[lane].Token = kLaneTokens[lane];
+        KeInitializeWorkItem(&items[lane], KiLaneWorkRoutine, &contexts[lane]);
+        KiAssertDpcStatus(KeQueueWorkItem(&items[lane], (uint8_t)lane), EC_SUCCESS, "queue lane work item");
+    }
+    KiAssertDpcStatus(KeQueueWorkItem(&items[0], KTHREAD_PRIORITY_LOW), EC_INVALID_STATE, "double queue");
+    KeReleaseIrqlGuard(&guard);
+
+    for (lane = 0; lane < (uint32_t)KTHREAD_PRIORITY_COUNT; ++lane)
+    {
+        KiAssertDpcStatus(KeWaitForSingleObject(&doneSemaphore, DPC_WAIT_TIMEOUT_NS), EC_SUCCESS,
+                          "wait for lane completion");
+    }
+
+    KiAssertDpcCondition(sequence.Length == 3U && sequence.Tokens[0] == 'H' && sequence.Tokens[1] == 'N' &&
+                             sequence.Tokens[2] == 'L',
+                         "work-queue lanes ran out of priority order");
+    klog(KLOG_LEVEL_INFO, "[DPC] lanes sequence=%s\n", sequence.Tokens);
+}
+
+// ISR-style hand-off: DPC -> work item -> waiter.
+static void
+KiRunDpcChainScenario(void)
+{
+    KDPC dpc;
+    KE_IRQL_GUARD guard = {0};
+
+    KeInitializeEvent(&gDpcChainDoneEvent, FALSE);
+    KeInitializeWorkItem(&gDpcChainWorkItem, KiChainWorkRoutine, NULL);
+    KeInitializeDpc(&dpc, KiChainDpcRoutine, NULL);
+
+    KeAcquireIrqlGuard(&guard, KE_IRQL_DISPATCH_LEVEL);
+    KiAssertDpcCondition(KeInsertQueueDpc(&dpc), "chain insert rejected");
+    KeReleaseIrqlGuard(&guard);
+    KiAssertDpcCondition(!KiWorkQueueHasDeferredWakes(), "deferred work item wake not flushed after the drain");
+
+    KiAssertDpcStatus(KeWaitForSingleObject(&gDpcChainDoneEvent, DPC_WAIT_TIMEOUT_NS), EC_SUCCESS,
+                      "wait for DPC -> work item chain");
+    klog(KLOG_LEVEL_INFO, "[DPC] chain passed\n");
+}
+
+static void
+KiRunInterruptStatsScenario(void)
+{
+    SYSINFO_INTERRUPT info;
+    uint8_t timerVector = KeClockEventGetVector();
+    BOOL timerSeen = FALSE;
+    uint64_t handlerCycles = 0;
+    uint64_t handlerSamples = 0;
+    uint64_t offCycles = 0;
+    uint64_t offSamplesTotal = 0;
+    uint32_t index;
+
+    // Sleeping goes through the timer ISR -> clock-expiry DPC path.
+    KeSleep(DPC_SETTLE_SLEEP_NS);
+
+    KiAssertDpcStatus(KeQuerySystemInformation(KE_SYSINFO_INTERRUPT, &info, sizeof(info), NULL), EC_SUCCESS,
+                      "query interrupt sysinfo");
+
+    for (index = 0; index < info.ReturnedVectorCount; ++index)
+    {
+        const SYSINFO_INTERRUPT_VECTOR *vector = &info.Vectors[index];
+
+        uint64_t offSamples = vector->Count - vector->SwitchedCount;
+        klog(KLOG_LEVEL_INFO,
+             "[DPC] vector=%u count=%lu avg_cycles=%lu max_cycles=%lu avg_off_cycles=%lu max_off_cycles=%lu "
+             "switched=%lu\n",
+             vector->VectorNumber, (unsigned long)vector->Count,
+             (unsigned long)(vector->TotalHandlerCycles / vector->Count), (unsigned long)vector->MaxHandlerCycles,
+             (unsigned long)(offSamples != 0 ? vector->TotalInterruptOffCycles / offSamples : 0),
+             (unsigned long)vector->MaxInterruptOffCycles, (unsigned long)vector->SwitchedCount);
+
+        handlerCycles += vector->TotalHandlerCycles;
+        handlerSamples += vector->Count;
+        offCycles += vector->TotalInterruptOffCycles;
+        offSamplesTotal += offSamples;
+
+        if (vector->VectorNumber == timerVector)
+            timerSeen = TRUE;
+    }
+
+    // DPCs still retire in the interrupt epilogue with interrupts disabled, so deferral
+    // shortens the ISR but not the interrupt-off window. Report both so the gap is visible.
+    if (handlerSamples != 0 && offSamplesTotal != 0)
+    {
+        klog(KLOG_LEVEL_INFO, "[DPC] interrupt-off span avg_isr_cycles=%lu avg_off_cycles=%lu (DPC drain runs with "
+                              "interrupts disabled)\n",
+             (unsigned long)(handlerCycles / handlerSamples), (unsigned long)(offCycles / offSamplesTotal));
+    }
+
+    KiAssertDpcCondition(timerSeen, "timer vector missing from interrupt sysinfo");
+    KiAssertDpcCondition(info.Dpc.ExecutedCount != 0 && info.Dpc.QueueDepth == 0, "DPC counters inconsistent");
+    KiAssertDpcCondition(info.WorkQueueReady, "work queue not reported ready");
+
+    for (index = 0; index < SYSINFO_WORK_QUEUE_LANE_COUNT; ++index)
+    {
+        KiAssertDpcCondition(info.WorkQueueLanes[index].ExecutedCount != 0, "work-queue lane never executed");
+        KiAssertDpcCondition(info.WorkQueueLanes[index].WorkerCount == KE_WORK_QUEUE_WORKERS_PER_LANE,
+                             "work-queue lane worker count mismatch");
+    }
+
+    klog(KLOG_LEVEL_INFO, "[DPC] dpc executed=%lu max_queue_cycles=%lu max_routine_cycles=%lu\n",
+         (unsigned long)info.Dpc.ExecutedCount, (unsigned long)info.Dpc.MaxQueueCycles,
+         (unsigned long)info.Dpc.MaxRoutineCycles);
+    klog(KLOG_LEVEL_INFO, "[DPC] interrupt stats passed\n");
+}
+
+static void
+DpcControllerThread(void *arg)
+{
+    (void)arg;
+
+    klog(KLOG_LEVEL_INFO, "[DPC] dpc/work-queue regression start\n");
+    KiRunDpcPassiveScenario();
+    KiRunDpcGuardScenario();
+    KiRunWorkQueueLaneScenario();
+    KiRunDpcChainScenario();
+    KiRunInterruptStatsScenario();
+    klog(KLOG_LEVEL_INFO, "[DPC] dpc/work-queue regression passed\n");
+}
@@ -0,0 +1,182 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/fb_shadow.c
+ * Description: Framebuffer shadow profile. Writes the same block of lines
+ *              under each console flush policy and reports cycles per line and
+ *              bytes copied to video memory, and checks that a partial line
+ *              stays in the shadow until a newline or the periodic timer DPC
+ *              pushes it out.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+
+#define FB_SHADOW_DEMO_LINES     16U
+#define FB_SHADOW_DEMO_PERIOD_NS 20000000ULL // 20 ms
+#define FB_SHADOW_DEMO_SETTLE_NS (FB_SHADOW_DEMO_PERIOD_NS * 3U)
+
+static const char gFbShadowDemoLine[] = "[FBSHD] 0123456789abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ\n";
+static const char gFbShadowDemoPartial[] = "[FBSHD] partial line without a newline...";
+
+typedef struct FB_SHADOW_DEMO_RESULT
+{
+    uint64_t Cycles;
+    VD_SHADOW_STATS Delta;
+} FB_SHADOW_DEMO_RESULT;
+
+static void
+KiFbShadowDemoQuery(CONSOLE_FRAMEBUFFER_STATS *stats)
+{
+    HO_STATUS status = ConsoleQueryFramebufferStats(stats);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "fb_shadow: failed to query framebuffer stats");
+}
+
+static void
+KiFbShadowDemoSetPolicy(CONSOLE_FLUSH_POLICY policy, uint64_t periodNs)
+{
+    HO_STATUS status = ConsoleSetFlushPolicy(policy, periodNs);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "fb_shadow: failed to set flush policy");
+}
+
+static void
+KiFbShadowDemoDelta(VD_SHADOW_STATS *delta, const VD_SHADOW_STATS *before, const VD_SHADOW_STATS *after)
+{
+    delta->DirtyMarks = after->DirtyMarks - before->DirtyMarks;
+    delta->FlushCount = after->FlushCount - before->FlushCount;
+    delta->FlushedBytes = after->FlushedBytes - before->FlushedBytes;
+    delta->FlushCycles = after->FlushCycles - before->FlushCycles;
+}
+
+static void
+KiFbShadowDemoRun(CONSOLE_FLUSH_POLICY policy, uint64_t periodNs, FB_SHADOW_DEMO_RESULT *result)
+{
+    KiFbShadowDemoSetPolicy(policy, periodNs);
+
+    // Start at the top of a clear screen so the block never scrolls.
+    ConsoleClearScreen(HO_CONSOLE_DEFAULT_BACKGROUND);
+    ConsoleFlush();
+
+    CONSOLE_FRAMEBUFFER_STATS before = {0};
+    KiFbShadowDemoQuery(&before);
+
+    uint64_t startTsc = rdtsc();
+    for (uint32_t index = 0; index < FB_SHADOW_DEMO_LINES; ++index)
+        (void)ConsoleWrite(gFbShadowDemoLine);
+    result->Cycles = rdtsc() - startTsc;
+
+    // Periodic flushes land after the loop; settle so the copy is counted.
+    if (policy == CONSOLE_FLUSH_PERIODIC)
+        KeSleep(FB_SHADOW_DEMO_SETTLE_NS);
+
+    CONSOLE_FRAMEBUFFER_STATS after = {0};
+    KiFbShadowDemoQuery(&after);
+    KiFbShadowDemoDelta(&result->Delta, &before.Shadow, &after.Shadow);
+}
+
+static void
+KiFbShadowDemoReport(const char *mode, const FB_SHADOW_DEMO_RESULT *result)
+{
+    uint64_t flushes = result->Delta.FlushCount != 0 ? result->Delta.FlushCount : 1;
+    klog(KLOG_LEVEL_INFO, "[FBSHD] %s: cycles/line=%lu flushes=%lu flushed=%lu bytes cycles/flush=%lu\n", mode,
+         (unsigned long)(result->Cycles / FB_SHADOW_DEMO_LINES), (unsigned long)result->Delta.FlushCount,
+         (unsigned long)result->Delta.FlushedBytes, (unsigned long)(result->Delta.FlushCycles / flushes));
+}
+
+static void
+KiFbShadowDemoCheckNewline(void)
+{
+    KiFbShadowDemoSetPolicy(CONSOLE_FLUSH_ON_NEWLINE, 0);
+
+    CONSOLE_FRAMEBUFFER_STATS stats = {0};
+    (void)ConsoleWrite(gFbShadowDemoPartial);
+    KiFbShadowDemoQuery(&stats);
+    if (!stats.DirtyPending)
+        HO_KPANIC(EC_INVALID_STATE, "fb_shadow: partial line was flushed under the newline policy");
+
+    (void)ConsoleWriteChar('\n');
+    KiFbShadowDemoQuery(&stats);
+    if (stats.DirtyPending)
+        HO_KPANIC(EC_INVALID_STATE, "fb_shadow: newline did not flush the shadow");
+}
+
+static void
+KiFbShadowDemoCheckPeriodic(void)
+{
+    KiFbShadowDemoSetPolicy(CONSOLE_FLUSH_PERIODIC, FB_SHADOW_DEMO_PERIOD_NS);
+
+    CONSOLE_FRAMEBUFFER_STATS before = {0};
+    (void)ConsoleWrite(gFbShadowDemoPartial);
+    KiFbShadowDemoQuery(&before);
+    if (!before.DirtyPending)
+        HO_KPANIC(EC_INVALID_STATE, "fb_shadow: periodic policy flushed on write");
+
+    KeSleep(FB_SHADOW_DEMO_SETTLE_NS);
+
+    CONSOLE_FRAMEBUFFER_STATS after = {0};
+    KiFbShadowDemoQuery(&after);
+    if (after.Shadow.FlushCount == before.Shadow.FlushCount)
+        HO_KPANIC(EC_INVALID_STATE, "fb_shadow: periodic timer never flushed the shadow");
+    (void)ConsoleWriteChar('\n');
+}
+
+static void
+KiFbShadowDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    // Time the framebuffer sink itself, not the queue in front of it.
+    CONSOLE_SINK_QUEUE_STATS queue = {0};
+    (void)ConsoleQuerySinkQueueStats(CONSOLE_SINK_FRAMEBUFFER, &queue);
+    (void)ConsoleSetSinkQueuePolicy(CONSOLE_SINK_FRAMEBUFFER, CONSOLE_SINK_QUEUE_DIRECT);
+
+    CONSOLE_FRAMEBUFFER_STATS boot = {0};
+    KiFbShadowDemoQuery(&boot);
+    if (!boot.Shadowed)
+        HO_KPANIC(EC_INVALID_STATE, "fb_shadow: console is not shadowed after boot");
+    if (boot.Policy != CONSOLE_FLUSH_IMMEDIATE)
+        HO_KPANIC(EC_INVALID_STATE, "fb_shadow: boot flush policy is not immediate");
+    if (ConsoleSetFlushPolicy(CONSOLE_FLUSH_PERIODIC, 0) != EC_ILLEGAL_ARGUMENT)
+        HO_KPANIC(EC_INVALID_STATE, "fb_shadow: zero flush period was accepted");
+
+    FB_SHADOW_DEMO_RESULT immediate = {0};
+    FB_SHADOW_DEMO_RESULT newline = {0};
+    FB_SHADOW_DEMO_RESULT periodic = {0};
+    KiFbShadowDemoRun(CONSOLE_FLUSH_IMMEDIATE, 0, &immediate);
+    KiFbShadowDemoRun(CONSOLE_FLUSH_ON_NEWLINE, 0, &newline);
+    KiFbShadowDemoRun(CONSOLE_FLUSH_PERIODIC, FB_SHADOW_DEMO_PERIOD_NS, &periodic);
+
+    if (immediate.Delta.FlushCount < FB_SHADOW_DEMO_LINES || immediate.Delta.FlushedBytes == 0)
+        HO_KPANIC(EC_INVALID_STATE, "fb_shadow: immediate policy did not flush every line");
+    if (periodic.Delta.FlushCount == 0 || periodic.Delta.FlushCount >= immediate.Delta.FlushCount)
+        HO_KPANIC(EC_INVALID_STATE, "fb_shadow: periodic policy did not batch the block");
+
+    KiFbShadowDemoCheckNewline();
+    KiFbShadowDemoCheckPeriodic();
+    KiFbShadowDemoSetPolicy(CONSOLE_FLUSH_IMMEDIATE, 0);
+
+    KiFbShadowDemoReport("immediate", &immediate);
+    KiFbShadowDemoReport("newline", &newline);
+    KiFbShadowDemoReport("periodic", &periodic);
+    (void)ConsoleSetSinkQueuePolicy(CONSOLE_SINK_FRAMEBUFFER, queue.Policy);
+    klog(KLOG_LEVEL_INFO, "[FBSHD] framebuffer shadow regression passed\n");
+}
+
+void
+RunFbShadowDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiFbShadowDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create framebuffer shadow controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start framebuffer shadow controller thread");
+}
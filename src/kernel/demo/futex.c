@@ -0,0 +1,81 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/futex.c
+ * Description: Futex profile. Runs the futex_probe payload, which exercises the
+ *              libsys mutex/condvar fast path and the SYS_FUTEX_WAIT/WAKE slow
+ *              paths, then checks the Ex futex table counters.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <kernel/ex/ex_process.h>
+#include <kernel/ex/futex.h>
+
+static void KiFutexDemoControllerThread(void *arg);
+
+static void
+KiFutexDemoQuery(EX_SYSINFO_FUTEX_STATS *out)
+{
+    HO_STATUS status = ExQueryFutexStats(out);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "futex: failed to query futex stats");
+}
+
+static void
+KiFutexDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    EX_SYSINFO_FUTEX_STATS before = {0};
+    EX_SYSINFO_FUTEX_STATS after = {0};
+    uint32_t pid = 0;
+
+    KiFutexDemoQuery(&before);
+
+    HO_STATUS status = ExSpawnProgram("futex_probe", sizeof("futex_probe") - 1U, EX_USER_SPAWN_FLAG_NONE, &pid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "futex: failed to spawn futex_probe");
+
+    status = ExWaitProcess(pid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "futex: failed to wait futex_probe");
+
+    KiFutexDemoQuery(&after);
+
+    // The probe charges one mismatch, two timed-out sleeps, and two wakes
+    // (explicit plus the contended unlock after the condvar timeout).
+    uint64_t waits = after.WaitCount - before.WaitCount;
+    uint64_t blocks = after.BlockCount - before.BlockCount;
+    uint64_t wakes = after.WakeCount - before.WakeCount;
+
+    if (after.MismatchCount - before.MismatchCount != 1U || after.TimeoutCount - before.TimeoutCount != 2U ||
+        blocks != 2U || wakes != 2U)
+    {
+        HO_KPANIC(EC_INVALID_STATE, "futex: probe counters mismatch");
+    }
+
+    if (after.ActiveWaiters != 0 || after.MaxActiveWaiters == 0 || after.BucketCount != EX_FUTEX_HASH_BUCKETS)
+        HO_KPANIC(EC_INVALID_STATE, "futex: table state mismatch");
+
+    klog(KLOG_LEVEL_INFO, "[FUTEX] waits=%lu blocks=%lu wakes=%lu woken=%lu max_waiters=%u\n", (unsigned long)waits,
+         (unsigned long)blocks, (unsigned long)wakes, (unsigned long)(after.WokenCount - before.WokenCount),
+         after.MaxActiveWaiters);
+    klog(KLOG_LEVEL_INFO, "[FUTEX] futex regression passed\n");
+}
+
+void
+RunFutexDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiFutexDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create futex controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start futex controller thread");
+}
@@ -0,0 +1,135 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/gfx_glyph.c
+ * Description: Framebuffer glyph rendering profile. Draws the same screenful of
+ *              text through the per-pixel video driver path and through the
+ *              glyph cache, reports characters per second and cycles per
+ *              character for both, and checks that alternating colour pairs are
+ *              served from the cached slots instead of being re-expanded.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <kernel/ke/time_source.h>
+
+#define GFX_GLYPH_DEMO_LINES 16U
+
+// 64 glyphs + newline per line; the two colour variants alternate line by line.
+static const char gGfxGlyphDemoLine[] = "[GLYPH] 0123456789abcdefghijklmnopqrstuvwxyz!#$&()*+,-./:;<=>?@~\n";
+static const char gGfxGlyphDemoColorOn[] = ANSI_FG_GREEN;
+static const char gGfxGlyphDemoColorOff[] = ANSI_RESET;
+
+typedef struct GFX_GLYPH_DEMO_RESULT
+{
+    uint64_t Glyphs;
+    uint64_t ElapsedNs;
+    uint64_t Cycles;
+    CONSOLE_GLYPH_STATS Delta;
+} GFX_GLYPH_DEMO_RESULT;
+
+static void
+KiGfxGlyphDemoQuery(CONSOLE_GLYPH_STATS *stats)
+{
+    HO_STATUS status = ConsoleQueryGlyphStats(stats);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "gfx_glyph: failed to query glyph stats");
+}
+
+static void
+KiGfxGlyphDemoRun(BOOL glyphCache, GFX_GLYPH_DEMO_RESULT *result)
+{
+    HO_STATUS status = ConsoleSetGlyphCache(glyphCache);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "gfx_glyph: failed to switch glyph cache");
+
+    // Start at the top of a clear screen so the block never scrolls.
+    ConsoleClearScreen(HO_CONSOLE_DEFAULT_BACKGROUND);
+
+    CONSOLE_GLYPH_STATS before = {0};
+    KiGfxGlyphDemoQuery(&before);
+
+    uint64_t startNs = KeGetSystemUpTimeNs();
+    uint64_t startTsc = rdtsc();
+    for (uint32_t index = 0; index < GFX_GLYPH_DEMO_LINES; ++index)
+    {
+        if ((index & 1U) != 0)
+            (void)ConsoleWrite(gGfxGlyphDemoColorOn);
+        (void)ConsoleWrite(gGfxGlyphDemoLine);
+        if ((index & 1U) != 0)
+            (void)ConsoleWrite(gGfxGlyphDemoColorOff);
+    }
+    result->Cycles = rdtsc() - startTsc;
+    result->ElapsedNs = KeGetSystemUpTimeNs() - startNs;
+    result->Glyphs = (sizeof(gGfxGlyphDemoLine) - 2U) * GFX_GLYPH_DEMO_LINES;
+
+    KiGfxGlyphDemoQuery(&result->Delta);
+    result->Delta.CachedGlyphs -= before.CachedGlyphs;
+    result->Delta.PixelGlyphs -= before.PixelGlyphs;
+    result->Delta.SlotHits -= before.SlotHits;
+    result->Delta.SlotFills -= before.SlotFills;
+}
+
+static void
+KiGfxGlyphDemoReport(const char *mode, const GFX_GLYPH_DEMO_RESULT *result)
+{
+    uint64_t elapsedNs = result->ElapsedNs != 0 ? result->ElapsedNs : 1;
+    klog(KLOG_LEVEL_INFO, "[GLYPH] %s: glyphs=%lu elapsed=%lu ns chars/s=%lu cycles/char=%lu\n", mode,
+         (unsigned long)result->Glyphs, (unsigned long)result->ElapsedNs,
+         (unsigned long)(result->Glyphs * 1000000000ULL / elapsedNs),
+         (unsigned long)(result->Cycles / result->Glyphs));
+}
+
+static void
+KiGfxGlyphDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    // Time the framebuffer sink itself, not the queue in front of it.
+    CONSOLE_SINK_QUEUE_STATS queue = {0};
+    (void)ConsoleQuerySinkQueueStats(CONSOLE_SINK_FRAMEBUFFER, &queue);
+    (void)ConsoleSetSinkQueuePolicy(CONSOLE_SINK_FRAMEBUFFER, CONSOLE_SINK_QUEUE_DIRECT);
+
+    CONSOLE_GLYPH_STATS boot = {0};
+    KiGfxGlyphDemoQuery(&boot);
+    if (!boot.Enabled)
+        HO_KPANIC(EC_INVALID_STATE, "gfx_glyph: glyph cache is not enabled after boot");
+
+    GFX_GLYPH_DEMO_RESULT pixels = {0};
+    GFX_GLYPH_DEMO_RESULT cached = {0};
+    KiGfxGlyphDemoRun(FALSE, &pixels);
+    KiGfxGlyphDemoRun(TRUE, &cached);
+
+    if (pixels.Delta.PixelGlyphs < pixels.Glyphs || pixels.Delta.CachedGlyphs != 0)
+        HO_KPANIC(EC_INVALID_STATE, "gfx_glyph: per-pixel run did not use the driver path");
+    if (cached.Delta.CachedGlyphs < cached.Glyphs || cached.Delta.PixelGlyphs != 0)
+        HO_KPANIC(EC_INVALID_STATE, "gfx_glyph: cached run did not use the glyph cache");
+    if (cached.Delta.SlotFills > cached.Delta.Slots)
+        HO_KPANIC(EC_INVALID_STATE, "gfx_glyph: alternating colour pairs were re-expanded");
+    if (cached.Cycles >= pixels.Cycles)
+        HO_KPANIC(EC_INVALID_STATE, "gfx_glyph: glyph cache is not faster than per-pixel rendering");
+
+    KiGfxGlyphDemoReport("per-pixel", &pixels);
+    KiGfxGlyphDemoReport("cached", &cached);
+    klog(KLOG_LEVEL_INFO, "[GLYPH] slot hits=%lu fills=%lu slots=%u\n", (unsigned long)cached.Delta.SlotHits,
+         (unsigned long)cached.Delta.SlotFills, cached.Delta.Slots);
+    (void)ConsoleSetSinkQueuePolicy(CONSOLE_SINK_FRAMEBUFFER, queue.Policy);
+    klog(KLOG_LEVEL_INFO, "[GLYPH] glyph cache regression passed\n");
+}
+
+void
+RunGfxGlyphDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiGfxGlyphDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create glyph cache controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start glyph cache controller thread");
+}
@@ -0,0 +1,142 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/idle.c
+ * Description: Idle driver profile. Checks that the idle method and monitor
+ *              line size match what CPUID allows, then sleeps so the CPU idles
+ *              and checks that entries, the residency histogram and the
+ *              exit-latency counters all advanced, with exactly one residency
+ *              sample per wake.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <kernel/ke/idle.h>
+
+#define IDLE_DEMO_SLEEPS        4U
+#define IDLE_DEMO_SLEEP_NS      50000000ULL // 50 ms
+#define IDLE_DEMO_CPUID_MONITOR (1U << 3)    // CPUID.1:ECX
+
+static void
+KiIdleDemoQuery(KE_IDLE_STATS *out)
+{
+    KE_SYSINFO_SCHEDULER_DATA info = {0};
+    HO_STATUS status = KeQuerySchedulerInfo(&info);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "idle: failed to query scheduler info");
+    *out = info.Idle;
+}
+
+// Repeat the driver's choice from CPUID: MWAIT needs MONITOR support and a
+// monitor line that fits the padded need-resched block.
+static void
+KiIdleDemoCheckMethod(const KE_IDLE_STATS *stats)
+{
+    uint32_t eax, ebx, ecx, edx;
+    uint32_t expectedMethod = KE_IDLE_METHOD_HLT;
+    uint32_t expectedLine = 0;
+
+    cpuid(0, &eax, &ebx, &ecx, &edx);
+    uint32_t maxLeaf = eax;
+    cpuid(1, &eax, &ebx, &ecx, &edx);
+    if ((ecx & IDLE_DEMO_CPUID_MONITOR) != 0 && maxLeaf >= 5U)
+    {
+        cpuid(5, &eax, &ebx, &ecx, &edx);
+        uint32_t lineSize = ebx & 0xFFFFU;
+        if (lineSize != 0 && lineSize <= 64U)
+        {
+            expectedMethod = KE_IDLE_METHOD_MWAIT;
+            expectedLine = lineSize;
+        }
+    }
+
+    klog(KLOG_LEVEL_INFO, "[IDLEDEMO] method=%s monitor_line=%u (cpuid expects %s/%u)\n",
+         stats->Method == KE_IDLE_METHOD_MWAIT ? "mwait" : "hlt", stats->MonitorLineSize,
+         expectedMethod == KE_IDLE_METHOD_MWAIT ? "mwait" : "hlt", expectedLine);
+
+    if (stats->Method != expectedMethod)
+        HO_KPANIC(EC_INVALID_STATE, "idle: idle method does not match CPUID");
+    if (stats->MonitorLineSize != expectedLine)
+        HO_KPANIC(EC_INVALID_STATE, "idle: monitor line size does not match CPUID");
+}
+
+static uint64_t
+KiIdleDemoHistogramTotal(const KE_IDLE_STATS *stats)
+{
+    uint64_t total = 0;
+    for (uint32_t bucket = 0; bucket < KE_IDLE_RESIDENCY_BUCKETS; ++bucket)
+        total += stats->ResidencyHistogram[bucket];
+    return total;
+}
+
+static void
+KiIdleDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    KE_IDLE_STATS before = {0};
+    KE_IDLE_STATS after = {0};
+
+    KiIdleDemoQuery(&before);
+    KiIdleDemoCheckMethod(&before);
+
+    for (uint32_t index = 0; index < IDLE_DEMO_SLEEPS; ++index)
+        KeSleep(IDLE_DEMO_SLEEP_NS);
+
+    KiIdleDemoQuery(&after);
+
+    uint64_t entries = after.EntryCount - before.EntryCount;
+    uint64_t interruptWakes = after.InterruptWakeCount - before.InterruptWakeCount;
+    uint64_t monitorWakes = after.MonitorWakeCount - before.MonitorWakeCount;
+    uint64_t samples = KiIdleDemoHistogramTotal(&after) - KiIdleDemoHistogramTotal(&before);
+    uint64_t residencyNs = after.TotalResidencyNs - before.TotalResidencyNs;
+    uint64_t exitSamples = after.ExitLatencySamples - before.ExitLatencySamples;
+    uint64_t exitCycles = after.TotalExitLatencyCycles - before.TotalExitLatencyCycles;
+
+    klog(KLOG_LEVEL_INFO,
+         "[IDLEDEMO] entries=%lu skipped=%lu irq_wakes=%lu monitor_wakes=%lu residency_ms=%lu max_residency_us=%lu\n",
+         (unsigned long)entries, (unsigned long)(after.SkippedCount - before.SkippedCount),
+         (unsigned long)interruptWakes, (unsigned long)monitorWakes, (unsigned long)(residencyNs / 1000000ULL),
+         (unsigned long)(after.MaxResidencyNs / 1000ULL));
+    klog(KLOG_LEVEL_INFO, "[IDLEDEMO] histogram <10us=%lu <100us=%lu <1ms=%lu <10ms=%lu <100ms=%lu >=100ms=%lu\n",
+         (unsigned long)(after.ResidencyHistogram[0] - before.ResidencyHistogram[0]),
+         (unsigned long)(after.ResidencyHistogram[1] - before.ResidencyHistogram[1]),
+         (unsigned long)(after.ResidencyHistogram[2] - before.ResidencyHistogram[2]),
+         (unsigned long)(after.ResidencyHistogram[3] - before.ResidencyHistogram[3]),
+         (unsigned long)(after.ResidencyHistogram[4] - before.ResidencyHistogram[4]),
+         (unsigned long)(after.ResidencyHistogram[5] - before.ResidencyHistogram[5]));
+    klog(KLOG_LEVEL_INFO, "[IDLEDEMO] exit samples=%lu avg_cycles=%lu max_cycles=%lu\n", (unsigned long)exitSamples,
+         (unsigned long)(exitSamples != 0 ? exitCycles / exitSamples : 0), (unsigned long)after.MaxExitLatencyCycles);
+
+    if (entries == 0)
+        HO_KPANIC(EC_INVALID_STATE, "idle: the CPU never idled across the sleeps");
+    if (samples == 0 || residencyNs == 0)
+        HO_KPANIC(EC_INVALID_STATE, "idle: residency histogram did not advance");
+    // Every wake, by interrupt or by monitor, closes exactly one residency sample.
+    if (samples != interruptWakes + monitorWakes)
+        HO_KPANIC(EC_INVALID_STATE, "idle: residency samples do not match wake events");
+    if (exitSamples == 0 || exitCycles == 0)
+        HO_KPANIC(EC_INVALID_STATE, "idle: exit-latency counters did not advance");
+    // Nothing else runs during the sleeps, so most of that time must be spent halted.
+    if (residencyNs < IDLE_DEMO_SLEEPS * IDLE_DEMO_SLEEP_NS / 4U)
+        HO_KPANIC(EC_INVALID_STATE, "idle: idle residency is far below the time slept");
+
+    klog(KLOG_LEVEL_INFO, "[IDLEDEMO] idle driver regression passed\n");
+}
+
+void
+RunIdleDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiIdleDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create idle controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start idle controller thread");
+}
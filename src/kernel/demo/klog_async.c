@@ -0,0 +1,136 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/klog_async.c
+ * Description: Asynchronous klog profile. Compares the producer cost of a
+ *              queued klog line with a synchronous console write of the same
+ *              text, overruns the ring while the drain thread cannot run and
+ *              checks the drop counter, then lets the drain thread catch up and
+ *              finds a marker line in the KE_SYSINFO_KLOG ring snapshot.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <kernel/ke/sysinfo.h>
+#include <kernel/log.h>
+#include <libc/string.h>
+
+#define KLOG_ASYNC_DEMO_COST_LINES 32U
+#define KLOG_ASYNC_DEMO_FLOOD      512U // About 90 KiB of text against a 64 KiB ring
+#define KLOG_ASYNC_DEMO_SETTLE_NS  50000000ULL
+#define KLOG_ASYNC_DEMO_MARKER     "[KLOGQ] marker 5a17c0de\n"
+
+// Static: SYSINFO_KLOG carries a 4 KiB text snapshot.
+static SYSINFO_KLOG gKlogAsyncDemoInfo;
+
+static void
+KiKlogAsyncDemoQuery(void)
+{
+    HO_STATUS status = KeQuerySystemInformation(KE_SYSINFO_KLOG, &gKlogAsyncDemoInfo, sizeof(gKlogAsyncDemoInfo), NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "klog_async: failed to query klog ring");
+}
+
+static BOOL
+KiKlogAsyncDemoTextContains(const char *text, uint32_t length, const char *needle)
+{
+    uint32_t needleLength = (uint32_t)strlen(needle);
+
+    for (uint32_t start = 0; start + needleLength <= length; ++start)
+    {
+        if (memcmp(text + start, needle, needleLength) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void
+KiKlogAsyncDemoMeasureCost(void)
+{
+    uint64_t start = rdtsc();
+    for (uint32_t index = 0; index < KLOG_ASYNC_DEMO_COST_LINES; ++index)
+        klog(KLOG_LEVEL_INFO, "[KLOGQ] cost line %u value=%lx\n", index, (unsigned long)start);
+    uint64_t queuedCycles = (rdtsc() - start) / KLOG_ASYNC_DEMO_COST_LINES;
+
+    start = rdtsc();
+    for (uint32_t index = 0; index < KLOG_ASYNC_DEMO_COST_LINES; ++index)
+        (void)ConsoleWriteFmt("[INF] [+0000.000000] [KLOGQ] sync line %u value=%lx\n", index, (unsigned long)start);
+    uint64_t syncCycles = (rdtsc() - start) / KLOG_ASYNC_DEMO_COST_LINES;
+
+    if (queuedCycles >= syncCycles)
+        HO_KPANIC(EC_INVALID_STATE, "klog_async: queued klog is not cheaper than a console write");
+
+    klog(KLOG_LEVEL_INFO, "[KLOGQ] cycles/line: queued=%lu console=%lu (lines=%u)\n", (unsigned long)queuedCycles,
+         (unsigned long)syncCycles, KLOG_ASYNC_DEMO_COST_LINES);
+}
+
+static void
+KiKlogAsyncDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    KiKlogAsyncDemoQuery();
+    if (gKlogAsyncDemoInfo.Stats.Mode != KE_KLOG_MODE_ASYNC)
+        HO_KPANIC(EC_INVALID_STATE, "klog_async: klog is not in asynchronous mode after boot");
+    if (gKlogAsyncDemoInfo.Stats.RingSize != KE_KLOG_RING_SIZE)
+        HO_KPANIC(EC_INVALID_STATE, "klog_async: sysinfo ring size disagrees");
+
+    KiKlogAsyncDemoMeasureCost();
+
+    // This thread outranks the drain thread and never blocks here, so nothing
+    // drains until the flood is over and the ring must overflow.
+    KE_KLOG_STATS before = {0};
+    KLogQueryStats(&before);
+    for (uint32_t index = 0; index < KLOG_ASYNC_DEMO_FLOOD; ++index)
+    {
+        klog(KLOG_LEVEL_INFO, "[KLOGQ] flood %03u ........................................................"
+                              "................................................................\n",
+             index);
+    }
+    KE_KLOG_STATS after = {0};
+    KLogQueryStats(&after);
+
+    uint64_t committed = after.RecordCount - before.RecordCount;
+    uint64_t dropped = after.DroppedCount - before.DroppedCount;
+    if (dropped == 0 || committed + dropped < KLOG_ASYNC_DEMO_FLOOD)
+        HO_KPANIC(EC_INVALID_STATE, "klog_async: flood did not overrun the ring");
+    if (after.MaxPendingBytes > after.RingSize)
+        HO_KPANIC(EC_INVALID_STATE, "klog_async: pending bytes exceed the ring");
+
+    KeSleep(KLOG_ASYNC_DEMO_SETTLE_NS);
+
+    klog(KLOG_LEVEL_INFO, "[KLOGQ] flood lines=%u committed=%lu dropped=%lu max_pending=%u\n", KLOG_ASYNC_DEMO_FLOOD,
+         (unsigned long)committed, (unsigned long)dropped, after.MaxPendingBytes);
+    klog(KLOG_LEVEL_INFO, KLOG_ASYNC_DEMO_MARKER);
+    KLogFlush();
+
+    KiKlogAsyncDemoQuery();
+    const KE_KLOG_STATS *stats = &gKlogAsyncDemoInfo.Stats;
+    if (stats->DrainedCount - after.DrainedCount < committed || stats->DrainWakeCount == before.DrainWakeCount)
+        HO_KPANIC(EC_INVALID_STATE, "klog_async: drain thread did not catch up after the flood");
+    if (!KiKlogAsyncDemoTextContains(gKlogAsyncDemoInfo.Text, gKlogAsyncDemoInfo.TextLength, KLOG_ASYNC_DEMO_MARKER))
+        HO_KPANIC(EC_INVALID_STATE, "klog_async: marker line missing from the sysinfo ring snapshot");
+
+    klog(KLOG_LEVEL_INFO, "[KLOGQ] records=%lu drained=%lu wakes=%lu dropped=%lu truncated=%lu direct=%lu\n",
+         (unsigned long)stats->RecordCount, (unsigned long)stats->DrainedCount, (unsigned long)stats->DrainWakeCount,
+         (unsigned long)stats->DroppedCount, (unsigned long)stats->TruncatedCount,
+         (unsigned long)stats->DirectWriteCount);
+    klog(KLOG_LEVEL_INFO, "[KLOGQ] async klog regression passed\n");
+}
+
+void
+RunKlogAsyncDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiKlogAsyncDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create async klog controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start async klog controller thread");
+}
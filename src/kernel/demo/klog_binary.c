@@ -0,0 +1,106 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/klog_binary.c
+ * Description: Binary klog profile. Compares the producer cost of a binary
+ *              klog record with the text formatter on the same SYS_WRITE-style
+ *              line, checks that binary records are counted and kept out of the
+ *              text snapshot, and that the mixed mode still stores a WARNING as
+ *              text. Built with HO_ENABLE_BINARY_LOG=1; its INFO lines are read
+ *              back through scripts/klog_decode.py.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <kernel/log.h>
+#include <libc/string.h>
+
+#define KLOG_BINARY_DEMO_LINES  32U
+#define KLOG_BINARY_DEMO_LINE   "[KLOGB] stdout capability write succeeds bytes=%lu thread=%u handle=%u\n"
+#define KLOG_BINARY_DEMO_MARKER "[KLOGB] marker 6b10b1e5"
+
+#if HO_ENABLE_BINARY_LOG
+static char gKlogBinaryDemoText[4096];
+
+static BOOL
+KiKlogBinaryDemoRecentContains(const char *needle)
+{
+    uint32_t length = KLogReadRecent(gKlogBinaryDemoText, sizeof(gKlogBinaryDemoText));
+    uint32_t needleLength = (uint32_t)strlen(needle);
+
+    for (uint32_t start = 0; start + needleLength <= length; ++start)
+    {
+        if (memcmp(gKlogBinaryDemoText + start, needle, needleLength) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+#endif
+
+static void
+KiKlogBinaryDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+#if !HO_ENABLE_BINARY_LOG
+    klog(KLOG_LEVEL_INFO, "[KLOGB] built without HO_ENABLE_BINARY_LOG, skipped\n");
+#else
+    KE_KLOG_STATS before = {0};
+    KLogQueryStats(&before);
+    if (before.BinaryCount == 0)
+        HO_KPANIC(EC_INVALID_STATE, "klog_binary: boot logged no binary records");
+
+    // This thread outranks the drain thread, so both loops only pay for the producer side.
+    uint64_t start = rdtsc();
+    for (uint32_t index = 0; index < KLOG_BINARY_DEMO_LINES; ++index)
+        klog(KLOG_LEVEL_INFO, KLOG_BINARY_DEMO_LINE, (unsigned long)index * 64U, index, 3U);
+    uint64_t binaryCycles = (rdtsc() - start) / KLOG_BINARY_DEMO_LINES;
+
+    start = rdtsc();
+    for (uint32_t index = 0; index < KLOG_BINARY_DEMO_LINES; ++index)
+        (void)KLogWriteFmt(KLOG_LEVEL_INFO, KLOG_BINARY_DEMO_LINE, (unsigned long)index * 64U, index, 3U);
+    uint64_t textCycles = (rdtsc() - start) / KLOG_BINARY_DEMO_LINES;
+
+    KE_KLOG_STATS after = {0};
+    KLogQueryStats(&after);
+    if (after.BinaryCount - before.BinaryCount != KLOG_BINARY_DEMO_LINES)
+        HO_KPANIC(EC_INVALID_STATE, "klog_binary: binary loop did not commit one binary record per line");
+    if (after.DroppedCount != before.DroppedCount)
+        HO_KPANIC(EC_INVALID_STATE, "klog_binary: ring dropped lines during the cost loops");
+    if (binaryCycles >= textCycles)
+        HO_KPANIC(EC_INVALID_STATE, "klog_binary: binary record is not cheaper than formatting");
+
+    klog(KLOG_LEVEL_INFO, KLOG_BINARY_DEMO_MARKER " info\n");
+#if HO_BINARY_LOG_MIXED
+    klog(KLOG_LEVEL_WARNING, KLOG_BINARY_DEMO_MARKER " warning\n");
+    if (!KiKlogBinaryDemoRecentContains(KLOG_BINARY_DEMO_MARKER " warning"))
+        HO_KPANIC(EC_INVALID_STATE, "klog_binary: mixed mode did not keep the WARNING line as text");
+#endif
+    if (KiKlogBinaryDemoRecentContains(KLOG_BINARY_DEMO_MARKER " info"))
+        HO_KPANIC(EC_INVALID_STATE, "klog_binary: binary record leaked into the text snapshot");
+    KLogFlush();
+
+    klog(KLOG_LEVEL_INFO, "[KLOGB] cycles/line: binary=%lu text=%lu (lines=%u)\n", (unsigned long)binaryCycles,
+         (unsigned long)textCycles, KLOG_BINARY_DEMO_LINES);
+    klog(KLOG_LEVEL_INFO, "[KLOGB] binary records=%lu status=%ke who=%s\n", (unsigned long)after.BinaryCount,
+         EC_SUCCESS, "klog_binary");
+    klog(KLOG_LEVEL_INFO, "[KLOGB] binary klog regression passed\n");
+#endif
+}
+
+void
+RunKlogBinaryDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiKlogBinaryDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create binary klog controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start binary klog controller thread");
+}
@@ -0,0 +1,132 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/klog_levels.c
+ * Description: Runtime klog level profile. Times the same DBG line with its
+ *              category switched off (the inline check only) and on (the full
+ *              producer), checks that an off category commits nothing, and that
+ *              a malformed level spec is rejected without changing any level.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <kernel/log.h>
+#include <libc/string.h>
+
+#define KLOG_LEVELS_DEMO_LINES 64U
+#define KLOG_LEVELS_DEMO_LINE  "[KLOGQ] quiet category line index=%u bytes=%lu\n"
+
+static char gKlogLevelsDemoText[1024];
+
+static void
+KiKlogLevelsDemoApply(const char *spec, HO_STATUS expected)
+{
+    HO_STATUS status = KLogApplyLevelSpec(spec, (uint32_t)strlen(spec), NULL);
+    if (status != expected)
+        HO_KPANIC(EC_INVALID_STATE, "klog_levels: level spec not handled as expected");
+}
+
+static BOOL
+KiKlogLevelsDemoContains(uint32_t length, const char *needle)
+{
+    uint32_t needleLength = (uint32_t)strlen(needle);
+
+    for (uint32_t start = 0; start + needleLength <= length; ++start)
+    {
+        if (memcmp(gKlogLevelsDemoText + start, needle, needleLength) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static BOOL
+KiKlogLevelsDemoListContains(const char *needle)
+{
+    return KiKlogLevelsDemoContains(KLogFormatCategoryLevels(gKlogLevelsDemoText, sizeof(gKlogLevelsDemoText)),
+                                    needle);
+}
+
+// Returns cycles per line; *outRecords receives the lines committed meanwhile.
+static uint64_t
+KiKlogLevelsDemoRun(uint64_t *outRecords)
+{
+    KE_KLOG_STATS before = {0};
+    KE_KLOG_STATS after = {0};
+
+    KLogQueryStats(&before);
+    uint64_t start = rdtsc();
+    for (uint32_t index = 0; index < KLOG_LEVELS_DEMO_LINES; ++index)
+        klog(KLOG_LEVEL_DEBUG, KLOG_LEVELS_DEMO_LINE, index, (unsigned long)index * 64U);
+    uint64_t cycles = (rdtsc() - start) / KLOG_LEVELS_DEMO_LINES;
+    KLogQueryStats(&after);
+
+    *outRecords = after.RecordCount - before.RecordCount;
+    return cycles;
+}
+
+static void
+KiKlogLevelsDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    if (HO_LOG_MIN_LEVEL > KLOG_LEVEL_DEBUG)
+    {
+        klog(KLOG_LEVEL_WARNING, "[KLOGL] DBG lines are compiled out (HO_LOG_MIN_LEVEL), skipped\n");
+        return;
+    }
+
+    uint64_t records = 0;
+
+    // This thread outranks the drain thread, so the enabled run only pays for the producer side.
+    KiKlogLevelsDemoApply("KLOGQ:off", EC_SUCCESS);
+    uint64_t offCycles = KiKlogLevelsDemoRun(&records);
+    if (records != 0)
+        HO_KPANIC(EC_INVALID_STATE, "klog_levels: off category still committed lines");
+    if (!KiKlogLevelsDemoListContains("\nKLOGQ off\n"))
+        HO_KPANIC(EC_INVALID_STATE, "klog_levels: category listing does not show KLOGQ off");
+
+    KiKlogLevelsDemoApply("KLOGQ:debug", EC_SUCCESS);
+    uint64_t onCycles = KiKlogLevelsDemoRun(&records);
+    if (records != KLOG_LEVELS_DEMO_LINES)
+        HO_KPANIC(EC_INVALID_STATE, "klog_levels: enabled category did not commit every line");
+    if (offCycles * 4U >= onCycles)
+        HO_KPANIC(EC_INVALID_STATE, "klog_levels: disabled line is not much cheaper than an enabled one");
+
+    // A bad entry anywhere rejects the whole spec.
+    KiKlogLevelsDemoApply("KLOGQ:loud", EC_ILLEGAL_ARGUMENT);
+    KiKlogLevelsDemoApply("KLOGQ", EC_ILLEGAL_ARGUMENT);
+    KiKlogLevelsDemoApply("KLOGQ:off,", EC_ILLEGAL_ARGUMENT);
+    KiKlogLevelsDemoApply("KLOGQ:off,BAD TAG:info", EC_ILLEGAL_ARGUMENT);
+    if (!KiKlogLevelsDemoListContains("\nKLOGQ debug\n"))
+        HO_KPANIC(EC_INVALID_STATE, "klog_levels: rejected spec changed a level");
+
+    // Setting a level ahead of the first call site registers the category.
+    KiKlogLevelsDemoApply("KLOGR:warning,KLOGQ:info", EC_SUCCESS);
+    if (!KiKlogLevelsDemoListContains("\nKLOGR warning\n") || !KiKlogLevelsDemoListContains("\nKLOGQ info\n"))
+        HO_KPANIC(EC_INVALID_STATE, "klog_levels: spec did not set both categories");
+    klog(KLOG_LEVEL_INFO, "[KLOGR] this line is below its category level\n");
+    if (KiKlogLevelsDemoContains(KLogReadRecent(gKlogLevelsDemoText, sizeof(gKlogLevelsDemoText)),
+                                 "below its category level"))
+        HO_KPANIC(EC_INVALID_STATE, "klog_levels: pre-registered category level was ignored");
+
+    klog(KLOG_LEVEL_INFO, "[KLOGL] cycles/line: off=%lu on=%lu (lines=%u)\n", (unsigned long)offCycles,
+         (unsigned long)onCycles, KLOG_LEVELS_DEMO_LINES);
+    klog(KLOG_LEVEL_INFO, "[KLOGL] runtime klog level regression passed\n");
+}
+
+void
+RunKlogLevelsDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiKlogLevelsDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create klog level controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start klog level controller thread");
+}
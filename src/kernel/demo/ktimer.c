@@ -0,0 +1,174 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/ktimer.c
+ * Description: KTIMER regression. Covers relative and absolute one-shot
+ *              notification timers, a periodic synchronization timer with an
+ *              expiry DPC, cancellation before expiry and a zero-timeout poll.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <kernel/ke/dpc.h>
+#include <kernel/ke/time_source.h>
+#include <kernel/ke/timer.h>
+
+#define KTIMER_DEMO_RELATIVE_NS 2000000ULL   // 2 ms
+#define KTIMER_DEMO_ABSOLUTE_NS 3000000ULL   // 3 ms
+#define KTIMER_DEMO_PERIOD_NS   1000000ULL   // 1 ms
+#define KTIMER_DEMO_PERIODS     5U
+#define KTIMER_DEMO_CANCEL_NS   50000000ULL  // 50 ms
+#define KTIMER_DEMO_WAIT_NS     200000000ULL // Upper bound for any single wait
+
+static KTIMER gKtimerDemoOneShot;
+static KTIMER gKtimerDemoPeriodic;
+static KDPC gKtimerDemoDpc;
+static volatile uint32_t gKtimerDemoDpcCount;
+
+static void
+KiKtimerDemoAssert(BOOL condition, const char *reason)
+{
+    if (!condition)
+        HO_KPANIC(EC_INVALID_STATE, reason);
+}
+
+static void
+KiKtimerDemoDpcRoutine(KDPC *dpc, void *context)
+{
+    (void)dpc;
+    (void)context;
+    gKtimerDemoDpcCount++;
+}
+
+static void
+KiKtimerDemoOneShot(void)
+{
+    KeInitializeTimer(&gKtimerDemoOneShot, KTIMER_NOTIFICATION);
+    KiKtimerDemoAssert(!KeReadStateTimer(&gKtimerDemoOneShot), "ktimer: fresh timer is signaled");
+
+    uint64_t start = KeGetSystemUpTimeNs();
+    HO_STATUS status = KeSetTimer(&gKtimerDemoOneShot, KTIMER_DEMO_RELATIVE_NS, 0, NULL, KTIMER_FLAG_NONE);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "ktimer: failed to set relative timer");
+
+    status = KeWaitForSingleObject(&gKtimerDemoOneShot, KTIMER_DEMO_WAIT_NS);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "ktimer: relative timer wait failed");
+    uint64_t elapsed = KeGetSystemUpTimeNs() - start;
+    KiKtimerDemoAssert(elapsed >= KTIMER_DEMO_RELATIVE_NS, "ktimer: relative timer fired early");
+    KiKtimerDemoAssert(KeReadStateTimer(&gKtimerDemoOneShot), "ktimer: notification timer not left signaled");
+
+    // A notification timer stays signaled, so a second wait must not block.
+    status = KeWaitForSingleObject(&gKtimerDemoOneShot, 0);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "ktimer: signaled notification timer did not satisfy a poll");
+    KiKtimerDemoAssert(!KeCancelTimer(&gKtimerDemoOneShot), "ktimer: expired one-shot still armed");
+
+    klog(KLOG_LEVEL_INFO, "[KTIMER] relative one-shot due=%lu ns elapsed=%lu ns\n",
+         (unsigned long)KTIMER_DEMO_RELATIVE_NS, (unsigned long)elapsed);
+
+    uint64_t dueNs = KeGetSystemUpTimeNs() + KTIMER_DEMO_ABSOLUTE_NS;
+    status = KeSetTimer(&gKtimerDemoOneShot, dueNs, 0, NULL, KTIMER_FLAG_ABSOLUTE);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "ktimer: failed to set absolute timer");
+    KiKtimerDemoAssert(!KeReadStateTimer(&gKtimerDemoOneShot), "ktimer: re-arm did not reset the signal");
+
+    status = KeWaitForSingleObject(&gKtimerDemoOneShot, KTIMER_DEMO_WAIT_NS);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "ktimer: absolute timer wait failed");
+    uint64_t now = KeGetSystemUpTimeNs();
+    KiKtimerDemoAssert(now >= dueNs, "ktimer: absolute timer fired before its due time");
+
+    klog(KLOG_LEVEL_INFO, "[KTIMER] absolute one-shot late=%lu ns\n", (unsigned long)(now - dueNs));
+}
+
+static void
+KiKtimerDemoPeriodic(void)
+{
+    KeInitializeTimer(&gKtimerDemoPeriodic, KTIMER_SYNCHRONIZATION);
+    KeInitializeDpc(&gKtimerDemoDpc, KiKtimerDemoDpcRoutine, NULL);
+    gKtimerDemoDpcCount = 0;
+
+    // Nothing armed yet: a poll must time out rather than consume a stale signal.
+    HO_STATUS status = KeWaitForSingleObject(&gKtimerDemoPeriodic, 0);
+    if (status != EC_TIMEOUT)
+        HO_KPANIC(EC_INVALID_STATE, "ktimer: unsignaled synchronization timer satisfied a poll");
+
+    uint64_t start = KeGetSystemUpTimeNs();
+    status = KeSetTimer(&gKtimerDemoPeriodic, KTIMER_DEMO_PERIOD_NS, KTIMER_DEMO_PERIOD_NS, &gKtimerDemoDpc,
+                        KTIMER_FLAG_NONE);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "ktimer: failed to set periodic timer");
+
+    for (uint32_t index = 0; index < KTIMER_DEMO_PERIODS; ++index)
+    {
+        status = KeWaitForSingleObject(&gKtimerDemoPeriodic, KTIMER_DEMO_WAIT_NS);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "ktimer: periodic timer wait failed");
+    }
+    uint64_t elapsed = KeGetSystemUpTimeNs() - start;
+
+    KiKtimerDemoAssert(KeCancelTimer(&gKtimerDemoPeriodic), "ktimer: periodic timer was not armed at cancel");
+    KiKtimerDemoAssert(!KeCancelTimer(&gKtimerDemoPeriodic), "ktimer: second cancel reported an armed timer");
+    KiKtimerDemoAssert(elapsed >= KTIMER_DEMO_PERIODS * KTIMER_DEMO_PERIOD_NS, "ktimer: periods completed early");
+    KiKtimerDemoAssert(gKtimerDemoPeriodic.ExpiryCount >= KTIMER_DEMO_PERIODS, "ktimer: expiries not counted");
+
+    // The DPC for the last expiry may still be queued behind this thread; give it a tick.
+    KeSleep(KTIMER_DEMO_PERIOD_NS);
+    KiKtimerDemoAssert(gKtimerDemoDpcCount >= KTIMER_DEMO_PERIODS, "ktimer: expiry DPC did not run per period");
+
+    klog(KLOG_LEVEL_INFO, "[KTIMER] periodic period=%lu ns waits=%u expiries=%lu dpcs=%u elapsed=%lu ns\n",
+         (unsigned long)KTIMER_DEMO_PERIOD_NS, KTIMER_DEMO_PERIODS, (unsigned long)gKtimerDemoPeriodic.ExpiryCount,
+         gKtimerDemoDpcCount, (unsigned long)elapsed);
+}
+
+static void
+KiKtimerDemoCancel(void)
+{
+    KeInitializeTimer(&gKtimerDemoOneShot, KTIMER_NOTIFICATION);
+
+    HO_STATUS status = KeSetTimer(&gKtimerDemoOneShot, KTIMER_DEMO_CANCEL_NS, 0, NULL, KTIMER_FLAG_NONE);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "ktimer: failed to set timer for cancel");
+    KiKtimerDemoAssert(KeCancelTimer(&gKtimerDemoOneShot), "ktimer: pending timer was not armed");
+
+    status = KeWaitForSingleObject(&gKtimerDemoOneShot, KTIMER_DEMO_CANCEL_NS + KTIMER_DEMO_CANCEL_NS / 5U);
+    if (status != EC_TIMEOUT)
+        HO_KPANIC(EC_INVALID_STATE, "ktimer: cancelled timer still fired");
+    KiKtimerDemoAssert(!KeCancelTimer(&gKtimerDemoOneShot), "ktimer: cancelled timer re-armed itself");
+
+    status = KeSetTimer(&gKtimerDemoOneShot, 0, 0, NULL, KTIMER_FLAG_ABSOLUTE | (1U << 7));
+    if (status != EC_ILLEGAL_ARGUMENT)
+        HO_KPANIC(EC_INVALID_STATE, "ktimer: unknown flag was accepted");
+
+    klog(KLOG_LEVEL_INFO, "[KTIMER] cancel before expiry held for %lu ns\n",
+         (unsigned long)(KTIMER_DEMO_CANCEL_NS + KTIMER_DEMO_CANCEL_NS / 5U));
+}
+
+static void
+KiKtimerDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    KiKtimerDemoOneShot();
+    KiKtimerDemoPeriodic();
+    KiKtimerDemoCancel();
+
+    klog(KLOG_LEVEL_INFO, "[KTIMER] kernel timer regression passed\n");
+}
+
+void
+RunKtimerDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiKtimerDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create KTIMER controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start KTIMER controller thread");
+}
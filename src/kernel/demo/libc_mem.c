@@ -0,0 +1,271 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/libc_mem.c
+ * Description: libc memory routine profile. Checks memcpy, memset and memmove
+ *              (both overlap directions) against byte-wise expectations across
+ *              sizes, alignments and feature restrictions, then times copies and
+ *              fills from 1 B to 2 MiB against the old byte loops, the general
+ *              register block loop, and temporal against streaming stores.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <kernel/ke/mm.h>
+#include <libc/hostdlib.h>
+#include <libc/string.h>
+
+#define LIBC_MEM_DEMO_MAX_BYTES  (2U * 1024U * 1024U)
+#define LIBC_MEM_DEMO_SLACK      512U
+#define LIBC_MEM_DEMO_CHECK_MAX  600U
+#define LIBC_MEM_DEMO_GUARD      0xEEU
+#define LIBC_MEM_DEMO_MOVE_BASE  128U
+#define LIBC_MEM_DEMO_BUDGET     (256U * 1024U) // Bytes per timing sample; small sizes repeat to reach it
+#define LIBC_MEM_DEMO_ASSERT_MIN 4096U          // From here on the dispatched routines must beat the byte loops
+
+static uint8_t *gLibcMemDemoSrc;
+static uint8_t *gLibcMemDemoDst;
+
+static const uint32_t gLibcMemDemoMasks[] = {
+    ~0U,
+    0U,
+    MEM_FEATURE_ERMS,
+    MEM_FEATURE_FSRM,
+    MEM_FEATURE_NONTEMPORAL,
+};
+
+static const int32_t gLibcMemDemoMoveDistances[] = {-65, -33, -32, -31, -8, -1, 1, 7, 8, 31, 32, 33, 65};
+
+static uint8_t
+KiLibcMemDemoPattern(size_t index, uint32_t seed)
+{
+    return (uint8_t)(index * 131U + seed * 7U + (index >> 8));
+}
+
+static void
+KiLibcMemDemoFail(const char *what, uint32_t mask, size_t size, size_t offset)
+{
+    klog(KLOG_LEVEL_ERROR, "[MEMB] %s mismatch: features=%x size=%lu offset=%lu\n", what, mask, (unsigned long)size,
+         (unsigned long)offset);
+    HO_KPANIC(EC_INVALID_STATE, "libc_mem: memory routine produced wrong bytes");
+}
+
+static void
+KiLibcMemDemoCheckCopyAndFill(uint32_t mask, size_t size, size_t srcOffset, size_t dstOffset)
+{
+    size_t span = size + dstOffset + 64U;
+
+    for (size_t index = 0; index < size + srcOffset; ++index)
+        gLibcMemDemoSrc[index] = KiLibcMemDemoPattern(index, (uint32_t)size);
+    for (size_t index = 0; index < span; ++index)
+        gLibcMemDemoDst[index] = LIBC_MEM_DEMO_GUARD;
+
+    if (memcpy(gLibcMemDemoDst + dstOffset, gLibcMemDemoSrc + srcOffset, size) != gLibcMemDemoDst + dstOffset)
+        KiLibcMemDemoFail("memcpy return", mask, size, dstOffset);
+    for (size_t index = 0; index < span; ++index)
+    {
+        BOOL inside = index >= dstOffset && index < dstOffset + size;
+        uint8_t expected = inside ? KiLibcMemDemoPattern(index - dstOffset + srcOffset, (uint32_t)size)
+                                  : (uint8_t)LIBC_MEM_DEMO_GUARD;
+        if (gLibcMemDemoDst[index] != expected)
+            KiLibcMemDemoFail("memcpy", mask, size, dstOffset);
+    }
+
+    // Only the low byte of the value counts.
+    uint8_t value = (uint8_t)(size * 3U + 1U);
+    if (memset(gLibcMemDemoDst + dstOffset, 0x100 | value, size) != gLibcMemDemoDst + dstOffset)
+        KiLibcMemDemoFail("memset return", mask, size, dstOffset);
+    for (size_t index = 0; index < span; ++index)
+    {
+        BOOL inside = index >= dstOffset && index < dstOffset + size;
+        uint8_t expected = inside ? value : (uint8_t)LIBC_MEM_DEMO_GUARD;
+        if (gLibcMemDemoDst[index] != expected)
+            KiLibcMemDemoFail("memset", mask, size, dstOffset);
+    }
+}
+
+static void
+KiLibcMemDemoCheckMove(uint32_t mask, size_t size, int32_t distance)
+{
+    size_t span = LIBC_MEM_DEMO_MOVE_BASE * 2U + size;
+    size_t to = (size_t)((int64_t)LIBC_MEM_DEMO_MOVE_BASE + distance);
+
+    for (size_t index = 0; index < span; ++index)
+        gLibcMemDemoDst[index] = KiLibcMemDemoPattern(index, (uint32_t)distance);
+
+    if (memmove(gLibcMemDemoDst + to, gLibcMemDemoDst + LIBC_MEM_DEMO_MOVE_BASE, size) != gLibcMemDemoDst + to)
+        KiLibcMemDemoFail("memmove return", mask, size, to);
+    for (size_t index = 0; index < span; ++index)
+    {
+        size_t source = index >= to && index < to + size ? index - to + LIBC_MEM_DEMO_MOVE_BASE : index;
+        if (gLibcMemDemoDst[index] != KiLibcMemDemoPattern(source, (uint32_t)distance))
+            KiLibcMemDemoFail("memmove", mask, size, to);
+    }
+}
+
+static void
+KiLibcMemDemoCheckAll(void)
+{
+    size_t previousThreshold = MemSetNonTemporalThreshold(0);
+
+    for (uint32_t maskIndex = 0; maskIndex < sizeof(gLibcMemDemoMasks) / sizeof(gLibcMemDemoMasks[0]); ++maskIndex)
+    {
+        uint32_t mask = gLibcMemDemoMasks[maskIndex];
+        (void)MemRestrictFeatures(mask);
+        // Let the streaming path see sizes the sweep reaches.
+        (void)MemSetNonTemporalThreshold(mask == MEM_FEATURE_NONTEMPORAL ? 64U : 0U);
+
+        for (size_t size = 0; size <= LIBC_MEM_DEMO_CHECK_MAX; size += size < 80U ? 1U : 13U)
+        {
+            KiLibcMemDemoCheckCopyAndFill(mask, size, 0, 0);
+            KiLibcMemDemoCheckCopyAndFill(mask, size, 3, 13);
+            KiLibcMemDemoCheckCopyAndFill(mask, size, 9, 1);
+            for (uint32_t index = 0; index < sizeof(gLibcMemDemoMoveDistances) / sizeof(gLibcMemDemoMoveDistances[0]);
+                 ++index)
+                KiLibcMemDemoCheckMove(mask, size, gLibcMemDemoMoveDistances[index]);
+        }
+    }
+
+    // One copy past the largest benchmark size, misaligned on both sides.
+    (void)MemRestrictFeatures(~0U);
+    (void)MemSetNonTemporalThreshold(previousThreshold);
+    for (size_t index = 0; index < LIBC_MEM_DEMO_MAX_BYTES + 32U; ++index)
+        gLibcMemDemoSrc[index] = KiLibcMemDemoPattern(index, 5U);
+    memcpy(gLibcMemDemoDst + 3U, gLibcMemDemoSrc + 1U, LIBC_MEM_DEMO_MAX_BYTES + 17U);
+    for (size_t index = 0; index < LIBC_MEM_DEMO_MAX_BYTES + 17U; ++index)
+    {
+        if (gLibcMemDemoDst[index + 3U] != KiLibcMemDemoPattern(index + 1U, 5U))
+            KiLibcMemDemoFail("large memcpy", ~0U, LIBC_MEM_DEMO_MAX_BYTES + 17U, 3U);
+    }
+}
+
+// The routines as they were before dispatch, kept as the baseline.
+static void
+KiLibcMemDemoByteCopy(uint8_t *dst, const uint8_t *src, size_t size)
+{
+    while (size--)
+        *dst++ = *src++;
+}
+
+static void
+KiLibcMemDemoByteFill(uint8_t *dst, uint8_t value, size_t size)
+{
+    while (size--)
+        *dst++ = value;
+}
+
+typedef enum LIBC_MEM_DEMO_OP
+{
+    LIBC_MEM_DEMO_BYTE_COPY,
+    LIBC_MEM_DEMO_MEMCPY,
+    LIBC_MEM_DEMO_BYTE_FILL,
+    LIBC_MEM_DEMO_MEMSET,
+} LIBC_MEM_DEMO_OP;
+
+// Returns cycles per call.
+static uint64_t
+KiLibcMemDemoTime(LIBC_MEM_DEMO_OP op, size_t size)
+{
+    size_t iterations = size >= LIBC_MEM_DEMO_BUDGET ? 1U : LIBC_MEM_DEMO_BUDGET / size;
+    uint64_t start = rdtsc();
+
+    for (size_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        switch (op)
+        {
+        case LIBC_MEM_DEMO_BYTE_COPY:
+            KiLibcMemDemoByteCopy(gLibcMemDemoDst, gLibcMemDemoSrc, size);
+            break;
+        case LIBC_MEM_DEMO_MEMCPY:
+            memcpy(gLibcMemDemoDst, gLibcMemDemoSrc, size);
+            break;
+        case LIBC_MEM_DEMO_BYTE_FILL:
+            KiLibcMemDemoByteFill(gLibcMemDemoDst, (uint8_t)iteration, size);
+            break;
+        case LIBC_MEM_DEMO_MEMSET:
+            memset(gLibcMemDemoDst, (int)iteration, size);
+            break;
+        }
+    }
+    return (rdtsc() - start) / iterations;
+}
+
+static void
+KiLibcMemDemoBenchmark(void)
+{
+    // 1 B, 8 B, ... 2 MiB.
+    for (size_t bytes = 1; bytes <= LIBC_MEM_DEMO_MAX_BYTES; bytes *= 8U)
+    {
+        uint64_t byteCopy = KiLibcMemDemoTime(LIBC_MEM_DEMO_BYTE_COPY, bytes);
+        uint32_t previous = MemRestrictFeatures(0);
+        uint64_t blockCopy = KiLibcMemDemoTime(LIBC_MEM_DEMO_MEMCPY, bytes);
+        (void)MemRestrictFeatures(previous);
+        uint64_t copy = KiLibcMemDemoTime(LIBC_MEM_DEMO_MEMCPY, bytes);
+        uint64_t byteFill = KiLibcMemDemoTime(LIBC_MEM_DEMO_BYTE_FILL, bytes);
+        uint64_t fill = KiLibcMemDemoTime(LIBC_MEM_DEMO_MEMSET, bytes);
+
+        klog(KLOG_LEVEL_INFO, "[MEMB] %lu B: copy byte=%lu block=%lu memcpy=%lu fill byte=%lu memset=%lu cycles\n",
+             (unsigned long)bytes, (unsigned long)byteCopy, (unsigned long)blockCopy, (unsigned long)copy,
+             (unsigned long)byteFill, (unsigned long)fill);
+        if (bytes >= LIBC_MEM_DEMO_ASSERT_MIN && (copy >= byteCopy || fill >= byteFill))
+            HO_KPANIC(EC_INVALID_STATE, "libc_mem: dispatched routine is not faster than the byte loop");
+    }
+
+    size_t threshold = MemSetNonTemporalThreshold((size_t)-1);
+    uint64_t temporalCopy = KiLibcMemDemoTime(LIBC_MEM_DEMO_MEMCPY, LIBC_MEM_DEMO_MAX_BYTES);
+    uint64_t temporalFill = KiLibcMemDemoTime(LIBC_MEM_DEMO_MEMSET, LIBC_MEM_DEMO_MAX_BYTES);
+    (void)MemSetNonTemporalThreshold(LIBC_MEM_DEMO_MAX_BYTES);
+    uint64_t streamingCopy = KiLibcMemDemoTime(LIBC_MEM_DEMO_MEMCPY, LIBC_MEM_DEMO_MAX_BYTES);
+    uint64_t streamingFill = KiLibcMemDemoTime(LIBC_MEM_DEMO_MEMSET, LIBC_MEM_DEMO_MAX_BYTES);
+    (void)MemSetNonTemporalThreshold(threshold);
+
+    // Not asserted: whether streaming wins depends on the cache and on the emulator.
+    klog(KLOG_LEVEL_INFO,
+         "[MEMB] 2 MiB: copy temporal=%lu streaming=%lu fill temporal=%lu streaming=%lu cycles (threshold=%luKB)\n",
+         (unsigned long)temporalCopy, (unsigned long)streamingCopy, (unsigned long)temporalFill,
+         (unsigned long)streamingFill, (unsigned long)(threshold / 1024U));
+}
+
+static void
+KiLibcMemDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    uint32_t detected = 0;
+    uint32_t enabled = MemQueryFeatures(&detected);
+    klog(KLOG_LEVEL_INFO, "[MEMB] features: detected=%x enabled=%x erms=%u fsrm=%u nontemporal=%u\n", detected,
+         enabled, (enabled & MEM_FEATURE_ERMS) != 0, (enabled & MEM_FEATURE_FSRM) != 0,
+         (enabled & MEM_FEATURE_NONTEMPORAL) != 0);
+    if ((detected & (MEM_FEATURE_SSE2 | MEM_FEATURE_AVX2)) != 0)
+        HO_KPANIC(EC_INVALID_STATE, "libc_mem: kernel build offers vector loops it cannot save");
+
+    gLibcMemDemoSrc = kmalloc(LIBC_MEM_DEMO_MAX_BYTES + LIBC_MEM_DEMO_SLACK);
+    gLibcMemDemoDst = kmalloc(LIBC_MEM_DEMO_MAX_BYTES + LIBC_MEM_DEMO_SLACK);
+    if (gLibcMemDemoSrc == NULL || gLibcMemDemoDst == NULL)
+        HO_KPANIC(EC_OUT_OF_RESOURCE, "libc_mem: failed to allocate benchmark buffers");
+
+    KiLibcMemDemoCheckAll();
+    klog(KLOG_LEVEL_INFO, "[MEMB] memcpy/memset/memmove results match byte-wise expectations\n");
+    KiLibcMemDemoBenchmark();
+
+    kfree(gLibcMemDemoDst);
+    kfree(gLibcMemDemoSrc);
+    klog(KLOG_LEVEL_INFO, "[MEMB] libc memory routine regression passed\n");
+}
+
+void
+RunLibcMemDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiLibcMemDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create libc memory controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start libc memory controller thread");
+}
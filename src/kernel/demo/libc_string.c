@@ -0,0 +1,364 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/libc_string.c
+ * Description: libc string routine profile. Fuzzes strlen, strcmp and memcmp
+ *              against bytewise references with strings that end right before an
+ *              unmapped guard page, checks the digit-pair integer formatting of
+ *              the console printf engine against a digit-at-a-time reference,
+ *              and times both against the bytewise versions.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <arch/amd64/pm.h>
+#include <kernel/ke/mm.h>
+#include <libc/string.h>
+
+#define LIBC_STRING_DEMO_FUZZ_ROUNDS   20000U
+#define LIBC_STRING_DEMO_FORMAT_ROUNDS 4000U
+#define LIBC_STRING_DEMO_MAX_LENGTH    300U
+#define LIBC_STRING_DEMO_BUDGET        (64U * 1024U) // Bytes scanned per timing sample
+#define LIBC_STRING_DEMO_FORMAT_LINES  256U
+#define LIBC_STRING_DEMO_ASSERT_MIN    512U // From here on the word routines must beat the bytewise ones
+#define LIBC_STRING_DEMO_PAGE_ATTRS    (PTE_WRITABLE | PTE_GLOBAL | PTE_NO_EXECUTE)
+
+typedef struct LIBC_STRING_DEMO_PAGE
+{
+    KE_KVA_RANGE Range;
+    char *Base; // One mapped page; the next page is an unmapped guard
+} LIBC_STRING_DEMO_PAGE;
+
+static LIBC_STRING_DEMO_PAGE gLibcStringDemoPages[2];
+static uint64_t gLibcStringDemoSeed = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t
+KiLibcStringDemoRandom(void)
+{
+    gLibcStringDemoSeed ^= gLibcStringDemoSeed << 13;
+    gLibcStringDemoSeed ^= gLibcStringDemoSeed >> 7;
+    gLibcStringDemoSeed ^= gLibcStringDemoSeed << 17;
+    return gLibcStringDemoSeed;
+}
+
+static int
+KiLibcStringDemoSign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+// The routines as they were before, kept as references and as the timing baseline.
+static size_t
+KiLibcStringDemoByteStrlen(const char *str)
+{
+    const char *s = str;
+    while (*s)
+        s++;
+    return (size_t)(s - str);
+}
+
+static int
+KiLibcStringDemoByteStrcmp(const char *a, const char *b)
+{
+    while (*a && *b && *a == *b)
+    {
+        a++;
+        b++;
+    }
+    return (unsigned char)(*a) - (unsigned char)(*b);
+}
+
+static int
+KiLibcStringDemoByteMemcmp(const void *s1, const void *s2, size_t n)
+{
+    const unsigned char *p1 = s1;
+    const unsigned char *p2 = s2;
+
+    while (n--)
+    {
+        if (*p1 != *p2)
+            return *p1 - *p2;
+        p1++;
+        p2++;
+    }
+    return 0;
+}
+
+static void
+KiLibcStringDemoMapPage(LIBC_STRING_DEMO_PAGE *page)
+{
+    HO_STATUS status = KeKvaAllocRange(KE_KVA_ARENA_HEAP, 1, 0, 1, TRUE, &page->Range);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "libc_string: failed to reserve a guarded page");
+    status = KeKvaMapOwnedPages(&page->Range, LIBC_STRING_DEMO_PAGE_ATTRS);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "libc_string: failed to map a guarded page");
+    page->Base = (char *)(uint64_t)page->Range.UsableBase;
+}
+
+// Place a random string of the given length in the page. Most strings end on the page's last byte, so any read
+// past the terminator faults on the guard page.
+static char *
+KiLibcStringDemoPlace(const LIBC_STRING_DEMO_PAGE *page, size_t length, const char *prefix, size_t prefixLength,
+                      uint32_t alphabet)
+{
+    size_t slack = (KiLibcStringDemoRandom() % 3U) == 0 ? (size_t)(KiLibcStringDemoRandom() % 64U) : 0;
+    char *str = page->Base + PAGE_4KB - 1U - length - slack;
+
+    for (size_t index = 0; index < length; ++index)
+    {
+        str[index] = index < prefixLength ? prefix[index]
+                                          : (char)(1U + (uint32_t)(KiLibcStringDemoRandom() % alphabet));
+    }
+    str[length] = '\0';
+    return str;
+}
+
+static void
+KiLibcStringDemoFuzz(void)
+{
+    for (uint32_t round = 0; round < LIBC_STRING_DEMO_FUZZ_ROUNDS; ++round)
+    {
+        // A three-letter alphabet makes long common prefixes and equal strings common.
+        uint32_t alphabet = (round & 1U) != 0 ? 3U : 255U;
+        size_t maxLength = (round % 8U) == 0 ? LIBC_STRING_DEMO_MAX_LENGTH : 40U;
+        size_t lengthA = (size_t)(KiLibcStringDemoRandom() % maxLength);
+        size_t lengthB = (KiLibcStringDemoRandom() % 3U) == 0 ? lengthA : (size_t)(KiLibcStringDemoRandom() % 40U);
+
+        char *a = KiLibcStringDemoPlace(&gLibcStringDemoPages[0], lengthA, NULL, 0, alphabet);
+        size_t common = (size_t)(KiLibcStringDemoRandom() % (lengthB + 1U));
+        char *b = KiLibcStringDemoPlace(&gLibcStringDemoPages[1], lengthB, a, common < lengthA ? common : lengthA,
+                                        alphabet);
+
+        if (strlen(a) != lengthA || strlen(b) != lengthB)
+            HO_KPANIC(EC_INVALID_STATE, "libc_string: strlen disagrees with the reference");
+        if (strcmp(a, b) != KiLibcStringDemoByteStrcmp(a, b))
+            HO_KPANIC(EC_INVALID_STATE, "libc_string: strcmp disagrees with the reference");
+
+        size_t shorter = lengthA < lengthB ? lengthA : lengthB;
+        size_t count = (size_t)(KiLibcStringDemoRandom() % (shorter + 1U));
+        if (memcmp(a, b, count) != KiLibcStringDemoByteMemcmp(a, b, count))
+            HO_KPANIC(EC_INVALID_STATE, "libc_string: memcmp disagrees with the reference");
+        if (KiLibcStringDemoSign(memcmp(a, b, count)) != -KiLibcStringDemoSign(memcmp(b, a, count)))
+            HO_KPANIC(EC_INVALID_STATE, "libc_string: memcmp is not antisymmetric");
+    }
+}
+
+static uint64_t
+KiLibcStringDemoFormat(char *buffer, uint64_t capacity, const char *fmt, ...)
+{
+    VA_LIST args;
+    VA_START(args, fmt);
+    uint64_t length = ConsoleFormatVFmt(buffer, capacity, fmt, args);
+    VA_END(args);
+    return length;
+}
+
+// Digit-at-a-time conversion padded to width, as the printf engine did it before. The sign always leads the
+// padding, for spaces as well as zeros.
+static uint64_t
+KiLibcStringDemoReferenceDecimal(char *out, uint64_t value, BOOL negative, uint32_t width, char padChar)
+{
+    char digits[24];
+    uint32_t count = 0;
+
+    do
+    {
+        digits[count++] = (char)('0' + value % 10U);
+        value /= 10U;
+    } while (value != 0);
+
+    uint32_t length = count + (negative ? 1U : 0U);
+    uint32_t fill = width > length ? width - length : 0;
+    uint32_t pos = 0;
+    if (negative)
+        out[pos++] = '-';
+    for (uint32_t index = 0; index < fill; ++index)
+        out[pos++] = padChar;
+    while (count != 0)
+        out[pos++] = digits[--count];
+    out[pos] = '\0';
+    return pos;
+}
+
+static void
+KiLibcStringDemoCheckFormat(void)
+{
+    char actual[64];
+    char expected[64];
+
+    for (uint32_t round = 0; round < LIBC_STRING_DEMO_FORMAT_ROUNDS; ++round)
+    {
+        // Shift so every digit count from 1 to 20 comes up.
+        uint64_t value = KiLibcStringDemoRandom() >> (KiLibcStringDemoRandom() % 64U);
+
+        (void)KiLibcStringDemoFormat(actual, sizeof(actual), "%lu", (unsigned long)value);
+        (void)KiLibcStringDemoReferenceDecimal(expected, value, FALSE, 0, ' ');
+        if (strcmp(actual, expected) != 0)
+            HO_KPANIC(EC_INVALID_STATE, "libc_string: %lu output is wrong");
+
+        (void)KiLibcStringDemoFormat(actual, sizeof(actual), "%020lu", (unsigned long)value);
+        (void)KiLibcStringDemoReferenceDecimal(expected, value, FALSE, 20U, '0');
+        if (strcmp(actual, expected) != 0)
+            HO_KPANIC(EC_INVALID_STATE, "libc_string: %020lu output is wrong");
+
+        int64_t signedValue = (int64_t)value;
+        if ((round & 1U) != 0 && signedValue > 0)
+            signedValue = -signedValue;
+        (void)KiLibcStringDemoFormat(actual, sizeof(actual), "%12ld", (long)signedValue);
+        uint64_t magnitude = signedValue < 0 ? (uint64_t)-signedValue : (uint64_t)signedValue;
+        (void)KiLibcStringDemoReferenceDecimal(expected, magnitude, signedValue < 0, 12U, ' ');
+        if (strcmp(actual, expected) != 0)
+            HO_KPANIC(EC_INVALID_STATE, "libc_string: %12ld output is wrong");
+    }
+
+    // Edges the random values are unlikely to hit.
+    (void)KiLibcStringDemoFormat(actual, sizeof(actual), "%ld|%lu|%d|%-5u|%x", (long)(-9223372036854775807L - 1L),
+                                 (unsigned long)18446744073709551615UL, 0, 7U, (uint64_t)0xBEEFU);
+    if (strcmp(actual, "-9223372036854775808|18446744073709551615|0|7    |BEEF") != 0)
+        HO_KPANIC(EC_INVALID_STATE, "libc_string: integer edge cases are formatted wrongly");
+}
+
+typedef enum LIBC_STRING_DEMO_OP
+{
+    LIBC_STRING_DEMO_BYTE_STRLEN,
+    LIBC_STRING_DEMO_STRLEN,
+    LIBC_STRING_DEMO_BYTE_STRCMP,
+    LIBC_STRING_DEMO_STRCMP,
+    LIBC_STRING_DEMO_BYTE_MEMCMP,
+    LIBC_STRING_DEMO_MEMCMP,
+} LIBC_STRING_DEMO_OP;
+
+// Returns cycles per call on two equal strings of the given length.
+static uint64_t
+KiLibcStringDemoTime(LIBC_STRING_DEMO_OP op, const char *a, const char *b, size_t length)
+{
+    uint32_t iterations = (uint32_t)(LIBC_STRING_DEMO_BUDGET / (length + 1U));
+    volatile uint64_t sink = 0;
+    uint64_t start = rdtsc();
+
+    for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        switch (op)
+        {
+        case LIBC_STRING_DEMO_BYTE_STRLEN:
+            sink += KiLibcStringDemoByteStrlen(a);
+            break;
+        case LIBC_STRING_DEMO_STRLEN:
+            sink += strlen(a);
+            break;
+        case LIBC_STRING_DEMO_BYTE_STRCMP:
+            sink += (uint64_t)KiLibcStringDemoByteStrcmp(a, b);
+            break;
+        case LIBC_STRING_DEMO_STRCMP:
+            sink += (uint64_t)strcmp(a, b);
+            break;
+        case LIBC_STRING_DEMO_BYTE_MEMCMP:
+            sink += (uint64_t)KiLibcStringDemoByteMemcmp(a, b, length);
+            break;
+        case LIBC_STRING_DEMO_MEMCMP:
+            sink += (uint64_t)memcmp(a, b, length);
+            break;
+        }
+    }
+    (void)sink;
+    return (rdtsc() - start) / iterations;
+}
+
+static void
+KiLibcStringDemoBenchmark(void)
+{
+    static const size_t lengths[] = {8U, 64U, 512U, 3000U};
+
+    for (uint32_t index = 0; index < sizeof(lengths) / sizeof(lengths[0]); ++index)
+    {
+        size_t length = lengths[index];
+        // Different alignments on the two sides, as in most real comparisons.
+        char *a = gLibcStringDemoPages[0].Base + PAGE_4KB - 1U - length;
+        char *b = gLibcStringDemoPages[1].Base + PAGE_4KB - 4U - length;
+        memset(a, 'h', length);
+        memset(b, 'h', length);
+        a[length] = '\0';
+        b[length] = '\0';
+
+        uint64_t byteStrlen = KiLibcStringDemoTime(LIBC_STRING_DEMO_BYTE_STRLEN, a, b, length);
+        uint64_t wordStrlen = KiLibcStringDemoTime(LIBC_STRING_DEMO_STRLEN, a, b, length);
+        uint64_t byteStrcmp = KiLibcStringDemoTime(LIBC_STRING_DEMO_BYTE_STRCMP, a, b, length);
+        uint64_t wordStrcmp = KiLibcStringDemoTime(LIBC_STRING_DEMO_STRCMP, a, b, length);
+        uint64_t byteMemcmp = KiLibcStringDemoTime(LIBC_STRING_DEMO_BYTE_MEMCMP, a, b, length);
+        uint64_t wordMemcmp = KiLibcStringDemoTime(LIBC_STRING_DEMO_MEMCMP, a, b, length);
+
+        klog(KLOG_LEVEL_INFO, "[STRB] %lu B: strlen %lu->%lu strcmp %lu->%lu memcmp %lu->%lu cycles\n",
+             (unsigned long)length, (unsigned long)byteStrlen, (unsigned long)wordStrlen, (unsigned long)byteStrcmp,
+             (unsigned long)wordStrcmp, (unsigned long)byteMemcmp, (unsigned long)wordMemcmp);
+        if (length >= LIBC_STRING_DEMO_ASSERT_MIN &&
+            (wordStrlen >= byteStrlen || wordStrcmp >= byteStrcmp || wordMemcmp >= byteMemcmp))
+            HO_KPANIC(EC_INVALID_STATE, "libc_string: word-at-a-time routine is not faster than the bytewise one");
+    }
+
+    // A klog-shaped line through the printf engine, and the integer conversion on its own.
+    char line[128];
+    uint64_t start = rdtsc();
+    for (uint32_t index = 0; index < LIBC_STRING_DEMO_FORMAT_LINES; ++index)
+    {
+        (void)KiLibcStringDemoFormat(line, sizeof(line), "[SPAWN] pid=%u image=%s entry=%lx bytes=%lu ticks=%8lu\n",
+                                     index, "user_hello", (unsigned long)0x400000UL + index,
+                                     (unsigned long)index * 4099UL, (unsigned long)index * 1000003UL);
+    }
+    uint64_t formatCycles = (rdtsc() - start) / LIBC_STRING_DEMO_FORMAT_LINES;
+
+    char digits[32];
+    start = rdtsc();
+    for (uint32_t index = 0; index < LIBC_STRING_DEMO_FORMAT_LINES; ++index)
+        (void)KiLibcStringDemoReferenceDecimal(digits, 18446744073709551557ULL - index, FALSE, 0, ' ');
+    uint64_t referenceCycles = (rdtsc() - start) / LIBC_STRING_DEMO_FORMAT_LINES;
+    start = rdtsc();
+    for (uint32_t index = 0; index < LIBC_STRING_DEMO_FORMAT_LINES; ++index)
+        (void)UInt64ToStringEx(18446744073709551557ULL - index, digits, 10, 0, 0);
+    uint64_t pairCycles = (rdtsc() - start) / LIBC_STRING_DEMO_FORMAT_LINES;
+
+    klog(KLOG_LEVEL_INFO, "[STRB] 20 digits: per-digit %lu -> digit pairs %lu cycles; klog-shaped line %lu cycles\n",
+         (unsigned long)referenceCycles, (unsigned long)pairCycles, (unsigned long)formatCycles);
+}
+
+static void
+KiLibcStringDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    KiLibcStringDemoMapPage(&gLibcStringDemoPages[0]);
+    KiLibcStringDemoMapPage(&gLibcStringDemoPages[1]);
+
+    KiLibcStringDemoFuzz();
+    klog(KLOG_LEVEL_INFO, "[STRB] strlen/strcmp/memcmp match the references on %u guarded fuzz rounds\n",
+         LIBC_STRING_DEMO_FUZZ_ROUNDS);
+    KiLibcStringDemoCheckFormat();
+    klog(KLOG_LEVEL_INFO, "[STRB] digit-pair integer formatting matches the reference on %u rounds\n",
+         LIBC_STRING_DEMO_FORMAT_ROUNDS);
+    KiLibcStringDemoBenchmark();
+
+    for (uint32_t index = 0; index < 2U; ++index)
+    {
+        HO_STATUS status = KeKvaReleaseRangeHandle(&gLibcStringDemoPages[index].Range);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "libc_string: failed to release a guarded page");
+    }
+    klog(KLOG_LEVEL_INFO, "[STRB] libc string routine regression passed\n");
+}
+
+void
+RunLibcStringDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiLibcStringDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create libc string controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start libc string controller thread");
+}
@@ -0,0 +1,283 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/lock_profile.c
+ * Description: Lock profiler profile. Registers a mutex and a semaphore, drives
+ *              contended acquisitions and a poll timeout through them, and checks
+ *              the per-object counters, a critical section site record, the
+ *              sysinfo ranking and the serial dump. Built with
+ *              HO_ENABLE_LOCK_PROFILE=1 (the makefile turns it on for this
+ *              profile); otherwise it only checks that the profiler reports
+ *              itself as compiled out.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <kernel/ke/lock_profile.h>
+#include <kernel/ke/sysinfo.h>
+#include <kernel/ke/time_source.h>
+#include <libc/string.h>
+
+#define LOCK_PROFILE_DEMO_WORKERS    3U
+#define LOCK_PROFILE_DEMO_ROUNDS     4U
+#define LOCK_PROFILE_DEMO_HOLD_NS    1000000ULL // 1 ms inside the mutex
+#define LOCK_PROFILE_DEMO_SETTLE_NS  2000000ULL // lets every worker reach the gate
+#define LOCK_PROFILE_DEMO_SITE_US    50U
+#define LOCK_PROFILE_DEMO_DUMP_COUNT 12U
+
+typedef struct LOCK_PROFILE_DEMO_CONTEXT
+{
+    KMUTEX Mutex;
+    KSEMAPHORE Gate;
+    uint32_t InsideCount;
+} LOCK_PROFILE_DEMO_CONTEXT;
+
+static LOCK_PROFILE_DEMO_CONTEXT gLockProfileDemo;
+
+static void KiLockProfileDemoControllerThread(void *arg);
+
+static void
+KiLockProfileDemoExpect(HO_STATUS actual, HO_STATUS expected, const char *what)
+{
+    if (actual != expected)
+    {
+        klog(KLOG_LEVEL_ERROR, "[LOCKPROF] %s: status=%d expected=%d\n", what, (int)actual, (int)expected);
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: unexpected status");
+    }
+}
+
+#if HO_ENABLE_LOCK_PROFILE
+
+static KE_LOCK_PROFILE_RECORD gLockProfileDemoRecords[KE_LOCK_PROFILE_OBJECT_MAX + KE_LOCK_PROFILE_SITE_MAX];
+
+static const KE_LOCK_PROFILE_RECORD *
+KiLockProfileDemoFind(uint32_t count, uint32_t kind, const char *name)
+{
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        const KE_LOCK_PROFILE_RECORD *record = &gLockProfileDemoRecords[index];
+        if (record->Kind == kind && strcmp(record->Name, name) == 0)
+            return record;
+    }
+
+    HO_KPANIC(EC_INVALID_STATE, "lock_profile: record missing");
+    return NULL;
+}
+
+static uint32_t
+KiLockProfileDemoSnapshot(void)
+{
+    KE_LOCK_PROFILE_SUMMARY summary;
+    uint32_t capacity = (uint32_t)(sizeof(gLockProfileDemoRecords) / sizeof(gLockProfileDemoRecords[0]));
+    uint32_t count = KeQueryLockProfile(gLockProfileDemoRecords, capacity, &summary);
+
+    if (!summary.Enabled || count != summary.ObjectCount + summary.SiteCount)
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: snapshot does not cover every entry");
+
+    return count;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Workers
+// ─────────────────────────────────────────────────────────────
+
+static void
+KiLockProfileDemoWorker(void *arg)
+{
+    LOCK_PROFILE_DEMO_CONTEXT *ctx = (LOCK_PROFILE_DEMO_CONTEXT *)arg;
+
+    KiLockProfileDemoExpect(KeWaitForSingleObject(&ctx->Gate, KE_WAIT_INFINITE), EC_SUCCESS, "gate wait");
+
+    for (uint32_t round = 0; round < LOCK_PROFILE_DEMO_ROUNDS; ++round)
+    {
+        KiLockProfileDemoExpect(KeWaitForSingleObject(&ctx->Mutex, KE_WAIT_INFINITE), EC_SUCCESS, "mutex acquire");
+        if (++ctx->InsideCount != 1)
+            HO_KPANIC(EC_INVALID_STATE, "lock_profile: two owners inside the mutex");
+
+        // Sleeping with the mutex held makes the other workers queue behind it.
+        KeSleep(LOCK_PROFILE_DEMO_HOLD_NS);
+
+        ctx->InsideCount--;
+        KiLockProfileDemoExpect(KeReleaseMutex(&ctx->Mutex), EC_SUCCESS, "mutex release");
+    }
+}
+
+// ─────────────────────────────────────────────────────────────
+// Checks
+// ─────────────────────────────────────────────────────────────
+
+static void
+KiLockProfileDemoCheckRegistration(LOCK_PROFILE_DEMO_CONTEXT *ctx)
+{
+    KE_LOCK_PROFILE_SUMMARY before;
+    KE_LOCK_PROFILE_SUMMARY after;
+
+    KiLockProfileDemoExpect(KeRegisterLockProfile(NULL, "demo.null"), EC_ILLEGAL_ARGUMENT, "register NULL");
+    KiLockProfileDemoExpect(KeRegisterLockProfile(&ctx->Mutex, "demo.mutex"), EC_SUCCESS, "register mutex");
+    KiLockProfileDemoExpect(KeRegisterLockProfile(&ctx->Mutex, "demo.mutex"), EC_INVALID_STATE, "register twice");
+    KiLockProfileDemoExpect(KeRegisterLockProfile(&ctx->Gate, "demo.gate"), EC_SUCCESS, "register semaphore");
+
+    // Re-initializing detaches the object; registering again reuses its entry.
+    (void)KeQueryLockProfile(NULL, 0, &before);
+    KeInitializeMutex(&ctx->Mutex);
+    KiLockProfileDemoExpect(KeRegisterLockProfile(&ctx->Mutex, "demo.mutex"), EC_SUCCESS, "register after re-init");
+    (void)KeQueryLockProfile(NULL, 0, &after);
+
+    if (after.ObjectCount != before.ObjectCount)
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: re-registration added a second entry");
+}
+
+static void
+KiLockProfileDemoCheckContention(LOCK_PROFILE_DEMO_CONTEXT *ctx)
+{
+    KTHREAD *workers[LOCK_PROFILE_DEMO_WORKERS] = {0};
+
+    KeResetLockProfile();
+
+    for (uint32_t index = 0; index < LOCK_PROFILE_DEMO_WORKERS; ++index)
+    {
+        HO_STATUS status = KeThreadCreateJoinable(&workers[index], KiLockProfileDemoWorker, ctx);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "lock_profile: failed to create worker");
+
+        status = KeThreadStart(workers[index]);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "lock_profile: failed to start worker");
+    }
+
+    KeSleep(LOCK_PROFILE_DEMO_SETTLE_NS);
+    KiLockProfileDemoExpect(KeReleaseSemaphore(&ctx->Gate, (int32_t)LOCK_PROFILE_DEMO_WORKERS), EC_SUCCESS,
+                            "gate release");
+
+    for (uint32_t index = 0; index < LOCK_PROFILE_DEMO_WORKERS; ++index)
+    {
+        HO_STATUS status = KeThreadJoin(workers[index], KE_WAIT_INFINITE);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "lock_profile: failed to join worker");
+    }
+
+    KiLockProfileDemoExpect(KeWaitForSingleObject(&ctx->Gate, 0), EC_TIMEOUT, "gate poll");
+
+    uint32_t count = KiLockProfileDemoSnapshot();
+    const KE_LOCK_PROFILE_RECORD *mutex = KiLockProfileDemoFind(count, KE_LOCK_PROFILE_KIND_OBJECT, "demo.mutex");
+    const KE_LOCK_PROFILE_RECORD *gate = KiLockProfileDemoFind(count, KE_LOCK_PROFILE_KIND_OBJECT, "demo.gate");
+
+    klog(KLOG_LEVEL_INFO, "[LOCKPROF] mutex acq=%lu cont=%lu wait=%lu hold=%lu/%lu\n",
+         (unsigned long)mutex->AcquireCount, (unsigned long)mutex->ContendedCount,
+         (unsigned long)mutex->TotalWaitCycles, (unsigned long)mutex->TotalHoldCycles,
+         (unsigned long)mutex->MaxHoldCycles);
+
+    if (mutex->ObjectType != DISPATCHER_TYPE_MUTEX ||
+        mutex->AcquireCount != (uint64_t)LOCK_PROFILE_DEMO_WORKERS * LOCK_PROFILE_DEMO_ROUNDS)
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: mutex acquisitions not counted");
+
+    if (mutex->ContendedCount == 0 || mutex->TotalWaitCycles == 0 || mutex->MaxWaitCycles == 0)
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: mutex contention not recorded");
+
+    if (mutex->TotalHoldCycles == 0 || mutex->MaxHoldCycles == 0 || mutex->MaxHoldCycles > mutex->TotalHoldCycles)
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: mutex hold time not recorded");
+
+    if (gate->AcquireCount != LOCK_PROFILE_DEMO_WORKERS || gate->ContendedCount != LOCK_PROFILE_DEMO_WORKERS ||
+        gate->TimeoutCount != 1)
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: semaphore waits not counted");
+
+    if (gate->TotalHoldCycles != 0)
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: semaphore reported a hold time");
+}
+
+static void
+KiLockProfileDemoCheckSites(void)
+{
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    KeBusyWaitUs(LOCK_PROFILE_DEMO_SITE_US);
+    KeLeaveCriticalSection(&criticalSection);
+
+    uint32_t count = KiLockProfileDemoSnapshot();
+    const KE_LOCK_PROFILE_RECORD *site = KiLockProfileDemoFind(count, KE_LOCK_PROFILE_KIND_CRITICAL_SECTION, __func__);
+
+    if (site->AcquireCount != 1 || site->Line == 0 || site->TotalHoldCycles == 0)
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: critical section site not recorded");
+}
+
+static void
+KiLockProfileDemoCheckSysinfo(void)
+{
+    static SYSINFO_LOCK_PROFILE info;
+    size_t required = 0;
+
+    KiLockProfileDemoExpect(KeQuerySystemInformation(KE_SYSINFO_LOCK_PROFILE, NULL, 0, &required), EC_SUCCESS,
+                            "sysinfo size");
+    if (required != sizeof(info))
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: sysinfo size mismatch");
+
+    KiLockProfileDemoExpect(KeQuerySystemInformation(KE_SYSINFO_LOCK_PROFILE, &info, sizeof(info), &required),
+                            EC_SUCCESS, "sysinfo query");
+
+    if (!info.Summary.Enabled || info.ReturnedCount == 0 || info.ReturnedCount > SYSINFO_LOCK_PROFILE_ENTRY_MAX)
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: sysinfo returned no entries");
+
+    for (uint32_t index = 1; index < info.ReturnedCount; ++index)
+    {
+        const KE_LOCK_PROFILE_RECORD *prev = &info.Entries[index - 1];
+        const KE_LOCK_PROFILE_RECORD *cur = &info.Entries[index];
+        if (prev->TotalWaitCycles + prev->TotalHoldCycles < cur->TotalWaitCycles + cur->TotalHoldCycles)
+            HO_KPANIC(EC_INVALID_STATE, "lock_profile: sysinfo entries are not ranked");
+    }
+}
+
+static void
+KiLockProfileDemoControllerThread(void *arg)
+{
+    LOCK_PROFILE_DEMO_CONTEXT *ctx = (LOCK_PROFILE_DEMO_CONTEXT *)arg;
+
+    KeInitializeMutex(&ctx->Mutex);
+    KiLockProfileDemoExpect(KeInitializeSemaphore(&ctx->Gate, 0, (int32_t)LOCK_PROFILE_DEMO_WORKERS), EC_SUCCESS,
+                            "semaphore init");
+
+    KiLockProfileDemoCheckRegistration(ctx);
+    KiLockProfileDemoCheckContention(ctx);
+    KiLockProfileDemoCheckSites();
+    KiLockProfileDemoCheckSysinfo();
+
+    KeDumpLockProfile(LOCK_PROFILE_DEMO_DUMP_COUNT);
+    klog(KLOG_LEVEL_INFO, "[LOCKPROF] lock_profile regression passed\n");
+}
+
+#else
+
+static void
+KiLockProfileDemoControllerThread(void *arg)
+{
+    LOCK_PROFILE_DEMO_CONTEXT *ctx = (LOCK_PROFILE_DEMO_CONTEXT *)arg;
+    SYSINFO_LOCK_PROFILE info;
+
+    KeInitializeMutex(&ctx->Mutex);
+    KiLockProfileDemoExpect(KeRegisterLockProfile(&ctx->Mutex, "demo.mutex"), EC_NOT_SUPPORTED, "register");
+    KiLockProfileDemoExpect(KeQuerySystemInformation(KE_SYSINFO_LOCK_PROFILE, &info, sizeof(info), NULL), EC_SUCCESS,
+                            "sysinfo query");
+
+    if (info.Summary.Enabled || info.ReturnedCount != 0)
+        HO_KPANIC(EC_INVALID_STATE, "lock_profile: compiled-out profiler reported data");
+
+    klog(KLOG_LEVEL_INFO, "[LOCKPROF] profiler compiled out (HO_ENABLE_LOCK_PROFILE=0)\n");
+    klog(KLOG_LEVEL_INFO, "[LOCKPROF] lock_profile regression passed\n");
+}
+
+#endif
+
+void
+RunLockProfileDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiLockProfileDemoControllerThread, &gLockProfileDemo);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create lock_profile controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start lock_profile controller thread");
+}
@@ -0,0 +1,474 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/prio_inherit.c
+ * Description: Regression suite for KMUTEX priority inheritance and priority-ordered wait lists.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+#include <kernel/ke/time_source.h>
+
+#define PI_HOLDER_WORK_CHUNKS 20U
+#define PI_HOG_WORK_CHUNKS    100U
+#define PI_WORK_CHUNK_US      1000ULL
+#define PI_TIMEOUT_WAIT_NS    20000000ULL
+#define PI_POLL_RETRIES       128U
+#define PI_POLL_SLEEP_NS      1000000ULL
+#define PI_MAX_SEQUENCE       8U
+
+typedef struct KI_PI_SEQUENCE
+{
+    char Tokens[PI_MAX_SEQUENCE + 1];
+    uint32_t Length;
+} KI_PI_SEQUENCE;
+
+typedef struct KI_PI_WORKER_CONTEXT
+{
+    KI_PI_SEQUENCE *Sequence;
+    KMUTEX *Mutex;       // Mutex acquired first (held across Gate / WorkChunks)
+    KMUTEX *InnerMutex;  // Optional mutex acquired while holding Mutex
+    KEVENT *ReadyEvent;  // Optional: signaled once Mutex is owned
+    KEVENT *Gate;        // Optional: wait here while holding Mutex
+    uint64_t TimeoutNs;  // Timeout used when acquiring Mutex
+    uint32_t WorkChunks; // Busy-work chunks while holding Mutex (or without it when Mutex is NULL)
+    char Token;
+    uint8_t PriorityBeforeRelease;
+    uint8_t PriorityAfterRelease;
+    HO_STATUS AcquireStatus;
+} KI_PI_WORKER_CONTEXT;
+
+static void KiAssertPiStatus(HO_STATUS actual, HO_STATUS expected, const char *reason);
+static void KiAssertPiPriority(uint8_t actual, uint8_t expected, const char *reason);
+static void KiPiAppendToken(KI_PI_SEQUENCE *sequence, char token);
+static void KiAssertPiSequence(const KI_PI_SEQUENCE *sequence, const char *expected, const char *scenarioName);
+static void KiPiBusyWork(uint32_t chunks);
+static uint8_t KiReadPiPriority(const KTHREAD *thread);
+static void KiWaitForPiBlocked(const KTHREAD *thread, const char *reason);
+static KTHREAD *KiStartPiWorker(KI_PI_WORKER_CONTEXT *context, uint8_t priority, const char *reason);
+static void KiJoinPiWorker(KTHREAD *thread, const char *reason);
+static void KiRunPiInversionScenario(void);
+static void KiRunPiChainScenario(void);
+static void KiRunPiTimeoutScenario(void);
+static void KiRunPiWaitOrderScenario(void);
+static void PrioInheritControllerThread(void *arg);
+static void PrioInheritWorkerThread(void *arg);
+
+void
+RunPrioInheritDemo(void)
+{
+    KTHREAD *controller = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controller, PrioInheritControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create priority inheritance controller");
+
+    status = KeThreadSetPriority(controller, KTHREAD_PRIORITY_HIGH);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to raise priority inheritance controller");
+
+    status = KeThreadStart(controller);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start priority inheritance controller");
+}
+
+static void
+KiAssertPiStatus(HO_STATUS actual, HO_STATUS expected, const char *reason)
+{
+    if (actual == expected)
+        return;
+
+    klog(KLOG_LEVEL_ERROR, "[PI] %s failed (expected=%d actual=%d)\n", reason, expected, actual);
+    HO_KPANIC(actual, "Priority inheritance regression assertion failed");
+}
+
+static void
+KiAssertPiPriority(uint8_t actual, uint8_t expected, const char *reason)
+{
+    if (actual == expected)
+        return;
+
+    klog(KLOG_LEVEL_ERROR, "[PI] %s priority mismatch (expected=%u actual=%u)\n", reason, expected, actual);
+    HO_KPANIC(EC_INVALID_STATE, "Priority inheritance regression priority mismatch");
+}
+
+static void
+KiPiAppendToken(KI_PI_SEQUENCE *sequence, char token)
+{
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (sequence->Length >= PI_MAX_SEQUENCE)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        HO_KPANIC(EC_OUT_OF_RESOURCE, "Priority inheritance sequence overflow");
+    }
+
+    sequence->Tokens[sequence->Length++] = token;
+    sequence->Tokens[sequence->Length] = '\0';
+
+    KeLeaveCriticalSection(&criticalSection);
+}
+
+static void
+KiAssertPiSequence(const KI_PI_SEQUENCE *sequence, const char *expected, const char *scenarioName)
+{
+    uint32_t index = 0;
+
+    while (expected[index] != '\0' && index < sequence->Length && sequence->Tokens[index] == expected[index])
+        index++;
+
+    if (expected[index] != '\0' || index != sequence->Length)
+    {
+        klog(KLOG_LEVEL_ERROR, "[PI] %s mismatch observed=%s expected=%s\n", scenarioName, sequence->Tokens,
+             expected);
+        HO_KPANIC(EC_INVALID_STATE, "Priority inheritance sequence mismatch");
+    }
+
+    klog(KLOG_LEVEL_INFO, "[PI] %s sequence=%s\n", scenarioName, sequence->Tokens);
+}
+
+static void
+KiPiBusyWork(uint32_t chunks)
+{
+    // Wall-clock chunks: a preempted chunk simply completes on the next dispatch.
+    for (uint32_t i = 0; i < chunks; i++)
+        KeBusyWaitUs(PI_WORK_CHUNK_US);
+}
+
+static uint8_t
+KiReadPiPriority(const KTHREAD *thread)
+{
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    uint8_t priority = thread->Priority;
+    KeLeaveCriticalSection(&criticalSection);
+    return priority;
+}
+
+static void
+KiWaitForPiBlocked(const KTHREAD *thread, const char *reason)
+{
+    for (uint32_t attempt = 0; attempt < PI_POLL_RETRIES; attempt++)
+    {
+        KE_CRITICAL_SECTION criticalSection = {0};
+        KeEnterCriticalSection(&criticalSection);
+        KTHREAD_STATE state = thread->State;
+        KeLeaveCriticalSection(&criticalSection);
+
+        if (state == KTHREAD_STATE_BLOCKED)
+            return;
+
+        KeSleep(PI_POLL_SLEEP_NS);
+    }
+
+    klog(KLOG_LEVEL_ERROR, "[PI] %s: thread %u never blocked\n", reason, thread->ThreadId);
+    HO_KPANIC(EC_TIMEOUT, "Priority inheritance worker did not block");
+}
+
+static KTHREAD *
+KiStartPiWorker(KI_PI_WORKER_CONTEXT *context, uint8_t priority, const char *reason)
+{
+    KTHREAD *thread = NULL;
+
+    HO_STATUS status = KeThreadCreateJoinable(&thread, PrioInheritWorkerThread, context);
+    KiAssertPiStatus(status, EC_SUCCESS, reason);
+
+    status = KeThreadSetPriority(thread, priority);
+    KiAssertPiStatus(status, EC_SUCCESS, reason);
+
+    status = KeThreadStart(thread);
+    KiAssertPiStatus(status, EC_SUCCESS, reason);
+    return thread;
+}
+
+static void
+KiJoinPiWorker(KTHREAD *thread, const char *reason)
+{
+    KiAssertPiStatus(KeThreadJoin(thread, KE_WAIT_INFINITE), EC_SUCCESS, reason);
+}
+
+// LOW holds the mutex, HIGH waits for it, NORMAL burns CPU. Without inheritance the
+// NORMAL hog starves the LOW holder and HIGH finishes last ("NLH").
+static void
+KiRunPiInversionScenario(void)
+{
+    KI_PI_SEQUENCE sequence = {0};
+    KMUTEX mutex;
+    KEVENT holderReady;
+    KI_PI_WORKER_CONTEXT holder = {0};
+    KI_PI_WORKER_CONTEXT waiter = {0};
+    KI_PI_WORKER_CONTEXT hog = {0};
+
+    klog(KLOG_LEVEL_INFO, "[PI] inversion start\n");
+    KeInitializeMutex(&mutex);
+    KeInitializeEvent(&holderReady, FALSE);
+
+    holder.Sequence = &sequence;
+    holder.Mutex = &mutex;
+    holder.ReadyEvent = &holderReady;
+    holder.TimeoutNs = KE_WAIT_INFINITE;
+    holder.WorkChunks = PI_HOLDER_WORK_CHUNKS;
+    holder.Token = 'L';
+
+    waiter.Sequence = &sequence;
+    waiter.Mutex = &mutex;
+    waiter.TimeoutNs = KE_WAIT_INFINITE;
+    waiter.Token = 'H';
+
+    hog.Sequence = &sequence;
+    hog.WorkChunks = PI_HOG_WORK_CHUNKS;
+    hog.Token = 'N';
+
+    KTHREAD *holderThread = KiStartPiWorker(&holder, KTHREAD_PRIORITY_LOW, "start inversion holder");
+    KiAssertPiStatus(KeWaitForSingleObject(&holderReady, KE_WAIT_INFINITE), EC_SUCCESS, "wait inversion holder");
+
+    KTHREAD *hogThread = KiStartPiWorker(&hog, KTHREAD_PRIORITY_NORMAL, "start inversion hog");
+    KTHREAD *waiterThread = KiStartPiWorker(&waiter, KTHREAD_PRIORITY_HIGH, "start inversion waiter");
+
+    KiJoinPiWorker(waiterThread, "join inversion waiter");
+    KiJoinPiWorker(hogThread, "join inversion hog");
+    KiJoinPiWorker(holderThread, "join inversion holder");
+
+    KiAssertPiStatus(waiter.AcquireStatus, EC_SUCCESS, "inversion waiter acquire");
+    KiAssertPiPriority(holder.PriorityBeforeRelease, KTHREAD_PRIORITY_HIGH, "inversion holder boosted");
+    KiAssertPiPriority(holder.PriorityAfterRelease, KTHREAD_PRIORITY_LOW, "inversion holder restored");
+    KiAssertPiSequence(&sequence, "LHN", "inversion");
+    klog(KLOG_LEVEL_INFO, "[PI] inversion passed\n");
+}
+
+// HIGH -> M2 (owned by NORMAL) -> M1 (owned by LOW): both owners must run at HIGH.
+static void
+KiRunPiChainScenario(void)
+{
+    KI_PI_SEQUENCE sequence = {0};
+    KMUTEX outerMutex;
+    KMUTEX innerMutex;
+    KEVENT lowReady;
+    KEVENT midReady;
+    KEVENT gate;
+    KI_PI_WORKER_CONTEXT low = {0};
+    KI_PI_WORKER_CONTEXT mid = {0};
+    KI_PI_WORKER_CONTEXT high = {0};
+
+    klog(KLOG_LEVEL_INFO, "[PI] chain start\n");
+    KeInitializeMutex(&outerMutex);
+    KeInitializeMutex(&innerMutex);
+    KeInitializeEvent(&lowReady, FALSE);
+    KeInitializeEvent(&midReady, FALSE);
+    KeInitializeEvent(&gate, FALSE);
+
+    low.Sequence = &sequence;
+    low.Mutex = &innerMutex;
+    low.ReadyEvent = &lowReady;
+    low.Gate = &gate;
+    low.TimeoutNs = KE_WAIT_INFINITE;
+    low.Token = 'L';
+
+    mid.Sequence = &sequence;
+    mid.Mutex = &outerMutex;
+    mid.InnerMutex = &innerMutex;
+    mid.ReadyEvent = &midReady;
+    mid.TimeoutNs = KE_WAIT_INFINITE;
+    mid.Token = 'N';
+
+    high.Sequence = &sequence;
+    high.Mutex = &outerMutex;
+    high.TimeoutNs = KE_WAIT_INFINITE;
+    high.Token = 'H';
+
+    KTHREAD *lowThread = KiStartPiWorker(&low, KTHREAD_PRIORITY_LOW, "start chain low");
+    KiAssertPiStatus(KeWaitForSingleObject(&lowReady, KE_WAIT_INFINITE), EC_SUCCESS, "wait chain low");
+    KiWaitForPiBlocked(lowThread, "chain low parked on gate");
+
+    KTHREAD *midThread = KiStartPiWorker(&mid, KTHREAD_PRIORITY_NORMAL, "start chain mid");
+    KiAssertPiStatus(KeWaitForSingleObject(&midReady, KE_WAIT_INFINITE), EC_SUCCESS, "wait chain mid");
+    KiWaitForPiBlocked(midThread, "chain mid blocked on inner mutex");
+    KiAssertPiPriority(KiReadPiPriority(lowThread), KTHREAD_PRIORITY_NORMAL, "chain low boosted by mid");
+
+    KTHREAD *highThread = KiStartPiWorker(&high, KTHREAD_PRIORITY_HIGH, "start chain high");
+    KiWaitForPiBlocked(highThread, "chain high blocked on outer mutex");
+    KiAssertPiPriority(KiReadPiPriority(midThread), KTHREAD_PRIORITY_HIGH, "chain mid boosted by high");
+    KiAssertPiPriority(KiReadPiPriority(lowThread), KTHREAD_PRIORITY_HIGH, "chain low boosted transitively");
+
+    KeSetEvent(&gate);
+
+    KiJoinPiWorker(highThread, "join chain high");
+    KiJoinPiWorker(midThread, "join chain mid");
+    KiJoinPiWorker(lowThread, "join chain low");
+
+    KiAssertPiPriority(low.PriorityAfterRelease, KTHREAD_PRIORITY_LOW, "chain low restored");
+    KiAssertPiPriority(mid.PriorityBeforeRelease, KTHREAD_PRIORITY_HIGH, "chain mid still boosted by high");
+    KiAssertPiPriority(mid.PriorityAfterRelease, KTHREAD_PRIORITY_NORMAL, "chain mid restored");
+    KiAssertPiSequence(&sequence, "LNH", "chain");
+    klog(KLOG_LEVEL_INFO, "[PI] chain passed\n");
+}
+
+// A timed-out HIGH waiter must withdraw the boost it lent to the owner.
+static void
+KiRunPiTimeoutScenario(void)
+{
+    KI_PI_SEQUENCE sequence = {0};
+    KMUTEX mutex;
+    KEVENT holderReady;
+    KEVENT gate;
+    KI_PI_WORKER_CONTEXT holder = {0};
+    KI_PI_WORKER_CONTEXT waiter = {0};
+
+    klog(KLOG_LEVEL_INFO, "[PI] timeout start\n");
+    KeInitializeMutex(&mutex);
+    KeInitializeEvent(&holderReady, FALSE);
+    KeInitializeEvent(&gate, FALSE);
+
+    holder.Sequence = &sequence;
+    holder.Mutex = &mutex;
+    holder.ReadyEvent = &holderReady;
+    holder.Gate = &gate;
+    holder.TimeoutNs = KE_WAIT_INFINITE;
+    holder.Token = 'L';
+
+    waiter.Sequence = &sequence;
+    waiter.Mutex = &mutex;
+    waiter.TimeoutNs = PI_TIMEOUT_WAIT_NS;
+    waiter.Token = 'T';
+
+    KTHREAD *holderThread = KiStartPiWorker(&holder, KTHREAD_PRIORITY_LOW, "start timeout holder");
+    KiAssertPiStatus(KeWaitForSingleObject(&holderReady, KE_WAIT_INFINITE), EC_SUCCESS, "wait timeout holder");
+    KiWaitForPiBlocked(holderThread, "timeout holder parked on gate");
+
+    KTHREAD *waiterThread = KiStartPiWorker(&waiter, KTHREAD_PRIORITY_HIGH, "start timeout waiter");
+    KiWaitForPiBlocked(waiterThread, "timeout waiter blocked on mutex");
+    KiAssertPiPriority(KiReadPiPriority(holderThread), KTHREAD_PRIORITY_HIGH, "timeout holder boosted");
+
+    KiJoinPiWorker(waiterThread, "join timeout waiter");
+    KiAssertPiStatus(waiter.AcquireStatus, EC_TIMEOUT, "timeout waiter acquire");
+    KiAssertPiPriority(KiReadPiPriority(holderThread), KTHREAD_PRIORITY_LOW, "timeout holder restored");
+
+    KeSetEvent(&gate);
+    KiJoinPiWorker(holderThread, "join timeout holder");
+
+    KiAssertPiSequence(&sequence, "TL", "timeout");
+    klog(KLOG_LEVEL_INFO, "[PI] timeout passed\n");
+}
+
+// Waiters queue by priority: a later HIGH waiter is handed the mutex before an earlier LOW one.
+static void
+KiRunPiWaitOrderScenario(void)
+{
+    KI_PI_SEQUENCE sequence = {0};
+    KMUTEX mutex;
+    KEVENT holderReady;
+    KEVENT gate;
+    KI_PI_WORKER_CONTEXT holder = {0};
+    KI_PI_WORKER_CONTEXT lowWaiter = {0};
+    KI_PI_WORKER_CONTEXT highWaiter = {0};
+
+    klog(KLOG_LEVEL_INFO, "[PI] order start\n");
+    KeInitializeMutex(&mutex);
+    KeInitializeEvent(&holderReady, FALSE);
+    KeInitializeEvent(&gate, FALSE);
+
+    holder.Sequence = &sequence;
+    holder.Mutex = &mutex;
+    holder.ReadyEvent = &holderReady;
+    holder.Gate = &gate;
+    holder.TimeoutNs = KE_WAIT_INFINITE;
+    holder.Token = 'O';
+
+    lowWaiter.Sequence = &sequence;
+    lowWaiter.Mutex = &mutex;
+    lowWaiter.TimeoutNs = KE_WAIT_INFINITE;
+    lowWaiter.Token = 'L';
+
+    highWaiter.Sequence = &sequence;
+    highWaiter.Mutex = &mutex;
+    highWaiter.TimeoutNs = KE_WAIT_INFINITE;
+    highWaiter.Token = 'H';
+
+    KTHREAD *holderThread = KiStartPiWorker(&holder, KTHREAD_PRIORITY_NORMAL, "start order holder");
+    KiAssertPiStatus(KeWaitForSingleObject(&holderReady, KE_WAIT_INFINITE), EC_SUCCESS, "wait order holder");
+    KiWaitForPiBlocked(holderThread, "order holder parked on gate");
+
+    KTHREAD *lowThread = KiStartPiWorker(&lowWaiter, KTHREAD_PRIORITY_LOW, "start order low waiter");
+    KiWaitForPiBlocked(lowThread, "order low waiter blocked");
+    KTHREAD *highThread = KiStartPiWorker(&highWaiter, KTHREAD_PRIORITY_HIGH, "start order high waiter");
+    KiWaitForPiBlocked(highThread, "order high waiter blocked");
+
+    KeSetEvent(&gate);
+
+    KiJoinPiWorker(holderThread, "join order holder");
+    KiJoinPiWorker(highThread, "join order high waiter");
+    KiJoinPiWorker(lowThread, "join order low waiter");
+
+    KiAssertPiSequence(&sequence, "OHL", "order");
+    klog(KLOG_LEVEL_INFO, "[PI] order passed\n");
+}
+
+static void
+PrioInheritControllerThread(void *arg)
+{
+    (void)arg;
+    KE_SYSINFO_SCHEDULER_DATA before = {0};
+    KE_SYSINFO_SCHEDULER_DATA after = {0};
+
+    klog(KLOG_LEVEL_INFO, "[PI] priority inheritance regression start\n");
+    KiAssertPiStatus(KeQuerySchedulerInfo(&before), EC_SUCCESS, "query scheduler info");
+
+    KiRunPiInversionScenario();
+    KiRunPiChainScenario();
+    KiRunPiTimeoutScenario();
+    KiRunPiWaitOrderScenario();
+
+    KiAssertPiStatus(KeQuerySchedulerInfo(&after), EC_SUCCESS, "query scheduler info");
+    uint64_t boosts = after.PriorityBoostCount - before.PriorityBoostCount;
+    if (boosts == 0)
+        HO_KPANIC(EC_INVALID_STATE, "Priority inheritance regression observed no boosts");
+
+    klog(KLOG_LEVEL_INFO, "[PI] boosts=%lu\n", (unsigned long)boosts);
+    klog(KLOG_LEVEL_INFO, "[PI] priority inheritance regression passed\n");
+}
+
+static void
+PrioInheritWorkerThread(void *arg)
+{
+    KI_PI_WORKER_CONTEXT *context = (KI_PI_WORKER_CONTEXT *)arg;
+    KTHREAD *self = KeGetCurrentThread();
+
+    if (context->Mutex == NULL)
+    {
+        KiPiBusyWork(context->WorkChunks);
+        KiPiAppendToken(context->Sequence, context->Token);
+        return;
+    }
+
+    context->AcquireStatus = KeWaitForSingleObject(context->Mutex, context->TimeoutNs);
+    if (context->AcquireStatus != EC_SUCCESS)
+    {
+        KiPiAppendToken(context->Sequence, context->Token);
+        return;
+    }
+
+    if (context->ReadyEvent != NULL)
+        KeSetEvent(context->ReadyEvent);
+
+    if (context->Gate != NULL)
+        KiAssertPiStatus(KeWaitForSingleObject(context->Gate, KE_WAIT_INFINITE), EC_SUCCESS, "worker gate");
+
+    if (context->InnerMutex != NULL)
+    {
+        KiAssertPiStatus(KeWaitForSingleObject(context->InnerMutex, KE_WAIT_INFINITE), EC_SUCCESS,
+                         "worker inner acquire");
+        KiAssertPiStatus(KeReleaseMutex(context->InnerMutex), EC_SUCCESS, "worker inner release");
+    }
+
+    KiPiBusyWork(context->WorkChunks);
+    KiPiAppendToken(context->Sequence, context->Token);
+
+    context->PriorityBeforeRelease = KiReadPiPriority(self);
+    KiAssertPiStatus(KeReleaseMutex(context->Mutex), EC_SUCCESS, "worker release");
+    context->PriorityAfterRelease = KiReadPiPriority(self);
+
+    klog(KLOG_LEVEL_INFO, "[PI] thread %u token=%c priority %u -> %u (base=%u)\n", self->ThreadId, context->Token,
+         context->PriorityBeforeRelease, context->PriorityAfterRelease, self->BasePriority);
+}
@@ -0,0 +1,138 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/reaper.c
+ * Description: Reaper thread profile. A short burst below the wake threshold
+ *              is left to the idle loop; a larger burst is then retired while
+ *              the controller keeps the CPU busy so idle never runs, and the
+ *              reaper must drain the backlog on its own.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <kernel/ke/time_source.h>
+
+#define REAPER_DEMO_IDLE_BURST     2U
+#define REAPER_DEMO_PRESSURE_BURST 20U
+#define REAPER_DEMO_IDLE_WAIT_NS   20000000ULL // 20 ms
+#define REAPER_DEMO_TIMEOUT_US     2000000ULL  // 2 s
+
+static void KiReaperDemoExitThread(void *arg);
+static void KiReaperDemoControllerThread(void *arg);
+
+static void
+KiReaperDemoExitThread(void *arg)
+{
+    (void)arg;
+}
+
+static void
+KiReaperDemoQuery(KE_SYSINFO_SCHEDULER_DATA *out)
+{
+    HO_STATUS status = KeQuerySchedulerInfo(out);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "reaper: failed to query scheduler info");
+}
+
+static void
+KiReaperDemoBurst(uint32_t count)
+{
+    KTHREAD *threads[REAPER_DEMO_PRESSURE_BURST] = {0};
+
+    HO_KASSERT(count <= REAPER_DEMO_PRESSURE_BURST, EC_ILLEGAL_ARGUMENT);
+
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        HO_STATUS status = KeThreadCreate(&threads[index], KiReaperDemoExitThread, NULL);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "reaper: failed to create burst thread");
+    }
+
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        HO_STATUS status = KeThreadStart(threads[index]);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "reaper: failed to start burst thread");
+    }
+}
+
+static void
+KiReaperDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    KE_SYSINFO_SCHEDULER_DATA before = {0};
+    KE_SYSINFO_SCHEDULER_DATA after = {0};
+
+    KiReaperDemoQuery(&before);
+    if (before.ReaperThreadId == 0)
+        HO_KPANIC(EC_INVALID_STATE, "reaper: reaper thread not running");
+
+    // Phase 1: below the wake threshold only the idle loop reclaims.
+    KiReaperDemoBurst(REAPER_DEMO_IDLE_BURST);
+    KeSleep(REAPER_DEMO_IDLE_WAIT_NS);
+
+    KiReaperDemoQuery(&after);
+    if (after.ReaperBacklogDepth != 0 || after.ReapedThreadCount - before.ReapedThreadCount < REAPER_DEMO_IDLE_BURST)
+        HO_KPANIC(EC_INVALID_STATE, "reaper: idle loop did not drain the short burst");
+
+    klog(KLOG_LEVEL_INFO, "[REAPER] idle drain reaped=%lu\n",
+         (unsigned long)(after.ReapedThreadCount - before.ReapedThreadCount));
+
+    // Phase 2: keep the CPU busy so idle never runs; the reaper must be woken
+    // and boosted past the pressure threshold to drain the backlog.
+    before = after;
+    KiReaperDemoBurst(REAPER_DEMO_PRESSURE_BURST);
+
+    uint64_t deadlineUs = KeGetSystemUpRealTime() + REAPER_DEMO_TIMEOUT_US;
+    for (;;)
+    {
+        KeYield();
+        KiReaperDemoQuery(&after);
+
+        if (after.ReapedThreadCount - before.ReapedThreadCount >= REAPER_DEMO_PRESSURE_BURST &&
+            after.ReaperBacklogDepth == 0)
+        {
+            break;
+        }
+
+        if (KeGetSystemUpRealTime() > deadlineUs)
+            HO_KPANIC(EC_TIMEOUT, "reaper: backlog not drained under load");
+    }
+
+    uint64_t wakes = after.ReaperWakeCount - before.ReaperWakeCount;
+    uint64_t batches = after.ReaperBatchCount - before.ReaperBatchCount;
+    uint64_t reaped = after.ReapedThreadCount - before.ReapedThreadCount;
+
+    if (wakes == 0)
+        HO_KPANIC(EC_INVALID_STATE, "reaper: reaper was never woken");
+
+    if (batches < (REAPER_DEMO_PRESSURE_BURST + KE_REAPER_BATCH_SIZE - 1U) / KE_REAPER_BATCH_SIZE || batches > reaped)
+        HO_KPANIC(EC_INVALID_STATE, "reaper: batch accounting mismatch");
+
+    if (after.MaxReaperBacklogDepth < KE_REAPER_BOOST_THRESHOLD)
+        HO_KPANIC(EC_INVALID_STATE, "reaper: backlog never reached the boost threshold");
+
+    klog(KLOG_LEVEL_INFO, "[REAPER] pressure drain reaped=%lu wakes=%lu batches=%lu max_backlog=%u\n",
+         (unsigned long)reaped, (unsigned long)wakes, (unsigned long)batches, after.MaxReaperBacklogDepth);
+    klog(KLOG_LEVEL_INFO, "[REAPER] reclaim latency avg=%luns max=%luns\n",
+         (unsigned long)(after.ReclaimLatencyTotalNs / after.ReapedThreadCount),
+         (unsigned long)after.ReclaimLatencyMaxNs);
+    klog(KLOG_LEVEL_INFO, "[REAPER] reaper regression passed\n");
+}
+
+void
+RunReaperDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiReaperDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create reaper controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start reaper controller thread");
+}
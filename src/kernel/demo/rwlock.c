@@ -0,0 +1,477 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/rwlock.c
+ * Description: Reader-writer lock and condition variable profile. Covers shared
+ *              concurrency, writer preference, upgrade (including the two-upgrader
+ *              conflict), shared/exclusive timeouts, a timed-out writer releasing
+ *              the readers queued behind it, and condition signal/broadcast/timeout
+ *              over both KMUTEX and KRWLOCK. Finishes by spawning user processes so
+ *              the Ex runtime tables see publish, lookup and unpublish traffic, once
+ *              with a table reader blocked across the reap of the exiting process.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <kernel/ex/ex_process.h>
+#include <kernel/ex/runtime_internal.h>
+#include <kernel/ke/condition.h>
+#include <kernel/ke/rwlock.h>
+#include <kernel/ke/time_source.h>
+
+#define RWLOCK_DEMO_READERS      3U
+#define RWLOCK_DEMO_HOLD_NS      5000000ULL  // 5 ms inside the lock
+#define RWLOCK_DEMO_SETTLE_NS    2000000ULL  // lets a started thread reach its wait
+#define RWLOCK_DEMO_LONG_HOLD_NS 20000000ULL // outlasts every short timeout below
+#define RWLOCK_DEMO_TIMEOUT_NS   2000000ULL
+#define RWLOCK_DEMO_SPAWNS       2U
+#define RWLOCK_DEMO_REAP_WAIT_US 2000000ULL // 2 s for the exiting process to reach the reaper
+
+typedef struct RWLOCK_DEMO_CONTEXT
+{
+    KRWLOCK Lock;
+    KMUTEX Mutex;
+    KCONDITION Condition;
+    uint32_t ActiveReaders;
+    uint32_t MaxActiveReaders;
+    char Order[4];
+    uint32_t OrderLength;
+    uint32_t Ready;
+    uint32_t Consumed;
+    HO_STATUS ObservedStatus;
+} RWLOCK_DEMO_CONTEXT;
+
+static RWLOCK_DEMO_CONTEXT gRwLockDemo;
+
+static void KiRwLockDemoControllerThread(void *arg);
+
+static void
+KiRwLockDemoExpect(HO_STATUS actual, HO_STATUS expected, const char *what)
+{
+    if (actual != expected)
+    {
+        klog(KLOG_LEVEL_ERROR, "[RWLOCK] %s: status=%d expected=%d\n", what, (int)actual, (int)expected);
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: unexpected status");
+    }
+}
+
+static KTHREAD *
+KiRwLockDemoStart(KTHREAD_ENTRY entry)
+{
+    KTHREAD *thread = NULL;
+
+    HO_STATUS status = KeThreadCreateJoinable(&thread, entry, &gRwLockDemo);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "rwlock: failed to create worker");
+
+    status = KeThreadStart(thread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "rwlock: failed to start worker");
+
+    return thread;
+}
+
+static void
+KiRwLockDemoJoin(KTHREAD *thread)
+{
+    HO_STATUS status = KeThreadJoin(thread, KE_WAIT_INFINITE);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "rwlock: failed to join worker");
+}
+
+static void
+KiRwLockDemoRecord(RWLOCK_DEMO_CONTEXT *ctx, char tag)
+{
+    if (ctx->OrderLength < sizeof(ctx->Order) - 1U)
+        ctx->Order[ctx->OrderLength++] = tag;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Workers
+// ─────────────────────────────────────────────────────────────
+
+static void
+KiRwLockDemoReader(void *arg)
+{
+    RWLOCK_DEMO_CONTEXT *ctx = (RWLOCK_DEMO_CONTEXT *)arg;
+
+    KiRwLockDemoExpect(KeAcquireRwLockShared(&ctx->Lock, KE_WAIT_INFINITE), EC_SUCCESS, "reader acquire");
+    ctx->ActiveReaders++;
+    if (ctx->ActiveReaders > ctx->MaxActiveReaders)
+        ctx->MaxActiveReaders = ctx->ActiveReaders;
+    KiRwLockDemoRecord(ctx, 'R');
+
+    KeSleep(RWLOCK_DEMO_HOLD_NS);
+
+    ctx->ActiveReaders--;
+    KiRwLockDemoExpect(KeReleaseRwLockShared(&ctx->Lock), EC_SUCCESS, "reader release");
+}
+
+static void
+KiRwLockDemoWriter(void *arg)
+{
+    RWLOCK_DEMO_CONTEXT *ctx = (RWLOCK_DEMO_CONTEXT *)arg;
+
+    KiRwLockDemoExpect(KeAcquireRwLockExclusive(&ctx->Lock, KE_WAIT_INFINITE), EC_SUCCESS, "writer acquire");
+    if (ctx->ActiveReaders != 0)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: writer admitted alongside readers");
+    KiRwLockDemoRecord(ctx, 'W');
+
+    KeSleep(RWLOCK_DEMO_HOLD_NS);
+
+    KiRwLockDemoExpect(KeReleaseRwLockExclusive(&ctx->Lock), EC_SUCCESS, "writer release");
+}
+
+static void
+KiRwLockDemoLongWriter(void *arg)
+{
+    RWLOCK_DEMO_CONTEXT *ctx = (RWLOCK_DEMO_CONTEXT *)arg;
+
+    KiRwLockDemoExpect(KeAcquireRwLockExclusive(&ctx->Lock, KE_WAIT_INFINITE), EC_SUCCESS, "long writer acquire");
+    KeSleep(RWLOCK_DEMO_LONG_HOLD_NS);
+    KiRwLockDemoExpect(KeReleaseRwLockExclusive(&ctx->Lock), EC_SUCCESS, "long writer release");
+}
+
+static void
+KiRwLockDemoTimedWriter(void *arg)
+{
+    RWLOCK_DEMO_CONTEXT *ctx = (RWLOCK_DEMO_CONTEXT *)arg;
+    ctx->ObservedStatus = KeAcquireRwLockExclusive(&ctx->Lock, RWLOCK_DEMO_TIMEOUT_NS);
+}
+
+static void
+KiRwLockDemoPeerReader(void *arg)
+{
+    RWLOCK_DEMO_CONTEXT *ctx = (RWLOCK_DEMO_CONTEXT *)arg;
+
+    KiRwLockDemoExpect(KeAcquireRwLockShared(&ctx->Lock, KE_WAIT_INFINITE), EC_SUCCESS, "peer acquire");
+    KeSleep(RWLOCK_DEMO_SETTLE_NS * 2U);
+
+    // The controller's upgrade is pending by now; a second upgrader must be refused.
+    ctx->ObservedStatus = KeUpgradeRwLock(&ctx->Lock, 0);
+    KiRwLockDemoExpect(KeReleaseRwLockShared(&ctx->Lock), EC_SUCCESS, "peer release");
+}
+
+static void
+KiRwLockDemoLongReader(void *arg)
+{
+    RWLOCK_DEMO_CONTEXT *ctx = (RWLOCK_DEMO_CONTEXT *)arg;
+
+    KiRwLockDemoExpect(KeAcquireRwLockShared(&ctx->Lock, KE_WAIT_INFINITE), EC_SUCCESS, "long reader acquire");
+    KeSleep(RWLOCK_DEMO_LONG_HOLD_NS);
+    KiRwLockDemoExpect(KeReleaseRwLockShared(&ctx->Lock), EC_SUCCESS, "long reader release");
+}
+
+static void
+KiRwLockDemoConditionWaiter(void *arg)
+{
+    RWLOCK_DEMO_CONTEXT *ctx = (RWLOCK_DEMO_CONTEXT *)arg;
+
+    KiRwLockDemoExpect(KeWaitForSingleObject(&ctx->Mutex, KE_WAIT_INFINITE), EC_SUCCESS, "waiter mutex");
+    while (!ctx->Ready)
+    {
+        KiRwLockDemoExpect(KeWaitForCondition(&ctx->Condition, &ctx->Mutex, KE_WAIT_INFINITE), EC_SUCCESS,
+                           "condition wait");
+    }
+    if (ctx->Mutex.OwnerThread != KeGetCurrentThread())
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: condition returned without the mutex");
+    ctx->Consumed++;
+    KiRwLockDemoExpect(KeReleaseMutex(&ctx->Mutex), EC_SUCCESS, "waiter release");
+}
+
+// ─────────────────────────────────────────────────────────────
+// Phases
+// ─────────────────────────────────────────────────────────────
+
+static void
+KiRwLockDemoCheckApi(RWLOCK_DEMO_CONTEXT *ctx)
+{
+    KRWLOCK *lock = &ctx->Lock;
+
+    KiRwLockDemoExpect(KeAcquireRwLockShared(lock, 0), EC_SUCCESS, "shared try 1");
+    KiRwLockDemoExpect(KeAcquireRwLockShared(lock, 0), EC_SUCCESS, "shared try 2");
+    KiRwLockDemoExpect(KeAcquireRwLockExclusive(lock, 0), EC_TIMEOUT, "exclusive try while shared");
+    KiRwLockDemoExpect(KeUpgradeRwLock(lock, 0), EC_TIMEOUT, "upgrade poll with a second holder");
+    KiRwLockDemoExpect(KeReleaseRwLockShared(lock), EC_SUCCESS, "shared release 1");
+    KiRwLockDemoExpect(KeUpgradeRwLock(lock, 0), EC_SUCCESS, "sole-holder upgrade");
+    KiRwLockDemoExpect(KeWaitForSingleObject(lock, 0), EC_INVALID_STATE, "recursive exclusive");
+    KiRwLockDemoExpect(KeDowngradeRwLock(lock), EC_SUCCESS, "downgrade");
+    KiRwLockDemoExpect(KeReleaseRwLockExclusive(lock), EC_INVALID_STATE, "exclusive release while shared");
+    KiRwLockDemoExpect(KeReleaseRwLockShared(lock), EC_SUCCESS, "shared release 2");
+    KiRwLockDemoExpect(KeReleaseRwLockShared(lock), EC_INVALID_STATE, "shared release on free lock");
+    KiRwLockDemoExpect(KeUpgradeRwLock(lock, 0), EC_INVALID_STATE, "upgrade on free lock");
+    KiRwLockDemoExpect(KeWaitForSingleObject(lock, KE_WAIT_INFINITE), EC_SUCCESS, "wait as exclusive");
+    KiRwLockDemoExpect(KeReleaseRwLockExclusive(lock), EC_SUCCESS, "exclusive release");
+
+    if (lock->Header.SignalState != 0 || lock->OwnerThread != NULL)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: lock not free after API checks");
+}
+
+static void
+KiRwLockDemoCheckReaders(RWLOCK_DEMO_CONTEXT *ctx)
+{
+    KTHREAD *readers[RWLOCK_DEMO_READERS] = {0};
+
+    ctx->MaxActiveReaders = 0;
+    for (uint32_t i = 0; i < RWLOCK_DEMO_READERS; ++i)
+        readers[i] = KiRwLockDemoStart(KiRwLockDemoReader);
+    for (uint32_t i = 0; i < RWLOCK_DEMO_READERS; ++i)
+        KiRwLockDemoJoin(readers[i]);
+
+    if (ctx->MaxActiveReaders != RWLOCK_DEMO_READERS)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: readers did not share the lock");
+
+    klog(KLOG_LEVEL_INFO, "[RWLOCK] concurrent readers max=%u\n", ctx->MaxActiveReaders);
+}
+
+static void
+KiRwLockDemoCheckWriterPreference(RWLOCK_DEMO_CONTEXT *ctx)
+{
+    KRWLOCK *lock = &ctx->Lock;
+
+    ctx->OrderLength = 0;
+    KiRwLockDemoExpect(KeAcquireRwLockShared(lock, 0), EC_SUCCESS, "preference hold");
+
+    KTHREAD *writer = KiRwLockDemoStart(KiRwLockDemoWriter);
+    KeSleep(RWLOCK_DEMO_SETTLE_NS);
+    if (lock->ExclusiveWaiterCount != 1)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: writer is not queued");
+
+    // With a writer queued, even a thread that already reads is refused a new shared grant.
+    KiRwLockDemoExpect(KeAcquireRwLockShared(lock, 0), EC_TIMEOUT, "shared try behind writer");
+
+    KTHREAD *reader = KiRwLockDemoStart(KiRwLockDemoReader);
+    KeSleep(RWLOCK_DEMO_SETTLE_NS);
+    if (ctx->OrderLength != 0)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: late reader overtook the queued writer");
+
+    KiRwLockDemoExpect(KeReleaseRwLockShared(lock), EC_SUCCESS, "preference release");
+    KiRwLockDemoJoin(writer);
+    KiRwLockDemoJoin(reader);
+
+    if (ctx->OrderLength != 2 || ctx->Order[0] != 'W' || ctx->Order[1] != 'R')
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: writer was not served first");
+
+    klog(KLOG_LEVEL_INFO, "[RWLOCK] writer preference order=%c%c\n", ctx->Order[0], ctx->Order[1]);
+}
+
+static void
+KiRwLockDemoCheckUpgrade(RWLOCK_DEMO_CONTEXT *ctx)
+{
+    KRWLOCK *lock = &ctx->Lock;
+
+    // Upgrade waits for the peer to drain and refuses the peer's own upgrade attempt.
+    ctx->ObservedStatus = EC_SUCCESS;
+    KiRwLockDemoExpect(KeAcquireRwLockShared(lock, 0), EC_SUCCESS, "upgrade hold");
+    KTHREAD *peer = KiRwLockDemoStart(KiRwLockDemoPeerReader);
+    KeSleep(RWLOCK_DEMO_SETTLE_NS);
+
+    KiRwLockDemoExpect(KeUpgradeRwLock(lock, KE_WAIT_INFINITE), EC_SUCCESS, "blocking upgrade");
+    if (lock->OwnerThread != KeGetCurrentThread() || lock->UpgradeWaiter != NULL)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: upgrade did not take ownership");
+    KiRwLockDemoExpect(ctx->ObservedStatus, EC_INVALID_STATE, "second upgrader");
+    KiRwLockDemoExpect(KeReleaseRwLockExclusive(lock), EC_SUCCESS, "upgrade release");
+    KiRwLockDemoJoin(peer);
+
+    // A timed-out upgrade leaves the caller holding the lock shared.
+    KiRwLockDemoExpect(KeAcquireRwLockShared(lock, 0), EC_SUCCESS, "timed upgrade hold");
+    KTHREAD *longReader = KiRwLockDemoStart(KiRwLockDemoLongReader);
+    KeSleep(RWLOCK_DEMO_SETTLE_NS);
+
+    KiRwLockDemoExpect(KeUpgradeRwLock(lock, RWLOCK_DEMO_TIMEOUT_NS), EC_TIMEOUT, "timed upgrade");
+    if (lock->Header.SignalState != 2 || lock->UpgradeWaiter != NULL)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: timed-out upgrade lost its shared hold");
+    KiRwLockDemoExpect(KeReleaseRwLockShared(lock), EC_SUCCESS, "timed upgrade release");
+    KiRwLockDemoJoin(longReader);
+
+    klog(KLOG_LEVEL_INFO, "[RWLOCK] upgrade and upgrade conflict ok\n");
+}
+
+static void
+KiRwLockDemoCheckTimeouts(RWLOCK_DEMO_CONTEXT *ctx)
+{
+    KRWLOCK *lock = &ctx->Lock;
+
+    KTHREAD *writer = KiRwLockDemoStart(KiRwLockDemoLongWriter);
+    KeSleep(RWLOCK_DEMO_SETTLE_NS);
+
+    KiRwLockDemoExpect(KeAcquireRwLockShared(lock, RWLOCK_DEMO_TIMEOUT_NS), EC_TIMEOUT, "shared timeout");
+    KiRwLockDemoExpect(KeAcquireRwLockExclusive(lock, RWLOCK_DEMO_TIMEOUT_NS), EC_TIMEOUT, "exclusive timeout");
+    KiRwLockDemoExpect(KeWaitForSingleObject(lock, RWLOCK_DEMO_TIMEOUT_NS), EC_TIMEOUT, "wait timeout");
+    if (lock->ExclusiveWaiterCount != 0)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: timed-out writer left its count behind");
+    KiRwLockDemoJoin(writer);
+
+    // A writer that gives up must let the readers it was holding back in.
+    ctx->OrderLength = 0;
+    ctx->ObservedStatus = EC_SUCCESS;
+    KiRwLockDemoExpect(KeAcquireRwLockShared(lock, 0), EC_SUCCESS, "timed writer hold");
+    KTHREAD *timedWriter = KiRwLockDemoStart(KiRwLockDemoTimedWriter);
+    KeSleep(RWLOCK_DEMO_SETTLE_NS / 2U);
+    KTHREAD *reader = KiRwLockDemoStart(KiRwLockDemoReader);
+
+    KiRwLockDemoJoin(timedWriter);
+    KiRwLockDemoExpect(ctx->ObservedStatus, EC_TIMEOUT, "timed writer");
+    KeSleep(RWLOCK_DEMO_SETTLE_NS);
+    if (ctx->OrderLength != 1 || ctx->Order[0] != 'R')
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: reader stayed blocked after the writer timed out");
+    KiRwLockDemoExpect(KeReleaseRwLockShared(lock), EC_SUCCESS, "timed writer release");
+    KiRwLockDemoJoin(reader);
+
+    klog(KLOG_LEVEL_INFO, "[RWLOCK] shared/exclusive timeouts ok\n");
+}
+
+static void
+KiRwLockDemoCheckCondition(RWLOCK_DEMO_CONTEXT *ctx)
+{
+    KTHREAD *waiters[RWLOCK_DEMO_READERS] = {0};
+
+    if (KeSignalCondition(&ctx->Condition) != 0)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: signal without waiters woke someone");
+    KiRwLockDemoExpect(KeWaitForCondition(&ctx->Condition, &ctx->Mutex, 0), EC_INVALID_STATE,
+                       "condition without the lock");
+
+    // Signal: one waiter, one wakeup.
+    ctx->Ready = 0;
+    ctx->Consumed = 0;
+    waiters[0] = KiRwLockDemoStart(KiRwLockDemoConditionWaiter);
+    KeSleep(RWLOCK_DEMO_SETTLE_NS);
+    KiRwLockDemoExpect(KeWaitForSingleObject(&ctx->Mutex, KE_WAIT_INFINITE), EC_SUCCESS, "signal mutex");
+    ctx->Ready = 1;
+    uint32_t signaled = KeSignalCondition(&ctx->Condition);
+    KiRwLockDemoExpect(KeReleaseMutex(&ctx->Mutex), EC_SUCCESS, "signal release");
+    KiRwLockDemoJoin(waiters[0]);
+    if (signaled != 1 || ctx->Consumed != 1)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: condition signal mismatch");
+
+    // Broadcast: every waiter wakes and reacquires the mutex in turn.
+    ctx->Ready = 0;
+    ctx->Consumed = 0;
+    for (uint32_t i = 0; i < RWLOCK_DEMO_READERS; ++i)
+        waiters[i] = KiRwLockDemoStart(KiRwLockDemoConditionWaiter);
+    KeSleep(RWLOCK_DEMO_SETTLE_NS);
+    KiRwLockDemoExpect(KeWaitForSingleObject(&ctx->Mutex, KE_WAIT_INFINITE), EC_SUCCESS, "broadcast mutex");
+    ctx->Ready = 1;
+    uint32_t broadcast = KeBroadcastCondition(&ctx->Condition);
+    KiRwLockDemoExpect(KeReleaseMutex(&ctx->Mutex), EC_SUCCESS, "broadcast release");
+    for (uint32_t i = 0; i < RWLOCK_DEMO_READERS; ++i)
+        KiRwLockDemoJoin(waiters[i]);
+    if (broadcast != RWLOCK_DEMO_READERS || ctx->Consumed != RWLOCK_DEMO_READERS)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: condition broadcast mismatch");
+
+    // Timeout over a mutex and over an exclusively held rwlock: the lock comes back either way.
+    KiRwLockDemoExpect(KeWaitForSingleObject(&ctx->Mutex, KE_WAIT_INFINITE), EC_SUCCESS, "timeout mutex");
+    KiRwLockDemoExpect(KeWaitForCondition(&ctx->Condition, &ctx->Mutex, RWLOCK_DEMO_TIMEOUT_NS), EC_TIMEOUT,
+                       "condition timeout (mutex)");
+    if (ctx->Mutex.OwnerThread != KeGetCurrentThread())
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: mutex not reacquired after timeout");
+    KiRwLockDemoExpect(KeReleaseMutex(&ctx->Mutex), EC_SUCCESS, "timeout mutex release");
+
+    KiRwLockDemoExpect(KeAcquireRwLockExclusive(&ctx->Lock, 0), EC_SUCCESS, "timeout rwlock");
+    KiRwLockDemoExpect(KeWaitForCondition(&ctx->Condition, &ctx->Lock, RWLOCK_DEMO_TIMEOUT_NS), EC_TIMEOUT,
+                       "condition timeout (rwlock)");
+    if (ctx->Lock.OwnerThread != KeGetCurrentThread())
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: rwlock not reacquired after timeout");
+    KiRwLockDemoExpect(KeReleaseRwLockExclusive(&ctx->Lock), EC_SUCCESS, "timeout rwlock release");
+
+    klog(KLOG_LEVEL_INFO, "[RWLOCK] condition signal=%u broadcast=%u timeout ok\n", signaled, broadcast);
+}
+
+static void
+KiRwLockDemoCheckRuntimeTables(void)
+{
+    uint32_t pids[RWLOCK_DEMO_SPAWNS] = {0};
+
+    for (uint32_t i = 0; i < RWLOCK_DEMO_SPAWNS; ++i)
+    {
+        HO_STATUS status =
+            ExSpawnProgram("user_hello", sizeof("user_hello") - 1U, EX_USER_SPAWN_FLAG_NONE, &pids[i]);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "rwlock: failed to spawn user_hello");
+    }
+
+    for (uint32_t i = 0; i < RWLOCK_DEMO_SPAWNS; ++i)
+    {
+        HO_STATUS status = ExWaitProcess(pids[i]);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "rwlock: failed to wait user_hello");
+    }
+
+    klog(KLOG_LEVEL_INFO, "[RWLOCK] runtime table publish/lookup/unpublish ok\n");
+}
+
+static void
+KiRwLockDemoCheckRuntimeTableReap(void)
+{
+    KE_SYSINFO_SCHEDULER_DATA before = {0};
+    KE_SYSINFO_SCHEDULER_DATA after = {0};
+    uint32_t pid = 0;
+
+    KiRwLockDemoExpect(KeQuerySchedulerInfo(&before), EC_SUCCESS, "scheduler query");
+    HO_STATUS status = ExSpawnProgram("user_hello", sizeof("user_hello") - 1U, EX_USER_SPAWN_FLAG_NONE, &pid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "rwlock: failed to spawn user_hello");
+
+    // Stand in for a table reader that loses the CPU mid-scan: hold the table shared and
+    // sleep, so user_hello exits and idle runs while the lock is held. Idle must hand the
+    // thread to the reaper, and the reaper must queue behind this hold instead of panicking.
+    KiRwLockDemoExpect(ExRuntimeTestAcquireTableShared(), EC_SUCCESS, "table reader acquire");
+
+    uint64_t deadlineUs = KeGetSystemUpRealTime() + RWLOCK_DEMO_REAP_WAIT_US;
+    while (!ExRuntimeTestIsTableWriterWaiting())
+    {
+        if (KeGetSystemUpRealTime() > deadlineUs)
+            HO_KPANIC(EC_TIMEOUT, "rwlock: reap never queued behind the table reader");
+        KeSleep(RWLOCK_DEMO_SETTLE_NS);
+    }
+
+    KiRwLockDemoExpect(KeQuerySchedulerInfo(&after), EC_SUCCESS, "scheduler query");
+    KiRwLockDemoExpect(ExRuntimeTestReleaseTableShared(), EC_SUCCESS, "table reader release");
+
+    if (after.ReaperHandOffCount == before.ReaperHandOffCount)
+        HO_KPANIC(EC_INVALID_STATE, "rwlock: idle reaped a user-runtime thread itself");
+
+    status = ExWaitProcess(pid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "rwlock: failed to wait user_hello after the held reap");
+
+    klog(KLOG_LEVEL_INFO, "[RWLOCK] reap behind a preempted table reader ok handoffs=%lu\n",
+         (unsigned long)(after.ReaperHandOffCount - before.ReaperHandOffCount));
+}
+
+static void
+KiRwLockDemoControllerThread(void *arg)
+{
+    RWLOCK_DEMO_CONTEXT *ctx = (RWLOCK_DEMO_CONTEXT *)arg;
+
+    KeInitializeRwLock(&ctx->Lock);
+    KeInitializeMutex(&ctx->Mutex);
+    KeInitializeCondition(&ctx->Condition);
+
+    KiRwLockDemoCheckApi(ctx);
+    KiRwLockDemoCheckReaders(ctx);
+    KiRwLockDemoCheckWriterPreference(ctx);
+    KiRwLockDemoCheckUpgrade(ctx);
+    KiRwLockDemoCheckTimeouts(ctx);
+    KiRwLockDemoCheckCondition(ctx);
+    KiRwLockDemoCheckRuntimeTables();
+    KiRwLockDemoCheckRuntimeTableReap();
+
+    klog(KLOG_LEVEL_INFO, "[RWLOCK] rwlock regression passed\n");
+}
+
+void
+RunRwLockDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiRwLockDemoControllerThread, &gRwLockDemo);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create rwlock controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start rwlock controller thread");
+}
@@ -0,0 +1,158 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/serial_tx.c
+ * Description: Serial transmit profile. Sends the same block of lines to COM1
+ *              once with per-byte LSR polling and once through the transmit ring
+ *              and THRE interrupt, and reports bytes per second and CPU cycles
+ *              per byte for both paths. CPU cycles count the producer loop plus
+ *              the COM1 ISR time spent after it while the ring drained.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <arch/amd64/idt.h>
+#include <drivers/serial.h>
+#include <kernel/ke/time_source.h>
+#include <kernel/log.h>
+#include <libc/string.h>
+
+#define SERIAL_TX_DEMO_VECTOR     (0x20U + COM1_IRQ_LINE)
+#define SERIAL_TX_DEMO_LINES      64U
+#define SERIAL_TX_DEMO_WAIT_NS    1000000ULL    // 1 ms between drain checks
+#define SERIAL_TX_DEMO_TIMEOUT_NS 5000000000ULL // 4 KiB at 9600 baud still fits
+
+// 62 visible bytes + CRLF + NUL: 64 bytes on the wire per line.
+static const char gSerialTxDemoLine[] = "[SERTX] 0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRS\r\n";
+
+typedef struct SERIAL_TX_DEMO_RESULT
+{
+    uint64_t Bytes;
+    uint64_t ElapsedNs;
+    uint64_t CpuCycles;
+    CONSOLE_SERIAL_TX_STATS Delta;
+} SERIAL_TX_DEMO_RESULT;
+
+static void
+KiSerialTxDemoQuery(CONSOLE_SERIAL_TX_STATS *stats, IDT_VECTOR_STATS *vectorStats)
+{
+    HO_STATUS status = ConsoleQuerySerialTxStats(stats);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "serial_tx: failed to query serial TX stats");
+    status = IdtQueryVectorStats(SERIAL_TX_DEMO_VECTOR, vectorStats);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "serial_tx: failed to query COM1 vector stats");
+}
+
+static void
+KiSerialTxDemoRun(BOOL interruptDriven, SERIAL_TX_DEMO_RESULT *result)
+{
+    HO_STATUS status = ConsoleSetSerialTxMode(interruptDriven);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "serial_tx: failed to switch serial TX mode");
+
+    // Start from an idle UART with nothing of klog's still queued.
+    KLogFlush();
+    ConsoleFlush();
+
+    CONSOLE_SERIAL_TX_STATS before = {0};
+    IDT_VECTOR_STATS vectorBefore = {0};
+    KiSerialTxDemoQuery(&before, &vectorBefore);
+
+    uint64_t lineLength = sizeof(gSerialTxDemoLine) - 1U;
+    uint64_t startNs = KeGetSystemUpTimeNs();
+    uint64_t startTsc = rdtsc();
+    for (uint32_t index = 0; index < SERIAL_TX_DEMO_LINES; ++index)
+        (void)ConsoleWriteSerial(gSerialTxDemoLine, lineLength);
+    uint64_t producerCycles = rdtsc() - startTsc;
+
+    // ISR time inside the producer loop is already part of producerCycles.
+    CONSOLE_SERIAL_TX_STATS stats = {0};
+    IDT_VECTOR_STATS vectorProduced = {0};
+    KiSerialTxDemoQuery(&stats, &vectorProduced);
+
+    IDT_VECTOR_STATS vectorAfter = vectorProduced;
+    while (stats.QueueDepth != 0)
+    {
+        if (KeGetSystemUpTimeNs() - startNs > SERIAL_TX_DEMO_TIMEOUT_NS)
+            HO_KPANIC(EC_TIMEOUT, "serial_tx: transmit ring did not drain");
+        KeSleep(SERIAL_TX_DEMO_WAIT_NS);
+        KiSerialTxDemoQuery(&stats, &vectorAfter);
+    }
+
+    result->Bytes = lineLength * SERIAL_TX_DEMO_LINES;
+    result->ElapsedNs = KeGetSystemUpTimeNs() - startNs;
+    result->CpuCycles = producerCycles + (vectorAfter.TotalHandlerCycles - vectorProduced.TotalHandlerCycles);
+    result->Delta = stats;
+    result->Delta.QueuedBytes -= before.QueuedBytes;
+    result->Delta.FifoBytes -= before.FifoBytes;
+    result->Delta.PolledBytes -= before.PolledBytes;
+    result->Delta.InterruptCount -= before.InterruptCount;
+    result->Delta.KickCount -= before.KickCount;
+    result->Delta.RingFullCount -= before.RingFullCount;
+}
+
+static void
+KiSerialTxDemoReport(const char *mode, const SERIAL_TX_DEMO_RESULT *result)
+{
+    uint64_t elapsedNs = result->ElapsedNs != 0 ? result->ElapsedNs : 1;
+    klog(KLOG_LEVEL_INFO, "[SERTX] %s: bytes=%lu elapsed=%lu ns bytes/s=%lu cycles/byte=%lu\n", mode,
+         (unsigned long)result->Bytes, (unsigned long)result->ElapsedNs,
+         (unsigned long)(result->Bytes * 1000000000ULL / elapsedNs),
+         (unsigned long)(result->CpuCycles / result->Bytes));
+    klog(KLOG_LEVEL_INFO, "[SERTX] %s: fifo=%lu polled=%lu irqs=%lu kicks=%lu ring_full=%lu max_depth=%u\n", mode,
+         (unsigned long)result->Delta.FifoBytes, (unsigned long)result->Delta.PolledBytes,
+         (unsigned long)result->Delta.InterruptCount, (unsigned long)result->Delta.KickCount,
+         (unsigned long)result->Delta.RingFullCount, result->Delta.MaxQueueDepth);
+}
+
+static void
+KiSerialTxDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    CONSOLE_SERIAL_TX_STATS boot = {0};
+    HO_STATUS status = ConsoleQuerySerialTxStats(&boot);
+    if (status == EC_NOT_SUPPORTED)
+    {
+        klog(KLOG_LEVEL_INFO, "[SERTX] no serial console in this build, skipped\n");
+        return;
+    }
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "serial_tx: failed to query serial TX stats");
+    if (!boot.InterruptDriven)
+        HO_KPANIC(EC_INVALID_STATE, "serial_tx: serial TX is not interrupt driven after boot");
+
+    SERIAL_TX_DEMO_RESULT polled = {0};
+    SERIAL_TX_DEMO_RESULT interrupt = {0};
+    KiSerialTxDemoRun(FALSE, &polled);
+    KiSerialTxDemoRun(TRUE, &interrupt);
+
+    if (polled.Delta.FifoBytes != 0 || polled.Delta.PolledBytes < polled.Bytes)
+        HO_KPANIC(EC_INVALID_STATE, "serial_tx: polled run did not poll every byte");
+    if (interrupt.Delta.InterruptCount == 0 || interrupt.Delta.FifoBytes == 0)
+        HO_KPANIC(EC_INVALID_STATE, "serial_tx: no THRE interrupt refilled the FIFO");
+    if (interrupt.Delta.QueuedBytes < interrupt.Bytes || interrupt.Delta.RingFullCount != 0)
+        HO_KPANIC(EC_INVALID_STATE, "serial_tx: interrupt run lost bytes or overran the ring");
+
+    KiSerialTxDemoReport("polled", &polled);
+    KiSerialTxDemoReport("interrupt", &interrupt);
+    klog(KLOG_LEVEL_INFO, "[SERTX] serial TX regression passed\n");
+}
+
+void
+RunSerialTxDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiSerialTxDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create serial TX controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start serial TX controller thread");
+}
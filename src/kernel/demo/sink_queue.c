@@ -0,0 +1,163 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/sink_queue.c
+ * Description: Per-sink console queue profile. Times the same burst of lines with
+ *              the framebuffer sink direct and queued, checks that the drain
+ *              threads catch up on their own, that a full DROP queue drops and a
+ *              full COALESCE queue coalesces, and that the serial sink (BLOCK)
+ *              never loses an operation. Every lane must account for each
+ *              operation it was handed.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <kernel/ke/time_source.h>
+
+#define SINK_QUEUE_DEMO_LINES      16U
+#define SINK_QUEUE_DEMO_FLOOD      96U // Enough full-screen repaints to overflow a lane
+#define SINK_QUEUE_DEMO_WAIT_NS    1000000ULL
+#define SINK_QUEUE_DEMO_TIMEOUT_NS 5000000000ULL
+#define SINK_QUEUE_DEMO_LINE       "[SINKQ] 0123456789abcdefghijklmnopqrstuvwxyz\n"
+
+static void
+KiSinkQueueDemoQuery(CONSOLE_SINK_ID sink, CONSOLE_SINK_QUEUE_STATS *stats)
+{
+    HO_STATUS status = ConsoleQuerySinkQueueStats(sink, stats);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "sink_queue: failed to query sink queue stats");
+    if (stats->Submitted != stats->Applied + stats->Dropped + stats->Coalesced + stats->Pending)
+        HO_KPANIC(EC_INVALID_STATE, "sink_queue: lane lost track of an operation");
+}
+
+static void
+KiSinkQueueDemoSetPolicy(CONSOLE_SINK_ID sink, CONSOLE_SINK_QUEUE_POLICY policy)
+{
+    HO_STATUS status = ConsoleSetSinkQueuePolicy(sink, policy);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "sink_queue: failed to set sink queue policy");
+}
+
+// Returns producer cycles per line.
+static uint64_t
+KiSinkQueueDemoWrite(uint32_t lines)
+{
+    uint64_t start = rdtsc();
+    for (uint32_t index = 0; index < lines; ++index)
+        (void)ConsoleWrite(SINK_QUEUE_DEMO_LINE);
+    return (rdtsc() - start) / lines;
+}
+
+// This thread outranks the drain threads, so they only run while it sleeps.
+static void
+KiSinkQueueDemoWaitDrained(void)
+{
+    uint64_t startNs = KeGetSystemUpTimeNs();
+    CONSOLE_SINK_QUEUE_STATS framebuffer = {0};
+    CONSOLE_SINK_QUEUE_STATS serial = {0};
+
+    for (;;)
+    {
+        KiSinkQueueDemoQuery(CONSOLE_SINK_FRAMEBUFFER, &framebuffer);
+        KiSinkQueueDemoQuery(CONSOLE_SINK_SERIAL, &serial);
+        if (framebuffer.Pending == 0 && serial.Pending == 0)
+            return;
+        if (KeGetSystemUpTimeNs() - startNs > SINK_QUEUE_DEMO_TIMEOUT_NS)
+            HO_KPANIC(EC_TIMEOUT, "sink_queue: drain threads did not catch up");
+        KeSleep(SINK_QUEUE_DEMO_WAIT_NS);
+    }
+}
+
+static void
+KiSinkQueueDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    CONSOLE_SINK_QUEUE_STATS framebuffer = {0};
+    CONSOLE_SINK_QUEUE_STATS serial = {0};
+    HO_STATUS status = ConsoleQuerySinkQueueStats(CONSOLE_SINK_FRAMEBUFFER, &framebuffer);
+    if (status == EC_NOT_SUPPORTED)
+    {
+        klog(KLOG_LEVEL_INFO, "[SINKQ] no console mux in this build, skipped\n");
+        return;
+    }
+    KiSinkQueueDemoQuery(CONSOLE_SINK_FRAMEBUFFER, &framebuffer);
+    KiSinkQueueDemoQuery(CONSOLE_SINK_SERIAL, &serial);
+    if (framebuffer.Policy != CONSOLE_SINK_QUEUE_COALESCE || serial.Policy != CONSOLE_SINK_QUEUE_BLOCK)
+        HO_KPANIC(EC_INVALID_STATE, "sink_queue: boot queue policies are not coalesce/block");
+    if (framebuffer.Capacity == 0 || serial.Capacity == 0)
+        HO_KPANIC(EC_INVALID_STATE, "sink_queue: sink queues were not started");
+    if (ConsoleSetSinkQueuePolicy(CONSOLE_SINK_COUNT, CONSOLE_SINK_QUEUE_DROP) != EC_ILLEGAL_ARGUMENT)
+        HO_KPANIC(EC_INVALID_STATE, "sink_queue: unknown sink was accepted");
+
+    // Start the screen at a known state with nothing of klog's still queued.
+    KLogFlush();
+    ConsoleClearScreen(HO_CONSOLE_DEFAULT_BACKGROUND);
+    ConsoleFlush();
+
+    KiSinkQueueDemoSetPolicy(CONSOLE_SINK_FRAMEBUFFER, CONSOLE_SINK_QUEUE_DIRECT);
+    uint64_t directCycles = KiSinkQueueDemoWrite(SINK_QUEUE_DEMO_LINES);
+    KiSinkQueueDemoSetPolicy(CONSOLE_SINK_FRAMEBUFFER, CONSOLE_SINK_QUEUE_COALESCE);
+    ConsoleFlush();
+
+    uint64_t queuedCycles = KiSinkQueueDemoWrite(SINK_QUEUE_DEMO_LINES);
+    KiSinkQueueDemoQuery(CONSOLE_SINK_FRAMEBUFFER, &framebuffer);
+    if (framebuffer.Pending == 0)
+        HO_KPANIC(EC_INVALID_STATE, "sink_queue: framebuffer lane applied operations in the writer");
+    if (queuedCycles >= directCycles)
+        HO_KPANIC(EC_INVALID_STATE, "sink_queue: queued framebuffer is not cheaper for the writer");
+    KiSinkQueueDemoWaitDrained();
+
+    // A full DROP lane drops the new operation.
+    CONSOLE_SINK_QUEUE_STATS before = {0};
+    KiSinkQueueDemoQuery(CONSOLE_SINK_FRAMEBUFFER, &before);
+    KiSinkQueueDemoSetPolicy(CONSOLE_SINK_FRAMEBUFFER, CONSOLE_SINK_QUEUE_DROP);
+    (void)KiSinkQueueDemoWrite(SINK_QUEUE_DEMO_FLOOD);
+    KiSinkQueueDemoQuery(CONSOLE_SINK_FRAMEBUFFER, &framebuffer);
+    if (framebuffer.Dropped == before.Dropped || framebuffer.Pending != framebuffer.Capacity)
+        HO_KPANIC(EC_INVALID_STATE, "sink_queue: full DROP lane did not drop");
+    uint64_t dropped = framebuffer.Dropped - before.Dropped;
+
+    // A full COALESCE lane makes room by removing repaints a later one overwrites.
+    KiSinkQueueDemoSetPolicy(CONSOLE_SINK_FRAMEBUFFER, CONSOLE_SINK_QUEUE_COALESCE);
+    KiSinkQueueDemoQuery(CONSOLE_SINK_FRAMEBUFFER, &before);
+    (void)KiSinkQueueDemoWrite(SINK_QUEUE_DEMO_FLOOD);
+    KiSinkQueueDemoQuery(CONSOLE_SINK_FRAMEBUFFER, &framebuffer);
+    if (framebuffer.Coalesced == before.Coalesced)
+        HO_KPANIC(EC_INVALID_STATE, "sink_queue: full COALESCE lane did not coalesce");
+    uint64_t coalesced = framebuffer.Coalesced - before.Coalesced;
+
+    // The dropped run left holes in the picture; a clear repaints from scratch.
+    ConsoleClearScreen(HO_CONSOLE_DEFAULT_BACKGROUND);
+    KiSinkQueueDemoWaitDrained();
+
+    KiSinkQueueDemoQuery(CONSOLE_SINK_FRAMEBUFFER, &framebuffer);
+    KiSinkQueueDemoQuery(CONSOLE_SINK_SERIAL, &serial);
+    if (serial.Dropped != 0 || serial.Coalesced != 0)
+        HO_KPANIC(EC_INVALID_STATE, "sink_queue: serial lane lost operations");
+
+    klog(KLOG_LEVEL_INFO, "[SINKQ] cycles/line: direct=%lu queued=%lu (lines=%u)\n", (unsigned long)directCycles,
+         (unsigned long)queuedCycles, SINK_QUEUE_DEMO_LINES);
+    klog(KLOG_LEVEL_INFO, "[SINKQ] framebuffer: max_pending=%u dropped=%lu coalesced=%lu capacity=%u\n",
+         framebuffer.MaxPending, (unsigned long)dropped, (unsigned long)coalesced, framebuffer.Capacity);
+    klog(KLOG_LEVEL_INFO, "[SINKQ] serial: max_pending=%u blocked=%lu applied=%lu\n", serial.MaxPending,
+         (unsigned long)serial.BlockCount, (unsigned long)serial.Applied);
+    klog(KLOG_LEVEL_INFO, "[SINKQ] per-sink queue regression passed\n");
+}
+
+void
+RunSinkQueueDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiSinkQueueDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create sink queue controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start sink queue controller thread");
+}
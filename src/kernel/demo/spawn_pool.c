@@ -0,0 +1,163 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/spawn_pool.c
+ * Description: Ex spawn worker pool profile. Several kernel spawners launch
+ *              user_hello concurrently through ExSpawnProgram() so requests
+ *              queue up behind the persistent workers, then checks that the
+ *              requests were spread over more than one worker and that the
+ *              spawn-latency counters add up.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <kernel/ex/program.h>
+
+#define SPAWN_POOL_DEMO_SPAWNERS 4U
+
+typedef struct SPAWN_POOL_DEMO_SPAWNER
+{
+    uint32_t Index;
+    uint32_t Pid;
+    HO_STATUS SpawnStatus;
+    HO_STATUS WaitStatus;
+} SPAWN_POOL_DEMO_SPAWNER;
+
+static SPAWN_POOL_DEMO_SPAWNER gSpawnPoolSpawners[SPAWN_POOL_DEMO_SPAWNERS];
+
+static void KiSpawnPoolSpawnerThread(void *arg);
+static void KiSpawnPoolControllerThread(void *arg);
+
+static void
+KiSpawnPoolSpawnerThread(void *arg)
+{
+    SPAWN_POOL_DEMO_SPAWNER *spawner = (SPAWN_POOL_DEMO_SPAWNER *)arg;
+
+    spawner->SpawnStatus =
+        ExSpawnProgram("user_hello", sizeof("user_hello") - 1U, EX_USER_SPAWN_FLAG_NONE, &spawner->Pid);
+    if (spawner->SpawnStatus != EC_SUCCESS)
+        return;
+
+    spawner->WaitStatus = ExWaitProcess(spawner->Pid);
+}
+
+static void
+KiSpawnPoolControllerThread(void *arg)
+{
+    (void)arg;
+
+    KTHREAD *spawners[SPAWN_POOL_DEMO_SPAWNERS] = {0};
+    EX_SYSINFO_SPAWN_STATS before = {0};
+    EX_SYSINFO_SPAWN_STATS after = {0};
+    uint64_t loadBefore[EX_SPAWN_WORKER_COUNT] = {0};
+    uint64_t loadAfter[EX_SPAWN_WORKER_COUNT] = {0};
+    HO_STATUS status = ExQuerySpawnStats(&before);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "spawn_pool: failed to query spawn stats");
+    status = ExQuerySpawnWorkerLoad(loadBefore, EX_SPAWN_WORKER_COUNT);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "spawn_pool: failed to query worker load");
+
+    if (before.WorkerCount != EX_SPAWN_WORKER_COUNT || before.WorkerCount == 0)
+        HO_KPANIC(EC_INVALID_STATE, "spawn_pool: unexpected worker count");
+
+    for (uint32_t index = 0; index < SPAWN_POOL_DEMO_SPAWNERS; ++index)
+    {
+        gSpawnPoolSpawners[index].Index = index;
+        gSpawnPoolSpawners[index].SpawnStatus = EC_INVALID_STATE;
+        gSpawnPoolSpawners[index].WaitStatus = EC_INVALID_STATE;
+
+        status = KeThreadCreateJoinable(&spawners[index], KiSpawnPoolSpawnerThread, &gSpawnPoolSpawners[index]);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "spawn_pool: failed to create spawner");
+    }
+
+    // Start every spawner before any of them runs so their requests overlap
+    // in the pool queue.
+    for (uint32_t index = 0; index < SPAWN_POOL_DEMO_SPAWNERS; ++index)
+    {
+        status = KeThreadStart(spawners[index]);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "spawn_pool: failed to start spawner");
+    }
+
+    for (uint32_t index = 0; index < SPAWN_POOL_DEMO_SPAWNERS; ++index)
+    {
+        status = KeThreadJoin(spawners[index], KE_WAIT_INFINITE);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "spawn_pool: failed to join spawner");
+
+        if (gSpawnPoolSpawners[index].SpawnStatus != EC_SUCCESS)
+            HO_KPANIC(gSpawnPoolSpawners[index].SpawnStatus, "spawn_pool: spawn failed");
+
+        if (gSpawnPoolSpawners[index].WaitStatus != EC_SUCCESS)
+            HO_KPANIC(gSpawnPoolSpawners[index].WaitStatus, "spawn_pool: wait failed");
+    }
+
+    klog(KLOG_LEVEL_INFO, "[SPAWNPOOL] spawned=%u workers=%u\n", SPAWN_POOL_DEMO_SPAWNERS, before.WorkerCount);
+
+    // Each semaphore count a waiting worker receives stands for one request it
+    // will take, so overlapping spawns must land on different workers.
+    status = ExQuerySpawnWorkerLoad(loadAfter, EX_SPAWN_WORKER_COUNT);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "spawn_pool: failed to query worker load");
+
+    uint32_t servingWorkers = 0;
+    for (uint32_t index = 0; index < EX_SPAWN_WORKER_COUNT; ++index)
+    {
+        uint64_t served = loadAfter[index] - loadBefore[index];
+        klog(KLOG_LEVEL_INFO, "[SPAWNPOOL] worker=%u served=%lu\n", index, (unsigned long)served);
+        if (served != 0)
+            servingWorkers++;
+    }
+
+    if (EX_SPAWN_WORKER_COUNT >= 2U && servingWorkers < 2U)
+        HO_KPANIC(EC_INVALID_STATE, "spawn_pool: concurrent spawns all ran on one worker");
+
+    status = ExQuerySpawnStats(&after);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "spawn_pool: failed to query spawn stats");
+
+    uint64_t completed = after.CompletedCount - before.CompletedCount;
+    uint64_t batches = after.BatchCount - before.BatchCount;
+    uint64_t firstEntries = after.FirstUserEntryCount - before.FirstUserEntryCount;
+
+    if (completed != SPAWN_POOL_DEMO_SPAWNERS || after.FailedCount != before.FailedCount)
+        HO_KPANIC(EC_INVALID_STATE, "spawn_pool: completion count mismatch");
+
+    if (batches == 0 || batches > completed || after.MaxBatchSize > after.BatchLimit)
+        HO_KPANIC(EC_INVALID_STATE, "spawn_pool: batch accounting mismatch");
+
+    if (firstEntries != SPAWN_POOL_DEMO_SPAWNERS)
+        HO_KPANIC(EC_INVALID_STATE, "spawn_pool: first user entry count mismatch");
+
+    if (after.PendingDepth != 0 || after.MaxPendingDepth == 0)
+        HO_KPANIC(EC_INVALID_STATE, "spawn_pool: queue depth mismatch");
+
+    klog(KLOG_LEVEL_INFO, "[SPAWNPOOL] batches=%lu max_batch=%u max_pending=%u\n", (unsigned long)batches,
+         after.MaxBatchSize, after.MaxPendingDepth);
+    klog(KLOG_LEVEL_INFO, "[SPAWNPOOL] queue_wait avg=%luns max=%luns\n",
+         (unsigned long)(after.QueueWaitTotalNs / after.CompletedCount), (unsigned long)after.QueueWaitMaxNs);
+    klog(KLOG_LEVEL_INFO, "[SPAWNPOOL] staging avg=%luns max=%luns\n",
+         (unsigned long)(after.StagingTotalNs / after.CompletedCount), (unsigned long)after.StagingMaxNs);
+    klog(KLOG_LEVEL_INFO, "[SPAWNPOOL] first_user avg=%luns max=%luns\n",
+         (unsigned long)(after.FirstUserEntryTotalNs / after.FirstUserEntryCount),
+         (unsigned long)after.FirstUserEntryMaxNs);
+    klog(KLOG_LEVEL_INFO, "[SPAWNPOOL] spawn pool regression passed\n");
+}
+
+void
+RunSpawnPoolDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiSpawnPoolControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create spawn_pool controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start spawn_pool controller thread");
+}
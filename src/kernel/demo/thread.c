@@ -246,11 +246,13 @@ KiRunPriorityOrderingScenario(void)
 
     HO_STATUS status = KeThreadCreateJoinable(&lowThread, KiPrioritySmokeWorkerThread, &lowContext);
     KiAssertThreadDemoStatus(status, EC_SUCCESS, "create low-priority smoke worker");
-    lowThread->Priority = KTHREAD_PRIORITY_LOW;
+    status = KeThreadSetPriority(lowThread, KTHREAD_PRIORITY_LOW);
+    KiAssertThreadDemoStatus(status, EC_SUCCESS, "set low-priority smoke worker priority");
 
     status = KeThreadCreateJoinable(&highThread, KiPrioritySmokeWorkerThread, &highContext);
     KiAssertThreadDemoStatus(status, EC_SUCCESS, "create high-priority smoke worker");
-    highThread->Priority = KTHREAD_PRIORITY_HIGH;
+    status = KeThreadSetPriority(highThread, KTHREAD_PRIORITY_HIGH);
+    KiAssertThreadDemoStatus(status, EC_SUCCESS, "set high-priority smoke worker priority");
 
     KiStartPrioritySmokeThreadPair(lowThread, highThread);
 
@@ -289,11 +291,13 @@ KiRunPriorityRoundRobinScenario(void)
 
     HO_STATUS status = KeThreadCreateJoinable(&workerA, KiPrioritySmokeWorkerThread, &workerAContext);
     KiAssertThreadDemoStatus(status, EC_SUCCESS, "create rr worker A");
-    workerA->Priority = KTHREAD_PRIORITY_HIGH;
+    status = KeThreadSetPriority(workerA, KTHREAD_PRIORITY_HIGH);
+    KiAssertThreadDemoStatus(status, EC_SUCCESS, "set rr worker A priority");
 
     status = KeThreadCreateJoinable(&workerB, KiPrioritySmokeWorkerThread, &workerBContext);
     KiAssertThreadDemoStatus(status, EC_SUCCESS, "create rr worker B");
-    workerB->Priority = KTHREAD_PRIORITY_HIGH;
+    status = KeThreadSetPriority(workerB, KTHREAD_PRIORITY_HIGH);
+    KiAssertThreadDemoStatus(status, EC_SUCCESS, "set rr worker B priority");
 
     KiStartPrioritySmokeThreadPair(workerA, workerB);
 
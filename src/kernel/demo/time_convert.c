@@ -0,0 +1,151 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/time_convert.c
+ * Description: Time conversion profile. Reports the per-call cost of the
+ *              precomputed mult/shift conversion against the 128-bit divide it
+ *              replaced and of a full KeGetSystemUpTimeNs() read, then forces a
+ *              TSC recalibration and checks that uptime stays monotonic across it.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <arch/amd64/asm.h>
+#include <kernel/ke/sysinfo.h>
+#include <kernel/ke/time_convert.h>
+#include <kernel/ke/time_source.h>
+
+#define TIME_CONVERT_DEMO_ROUNDS    4096U
+#define TIME_CONVERT_DEMO_FREQ_HZ   2999999999ULL // Deliberately not a power-of-ten multiple
+#define TIME_CONVERT_DEMO_NS_PER_S  1000000000ULL
+#define TIME_CONVERT_DEMO_READS     256U
+#define TIME_CONVERT_DEMO_SPAN_TICK (TIME_CONVERT_DEMO_FREQ_HZ * 3600ULL)
+
+static volatile uint64_t gTimeConvertDemoSink;
+
+static uint64_t
+KiTimeConvertDemoCostDivide(void)
+{
+    uint64_t sum = 0;
+    uint64_t start = rdtsc();
+    for (uint32_t index = 0; index < TIME_CONVERT_DEMO_ROUNDS; ++index)
+        sum += KeTimeMulDiv(TIME_CONVERT_DEMO_SPAN_TICK - index, TIME_CONVERT_DEMO_NS_PER_S, TIME_CONVERT_DEMO_FREQ_HZ);
+    uint64_t cycles = rdtsc() - start;
+
+    gTimeConvertDemoSink = sum;
+    return cycles / TIME_CONVERT_DEMO_ROUNDS;
+}
+
+static uint64_t
+KiTimeConvertDemoCostConvert(const KE_TIME_CONVERSION *conversion)
+{
+    uint64_t sum = 0;
+    uint64_t start = rdtsc();
+    for (uint32_t index = 0; index < TIME_CONVERT_DEMO_ROUNDS; ++index)
+        sum += KeTimeConvert(conversion, TIME_CONVERT_DEMO_SPAN_TICK - index);
+    uint64_t cycles = rdtsc() - start;
+
+    gTimeConvertDemoSink = sum;
+    return cycles / TIME_CONVERT_DEMO_ROUNDS;
+}
+
+static uint64_t
+KiTimeConvertDemoCostUptime(void)
+{
+    uint64_t sum = 0;
+    uint64_t start = rdtsc();
+    for (uint32_t index = 0; index < TIME_CONVERT_DEMO_ROUNDS; ++index)
+        sum += KeGetSystemUpTimeNs();
+    uint64_t cycles = rdtsc() - start;
+
+    gTimeConvertDemoSink = sum;
+    return cycles / TIME_CONVERT_DEMO_ROUNDS;
+}
+
+static void
+KiTimeConvertDemoCheckMonotonic(uint64_t *previous)
+{
+    for (uint32_t index = 0; index < TIME_CONVERT_DEMO_READS; ++index)
+    {
+        uint64_t now = KeGetSystemUpTimeNs();
+        if (now < *previous)
+            HO_KPANIC(EC_INVALID_STATE, "time_convert: uptime went backwards");
+        *previous = now;
+    }
+}
+
+static void
+KiTimeConvertDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    KE_TIME_CONVERSION conversion = {0};
+    HO_STATUS status = KeTimeConversionInit(&conversion, TIME_CONVERT_DEMO_FREQ_HZ, TIME_CONVERT_DEMO_NS_PER_S);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "time_convert: failed to build the sample conversion");
+
+    status = KeTimeConversionCheck(&conversion, TIME_CONVERT_DEMO_FREQ_HZ, TIME_CONVERT_DEMO_NS_PER_S,
+                                   TIME_CONVERT_DEMO_SPAN_TICK);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "time_convert: sample conversion disagrees with the divide path");
+
+    uint64_t divideCycles = KiTimeConvertDemoCostDivide();
+    uint64_t convertCycles = KiTimeConvertDemoCostConvert(&conversion);
+    uint64_t uptimeCycles = KiTimeConvertDemoCostUptime();
+    klog(KLOG_LEVEL_INFO, "[TIMECONV] cycles/call: muldiv=%lu mult_shift=%lu uptime_ns=%lu (rounds=%u)\n",
+         (unsigned long)divideCycles, (unsigned long)convertCycles, (unsigned long)uptimeCycles,
+         TIME_CONVERT_DEMO_ROUNDS);
+
+    uint64_t acceptedBefore = 0;
+    uint64_t rejectedBefore = 0;
+    KeQueryTimeSourceRecalibration(&acceptedBefore, &rejectedBefore);
+
+    uint64_t previous = KeGetSystemUpTimeNs();
+    KiTimeConvertDemoCheckMonotonic(&previous);
+
+    HO_STATUS recalibrateStatus = KeTimeSourceRecalibrate();
+    if (recalibrateStatus != EC_SUCCESS && recalibrateStatus != EC_NOT_SUPPORTED && recalibrateStatus != EC_FAILURE)
+        HO_KPANIC(recalibrateStatus, "time_convert: recalibration failed unexpectedly");
+
+    KiTimeConvertDemoCheckMonotonic(&previous);
+
+    uint64_t acceptedAfter = 0;
+    uint64_t rejectedAfter = 0;
+    KeQueryTimeSourceRecalibration(&acceptedAfter, &rejectedAfter);
+    if (recalibrateStatus == EC_SUCCESS && acceptedAfter != acceptedBefore + 1)
+        HO_KPANIC(EC_INVALID_STATE, "time_convert: accepted recalibration was not counted");
+    if (recalibrateStatus == EC_FAILURE && rejectedAfter != rejectedBefore + 1)
+        HO_KPANIC(EC_INVALID_STATE, "time_convert: rejected recalibration was not counted");
+
+    SYSINFO_TIME_SOURCE timeSource = {0};
+    status = KeQuerySystemInformation(KE_SYSINFO_TIME_SOURCE, &timeSource, sizeof(timeSource), NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "time_convert: failed to query time source");
+    if (timeSource.RecalibrationCount != acceptedAfter || timeSource.RejectedRecalibrationCount != rejectedAfter)
+        HO_KPANIC(EC_INVALID_STATE, "time_convert: sysinfo recalibration counters disagree");
+
+    status = KeTimeSourceSelfTest();
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "time_convert: self-test failed after recalibration");
+
+    klog(KLOG_LEVEL_INFO, "[TIMECONV] source=%s freq=%lu Hz recalibrate=%s accepted=%lu rejected=%lu\n",
+         timeSource.Name, (unsigned long)timeSource.Frequency, KrGetStatusMessage(recalibrateStatus),
+         (unsigned long)acceptedAfter, (unsigned long)rejectedAfter);
+    klog(KLOG_LEVEL_INFO, "[TIMECONV] time conversion regression passed\n");
+}
+
+void
+RunTimeConvertDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiTimeConvertDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create time conversion controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start time conversion controller thread");
+}
@@ -0,0 +1,64 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/time_page.c
+ * Description: User time page profile. Checks that the shared page exists and
+ *              that KE_SYSINFO_TIME_SOURCE advertises the fast path exactly when
+ *              the active source is a TSC, then runs the time_probe payload.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <kernel/ex/ex_process.h>
+#include <kernel/ke/sysinfo.h>
+#include <kernel/ke/time_source.h>
+
+static void
+KiTimePageDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    SYSINFO_TIME_SOURCE timeSource = {0};
+    uint32_t pid = 0;
+
+    if (KeGetUserTimePagePhys() == 0)
+        HO_KPANIC(EC_INVALID_STATE, "time_page: user time page was not created");
+
+    HO_STATUS status = KeQuerySystemInformation(KE_SYSINFO_TIME_SOURCE, &timeSource, sizeof(timeSource), NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "time_page: failed to query time source");
+
+    BOOL fastPath = (timeSource.Features & SYSINFO_TIME_SOURCE_FEATURE_USER_TIME_PAGE) != 0;
+    if (fastPath != KeIsUserTimePageFastPath())
+        HO_KPANIC(EC_INVALID_STATE, "time_page: sysinfo feature disagrees with the time page");
+    if (fastPath && KeGetTimeSourceKind() != TIME_SOURCE_TSC)
+        HO_KPANIC(EC_INVALID_STATE, "time_page: fast path advertised for a non-TSC source");
+
+    klog(KLOG_LEVEL_INFO, "[TIMEPAGE] source=%s fast_path=%u\n", timeSource.Name, fastPath ? 1U : 0U);
+
+    status = ExSpawnProgram("time_probe", sizeof("time_probe") - 1U, EX_USER_SPAWN_FLAG_NONE, &pid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "time_page: failed to spawn time_probe");
+
+    status = ExWaitProcess(pid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "time_page: failed to wait time_probe");
+
+    klog(KLOG_LEVEL_INFO, "[TIMEPAGE] time page regression passed\n");
+}
+
+void
+RunTimePageDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiTimePageDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create time page controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start time page controller thread");
+}
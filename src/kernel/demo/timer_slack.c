@@ -0,0 +1,205 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/timer_slack.c
+ * Description: Timer slack profile. Sleepers aimed at nearby deadlines run once
+ *              with exact expiry and once with slack wide enough to cover the
+ *              spread; the slack pass must retire each batch on a shared
+ *              interrupt without waking anyone early. The timer_slack_probe
+ *              payload covers the user syscall surface.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <kernel/ex/ex_process.h>
+#include <kernel/ke/sysinfo.h>
+#include <kernel/ke/time_source.h>
+
+#define TIMER_SLACK_DEMO_THREADS    8U
+#define TIMER_SLACK_DEMO_ROUNDS     10U
+#define TIMER_SLACK_DEMO_LEAD_NS    10000000ULL // 10 ms before the first round
+#define TIMER_SLACK_DEMO_PERIOD_NS  20000000ULL // 20 ms between rounds
+#define TIMER_SLACK_DEMO_STAGGER_NS 250000ULL   // 250 us between sleepers
+#define TIMER_SLACK_DEMO_SLACK_NS   4000000ULL  // covers the 1.75 ms spread
+
+typedef struct TIMER_SLACK_DEMO_SLEEPER
+{
+    uint64_t BaseNs;
+    uint32_t Index;
+    uint32_t EarlyCount;
+    uint64_t MaxLatenessNs;
+} TIMER_SLACK_DEMO_SLEEPER;
+
+typedef struct TIMER_SLACK_DEMO_RESULT
+{
+    uint64_t InterruptCount;
+    uint64_t ExpiryCount;
+    uint64_t SavedCount;
+    uint32_t EarlyCount;
+    uint64_t MaxLatenessNs;
+} TIMER_SLACK_DEMO_RESULT;
+
+static void KiTimerSlackDemoControllerThread(void *arg);
+
+static void
+KiTimerSlackDemoQuery(SYSINFO_CLOCK_EVENT *out)
+{
+    HO_STATUS status = KeQuerySystemInformation(KE_SYSINFO_CLOCK_EVENT, out, sizeof(*out), NULL);
+    if (status != EC_SUCCESS || !out->Ready)
+        HO_KPANIC(status != EC_SUCCESS ? status : EC_INVALID_STATE, "timer_slack: failed to query clock event");
+}
+
+static void
+KiTimerSlackDemoSleeper(void *arg)
+{
+    TIMER_SLACK_DEMO_SLEEPER *sleeper = (TIMER_SLACK_DEMO_SLEEPER *)arg;
+
+    for (uint32_t round = 0; round < TIMER_SLACK_DEMO_ROUNDS; ++round)
+    {
+        uint64_t targetNs =
+            sleeper->BaseNs + round * TIMER_SLACK_DEMO_PERIOD_NS + sleeper->Index * TIMER_SLACK_DEMO_STAGGER_NS;
+        uint64_t nowNs = KeGetSystemUpTimeNs();
+        if (targetNs > nowNs)
+            KeSleep(targetNs - nowNs);
+
+        uint64_t wokeNs = KeGetSystemUpTimeNs();
+        if (wokeNs < targetNs)
+        {
+            sleeper->EarlyCount++;
+        }
+        else if (wokeNs - targetNs > sleeper->MaxLatenessNs)
+        {
+            sleeper->MaxLatenessNs = wokeNs - targetNs;
+        }
+    }
+}
+
+static void
+KiTimerSlackDemoRun(uint64_t slackNs, TIMER_SLACK_DEMO_RESULT *result)
+{
+    TIMER_SLACK_DEMO_SLEEPER sleepers[TIMER_SLACK_DEMO_THREADS] = {0};
+    KTHREAD *threads[TIMER_SLACK_DEMO_THREADS] = {0};
+    SYSINFO_CLOCK_EVENT before = {0};
+    SYSINFO_CLOCK_EVENT after = {0};
+
+    uint64_t baseNs = KeGetSystemUpTimeNs() + TIMER_SLACK_DEMO_LEAD_NS;
+
+    for (uint32_t i = 0; i < TIMER_SLACK_DEMO_THREADS; ++i)
+    {
+        sleepers[i].BaseNs = baseNs;
+        sleepers[i].Index = i;
+
+        HO_STATUS status = KeThreadCreateJoinable(&threads[i], KiTimerSlackDemoSleeper, &sleepers[i]);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "timer_slack: failed to create sleeper");
+
+        status = KeThreadSetTimerSlack(threads[i], slackNs);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "timer_slack: failed to set sleeper slack");
+    }
+
+    KiTimerSlackDemoQuery(&before);
+
+    for (uint32_t i = 0; i < TIMER_SLACK_DEMO_THREADS; ++i)
+    {
+        HO_STATUS status = KeThreadStart(threads[i]);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "timer_slack: failed to start sleeper");
+    }
+
+    for (uint32_t i = 0; i < TIMER_SLACK_DEMO_THREADS; ++i)
+    {
+        HO_STATUS status = KeThreadJoin(threads[i], KE_WAIT_INFINITE);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "timer_slack: failed to join sleeper");
+    }
+
+    KiTimerSlackDemoQuery(&after);
+
+    result->InterruptCount = after.InterruptCount - before.InterruptCount;
+    result->ExpiryCount = after.TimeoutExpiryCount - before.TimeoutExpiryCount;
+    result->SavedCount = after.SavedInterruptCount - before.SavedInterruptCount;
+
+    for (uint32_t i = 0; i < TIMER_SLACK_DEMO_THREADS; ++i)
+    {
+        result->EarlyCount += sleepers[i].EarlyCount;
+        if (sleepers[i].MaxLatenessNs > result->MaxLatenessNs)
+            result->MaxLatenessNs = sleepers[i].MaxLatenessNs;
+    }
+}
+
+static void
+KiTimerSlackDemoCheckApi(void)
+{
+    KTHREAD *self = KeGetCurrentThread();
+
+    if (KeThreadSetTimerSlack(self, KE_TIMER_SLACK_MAX_NS + 1U) != EC_ILLEGAL_ARGUMENT)
+        HO_KPANIC(EC_INVALID_STATE, "timer_slack: oversized slack was accepted");
+    if (KeThreadSetTimerSlack(NULL, 0) != EC_ILLEGAL_ARGUMENT)
+        HO_KPANIC(EC_INVALID_STATE, "timer_slack: NULL thread was accepted");
+    if (KeThreadSetTimerSlack(self, KE_TIMER_SLACK_MAX_NS) != EC_SUCCESS ||
+        KeThreadSetTimerSlack(self, KE_TIMER_SLACK_DEFAULT) != EC_SUCCESS)
+    {
+        HO_KPANIC(EC_INVALID_STATE, "timer_slack: valid slack was rejected");
+    }
+}
+
+static void
+KiTimerSlackDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    TIMER_SLACK_DEMO_RESULT exact = {0};
+    TIMER_SLACK_DEMO_RESULT slack = {0};
+    uint32_t pid = 0;
+
+    KiTimerSlackDemoCheckApi();
+
+    KiTimerSlackDemoRun(0, &exact);
+    klog(KLOG_LEVEL_INFO, "[TIMERSLACK] exact interrupts=%lu expiries=%lu saved=%lu max_late_us=%lu\n",
+         (unsigned long)exact.InterruptCount, (unsigned long)exact.ExpiryCount, (unsigned long)exact.SavedCount,
+         (unsigned long)(exact.MaxLatenessNs / 1000ULL));
+
+    KiTimerSlackDemoRun(TIMER_SLACK_DEMO_SLACK_NS, &slack);
+    klog(KLOG_LEVEL_INFO, "[TIMERSLACK] slack interrupts=%lu expiries=%lu saved=%lu max_late_us=%lu\n",
+         (unsigned long)slack.InterruptCount, (unsigned long)slack.ExpiryCount, (unsigned long)slack.SavedCount,
+         (unsigned long)(slack.MaxLatenessNs / 1000ULL));
+
+    if (exact.EarlyCount != 0 || slack.EarlyCount != 0)
+        HO_KPANIC(EC_INVALID_STATE, "timer_slack: a sleeper woke before its deadline");
+
+    // Every round's spread fits inside one slack window, so each round must
+    // retire at least two deadlines on a shared interrupt.
+    if (slack.SavedCount < TIMER_SLACK_DEMO_ROUNDS)
+        HO_KPANIC(EC_INVALID_STATE, "timer_slack: slack did not coalesce expirations");
+    // Exact sleepers have no window to ride in; late batches must not count as saved.
+    if (slack.SavedCount <= exact.SavedCount)
+        HO_KPANIC(EC_INVALID_STATE, "timer_slack: exact expiry reported as many saved interrupts as slack");
+
+    HO_STATUS status =
+        ExSpawnProgram("timer_slack_probe", sizeof("timer_slack_probe") - 1U, EX_USER_SPAWN_FLAG_NONE, &pid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "timer_slack: failed to spawn timer_slack_probe");
+
+    status = ExWaitProcess(pid);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "timer_slack: failed to wait timer_slack_probe");
+
+    klog(KLOG_LEVEL_INFO, "[TIMERSLACK] timer slack regression passed\n");
+}
+
+void
+RunTimerSlackDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiTimerSlackDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create timer slack controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start timer slack controller thread");
+}
@@ -0,0 +1,126 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: demo/tsc_deadline.c
+ * Description: Clock-event mode profile. Runs the same train of short sleeps
+ *              with the LAPIC timer in one-shot mode and, when the CPU offers
+ *              it, in TSC-deadline mode, and reports the timer lateness
+ *              (interrupt arrival minus due TSC) KE_SYSINFO_CLOCK_EVENT
+ *              collected for each. Restores the boot mode afterwards.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "demo_internal.h"
+
+#include <kernel/ke/clock_event.h>
+#include <kernel/ke/sysinfo.h>
+#include <kernel/ke/time_convert.h>
+#include <kernel/ke/time_source.h>
+
+#define TSC_DEADLINE_DEMO_SLEEPS   64U
+#define TSC_DEADLINE_DEMO_SLEEP_NS 1000000ULL // 1 ms
+#define TSC_DEADLINE_DEMO_STEP_NS  37000ULL   // Spreads the deltas across LAPIC count values
+
+static void
+KiTscDeadlineDemoQuery(SYSINFO_CLOCK_EVENT *out)
+{
+    HO_STATUS status = KeQuerySystemInformation(KE_SYSINFO_CLOCK_EVENT, out, sizeof(*out), NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "tsc_deadline: failed to query clock event");
+    if (!out->Ready)
+        HO_KPANIC(EC_INVALID_STATE, "tsc_deadline: clock event is not ready");
+}
+
+static uint64_t
+KiTscDeadlineDemoCyclesToNs(uint64_t cycles)
+{
+    uint64_t tscFreqHz = KeGetTimeSourceFrequency();
+    return tscFreqHz != 0 ? KeTimeMulDiv(cycles, 1000000000ULL, tscFreqHz) : 0;
+}
+
+static void
+KiTscDeadlineDemoRun(KE_CLOCK_EVENT_MODE mode, uint32_t expectedSysinfoMode, const char *name)
+{
+    SYSINFO_CLOCK_EVENT before = {0};
+    SYSINFO_CLOCK_EVENT after = {0};
+
+    HO_STATUS status = KeClockEventSetMode(mode);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "tsc_deadline: failed to switch clock event mode");
+
+    KiTscDeadlineDemoQuery(&before);
+    if (before.Mode != expectedSysinfoMode)
+        HO_KPANIC(EC_INVALID_STATE, "tsc_deadline: sysinfo does not report the selected mode");
+
+    for (uint32_t index = 0; index < TSC_DEADLINE_DEMO_SLEEPS; ++index)
+        KeSleep(TSC_DEADLINE_DEMO_SLEEP_NS + (index % 8U) * TSC_DEADLINE_DEMO_STEP_NS);
+
+    KiTscDeadlineDemoQuery(&after);
+    if (after.Mode != expectedSysinfoMode)
+        HO_KPANIC(EC_INVALID_STATE, "tsc_deadline: clock event mode changed under the run");
+
+    uint64_t samples = after.LatenessSampleCount - before.LatenessSampleCount;
+    uint64_t totalCycles = after.TotalLatenessCycles - before.TotalLatenessCycles;
+    uint64_t early = after.EarlyFireCount - before.EarlyFireCount;
+
+    if (KeGetTimeSourceKind() == TIME_SOURCE_TSC && samples == 0)
+        HO_KPANIC(EC_INVALID_STATE, "tsc_deadline: no lateness samples with a TSC time source");
+
+    // MaxLatenessCycles is a boot-wide maximum; the per-run average is the comparable figure.
+    uint64_t avgNs = samples != 0 ? KiTscDeadlineDemoCyclesToNs(totalCycles / samples) : 0;
+    klog(KLOG_LEVEL_INFO, "[TSCDL] mode=%s freq=%lu Hz interrupts=%lu samples=%lu avg_late_ns=%lu early=%lu\n", name,
+         (unsigned long)after.FreqHz, (unsigned long)(after.InterruptCount - before.InterruptCount),
+         (unsigned long)samples, (unsigned long)avgNs, (unsigned long)early);
+}
+
+static void
+KiTscDeadlineDemoControllerThread(void *arg)
+{
+    (void)arg;
+
+    SYSINFO_CLOCK_EVENT info = {0};
+    KiTscDeadlineDemoQuery(&info);
+
+    KE_CLOCK_EVENT_MODE bootMode = KeClockEventGetMode();
+    BOOL supported = KeClockEventIsTscDeadlineSupported();
+    if (info.TscDeadlineSupported != supported)
+        HO_KPANIC(EC_INVALID_STATE, "tsc_deadline: sysinfo support flag disagrees with the device");
+
+    klog(KLOG_LEVEL_INFO, "[TSCDL] boot mode=%s tsc_deadline_supported=%u\n",
+         bootMode == KE_CLOCK_EVENT_MODE_TSC_DEADLINE ? "tsc-deadline" : "one-shot", supported ? 1U : 0U);
+
+    KiTscDeadlineDemoRun(KE_CLOCK_EVENT_MODE_ONE_SHOT, SYSINFO_CLOCK_EVENT_MODE_ONE_SHOT, "one-shot");
+
+    if (supported)
+    {
+        KiTscDeadlineDemoRun(KE_CLOCK_EVENT_MODE_TSC_DEADLINE, SYSINFO_CLOCK_EVENT_MODE_TSC_DEADLINE, "tsc-deadline");
+    }
+    else
+    {
+        HO_STATUS status = KeClockEventSetMode(KE_CLOCK_EVENT_MODE_TSC_DEADLINE);
+        if (status != EC_NOT_SUPPORTED)
+            HO_KPANIC(EC_INVALID_STATE, "tsc_deadline: unsupported mode switch was not refused");
+        klog(KLOG_LEVEL_INFO, "[TSCDL] tsc-deadline unavailable, one-shot only\n");
+    }
+
+    HO_STATUS status = KeClockEventSetMode(bootMode);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "tsc_deadline: failed to restore the boot clock event mode");
+
+    klog(KLOG_LEVEL_INFO, "[TSCDL] clock event mode regression passed\n");
+}
+
+void
+RunTscDeadlineDemo(void)
+{
+    KTHREAD *controllerThread = NULL;
+
+    HO_STATUS status = KeThreadCreate(&controllerThread, KiTscDeadlineDemoControllerThread, NULL);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to create TSC-deadline controller thread");
+
+    status = KeThreadStart(controllerThread);
+    if (status != EC_SUCCESS)
+        HO_KPANIC(status, "Failed to start TSC-deadline controller thread");
+}
@@ -0,0 +1,312 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ex/futex.c
+ * Description: Ex wait-on-address table backing SYS_FUTEX_WAIT/SYS_FUTEX_WAKE.
+ *              Waiters are keyed by (address space root, user VA), hashed into
+ *              a fixed bucket array, and block on a stack-resident KEVENT.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "runtime_internal.h"
+
+#include <kernel/ex/futex.h>
+#include <kernel/hodbg.h>
+#include <kernel/ke/critical_section.h>
+#include <kernel/ke/event.h>
+#include <kernel/ke/irql.h>
+#include <kernel/ke/kthread.h>
+#include <kernel/ke/scheduler.h>
+#include <kernel/ke/user_mode.h>
+#include <lib/common/linked_list.h>
+#include <libc/string.h>
+
+#define EX_FUTEX_HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
+typedef char EX_FUTEX_HASH_BUCKETS_IS_POWER_OF_TWO[((EX_FUTEX_HASH_BUCKETS & (EX_FUTEX_HASH_BUCKETS - 1U)) == 0) ? 1
+                                                                                                                 : -1];
+
+typedef struct EX_FUTEX_WAITER
+{
+    LINKED_LIST_TAG Link;
+    HO_PHYSICAL_ADDRESS RootPageTablePhys;
+    HO_VIRTUAL_ADDRESS UserAddress;
+    KEVENT WakeEvent;
+    BOOL Woken; // Unlinked by a waker; the event is set or about to be
+} EX_FUTEX_WAITER;
+
+typedef struct EX_FUTEX_BUCKET
+{
+    LINKED_LIST_TAG Waiters;
+    uint32_t Depth;
+} EX_FUTEX_BUCKET;
+
+typedef struct EX_FUTEX_TABLE
+{
+    BOOL Ready;
+    EX_FUTEX_BUCKET Buckets[EX_FUTEX_HASH_BUCKETS];
+    EX_SYSINFO_FUTEX_STATS Stats;
+} EX_FUTEX_TABLE;
+
+static EX_FUTEX_TABLE gExFutexTable;
+
+static EX_FUTEX_BUCKET *
+KiFutexBucket(HO_PHYSICAL_ADDRESS rootPageTablePhys, HO_VIRTUAL_ADDRESS userAddress)
+{
+    uint64_t key = (rootPageTablePhys >> 12) ^ (userAddress >> 2);
+    uint64_t hash = (key * EX_FUTEX_HASH_MULTIPLIER) >> 32;
+
+    return &gExFutexTable.Buckets[hash & (EX_FUTEX_HASH_BUCKETS - 1U)];
+}
+
+static HO_STATUS
+KiFutexResolveKey(HO_VIRTUAL_ADDRESS userAddress, HO_PHYSICAL_ADDRESS *outRootPageTablePhys)
+{
+    if (!gExFutexTable.Ready)
+        return EC_INVALID_STATE;
+
+    if (userAddress == 0 || (userAddress & (sizeof(uint32_t) - 1U)) != 0)
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_USER_MODE_LAYOUT layout = {0};
+    HO_STATUS status = KeUserModeQueryCurrentThreadLayout(&layout);
+    if (status != EC_SUCCESS)
+        return status;
+
+    *outRootPageTablePhys = layout.OwnerRootPageTablePhys;
+    return EC_SUCCESS;
+}
+
+static void
+KiFutexUnlinkWaiter(EX_FUTEX_WAITER *waiter)
+{
+    EX_FUTEX_BUCKET *bucket = KiFutexBucket(waiter->RootPageTablePhys, waiter->UserAddress);
+
+    LinkedListRemove(&waiter->Link);
+    bucket->Depth--;
+    gExFutexTable.Stats.ActiveWaiters--;
+}
+
+// Waiters on releaseList were marked Woken under the table lock. The caller
+// holds DISPATCH level, so none of them can observe Woken and unwind its stack
+// before its event is set here.
+static void
+KiFutexSignalReleased(LINKED_LIST_TAG *releaseList)
+{
+    while (!LinkedListIsEmpty(releaseList))
+    {
+        LINKED_LIST_TAG *entry = releaseList->Flink;
+        LinkedListRemove(entry);
+        KeSetEvent(&CONTAINING_RECORD(entry, EX_FUTEX_WAITER, Link)->WakeEvent);
+    }
+}
+
+HO_KERNEL_API HO_STATUS
+ExFutexInit(void)
+{
+    if (gExFutexTable.Ready)
+        return EC_INVALID_STATE;
+
+    memset(&gExFutexTable, 0, sizeof(gExFutexTable));
+    for (uint32_t index = 0; index < EX_FUTEX_HASH_BUCKETS; ++index)
+        LinkedListInit(&gExFutexTable.Buckets[index].Waiters);
+
+    gExFutexTable.Ready = TRUE;
+    klog(KLOG_LEVEL_INFO, "[FUTEX] table ready buckets=%u\n", EX_FUTEX_HASH_BUCKETS);
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API HO_STATUS
+ExFutexWait(HO_VIRTUAL_ADDRESS userAddress, uint32_t expected, uint64_t timeoutNs)
+{
+    HO_PHYSICAL_ADDRESS rootPageTablePhys = 0;
+    HO_STATUS status = KiFutexResolveKey(userAddress, &rootPageTablePhys);
+    if (status != EC_SUCCESS)
+        return status;
+
+    EX_FUTEX_WAITER waiter = {0};
+    waiter.RootPageTablePhys = rootPageTablePhys;
+    waiter.UserAddress = userAddress;
+    KeInitializeEvent(&waiter.WakeEvent, FALSE);
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    // A kill that already landed would never wake a waiter queued after it;
+    // return so the syscall exit path observes the request.
+    if (ExRuntimeShouldTerminateCurrentProcess(NULL))
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        return EC_SUCCESS;
+    }
+
+    // The copy validates presence through the page tables and cannot fault, so
+    // the compare and the enqueue stay atomic against ExFutexWake.
+    uint32_t current = 0;
+    status = KeUserModeCopyInBytes(&current, userAddress, sizeof(current));
+    if (status != EC_SUCCESS)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        return status;
+    }
+
+    EX_SYSINFO_FUTEX_STATS *stats = &gExFutexTable.Stats;
+    stats->WaitCount++;
+
+    if (current != expected)
+    {
+        stats->MismatchCount++;
+        KeLeaveCriticalSection(&criticalSection);
+        return EC_INVALID_STATE;
+    }
+
+    if (timeoutNs == 0)
+    {
+        stats->TimeoutCount++;
+        KeLeaveCriticalSection(&criticalSection);
+        return EC_TIMEOUT;
+    }
+
+    EX_FUTEX_BUCKET *bucket = KiFutexBucket(rootPageTablePhys, userAddress);
+    LinkedListInsertTail(&bucket->Waiters, &waiter.Link);
+    bucket->Depth++;
+    if (bucket->Depth > stats->MaxBucketDepth)
+        stats->MaxBucketDepth = bucket->Depth;
+
+    stats->BlockCount++;
+    stats->ActiveWaiters++;
+    if (stats->ActiveWaiters > stats->MaxActiveWaiters)
+        stats->MaxActiveWaiters = stats->ActiveWaiters;
+
+    KeLeaveCriticalSection(&criticalSection);
+
+    status = KeWaitForSingleObject(&waiter.WakeEvent, timeoutNs);
+
+    KeEnterCriticalSection(&criticalSection);
+    if (!waiter.Woken)
+    {
+        KiFutexUnlinkWaiter(&waiter);
+        if (status == EC_TIMEOUT)
+            stats->TimeoutCount++;
+    }
+    KeLeaveCriticalSection(&criticalSection);
+
+    // A wake that raced the timeout still counts as a wake; the waker already
+    // charged it to WokenCount.
+    return waiter.Woken ? EC_SUCCESS : status;
+}
+
+HO_KERNEL_API HO_STATUS
+ExFutexWake(HO_VIRTUAL_ADDRESS userAddress, uint32_t maxWake, uint32_t *outWoken)
+{
+    if (outWoken == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+
+    *outWoken = 0;
+
+    HO_PHYSICAL_ADDRESS rootPageTablePhys = 0;
+    HO_STATUS status = KiFutexResolveKey(userAddress, &rootPageTablePhys);
+    if (status != EC_SUCCESS)
+        return status;
+
+    LINKED_LIST_TAG releaseList;
+    LinkedListInit(&releaseList);
+    uint32_t woken = 0;
+
+    KE_IRQL_GUARD irqlGuard = {0};
+    KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    EX_FUTEX_BUCKET *bucket = KiFutexBucket(rootPageTablePhys, userAddress);
+    LINKED_LIST_TAG *entry = bucket->Waiters.Flink;
+    while (entry != &bucket->Waiters && woken < maxWake)
+    {
+        LINKED_LIST_TAG *next = entry->Flink;
+        EX_FUTEX_WAITER *waiter = CONTAINING_RECORD(entry, EX_FUTEX_WAITER, Link);
+
+        if (waiter->RootPageTablePhys == rootPageTablePhys && waiter->UserAddress == userAddress)
+        {
+            KiFutexUnlinkWaiter(waiter);
+            waiter->Woken = TRUE;
+            LinkedListInsertTail(&releaseList, &waiter->Link);
+            woken++;
+        }
+
+        entry = next;
+    }
+
+    gExFutexTable.Stats.WakeCount++;
+    gExFutexTable.Stats.WokenCount += woken;
+    KeLeaveCriticalSection(&criticalSection);
+
+    KiFutexSignalReleased(&releaseList);
+    KeReleaseIrqlGuard(&irqlGuard);
+
+    *outWoken = woken;
+    return EC_SUCCESS;
+}
+
+uint32_t
+ExFutexWakeAddressSpace(HO_PHYSICAL_ADDRESS rootPageTablePhys)
+{
+    if (!gExFutexTable.Ready || rootPageTablePhys == 0)
+        return 0;
+
+    LINKED_LIST_TAG releaseList;
+    LinkedListInit(&releaseList);
+    uint32_t woken = 0;
+
+    KE_IRQL_GUARD irqlGuard = {0};
+    KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    for (uint32_t index = 0; index < EX_FUTEX_HASH_BUCKETS; ++index)
+    {
+        EX_FUTEX_BUCKET *bucket = &gExFutexTable.Buckets[index];
+        LINKED_LIST_TAG *entry = bucket->Waiters.Flink;
+
+        while (entry != &bucket->Waiters)
+        {
+            LINKED_LIST_TAG *next = entry->Flink;
+            EX_FUTEX_WAITER *waiter = CONTAINING_RECORD(entry, EX_FUTEX_WAITER, Link);
+
+            if (waiter->RootPageTablePhys == rootPageTablePhys)
+            {
+                KiFutexUnlinkWaiter(waiter);
+                waiter->Woken = TRUE;
+                LinkedListInsertTail(&releaseList, &waiter->Link);
+                woken++;
+            }
+
+            entry = next;
+        }
+    }
+
+    gExFutexTable.Stats.KillWakeCount += woken;
+    KeLeaveCriticalSection(&criticalSection);
+
+    KiFutexSignalReleased(&releaseList);
+    KeReleaseIrqlGuard(&irqlGuard);
+
+    return woken;
+}
+
+HO_KERNEL_API HO_STATUS
+ExQueryFutexStats(EX_SYSINFO_FUTEX_STATS *outStats)
+{
+    if (outStats == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    *outStats = gExFutexTable.Stats;
+    KeLeaveCriticalSection(&criticalSection);
+
+    outStats->Version = EX_SYSINFO_FUTEX_STATS_VERSION;
+    outStats->Size = sizeof(*outStats);
+    outStats->BucketCount = EX_FUTEX_HASH_BUCKETS;
+    return EC_SUCCESS;
+}
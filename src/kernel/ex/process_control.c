@@ -2,7 +2,8 @@
  * HimuOperatingSystem
  *
  * File: ex/process_control.c
- * Description: Ex-owned runtime process lifecycle control for spawn/wait/kill.
+ * Description: Ex-owned runtime process lifecycle control for spawn/wait/kill,
+ *              served by a persistent spawn worker pool.
  * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
  */
 
@@ -10,29 +11,62 @@
 
 #include <kernel/ex/ex_runtime.h>
 
+#include <kernel/ex/futex.h>
 #include <kernel/ex/program.h>
 #include <kernel/ex/user_syscall_abi.h>
 #include <kernel/hodbg.h>
+#include <kernel/ke/critical_section.h>
+#include <kernel/ke/event.h>
 #include <kernel/ke/input.h>
+#include <kernel/ke/lock_profile.h>
 #include <kernel/ke/scheduler.h>
+#include <kernel/ke/semaphore.h>
+#include <kernel/ke/time_source.h>
+#include <lib/common/linked_list.h>
+
+#define EX_SPAWN_POOL_SEMAPHORE_LIMIT 0x7FFFFFFF
 
 typedef struct EX_PROCESS_SPAWN_WORK
 {
+    LINKED_LIST_TAG QueueLink;
     const EX_USER_IMAGE *Image;
     uint32_t Flags;
     uint32_t ParentProcessId;
     uint32_t PreviousForegroundOwnerThreadId;
     uint32_t ChildProcessId;
     uint32_t ChildThreadId;
+    uint64_t RequestNs;
+    KEVENT CompletionEvent;
     HO_STATUS Status;
 } EX_PROCESS_SPAWN_WORK;
 
+// Spawn requests are served by a fixed pool of long-lived kernel workers
+// instead of a throwaway KTHREAD per request. A worker takes one request per
+// wakeup, so queued requests spread over the pool; only when every worker is
+// already busy does it pull up to EX_SPAWN_BATCH_LIMIT at once.
+typedef struct EX_SPAWN_POOL
+{
+    BOOL Ready;
+    LINKED_LIST_TAG PendingList;
+    KSEMAPHORE PendingSemaphore;
+    KTHREAD *Workers[EX_SPAWN_WORKER_COUNT];
+    uint32_t BusyWorkers;
+    uint64_t WorkerServedCount[EX_SPAWN_WORKER_COUNT];
+    EX_SYSINFO_SPAWN_STATS Stats;
+} EX_SPAWN_POOL;
+
+static EX_SPAWN_POOL gExSpawnPool;
+
 static void KiUnexpectedExProcessControlKernelEntry(void *arg);
 static void KiExSpawnWorkerThread(void *arg);
+static uint32_t KiExDequeueSpawnBatch(uint32_t workerIndex, EX_PROCESS_SPAWN_WORK **batch);
+static void KiExRunSpawnWork(EX_PROCESS_SPAWN_WORK *work);
+static void KiExRecordSpawnCompletion(HO_STATUS status, uint64_t stagingNs);
 static HO_STATUS KiExCreateAndStartProcessImage(const EX_USER_IMAGE *image,
                                                 uint32_t flags,
                                                 uint32_t parentProcessId,
                                                 uint32_t previousForegroundOwnerThreadId,
+                                                uint64_t requestNs,
                                                 uint32_t *outPid,
                                                 uint32_t *outThreadId);
 static HO_STATUS KiResolveCallerParentProcessId(uint32_t *outParentProcessId);
@@ -45,22 +79,123 @@ KiUnexpectedExProcessControlKernelEntry(void *arg)
     HO_KPANIC(EC_INVALID_STATE, "Ex process-control runtime thread unexpectedly executed the kernel entry point");
 }
 
+// Marks the worker busy and takes its requests; batch holds EX_SPAWN_BATCH_LIMIT entries.
+static uint32_t
+KiExDequeueSpawnBatch(uint32_t workerIndex, EX_PROCESS_SPAWN_WORK **batch)
+{
+    uint32_t count = 0;
+    uint64_t nowNs = KeGetSystemUpTimeNs();
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    // An idle worker holding a semaphore count would otherwise wake to an
+    // empty queue while this one runs its requests back to back.
+    gExSpawnPool.BusyWorkers++;
+    uint32_t capacity = gExSpawnPool.BusyWorkers == EX_SPAWN_WORKER_COUNT ? EX_SPAWN_BATCH_LIMIT : 1U;
+
+    while (count < capacity && !LinkedListIsEmpty(&gExSpawnPool.PendingList))
+    {
+        LINKED_LIST_TAG *entry = gExSpawnPool.PendingList.Flink;
+        EX_PROCESS_SPAWN_WORK *work = CONTAINING_RECORD(entry, EX_PROCESS_SPAWN_WORK, QueueLink);
+        uint64_t waitNs = nowNs > work->RequestNs ? nowNs - work->RequestNs : 0;
+
+        LinkedListRemove(entry);
+        LinkedListInit(entry);
+        HO_KASSERT(gExSpawnPool.Stats.PendingDepth != 0, EC_INVALID_STATE);
+        gExSpawnPool.Stats.PendingDepth--;
+        gExSpawnPool.Stats.QueueWaitTotalNs += waitNs;
+        if (waitNs > gExSpawnPool.Stats.QueueWaitMaxNs)
+            gExSpawnPool.Stats.QueueWaitMaxNs = waitNs;
+
+        batch[count++] = work;
+    }
+
+    if (count != 0)
+    {
+        gExSpawnPool.WorkerServedCount[workerIndex] += count;
+        gExSpawnPool.Stats.BatchCount++;
+        if (count > gExSpawnPool.Stats.MaxBatchSize)
+            gExSpawnPool.Stats.MaxBatchSize = count;
+    }
+
+    KeLeaveCriticalSection(&criticalSection);
+    return count;
+}
+
+static void
+KiExRecordSpawnCompletion(HO_STATUS status, uint64_t stagingNs)
+{
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (status == EC_SUCCESS)
+    {
+        gExSpawnPool.Stats.CompletedCount++;
+        gExSpawnPool.Stats.StagingTotalNs += stagingNs;
+        if (stagingNs > gExSpawnPool.Stats.StagingMaxNs)
+            gExSpawnPool.Stats.StagingMaxNs = stagingNs;
+    }
+    else
+    {
+        gExSpawnPool.Stats.FailedCount++;
+    }
+
+    KeLeaveCriticalSection(&criticalSection);
+}
+
+static void
+KiExRunSpawnWork(EX_PROCESS_SPAWN_WORK *work)
+{
+    uint64_t startNs = KeGetSystemUpTimeNs();
+
+    work->Status = KiExCreateAndStartProcessImage(work->Image,
+                                                  work->Flags,
+                                                  work->ParentProcessId,
+                                                  work->PreviousForegroundOwnerThreadId,
+                                                  work->RequestNs,
+                                                  &work->ChildProcessId,
+                                                  &work->ChildThreadId);
+
+    KiExRecordSpawnCompletion(work->Status, KeGetSystemUpTimeNs() - startNs);
+
+    // The request lives on the requester's stack; it must not be touched
+    // once the completion event is set.
+    KeSetEvent(&work->CompletionEvent);
+}
+
 static void
 KiExSpawnWorkerThread(void *arg)
 {
-    EX_PROCESS_SPAWN_WORK *work = (EX_PROCESS_SPAWN_WORK *)arg;
-    HO_STATUS status = EC_SUCCESS;
+    uint32_t workerIndex = (uint32_t)(uint64_t)arg;
+
+    HO_KASSERT(workerIndex < EX_SPAWN_WORKER_COUNT, EC_ILLEGAL_ARGUMENT);
+
+    for (;;)
+    {
+        EX_PROCESS_SPAWN_WORK *batch[EX_SPAWN_BATCH_LIMIT];
+
+        HO_STATUS status = KeWaitForSingleObject(&gExSpawnPool.PendingSemaphore, KE_WAIT_INFINITE);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "Ex spawn worker wait failed");
 
-    if (work == NULL)
-        HO_KPANIC(EC_ILLEGAL_ARGUMENT, "Ex process-control spawn work is required");
+        uint32_t batchSize = KiExDequeueSpawnBatch(workerIndex, batch);
 
-    status = KiExCreateAndStartProcessImage(work->Image,
-                                            work->Flags,
-                                            work->ParentProcessId,
-                                            work->PreviousForegroundOwnerThreadId,
-                                            &work->ChildProcessId,
-                                            &work->ChildThreadId);
-    work->Status = status;
+        // Absorb the semaphore counts of the extra requests taken in this
+        // batch. Every worker is busy, so nobody is waiting for them; a
+        // worker that finishes meanwhile may still take one, find the queue
+        // empty and simply wait again.
+        for (uint32_t index = 1; index < batchSize; ++index)
+            (void)KeWaitForSingleObject(&gExSpawnPool.PendingSemaphore, 0);
+
+        for (uint32_t index = 0; index < batchSize; ++index)
+            KiExRunSpawnWork(batch[index]);
+
+        KE_CRITICAL_SECTION criticalSection = {0};
+        KeEnterCriticalSection(&criticalSection);
+        HO_KASSERT(gExSpawnPool.BusyWorkers != 0, EC_INVALID_STATE);
+        gExSpawnPool.BusyWorkers--;
+        KeLeaveCriticalSection(&criticalSection);
+    }
 }
 
 static HO_STATUS
@@ -68,6 +203,7 @@ KiExCreateAndStartProcessImage(const EX_USER_IMAGE *image,
                                uint32_t flags,
                                uint32_t parentProcessId,
                                uint32_t previousForegroundOwnerThreadId,
+                               uint64_t requestNs,
                                uint32_t *outPid,
                                uint32_t *outThreadId)
 {
@@ -112,6 +248,8 @@ KiExCreateAndStartProcessImage(const EX_USER_IMAGE *image,
     if (status != EC_SUCCESS)
         goto Cleanup;
 
+    process->SpawnRequestNs = requestNs;
+
     status = ExRuntimeCreateThread(&process, &threadParams, &thread);
     if (status != EC_SUCCESS)
         goto Cleanup;
@@ -220,7 +358,6 @@ ExSpawnProgramImage(const EX_USER_IMAGE *image, uint32_t flags, uint32_t *outPid
 {
     KTHREAD *currentThread = KeGetCurrentThread();
     EX_PROCESS_SPAWN_WORK work = {0};
-    KTHREAD *workerThread = NULL;
     uint32_t parentProcessId = 0;
     HO_STATUS status = EC_SUCCESS;
 
@@ -249,33 +386,46 @@ ExSpawnProgramImage(const EX_USER_IMAGE *image, uint32_t flags, uint32_t *outPid
                                               flags,
                                               parentProcessId,
                                               KeInputGetForegroundOwnerThreadId(),
+                                              KeGetSystemUpTimeNs(),
                                               outPid,
                                               &childThreadId);
     }
 
+    LinkedListInit(&work.QueueLink);
     work.Image = image;
     work.Flags = flags;
     work.ParentProcessId = parentProcessId;
     work.PreviousForegroundOwnerThreadId = KeInputGetForegroundOwnerThreadId();
     work.Status = EC_INVALID_STATE;
+    KeInitializeEvent(&work.CompletionEvent, FALSE);
 
-    status = KeThreadCreateJoinable(&workerThread, KiExSpawnWorkerThread, &work);
-    if (status != EC_SUCCESS)
-        return status;
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (!gExSpawnPool.Ready)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        return EC_INVALID_STATE;
+    }
+
+    work.RequestNs = KeGetSystemUpTimeNs();
+    LinkedListInsertTail(&gExSpawnPool.PendingList, &work.QueueLink);
+    gExSpawnPool.Stats.PendingDepth++;
+    if (gExSpawnPool.Stats.PendingDepth > gExSpawnPool.Stats.MaxPendingDepth)
+        gExSpawnPool.Stats.MaxPendingDepth = gExSpawnPool.Stats.PendingDepth;
+
+    KeLeaveCriticalSection(&criticalSection);
 
-    status = KeThreadStart(workerThread);
+    status = KeReleaseSemaphore(&gExSpawnPool.PendingSemaphore, 1);
     if (status != EC_SUCCESS)
-        return status;
+        HO_KPANIC(status, "Failed to signal Ex spawn pool");
 
-    status = KeThreadJoin(workerThread, KE_WAIT_INFINITE);
+    status = KeWaitForSingleObject(&work.CompletionEvent, KE_WAIT_INFINITE);
     if (status != EC_SUCCESS)
-        return status;
+        HO_KPANIC(status, "Ex spawn completion wait failed");
 
     if (work.Status != EC_SUCCESS)
-    {
-        status = work.Status;
-        return status;
-    }
+        return work.Status;
 
     *outPid = work.ChildProcessId;
     return EC_SUCCESS;
@@ -353,6 +503,10 @@ ExKillProcess(uint32_t pid)
     if (status != EC_SUCCESS)
         goto Exit;
 
+    // Kill is observed on the syscall exit path; release any futex sleepers so
+    // they reach it.
+    (void)ExFutexWakeAddressSpace(childProcess->AddressSpace.RootPageTablePhys);
+
     status = ExRuntimeWaitForProcessCompletion(childProcess, KE_WAIT_INFINITE);
     if (status != EC_SUCCESS)
         goto Exit;
@@ -404,3 +558,97 @@ ExShouldTerminateCurrentProcess(uint32_t *outProgramId)
 {
     return ExRuntimeShouldTerminateCurrentProcess(outProgramId);
 }
+
+// ─────────────────────────────────────────────────────────────
+// Spawn pool
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+ExSpawnPoolInit(void)
+{
+    if (gExSpawnPool.Ready)
+        return EC_INVALID_STATE;
+
+    memset(&gExSpawnPool, 0, sizeof(gExSpawnPool));
+    LinkedListInit(&gExSpawnPool.PendingList);
+
+    HO_STATUS status = KeInitializeSemaphore(&gExSpawnPool.PendingSemaphore, 0, EX_SPAWN_POOL_SEMAPHORE_LIMIT);
+    if (status != EC_SUCCESS)
+        return status;
+    (void)KeRegisterLockProfile(&gExSpawnPool.PendingSemaphore, "ex.spawn.pending");
+
+    for (uint32_t index = 0; index < EX_SPAWN_WORKER_COUNT; ++index)
+    {
+        KTHREAD *worker = NULL;
+
+        status = KeThreadCreate(&worker, KiExSpawnWorkerThread, (void *)(uint64_t)index);
+        if (status != EC_SUCCESS)
+            return status;
+
+        status = KeThreadStart(worker);
+        if (status != EC_SUCCESS)
+            return status;
+
+        gExSpawnPool.Workers[index] = worker;
+    }
+
+    gExSpawnPool.Ready = TRUE;
+    klog(KLOG_LEVEL_INFO, "[SPAWN] pool ready workers=%u batch=%u\n", EX_SPAWN_WORKER_COUNT, EX_SPAWN_BATCH_LIMIT);
+    return EC_SUCCESS;
+}
+
+void
+ExRuntimeRecordFirstUserEntry(EX_PROCESS *process)
+{
+    if (process == NULL)
+        return;
+
+    uint64_t nowNs = KeGetSystemUpTimeNs();
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (process->SpawnRequestNs != 0)
+    {
+        uint64_t latencyNs = nowNs > process->SpawnRequestNs ? nowNs - process->SpawnRequestNs : 0;
+
+        process->SpawnRequestNs = 0;
+        gExSpawnPool.Stats.FirstUserEntryCount++;
+        gExSpawnPool.Stats.FirstUserEntryTotalNs += latencyNs;
+        if (latencyNs > gExSpawnPool.Stats.FirstUserEntryMaxNs)
+            gExSpawnPool.Stats.FirstUserEntryMaxNs = latencyNs;
+    }
+
+    KeLeaveCriticalSection(&criticalSection);
+}
+
+HO_KERNEL_API HO_STATUS
+ExQuerySpawnStats(EX_SYSINFO_SPAWN_STATS *outStats)
+{
+    if (outStats == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    *outStats = gExSpawnPool.Stats;
+    KeLeaveCriticalSection(&criticalSection);
+
+    outStats->Version = EX_SYSINFO_SPAWN_STATS_VERSION;
+    outStats->Size = sizeof(*outStats);
+    outStats->WorkerCount = EX_SPAWN_WORKER_COUNT;
+    outStats->BatchLimit = EX_SPAWN_BATCH_LIMIT;
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API HO_STATUS
+ExQuerySpawnWorkerLoad(uint64_t *outServedCounts, uint32_t capacity)
+{
+    if (outServedCounts == NULL || capacity < EX_SPAWN_WORKER_COUNT)
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    for (uint32_t index = 0; index < EX_SPAWN_WORKER_COUNT; ++index)
+        outServedCounts[index] = gExSpawnPool.WorkerServedCount[index];
+    KeLeaveCriticalSection(&criticalSection);
+    return EC_SUCCESS;
+}
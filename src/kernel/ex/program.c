@@ -50,6 +50,26 @@ extern const uint8_t gExBuiltinProgram_line_echo_CodeBytesStart[];
 extern const uint8_t gExBuiltinProgram_line_echo_CodeBytesEnd[];
 extern const uint8_t gExBuiltinProgram_line_echo_ConstBytesStart[];
 extern const uint8_t gExBuiltinProgram_line_echo_ConstBytesEnd[];
+extern const uint8_t gExBuiltinProgram_futex_probe_CodeBytesStart[];
+extern const uint8_t gExBuiltinProgram_futex_probe_CodeBytesEnd[];
+extern const uint8_t gExBuiltinProgram_futex_probe_ConstBytesStart[];
+extern const uint8_t gExBuiltinProgram_futex_probe_ConstBytesEnd[];
+extern const uint8_t gExBuiltinProgram_deadline_probe_CodeBytesStart[];
+extern const uint8_t gExBuiltinProgram_deadline_probe_CodeBytesEnd[];
+extern const uint8_t gExBuiltinProgram_deadline_probe_ConstBytesStart[];
+extern const uint8_t gExBuiltinProgram_deadline_probe_ConstBytesEnd[];
+extern const uint8_t gExBuiltinProgram_timer_slack_probe_CodeBytesStart[];
+extern const uint8_t gExBuiltinProgram_timer_slack_probe_CodeBytesEnd[];
+extern const uint8_t gExBuiltinProgram_timer_slack_probe_ConstBytesStart[];
+extern const uint8_t gExBuiltinProgram_timer_slack_probe_ConstBytesEnd[];
+extern const uint8_t gExBuiltinProgram_time_probe_CodeBytesStart[];
+extern const uint8_t gExBuiltinProgram_time_probe_CodeBytesEnd[];
+extern const uint8_t gExBuiltinProgram_time_probe_ConstBytesStart[];
+extern const uint8_t gExBuiltinProgram_time_probe_ConstBytesEnd[];
+extern const uint8_t gExBuiltinProgram_loglevel_CodeBytesStart[];
+extern const uint8_t gExBuiltinProgram_loglevel_CodeBytesEnd[];
+extern const uint8_t gExBuiltinProgram_loglevel_ConstBytesStart[];
+extern const uint8_t gExBuiltinProgram_loglevel_ConstBytesEnd[];
 
 typedef struct EX_PROGRAM_REGISTRY_ENTRY
 {
@@ -89,6 +109,11 @@ static EX_PROGRAM_REGISTRY_ENTRY gExBuiltinPrograms[] = {
     EX_PROGRAM_REGISTRY_ENTRY(user_caps, "user_caps", EX_PROGRAM_ID_USER_CAPS),
     EX_PROGRAM_REGISTRY_ENTRY(input_probe, "input_probe", EX_PROGRAM_ID_INPUT_PROBE),
     EX_PROGRAM_REGISTRY_ENTRY(line_echo, "line_echo", EX_PROGRAM_ID_LINE_ECHO),
+    EX_PROGRAM_REGISTRY_ENTRY(futex_probe, "futex_probe", EX_PROGRAM_ID_FUTEX_PROBE),
+    EX_PROGRAM_REGISTRY_ENTRY(deadline_probe, "deadline_probe", EX_PROGRAM_ID_DEADLINE_PROBE),
+    EX_PROGRAM_REGISTRY_ENTRY(timer_slack_probe, "timer_slack_probe", EX_PROGRAM_ID_TIMER_SLACK_PROBE),
+    EX_PROGRAM_REGISTRY_ENTRY(time_probe, "time_probe", EX_PROGRAM_ID_TIME_PROBE),
+    EX_PROGRAM_REGISTRY_ENTRY(loglevel, "loglevel", EX_PROGRAM_ID_LOGLEVEL),
 };
 
 static BOOL gExProgramRegistryValidated;
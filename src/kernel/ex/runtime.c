@@ -8,13 +8,18 @@
 
 #include <kernel/ex/ex_runtime.h>
 
+#include "runtime_internal.h"
+
 #include <kernel/ex/ex_user_runtime.h>
+#include <kernel/ex/futex.h>
 #include <kernel/ex/program.h>
 #include <kernel/ke/user_mode.h>
 
 HO_STATUS
 ExRuntimeInit(void)
 {
+    ExRuntimeTableInit();
+
     HO_STATUS status = ExProgramValidateBuiltins();
     if (status != EC_SUCCESS)
         return status;
@@ -23,5 +28,13 @@ ExRuntimeInit(void)
     if (status != EC_SUCCESS)
         return status;
 
-    return ExUserRuntimeInit();
+    status = ExUserRuntimeInit();
+    if (status != EC_SUCCESS)
+        return status;
+
+    status = ExFutexInit();
+    if (status != EC_SUCCESS)
+        return status;
+
+    return ExSpawnPoolInit();
 }
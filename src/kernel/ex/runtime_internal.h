@@ -61,6 +61,7 @@ struct EX_PROCESS
     BOOL Foreground;
     uint32_t RestoreForegroundOwnerThreadId;
     uint32_t ProgramId;
+    uint64_t SpawnRequestNs; // Spawn enqueue time; cleared once the first user entry is recorded
     KEVENT CompletionEvent;
     EX_STDOUT_SERVICE StdoutService;
     EX_HANDLE_TABLE HandleTable;
@@ -86,6 +87,12 @@ EX_PROCESS *ExRuntimeRetainProcess(EX_PROCESS *process);
 HO_STATUS ExRuntimeReleaseProcess(EX_PROCESS *process);
 HO_STATUS ExRuntimeReleaseThread(EX_THREAD *thread);
 BOOL ExRuntimeIsPublishedObject(const EX_OBJECT_HEADER *objectHeader);
+void ExRuntimeTableInit(void);
+
+// Regression-profile hooks: hold the table shared across a sleep and watch for a queued writer.
+HO_STATUS ExRuntimeTestAcquireTableShared(void);
+HO_STATUS ExRuntimeTestReleaseTableShared(void);
+BOOL ExRuntimeTestIsTableWriterWaiting(void);
 BOOL ExRuntimeIsProcessPublished(const EX_PROCESS *process);
 HO_STATUS ExRuntimeCaptureThreadList(EX_SYSINFO_THREAD_LIST *outThreadList);
 HO_STATUS ExRuntimeCaptureProcessList(EX_SYSINFO_PROCESS_LIST *outProcessList);
@@ -109,12 +116,15 @@ HO_STATUS ExRuntimeSignalThreadCompletion(EX_THREAD *thread);
 HO_STATUS ExRuntimeWaitForProcessCompletion(EX_PROCESS *process, uint64_t timeoutNs);
 HO_STATUS ExRuntimeWaitForThreadCompletion(EX_THREAD *thread, uint64_t timeoutNs);
 HO_STATUS ExRuntimeConsumeCompletedProcess(EX_PROCESS *process);
-void ExRuntimeUnpublishThreadByKernelThread(const struct KTHREAD *thread,
-                                            EX_THREAD **outThread,
-                                            EX_PROCESS **outProcess);
-void ExRuntimeUnpublishByKernelThread(const struct KTHREAD *thread, EX_THREAD **outThread, EX_PROCESS **outProcess);
+HO_STATUS ExRuntimeUnpublishThreadByKernelThread(const struct KTHREAD *thread,
+                                                 EX_THREAD **outThread,
+                                                 EX_PROCESS **outProcess);
+HO_STATUS ExRuntimeUnpublishByKernelThread(const struct KTHREAD *thread,
+                                           EX_THREAD **outThread,
+                                           EX_PROCESS **outProcess);
 HO_STATUS ExRuntimeBuildInitialConstBytes(const EX_RUNTIME_PROCESS_CREATE_PARAMS *params,
                                           uint8_t **outConstBytes,
                                           uint64_t *outConstLength);
 HO_STATUS ExRuntimePatchCapabilitySeed(EX_PROCESS *process, EX_THREAD *thread);
+void ExRuntimeRecordFirstUserEntry(EX_PROCESS *process);
 int64_t ExRuntimeHandleQuerySysinfo(EX_PROCESS *process, uint64_t infoClassRaw, uint64_t userBuffer, uint64_t length);
@@ -10,9 +10,11 @@
 
 #include <kernel/ex/ex_runtime.h>
 #include <kernel/ex/program.h>
+#include <kernel/hodbg.h>
 #include <kernel/ke/critical_section.h>
 #include <kernel/ke/input.h>
 #include <kernel/ke/kthread.h>
+#include <kernel/ke/lock_profile.h>
 #include <kernel/ke/scheduler.h>
 #include <libc/string.h>
 
@@ -42,6 +44,22 @@ typedef struct EX_RUNTIME_THREAD_TABLE_ENTRY
 static EX_RUNTIME_PROCESS_TABLE_ENTRY gExRuntimeProcessTable[EX_RUNTIME_PROCESS_TABLE_CAPACITY] = {0};
 static EX_RUNTIME_THREAD_TABLE_ENTRY gExRuntimeThreadTable[EX_RUNTIME_THREAD_TABLE_CAPACITY] = {0};
 
+// Table membership lock. Readers (sysinfo captures, ps, handle and pid lookups) share it
+// and stay preemptible; writers (publish, consume, unpublish) take it exclusively and
+// additionally mutate inside a critical section. Callers that cannot block (the idle
+// thread, the timer ISR hook, the dispatcher, anything already inside a critical section)
+// read under a bare critical section instead, which is consistent because no writer is
+// ever preempted mid-update. Per-process field updates (kill, foreground, termination)
+// still use a critical section only: they never change table membership.
+static KRWLOCK gExRuntimeTableLock;
+
+typedef struct EX_RUNTIME_TABLE_GUARD
+{
+    BOOL Shared;
+    BOOL RwLockHeld;
+    KE_CRITICAL_SECTION CriticalSection;
+} EX_RUNTIME_TABLE_GUARD;
+
 static void KiCopyRuntimeProgramName(char *destination, size_t destinationSize, const char *source);
 static const char *KiGetRuntimeProgramName(uint32_t programId);
 static uint32_t KiMapRuntimeThreadState(const KTHREAD *thread);
@@ -56,6 +74,97 @@ static uint32_t KiFindThreadSlotByThreadId(uint32_t threadId);
 static uint32_t KiFindThreadSlotByKernelThread(const KTHREAD *thread);
 static uint32_t KiFindFreeThreadSlot(void);
 static EX_THREAD *KiLookupThreadByTidLocked(uint32_t threadId);
+static HO_STATUS KiUnpublishByKernelThread(const KTHREAD *thread,
+                                           BOOL unpublishProcess,
+                                           EX_THREAD **outThread,
+                                           EX_PROCESS **outProcess);
+static BOOL KiCanWaitForRuntimeTable(void);
+static void KiLockRuntimeTableShared(EX_RUNTIME_TABLE_GUARD *guard);
+static HO_STATUS KiLockRuntimeTableExclusive(EX_RUNTIME_TABLE_GUARD *guard);
+static void KiUnlockRuntimeTable(EX_RUNTIME_TABLE_GUARD *guard);
+
+void
+ExRuntimeTableInit(void)
+{
+    KeInitializeRwLock(&gExRuntimeTableLock);
+    (void)KeRegisterLockProfile(&gExRuntimeTableLock, "ex.runtime.table");
+}
+
+HO_STATUS
+ExRuntimeTestAcquireTableShared(void)
+{
+    return KeAcquireRwLockShared(&gExRuntimeTableLock, KE_WAIT_INFINITE);
+}
+
+HO_STATUS
+ExRuntimeTestReleaseTableShared(void)
+{
+    return KeReleaseRwLockShared(&gExRuntimeTableLock);
+}
+
+BOOL
+ExRuntimeTestIsTableWriterWaiting(void)
+{
+    return gExRuntimeTableLock.ExclusiveWaiterCount != 0;
+}
+
+// The idle thread runs at PASSIVE_LEVEL but may never wait.
+static BOOL
+KiCanWaitForRuntimeTable(void)
+{
+    KTHREAD *thread = KeGetCurrentThread();
+    return KeIsBlockingAllowed() && thread != NULL && (thread->Flags & KTHREAD_FLAG_IDLE) == 0;
+}
+
+static void
+KiLockRuntimeTableShared(EX_RUNTIME_TABLE_GUARD *guard)
+{
+    guard->Shared = TRUE;
+    guard->RwLockHeld = FALSE;
+
+    if (KiCanWaitForRuntimeTable())
+    {
+        HO_STATUS status = KeAcquireRwLockShared(&gExRuntimeTableLock, KE_WAIT_INFINITE);
+        HO_KASSERT(status == EC_SUCCESS, status);
+        guard->RwLockHeld = TRUE;
+        return;
+    }
+
+    KeEnterCriticalSection(&guard->CriticalSection);
+}
+
+// Callers that cannot block only try; a held lock comes back as EC_TIMEOUT. The idle
+// loop leaves user-runtime teardown to the reaper thread, which can wait here.
+static HO_STATUS
+KiLockRuntimeTableExclusive(EX_RUNTIME_TABLE_GUARD *guard)
+{
+    guard->Shared = FALSE;
+    guard->RwLockHeld = FALSE;
+
+    HO_STATUS status =
+        KeAcquireRwLockExclusive(&gExRuntimeTableLock, KiCanWaitForRuntimeTable() ? KE_WAIT_INFINITE : 0);
+    if (status != EC_SUCCESS)
+        return status;
+
+    guard->RwLockHeld = TRUE;
+    KeEnterCriticalSection(&guard->CriticalSection);
+    return EC_SUCCESS;
+}
+
+static void
+KiUnlockRuntimeTable(EX_RUNTIME_TABLE_GUARD *guard)
+{
+    if (guard->CriticalSection.Active)
+        KeLeaveCriticalSection(&guard->CriticalSection);
+
+    if (!guard->RwLockHeld)
+        return;
+
+    HO_STATUS status = guard->Shared ? KeReleaseRwLockShared(&gExRuntimeTableLock)
+                                     : KeReleaseRwLockExclusive(&gExRuntimeTableLock);
+    HO_KASSERT(status == EC_SUCCESS, status);
+    guard->RwLockHeld = FALSE;
+}
 
 static void
 KiCopyRuntimeProgramName(char *destination, size_t destinationSize, const char *source)
@@ -298,12 +407,12 @@ BOOL
 ExRuntimeIsPublishedObject(const EX_OBJECT_HEADER *objectHeader)
 {
     BOOL isPublished = FALSE;
-    KE_CRITICAL_SECTION guard = {0};
+    EX_RUNTIME_TABLE_GUARD guard = {0};
 
     if (objectHeader == NULL)
         return FALSE;
 
-    KeEnterCriticalSection(&guard);
+    KiLockRuntimeTableShared(&guard);
 
     switch (objectHeader->Type)
     {
@@ -320,7 +429,7 @@ ExRuntimeIsPublishedObject(const EX_OBJECT_HEADER *objectHeader)
         break;
     }
 
-    KeLeaveCriticalSection(&guard);
+    KiUnlockRuntimeTable(&guard);
     return isPublished;
 }
 
@@ -328,11 +437,11 @@ BOOL
 ExRuntimeIsProcessPublished(const EX_PROCESS *process)
 {
     BOOL isPublished = FALSE;
-    KE_CRITICAL_SECTION guard = {0};
+    EX_RUNTIME_TABLE_GUARD guard = {0};
 
-    KeEnterCriticalSection(&guard);
+    KiLockRuntimeTableShared(&guard);
     isPublished = KiFindProcessSlotByProcess(process) < EX_RUNTIME_PROCESS_TABLE_CAPACITY;
-    KeLeaveCriticalSection(&guard);
+    KiUnlockRuntimeTable(&guard);
 
     return isPublished;
 }
@@ -340,7 +449,7 @@ ExRuntimeIsProcessPublished(const EX_PROCESS *process)
 HO_STATUS
 ExRuntimeCaptureThreadList(EX_SYSINFO_THREAD_LIST *outThreadList)
 {
-    KE_CRITICAL_SECTION guard = {0};
+    EX_RUNTIME_TABLE_GUARD guard = {0};
 
     if (outThreadList == NULL)
         return EC_ILLEGAL_ARGUMENT;
@@ -349,7 +458,7 @@ ExRuntimeCaptureThreadList(EX_SYSINFO_THREAD_LIST *outThreadList)
     outThreadList->Version = EX_SYSINFO_THREAD_LIST_VERSION;
     outThreadList->Size = sizeof(*outThreadList);
 
-    KeEnterCriticalSection(&guard);
+    KiLockRuntimeTableShared(&guard);
 
     for (uint32_t index = 0; index < EX_RUNTIME_THREAD_TABLE_CAPACITY; ++index)
     {
@@ -379,7 +488,7 @@ ExRuntimeCaptureThreadList(EX_SYSINFO_THREAD_LIST *outThreadList)
         KiCopyRuntimeProgramName(entry->Name, sizeof(entry->Name), KiGetRuntimeProgramName(thread->Process->ProgramId));
     }
 
-    KeLeaveCriticalSection(&guard);
+    KiUnlockRuntimeTable(&guard);
     KiSortThreadEntries(outThreadList);
     return EC_SUCCESS;
 }
@@ -387,7 +496,7 @@ ExRuntimeCaptureThreadList(EX_SYSINFO_THREAD_LIST *outThreadList)
 HO_STATUS
 ExRuntimeCaptureProcessList(EX_SYSINFO_PROCESS_LIST *outProcessList)
 {
-    KE_CRITICAL_SECTION guard = {0};
+    EX_RUNTIME_TABLE_GUARD guard = {0};
 
     if (outProcessList == NULL)
         return EC_ILLEGAL_ARGUMENT;
@@ -396,7 +505,7 @@ ExRuntimeCaptureProcessList(EX_SYSINFO_PROCESS_LIST *outProcessList)
     outProcessList->Version = EX_SYSINFO_PROCESS_LIST_VERSION;
     outProcessList->Size = sizeof(*outProcessList);
 
-    KeEnterCriticalSection(&guard);
+    KiLockRuntimeTableShared(&guard);
 
     for (uint32_t index = 0; index < EX_RUNTIME_PROCESS_TABLE_CAPACITY; ++index)
     {
@@ -430,7 +539,7 @@ ExRuntimeCaptureProcessList(EX_SYSINFO_PROCESS_LIST *outProcessList)
         KiCopyRuntimeProgramName(entry->Name, sizeof(entry->Name), KiGetRuntimeProgramName(process->ProgramId));
     }
 
-    KeLeaveCriticalSection(&guard);
+    KiUnlockRuntimeTable(&guard);
     KiSortProcessEntries(outProcessList);
     return EC_SUCCESS;
 }
@@ -441,7 +550,7 @@ ExRuntimePublishThread(EX_PROCESS *process, EX_THREAD *thread)
     uint32_t processSlot = 0;
     uint32_t threadSlot = 0;
     HO_STATUS status = EC_SUCCESS;
-    KE_CRITICAL_SECTION guard = {0};
+    EX_RUNTIME_TABLE_GUARD guard = {0};
 
     if (process == NULL || thread == NULL || thread->Thread == NULL || thread->Process != process ||
         process->ProcessId == 0 || thread->ThreadId == 0)
@@ -449,7 +558,9 @@ ExRuntimePublishThread(EX_PROCESS *process, EX_THREAD *thread)
         return EC_ILLEGAL_ARGUMENT;
     }
 
-    KeEnterCriticalSection(&guard);
+    status = KiLockRuntimeTableExclusive(&guard);
+    if (status != EC_SUCCESS)
+        return status;
 
     if (KiFindProcessSlotByProcess(process) < EX_RUNTIME_PROCESS_TABLE_CAPACITY ||
         KiFindProcessSlotByPid(process->ProcessId) < EX_RUNTIME_PROCESS_TABLE_CAPACITY ||
@@ -476,7 +587,7 @@ ExRuntimePublishThread(EX_PROCESS *process, EX_THREAD *thread)
     process->MainThreadId = thread->ThreadId;
 
 Exit:
-    KeLeaveCriticalSection(&guard);
+    KiUnlockRuntimeTable(&guard);
     return status;
 }
 
@@ -485,13 +596,13 @@ ExRuntimeLookupThreadByKernelThread(const KTHREAD *thread)
 {
     uint32_t slotIndex = 0;
     EX_THREAD *runtimeThread = NULL;
-    KE_CRITICAL_SECTION guard = {0};
+    EX_RUNTIME_TABLE_GUARD guard = {0};
 
-    KeEnterCriticalSection(&guard);
+    KiLockRuntimeTableShared(&guard);
     slotIndex = KiFindThreadSlotByKernelThread(thread);
     if (slotIndex < EX_RUNTIME_THREAD_TABLE_CAPACITY)
         runtimeThread = gExRuntimeThreadTable[slotIndex].Thread;
-    KeLeaveCriticalSection(&guard);
+    KiUnlockRuntimeTable(&guard);
 
     return runtimeThread;
 }
@@ -508,13 +619,13 @@ ExRuntimeLookupProcessByPid(uint32_t processId)
 {
     uint32_t slotIndex = 0;
     EX_PROCESS *process = NULL;
-    KE_CRITICAL_SECTION guard = {0};
+    EX_RUNTIME_TABLE_GUARD guard = {0};
 
-    KeEnterCriticalSection(&guard);
+    KiLockRuntimeTableShared(&guard);
     slotIndex = KiFindProcessSlotByPid(processId);
     if (slotIndex < EX_RUNTIME_PROCESS_TABLE_CAPACITY)
         process = gExRuntimeProcessTable[slotIndex].Process;
-    KeLeaveCriticalSection(&guard);
+    KiUnlockRuntimeTable(&guard);
 
     return process;
 }
@@ -525,26 +636,33 @@ ExRuntimeRetainChildProcess(uint32_t parentProcessId, uint32_t childProcessId, E
     uint32_t slotIndex = 0;
     EX_PROCESS *process = NULL;
     HO_STATUS status = EC_INVALID_STATE;
-    KE_CRITICAL_SECTION guard = {0};
+    EX_RUNTIME_TABLE_GUARD guard = {0};
 
     if (outProcess == NULL || childProcessId == 0U)
         return EC_ILLEGAL_ARGUMENT;
 
     *outProcess = NULL;
 
-    KeEnterCriticalSection(&guard);
+    KiLockRuntimeTableShared(&guard);
     slotIndex = KiFindProcessSlotByPid(childProcessId);
     if (slotIndex < EX_RUNTIME_PROCESS_TABLE_CAPACITY)
     {
         process = gExRuntimeProcessTable[slotIndex].Process;
-        if (process != NULL && process->ParentProcessId == parentProcessId &&
-            ExObjectRetain(&process->Header, EX_OBJECT_TYPE_PROCESS) == EC_SUCCESS)
+        if (process != NULL && process->ParentProcessId == parentProcessId)
         {
-            *outProcess = process;
-            status = EC_SUCCESS;
+            // The table lock keeps the process published; the reference count
+            // itself is still updated under a critical section.
+            KE_CRITICAL_SECTION retainGuard = {0};
+            KeEnterCriticalSection(&retainGuard);
+            if (ExObjectRetain(&process->Header, EX_OBJECT_TYPE_PROCESS) == EC_SUCCESS)
+            {
+                *outProcess = process;
+                status = EC_SUCCESS;
+            }
+            KeLeaveCriticalSection(&retainGuard);
         }
     }
-    KeLeaveCriticalSection(&guard);
+    KiUnlockRuntimeTable(&guard);
 
     return status;
 }
@@ -819,22 +937,25 @@ ExRuntimeConsumeCompletedProcess(EX_PROCESS *process)
 {
     uint32_t processSlot = 0;
     BOOL releaseCompletionReference = FALSE;
-    KE_CRITICAL_SECTION guard = {0};
+    EX_RUNTIME_TABLE_GUARD guard = {0};
 
     if (process == NULL)
         return EC_ILLEGAL_ARGUMENT;
 
-    KeEnterCriticalSection(&guard);
+    HO_STATUS status = KiLockRuntimeTableExclusive(&guard);
+    if (status != EC_SUCCESS)
+        return status;
+
     if (process->State != EX_PROCESS_STATE_TERMINATED || !process->CompletionSignaled || !process->CompletionRetained)
     {
-        KeLeaveCriticalSection(&guard);
+        KiUnlockRuntimeTable(&guard);
         return EC_INVALID_STATE;
     }
 
     processSlot = KiFindProcessSlotByProcess(process);
     if (processSlot >= EX_RUNTIME_PROCESS_TABLE_CAPACITY)
     {
-        KeLeaveCriticalSection(&guard);
+        KiUnlockRuntimeTable(&guard);
         return EC_INVALID_STATE;
     }
 
@@ -842,20 +963,33 @@ ExRuntimeConsumeCompletedProcess(EX_PROCESS *process)
     gExRuntimeProcessTable[processSlot].Process = NULL;
     process->CompletionRetained = FALSE;
     releaseCompletionReference = TRUE;
-    KeLeaveCriticalSection(&guard);
+    KiUnlockRuntimeTable(&guard);
 
     return releaseCompletionReference ? ExRuntimeReleaseProcess(process) : EC_SUCCESS;
 }
 
-void
-ExRuntimeUnpublishThreadByKernelThread(const KTHREAD *thread, EX_THREAD **outThread, EX_PROCESS **outProcess)
+// Both unpublish paths clear their slots under one exclusive hold, so a caller that
+// cannot wait either changes nothing (EC_TIMEOUT) or removes everything it asked for.
+static HO_STATUS
+KiUnpublishByKernelThread(const KTHREAD *thread,
+                          BOOL unpublishProcess,
+                          EX_THREAD **outThread,
+                          EX_PROCESS **outProcess)
 {
     uint32_t threadSlot = 0;
     EX_THREAD *runtimeThread = NULL;
     EX_PROCESS *process = NULL;
-    KE_CRITICAL_SECTION guard = {0};
+    EX_RUNTIME_TABLE_GUARD guard = {0};
+
+    if (outThread != NULL)
+        *outThread = NULL;
+    if (outProcess != NULL)
+        *outProcess = NULL;
+
+    HO_STATUS status = KiLockRuntimeTableExclusive(&guard);
+    if (status != EC_SUCCESS)
+        return status;
 
-    KeEnterCriticalSection(&guard);
     threadSlot = KiFindThreadSlotByKernelThread(thread);
     if (threadSlot < EX_RUNTIME_THREAD_TABLE_CAPACITY)
     {
@@ -867,40 +1001,37 @@ ExRuntimeUnpublishThreadByKernelThread(const KTHREAD *thread, EX_THREAD **outThr
     if (runtimeThread != NULL)
         process = runtimeThread->Process;
 
-    KeLeaveCriticalSection(&guard);
+    if (unpublishProcess)
+    {
+        uint32_t processSlot = KiFindProcessSlotByProcess(process);
+        if (processSlot < EX_RUNTIME_PROCESS_TABLE_CAPACITY)
+        {
+            gExRuntimeProcessTable[processSlot].Active = FALSE;
+            gExRuntimeProcessTable[processSlot].Process = NULL;
+        }
+    }
+
+    KiUnlockRuntimeTable(&guard);
 
     if (outThread != NULL)
         *outThread = runtimeThread;
 
     if (outProcess != NULL)
         *outProcess = process;
+
+    return EC_SUCCESS;
 }
 
-void
-ExRuntimeUnpublishByKernelThread(const KTHREAD *thread, EX_THREAD **outThread, EX_PROCESS **outProcess)
+HO_STATUS
+ExRuntimeUnpublishThreadByKernelThread(const KTHREAD *thread, EX_THREAD **outThread, EX_PROCESS **outProcess)
 {
-    uint32_t processSlot = 0;
-    EX_THREAD *runtimeThread = NULL;
-    EX_PROCESS *process = NULL;
-    KE_CRITICAL_SECTION guard = {0};
-
-    ExRuntimeUnpublishThreadByKernelThread(thread, &runtimeThread, &process);
-
-    KeEnterCriticalSection(&guard);
-    processSlot = KiFindProcessSlotByProcess(process);
-    if (processSlot < EX_RUNTIME_PROCESS_TABLE_CAPACITY)
-    {
-        gExRuntimeProcessTable[processSlot].Active = FALSE;
-        gExRuntimeProcessTable[processSlot].Process = NULL;
-    }
-
-    KeLeaveCriticalSection(&guard);
-
-    if (outThread != NULL)
-        *outThread = runtimeThread;
+    return KiUnpublishByKernelThread(thread, FALSE, outThread, outProcess);
+}
 
-    if (outProcess != NULL)
-        *outProcess = process;
+HO_STATUS
+ExRuntimeUnpublishByKernelThread(const KTHREAD *thread, EX_THREAD **outThread, EX_PROCESS **outProcess)
+{
+    return KiUnpublishByKernelThread(thread, TRUE, outThread, outProcess);
 }
 
 static EX_THREAD *
@@ -10,6 +10,7 @@
 
 #include <kernel/ex/ex_user_runtime.h>
 #include <kernel/ex/ex_syscall.h>
+#include <kernel/ex/futex.h>
 #include <kernel/ex/program.h>
 #include <kernel/ex/user_regression_anchors.h>
 #include <kernel/ex/user_syscall_abi.h>
@@ -20,6 +21,7 @@
 #include <kernel/ke/user_mode.h>
 
 typedef char KI_INPUT_LINE_CAPACITY_MATCHES_USER_ABI[(KE_INPUT_LINE_CAPACITY == EX_USER_READLINE_MAX_LENGTH) ? 1 : -1];
+typedef char KI_LOG_LEVEL_SPEC_MATCHES_USER_ABI[(KE_KLOG_LEVEL_SPEC_MAX == EX_USER_LOG_LEVEL_SPEC_MAX_LENGTH) ? 1 : -1];
 
 static int64_t KiEncodeSyscallStatus(HO_STATUS status);
 static void KiSetReturnResult(EX_SYSCALL_DISPATCH_RESULT *result, int64_t returnValue);
@@ -48,6 +50,14 @@ static int64_t KiHandleSpawnProgram(uint64_t userName, uint64_t nameLength, uint
 static int64_t KiHandleWaitPid(uint64_t pid, uint64_t reserved0, uint64_t reserved1);
 static int64_t KiHandleSleepMs(uint64_t milliseconds, uint64_t reserved0, uint64_t reserved1);
 static int64_t KiHandleKillPid(uint64_t pid, uint64_t reserved0, uint64_t reserved1);
+static int64_t KiRejectFutexSyscall(const char *operation, uint64_t userAddress, HO_STATUS status);
+static int64_t KiHandleFutexWait(uint64_t userAddress, uint64_t expected, uint64_t timeoutMsRaw);
+static int64_t KiHandleFutexWake(uint64_t userAddress, uint64_t count, uint64_t reserved);
+static int64_t KiRejectDeadlineSyscall(const char *operation, HO_STATUS status);
+static int64_t KiHandleSetDeadline(uint64_t runtimeUs, uint64_t periodUs, uint64_t deadlineUs);
+static int64_t KiHandleWaitPeriod(uint64_t reserved0, uint64_t reserved1, uint64_t reserved2);
+static int64_t KiHandleSetTimerSlack(uint64_t slackUs, uint64_t reserved0, uint64_t reserved1);
+static int64_t KiHandleSetLogLevel(uint64_t userSpec, uint64_t length, uint64_t reserved);
 static HO_STATUS KiDispatchFormalSyscall(const EX_SYSCALL_ARGUMENTS *args, EX_SYSCALL_DISPATCH_RESULT *result);
 static HO_STATUS KiObserveKillRequest(EX_SYSCALL_DISPATCH_RESULT *result);
 
@@ -479,6 +489,152 @@ KiHandleKillPid(uint64_t pid, uint64_t reserved0, uint64_t reserved1)
     return 0;
 }
 
+static int64_t
+KiRejectFutexSyscall(const char *operation, uint64_t userAddress, HO_STATUS status)
+{
+    KTHREAD *thread = KeGetCurrentThread();
+
+    klog(KLOG_LEVEL_WARNING, EX_USER_REGRESSION_LOG_FUTEX_REJECTED " op=%s thread=%u addr=%p status=%s (%d)\n",
+         operation, thread ? thread->ThreadId : 0U, (void *)(uint64_t)userAddress, KrGetStatusMessage(status), status);
+    return KiEncodeSyscallStatus(status);
+}
+
+// The futex paths sit under user lock contention, so only argument rejections
+// are logged; mismatches and timeouts are ordinary results.
+static int64_t
+KiHandleFutexWait(uint64_t userAddress, uint64_t expected, uint64_t timeoutMsRaw)
+{
+    uint64_t timeoutNs = KE_WAIT_INFINITE;
+
+    if (expected > 0xFFFFFFFFULL ||
+        (timeoutMsRaw != EX_USER_FUTEX_TIMEOUT_INFINITE && timeoutMsRaw > EX_USER_FUTEX_TIMEOUT_MAX_MS))
+    {
+        return KiRejectFutexSyscall("SYS_FUTEX_WAIT", userAddress, EC_ILLEGAL_ARGUMENT);
+    }
+
+    if (timeoutMsRaw != EX_USER_FUTEX_TIMEOUT_INFINITE)
+        timeoutNs = timeoutMsRaw * EX_USER_FUTEX_TIMEOUT_NS_PER_MS;
+
+    HO_STATUS status = ExFutexWait((HO_VIRTUAL_ADDRESS)userAddress, (uint32_t)expected, timeoutNs);
+    if (status == EC_ILLEGAL_ARGUMENT)
+        return KiRejectFutexSyscall("SYS_FUTEX_WAIT", userAddress, status);
+
+    return KiEncodeSyscallStatus(status);
+}
+
+static int64_t
+KiHandleFutexWake(uint64_t userAddress, uint64_t count, uint64_t reserved)
+{
+    uint32_t woken = 0;
+
+    if (reserved != 0 || count > EX_USER_FUTEX_WAKE_ALL)
+        return KiRejectFutexSyscall("SYS_FUTEX_WAKE", userAddress, EC_ILLEGAL_ARGUMENT);
+
+    HO_STATUS status = ExFutexWake((HO_VIRTUAL_ADDRESS)userAddress, (uint32_t)count, &woken);
+    if (status != EC_SUCCESS)
+        return KiRejectFutexSyscall("SYS_FUTEX_WAKE", userAddress, status);
+
+    return (int64_t)woken;
+}
+
+static int64_t
+KiRejectDeadlineSyscall(const char *operation, HO_STATUS status)
+{
+    KTHREAD *thread = KeGetCurrentThread();
+
+    klog(KLOG_LEVEL_WARNING, EX_USER_REGRESSION_LOG_DEADLINE_REJECTED " op=%s thread=%u status=%s (%d)\n", operation,
+         thread ? thread->ThreadId : 0U, KrGetStatusMessage(status), status);
+    return KiEncodeSyscallStatus(status);
+}
+
+static int64_t
+KiHandleSetDeadline(uint64_t runtimeUs, uint64_t periodUs, uint64_t deadlineUs)
+{
+    if (runtimeUs > EX_USER_DEADLINE_MAX_US || periodUs > EX_USER_DEADLINE_MAX_US ||
+        deadlineUs > EX_USER_DEADLINE_MAX_US)
+    {
+        return KiRejectDeadlineSyscall("SYS_SET_DEADLINE", EC_ILLEGAL_ARGUMENT);
+    }
+
+    KE_DEADLINE_PARAMS params = {
+        .RuntimeNs = runtimeUs * EX_USER_DEADLINE_NS_PER_US,
+        .PeriodNs = periodUs * EX_USER_DEADLINE_NS_PER_US,
+        .DeadlineNs = deadlineUs * EX_USER_DEADLINE_NS_PER_US,
+    };
+
+    HO_STATUS status = KeThreadSetDeadline(KeGetCurrentThread(), &params);
+    if (status != EC_SUCCESS)
+        return KiRejectDeadlineSyscall("SYS_SET_DEADLINE", status);
+
+    return 0;
+}
+
+static int64_t
+KiHandleWaitPeriod(uint64_t reserved0, uint64_t reserved1, uint64_t reserved2)
+{
+    if (reserved0 != 0 || reserved1 != 0 || reserved2 != 0)
+        return KiRejectDeadlineSyscall("SYS_WAIT_PERIOD", EC_ILLEGAL_ARGUMENT);
+
+    // Runs once per period, so only failures are logged.
+    HO_STATUS status = KeThreadWaitNextPeriod();
+    if (status != EC_SUCCESS)
+        return KiRejectDeadlineSyscall("SYS_WAIT_PERIOD", status);
+
+    return 0;
+}
+
+static int64_t
+KiHandleSetTimerSlack(uint64_t slackUs, uint64_t reserved0, uint64_t reserved1)
+{
+    HO_STATUS status = EC_ILLEGAL_ARGUMENT;
+
+    if (reserved0 == 0 && reserved1 == 0 &&
+        (slackUs <= EX_USER_TIMER_SLACK_MAX_US || slackUs == EX_USER_TIMER_SLACK_DEFAULT))
+    {
+        uint64_t slackNs =
+            slackUs == EX_USER_TIMER_SLACK_DEFAULT ? KE_TIMER_SLACK_DEFAULT : slackUs * EX_USER_TIMER_SLACK_NS_PER_US;
+        status = KeThreadSetTimerSlack(KeGetCurrentThread(), slackNs);
+    }
+
+    if (status != EC_SUCCESS)
+    {
+        KTHREAD *thread = KeGetCurrentThread();
+        klog(KLOG_LEVEL_WARNING, EX_USER_REGRESSION_LOG_TIMER_SLACK_REJECTED " thread=%u slack_us=%lu status=%s (%d)\n",
+             thread ? thread->ThreadId : 0U, (unsigned long)slackUs, KrGetStatusMessage(status), status);
+        return KiEncodeSyscallStatus(status);
+    }
+
+    return 0;
+}
+
+static int64_t
+KiHandleSetLogLevel(uint64_t userSpec, uint64_t length, uint64_t reserved)
+{
+    KTHREAD *thread = KeGetCurrentThread();
+    char spec[EX_USER_LOG_LEVEL_SPEC_MAX_LENGTH];
+    uint32_t updated = 0;
+    HO_STATUS status = EC_ILLEGAL_ARGUMENT;
+
+    if (userSpec != 0 && length != 0 && length <= sizeof(spec) && reserved == 0)
+    {
+        status = KeUserModeCopyInBytes(spec, (HO_VIRTUAL_ADDRESS)userSpec, length);
+        if (status == EC_SUCCESS)
+            status = KLogApplyLevelSpec(spec, (uint32_t)length, &updated);
+    }
+
+    if (status != EC_SUCCESS)
+    {
+        klog(KLOG_LEVEL_WARNING,
+             EX_USER_REGRESSION_LOG_SET_LOG_LEVEL_REJECTED " thread=%u len=%lu updated=%u status=%s (%d)\n",
+             thread ? thread->ThreadId : 0U, (unsigned long)length, updated, KrGetStatusMessage(status), status);
+        return KiEncodeSyscallStatus(status);
+    }
+
+    klog(KLOG_LEVEL_INFO, EX_USER_REGRESSION_LOG_SET_LOG_LEVEL_SUCCEEDED " thread=%u updated=%u\n",
+         thread ? thread->ThreadId : 0U, updated);
+    return (int64_t)updated;
+}
+
 static HO_STATUS
 KiDispatchFormalSyscall(const EX_SYSCALL_ARGUMENTS *args, EX_SYSCALL_DISPATCH_RESULT *result)
 {
@@ -507,6 +663,24 @@ KiDispatchFormalSyscall(const EX_SYSCALL_ARGUMENTS *args, EX_SYSCALL_DISPATCH_RE
     case EX_USER_SYS_KILL_PID:
         KiSetReturnResult(result, KiHandleKillPid(args->Arg0, args->Arg1, args->Arg2));
         return EC_SUCCESS;
+    case EX_USER_SYS_FUTEX_WAIT:
+        KiSetReturnResult(result, KiHandleFutexWait(args->Arg0, args->Arg1, args->Arg2));
+        return EC_SUCCESS;
+    case EX_USER_SYS_FUTEX_WAKE:
+        KiSetReturnResult(result, KiHandleFutexWake(args->Arg0, args->Arg1, args->Arg2));
+        return EC_SUCCESS;
+    case EX_USER_SYS_SET_DEADLINE:
+        KiSetReturnResult(result, KiHandleSetDeadline(args->Arg0, args->Arg1, args->Arg2));
+        return EC_SUCCESS;
+    case EX_USER_SYS_WAIT_PERIOD:
+        KiSetReturnResult(result, KiHandleWaitPeriod(args->Arg0, args->Arg1, args->Arg2));
+        return EC_SUCCESS;
+    case EX_USER_SYS_SET_TIMER_SLACK:
+        KiSetReturnResult(result, KiHandleSetTimerSlack(args->Arg0, args->Arg1, args->Arg2));
+        return EC_SUCCESS;
+    case EX_USER_SYS_SET_LOG_LEVEL:
+        KiSetReturnResult(result, KiHandleSetLogLevel(args->Arg0, args->Arg1, args->Arg2));
+        return EC_SUCCESS;
     default:
         KiSetReturnResult(result, KiDispatchCapabilitySyscall(args->Number, args->Arg0, args->Arg1, args->Arg2));
         return EC_SUCCESS;
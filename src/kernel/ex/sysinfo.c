@@ -8,6 +8,8 @@
 
 #include "runtime_internal.h"
 
+#include <kernel/ex/futex.h>
+#include <kernel/ex/program.h>
 #include <kernel/ex/user_regression_anchors.h>
 #include <kernel/ke/kthread.h>
 #include <kernel/ke/mm.h>
@@ -897,7 +899,8 @@ ExRuntimeHandleQuerySysinfo(EX_PROCESS *process, uint64_t infoClassRaw, uint64_t
     if (infoClassRaw != EX_SYSINFO_CLASS_OVERVIEW && infoClassRaw != EX_SYSINFO_CLASS_OVERVIEW_TEXT &&
         infoClassRaw != EX_SYSINFO_CLASS_THREAD_LIST && infoClassRaw != EX_SYSINFO_CLASS_THREAD_LIST_TEXT &&
         infoClassRaw != EX_SYSINFO_CLASS_MEMMAP_TEXT && infoClassRaw != EX_SYSINFO_CLASS_PROCESS_LIST &&
-        infoClassRaw != EX_SYSINFO_CLASS_PROCESS_LIST_TEXT)
+        infoClassRaw != EX_SYSINFO_CLASS_PROCESS_LIST_TEXT && infoClassRaw != EX_SYSINFO_CLASS_SPAWN_STATS &&
+        infoClassRaw != EX_SYSINFO_CLASS_FUTEX_STATS && infoClassRaw != EX_SYSINFO_CLASS_LOG_LEVELS_TEXT)
     {
         return KiRejectQuerySysinfo(infoClassRaw, userBuffer, length, EC_ILLEGAL_ARGUMENT);
     }
@@ -952,6 +955,52 @@ ExRuntimeHandleQuerySysinfo(EX_PROCESS *process, uint64_t infoClassRaw, uint64_t
         }
     }
 
+    if (infoClassRaw == EX_SYSINFO_CLASS_SPAWN_STATS)
+    {
+        EX_SYSINFO_SPAWN_STATS spawnStats = {0};
+
+        status = ExQuerySpawnStats(&spawnStats);
+        if (status != EC_SUCCESS)
+            return KiRejectQuerySysinfo(infoClassRaw, userBuffer, length, status);
+
+        if (length < sizeof(spawnStats))
+            return KiRejectQuerySysinfo(infoClassRaw, userBuffer, length, EC_NOT_ENOUGH_MEMORY);
+
+        status = KeUserModeCopyOutBytes((HO_VIRTUAL_ADDRESS)userBuffer, &spawnStats, sizeof(spawnStats));
+        if (status != EC_SUCCESS)
+            return KiRejectQuerySysinfo(infoClassRaw, userBuffer, length, status);
+
+        klog(KLOG_LEVEL_INFO,
+             EX_USER_REGRESSION_LOG_QUERY_SYSINFO_SUCCEEDED " class=%lu bytes=%lu thread=%u spawned=%lu\n",
+             (unsigned long)infoClassRaw, (unsigned long)sizeof(spawnStats), thread ? thread->ThreadId : 0U,
+             (unsigned long)spawnStats.CompletedCount);
+
+        return (int64_t)sizeof(spawnStats);
+    }
+
+    if (infoClassRaw == EX_SYSINFO_CLASS_FUTEX_STATS)
+    {
+        EX_SYSINFO_FUTEX_STATS futexStats = {0};
+
+        status = ExQueryFutexStats(&futexStats);
+        if (status != EC_SUCCESS)
+            return KiRejectQuerySysinfo(infoClassRaw, userBuffer, length, status);
+
+        if (length < sizeof(futexStats))
+            return KiRejectQuerySysinfo(infoClassRaw, userBuffer, length, EC_NOT_ENOUGH_MEMORY);
+
+        status = KeUserModeCopyOutBytes((HO_VIRTUAL_ADDRESS)userBuffer, &futexStats, sizeof(futexStats));
+        if (status != EC_SUCCESS)
+            return KiRejectQuerySysinfo(infoClassRaw, userBuffer, length, status);
+
+        klog(KLOG_LEVEL_INFO,
+             EX_USER_REGRESSION_LOG_QUERY_SYSINFO_SUCCEEDED " class=%lu bytes=%lu thread=%u waits=%lu wakes=%lu\n",
+             (unsigned long)infoClassRaw, (unsigned long)sizeof(futexStats), thread ? thread->ThreadId : 0U,
+             (unsigned long)futexStats.WaitCount, (unsigned long)futexStats.WakeCount);
+
+        return (int64_t)sizeof(futexStats);
+    }
+
     if (infoClassRaw == EX_SYSINFO_CLASS_MEMMAP_TEXT)
     {
         char text[EX_SYSINFO_TEXT_MAX_LENGTH];
@@ -974,6 +1023,24 @@ ExRuntimeHandleQuerySysinfo(EX_PROCESS *process, uint64_t infoClassRaw, uint64_t
         return (int64_t)textLength;
     }
 
+    if (infoClassRaw == EX_SYSINFO_CLASS_LOG_LEVELS_TEXT)
+    {
+        char text[EX_SYSINFO_TEXT_MAX_LENGTH];
+        size_t textLength = KLogFormatCategoryLevels(text, sizeof(text));
+
+        if (length < textLength)
+            return KiRejectQuerySysinfo(infoClassRaw, userBuffer, length, EC_NOT_ENOUGH_MEMORY);
+
+        status = KeUserModeCopyOutBytes((HO_VIRTUAL_ADDRESS)userBuffer, text, textLength);
+        if (status != EC_SUCCESS)
+            return KiRejectQuerySysinfo(infoClassRaw, userBuffer, length, status);
+
+        klog(KLOG_LEVEL_INFO, EX_USER_REGRESSION_LOG_QUERY_SYSINFO_SUCCEEDED " class=%lu bytes=%lu thread=%u\n",
+             (unsigned long)infoClassRaw, (unsigned long)textLength, thread ? thread->ThreadId : 0U);
+
+        return (int64_t)textLength;
+    }
+
     if (infoClassRaw == EX_SYSINFO_CLASS_PROCESS_LIST || infoClassRaw == EX_SYSINFO_CLASS_PROCESS_LIST_TEXT)
     {
         EX_SYSINFO_PROCESS_LIST processList = {0};
@@ -235,13 +235,17 @@ ExRuntimeTeardownThread(EX_THREAD *thread)
 
     process = ExRuntimeLookupProcessByKernelThread(thread->Thread);
 
+    // Unpublish before touching anything else: if the table cannot be taken without
+    // waiting (idle spawning before the reaper exists), nothing has changed yet.
+    HO_STATUS unpublishStatus = ExRuntimeUnpublishByKernelThread(thread->Thread, NULL, NULL);
+    if (unpublishStatus != EC_SUCCESS)
+        return unpublishStatus;
+
     HO_STATUS firstError = ExRuntimeTeardownProcessPayload(process);
 
     if (process != NULL)
         process->State = EX_PROCESS_STATE_TERMINATED;
 
-    ExRuntimeUnpublishByKernelThread(thread->Thread, NULL, NULL);
-
     HO_STATUS threadStatus = ExRuntimeDestroyNewKernelThread(thread->Thread);
     if (firstError == EC_SUCCESS)
         firstError = threadStatus;
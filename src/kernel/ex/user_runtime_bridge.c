@@ -61,6 +61,7 @@ ExUserRuntimeEnterHook(KTHREAD *thread)
         HO_KPANIC(EC_INVALID_STATE, "User-runtime enter: dispatch root not installed");
     }
 
+    ExRuntimeRecordFirstUserEntry(process);
     KeUserModeEnterCurrentThread();
 }
 
@@ -222,7 +223,9 @@ KiDestroyUserRuntimeWrapperObjects(KTHREAD *thread)
     EX_PROCESS *process = NULL;
     HO_STATUS status = EC_SUCCESS;
 
-    ExRuntimeUnpublishThreadByKernelThread(thread, &exThread, &process);
+    status = ExRuntimeUnpublishThreadByKernelThread(thread, &exThread, &process);
+    if (status != EC_SUCCESS)
+        return status;
 
     if (exThread != NULL && process == NULL)
         process = exThread->Process;
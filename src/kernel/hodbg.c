@@ -378,6 +378,10 @@ ShowKernelPanicInfo(HO_STATUS code, HO_PANIC_CONTEXT *ctx)
 HO_PUBLIC_API HO_NORETURN void
 KernelHalt(int64_t ec, void *dump)
 {
+    // Print what the klog ring still holds, then write the stop screen straight through.
+    // Serial goes back to polling first so nothing waits on a THRE interrupt.
+    ConsoleEnterPanicMode();
+    KLogEnterPanicMode();
     ConsoleFlush();
     ConsoleClearScreen(COLOR_BLUE);
 
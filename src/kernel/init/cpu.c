@@ -26,4 +26,7 @@ InitCpuState(STAGING_BLOCK *block)
 
     data->Tss = tss;
     LoadGdtAndTss(data);
+
+    // Without a PAT the framebuffer simply stays uncached.
+    (void)InitPat();
 }
@@ -3,6 +3,8 @@
 #include <kernel/ex/ex_runtime.h>
 #include <kernel/ke/input.h>
 #include <kernel/ke/sysinfo.h>
+#include <kernel/ke/work_queue.h>
+#include <libc/hostdlib.h>
 
 //
 // Global kernel variables that need to be initialized at startup
@@ -487,6 +489,42 @@ RunSchedulerObservabilitySelfTest(void)
     return EC_SUCCESS;
 }
 
+// Apply the "klog=" boot option, if any, before the first category registers.
+static void
+KiApplyBootLogLevels(const BOOT_CAPSULE *block)
+{
+    static const char key[] = "klog=";
+    const char *options = block->BootOptions;
+    uint32_t length = 0;
+
+    while (length < BOOT_OPTIONS_MAX && options[length] != '\0')
+        length++;
+
+    for (uint32_t start = 0; start < length;)
+    {
+        uint32_t end = start;
+        while (end < length && options[end] != ' ')
+            end++;
+
+        if (end - start > sizeof(key) - 1U && memcmp(options + start, key, sizeof(key) - 1U) == 0)
+        {
+            const char *spec = options + start + sizeof(key) - 1U;
+            uint32_t specLength = end - start - (uint32_t)(sizeof(key) - 1U);
+            uint32_t updated = 0;
+            HO_STATUS status = KLogApplyLevelSpec(spec, specLength, &updated);
+            if (status != EC_SUCCESS)
+            {
+                klog(KLOG_LEVEL_WARNING, "[BOOT] ignored klog= boot option: %ke\n", status);
+            }
+            else
+            {
+                klog(KLOG_LEVEL_INFO, "[BOOT] klog= boot option set %u categories\n", updated);
+            }
+        }
+        start = end + 1U;
+    }
+}
+
 void
 InitKernel(MAYBE_UNUSED STAGING_BLOCK *block)
 {
@@ -496,6 +534,7 @@ InitKernel(MAYBE_UNUSED STAGING_BLOCK *block)
     VdInit(&gVideoDriver, block);
     VdClearScreen(&gVideoDriver, HO_CONSOLE_DEFAULT_BACKGROUND);
     ConsoleInit(&gVideoDriver, &gSystemFont);
+    KiApplyBootLogLevels(block);
 
     HO_STATUS initStatus;
     initStatus = IdtInit();
@@ -510,6 +549,11 @@ InitKernel(MAYBE_UNUSED STAGING_BLOCK *block)
     AssertRsdp(HHDM_PHYS2VIRT(block->AcpiRsdpPhys));
     GetBasicCpuInfo(&gBasicCpuInfo);
 
+    uint32_t memFeatures = MemQueryFeatures(NULL);
+    klog(KLOG_LEVEL_INFO, "[LIBC] memcpy/memset strategies: erms=%u fsrm=%u nontemporal=%u\n",
+         (memFeatures & MEM_FEATURE_ERMS) != 0, (memFeatures & MEM_FEATURE_FSRM) != 0,
+         (memFeatures & MEM_FEATURE_NONTEMPORAL) != 0);
+
     // ---- Physical Memory Manager ----
     initStatus = KePmmInitFromBootMemoryMap(block);
     if (initStatus != EC_SUCCESS)
@@ -578,6 +622,27 @@ InitKernel(MAYBE_UNUSED STAGING_BLOCK *block)
         HO_KPANIC(initStatus, "Failed to promote console mux storage onto allocator layer");
     }
 
+    // Scanout writes go through a write-combining alias of video memory when the PAT allows it.
+    initStatus = VdMapScanoutWriteCombining(&gVideoDriver);
+    if (initStatus != EC_SUCCESS)
+    {
+        klog(KLOG_LEVEL_WARNING, "[VIDEO] write-combining framebuffer unavailable: %ke\n", initStatus);
+    }
+
+    // Render the console into RAM from here on; without a shadow it keeps drawing to video memory.
+    initStatus = ConsoleEnableShadowBuffer();
+    if (initStatus != EC_SUCCESS)
+    {
+        klog(KLOG_LEVEL_WARNING, "[CONSOLE] framebuffer shadow unavailable: %ke\n", initStatus);
+    }
+
+    // Scroll through the character grid instead of moving framebuffer pixels.
+    initStatus = ConsoleSetCellGrid(TRUE);
+    if (initStatus != EC_SUCCESS)
+    {
+        klog(KLOG_LEVEL_WARNING, "[CONSOLE] cell grid unavailable: %ke\n", initStatus);
+    }
+
     // Smoke test: single page alloc/write/read/free
     {
         HO_PHYSICAL_ADDRESS testPage;
@@ -629,6 +694,12 @@ InitKernel(MAYBE_UNUSED STAGING_BLOCK *block)
         HO_KPANIC(initStatus, "Failed to initialize time source");
     }
 
+    initStatus = KeTimeSourceSelfTest();
+    if (initStatus != EC_SUCCESS)
+    {
+        HO_KPANIC(initStatus, "Time conversion self-test failed");
+    }
+
     initStatus = KeClockEventInit();
     if (initStatus != EC_SUCCESS)
     {
@@ -663,6 +734,37 @@ InitKernel(MAYBE_UNUSED STAGING_BLOCK *block)
         HO_KPANIC(initStatus, "Scheduler observability self-test failed");
     }
 
+    // ---- Reaper and kernel work queue ----
+    // Both are ordinary KTHREADs; start them only after the scheduler
+    // self-test has checked the single-idle-thread baseline.
+    initStatus = KeReaperInit();
+    if (initStatus != EC_SUCCESS)
+    {
+        HO_KPANIC(initStatus, "Failed to start reaper thread");
+    }
+
+    initStatus = KeWorkQueueInit();
+    if (initStatus != EC_SUCCESS)
+    {
+        HO_KPANIC(initStatus, "Failed to initialize kernel work queue");
+    }
+
+    // ---- Asynchronous klog ----
+    // Lines logged up to here were drained synchronously by their producers.
+    initStatus = KLogStartDrainThread();
+    if (initStatus != EC_SUCCESS)
+    {
+        HO_KPANIC(initStatus, "Failed to start klog drain thread");
+    }
+
+    // ---- Console sink queues ----
+    // Each mux sink is drained by its own thread from here on.
+    initStatus = ConsoleStartSinkQueues();
+    if (initStatus != EC_SUCCESS && initStatus != EC_NOT_SUPPORTED)
+    {
+        klog(KLOG_LEVEL_WARNING, "[CONSOLE] sink queues unavailable: %ke\n", initStatus);
+    }
+
     initStatus = ExRuntimeInit();
     if (initStatus != EC_SUCCESS)
     {
@@ -674,6 +776,13 @@ InitKernel(MAYBE_UNUSED STAGING_BLOCK *block)
     {
         HO_KPANIC(initStatus, "Failed to initialize runtime keyboard input");
     }
+
+    // The 8259 is remapped now, so COM1 IRQ4 can carry console output.
+    initStatus = ConsoleSetSerialTxMode(TRUE);
+    if (initStatus != EC_SUCCESS && initStatus != EC_NOT_SUPPORTED)
+    {
+        klog(KLOG_LEVEL_WARNING, "[CONSOLE] interrupt-driven serial TX unavailable: %ke\n", initStatus);
+    }
 }
 
 HO_KERNEL_API BOOT_CAPSULE *
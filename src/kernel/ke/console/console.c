@@ -1,5 +1,10 @@
 #include <kernel/ke/console.h>
+#include <arch/amd64/idt.h>
 #include <kernel/ke/critical_section.h>
+#include <kernel/ke/dpc.h>
+#include <kernel/ke/event.h>
+#include <kernel/ke/scheduler.h>
+#include <kernel/ke/timer.h>
 #include <string.h>
 #include <stdarg.h>
 #include <kernel/hodbg.h>
@@ -11,6 +16,12 @@
 
 #define MAX_FORMAT_BUFFER 64
 
+// COM1 IRQ4 behind the 8259, which the PS/2 driver remaps to 0x20.
+#define CONSOLE_SERIAL_IRQ_VECTOR (0x20U + COM1_IRQ_LINE)
+
+#define CONSOLE_SINK_QUEUE_CAPACITY 1024U // Operations per mux lane; a power of two
+#define CONSOLE_SINK_DRAIN_BATCH    64U   // Operations a drain thread applies per critical section
+
 //
 // Global Variables
 //
@@ -20,23 +31,178 @@ static GFX_CONSOLE_SINK gGfxConsoleSink;
 #if __HO_DEBUG_BUILD__
 static SERIAL_CONSOLE_SINK gSerialConsoleSink;
 static MUX_CONSOLE_SINK gMuxConsoleSink;
+static BOOL gSerialIrqRouted = FALSE;
+
+// Drain context of one mux lane. Writers may be interrupts, so the lane's notify
+// only queues WakeDpc, which raises WakeEvent for the thread.
+typedef struct CONSOLE_SINK_DRAIN
+{
+    uint32_t Lane;
+    KEVENT WakeEvent;
+    KDPC WakeDpc;
+    KTHREAD *Thread;
+} CONSOLE_SINK_DRAIN;
+
+static CONSOLE_SINK_DRAIN gConsoleSinkDrains[CONSOLE_SINK_COUNT];
+static const CONSOLE_SINK_QUEUE_POLICY gConsoleSinkDefaultPolicies[CONSOLE_SINK_COUNT] = {
+    CONSOLE_SINK_QUEUE_COALESCE, // Framebuffer: only the latest picture has to reach the screen
+    CONSOLE_SINK_QUEUE_BLOCK,    // Serial: the regression log must not lose a byte
+};
 #endif
 static BOOL gConsoleInitialized = FALSE;
 
+// Framebuffer flush policy. The periodic flush runs from the timer DPC: console
+// calls hold a critical section, so it never lands in the middle of one.
+static CONSOLE_FLUSH_POLICY gConsoleFlushPolicy = CONSOLE_FLUSH_IMMEDIATE;
+static uint64_t gConsoleFlushPeriodNs;
+static BOOL gConsoleNewlinePending;
+static KTIMER gConsoleFlushTimer;
+static KDPC gConsoleFlushDpc;
+static BOOL gConsoleFlushTimerReady;
+
+// Caller holds the console critical section. Anything that reaches below the mux
+// to a sink applies the sink's queued operations first.
+static inline void
+ConsoleSyncSinkUnlocked(CONSOLE_SINK_ID sink)
+{
+#if __HO_DEBUG_BUILD__
+    KeMuxConSinkSyncLane(&gMuxConsoleSink, (uint32_t)sink);
+#else
+    (void)sink;
+#endif
+}
+
 static inline int
 ConsoleWriteCharUnlocked(char c)
 {
+    if (c == '\n')
+        gConsoleNewlinePending = TRUE;
     return KeConDevPutChar(&gConsoleDevice, c);
 }
 
 static inline uint64_t
 ConsoleWriteUnlocked(const char *str)
 {
+    if (gConsoleFlushPolicy == CONSOLE_FLUSH_ON_NEWLINE)
+    {
+        for (const char *p = str; *p; ++p)
+        {
+            if (*p == '\n')
+            {
+                gConsoleNewlinePending = TRUE;
+                break;
+            }
+        }
+    }
     return KeConDevPutStr(&gConsoleDevice, str);
 }
 
+// Repaint the grid rows that scrolled or were erased, then push the shadow out.
+// Deferring the repaint to here is what makes a burst of scrolls cost one redraw.
+static void
+ConsoleFlushFramebufferUnlocked(void)
+{
+    KE_CONSOLE_SINK *sink = gConsoleDevice.Sink;
+    KeConDevPresent(&gConsoleDevice);
+    if (sink->Flush != NULL)
+        (void)sink->Flush(sink);
+    gConsoleNewlinePending = FALSE;
+}
+
+// Caller holds the console critical section. Flushes when the policy says this
+// call ends a visible unit of output.
+static void
+ConsolePresentUnlocked(void)
+{
+    if (gConsoleFlushPolicy == CONSOLE_FLUSH_IMMEDIATE ||
+        (gConsoleFlushPolicy == CONSOLE_FLUSH_ON_NEWLINE && gConsoleNewlinePending))
+    {
+        ConsoleFlushFramebufferUnlocked();
+    }
+}
+
+static void
+ConsoleFlushDpcRoutine(KDPC *dpc, void *context)
+{
+    (void)dpc;
+    (void)context;
+
+    if (gConsoleFlushPolicy == CONSOLE_FLUSH_PERIODIC)
+        ConsoleFlushFramebufferUnlocked();
+}
+
+// Formatting target: NULL writes to the console device, otherwise output is
+// collected into a caller buffer and silently truncated at its capacity.
+typedef struct CONSOLE_FMT_TARGET
+{
+    char *Buffer;
+    uint64_t Capacity;
+    uint64_t Length;
+} CONSOLE_FMT_TARGET;
+
+static inline int
+ConsoleFmtPutChar(CONSOLE_FMT_TARGET *target, char c)
+{
+    if (target == NULL)
+        return ConsoleWriteCharUnlocked(c);
+
+    if (target->Length + 1 < target->Capacity)
+        target->Buffer[target->Length++] = c;
+    return 0;
+}
+
 static uint64_t
-ConsoleWriteVFmtInternal(const char *fmt, VA_LIST args)
+ConsoleFmtPutStr(CONSOLE_FMT_TARGET *target, const char *str)
+{
+    if (target == NULL)
+        return ConsoleWriteUnlocked(str);
+
+    uint64_t length = 0;
+    for (; str[length] != '\0'; ++length)
+        (void)ConsoleFmtPutChar(target, str[length]);
+    return length;
+}
+
+// A run of known length: one copy into a buffer target instead of a call per character.
+static uint64_t
+ConsoleFmtPutBytes(CONSOLE_FMT_TARGET *target, const char *bytes, uint64_t length)
+{
+    if (target == NULL)
+    {
+        for (uint64_t index = 0; index < length; ++index)
+            (void)ConsoleWriteCharUnlocked(bytes[index]);
+        return length;
+    }
+
+    uint64_t room = target->Capacity - 1 - target->Length;
+    uint64_t copied = length < room ? length : room;
+    memcpy(target->Buffer + target->Length, bytes, copied);
+    target->Length += copied;
+    return length;
+}
+
+// Emit one integer conversion with its padding; buf holds MAX_FORMAT_BUFFER characters.
+static uint64_t
+ConsoleFmtPutInteger(CONSOLE_FMT_TARGET *target, char *buf, uint64_t value, BOOL isSigned, int base, uint32_t width,
+                     char pc, BOOL leftAlign)
+{
+    // Left alignment pads with spaces after the digits, so the digits are converted unpadded.
+    int32_t padding = leftAlign ? 0 : (int32_t)width;
+    char padChar = leftAlign ? 0 : pc;
+    uint64_t length = isSigned ? Int64ToStringEx((int64_t)value, buf, padding, padChar)
+                               : UInt64ToStringEx(value, buf, base, padding, padChar);
+
+    uint64_t written = ConsoleFmtPutBytes(target, buf, length);
+    for (; leftAlign && length < width; ++length)
+    {
+        (void)ConsoleFmtPutChar(target, ' ');
+        written++;
+    }
+    return written;
+}
+
+static uint64_t
+ConsoleWriteVFmtInternal(CONSOLE_FMT_TARGET *target, const char *fmt, VA_LIST args)
 {
     char buf[MAX_FORMAT_BUFFER];
     uint64_t written = 0;
@@ -46,8 +212,11 @@ ConsoleWriteVFmtInternal(const char *fmt, VA_LIST args)
     {
         if (*p != '%')
         {
-            (void)ConsoleWriteCharUnlocked(*p);
-            written++;
+            // Literal text goes out as one run up to the next conversion.
+            const char *run = p;
+            while (p[1] != '\0' && p[1] != '%')
+                ++p;
+            written += ConsoleFmtPutBytes(target, run, (uint64_t)(p - run) + 1);
             continue;
         }
 
@@ -55,7 +224,7 @@ ConsoleWriteVFmtInternal(const char *fmt, VA_LIST args)
 
         if (*p == '%')
         {
-            (void)ConsoleWriteCharUnlocked(*p);
+            (void)ConsoleFmtPutChar(target, *p);
             written++;
             ++p;
             continue;
@@ -99,7 +268,7 @@ ConsoleWriteVFmtInternal(const char *fmt, VA_LIST args)
         {
         case 'c': {
             char c = (char)VA_ARG(args, int);
-            (void)ConsoleWriteCharUnlocked(c);
+            (void)ConsoleFmtPutChar(target, c);
             written++;
             break;
         }
@@ -113,16 +282,16 @@ ConsoleWriteVFmtInternal(const char *fmt, VA_LIST args)
             {
                 for (uint32_t i = 0; i < padLen; ++i)
                 {
-                    (void)ConsoleWriteCharUnlocked(pc);
+                    (void)ConsoleFmtPutChar(target, pc);
                     written++;
                 }
             }
-            written += ConsoleWriteUnlocked(s);
+            written += ConsoleFmtPutBytes(target, s, len);
             if (leftAlign && padLen > 0)
             {
                 for (uint32_t i = 0; i < padLen; ++i)
                 {
-                    (void)ConsoleWriteCharUnlocked(' ');
+                    (void)ConsoleFmtPutChar(target, ' ');
                     written++;
                 }
             }
@@ -131,85 +300,27 @@ ConsoleWriteVFmtInternal(const char *fmt, VA_LIST args)
         case 'd':
         case 'i': {
             int64_t val = VA_ARG(args, int);
-            uint64_t numLen;
-            if (leftAlign)
-            {
-                numLen = Int64ToStringEx(val, buf, 0, 0);
-                written += ConsoleWriteUnlocked(buf);
-                for (uint32_t i = numLen; i < width; ++i)
-                {
-                    (void)ConsoleWriteCharUnlocked(' ');
-                    written++;
-                }
-            }
-            else
-            {
-                (void)Int64ToStringEx(val, buf, width, pc);
-                written += ConsoleWriteUnlocked(buf);
-            }
+            written += ConsoleFmtPutInteger(target, buf, (uint64_t)val, TRUE, 10, width, pc, leftAlign);
             break;
         }
         case 'l': {
-            uint64_t numLen;
             if (*(p + 1) == 'd' || *(p + 1) == 'i') // long decimal
             {
                 ++p;
                 int64_t val = VA_ARG(args, long);
-                if (leftAlign)
-                {
-                    numLen = Int64ToStringEx(val, buf, 0, 0);
-                    written += ConsoleWriteUnlocked(buf);
-                    for (uint32_t i = numLen; i < width; ++i)
-                    {
-                        (void)ConsoleWriteCharUnlocked(' ');
-                        written++;
-                    }
-                }
-                else
-                {
-                    (void)Int64ToStringEx(val, buf, width, pc);
-                    written += ConsoleWriteUnlocked(buf);
-                }
+                written += ConsoleFmtPutInteger(target, buf, (uint64_t)val, TRUE, 10, width, pc, leftAlign);
             }
             else if (*(p + 1) == 'u') // long unsigned
             {
                 ++p;
                 uint64_t val = VA_ARG(args, unsigned long);
-                if (leftAlign)
-                {
-                    numLen = UInt64ToStringEx(val, buf, 10, 0, 0);
-                    written += ConsoleWriteUnlocked(buf);
-                    for (uint32_t i = numLen; i < width; ++i)
-                    {
-                        (void)ConsoleWriteCharUnlocked(' ');
-                        written++;
-                    }
-                }
-                else
-                {
-                    (void)UInt64ToStringEx(val, buf, 10, width, pc);
-                    written += ConsoleWriteUnlocked(buf);
-                }
+                written += ConsoleFmtPutInteger(target, buf, val, FALSE, 10, width, pc, leftAlign);
             }
             else if (*(p + 1) == 'x' || *(p + 1) == 'X') // long hex
             {
                 ++p;
                 uint64_t val = VA_ARG(args, unsigned long);
-                if (leftAlign)
-                {
-                    numLen = UInt64ToStringEx(val, buf, 16, 0, 0);
-                    written += ConsoleWriteUnlocked(buf);
-                    for (uint32_t i = numLen; i < width; ++i)
-                    {
-                        (void)ConsoleWriteCharUnlocked(' ');
-                        written++;
-                    }
-                }
-                else
-                {
-                    (void)UInt64ToStringEx(val, buf, 16, width, pc);
-                    written += ConsoleWriteUnlocked(buf);
-                }
+                written += ConsoleFmtPutInteger(target, buf, val, FALSE, 16, width, pc, leftAlign);
             }
             else
             {
@@ -219,50 +330,20 @@ ConsoleWriteVFmtInternal(const char *fmt, VA_LIST args)
         }
         case 'u': {
             uint64_t val = VA_ARG(args, unsigned int);
-            uint64_t numLen;
-            if (leftAlign)
-            {
-                numLen = UInt64ToStringEx(val, buf, 10, 0, 0);
-                written += ConsoleWriteUnlocked(buf);
-                for (uint32_t i = numLen; i < width; ++i)
-                {
-                    (void)ConsoleWriteCharUnlocked(' ');
-                    written++;
-                }
-            }
-            else
-            {
-                (void)UInt64ToStringEx(val, buf, 10, width, pc);
-                written += ConsoleWriteUnlocked(buf);
-            }
+            written += ConsoleFmtPutInteger(target, buf, val, FALSE, 10, width, pc, leftAlign);
             break;
         }
         case 'x':
         case 'X': {
             uint64_t val = VA_ARG(args, uint64_t);
-            uint64_t numLen;
-            if (leftAlign)
-            {
-                numLen = UInt64ToStringEx(val, buf, 16, 0, 0);
-                written += ConsoleWriteUnlocked(buf);
-                for (uint32_t i = numLen; i < width; ++i)
-                {
-                    (void)ConsoleWriteCharUnlocked(' ');
-                    written++;
-                }
-            }
-            else
-            {
-                (void)UInt64ToStringEx(val, buf, 16, width, pc);
-                written += ConsoleWriteUnlocked(buf);
-            }
+            written += ConsoleFmtPutInteger(target, buf, val, FALSE, 16, width, pc, leftAlign);
             break;
         }
         case 'p': {
             uint64_t val = (uint64_t)VA_ARG(args, void *);
-            written += ConsoleWriteUnlocked("0X");
+            written += ConsoleFmtPutStr(target, "0X");
             (void)UInt64ToString(val, buf, 16, TRUE);
-            written += ConsoleWriteUnlocked(buf);
+            written += ConsoleFmtPutStr(target, buf);
             break;
         }
         // HimuOS kernel specific placeholders
@@ -272,14 +353,14 @@ ConsoleWriteVFmtInternal(const char *fmt, VA_LIST args)
                 ++p;
                 HO_STATUS val = VA_ARG(args, HO_STATUS);
                 const char *msg = KrGetStatusMessage(val);
-                written += ConsoleWriteUnlocked(msg);
+                written += ConsoleFmtPutStr(target, msg);
             }
             else if (*(p + 1) == 's') // error codes status (FAIL or SUCCESS)
             {
                 ++p;
                 HO_STATUS val = VA_ARG(args, HO_STATUS);
                 const char *msg = HO_LIKELY(!val) ? "OK" : "FAILED";
-                written += ConsoleWriteUnlocked(msg);
+                written += ConsoleFmtPutStr(target, msg);
             }
             else
             {
@@ -346,6 +427,7 @@ ConsoleWriteChar(char c)
     KE_CRITICAL_SECTION criticalSection = {0};
     KeEnterCriticalSection(&criticalSection);
     int status = ConsoleWriteCharUnlocked(c);
+    ConsolePresentUnlocked();
     KeLeaveCriticalSection(&criticalSection);
     return status;
 }
@@ -359,6 +441,7 @@ ConsoleWrite(const char *str)
     KE_CRITICAL_SECTION criticalSection = {0};
     KeEnterCriticalSection(&criticalSection);
     uint64_t written = ConsoleWriteUnlocked(str);
+    ConsolePresentUnlocked();
     KeLeaveCriticalSection(&criticalSection);
     return written;
 }
@@ -374,8 +457,9 @@ ConsoleWriteFmt(const char *fmt, ...)
 
     VA_LIST args;
     VA_START(args, fmt);
-    uint64_t written = ConsoleWriteVFmtInternal(fmt, args);
+    uint64_t written = ConsoleWriteVFmtInternal(NULL, fmt, args);
     VA_END(args);
+    ConsolePresentUnlocked();
 
     KeLeaveCriticalSection(&criticalSection);
     return written;
@@ -389,11 +473,25 @@ ConsoleWriteVFmt(const char *fmt, VA_LIST args)
 
     KE_CRITICAL_SECTION criticalSection = {0};
     KeEnterCriticalSection(&criticalSection);
-    uint64_t written = ConsoleWriteVFmtInternal(fmt, args);
+    uint64_t written = ConsoleWriteVFmtInternal(NULL, fmt, args);
+    ConsolePresentUnlocked();
     KeLeaveCriticalSection(&criticalSection);
     return written;
 }
 
+HO_PUBLIC_API uint64_t
+ConsoleFormatVFmt(char *buffer, uint64_t capacity, const char *fmt, VA_LIST args)
+{
+    if (buffer == NULL || capacity == 0)
+        return 0;
+
+    // No console state is touched, so no critical section and no init check.
+    CONSOLE_FMT_TARGET target = {.Buffer = buffer, .Capacity = capacity, .Length = 0};
+    uint64_t length = ConsoleWriteVFmtInternal(&target, fmt, args);
+    buffer[target.Length] = '\0';
+    return length;
+}
+
 HO_PUBLIC_API void
 ConsoleClearScreen(COLOR32 color)
 {
@@ -403,6 +501,7 @@ ConsoleClearScreen(COLOR32 color)
     KE_CRITICAL_SECTION criticalSection = {0};
     KeEnterCriticalSection(&criticalSection);
     KeConDevClearScreen(&gConsoleDevice, color);
+    ConsolePresentUnlocked();
     KeLeaveCriticalSection(&criticalSection);
 }
 
@@ -414,8 +513,376 @@ ConsoleFlush(void)
 
     KE_CRITICAL_SECTION criticalSection = {0};
     KeEnterCriticalSection(&criticalSection);
+    ConsoleFlushFramebufferUnlocked();
 #if __HO_DEBUG_BUILD__
+    // An explicit flush waits for every sink queue.
+    KeMuxConSinkSyncAll(&gMuxConsoleSink);
     KeSerialConSinkFlushPendingCursor(&gSerialConsoleSink, gConsoleDevice.CursorX, gConsoleDevice.CursorY);
 #endif
     KeLeaveCriticalSection(&criticalSection);
 }
+
+HO_PUBLIC_API HO_STATUS
+ConsoleSetSerialTxMode(BOOL interruptDriven)
+{
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+#if __HO_DEBUG_BUILD__
+    if (interruptDriven && !gSerialIrqRouted)
+    {
+        HO_STATUS status = IdtRegisterInterruptHandler(CONSOLE_SERIAL_IRQ_VECTOR, KeSerialConSinkInterruptHandler,
+                                                       &gSerialConsoleSink);
+        if (status != EC_SUCCESS)
+            return status;
+        SerialUnmaskIrq(COM1_IRQ_LINE);
+        gSerialIrqRouted = TRUE;
+    }
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    KeSerialConSinkSetInterruptTx(&gSerialConsoleSink, interruptDriven);
+    KeLeaveCriticalSection(&criticalSection);
+    return EC_SUCCESS;
+#else
+    (void)interruptDriven;
+    return EC_NOT_SUPPORTED;
+#endif
+}
+
+HO_PUBLIC_API HO_STATUS
+ConsoleQuerySerialTxStats(CONSOLE_SERIAL_TX_STATS *stats)
+{
+    if (stats == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+#if __HO_DEBUG_BUILD__
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    ConsoleSyncSinkUnlocked(CONSOLE_SINK_SERIAL);
+    KeLeaveCriticalSection(&criticalSection);
+    KeSerialConSinkQueryStats(&gSerialConsoleSink, stats);
+    return EC_SUCCESS;
+#else
+    return EC_NOT_SUPPORTED;
+#endif
+}
+
+HO_PUBLIC_API uint64_t
+ConsoleWriteSerial(const char *buffer, uint64_t length)
+{
+    if (!gConsoleInitialized)
+        return 0;
+
+#if __HO_DEBUG_BUILD__
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    ConsoleSyncSinkUnlocked(CONSOLE_SINK_SERIAL);
+    uint64_t written = KeSerialConSinkWriteRaw(&gSerialConsoleSink, buffer, length);
+    KeLeaveCriticalSection(&criticalSection);
+    return written;
+#else
+    (void)buffer;
+    (void)length;
+    return 0;
+#endif
+}
+
+HO_PUBLIC_API HO_STATUS
+ConsoleSetGlyphCache(BOOL enable)
+{
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    ConsoleSyncSinkUnlocked(CONSOLE_SINK_FRAMEBUFFER);
+    HO_STATUS status = KeGfxConSinkSetGlyphCache(&gGfxConsoleSink, enable);
+    KeLeaveCriticalSection(&criticalSection);
+    return status;
+}
+
+HO_PUBLIC_API HO_STATUS
+ConsoleQueryGlyphStats(CONSOLE_GLYPH_STATS *stats)
+{
+    if (stats == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    ConsoleSyncSinkUnlocked(CONSOLE_SINK_FRAMEBUFFER);
+    KeGfxConSinkQueryStats(&gGfxConsoleSink, stats);
+    KeLeaveCriticalSection(&criticalSection);
+    return EC_SUCCESS;
+}
+
+HO_PUBLIC_API HO_STATUS
+ConsoleEnableShadowBuffer(void)
+{
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    ConsoleSyncSinkUnlocked(CONSOLE_SINK_FRAMEBUFFER);
+    HO_STATUS status = VdEnableShadowBuffer(gGfxConsoleSink.Driver);
+    KeLeaveCriticalSection(&criticalSection);
+    return status;
+}
+
+HO_PUBLIC_API HO_STATUS
+ConsoleSetFlushPolicy(CONSOLE_FLUSH_POLICY policy, uint64_t periodNs)
+{
+    if (policy > CONSOLE_FLUSH_PERIODIC || (policy == CONSOLE_FLUSH_PERIODIC && periodNs == 0))
+        return EC_ILLEGAL_ARGUMENT;
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+    if (!gConsoleFlushTimerReady)
+    {
+        KeInitializeTimer(&gConsoleFlushTimer, KTIMER_NOTIFICATION);
+        KeInitializeDpc(&gConsoleFlushDpc, ConsoleFlushDpcRoutine, NULL);
+        gConsoleFlushTimerReady = TRUE;
+    }
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    (void)KeCancelTimer(&gConsoleFlushTimer);
+    ConsoleFlushFramebufferUnlocked();
+    gConsoleFlushPolicy = policy;
+    gConsoleFlushPeriodNs = policy == CONSOLE_FLUSH_PERIODIC ? periodNs : 0;
+
+    HO_STATUS status = EC_SUCCESS;
+    if (policy == CONSOLE_FLUSH_PERIODIC)
+    {
+        status = KeSetTimer(&gConsoleFlushTimer, periodNs, periodNs, &gConsoleFlushDpc, KTIMER_FLAG_NONE);
+        if (status != EC_SUCCESS)
+            gConsoleFlushPolicy = CONSOLE_FLUSH_IMMEDIATE;
+    }
+
+    KeLeaveCriticalSection(&criticalSection);
+    return status;
+}
+
+HO_PUBLIC_API HO_STATUS
+ConsoleQueryFramebufferStats(CONSOLE_FRAMEBUFFER_STATS *stats)
+{
+    if (stats == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    ConsoleSyncSinkUnlocked(CONSOLE_SINK_FRAMEBUFFER);
+    const KE_VIDEO_DRIVER *driver = gGfxConsoleSink.Driver;
+    stats->Shadowed = driver->ShadowBuffer != NULL;
+    stats->DirtyPending = driver->DirtyLeft < driver->DirtyRight;
+    stats->Policy = gConsoleFlushPolicy;
+    stats->PeriodNs = gConsoleFlushPeriodNs;
+    stats->Shadow = driver->ShadowStats;
+    KeLeaveCriticalSection(&criticalSection);
+    return EC_SUCCESS;
+}
+
+HO_PUBLIC_API HO_STATUS
+ConsoleSetCellGrid(BOOL enable)
+{
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    // Leave nothing queued for a repaint the device will no longer do, and no
+    // queued row pointing into the grid.
+    ConsoleFlushFramebufferUnlocked();
+    ConsoleSyncSinkUnlocked(CONSOLE_SINK_FRAMEBUFFER);
+    HO_STATUS status = KeConDevEnableGrid(&gConsoleDevice, enable);
+    if (status == EC_SUCCESS)
+        KeGfxConSinkSetDeferredScroll(&gGfxConsoleSink, enable);
+    KeLeaveCriticalSection(&criticalSection);
+    return status;
+}
+
+HO_PUBLIC_API HO_STATUS
+ConsoleQueryGridStats(CONSOLE_GRID_STATS *stats)
+{
+    if (stats == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    KeConDevQueryGridStats(&gConsoleDevice, stats);
+    KeLeaveCriticalSection(&criticalSection);
+    return EC_SUCCESS;
+}
+
+#if __HO_DEBUG_BUILD__
+static void
+ConsoleSinkNotify(void *context)
+{
+    CONSOLE_SINK_DRAIN *drain = (CONSOLE_SINK_DRAIN *)context;
+    (void)KeInsertQueueDpc(&drain->WakeDpc);
+}
+
+static void
+ConsoleSinkWakeDpcRoutine(KDPC *dpc, void *context)
+{
+    (void)dpc;
+    CONSOLE_SINK_DRAIN *drain = (CONSOLE_SINK_DRAIN *)context;
+    KeSetEvent(&drain->WakeEvent);
+}
+
+static void
+ConsoleSinkDrainThread(void *arg)
+{
+    CONSOLE_SINK_DRAIN *drain = (CONSOLE_SINK_DRAIN *)arg;
+
+    for (;;)
+    {
+        HO_STATUS status = KeWaitForSingleObject(&drain->WakeEvent, KE_WAIT_INFINITE);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "console sink drain wait failed");
+        KeResetEvent(&drain->WakeEvent);
+
+        // Short batches let writers and the other lanes' threads in between.
+        uint32_t pending = 0;
+        do
+        {
+            KE_CRITICAL_SECTION criticalSection = {0};
+            KeEnterCriticalSection(&criticalSection);
+            pending = KeMuxConSinkDrainLane(&gMuxConsoleSink, drain->Lane, CONSOLE_SINK_DRAIN_BATCH);
+            KeLeaveCriticalSection(&criticalSection);
+        } while (pending != 0);
+    }
+}
+
+static HO_STATUS
+ConsoleStartSinkDrain(CONSOLE_SINK_DRAIN *drain, uint32_t lane)
+{
+    drain->Lane = lane;
+    KeInitializeEvent(&drain->WakeEvent, FALSE);
+    KeInitializeDpc(&drain->WakeDpc, ConsoleSinkWakeDpcRoutine, drain);
+
+    HO_STATUS status =
+        KeMuxConSinkSetupQueue(&gMuxConsoleSink, lane, CONSOLE_SINK_QUEUE_CAPACITY, ConsoleSinkNotify, drain);
+    if (status != EC_SUCCESS)
+        return status;
+
+    KTHREAD *thread = NULL;
+    status = KeThreadCreate(&thread, ConsoleSinkDrainThread, drain);
+    if (status != EC_SUCCESS)
+        return status;
+
+    status = KeThreadSetPriority(thread, KTHREAD_PRIORITY_LOW);
+    if (status != EC_SUCCESS)
+        return status;
+
+    // Like the klog drain, its own wait/wake trace must not keep klog writing to it.
+    thread->Flags |= KTHREAD_FLAG_LOG_QUIET;
+    drain->Thread = thread;
+    status = KeThreadStart(thread);
+    if (status != EC_SUCCESS)
+    {
+        drain->Thread = NULL;
+        return status;
+    }
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    status = KeMuxConSinkSetPolicy(&gMuxConsoleSink, lane, gConsoleSinkDefaultPolicies[lane]);
+    KeLeaveCriticalSection(&criticalSection);
+    return status;
+}
+#endif
+
+HO_PUBLIC_API HO_STATUS
+ConsoleStartSinkQueues(void)
+{
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+#if __HO_DEBUG_BUILD__
+    if (gConsoleSinkDrains[0].Thread != NULL)
+        return EC_INVALID_STATE;
+
+    for (uint32_t lane = 0; lane < CONSOLE_SINK_COUNT; ++lane)
+    {
+        HO_STATUS status = ConsoleStartSinkDrain(&gConsoleSinkDrains[lane], lane);
+        if (status != EC_SUCCESS)
+            return status;
+    }
+
+    klog(KLOG_LEVEL_INFO, "[CONSOLE] sink queues ready (framebuffer=coalesce serial=block, capacity=%u ops)\n",
+         CONSOLE_SINK_QUEUE_CAPACITY);
+    return EC_SUCCESS;
+#else
+    return EC_NOT_SUPPORTED;
+#endif
+}
+
+HO_PUBLIC_API HO_STATUS
+ConsoleSetSinkQueuePolicy(CONSOLE_SINK_ID sink, CONSOLE_SINK_QUEUE_POLICY policy)
+{
+    if ((uint32_t)sink >= CONSOLE_SINK_COUNT || (uint32_t)policy > CONSOLE_SINK_QUEUE_COALESCE)
+        return EC_ILLEGAL_ARGUMENT;
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+#if __HO_DEBUG_BUILD__
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    HO_STATUS status = KeMuxConSinkSetPolicy(&gMuxConsoleSink, (uint32_t)sink, policy);
+    KeLeaveCriticalSection(&criticalSection);
+    return status;
+#else
+    return EC_NOT_SUPPORTED;
+#endif
+}
+
+HO_PUBLIC_API HO_STATUS
+ConsoleQuerySinkQueueStats(CONSOLE_SINK_ID sink, CONSOLE_SINK_QUEUE_STATS *stats)
+{
+    if ((uint32_t)sink >= CONSOLE_SINK_COUNT || stats == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+    if (!gConsoleInitialized)
+        return EC_INVALID_STATE;
+
+#if __HO_DEBUG_BUILD__
+    // Not synced: the point is to see how far the sink lags.
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    HO_STATUS status = KeMuxConSinkQueryLaneStats(&gMuxConsoleSink, (uint32_t)sink, stats);
+    KeLeaveCriticalSection(&criticalSection);
+    return status;
+#else
+    return EC_NOT_SUPPORTED;
+#endif
+}
+
+HO_PUBLIC_API void
+ConsoleEnterPanicMode(void)
+{
+    if (!gConsoleInitialized)
+        return;
+
+#if __HO_DEBUG_BUILD__
+    // No critical section: the faulting context may already hold one. The drain
+    // threads may never run again, so the lanes are emptied here and write through
+    // from now on. The serial sink masks interrupts around every ring access on its own.
+    for (uint32_t lane = 0; lane < CONSOLE_SINK_COUNT; ++lane)
+        (void)KeMuxConSinkSetPolicy(&gMuxConsoleSink, lane, CONSOLE_SINK_QUEUE_DIRECT);
+    KeSerialConSinkSetInterruptTx(&gSerialConsoleSink, FALSE);
+#endif
+
+    // The periodic DPC may never run again; every stop-screen write flushes itself.
+    gConsoleFlushPolicy = CONSOLE_FLUSH_IMMEDIATE;
+    ConsoleFlushFramebufferUnlocked();
+}
@@ -9,6 +9,7 @@
 
 #include "console_device.h"
 #include <kernel/ke/console.h>
+#include <kernel/ke/mm.h>
 #include <drivers/basic_color.h>
 
 enum
@@ -24,6 +25,121 @@ static BOOL TryProcessAnisSeq(KE_CONSOLE_DEVICE *dev, char ch);
 // Map ANSI code to console device attributes.
 static void ApplyAnsiCode(KE_CONSOLE_DEVICE *dev, int code);
 
+// CSI K / CSI J. Only the grid can erase pixels it does not own, so without a
+// grid these are eaten like any other unsupported sequence.
+static void EraseInLine(KE_CONSOLE_DEVICE *dev, int mode);
+static void EraseInDisplay(KE_CONSOLE_DEVICE *dev, int mode);
+
+static inline uint32_t
+GridLineIndex(const KE_CONSOLE_DEVICE *dev, uint16_t row)
+{
+    return (dev->_Grid.Head + row) % dev->_Grid.Height;
+}
+
+static inline KE_CONSOLE_CELL *
+GridLineCells(KE_CONSOLE_DEVICE *dev, uint32_t line)
+{
+    return dev->_Grid.Cells + (uint64_t)line * dev->_Grid.Width;
+}
+
+// Grow a line's used prefix to end, blanking the cells it newly covers.
+static void
+GridExtendLine(KE_CONSOLE_DEVICE *dev, uint32_t line, uint16_t end)
+{
+    KE_CONSOLE_GRID_LINE *state = &dev->_Grid.Lines[line];
+    KE_CONSOLE_CELL *cells = GridLineCells(dev, line);
+
+    for (uint16_t x = state->Used; x < end; ++x)
+    {
+        cells[x].Char = ' ';
+        cells[x].Foreground = dev->Foreground;
+        cells[x].Background = state->Fill;
+    }
+    if (end > state->Used)
+        state->Used = end;
+}
+
+static void
+GridStoreCell(KE_CONSOLE_DEVICE *dev, uint16_t x, uint16_t y, char c)
+{
+    if (x >= dev->_Grid.Width || y >= dev->_Grid.Height)
+        return;
+
+    uint32_t line = GridLineIndex(dev, y);
+    GridExtendLine(dev, line, x + 1);
+
+    KE_CONSOLE_CELL *cell = &GridLineCells(dev, line)[x];
+    cell->Char = c;
+    cell->Foreground = dev->Foreground;
+    cell->Background = dev->Background;
+
+    // The sink draws this cell itself; the row now shows at least this much.
+    KE_CONSOLE_GRID_ROW *row = &dev->_Grid.Rows[y];
+    if (row->ShownUsed < x + 1)
+        row->ShownUsed = x + 1;
+}
+
+// Blank cells [from, to) of screen row y in the current background.
+static void
+GridEraseRow(KE_CONSOLE_DEVICE *dev, uint16_t y, uint16_t from, uint16_t to)
+{
+    if (to > dev->_Grid.Width)
+        to = dev->_Grid.Width;
+    if (from >= to)
+        return;
+
+    uint32_t line = GridLineIndex(dev, y);
+    KE_CONSOLE_GRID_LINE *state = &dev->_Grid.Lines[line];
+    if (to >= state->Used && dev->Background == state->Fill)
+    {
+        // Erasing the tail in the line's own fill colour just shortens it.
+        if (from < state->Used)
+            state->Used = from;
+    }
+    else
+    {
+        GridExtendLine(dev, line, to);
+        KE_CONSOLE_CELL *cells = GridLineCells(dev, line);
+        for (uint16_t x = from; x < to; ++x)
+        {
+            cells[x].Char = ' ';
+            cells[x].Foreground = dev->Foreground;
+            cells[x].Background = dev->Background;
+        }
+    }
+
+    dev->_Grid.Rows[y].Dirty = TRUE;
+    dev->_Grid.AnyDirty = TRUE;
+}
+
+// O(1): the top line becomes the new bottom line, emptied in the current background.
+static void
+GridScroll(KE_CONSOLE_DEVICE *dev)
+{
+    uint32_t line = dev->_Grid.Head;
+    dev->_Grid.Head = (dev->_Grid.Head + 1) % dev->_Grid.Height;
+    dev->_Grid.Lines[line].Used = 0;
+    dev->_Grid.Lines[line].Fill = dev->Background;
+    dev->_Grid.RepaintAll = TRUE;
+    dev->_Grid.Scrolls++;
+}
+
+static void
+GridReset(KE_CONSOLE_DEVICE *dev, COLOR32 fill, uint16_t shownUsed)
+{
+    dev->_Grid.Head = 0;
+    dev->_Grid.RepaintAll = FALSE;
+    dev->_Grid.AnyDirty = FALSE;
+    for (uint16_t y = 0; y < dev->_Grid.Height; ++y)
+    {
+        dev->_Grid.Lines[y].Used = 0;
+        dev->_Grid.Lines[y].Fill = fill;
+        dev->_Grid.Rows[y].Dirty = FALSE;
+        dev->_Grid.Rows[y].ShownUsed = shownUsed;
+        dev->_Grid.Rows[y].ShownFill = fill;
+    }
+}
+
 HO_KERNEL_API void
 KeConDevInit(KE_CONSOLE_DEVICE *dev, struct KE_CONSOLE_SINK *sink)
 {
@@ -51,6 +167,8 @@ KeConDevPutChar(KE_CONSOLE_DEVICE *this, char c)
     if (HO_LIKELY(c >= ' ' && c <= '~'))
     {
     render_char:
+        if (this->_Grid.Enabled)
+            GridStoreCell(this, this->CursorX, this->CursorY, c);
         this->Sink->PutChar(this->Sink, this->CursorX, this->CursorY, c, this->Foreground, this->Background);
         if (move)
             this->CursorX++;
@@ -91,6 +209,10 @@ KeConDevPutChar(KE_CONSOLE_DEVICE *this, char c)
 
     if (this->CursorY >= kGridHeight)
     {
+        // With a grid, pixel sinks ignore Scroll and repaint on present; stream
+        // sinks such as serial still see the line feed.
+        if (this->_Grid.Enabled)
+            GridScroll(this);
         this->Sink->Scroll(this->Sink, 1, this->Background);
         this->CursorY = kGridHeight - 1;
     }
@@ -123,6 +245,97 @@ KeConDevClearScreen(KE_CONSOLE_DEVICE *dev, COLOR32 color)
     dev->Sink->Clear(dev->Sink, color);
     dev->CursorX = 0;
     dev->CursorY = 0;
+    if (dev->_Grid.Enabled)
+        GridReset(dev, color, 0);
+}
+
+HO_KERNEL_API HO_STATUS
+KeConDevEnableGrid(KE_CONSOLE_DEVICE *dev, BOOL enable)
+{
+    if (!dev || !dev->Sink)
+        return EC_ILLEGAL_ARGUMENT;
+    if (!enable)
+    {
+        dev->_Grid.Enabled = FALSE;
+        return EC_SUCCESS;
+    }
+    if (dev->_Grid.Enabled)
+        return EC_SUCCESS;
+    if (dev->Sink->DrawRow == NULL)
+        return EC_NOT_SUPPORTED;
+
+    if (dev->_Grid.Cells == NULL)
+    {
+        CONSOLE_SINK_INFO info;
+        HO_STATUS status = dev->Sink->GetInfo(dev->Sink, &info);
+        if (status != EC_SUCCESS)
+            return status;
+        if (info.GridWidth == 0 || info.GridHeight == 0)
+            return EC_INVALID_STATE;
+
+        uint64_t cellBytes = (uint64_t)info.GridWidth * info.GridHeight * sizeof(KE_CONSOLE_CELL);
+        uint64_t lineBytes = (uint64_t)info.GridHeight * sizeof(KE_CONSOLE_GRID_LINE);
+        uint64_t rowBytes = (uint64_t)info.GridHeight * sizeof(KE_CONSOLE_GRID_ROW);
+        HO_VIRTUAL_ADDRESS base = 0;
+        status = KeHeapAllocPages(HO_ALIGN_UP(cellBytes + lineBytes + rowBytes, PAGE_4KB) / PAGE_4KB, &base);
+        if (status != EC_SUCCESS)
+            return status;
+
+        dev->_Grid.Cells = (KE_CONSOLE_CELL *)base;
+        dev->_Grid.Lines = (KE_CONSOLE_GRID_LINE *)(base + cellBytes);
+        dev->_Grid.Rows = (KE_CONSOLE_GRID_ROW *)(base + cellBytes + lineBytes);
+        dev->_Grid.Width = info.GridWidth;
+        dev->_Grid.Height = info.GridHeight;
+    }
+
+    // What is on screen now is unknown to the grid: treat every row as full so
+    // the first repaint overwrites it.
+    GridReset(dev, dev->Background, dev->_Grid.Width);
+    dev->_Grid.Enabled = TRUE;
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API void
+KeConDevPresent(KE_CONSOLE_DEVICE *dev)
+{
+    if (!dev || !dev->_Grid.Enabled || (!dev->_Grid.RepaintAll && !dev->_Grid.AnyDirty))
+        return;
+
+    for (uint16_t y = 0; y < dev->_Grid.Height; ++y)
+    {
+        KE_CONSOLE_GRID_ROW *row = &dev->_Grid.Rows[y];
+        if (!dev->_Grid.RepaintAll && !row->Dirty)
+            continue;
+        row->Dirty = FALSE;
+
+        uint32_t line = GridLineIndex(dev, y);
+        const KE_CONSOLE_GRID_LINE *state = &dev->_Grid.Lines[line];
+        if (state->Used == 0 && row->ShownUsed == 0 && state->Fill == row->ShownFill)
+        {
+            // Blank scrolled onto blank: nothing on screen changes.
+            dev->_Grid.SkippedRows++;
+            continue;
+        }
+
+        (void)dev->Sink->DrawRow(dev->Sink, y, GridLineCells(dev, line), state->Used, state->Fill);
+        row->ShownUsed = state->Used;
+        row->ShownFill = state->Fill;
+        dev->_Grid.RepaintedRows++;
+    }
+
+    dev->_Grid.RepaintAll = FALSE;
+    dev->_Grid.AnyDirty = FALSE;
+}
+
+HO_KERNEL_API void
+KeConDevQueryGridStats(KE_CONSOLE_DEVICE *dev, CONSOLE_GRID_STATS *stats)
+{
+    stats->Enabled = dev->_Grid.Enabled;
+    stats->Columns = dev->_Grid.Width;
+    stats->Rows = dev->_Grid.Height;
+    stats->Scrolls = dev->_Grid.Scrolls;
+    stats->RepaintedRows = dev->_Grid.RepaintedRows;
+    stats->SkippedRows = dev->_Grid.SkippedRows;
 }
 
 static BOOL
@@ -173,6 +386,16 @@ TryProcessAnisSeq(KE_CONSOLE_DEVICE *dev, char ch)
             dev->_ParserState.EscSeqState = STATE_NORMAL;
             return TRUE;
         }
+        else if (ch == 'K' || ch == 'J')
+        {
+            int mode = dev->_ParserState.AnsiHasCode ? dev->_ParserState.AnsiCurrentCode : 0;
+            if (ch == 'K')
+                EraseInLine(dev, mode);
+            else
+                EraseInDisplay(dev, mode);
+            dev->_ParserState.EscSeqState = STATE_NORMAL;
+            return TRUE;
+        }
         else
         {
             // Unsupported sequence, reset state
@@ -207,3 +430,32 @@ ApplyAnsiCode(KE_CONSOLE_DEVICE *dev, int code)
         dev->Background = kBackColors[code - 40];
     }
 }
+
+static void
+EraseInLine(KE_CONSOLE_DEVICE *dev, int mode)
+{
+    if (!dev->_Grid.Enabled || dev->CursorY >= dev->_Grid.Height)
+        return;
+
+    if (mode == 0)
+        GridEraseRow(dev, dev->CursorY, dev->CursorX, dev->_Grid.Width);
+    else if (mode == 1)
+        GridEraseRow(dev, dev->CursorY, 0, dev->CursorX + 1);
+    else if (mode == 2)
+        GridEraseRow(dev, dev->CursorY, 0, dev->_Grid.Width);
+}
+
+static void
+EraseInDisplay(KE_CONSOLE_DEVICE *dev, int mode)
+{
+    if (!dev->_Grid.Enabled || dev->CursorY >= dev->_Grid.Height || mode < 0 || mode > 2)
+        return;
+
+    // Rows entirely before (mode 1) or after (mode 0) the cursor, or all of them (mode 2).
+    uint16_t first = mode == 0 ? dev->CursorY + 1 : 0;
+    uint16_t last = mode == 1 ? dev->CursorY : dev->_Grid.Height;
+    if (mode != 2)
+        EraseInLine(dev, mode);
+    for (uint16_t y = first; y < last; ++y)
+        GridEraseRow(dev, y, 0, dev->_Grid.Width);
+}
@@ -11,10 +11,26 @@
 
 #include "_hobase.h"
 #include "drivers/basic_color.h"
+#include <kernel/ke/console.h>
 #include <kernel/ke/sinks/console_sink.h>
 
 struct KE_CONSOLE_SINK;
 
+// Per physical grid line. Cells at or past Used are blank in Fill.
+typedef struct KE_CONSOLE_GRID_LINE
+{
+    uint16_t Used;
+    COLOR32 Fill;
+} KE_CONSOLE_GRID_LINE;
+
+// Per screen row: what the pixel sinks last showed there.
+typedef struct KE_CONSOLE_GRID_ROW
+{
+    BOOL Dirty;
+    uint16_t ShownUsed;
+    COLOR32 ShownFill;
+} KE_CONSOLE_GRID_ROW;
+
 typedef struct KE_CONSOLE_DEVICE
 {
     uint16_t CursorX, CursorY; // in CHARACTERS unit
@@ -26,6 +42,24 @@ typedef struct KE_CONSOLE_DEVICE
         BOOL AnsiHasCode;
         int AnsiCurrentCode;
     } _ParserState;
+
+    // Character grid kept as a ring of lines: screen row y is physical line
+    // (Head + y) % Height, so a scroll bumps Head and clears one line. Rows
+    // whose content moved are repainted through DrawRow by KeConDevPresent.
+    HO_PRIVATE_FIELD struct
+    {
+        BOOL Enabled;
+        BOOL RepaintAll;
+        BOOL AnyDirty;
+        uint16_t Width, Height;
+        uint16_t Head;
+        KE_CONSOLE_CELL *Cells; // Height lines of Width cells
+        KE_CONSOLE_GRID_LINE *Lines;
+        KE_CONSOLE_GRID_ROW *Rows;
+        uint64_t Scrolls;
+        uint64_t RepaintedRows;
+        uint64_t SkippedRows;
+    } _Grid;
 } KE_CONSOLE_DEVICE;
 
 HO_KERNEL_API void KeConDevInit(KE_CONSOLE_DEVICE *dev, struct KE_CONSOLE_SINK *sink);
@@ -35,3 +69,14 @@ HO_KERNEL_API int KeConDevPutChar(KE_CONSOLE_DEVICE *dev, char ch);
 HO_KERNEL_API uint64_t KeConDevPutStr(KE_CONSOLE_DEVICE *dev, const char *str);
 
 HO_KERNEL_API void KeConDevClearScreen(KE_CONSOLE_DEVICE *dev, COLOR32 color);
+
+// Switches scrolling between the sink's Scroll and the line ring. The grid is
+// sized from the sink on first enable and allocated from the kernel heap; text
+// drawn before it existed is not in it and disappears at the next repaint.
+// The caller must also stop pixel sinks from moving pixels on Scroll.
+HO_KERNEL_API HO_STATUS KeConDevEnableGrid(KE_CONSOLE_DEVICE *dev, BOOL enable);
+
+// Repaints the rows changed by scrolls and erases since the last call.
+HO_KERNEL_API void KeConDevPresent(KE_CONSOLE_DEVICE *dev);
+
+HO_KERNEL_API void KeConDevQueryGridStats(KE_CONSOLE_DEVICE *dev, CONSOLE_GRID_STATS *stats);
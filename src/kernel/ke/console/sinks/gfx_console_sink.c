@@ -8,6 +8,7 @@
  */
 
 #include "gfx_console_sink.h"
+#include <libc/string.h>
 
 static HO_STATUS
 GfxConSinkGetInfo(void *self, CONSOLE_SINK_INFO *info)
@@ -27,10 +28,11 @@ GfxConSinkGetInfo(void *self, CONSOLE_SINK_INFO *info)
     return EC_SUCCESS;
 }
 
+// Reference path: one driver call per pixel (or per scaled pixel). Used for fonts
+// the glyph cache cannot expand and when the cache is switched off.
 static HO_STATUS
-GfxConSinkPutChar(void *self, uint16_t gridX, uint16_t gridY, char c, COLOR32 fg, COLOR32 bg)
+GfxConSinkPutCharPixels(GFX_CONSOLE_SINK *sink, uint16_t gridX, uint16_t gridY, char c, COLOR32 fg, COLOR32 bg)
 {
-    GFX_CONSOLE_SINK *sink = (GFX_CONSOLE_SINK *)self;
     KE_VIDEO_DRIVER *device = sink->Driver;
     uint16_t scale = sink->Scale;
     uint32_t x = gridX * sink->Font->Width * scale;
@@ -49,6 +51,9 @@ GfxConSinkPutChar(void *self, uint16_t gridX, uint16_t gridY, char c, COLOR32 fg
     }
 
     const uint8_t *glyph = GetGlyph(sink->Font, c);
+    if (!glyph)
+        return EC_ILLEGAL_ARGUMENT;
+
     uint32_t xi, yi;
     for (yi = 0; yi < sink->Font->Height; yi++)
     {
@@ -94,10 +99,119 @@ GfxConSinkPutChar(void *self, uint16_t gridX, uint16_t gridY, char c, COLOR32 fg
     return EC_SUCCESS;
 }
 
+static void
+GfxConSinkExpandSlot(GFX_CONSOLE_SINK *sink, GFX_CONSOLE_GLYPH_ROWS *slot, COLOR32 fg, COLOR32 bg)
+{
+    KE_VIDEO_DRIVER *device = sink->Driver;
+    uint64_t physFg = device->Methods->ToPhysColor(device, fg);
+    uint64_t physBg = device->Methods->ToPhysColor(device, bg);
+
+    // Bit 7 is the leftmost pixel; the left pixel of each pair is the low dword.
+    for (uint32_t bits = 0; bits < 256; ++bits)
+    {
+        for (uint32_t pair = 0; pair < 4; ++pair)
+        {
+            uint64_t left = (bits & (0x80U >> (pair * 2))) ? physFg : physBg;
+            uint64_t right = (bits & (0x40U >> (pair * 2))) ? physFg : physBg;
+            slot->Rows[bits][pair] = left | (right << 32);
+        }
+    }
+
+    slot->Foreground = fg;
+    slot->Background = bg;
+    slot->Valid = TRUE;
+}
+
+static const GFX_CONSOLE_GLYPH_ROWS *
+GfxConSinkLookupSlot(GFX_CONSOLE_SINK *sink, COLOR32 fg, COLOR32 bg)
+{
+    for (uint32_t index = 0; index < GFX_CONSOLE_GLYPH_SLOTS; ++index)
+    {
+        GFX_CONSOLE_GLYPH_ROWS *slot = &sink->Slots[index];
+        if (slot->Valid && slot->Foreground == fg && slot->Background == bg)
+        {
+            sink->Stats.SlotHits++;
+            return slot;
+        }
+    }
+
+    GFX_CONSOLE_GLYPH_ROWS *victim = &sink->Slots[sink->NextSlot];
+    sink->NextSlot = (sink->NextSlot + 1) % GFX_CONSOLE_GLYPH_SLOTS;
+    GfxConSinkExpandSlot(sink, victim, fg, bg);
+    sink->Stats.SlotFills++;
+    return victim;
+}
+
+static HO_STATUS
+GfxConSinkPutChar(void *self, uint16_t gridX, uint16_t gridY, char c, COLOR32 fg, COLOR32 bg)
+{
+    GFX_CONSOLE_SINK *sink = (GFX_CONSOLE_SINK *)self;
+    if (!sink->GlyphCacheEnabled)
+    {
+        sink->Stats.PixelGlyphs++;
+        return GfxConSinkPutCharPixels(sink, gridX, gridY, c, fg, bg);
+    }
+
+    const uint8_t *glyph = GetGlyph(sink->Font, (uint8_t)c);
+    if (!glyph)
+        return EC_ILLEGAL_ARGUMENT;
+
+    const GFX_CONSOLE_GLYPH_ROWS *slot = GfxConSinkLookupSlot(sink, fg, bg);
+    uint32_t scale = sink->Scale;
+    uint32_t stride = sink->Driver->HorizontalResolution;
+    uint32_t *pixel = (uint32_t *)sink->Driver->FrameBuffer + (uint64_t)gridY * sink->Font->Height * scale * stride +
+                      (uint64_t)gridX * 8U * scale;
+
+    if (HO_LIKELY(scale == 1))
+    {
+        // Cell origins are 8-pixel aligned, so each row is four aligned 8-byte stores.
+        for (uint32_t yi = 0; yi < sink->Font->Height; ++yi, pixel += stride)
+        {
+            const uint64_t *row = slot->Rows[glyph[yi]];
+            uint64_t *dst = (uint64_t *)pixel;
+            dst[0] = row[0];
+            dst[1] = row[1];
+            dst[2] = row[2];
+            dst[3] = row[3];
+        }
+    }
+    else
+    {
+        // Widen the cached row once, then replicate it down the scale rows.
+        uint64_t wide[GFX_CONSOLE_MAX_SCALE * 4];
+        uint32_t qwords = scale * 4U;
+        for (uint32_t yi = 0; yi < sink->Font->Height; ++yi)
+        {
+            const uint32_t *row = (const uint32_t *)slot->Rows[glyph[yi]];
+            uint32_t *out = (uint32_t *)wide;
+            for (uint32_t xi = 0; xi < 8; ++xi)
+            {
+                for (uint32_t rep = 0; rep < scale; ++rep)
+                    *out++ = row[xi];
+            }
+
+            for (uint32_t rep = 0; rep < scale; ++rep, pixel += stride)
+            {
+                uint64_t *dst = (uint64_t *)pixel;
+                for (uint32_t index = 0; index < qwords; ++index)
+                    dst[index] = wide[index];
+            }
+        }
+    }
+
+    VdMarkDirty(sink->Driver, (uint32_t)gridX * 8U * scale, (uint32_t)gridY * sink->Font->Height * scale, 8U * scale,
+                (uint32_t)sink->Font->Height * scale);
+    sink->Stats.CachedGlyphs++;
+    return EC_SUCCESS;
+}
+
 static HO_STATUS
 GfxConSinkScroll(void *self, uint16_t count, COLOR32 fill)
 {
     GFX_CONSOLE_SINK *sink = (GFX_CONSOLE_SINK *)self;
+    if (sink->DeferScroll)
+        return EC_SUCCESS;
+
     const uint8_t kScale = 1;
     const size_t kLineSize = sink->Driver->HorizontalResolution * sink->Font->Height * kScale * 4;
     const size_t kScrollSize = kLineSize * count;
@@ -117,6 +231,40 @@ GfxConSinkScroll(void *self, uint16_t count, COLOR32 fill)
         rect_params.Filled = 1;
         VdRenderRect(sink->Driver, &rect_params);
     }
+    VdMarkDirty(sink->Driver, 0, 0, sink->Driver->HorizontalResolution, sink->Driver->VerticalResolution);
+    return EC_SUCCESS;
+}
+
+static HO_STATUS
+GfxConSinkDrawRow(void *self, uint16_t gridY, const KE_CONSOLE_CELL *cells, uint16_t count, COLOR32 fillColor)
+{
+    GFX_CONSOLE_SINK *sink = (GFX_CONSOLE_SINK *)self;
+    for (uint16_t gridX = 0; gridX < count; ++gridX)
+    {
+        const KE_CONSOLE_CELL *cell = &cells[gridX];
+        (void)GfxConSinkPutChar(sink, gridX, gridY, cell->Char, cell->Foreground, cell->Background);
+    }
+
+    uint32_t x = (uint32_t)count * sink->Font->Width * sink->Scale;
+    if (x >= sink->Driver->HorizontalResolution)
+        return EC_SUCCESS;
+
+    VD_RENDER_RECT_PARAMS rect_params = {0};
+    rect_params.X = x;
+    rect_params.Y = (uint32_t)gridY * sink->Font->Height * sink->Scale;
+    rect_params.Width = sink->Driver->HorizontalResolution - x;
+    rect_params.Height = sink->Font->Height * sink->Scale;
+    rect_params.Color = fillColor;
+    rect_params.Filled = 1;
+    VdRenderRect(sink->Driver, &rect_params);
+    return EC_SUCCESS;
+}
+
+static HO_STATUS
+GfxConSinkFlush(void *self)
+{
+    GFX_CONSOLE_SINK *sink = (GFX_CONSOLE_SINK *)self;
+    VdFlush(sink->Driver);
     return EC_SUCCESS;
 }
 
@@ -142,7 +290,40 @@ KeGfxConSinkInit(GFX_CONSOLE_SINK *sink, KE_VIDEO_DRIVER *driver, BITMAP_FONT_IN
     sink->Base.PutChar = GfxConSinkPutChar;
     sink->Base.Scroll = GfxConSinkScroll;
     sink->Base.Clear = GfxConSinkClear;
+    sink->Base.DrawRow = GfxConSinkDrawRow;
+    sink->Base.Flush = GfxConSinkFlush;
     sink->Driver = driver;
     sink->Font = font;
-    sink->Scale = scale;
-}
\ No newline at end of file
+    sink->Scale = scale <= GFX_CONSOLE_MAX_SCALE ? scale : GFX_CONSOLE_MAX_SCALE;
+    sink->DeferScroll = FALSE;
+    sink->NextSlot = 0;
+    memset(sink->Slots, 0, sizeof(sink->Slots));
+    memset(&sink->Stats, 0, sizeof(sink->Stats));
+    sink->GlyphCacheEnabled = font != NULL && font->Width == 8;
+}
+
+HO_STATUS
+KeGfxConSinkSetGlyphCache(GFX_CONSOLE_SINK *sink, BOOL enable)
+{
+    if (!sink || !sink->Font)
+        return EC_ILLEGAL_ARGUMENT;
+    if (enable && sink->Font->Width != 8)
+        return EC_NOT_SUPPORTED;
+
+    sink->GlyphCacheEnabled = enable;
+    return EC_SUCCESS;
+}
+
+void
+KeGfxConSinkQueryStats(GFX_CONSOLE_SINK *sink, CONSOLE_GLYPH_STATS *stats)
+{
+    *stats = sink->Stats;
+    stats->Enabled = sink->GlyphCacheEnabled;
+    stats->Slots = GFX_CONSOLE_GLYPH_SLOTS;
+}
+
+void
+KeGfxConSinkSetDeferredScroll(GFX_CONSOLE_SINK *sink, BOOL defer)
+{
+    sink->DeferScroll = defer;
+}
@@ -11,16 +11,42 @@
 
 #include "_hobase.h"
 #include "drivers/video_driver.h"
+#include <kernel/ke/console.h>
 #include <kernel/ke/sinks/console_sink.h>
 #include <lib/tui/bitmap_font.h>
 
+#define GFX_CONSOLE_GLYPH_SLOTS 4U // Colour pairs kept expanded at once
+#define GFX_CONSOLE_MAX_SCALE   8U
+
+// One colour pair expanded to framebuffer pixels. An 8-pixel glyph row is one of
+// 256 bit patterns, so this covers every glyph of an 8-wide font: a row is drawn
+// by copying Rows[bits] (32 bytes) instead of testing and storing 8 pixels.
+typedef struct GFX_CONSOLE_GLYPH_ROWS
+{
+    BOOL Valid;
+    COLOR32 Foreground;
+    COLOR32 Background;
+    uint64_t Rows[256][4];
+} GFX_CONSOLE_GLYPH_ROWS;
+
 HO_INTERNAL_STRUCT typedef struct
 {
     KE_CONSOLE_SINK Base;
     uint8_t Scale;
     KE_VIDEO_DRIVER *Driver;
     BITMAP_FONT_INFO *Font;
+
+    BOOL DeferScroll; // The console grid repaints rows instead of Scroll moving pixels
+    BOOL GlyphCacheEnabled;
+    uint32_t NextSlot; // Round-robin victim when no slot matches
+    CONSOLE_GLYPH_STATS Stats;
+    GFX_CONSOLE_GLYPH_ROWS Slots[GFX_CONSOLE_GLYPH_SLOTS];
 } GFX_CONSOLE_SINK;
 
 HO_KERNEL_API
 void KeGfxConSinkInit(GFX_CONSOLE_SINK *sink, KE_VIDEO_DRIVER *driver, BITMAP_FONT_INFO *font, uint8_t scale);
+
+// The cached path needs an 8-pixel-wide font; otherwise enabling is refused.
+HO_KERNEL_API HO_STATUS KeGfxConSinkSetGlyphCache(GFX_CONSOLE_SINK *sink, BOOL enable);
+HO_KERNEL_API void KeGfxConSinkQueryStats(GFX_CONSOLE_SINK *sink, CONSOLE_GLYPH_STATS *stats);
+HO_KERNEL_API void KeGfxConSinkSetDeferredScroll(GFX_CONSOLE_SINK *sink, BOOL defer);
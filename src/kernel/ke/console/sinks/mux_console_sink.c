@@ -3,13 +3,194 @@
  *
  * File: ke/sinks/mux_console_sink.c
  * Description:
- * Ke Layer - Multiplexed console sink implementation
- * Copyright(c) 2024-2025 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ * Ke Layer - Multiplexed console sink implementation. Every sink sits behind its
+ * own lane: a direct lane calls the sink in the writer's context, a queued one
+ * records the call for the sink's drain thread, so sinks run at their own pace.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
  */
 
 #include "mux_console_sink.h"
 #include <kernel/ke/mm.h>
 
+static BOOL
+MuxConSinkImplements(const KE_CONSOLE_SINK *target, uint8_t kind)
+{
+    switch (kind)
+    {
+    case MUX_SINK_OP_CLEAR:
+        return target->Clear != NULL;
+    case MUX_SINK_OP_DRAW_ROW:
+        return target->DrawRow != NULL;
+    case MUX_SINK_OP_FLUSH:
+        return target->Flush != NULL;
+    default:
+        return TRUE;
+    }
+}
+
+static HO_STATUS
+MuxConSinkApply(KE_CONSOLE_SINK *target, const MUX_SINK_OP *op)
+{
+    switch (op->Kind)
+    {
+    case MUX_SINK_OP_PUT_CHAR:
+        return target->PutChar(target, op->X, op->Y, op->Char, op->Foreground, op->Background);
+    case MUX_SINK_OP_SCROLL:
+        return target->Scroll(target, op->Count, op->Background);
+    case MUX_SINK_OP_CLEAR:
+        return target->Clear(target, op->Background);
+    case MUX_SINK_OP_DRAW_ROW:
+        return target->DrawRow(target, op->Y, op->Cells, op->Count, op->Background);
+    case MUX_SINK_OP_FLUSH:
+        return target->Flush(target);
+    default:
+        return EC_ILLEGAL_ARGUMENT;
+    }
+}
+
+static inline uint32_t
+MuxConSinkPending(const MUX_SINK_LANE *lane)
+{
+    return lane->Head - lane->Tail;
+}
+
+// Apply the oldest queued operation. Tail moves only afterwards, so a panic that
+// lands inside the sink call replays that operation instead of losing it.
+static void
+MuxConSinkApplyOldest(MUX_CONSOLE_SINK *sink, uint32_t index)
+{
+    MUX_SINK_LANE *lane = &sink->Lanes[index];
+    (void)MuxConSinkApply(sink->Sinks[index], &lane->Ops[lane->Tail & (lane->Capacity - 1U)]);
+    lane->Tail++;
+    lane->Stats.Applied++;
+}
+
+static inline BOOL
+MuxConSinkRowMarked(const uint64_t *rows, uint16_t y)
+{
+    return y < MUX_SINK_COALESCE_ROWS && (rows[y / 64U] & (1ULL << (y % 64U))) != 0;
+}
+
+// Remove queued operations whose effect a later queued one overwrites: everything
+// before a Clear, a Flush followed by another Flush, and PutChar or DrawRow on a row
+// that a later DrawRow repaints. Scrolls in between do not matter: DrawRow only comes
+// from a device that keeps a grid, and pixel sinks then leave Scroll to the repaint.
+// Scrolls that end up adjacent merge. Returns how many slots were freed.
+static uint32_t
+MuxConSinkCoalesce(MUX_SINK_LANE *lane)
+{
+    uint32_t mask = lane->Capacity - 1U;
+    uint64_t repaintedRows[MUX_SINK_COALESCE_ROWS / 64U] = {0};
+    BOOL cleared = FALSE;
+    BOOL flushed = FALSE;
+
+    for (uint32_t position = lane->Head; position != lane->Tail; --position)
+    {
+        MUX_SINK_OP *op = &lane->Ops[(position - 1U) & mask];
+        op->Superseded = cleared;
+        if (cleared)
+            continue;
+
+        switch (op->Kind)
+        {
+        case MUX_SINK_OP_CLEAR:
+            cleared = TRUE;
+            break;
+        case MUX_SINK_OP_FLUSH:
+            op->Superseded = flushed;
+            flushed = TRUE;
+            break;
+        case MUX_SINK_OP_SCROLL:
+            break;
+        case MUX_SINK_OP_DRAW_ROW:
+            op->Superseded = MuxConSinkRowMarked(repaintedRows, op->Y);
+            if (op->Y < MUX_SINK_COALESCE_ROWS)
+                repaintedRows[op->Y / 64U] |= 1ULL << (op->Y % 64U);
+            break;
+        default:
+            op->Superseded = MuxConSinkRowMarked(repaintedRows, op->Y);
+            break;
+        }
+    }
+
+    uint32_t kept = lane->Tail;
+    MUX_SINK_OP *previous = NULL;
+    for (uint32_t position = lane->Tail; position != lane->Head; ++position)
+    {
+        MUX_SINK_OP *op = &lane->Ops[position & mask];
+        if (op->Superseded)
+            continue;
+        if (previous != NULL && op->Kind == MUX_SINK_OP_SCROLL && previous->Kind == MUX_SINK_OP_SCROLL &&
+            op->Background == previous->Background && (uint32_t)previous->Count + op->Count <= 0xFFFFU)
+        {
+            previous->Count = (uint16_t)(previous->Count + op->Count);
+            continue;
+        }
+
+        previous = &lane->Ops[kept & mask];
+        if (previous != op)
+            *previous = *op;
+        kept++;
+    }
+
+    uint32_t freed = lane->Head - kept;
+    lane->Head = kept;
+    lane->Stats.Coalesced += freed;
+    return freed;
+}
+
+static void
+MuxConSinkSubmit(MUX_CONSOLE_SINK *sink, uint32_t index, const MUX_SINK_OP *op)
+{
+    MUX_SINK_LANE *lane = &sink->Lanes[index];
+    KE_CONSOLE_SINK *target = sink->Sinks[index];
+    if (!MuxConSinkImplements(target, op->Kind))
+        return;
+
+    lane->Stats.Submitted++;
+    if (lane->Policy == CONSOLE_SINK_QUEUE_DIRECT)
+    {
+        (void)MuxConSinkApply(target, op);
+        lane->Stats.Applied++;
+        return;
+    }
+
+    if (MuxConSinkPending(lane) == lane->Capacity)
+    {
+        if (lane->Policy == CONSOLE_SINK_QUEUE_BLOCK)
+        {
+            lane->Stats.BlockCount++;
+            MuxConSinkApplyOldest(sink, index);
+        }
+        else if (lane->Policy == CONSOLE_SINK_QUEUE_DROP || MuxConSinkCoalesce(lane) == 0)
+        {
+            lane->Stats.Dropped++;
+            return;
+        }
+    }
+
+    lane->Ops[lane->Head & (lane->Capacity - 1U)] = *op;
+    lane->Head++;
+    if (MuxConSinkPending(lane) > lane->Stats.MaxPending)
+        lane->Stats.MaxPending = MuxConSinkPending(lane);
+
+    if (!lane->WakePending)
+    {
+        lane->WakePending = TRUE;
+        if (lane->Notify != NULL)
+            lane->Notify(lane->NotifyContext);
+    }
+}
+
+// Queued sinks cannot report a failure back to the writer; direct ones are not
+// waited on either, so the console keeps writing to the sinks that still work.
+static void
+MuxConSinkSubmitAll(MUX_CONSOLE_SINK *sink, const MUX_SINK_OP *op)
+{
+    for (size_t i = 0; i < sink->SinkCount; ++i)
+        MuxConSinkSubmit(sink, (uint32_t)i, op);
+}
+
 static HO_STATUS
 MuxConSinkGetInfo(void *self, CONSOLE_SINK_INFO *info)
 {
@@ -22,21 +203,22 @@ MuxConSinkGetInfo(void *self, CONSOLE_SINK_INFO *info)
     return sink->Sinks[0]->GetInfo(sink->Sinks[0], info);
 }
 
-static int
+static HO_STATUS
 MuxConSinkPutChar(void *self, uint16_t gx, uint16_t gy, char c, COLOR32 fg, COLOR32 bg)
 {
     MUX_CONSOLE_SINK *sink = (MUX_CONSOLE_SINK *)self;
     if (!sink)
-        return -1;
+        return EC_ILLEGAL_ARGUMENT;
 
-    int result = 0;
-    for (size_t i = 0; i < sink->SinkCount; ++i)
-    {
-        int res = sink->Sinks[i]->PutChar(sink->Sinks[i], gx, gy, c, fg, bg);
-        if (res < 0)
-            result = res;
-    }
-    return result;
+    MUX_SINK_OP op = {0};
+    op.Kind = MUX_SINK_OP_PUT_CHAR;
+    op.X = gx;
+    op.Y = gy;
+    op.Char = c;
+    op.Foreground = fg;
+    op.Background = bg;
+    MuxConSinkSubmitAll(sink, &op);
+    return EC_SUCCESS;
 }
 
 static HO_STATUS
@@ -46,14 +228,12 @@ MuxConSinkScroll(void *self, uint16_t count, COLOR32 fillColor)
     if (!sink)
         return EC_ILLEGAL_ARGUMENT;
 
-    HO_STATUS status = EC_SUCCESS;
-    for (size_t i = 0; i < sink->SinkCount; ++i)
-    {
-        HO_STATUS st = sink->Sinks[i]->Scroll(sink->Sinks[i], count, fillColor);
-        if (st != EC_SUCCESS)
-            status = st;
-    }
-    return status;
+    MUX_SINK_OP op = {0};
+    op.Kind = MUX_SINK_OP_SCROLL;
+    op.Count = count;
+    op.Background = fillColor;
+    MuxConSinkSubmitAll(sink, &op);
+    return EC_SUCCESS;
 }
 
 static HO_STATUS
@@ -63,16 +243,41 @@ MuxConSinkClear(void *self, COLOR32 fillColor)
     if (!sink)
         return EC_ILLEGAL_ARGUMENT;
 
-    HO_STATUS status = EC_SUCCESS;
-    for (size_t i = 0; i < sink->SinkCount; ++i)
-    {
-        if (sink->Sinks[i]->Clear == NULL)
-            continue;
-        HO_STATUS st = sink->Sinks[i]->Clear(sink->Sinks[i], fillColor);
-        if (st != EC_SUCCESS)
-            status = st;
-    }
-    return status;
+    MUX_SINK_OP op = {0};
+    op.Kind = MUX_SINK_OP_CLEAR;
+    op.Background = fillColor;
+    MuxConSinkSubmitAll(sink, &op);
+    return EC_SUCCESS;
+}
+
+static HO_STATUS
+MuxConSinkDrawRow(void *self, uint16_t y, const KE_CONSOLE_CELL *cells, uint16_t count, COLOR32 fillColor)
+{
+    MUX_CONSOLE_SINK *sink = (MUX_CONSOLE_SINK *)self;
+    if (!sink)
+        return EC_ILLEGAL_ARGUMENT;
+
+    MUX_SINK_OP op = {0};
+    op.Kind = MUX_SINK_OP_DRAW_ROW;
+    op.Y = y;
+    op.Cells = cells;
+    op.Count = count;
+    op.Background = fillColor;
+    MuxConSinkSubmitAll(sink, &op);
+    return EC_SUCCESS;
+}
+
+static HO_STATUS
+MuxConSinkFlush(void *self)
+{
+    MUX_CONSOLE_SINK *sink = (MUX_CONSOLE_SINK *)self;
+    if (!sink)
+        return EC_ILLEGAL_ARGUMENT;
+
+    MUX_SINK_OP op = {0};
+    op.Kind = MUX_SINK_OP_FLUSH;
+    MuxConSinkSubmitAll(sink, &op);
+    return EC_SUCCESS;
 }
 
 HO_KERNEL_API HO_STATUS
@@ -89,6 +294,8 @@ KeMuxConSinkInit(MUX_CONSOLE_SINK *sink)
     sink->Base.PutChar = MuxConSinkPutChar;
     sink->Base.Scroll = MuxConSinkScroll;
     sink->Base.Clear = MuxConSinkClear;
+    sink->Base.DrawRow = MuxConSinkDrawRow;
+    sink->Base.Flush = MuxConSinkFlush;
     return EC_SUCCESS;
 }
 
@@ -124,3 +331,92 @@ KeMuxConSinkPromoteToAllocator(MUX_CONSOLE_SINK *muxSink)
     muxSink->UsesAllocatorStorage = TRUE;
     return EC_SUCCESS;
 }
+
+HO_KERNEL_API HO_STATUS
+KeMuxConSinkSetupQueue(MUX_CONSOLE_SINK *muxSink, uint32_t lane, uint32_t capacity, MUX_SINK_LANE_NOTIFY notify,
+                       void *context)
+{
+    if (!muxSink || lane >= muxSink->SinkCount || capacity == 0 || (capacity & (capacity - 1U)) != 0)
+        return EC_ILLEGAL_ARGUMENT;
+
+    MUX_SINK_LANE *target = &muxSink->Lanes[lane];
+    if (target->Ops != NULL)
+        return EC_INVALID_STATE;
+
+    MUX_SINK_OP *ops = (MUX_SINK_OP *)kzalloc(capacity * sizeof(MUX_SINK_OP));
+    if (!ops)
+        return EC_NOT_ENOUGH_MEMORY;
+
+    target->Ops = ops;
+    target->Capacity = capacity;
+    target->Head = 0;
+    target->Tail = 0;
+    target->Notify = notify;
+    target->NotifyContext = context;
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API HO_STATUS
+KeMuxConSinkSetPolicy(MUX_CONSOLE_SINK *muxSink, uint32_t lane, CONSOLE_SINK_QUEUE_POLICY policy)
+{
+    if (!muxSink || lane >= muxSink->SinkCount || (uint32_t)policy > CONSOLE_SINK_QUEUE_COALESCE)
+        return EC_ILLEGAL_ARGUMENT;
+
+    MUX_SINK_LANE *target = &muxSink->Lanes[lane];
+    if (policy != CONSOLE_SINK_QUEUE_DIRECT && target->Ops == NULL)
+        return EC_INVALID_STATE;
+
+    if (policy == CONSOLE_SINK_QUEUE_DIRECT)
+        KeMuxConSinkSyncLane(muxSink, lane);
+    target->Policy = policy;
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API uint32_t
+KeMuxConSinkDrainLane(MUX_CONSOLE_SINK *muxSink, uint32_t lane, uint32_t budget)
+{
+    if (!muxSink || lane >= muxSink->SinkCount)
+        return 0;
+
+    // Cleared before the pass: an operation queued from here on wakes the drainer again.
+    MUX_SINK_LANE *target = &muxSink->Lanes[lane];
+    target->WakePending = FALSE;
+    for (; budget != 0 && MuxConSinkPending(target) != 0; --budget)
+        MuxConSinkApplyOldest(muxSink, lane);
+    return MuxConSinkPending(target);
+}
+
+HO_KERNEL_API void
+KeMuxConSinkSyncLane(MUX_CONSOLE_SINK *muxSink, uint32_t lane)
+{
+    if (!muxSink || lane >= muxSink->SinkCount)
+        return;
+
+    MUX_SINK_LANE *target = &muxSink->Lanes[lane];
+    while (MuxConSinkPending(target) != 0)
+        MuxConSinkApplyOldest(muxSink, lane);
+}
+
+HO_KERNEL_API void
+KeMuxConSinkSyncAll(MUX_CONSOLE_SINK *muxSink)
+{
+    if (!muxSink)
+        return;
+
+    for (size_t i = 0; i < muxSink->SinkCount; ++i)
+        KeMuxConSinkSyncLane(muxSink, (uint32_t)i);
+}
+
+HO_KERNEL_API HO_STATUS
+KeMuxConSinkQueryLaneStats(MUX_CONSOLE_SINK *muxSink, uint32_t lane, CONSOLE_SINK_QUEUE_STATS *stats)
+{
+    if (!muxSink || !stats || lane >= muxSink->SinkCount)
+        return EC_ILLEGAL_ARGUMENT;
+
+    const MUX_SINK_LANE *target = &muxSink->Lanes[lane];
+    *stats = target->Stats;
+    stats->Policy = target->Policy;
+    stats->Capacity = target->Capacity;
+    stats->Pending = MuxConSinkPending(target);
+    return EC_SUCCESS;
+}
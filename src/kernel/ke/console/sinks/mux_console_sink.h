@@ -4,16 +4,62 @@
  * File: ke/sinks/mux_console_sink.h
  * Description:
  * Ke Layer - Multiplexed console sink
- * Copyright(c) 2024-2025 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
  */
 
 #pragma once
 
 #include "_hobase.h"
 #include <kernel/ke/sinks/console_sink.h>
+#include <kernel/ke/console.h>
 
 #define MAX_MUX_SINKS 3
 
+// Rows the coalescing pass tracks; DrawRow on a lower row is never coalesced.
+#define MUX_SINK_COALESCE_ROWS 256U
+
+typedef enum MUX_SINK_OP_KIND
+{
+    MUX_SINK_OP_PUT_CHAR = 0,
+    MUX_SINK_OP_SCROLL,
+    MUX_SINK_OP_CLEAR,
+    MUX_SINK_OP_DRAW_ROW,
+    MUX_SINK_OP_FLUSH,
+} MUX_SINK_OP_KIND;
+
+// One sink call, recorded for a lane's drain thread. DrawRow keeps the device's
+// cell pointer rather than a copy: the row is drawn as it is when the operation is
+// applied, and any later change to it is queued behind as an operation of its own.
+typedef struct MUX_SINK_OP
+{
+    const KE_CONSOLE_CELL *Cells; // DrawRow
+    COLOR32 Foreground;           // PutChar
+    COLOR32 Background;           // PutChar; the fill colour of Scroll, Clear and DrawRow
+    uint16_t X;                   // PutChar
+    uint16_t Y;                   // PutChar, DrawRow
+    uint16_t Count;               // Scroll lines, DrawRow cells
+    uint8_t Kind;                 // MUX_SINK_OP_KIND
+    BOOL Superseded;              // Scratch mark of the coalescing pass
+    char Char;                    // PutChar
+} MUX_SINK_OP;
+
+typedef void (*MUX_SINK_LANE_NOTIFY)(void *context);
+
+// Per-sink queue. Head and Tail are free-running. Callers serialize on the console
+// critical section; the panic path takes the lanes over without it.
+typedef struct MUX_SINK_LANE
+{
+    MUX_SINK_OP *Ops; // Capacity entries, allocated by KeMuxConSinkSetupQueue
+    uint32_t Capacity;
+    uint32_t Head;
+    uint32_t Tail;
+    CONSOLE_SINK_QUEUE_POLICY Policy;
+    BOOL WakePending; // Notify was called and the drainer has not started a pass since
+    MUX_SINK_LANE_NOTIFY Notify;
+    void *NotifyContext;
+    CONSOLE_SINK_QUEUE_STATS Stats; // Counters only; the rest is filled in by the query
+} MUX_SINK_LANE;
+
 HO_INTERNAL_STRUCT typedef struct
 {
     KE_CONSOLE_SINK Base;
@@ -22,8 +68,24 @@ HO_INTERNAL_STRUCT typedef struct
     size_t SinkCapacity;
     size_t SinkCount;
     BOOL UsesAllocatorStorage;
+    MUX_SINK_LANE Lanes[MAX_MUX_SINKS]; // Lanes[i] feeds Sinks[i]
 } MUX_CONSOLE_SINK;
 
 HO_KERNEL_API HO_STATUS KeMuxConSinkInit(MUX_CONSOLE_SINK *muxSink);
 HO_KERNEL_API HO_STATUS KeMuxConSinkAddSink(MUX_CONSOLE_SINK *muxSink, KE_CONSOLE_SINK *sink);
 HO_KERNEL_API HO_STATUS KeMuxConSinkPromoteToAllocator(MUX_CONSOLE_SINK *muxSink);
+
+// Allocate a lane's queue (capacity is a power of two). The lane stays direct until
+// a queued policy is set; notify runs in the writer's context, inside its critical
+// section, when an operation lands in a lane whose drainer has not been woken yet.
+HO_KERNEL_API HO_STATUS KeMuxConSinkSetupQueue(MUX_CONSOLE_SINK *muxSink, uint32_t lane, uint32_t capacity,
+                                               MUX_SINK_LANE_NOTIFY notify, void *context);
+// Switching to CONSOLE_SINK_QUEUE_DIRECT applies everything queued first.
+HO_KERNEL_API HO_STATUS KeMuxConSinkSetPolicy(MUX_CONSOLE_SINK *muxSink, uint32_t lane,
+                                              CONSOLE_SINK_QUEUE_POLICY policy);
+// Apply up to budget queued operations in order. Returns how many are still queued.
+HO_KERNEL_API uint32_t KeMuxConSinkDrainLane(MUX_CONSOLE_SINK *muxSink, uint32_t lane, uint32_t budget);
+HO_KERNEL_API void KeMuxConSinkSyncLane(MUX_CONSOLE_SINK *muxSink, uint32_t lane);
+HO_KERNEL_API void KeMuxConSinkSyncAll(MUX_CONSOLE_SINK *muxSink);
+HO_KERNEL_API HO_STATUS KeMuxConSinkQueryLaneStats(MUX_CONSOLE_SINK *muxSink, uint32_t lane,
+                                                   CONSOLE_SINK_QUEUE_STATS *stats);
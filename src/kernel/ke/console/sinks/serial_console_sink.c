@@ -8,12 +8,117 @@
  */
 
 #include "serial_console_sink.h"
+#include <arch/arch.h>
+#include <libc/string.h>
+
+#define SERIAL_CONSOLE_TX_RING_MASK (SERIAL_CONSOLE_TX_RING_SIZE - 1U)
+
+// Interrupts must be disabled. Moves up to one FIFO load from the ring to the
+// UART; THRE must be set. Returns the number of bytes written.
+static uint32_t
+SerialConSinkFillFifo(SERIAL_CONSOLE_SINK *sink)
+{
+    uint32_t pending = sink->TxHead - sink->TxTail;
+    if (pending == 0)
+    {
+        sink->TxActive = FALSE;
+        return 0;
+    }
+
+    uint32_t count = pending < SERIAL_FIFO_DEPTH ? pending : SERIAL_FIFO_DEPTH;
+    uint32_t offset = sink->TxTail & SERIAL_CONSOLE_TX_RING_MASK;
+    uint32_t first = SERIAL_CONSOLE_TX_RING_SIZE - offset;
+    if (first > count)
+        first = count;
+
+    SerialWriteFifo(sink->Port, &sink->TxRing[offset], first);
+    if (first < count)
+        SerialWriteFifo(sink->Port, &sink->TxRing[0], count - first);
+
+    sink->TxTail += count;
+    sink->TxActive = TRUE;
+    return count;
+}
+
+// Interrupts must be disabled. Empties the ring by polling THRE.
+static void
+SerialConSinkDrainRingLocked(SERIAL_CONSOLE_SINK *sink)
+{
+    while (sink->TxHead != sink->TxTail)
+    {
+        while (!SerialIsTransmitReady(sink->Port))
+            ;
+        sink->Stats.PolledBytes += SerialConSinkFillFifo(sink);
+    }
+    sink->TxActive = FALSE;
+}
+
+// Empties the ring one FIFO load per interrupt-masked window, so a slow UART
+// does not hold interrupts off for the whole backlog.
+static void
+SerialConSinkDrainRing(SERIAL_CONSOLE_SINK *sink)
+{
+    for (;;)
+    {
+        ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+        if (sink->TxHead == sink->TxTail)
+        {
+            ArchRestoreInterruptState(interruptState);
+            return;
+        }
+        if (SerialIsTransmitReady(sink->Port))
+            sink->Stats.PolledBytes += SerialConSinkFillFifo(sink);
+        ArchRestoreInterruptState(interruptState);
+    }
+}
+
+static void
+SerialConSinkWriteByte(SERIAL_CONSOLE_SINK *sink, char c)
+{
+    if (!sink->InterruptTx)
+    {
+        SerialWriteByte(sink->Port, c);
+        sink->Stats.PolledBytes++;
+        return;
+    }
+
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+
+    if (sink->TxHead - sink->TxTail == SERIAL_CONSOLE_TX_RING_SIZE)
+    {
+        // Console output is never dropped: push one FIFO load out by hand.
+        sink->Stats.RingFullCount++;
+        while (!SerialIsTransmitReady(sink->Port))
+            ;
+        sink->Stats.PolledBytes += SerialConSinkFillFifo(sink);
+    }
+
+    sink->TxRing[sink->TxHead & SERIAL_CONSOLE_TX_RING_MASK] = c;
+    sink->TxHead++;
+    sink->Stats.QueuedBytes++;
+
+    uint32_t depth = sink->TxHead - sink->TxTail;
+    if (depth > sink->Stats.MaxQueueDepth)
+        sink->Stats.MaxQueueDepth = depth;
+
+    if (!sink->TxActive)
+    {
+        // Idle transmitter: no THRE interrupt is coming until the FIFO is fed once.
+        sink->Stats.KickCount++;
+        if (SerialIsTransmitReady(sink->Port))
+            sink->Stats.FifoBytes += SerialConSinkFillFifo(sink);
+        else
+            sink->TxActive = TRUE;
+    }
+
+    ArchRestoreInterruptState(interruptState);
+}
 
 static inline void
 SerialConSinkEmitCrlf(SERIAL_CONSOLE_SINK *sink)
 {
-    SerialWriteByte(sink->Port, '\r');
-    SerialWriteByte(sink->Port, '\n');
+    SerialConSinkWriteByte(sink, '\r');
+    SerialConSinkWriteByte(sink, '\n');
     sink->CurrentColumn = 0;
 }
 
@@ -28,13 +133,13 @@ SerialConSinkAdvanceCursor(SERIAL_CONSOLE_SINK *sink, uint16_t x, uint16_t y)
 
     if (x < sink->CurrentColumn)
     {
-        SerialWriteByte(sink->Port, '\r');
+        SerialConSinkWriteByte(sink, '\r');
         sink->CurrentColumn = 0;
     }
 
     while (sink->CurrentColumn < x)
     {
-        SerialWriteByte(sink->Port, ' ');
+        SerialConSinkWriteByte(sink, ' ');
         sink->CurrentColumn++;
     }
 }
@@ -56,7 +161,7 @@ SerialConSinkPutChar(
     SERIAL_CONSOLE_SINK *sink = (SERIAL_CONSOLE_SINK *)self;
 
     SerialConSinkAdvanceCursor(sink, x, y);
-    SerialWriteByte(sink->Port, c);
+    SerialConSinkWriteByte(sink, c);
     sink->CurrentColumn++;
     return EC_SUCCESS;
 }
@@ -92,9 +197,16 @@ KeSerialConSinkInit(SERIAL_CONSOLE_SINK *sink, uint16_t port)
     sink->Base.PutChar = SerialConSinkPutChar;
     sink->Base.Scroll = SerialConSinkScroll;
     sink->Base.Clear = SerialConSinkClear;
+    sink->Base.DrawRow = NULL; // Serial output is a stream; it has no rows to repaint
+    sink->Base.Flush = NULL;   // Bytes leave through the TX ring on their own
     sink->Port = port;
     sink->CurrentRow = 0;
     sink->CurrentColumn = 0;
+    sink->InterruptTx = FALSE;
+    sink->TxActive = FALSE;
+    sink->TxHead = 0;
+    sink->TxTail = 0;
+    memset(&sink->Stats, 0, sizeof(sink->Stats));
 }
 
 void
@@ -107,6 +219,7 @@ KeSerialConSinkFlushPendingCursor(SERIAL_CONSOLE_SINK *sink, uint16_t x, uint16_
     {
         sink->CurrentRow = y;
         sink->CurrentColumn = x;
+        SerialConSinkDrainRing(sink);
         SerialDrain(sink->Port);
         return;
     }
@@ -119,12 +232,81 @@ KeSerialConSinkFlushPendingCursor(SERIAL_CONSOLE_SINK *sink, uint16_t x, uint16_
 
     if (x < sink->CurrentColumn)
     {
-        SerialWriteByte(sink->Port, '\r');
+        SerialConSinkWriteByte(sink, '\r');
         sink->CurrentColumn = 0;
     }
 
     if (x > sink->CurrentColumn)
         sink->CurrentColumn = x;
 
+    SerialConSinkDrainRing(sink);
     SerialDrain(sink->Port);
 }
+
+void
+KeSerialConSinkSetInterruptTx(SERIAL_CONSOLE_SINK *sink, BOOL enable)
+{
+    if (!sink)
+        return;
+
+    if (!enable)
+    {
+        // Drain with interrupts mostly enabled, then close the window on the remainder.
+        SerialConSinkDrainRing(sink);
+    }
+
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    if (enable && !sink->InterruptTx)
+    {
+        sink->TxActive = FALSE;
+        sink->InterruptTx = TRUE;
+        SerialSetTransmitInterrupt(sink->Port, TRUE);
+    }
+    else if (!enable && sink->InterruptTx)
+    {
+        SerialSetTransmitInterrupt(sink->Port, FALSE);
+        SerialConSinkDrainRingLocked(sink);
+        sink->InterruptTx = FALSE;
+    }
+    ArchRestoreInterruptState(interruptState);
+}
+
+void
+KeSerialConSinkInterruptHandler(MAYBE_UNUSED void *frame, void *context)
+{
+    SERIAL_CONSOLE_SINK *sink = (SERIAL_CONSOLE_SINK *)context;
+
+    // Reading IIR acknowledges a THRE interrupt. LSR is checked rather than the
+    // IIR id so a refill also happens when a producer kick raced the interrupt.
+    (void)SerialReadInterruptId(sink->Port);
+    sink->Stats.InterruptCount++;
+
+    if (sink->InterruptTx && SerialIsTransmitReady(sink->Port))
+        sink->Stats.FifoBytes += SerialConSinkFillFifo(sink);
+
+    SerialAcknowledgeIrq();
+}
+
+void
+KeSerialConSinkQueryStats(SERIAL_CONSOLE_SINK *sink, CONSOLE_SERIAL_TX_STATS *stats)
+{
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    *stats = sink->Stats;
+    stats->InterruptDriven = sink->InterruptTx;
+    stats->RingSize = SERIAL_CONSOLE_TX_RING_SIZE;
+    stats->QueueDepth = sink->TxHead - sink->TxTail;
+    ArchRestoreInterruptState(interruptState);
+}
+
+uint64_t
+KeSerialConSinkWriteRaw(SERIAL_CONSOLE_SINK *sink, const char *buffer, uint64_t length)
+{
+    if (!sink || !buffer)
+        return 0;
+
+    for (uint64_t index = 0; index < length; ++index)
+        SerialConSinkWriteByte(sink, buffer[index]);
+
+    sink->CurrentColumn = 0;
+    return length;
+}
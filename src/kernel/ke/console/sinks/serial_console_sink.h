@@ -12,6 +12,9 @@
 #include "_hobase.h"
 #include <kernel/ke/sinks/console_sink.h>
 #include <drivers/serial.h>
+#include <kernel/ke/console.h>
+
+#define SERIAL_CONSOLE_TX_RING_SIZE 8192U // Must be a power of two
 
 HO_INTERNAL_STRUCT typedef struct
 {
@@ -19,7 +22,25 @@ HO_INTERNAL_STRUCT typedef struct
     uint16_t Port;
     uint16_t CurrentRow;
     uint16_t CurrentColumn;
+
+    // Interrupt-driven transmit. Head and Tail are free-running; every access
+    // happens with interrupts disabled, which also serializes against the ISR.
+    BOOL InterruptTx;
+    BOOL TxActive; // A FIFO burst is in flight and a THRE interrupt will refill it
+    uint32_t TxHead;
+    uint32_t TxTail;
+    CONSOLE_SERIAL_TX_STATS Stats;
+    char TxRing[SERIAL_CONSOLE_TX_RING_SIZE];
 } SERIAL_CONSOLE_SINK;
 
 HO_KERNEL_API void KeSerialConSinkInit(SERIAL_CONSOLE_SINK *sink, uint16_t port);
 HO_KERNEL_API void KeSerialConSinkFlushPendingCursor(SERIAL_CONSOLE_SINK *sink, uint16_t x, uint16_t y);
+
+// Switch between the polled path and the ring + THRE interrupt path. Turning the
+// interrupt path off drains the ring first, so no queued byte is lost or reordered.
+HO_KERNEL_API void KeSerialConSinkSetInterruptTx(SERIAL_CONSOLE_SINK *sink, BOOL enable);
+HO_KERNEL_API void KeSerialConSinkInterruptHandler(void *frame, void *context);
+HO_KERNEL_API void KeSerialConSinkQueryStats(SERIAL_CONSOLE_SINK *sink, CONSOLE_SERIAL_TX_STATS *stats);
+
+// Write bytes past the cursor model. The caller passes whole CRLF-terminated lines.
+HO_KERNEL_API uint64_t KeSerialConSinkWriteRaw(SERIAL_CONSOLE_SINK *sink, const char *buffer, uint64_t length);
@@ -8,12 +8,19 @@
  */
 
 #include <kernel/ke/critical_section.h>
+#include <kernel/ke/lock_profile.h>
 #include <kernel/hodbg.h>
+#include <arch/amd64/asm.h>
 
 static uint32_t gCriticalSectionDepth;
 
+#if HO_ENABLE_LOCK_PROFILE
+HO_KERNEL_API void
+KeEnterCriticalSectionAt(KE_CRITICAL_SECTION *guard, const char *function, uint32_t line)
+#else
 HO_KERNEL_API void
 KeEnterCriticalSection(KE_CRITICAL_SECTION *guard)
+#endif
 {
     HO_KASSERT(guard != NULL, EC_ILLEGAL_ARGUMENT);
     HO_KASSERT(!guard->Active, EC_INVALID_STATE);
@@ -24,6 +31,12 @@ KeEnterCriticalSection(KE_CRITICAL_SECTION *guard)
 
     guard->EnterDepth = gCriticalSectionDepth;
     guard->Active = TRUE;
+
+#if HO_ENABLE_LOCK_PROFILE
+    guard->SiteFunction = function;
+    guard->SiteLine = line;
+    guard->EnterTsc = rdtsc();
+#endif
 }
 
 HO_KERNEL_API void
@@ -34,6 +47,11 @@ KeLeaveCriticalSection(KE_CRITICAL_SECTION *guard)
     HO_KASSERT(gCriticalSectionDepth != 0, EC_INVALID_STATE);
     HO_KASSERT(guard->EnterDepth == gCriticalSectionDepth, EC_INVALID_STATE);
 
+#if HO_ENABLE_LOCK_PROFILE
+    // Recorded before the IRQL guard drops, while interrupts are still off.
+    KiLockProfileSiteLeave(guard->SiteFunction, guard->SiteLine, guard->EnterTsc);
+#endif
+
     gCriticalSectionDepth--;
 
     guard->Active = FALSE;
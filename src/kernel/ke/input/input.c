@@ -3,6 +3,9 @@
  *
  * File: ke/input/input.c
  * Description: Bounded runtime keyboard input lane for foreground-owned lines.
+ * The keyboard ISR only drains the controller into a scan-code ring and
+ * acknowledges; translation and line discipline run in a DPC, and console
+ * echo plus logging run on the high-priority work-queue lane.
  * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
  */
 
@@ -12,13 +15,18 @@
 #include <kernel/hodbg.h>
 #include <kernel/ke/console.h>
 #include <kernel/ke/critical_section.h>
+#include <kernel/ke/dpc.h>
 #include <kernel/ke/event.h>
 #include <kernel/ke/input.h>
+#include <kernel/ke/lock_profile.h>
 #include <kernel/ke/scheduler.h>
+#include <kernel/ke/work_queue.h>
 #include <libc/string.h>
 
-#define KE_INPUT_IRQ_VECTOR 0x21U
+#define KE_INPUT_IRQ_VECTOR               0x21U
 #define KE_INPUT_OWNER_RECHECK_TIMEOUT_NS 10000000ULL
+#define KE_INPUT_SCANCODE_RING_CAPACITY   64U
+#define KE_INPUT_ECHO_RING_CAPACITY       256U
 
 typedef struct KE_INPUT_DEVICE
 {
@@ -35,14 +43,34 @@ typedef struct KE_INPUT_DEVICE
     BOOL ShiftDown;
     BOOL Initialized;
     uint8_t Vector;
+
+    // ISR -> DPC: raw scan codes; both sides run with interrupts disabled.
+    KDPC ScanCodeDpc;
+    uint8_t ScanCodeRing[KE_INPUT_SCANCODE_RING_CAPACITY];
+    uint32_t ScanCodeHead;
+    uint32_t ScanCodeTail;
+    uint64_t DroppedScanCodeCount;
+
+    // DPC -> worker: echo characters and the deferred line-ready log record.
+    KWORK_ITEM EchoWorkItem;
+    char EchoRing[KE_INPUT_ECHO_RING_CAPACITY];
+    uint32_t EchoHead;
+    uint32_t EchoTail;
+    uint64_t DroppedEchoCount;
+    BOOL LineReadyLogPending;
+    uint32_t LineReadyLogBytes;
+    uint32_t LineReadyLogOwner;
 } KE_INPUT_DEVICE;
 
 static KE_INPUT_DEVICE gInputDevice;
 static KE_PS2_KEYBOARD_SINK gPs2KeyboardSink;
 
 static void KiKeyboardInterruptHandler(void *frame, void *context);
+static void KiKeyboardDpcRoutine(KDPC *dpc, void *context);
+static void KiKeyboardEchoWorkRoutine(KWORK_ITEM *item, void *context);
 static char KiTranslateSet1ScanCode(uint8_t scanCode, BOOL shifted);
 static void KiHandleTranslatedInputChar(char character);
+static void KiQueueInputEcho(char character);
 static HO_STATUS KiValidateForegroundCurrentThread(void);
 
 static const char kPs2Set1AsciiMap[128] = {
@@ -78,6 +106,21 @@ KiTranslateSet1ScanCode(uint8_t scanCode, BOOL shifted)
     return shifted ? kPs2Set1ShiftAsciiMap[scanCode] : kPs2Set1AsciiMap[scanCode];
 }
 
+static void
+KiQueueInputEcho(char character)
+{
+    uint32_t next = (gInputDevice.EchoHead + 1U) % KE_INPUT_ECHO_RING_CAPACITY;
+
+    if (next == gInputDevice.EchoTail)
+    {
+        gInputDevice.DroppedEchoCount++;
+        return;
+    }
+
+    gInputDevice.EchoRing[gInputDevice.EchoHead] = character;
+    gInputDevice.EchoHead = next;
+}
+
 static void
 KiHandleTranslatedInputChar(char character)
 {
@@ -90,7 +133,7 @@ KiHandleTranslatedInputChar(char character)
             return;
 
         gInputDevice.CurrentLineLength--;
-        (void)ConsoleWriteChar('\b');
+        KiQueueInputEcho('\b');
         return;
     }
 
@@ -107,12 +150,11 @@ KiHandleTranslatedInputChar(char character)
         gInputDevice.CurrentLineLength = 0U;
         memset(gInputDevice.CurrentLine, 0, sizeof(gInputDevice.CurrentLine));
 
-        (void)ConsoleWriteChar('\n');
+        KiQueueInputEcho('\n');
         KeSetEvent(&gInputDevice.LineReadyEvent);
-        klog(KLOG_LEVEL_INFO,
-             "[INPUT] line ready bytes=%u owner=%u\n",
-             gInputDevice.CompletedLineLength,
-             gInputDevice.ForegroundOwnerThreadId);
+        gInputDevice.LineReadyLogPending = TRUE;
+        gInputDevice.LineReadyLogBytes = gInputDevice.CompletedLineLength;
+        gInputDevice.LineReadyLogOwner = gInputDevice.ForegroundOwnerThreadId;
         return;
     }
 
@@ -123,7 +165,7 @@ KiHandleTranslatedInputChar(char character)
         return;
 
     gInputDevice.CurrentLine[gInputDevice.CurrentLineLength++] = character;
-    (void)ConsoleWriteChar(character);
+    KiQueueInputEcho(character);
 }
 
 static HO_STATUS
@@ -144,19 +186,39 @@ static void
 KiKeyboardInterruptHandler(MAYBE_UNUSED void *frame, void *context)
 {
     KE_INPUT_SINK *sink = (KE_INPUT_SINK *)context;
-    KE_CRITICAL_SECTION guard = {0};
 
     if (sink == NULL || sink->ReadScanCode == NULL || sink->AcknowledgeInterrupt == NULL)
         return;
 
-    KeEnterCriticalSection(&guard);
-
     while (sink->HasPendingData != NULL && sink->HasPendingData(gInputDevice.ActiveSinkContext))
     {
         uint8_t scanCode = 0;
         if (sink->ReadScanCode(gInputDevice.ActiveSinkContext, &scanCode) != EC_SUCCESS)
             break;
 
+        uint32_t next = (gInputDevice.ScanCodeHead + 1U) % KE_INPUT_SCANCODE_RING_CAPACITY;
+        if (next == gInputDevice.ScanCodeTail)
+        {
+            gInputDevice.DroppedScanCodeCount++;
+            continue;
+        }
+
+        gInputDevice.ScanCodeRing[gInputDevice.ScanCodeHead] = scanCode;
+        gInputDevice.ScanCodeHead = next;
+    }
+
+    sink->AcknowledgeInterrupt(gInputDevice.ActiveSinkContext);
+    (void)KeInsertQueueDpc(&gInputDevice.ScanCodeDpc);
+}
+
+static void
+KiKeyboardDpcRoutine(MAYBE_UNUSED KDPC *dpc, MAYBE_UNUSED void *context)
+{
+    while (gInputDevice.ScanCodeTail != gInputDevice.ScanCodeHead)
+    {
+        uint8_t scanCode = gInputDevice.ScanCodeRing[gInputDevice.ScanCodeTail];
+        gInputDevice.ScanCodeTail = (gInputDevice.ScanCodeTail + 1U) % KE_INPUT_SCANCODE_RING_CAPACITY;
+
         if (scanCode == 0x2AU || scanCode == 0x36U)
         {
             gInputDevice.ShiftDown = TRUE;
@@ -177,8 +239,58 @@ KiKeyboardInterruptHandler(MAYBE_UNUSED void *frame, void *context)
             KiHandleTranslatedInputChar(character);
     }
 
-    sink->AcknowledgeInterrupt(gInputDevice.ActiveSinkContext);
-    KeLeaveCriticalSection(&guard);
+    if (gInputDevice.EchoTail == gInputDevice.EchoHead && !gInputDevice.LineReadyLogPending)
+        return;
+
+    if (KeWorkQueueIsReady())
+    {
+        // EC_INVALID_STATE only means the worker has not picked up the previous batch yet.
+        (void)KeQueueWorkItem(&gInputDevice.EchoWorkItem, KTHREAD_PRIORITY_HIGH);
+        return;
+    }
+
+    KiKeyboardEchoWorkRoutine(&gInputDevice.EchoWorkItem, NULL);
+}
+
+static void
+KiKeyboardEchoWorkRoutine(MAYBE_UNUSED KWORK_ITEM *item, MAYBE_UNUSED void *context)
+{
+    for (;;)
+    {
+        KE_CRITICAL_SECTION guard = {0};
+        char character = 0;
+        BOOL haveCharacter = FALSE;
+        BOOL logLineReady = FALSE;
+        uint32_t logBytes = 0;
+        uint32_t logOwner = 0;
+
+        KeEnterCriticalSection(&guard);
+        if (gInputDevice.EchoTail != gInputDevice.EchoHead)
+        {
+            character = gInputDevice.EchoRing[gInputDevice.EchoTail];
+            gInputDevice.EchoTail = (gInputDevice.EchoTail + 1U) % KE_INPUT_ECHO_RING_CAPACITY;
+            haveCharacter = TRUE;
+        }
+        else if (gInputDevice.LineReadyLogPending)
+        {
+            logLineReady = TRUE;
+            logBytes = gInputDevice.LineReadyLogBytes;
+            logOwner = gInputDevice.LineReadyLogOwner;
+            gInputDevice.LineReadyLogPending = FALSE;
+        }
+        KeLeaveCriticalSection(&guard);
+
+        if (haveCharacter)
+        {
+            (void)ConsoleWriteChar(character);
+            continue;
+        }
+
+        if (logLineReady)
+            klog(KLOG_LEVEL_INFO, "[INPUT] line ready bytes=%u owner=%u\n", logBytes, logOwner);
+
+        return;
+    }
 }
 
 HO_KERNEL_API HO_STATUS
@@ -193,6 +305,9 @@ KeInputInit(void)
     gInputDevice.ActiveSinkContext = &gPs2KeyboardSink;
     gInputDevice.Vector = KE_INPUT_IRQ_VECTOR;
     KeInitializeEvent(&gInputDevice.LineReadyEvent, FALSE);
+    (void)KeRegisterLockProfile(&gInputDevice.LineReadyEvent, "ke.input.line");
+    KeInitializeDpc(&gInputDevice.ScanCodeDpc, KiKeyboardDpcRoutine, NULL);
+    KeInitializeWorkItem(&gInputDevice.EchoWorkItem, KiKeyboardEchoWorkRoutine, NULL);
 
     status = gInputDevice.ActiveSink->Init(gInputDevice.ActiveSinkContext);
     if (status != EC_SUCCESS)
@@ -8,6 +8,8 @@
  */
 
 #include <kernel/ke/irql.h>
+#include <kernel/ke/dpc.h>
+#include <kernel/ke/idle.h>
 #include <kernel/hodbg.h>
 
 static KE_IRQL_STATE gBootstrapIrqlState = {
@@ -118,6 +120,14 @@ KeReleaseIrqlGuard(KE_IRQL_GUARD *guard)
     HO_KASSERT(state->DispatchDepth != 0, EC_INVALID_STATE);
     HO_KASSERT(guard->EnterDepth == state->DispatchDepth, EC_INVALID_STATE);
 
+    // Outermost guard about to re-enable interrupts: this is the drop from
+    // DISPATCH_LEVEL, so retire DPCs queued while the guard was held.
+    if (guard->Transitioned && guard->SavedInterruptState.MaskableInterruptEnabled)
+    {
+        (void)KiRetireDpcQueue();
+        HO_KASSERT(guard->EnterDepth == state->DispatchDepth, EC_INVALID_STATE);
+    }
+
     state->DispatchDepth--;
     state->CurrentLevel = state->DispatchDepth == 0 ? guard->PreviousLevel : KE_IRQL_DISPATCH_LEVEL;
 
@@ -149,10 +159,14 @@ KeEnterInterruptContext(void)
     state->InterruptDepth++;
     state->CurrentLevel = KE_IRQL_DISPATCH_LEVEL;
 
+    // The outermost interrupt is the wake event when it lands on a halted CPU.
+    if (state->InterruptDepth == 1)
+        KiIdleNoteInterrupt();
+
     KiAssertIrqlState(state);
 }
 
-HO_KERNEL_API void
+HO_KERNEL_API BOOL
 KeLeaveInterruptContext(void)
 {
     KE_IRQL_STATE *state = KiGetCurrentIrqlState();
@@ -162,9 +176,19 @@ KeLeaveInterruptContext(void)
     HO_KASSERT(state->DispatchDepth != 0, EC_INVALID_STATE);
     HO_KASSERT(state->DispatchDepth == state->InterruptDepth, EC_INVALID_STATE);
 
+    // Leaving the outermost interrupt: run the work its ISR deferred while
+    // still at DISPATCH_LEVEL.
+    BOOL sameThread = TRUE;
+    if (state->InterruptDepth == 1U)
+    {
+        sameThread = KiRetireDpcQueue();
+        HO_KASSERT(state->InterruptDepth == 1U && state->DispatchDepth == 1U, EC_INVALID_STATE);
+    }
+
     state->InterruptDepth--;
     state->DispatchDepth--;
     state->CurrentLevel = state->DispatchDepth == 0 ? KE_IRQL_PASSIVE_LEVEL : KE_IRQL_DISPATCH_LEVEL;
 
     KiAssertIrqlState(state);
+    return sameThread;
 }
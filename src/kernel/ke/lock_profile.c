@@ -0,0 +1,388 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/lock_profile.c
+ * Description:
+ * Ke Layer - Lock contention and hold-time profiler (HO_ENABLE_LOCK_PROFILE).
+ * Every hook runs at DISPATCH_LEVEL with interrupts disabled, which is what
+ * serializes the tables on this UP kernel.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include <kernel/ke/lock_profile.h>
+#include <kernel/ke/critical_section.h>
+#include <kernel/hodbg.h>
+#include <arch/amd64/asm.h>
+#include <libc/string.h>
+
+#define KI_LOCK_PROFILE_RECORD_MAX (KE_LOCK_PROFILE_OBJECT_MAX + KE_LOCK_PROFILE_SITE_MAX)
+
+#if HO_ENABLE_LOCK_PROFILE
+
+typedef struct KE_LOCK_PROFILE_COUNTERS
+{
+    uint64_t AcquireCount;
+    uint64_t ContendedCount;
+    uint64_t TimeoutCount;
+    uint64_t TotalWaitCycles;
+    uint64_t MaxWaitCycles;
+    uint64_t TotalHoldCycles;
+    uint64_t MaxHoldCycles;
+} KE_LOCK_PROFILE_COUNTERS;
+
+typedef struct KE_LOCK_PROFILE_ENTRY
+{
+    KDISPATCHER_HEADER *Object;
+    const char *Name;
+    uint64_t HoldStartTsc; // 0 while not held exclusively
+    KE_LOCK_PROFILE_COUNTERS Counters;
+} KE_LOCK_PROFILE_ENTRY;
+
+typedef struct KE_LOCK_PROFILE_SITE
+{
+    const char *Function; // NULL = free slot
+    uint32_t Line;
+    KE_LOCK_PROFILE_COUNTERS Counters;
+} KE_LOCK_PROFILE_SITE;
+
+static KE_LOCK_PROFILE_ENTRY gLockProfileObjects[KE_LOCK_PROFILE_OBJECT_MAX];
+static uint32_t gLockProfileObjectCount;
+static uint32_t gLockProfileDroppedRegistrations;
+
+static KE_LOCK_PROFILE_SITE gLockProfileSites[KE_LOCK_PROFILE_SITE_MAX];
+static uint32_t gLockProfileSiteCount;
+static uint32_t gLockProfileDroppedSiteEntries;
+
+static void
+KiLockProfileAddSample(uint64_t *total, uint64_t *max, uint64_t cycles)
+{
+    *total += cycles;
+    if (cycles > *max)
+        *max = cycles;
+}
+
+// Internal: open-addressed lookup keyed by (function, line); inserts on a miss.
+static KE_LOCK_PROFILE_SITE *
+KiLockProfileLookupSite(const char *function, uint32_t line)
+{
+    uint32_t hash = (uint32_t)(((HO_VIRTUAL_ADDRESS)function >> 4) * 0x9E3779B1U) ^ (line * 0x85EBCA6BU);
+
+    for (uint32_t probe = 0; probe < KE_LOCK_PROFILE_SITE_MAX; ++probe)
+    {
+        KE_LOCK_PROFILE_SITE *site = &gLockProfileSites[(hash + probe) % KE_LOCK_PROFILE_SITE_MAX];
+
+        if (site->Function == function && site->Line == line)
+            return site;
+
+        if (site->Function == NULL)
+        {
+            site->Function = function;
+            site->Line = line;
+            gLockProfileSiteCount++;
+            return site;
+        }
+    }
+
+    return NULL;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Hooks
+// ─────────────────────────────────────────────────────────────
+
+uint64_t
+KiLockProfileWaitBegin(const KDISPATCHER_HEADER *header)
+{
+    return header->Profile != NULL ? rdtsc() : 0;
+}
+
+void
+KiLockProfileWaitEnd(KDISPATCHER_HEADER *header, uint64_t startTsc, BOOL blocked, HO_STATUS status)
+{
+    KE_LOCK_PROFILE_ENTRY *entry = header->Profile;
+    if (entry == NULL)
+        return;
+
+    KE_LOCK_PROFILE_COUNTERS *counters = &entry->Counters;
+
+    if (blocked)
+        KiLockProfileAddSample(&counters->TotalWaitCycles, &counters->MaxWaitCycles, rdtsc() - startTsc);
+
+    if (status == EC_SUCCESS)
+    {
+        counters->AcquireCount++;
+        if (blocked)
+            counters->ContendedCount++;
+    }
+    else if (status == EC_TIMEOUT)
+    {
+        counters->TimeoutCount++;
+    }
+}
+
+void
+KiLockProfileHoldBegin(KDISPATCHER_HEADER *header)
+{
+    KE_LOCK_PROFILE_ENTRY *entry = header->Profile;
+    if (entry != NULL)
+        entry->HoldStartTsc = rdtsc();
+}
+
+void
+KiLockProfileHoldEnd(KDISPATCHER_HEADER *header)
+{
+    KE_LOCK_PROFILE_ENTRY *entry = header->Profile;
+    if (entry == NULL || entry->HoldStartTsc == 0)
+        return;
+
+    KiLockProfileAddSample(&entry->Counters.TotalHoldCycles, &entry->Counters.MaxHoldCycles,
+                           rdtsc() - entry->HoldStartTsc);
+    entry->HoldStartTsc = 0;
+}
+
+void
+KiLockProfileSiteLeave(const char *function, uint32_t line, uint64_t enterTsc)
+{
+    uint64_t cycles = rdtsc() - enterTsc;
+
+    KE_LOCK_PROFILE_SITE *site = KiLockProfileLookupSite(function, line);
+    if (site == NULL)
+    {
+        gLockProfileDroppedSiteEntries++;
+        return;
+    }
+
+    site->Counters.AcquireCount++;
+    KiLockProfileAddSample(&site->Counters.TotalHoldCycles, &site->Counters.MaxHoldCycles, cycles);
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeRegisterLockProfile
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeRegisterLockProfile(void *object, const char *name)
+{
+    KDISPATCHER_HEADER *header = (KDISPATCHER_HEADER *)object;
+
+    if (header == NULL || name == NULL || header->Signature != KDISPATCHER_SIGNATURE)
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    HO_STATUS status = EC_SUCCESS;
+    KE_LOCK_PROFILE_ENTRY *existing = NULL;
+    for (uint32_t index = 0; index < gLockProfileObjectCount; ++index)
+    {
+        if (gLockProfileObjects[index].Object == header)
+            existing = &gLockProfileObjects[index];
+    }
+
+    if (header->Profile != NULL)
+    {
+        status = EC_INVALID_STATE;
+    }
+    else if (existing != NULL)
+    {
+        // Re-initialized since it was registered: pick the entry back up.
+        existing->Name = name;
+        existing->HoldStartTsc = 0;
+        header->Profile = existing;
+    }
+    else if (gLockProfileObjectCount >= KE_LOCK_PROFILE_OBJECT_MAX)
+    {
+        gLockProfileDroppedRegistrations++;
+        status = EC_OUT_OF_RESOURCE;
+    }
+    else
+    {
+        KE_LOCK_PROFILE_ENTRY *entry = &gLockProfileObjects[gLockProfileObjectCount++];
+        memset(entry, 0, sizeof(*entry));
+        entry->Object = header;
+        entry->Name = name;
+        header->Profile = entry;
+    }
+
+    KeLeaveCriticalSection(&criticalSection);
+
+    if (status == EC_OUT_OF_RESOURCE)
+        klog(KLOG_LEVEL_WARNING, "[LOCKPROF] Object table full, '%s' not profiled\n", name);
+    return status;
+}
+
+static void
+KiLockProfileFillRecord(KE_LOCK_PROFILE_RECORD *record, uint32_t kind, uint32_t objectType, const char *name,
+                        uint32_t line, const KE_LOCK_PROFILE_COUNTERS *counters)
+{
+    memset(record, 0, sizeof(*record));
+    record->Kind = kind;
+    record->ObjectType = objectType;
+    record->Line = line;
+
+    size_t nameLen = strlen(name);
+    if (nameLen >= KE_LOCK_PROFILE_NAME_LEN)
+        nameLen = KE_LOCK_PROFILE_NAME_LEN - 1;
+    memcpy(record->Name, name, nameLen);
+    record->Name[nameLen] = '\0';
+
+    record->AcquireCount = counters->AcquireCount;
+    record->ContendedCount = counters->ContendedCount;
+    record->TimeoutCount = counters->TimeoutCount;
+    record->TotalWaitCycles = counters->TotalWaitCycles;
+    record->MaxWaitCycles = counters->MaxWaitCycles;
+    record->TotalHoldCycles = counters->TotalHoldCycles;
+    record->MaxHoldCycles = counters->MaxHoldCycles;
+}
+
+#endif
+
+// ─────────────────────────────────────────────────────────────
+// Query / reset / dump
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API uint32_t
+KeQueryLockProfile(KE_LOCK_PROFILE_RECORD *records, uint32_t maxRecords, KE_LOCK_PROFILE_SUMMARY *summary)
+{
+    if (summary != NULL)
+        memset(summary, 0, sizeof(*summary));
+
+#if HO_ENABLE_LOCK_PROFILE
+    if (records == NULL)
+        maxRecords = 0;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (summary != NULL)
+    {
+        summary->Enabled = TRUE;
+        summary->ObjectCount = gLockProfileObjectCount;
+        summary->SiteCount = gLockProfileSiteCount;
+        summary->DroppedRegistrations = gLockProfileDroppedRegistrations;
+        summary->DroppedSiteEntries = gLockProfileDroppedSiteEntries;
+    }
+
+    // Selection of the top maxRecords: both tables are small and this is a diagnostic path.
+    BOOL taken[KI_LOCK_PROFILE_RECORD_MAX] = {0};
+    uint32_t written = 0;
+
+    while (written < maxRecords)
+    {
+        uint32_t best = KI_LOCK_PROFILE_RECORD_MAX;
+        uint64_t bestScore = 0;
+
+        for (uint32_t index = 0; index < KI_LOCK_PROFILE_RECORD_MAX; ++index)
+        {
+            const KE_LOCK_PROFILE_COUNTERS *counters = NULL;
+
+            if (taken[index])
+                continue;
+
+            if (index < KE_LOCK_PROFILE_OBJECT_MAX)
+            {
+                if (index >= gLockProfileObjectCount)
+                    continue;
+                counters = &gLockProfileObjects[index].Counters;
+            }
+            else
+            {
+                if (gLockProfileSites[index - KE_LOCK_PROFILE_OBJECT_MAX].Function == NULL)
+                    continue;
+                counters = &gLockProfileSites[index - KE_LOCK_PROFILE_OBJECT_MAX].Counters;
+            }
+
+            uint64_t score = counters->TotalWaitCycles + counters->TotalHoldCycles;
+            if (best == KI_LOCK_PROFILE_RECORD_MAX || score > bestScore)
+            {
+                best = index;
+                bestScore = score;
+            }
+        }
+
+        if (best == KI_LOCK_PROFILE_RECORD_MAX)
+            break;
+
+        taken[best] = TRUE;
+        if (best < KE_LOCK_PROFILE_OBJECT_MAX)
+        {
+            const KE_LOCK_PROFILE_ENTRY *entry = &gLockProfileObjects[best];
+            KiLockProfileFillRecord(&records[written], KE_LOCK_PROFILE_KIND_OBJECT, (uint32_t)entry->Object->Type,
+                                    entry->Name, 0, &entry->Counters);
+        }
+        else
+        {
+            const KE_LOCK_PROFILE_SITE *site = &gLockProfileSites[best - KE_LOCK_PROFILE_OBJECT_MAX];
+            KiLockProfileFillRecord(&records[written], KE_LOCK_PROFILE_KIND_CRITICAL_SECTION, 0, site->Function,
+                                    site->Line, &site->Counters);
+        }
+        written++;
+    }
+
+    KeLeaveCriticalSection(&criticalSection);
+    return written;
+#else
+    (void)records;
+    (void)maxRecords;
+    return 0;
+#endif
+}
+
+HO_KERNEL_API void
+KeResetLockProfile(void)
+{
+#if HO_ENABLE_LOCK_PROFILE
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    for (uint32_t index = 0; index < gLockProfileObjectCount; ++index)
+        memset(&gLockProfileObjects[index].Counters, 0, sizeof(KE_LOCK_PROFILE_COUNTERS));
+
+    for (uint32_t index = 0; index < KE_LOCK_PROFILE_SITE_MAX; ++index)
+        memset(&gLockProfileSites[index].Counters, 0, sizeof(KE_LOCK_PROFILE_COUNTERS));
+
+    gLockProfileDroppedSiteEntries = 0;
+
+    KeLeaveCriticalSection(&criticalSection);
+#endif
+}
+
+HO_KERNEL_API void
+KeDumpLockProfile(uint32_t maxEntries)
+{
+#if HO_ENABLE_LOCK_PROFILE
+    static KE_LOCK_PROFILE_RECORD records[KI_LOCK_PROFILE_RECORD_MAX];
+    KE_LOCK_PROFILE_SUMMARY summary;
+
+    if (maxEntries > KI_LOCK_PROFILE_RECORD_MAX)
+        maxEntries = KI_LOCK_PROFILE_RECORD_MAX;
+
+    uint32_t count = KeQueryLockProfile(records, maxEntries, &summary);
+
+    klog(KLOG_LEVEL_INFO, "[LOCKPROF] objects=%u sites=%u dropped_regs=%u dropped_sites=%u (cycles are TSC)\n",
+         summary.ObjectCount, summary.SiteCount, summary.DroppedRegistrations, summary.DroppedSiteEntries);
+
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        const KE_LOCK_PROFILE_RECORD *record = &records[index];
+
+        if (record->Kind == KE_LOCK_PROFILE_KIND_OBJECT)
+        {
+            klog(KLOG_LEVEL_INFO,
+                 "[LOCKPROF] #%u obj %s type=%u acq=%lu cont=%lu tmo=%lu wait=%lu/%lu hold=%lu/%lu\n", index,
+                 record->Name, record->ObjectType, (unsigned long)record->AcquireCount,
+                 (unsigned long)record->ContendedCount, (unsigned long)record->TimeoutCount,
+                 (unsigned long)record->TotalWaitCycles, (unsigned long)record->MaxWaitCycles,
+                 (unsigned long)record->TotalHoldCycles, (unsigned long)record->MaxHoldCycles);
+        }
+        else
+        {
+            klog(KLOG_LEVEL_INFO, "[LOCKPROF] #%u cs  %s:%u enter=%lu hold=%lu/%lu\n", index, record->Name,
+                 record->Line, (unsigned long)record->AcquireCount, (unsigned long)record->TotalHoldCycles,
+                 (unsigned long)record->MaxHoldCycles);
+        }
+    }
+#else
+    (void)maxEntries;
+#endif
+}
@@ -3,26 +3,368 @@
  *
  * File: ke/log/log.c
  * Description: Ke layer log mechanism with uptime timestamp prefix.
+ *              klog formats on the caller's stack and commits the line to a
+ *              per-CPU record ring; a low-priority drain thread pushes records
+ *              to the console sinks, so a DBG line no longer holds DISPATCH_LEVEL
+ *              for the serial and framebuffer work. Until the drain thread is up
+ *              the producer drains the ring itself, and a panic flushes the ring
+ *              and writes straight through from then on. Binary records (see
+ *              KE_KLOG_FORMAT) skip the formatter and reach the host as hex
+ *              lines on the serial port.
  * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
  */
 
 #include <kernel/log.h>
 
+#include <arch/arch.h>
+#include <kernel/hodbg.h>
 #include <kernel/ke/console.h>
-#include <kernel/ke/critical_section.h>
+#include <kernel/ke/dpc.h>
+#include <kernel/ke/event.h>
+#include <kernel/ke/scheduler.h>
 #include <kernel/ke/time_source.h>
+#include <libc/string.h>
 #include <stdarg.h>
 
-HO_KERNEL_API uint64_t
-KLogWriteFmt(enum KE_LOG_LEVEL level, const char *fmt, ...)
+#define KI_KLOG_MAX_CPU_COUNT   1U
+#define KI_KLOG_RING_MASK       ((uint64_t)KE_KLOG_RING_SIZE - 1U)
+#define KI_KLOG_RECORD_ALIGN    8U
+#define KI_KLOG_RECORD_MAX      ((uint32_t)sizeof(KI_KLOG_RECORD_HEADER) + KE_KLOG_LINE_MAX + KI_KLOG_RECORD_ALIGN)
+#define KI_KLOG_STATE_RESERVED  0U
+#define KI_KLOG_STATE_COMMITTED 1U
+#define KI_KLOG_RECORD_BINARY   0x01U
+
+// Records are 8-byte aligned and the ring size is a multiple of 8, so a
+// header never straddles the wrap point; only the text does.
+typedef struct KI_KLOG_RECORD_HEADER
 {
-    if (level < HO_LOG_MIN_LEVEL)
-        return 0;
+    uint16_t Length;     // Whole record: header, text and alignment padding
+    uint16_t TextLength; // Formatted bytes, no NUL; payload bytes for a binary record
+    volatile uint16_t State;
+    uint8_t Level;
+    uint8_t Flags; // KI_KLOG_RECORD_*
+} KI_KLOG_RECORD_HEADER;
+
+// Positions are free-running byte counts; Reclaim <= Tail <= Head and
+// Head - Reclaim <= KE_KLOG_RING_SIZE. [Reclaim, Tail) is drained history kept
+// for KLogReadRecent, [Tail, Head) is waiting for the console.
+//
+// Head, Reclaim and the counters only change with local interrupts masked for
+// a few instructions; no lock is taken, so klog is safe from ISRs and never
+// spins. The producer formats and copies its text outside that window.
+typedef struct KI_KLOG_RING
+{
+    uint64_t Head;
+    uint64_t Tail;
+    uint64_t Reclaim;
+    KE_KLOG_STATS Stats;
+    uint8_t Data[KE_KLOG_RING_SIZE] __attribute__((aligned(KI_KLOG_RECORD_ALIGN)));
+} KI_KLOG_RING;
 
-    uint64_t written = 0;
-    KE_CRITICAL_SECTION criticalSection = {0};
-    KeEnterCriticalSection(&criticalSection);
+// UP kernel: the single ring is the per-CPU ring of CPU 0.
+static KI_KLOG_RING gKlogRings[KI_KLOG_MAX_CPU_COUNT];
+static volatile uint32_t gKlogMode = KE_KLOG_MODE_SYNC;
+static volatile BOOL gKlogDraining;
+static volatile BOOL gKlogWakePending;
+static char gKlogDrainLine[KE_KLOG_LINE_MAX + 1]; // Owned by whoever holds gKlogDraining
+static char gKlogDrainHex[sizeof(KE_KLOG_BINARY_TAG) + KE_KLOG_LINE_MAX * 2U + 2U]; // Likewise
+static KTHREAD *gKlogDrainThread;
+static KEVENT gKlogWakeEvent;
+static KDPC gKlogWakeDpc;
+
+// Start of the .klog_fmt output section (himuos.ld).
+extern const KE_KLOG_FORMAT __klog_fmt_start[];
+
+static inline KI_KLOG_RING *
+KiKlogCurrentRing(void)
+{
+    return &gKlogRings[0];
+}
+
+static inline KI_KLOG_RECORD_HEADER *
+KiKlogHeaderAt(KI_KLOG_RING *ring, uint64_t position)
+{
+    return (KI_KLOG_RECORD_HEADER *)&ring->Data[position & KI_KLOG_RING_MASK];
+}
+
+static void
+KiKlogCopyIn(KI_KLOG_RING *ring, uint64_t position, const char *text, uint32_t length)
+{
+    uint32_t offset = (uint32_t)(position & KI_KLOG_RING_MASK);
+    uint32_t first = KE_KLOG_RING_SIZE - offset;
+    if (first > length)
+        first = length;
+
+    memcpy(&ring->Data[offset], text, first);
+    memcpy(&ring->Data[0], text + first, length - first);
+}
+
+static void
+KiKlogCopyOut(const KI_KLOG_RING *ring, uint64_t position, char *text, uint32_t length)
+{
+    uint32_t offset = (uint32_t)(position & KI_KLOG_RING_MASK);
+    uint32_t first = KE_KLOG_RING_SIZE - offset;
+    if (first > length)
+        first = length;
+
+    memcpy(text, &ring->Data[offset], first);
+    memcpy(text + first, &ring->Data[0], length - first);
+}
+
+static BOOL
+KiKlogIsValidRecord(const KI_KLOG_RECORD_HEADER *header)
+{
+    return header->Length >= sizeof(*header) && header->Length <= KI_KLOG_RECORD_MAX &&
+           (header->Length % KI_KLOG_RECORD_ALIGN) == 0 &&
+           header->TextLength <= header->Length - sizeof(*header) && header->TextLength <= KE_KLOG_LINE_MAX;
+}
 
+// Reserve a record for textLength bytes. Drained history is overwritten as
+// needed; undrained text never is, so a full ring fails the reservation.
+static BOOL
+KiKlogReserve(KI_KLOG_RING *ring, uint32_t textLength, uint8_t level, uint8_t flags, BOOL truncated,
+              uint64_t *outPosition)
+{
+    uint32_t recordLength = ((uint32_t)sizeof(KI_KLOG_RECORD_HEADER) + textLength + KI_KLOG_RECORD_ALIGN - 1U) &
+                            ~(KI_KLOG_RECORD_ALIGN - 1U);
+    BOOL reserved = FALSE;
+
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+
+    uint64_t head = ring->Head;
+    if (head + recordLength - ring->Tail <= KE_KLOG_RING_SIZE)
+    {
+        while (head + recordLength - ring->Reclaim > KE_KLOG_RING_SIZE)
+        {
+            const KI_KLOG_RECORD_HEADER *oldest = KiKlogHeaderAt(ring, ring->Reclaim);
+            if (!KiKlogIsValidRecord(oldest))
+            {
+                ring->Reclaim = ring->Tail;
+                break;
+            }
+            ring->Reclaim += oldest->Length;
+        }
+
+        KI_KLOG_RECORD_HEADER *header = KiKlogHeaderAt(ring, head);
+        header->Length = (uint16_t)recordLength;
+        header->TextLength = (uint16_t)textLength;
+        header->State = KI_KLOG_STATE_RESERVED;
+        header->Level = level;
+        header->Flags = flags;
+        ring->Head = head + recordLength;
+
+        uint32_t pending = (uint32_t)(ring->Head - ring->Tail);
+        if (pending > ring->Stats.MaxPendingBytes)
+            ring->Stats.MaxPendingBytes = pending;
+        ring->Stats.RecordCount++;
+        if (truncated)
+            ring->Stats.TruncatedCount++;
+        if ((flags & KI_KLOG_RECORD_BINARY) != 0)
+            ring->Stats.BinaryCount++;
+
+        *outPosition = head;
+        reserved = TRUE;
+    }
+
+    ArchRestoreInterruptState(interruptState);
+    return reserved;
+}
+
+static void
+KiKlogCommit(KI_KLOG_RING *ring, uint64_t position)
+{
+    // ArchDisableInterrupts is an out-of-line call and orders the text copy
+    // before the state store for the compiler; x86 keeps stores in order.
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    KiKlogHeaderAt(ring, position)->State = KI_KLOG_STATE_COMMITTED;
+    ArchRestoreInterruptState(interruptState);
+}
+
+static void
+KiKlogCount(uint64_t *counter)
+{
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    (*counter)++;
+    ArchRestoreInterruptState(interruptState);
+}
+
+static BOOL
+KiKlogTryAcquireDrain(void)
+{
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    BOOL acquired = !gKlogDraining;
+    gKlogDraining = TRUE;
+    ArchRestoreInterruptState(interruptState);
+    return acquired;
+}
+
+static BOOL
+KiKlogHasCommittedRecord(KI_KLOG_RING *ring)
+{
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    BOOL ready = ring->Tail != ring->Head && KiKlogHeaderAt(ring, ring->Tail)->State == KI_KLOG_STATE_COMMITTED;
+    ArchRestoreInterruptState(interruptState);
+    return ready;
+}
+
+// Binary records never reach the screen: the serial port gets one
+// KE_KLOG_BINARY_TAG line of hex for scripts/klog_decode.py to expand.
+static void
+KiKlogEmitBinary(const uint8_t *payload, uint32_t length)
+{
+    static const char digits[] = "0123456789abcdef";
+    uint32_t used = sizeof(KE_KLOG_BINARY_TAG) - 1U;
+
+    memcpy(gKlogDrainHex, KE_KLOG_BINARY_TAG, used);
+    for (uint32_t index = 0; index < length; ++index)
+    {
+        gKlogDrainHex[used++] = digits[payload[index] >> 4];
+        gKlogDrainHex[used++] = digits[payload[index] & 0x0FU];
+    }
+    gKlogDrainHex[used++] = '\r';
+    gKlogDrainHex[used++] = '\n';
+    (void)ConsoleWriteSerial(gKlogDrainHex, used);
+}
+
+// Push committed records to the console in ring order, stopping at the first
+// record still being filled in. Caller owns gKlogDraining.
+static void
+KiKlogDrainRing(KI_KLOG_RING *ring)
+{
+    while (KiKlogHasCommittedRecord(ring))
+    {
+        uint64_t tail = ring->Tail;
+        const KI_KLOG_RECORD_HEADER *header = KiKlogHeaderAt(ring, tail);
+        if (!KiKlogIsValidRecord(header))
+        {
+            // Only reachable on a corrupted ring (panic path); discard the backlog.
+            ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+            ring->Tail = ring->Head;
+            ring->Reclaim = ring->Head;
+            ArchRestoreInterruptState(interruptState);
+            break;
+        }
+
+        uint32_t textLength = header->TextLength;
+        uint32_t recordLength = header->Length;
+        BOOL binary = (header->Flags & KI_KLOG_RECORD_BINARY) != 0;
+        KiKlogCopyOut(ring, tail + sizeof(KI_KLOG_RECORD_HEADER), gKlogDrainLine, textLength);
+        if (binary)
+        {
+            KiKlogEmitBinary((const uint8_t *)gKlogDrainLine, textLength);
+        }
+        else
+        {
+            gKlogDrainLine[textLength] = '\0';
+            (void)ConsoleWrite(gKlogDrainLine);
+        }
+
+        ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+        ring->Tail = tail + recordLength;
+        ring->Stats.DrainedCount++;
+        ArchRestoreInterruptState(interruptState);
+    }
+}
+
+static void
+KiKlogDrain(KI_KLOG_RING *ring)
+{
+    // A record committed by an interrupt after the last check but before the
+    // release would otherwise wait for the next line; re-check after releasing.
+    do
+    {
+        if (!KiKlogTryAcquireDrain())
+            return;
+
+        KiKlogDrainRing(ring);
+        gKlogDraining = FALSE;
+    } while (KiKlogHasCommittedRecord(ring));
+}
+
+static void
+KiKlogWakeDpcRoutine(KDPC *dpc, void *context)
+{
+    (void)dpc;
+    (void)context;
+    KeSetEvent(&gKlogWakeEvent);
+}
+
+static void
+KiKlogRequestDrain(enum KE_LOG_LEVEL level)
+{
+    // The drain threads' own wait/wake paths are traced at DEBUG; letting those
+    // lines wake the klog drain would make every drain pass schedule the next one.
+    // They are printed with the next line from anywhere else.
+    KTHREAD *current = KeGetCurrentThread();
+    if (level == KLOG_LEVEL_DEBUG && current != NULL && (current->Flags & KTHREAD_FLAG_LOG_QUIET) != 0)
+        return;
+
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    BOOL alreadyPending = gKlogWakePending;
+    gKlogWakePending = TRUE;
+    ArchRestoreInterruptState(interruptState);
+
+    // KeSetEvent is not ISR-safe; the DPC raises it on the way out of the interrupt.
+    if (!alreadyPending)
+        (void)KeInsertQueueDpc(&gKlogWakeDpc);
+}
+
+static void
+KiKlogDrainThread(void *arg)
+{
+    (void)arg;
+    KI_KLOG_RING *ring = KiKlogCurrentRing();
+
+    for (;;)
+    {
+        HO_STATUS status = KeWaitForSingleObject(&gKlogWakeEvent, KE_WAIT_INFINITE);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "klog drain wait failed");
+
+        // Reset before clearing the pending flag: a line committed after this
+        // point raises a fresh wake, one committed before it is drained below.
+        KeResetEvent(&gKlogWakeEvent);
+        gKlogWakePending = FALSE;
+        KiKlogCount(&ring->Stats.DrainWakeCount);
+
+        KiKlogDrain(ring);
+    }
+}
+
+static uint64_t
+KiKlogFormatPrefix(char *buffer, uint64_t capacity, const char *fmt, ...)
+{
+    VA_LIST args;
+    VA_START(args, fmt);
+    uint64_t length = ConsoleFormatVFmt(buffer, capacity, fmt, args);
+    VA_END(args);
+    return length;
+}
+
+// Commit a finished record and get it to the console. Returns FALSE when the
+// ring had no room and the caller must write directly or drop the line.
+static BOOL
+KiKlogQueue(const void *payload, uint32_t length, enum KE_LOG_LEVEL level, uint8_t flags, BOOL truncated)
+{
+    KI_KLOG_RING *ring = KiKlogCurrentRing();
+    uint64_t position = 0;
+
+    if (!KiKlogReserve(ring, length, (uint8_t)level, flags, truncated, &position))
+        return FALSE;
+
+    KiKlogCopyIn(ring, position + sizeof(KI_KLOG_RECORD_HEADER), (const char *)payload, length);
+    KiKlogCommit(ring, position);
+
+    if (gKlogMode == KE_KLOG_MODE_SYNC)
+        KiKlogDrain(ring);
+    else
+        KiKlogRequestDrain(level);
+    return TRUE;
+}
+
+static uint64_t
+KiKlogWriteVFmt(enum KE_LOG_LEVEL level, const char *fmt, VA_LIST fmtArgs)
+{
     const char *levelStr = "";
     switch (level)
     {
@@ -42,25 +384,338 @@ KLogWriteFmt(enum KE_LOG_LEVEL level, const char *fmt, ...)
         levelStr = "[UNK] ";
         break;
     }
-    written += ConsoleWrite(levelStr);
+
+    char line[KE_KLOG_LINE_MAX];
+    uint64_t length = 0;
 
     if (KeIsTimeSourceReady())
     {
         uint64_t uptimeUs = KeGetSystemUpRealTime();
         uint64_t sec = uptimeUs / 1000000ULL;
         uint64_t fracUs = uptimeUs % 1000000ULL;
-        written += ConsoleWriteFmt("[+%04lu.%06lu] ", sec, fracUs);
+        length = KiKlogFormatPrefix(line, sizeof(line), "%s[+%04lu.%06lu] ", levelStr, sec, fracUs);
     }
     else
     {
-        written += ConsoleWrite("[+----.------] ");
+        length = KiKlogFormatPrefix(line, sizeof(line), "%s[+----.------] ", levelStr);
     }
 
+    if (length < sizeof(line) - 1U)
+        length += ConsoleFormatVFmt(line + length, sizeof(line) - length, fmt, fmtArgs);
+
+    // Keep the console line-aligned when a line is cut.
+    BOOL truncated = length >= sizeof(line);
+    uint32_t textLength = truncated ? (uint32_t)sizeof(line) - 1U : (uint32_t)length;
+    if (truncated)
+        line[textLength - 1U] = '\n';
+
+    KI_KLOG_RING *ring = KiKlogCurrentRing();
+    uint32_t mode = gKlogMode;
+
+    if (mode == KE_KLOG_MODE_PANIC || !KiKlogQueue(line, textLength, level, 0, truncated))
+    {
+        if (mode == KE_KLOG_MODE_ASYNC)
+        {
+            KiKlogCount(&ring->Stats.DroppedCount);
+            return 0;
+        }
+
+        // Panic, or an interrupt nested in an early-boot drain found no room.
+        KiKlogCount(&ring->Stats.DirectWriteCount);
+        (void)ConsoleWrite(line);
+    }
+
+    return textLength;
+}
+
+HO_KERNEL_API uint64_t
+KLogWriteFmt(enum KE_LOG_LEVEL level, const char *fmt, ...)
+{
+    if (level < HO_LOG_MIN_LEVEL)
+        return 0;
+
     VA_LIST args;
     VA_START(args, fmt);
-    written += ConsoleWriteVFmt(fmt, args);
+    uint64_t length = KiKlogWriteVFmt(level, fmt, args);
     VA_END(args);
+    return length;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KLogWriteBinary
+// ─────────────────────────────────────────────────────────────
+
+static BOOL
+KiKlogPutBytes(uint8_t *payload, uint32_t *used, const void *data, uint32_t length)
+{
+    if (length > KE_KLOG_LINE_MAX - *used)
+        return FALSE;
+
+    memcpy(payload + *used, data, length);
+    *used += length;
+    return TRUE;
+}
+
+static BOOL
+KiKlogPutValue(uint8_t *payload, uint32_t *used, uint64_t value)
+{
+    return KiKlogPutBytes(payload, used, &value, sizeof(value));
+}
+
+static BOOL
+KiKlogPutString(uint8_t *payload, uint32_t *used, const char *str)
+{
+    if (str == NULL)
+        str = "(null)";
+
+    uint32_t room = KE_KLOG_LINE_MAX - *used;
+    if (room < sizeof(uint16_t))
+        return FALSE;
+
+    uint16_t length = 0;
+    while (str[length] != '\0' && length < room - sizeof(uint16_t))
+        length++;
+
+    (void)KiKlogPutBytes(payload, used, &length, sizeof(length));
+    (void)KiKlogPutBytes(payload, used, str, length);
+    return str[length] == '\0';
+}
+
+// Copy the arguments out in the order and width the text formatter would read
+// them, so the host can replay the format. Stops at the first argument that
+// does not fit.
+static uint32_t
+KiKlogEncodeArgs(uint8_t *payload, uint32_t used, const char *fmt, VA_LIST args, uint32_t *flags)
+{
+    BOOL fits = TRUE;
+
+    for (const char *p = fmt; *p != '\0' && fits; ++p)
+    {
+        if (*p != '%')
+            continue;
+
+        ++p;
+        if (*p == '%')
+            continue;
+        while (*p == '-' || (*p >= '0' && *p <= '9'))
+            ++p;
+
+        switch (*p)
+        {
+        case 'c':
+        case 'd':
+        case 'i':
+            fits = KiKlogPutValue(payload, &used, (uint64_t)(int64_t)VA_ARG(args, int));
+            break;
+        case 'u':
+            fits = KiKlogPutValue(payload, &used, VA_ARG(args, unsigned int));
+            break;
+        case 'x':
+        case 'X':
+            fits = KiKlogPutValue(payload, &used, VA_ARG(args, uint64_t));
+            break;
+        case 'p':
+            fits = KiKlogPutValue(payload, &used, (uint64_t)VA_ARG(args, void *));
+            break;
+        case 's':
+            fits = KiKlogPutString(payload, &used, VA_ARG(args, const char *));
+            break;
+        case 'l':
+            ++p;
+            if (*p != 'd' && *p != 'i' && *p != 'u' && *p != 'x' && *p != 'X')
+                HO_KPANIC(EC_ILLEGAL_ARGUMENT, "Unsupported format in kernel printf");
+            fits = KiKlogPutValue(payload, &used, VA_ARG(args, unsigned long));
+            break;
+        case 'k':
+            ++p;
+            if (*p == 'e') // The message table is not in the ELF; send the text
+                fits = KiKlogPutString(payload, &used, KrGetStatusMessage(VA_ARG(args, HO_STATUS)));
+            else if (*p == 's')
+                fits = KiKlogPutValue(payload, &used, (uint64_t)VA_ARG(args, HO_STATUS));
+            else
+                HO_KPANIC(EC_ILLEGAL_ARGUMENT, "Unsupported format in kernel printf");
+            break;
+        default:
+            HO_KPANIC(EC_ILLEGAL_ARGUMENT, "Unsupported format in kernel printf");
+            break;
+        }
+    }
+
+    if (!fits)
+        *flags |= KE_KLOG_BINARY_ARGS_CUT;
+    return used;
+}
+
+HO_KERNEL_API uint64_t
+KLogWriteBinary(const KE_KLOG_FORMAT *format, ...)
+{
+    enum KE_LOG_LEVEL level = (enum KE_LOG_LEVEL)format->Level;
+    if (level < HO_LOG_MIN_LEVEL)
+        return 0;
+
+    VA_LIST args;
+    VA_START(args, format);
+
+    uint32_t mode = gKlogMode;
+    if (mode == KE_KLOG_MODE_PANIC || (HO_BINARY_LOG_MIXED && level >= KLOG_LEVEL_WARNING))
+    {
+        uint64_t length = KiKlogWriteVFmt(level, format->Format, args);
+        VA_END(args);
+        return length;
+    }
+
+    uint8_t payload[KE_KLOG_LINE_MAX];
+    KE_KLOG_BINARY_HEADER header = {0};
+    header.FormatId = (uint32_t)(format - __klog_fmt_start);
+    header.TimestampUs = KeIsTimeSourceReady() ? KeGetSystemUpRealTime() : KE_KLOG_BINARY_NO_TIME;
+
+    uint32_t length = KiKlogEncodeArgs(payload, sizeof(header), format->Format, args, &header.Flags);
+    VA_END(args);
+    memcpy(payload, &header, sizeof(header));
+
+    if (KiKlogQueue(payload, length, level, KI_KLOG_RECORD_BINARY, FALSE))
+        return length;
+
+    KI_KLOG_RING *ring = KiKlogCurrentRing();
+    if (mode == KE_KLOG_MODE_ASYNC)
+    {
+        KiKlogCount(&ring->Stats.DroppedCount);
+        return 0;
+    }
+
+    // An interrupt nested in an early-boot drain found no room: print it as text.
+    VA_START(args, format);
+    uint64_t textLength = KiKlogWriteVFmt(level, format->Format, args);
+    VA_END(args);
+    return textLength;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KLogStartDrainThread
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KLogStartDrainThread(void)
+{
+    if (gKlogDrainThread != NULL)
+        return EC_INVALID_STATE;
+
+    KeInitializeEvent(&gKlogWakeEvent, FALSE);
+    KeInitializeDpc(&gKlogWakeDpc, KiKlogWakeDpcRoutine, NULL);
+
+    KTHREAD *thread = NULL;
+    HO_STATUS status = KeThreadCreate(&thread, KiKlogDrainThread, NULL);
+    if (status != EC_SUCCESS)
+        return status;
+
+    status = KeThreadSetPriority(thread, KTHREAD_PRIORITY_LOW);
+    if (status != EC_SUCCESS)
+        return status;
+
+    thread->Flags |= KTHREAD_FLAG_LOG_QUIET;
+    gKlogDrainThread = thread;
+    status = KeThreadStart(thread);
+    if (status != EC_SUCCESS)
+    {
+        gKlogDrainThread = NULL;
+        return status;
+    }
+
+    // Everything logged so far was drained synchronously.
+    gKlogMode = KE_KLOG_MODE_ASYNC;
+    klog(KLOG_LEVEL_INFO, "[KLOG] async drain ready (ring=%u bytes, line=%u bytes, thread=%u)\n", KE_KLOG_RING_SIZE,
+         KE_KLOG_LINE_MAX, thread->ThreadId);
+    return EC_SUCCESS;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KLogFlush / KLogEnterPanicMode
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API void
+KLogFlush(void)
+{
+    KiKlogDrain(KiKlogCurrentRing());
+}
+
+HO_KERNEL_API void
+KLogEnterPanicMode(void)
+{
+    if (gKlogMode == KE_KLOG_MODE_PANIC)
+        return;
+
+    gKlogMode = KE_KLOG_MODE_PANIC;
+
+    // A drain the panic interrupted never resumes, so take the consumer side
+    // over unconditionally. Its current line may be printed twice.
+    gKlogDraining = TRUE;
+    KiKlogDrainRing(KiKlogCurrentRing());
+}
+
+// ─────────────────────────────────────────────────────────────
+// KLogQueryStats / KLogReadRecent
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API void
+KLogQueryStats(KE_KLOG_STATS *out)
+{
+    if (out == NULL)
+        return;
+
+    KI_KLOG_RING *ring = KiKlogCurrentRing();
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    *out = ring->Stats;
+    out->Mode = gKlogMode;
+    out->RingSize = KE_KLOG_RING_SIZE;
+    out->PendingBytes = (uint32_t)(ring->Head - ring->Tail);
+    ArchRestoreInterruptState(interruptState);
+}
+
+HO_KERNEL_API uint32_t
+KLogReadRecent(char *buffer, uint32_t capacity)
+{
+    if (buffer == NULL || capacity == 0)
+        return 0;
+
+    KI_KLOG_RING *ring = KiKlogCurrentRing();
+    uint32_t copied = 0;
+
+    // Producers only run on this CPU, so masking interrupts freezes the ring.
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+
+    uint64_t end = ring->Reclaim;
+    uint64_t totalText = 0;
+    while (end != ring->Head)
+    {
+        const KI_KLOG_RECORD_HEADER *header = KiKlogHeaderAt(ring, end);
+        if (header->State != KI_KLOG_STATE_COMMITTED || !KiKlogIsValidRecord(header))
+            break;
+        if ((header->Flags & KI_KLOG_RECORD_BINARY) == 0)
+            totalText += header->TextLength;
+        end += header->Length;
+    }
+
+    uint64_t skip = totalText > capacity - 1U ? totalText - (capacity - 1U) : 0;
+    for (uint64_t position = ring->Reclaim; position != end;)
+    {
+        const KI_KLOG_RECORD_HEADER *header = KiKlogHeaderAt(ring, position);
+        uint32_t textLength = (header->Flags & KI_KLOG_RECORD_BINARY) == 0 ? header->TextLength : 0;
+        if (skip >= textLength)
+        {
+            skip -= textLength;
+        }
+        else
+        {
+            KiKlogCopyOut(ring, position + sizeof(KI_KLOG_RECORD_HEADER) + skip, buffer + copied,
+                          textLength - (uint32_t)skip);
+            copied += textLength - (uint32_t)skip;
+            skip = 0;
+        }
+        position += header->Length;
+    }
+
+    ArchRestoreInterruptState(interruptState);
 
-    KeLeaveCriticalSection(&criticalSection);
-    return written;
+    buffer[copied] = '\0';
+    return copied;
 }
@@ -0,0 +1,257 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/log/log_level.c
+ * Description: Runtime klog levels per category. A category is the "[TAG]"
+ *              prefix of a format string; it is registered the first time one
+ *              of its call sites runs (or when a level is set for it), and
+ *              every site of the category then points at the same level byte.
+ *              Levels come from the "klog=" boot option and from user mode
+ *              through the SET_LOG_LEVEL syscall.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include <kernel/log.h>
+
+#include <arch/arch.h>
+#include <libc/string.h>
+
+typedef struct KI_KLOG_CATEGORY
+{
+    char Tag[KE_KLOG_TAG_MAX + 1];
+    uint8_t TagLength;
+} KI_KLOG_CATEGORY;
+
+// Thresholds live apart from the tags so the byte a site loads shares its
+// cache line with other thresholds, not with names. The last slot is the
+// overflow category used once the table is full; it follows the default.
+static KI_KLOG_CATEGORY gKlogCategories[KE_KLOG_CATEGORY_MAX];
+static volatile uint8_t gKlogThresholds[KE_KLOG_CATEGORY_MAX + 1];
+static uint32_t gKlogCategoryCount;
+static uint8_t gKlogDefaultLevel = KLOG_LEVEL_DEBUG;
+
+static const char *const gKlogLevelNames[] = {"debug", "info", "warning", "error", "off"};
+
+static BOOL
+KiKlogTagEquals(const KI_KLOG_CATEGORY *category, const char *tag, uint32_t tagLength)
+{
+    return category->TagLength == tagLength && memcmp(category->Tag, tag, tagLength) == 0;
+}
+
+// Caller masks interrupts. Returns the category's threshold slot, or the
+// overflow slot when the table is full.
+static uint32_t
+KiKlogLookupOrRegister(const char *tag, uint32_t tagLength)
+{
+    for (uint32_t index = 0; index < gKlogCategoryCount; ++index)
+    {
+        if (KiKlogTagEquals(&gKlogCategories[index], tag, tagLength))
+            return index;
+    }
+
+    if (gKlogCategoryCount == KE_KLOG_CATEGORY_MAX)
+        return KE_KLOG_CATEGORY_MAX;
+
+    uint32_t index = gKlogCategoryCount;
+    KI_KLOG_CATEGORY *category = &gKlogCategories[index];
+    memcpy(category->Tag, tag, tagLength);
+    category->Tag[tagLength] = '\0';
+    category->TagLength = (uint8_t)tagLength;
+    gKlogThresholds[index] = gKlogDefaultLevel;
+    gKlogCategoryCount = index + 1U;
+    return index;
+}
+
+// "[TAG] ..." names TAG; anything else, including an over-long or empty tag,
+// is untagged.
+static const char *
+KiKlogParseTag(const char *fmt, uint32_t *outLength)
+{
+    if (fmt != NULL && fmt[0] == '[')
+    {
+        uint32_t length = 0;
+        while (length <= KE_KLOG_TAG_MAX && fmt[1 + length] != '\0' && fmt[1 + length] != ']')
+            length++;
+        if (length != 0 && length <= KE_KLOG_TAG_MAX && fmt[1 + length] == ']')
+        {
+            *outLength = length;
+            return fmt + 1;
+        }
+    }
+
+    *outLength = sizeof(KE_KLOG_UNTAGGED) - 1U;
+    return KE_KLOG_UNTAGGED;
+}
+
+static BOOL
+KiKlogParseLevel(const char *text, uint32_t length, uint8_t *outLevel)
+{
+    for (uint32_t level = 0; level < sizeof(gKlogLevelNames) / sizeof(gKlogLevelNames[0]); ++level)
+    {
+        if (strlen(gKlogLevelNames[level]) == length && memcmp(gKlogLevelNames[level], text, length) == 0)
+        {
+            *outLevel = (uint8_t)level;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static BOOL
+KiKlogIsValidTag(const char *tag, uint32_t tagLength)
+{
+    if (tagLength == 0 || tagLength > KE_KLOG_TAG_MAX)
+        return FALSE;
+
+    for (uint32_t index = 0; index < tagLength; ++index)
+    {
+        if (tag[index] <= ' ' || tag[index] == ',' || tag[index] == ':' || tag[index] == '[' || tag[index] == ']')
+            return FALSE;
+    }
+    return TRUE;
+}
+
+HO_KERNEL_API const volatile uint8_t *
+KLogResolveSite(KE_KLOG_SITE *site, const char *fmt)
+{
+    uint32_t tagLength = 0;
+    const char *tag = KiKlogParseTag(fmt, &tagLength);
+
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    const volatile uint8_t *threshold = &gKlogThresholds[KiKlogLookupOrRegister(tag, tagLength)];
+    site->Threshold = threshold;
+    ArchRestoreInterruptState(interruptState);
+    return threshold;
+}
+
+HO_KERNEL_API HO_STATUS
+KLogSetCategoryLevel(const char *tag, uint32_t tagLength, enum KE_LOG_LEVEL level)
+{
+    if (tag == NULL || (uint32_t)level > KLOG_LEVEL_OFF || !KiKlogIsValidTag(tag, tagLength))
+        return EC_ILLEGAL_ARGUMENT;
+
+    HO_STATUS status = EC_SUCCESS;
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    if (tagLength == sizeof(KE_KLOG_ALL_TAGS) - 1U && tag[0] == KE_KLOG_ALL_TAGS[0])
+    {
+        gKlogDefaultLevel = (uint8_t)level;
+        for (uint32_t index = 0; index <= KE_KLOG_CATEGORY_MAX; ++index)
+            gKlogThresholds[index] = (uint8_t)level;
+    }
+    else
+    {
+        uint32_t index = KiKlogLookupOrRegister(tag, tagLength);
+        if (index == KE_KLOG_CATEGORY_MAX)
+            status = EC_OUT_OF_RESOURCE;
+        else
+            gKlogThresholds[index] = (uint8_t)level;
+    }
+    ArchRestoreInterruptState(interruptState);
+    return status;
+}
+
+// Split the next "TAG:level" entry off the spec. Returns FALSE on a malformed
+// entry; *cursor is left after the entry's comma.
+static BOOL
+KiKlogNextSpecEntry(const char *spec, uint32_t length, uint32_t *cursor, const char **outTag, uint32_t *outTagLength,
+                    uint8_t *outLevel)
+{
+    uint32_t start = *cursor;
+    uint32_t end = start;
+    while (end < length && spec[end] != ',')
+        end++;
+    *cursor = end < length ? end + 1U : end;
+
+    uint32_t colon = start;
+    while (colon < end && spec[colon] != ':')
+        colon++;
+    if (colon == end)
+        return FALSE;
+
+    *outTag = spec + start;
+    *outTagLength = colon - start;
+    return KiKlogIsValidTag(*outTag, *outTagLength) &&
+           KiKlogParseLevel(spec + colon + 1U, end - colon - 1U, outLevel);
+}
+
+HO_KERNEL_API HO_STATUS
+KLogApplyLevelSpec(const char *spec, uint32_t length, uint32_t *outUpdated)
+{
+    if (outUpdated != NULL)
+        *outUpdated = 0;
+    if (spec == NULL || length == 0 || length > KE_KLOG_LEVEL_SPEC_MAX)
+        return EC_ILLEGAL_ARGUMENT;
+
+    const char *tag = NULL;
+    uint32_t tagLength = 0;
+    uint8_t level = 0;
+    uint32_t cursor = 0;
+    while (cursor < length)
+    {
+        if (!KiKlogNextSpecEntry(spec, length, &cursor, &tag, &tagLength, &level))
+            return EC_ILLEGAL_ARGUMENT;
+    }
+    if (spec[length - 1U] == ',')
+        return EC_ILLEGAL_ARGUMENT;
+
+    uint32_t updated = 0;
+    for (cursor = 0; cursor < length; ++updated)
+    {
+        (void)KiKlogNextSpecEntry(spec, length, &cursor, &tag, &tagLength, &level);
+        HO_STATUS status = KLogSetCategoryLevel(tag, tagLength, (enum KE_LOG_LEVEL)level);
+        if (status != EC_SUCCESS)
+        {
+            if (outUpdated != NULL)
+                *outUpdated = updated;
+            return status;
+        }
+    }
+
+    if (outUpdated != NULL)
+        *outUpdated = updated;
+    return EC_SUCCESS;
+}
+
+static BOOL
+KiKlogAppend(char *buffer, uint32_t capacity, uint32_t *offset, const char *text)
+{
+    uint32_t length = (uint32_t)strlen(text);
+    if (length >= capacity - *offset)
+        return FALSE;
+
+    memcpy(buffer + *offset, text, length);
+    *offset += length;
+    return TRUE;
+}
+
+HO_KERNEL_API uint32_t
+KLogFormatCategoryLevels(char *buffer, uint32_t capacity)
+{
+    if (buffer == NULL || capacity == 0)
+        return 0;
+
+    uint32_t offset = 0;
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    if (KiKlogAppend(buffer, capacity, &offset, "default=") &&
+        KiKlogAppend(buffer, capacity, &offset, gKlogLevelNames[gKlogDefaultLevel]) &&
+        KiKlogAppend(buffer, capacity, &offset, "\n"))
+    {
+        // Whole lines only: a line that does not fit ends the listing.
+        for (uint32_t index = 0; index < gKlogCategoryCount; ++index)
+        {
+            uint32_t lineStart = offset;
+            if (!KiKlogAppend(buffer, capacity, &offset, gKlogCategories[index].Tag) ||
+                !KiKlogAppend(buffer, capacity, &offset, " ") ||
+                !KiKlogAppend(buffer, capacity, &offset, gKlogLevelNames[gKlogThresholds[index]]) ||
+                !KiKlogAppend(buffer, capacity, &offset, "\n"))
+            {
+                offset = lineStart;
+                break;
+            }
+        }
+    }
+    ArchRestoreInterruptState(interruptState);
+
+    buffer[offset] = '\0';
+    return offset;
+}
@@ -15,6 +15,7 @@
 #define KE_PT_ALLOWED_LEAF_FLAGS                                                                                       \
     (PTE_WRITABLE | PTE_USER | PTE_WRITETHROUGH | PTE_CACHE_DISABLE | PTE_GLOBAL | PTE_NO_EXECUTE)
 #define KE_PT_PHYS_ADDR_MASK 0x000FFFFFFFFFF000ULL
+#define KE_CR4_PGE           (1ULL << 7)
 
 typedef struct KE_PT_WALK
 {
@@ -829,11 +830,36 @@ KeDiagnoseVirtualAddress(const KE_KERNEL_ADDRESS_SPACE *space,
     return EC_SUCCESS;
 }
 
+static HO_STATUS
+KiMemoryTypeToLeafBits(KE_MEMORY_TYPE memoryType, uint64_t *outBits)
+{
+    switch (memoryType)
+    {
+    case KE_MEMORY_TYPE_WRITE_BACK:
+        *outBits = 0; // PA0
+        return EC_SUCCESS;
+    case KE_MEMORY_TYPE_WRITE_THROUGH:
+        *outBits = PTE_WRITETHROUGH; // PA1
+        return EC_SUCCESS;
+    case KE_MEMORY_TYPE_UNCACHED:
+        *outBits = PTE_WRITETHROUGH | PTE_CACHE_DISABLE; // PA3, strong UC
+        return EC_SUCCESS;
+    case KE_MEMORY_TYPE_WRITE_COMBINING:
+        if (!IsPatProgrammed())
+            return EC_NOT_SUPPORTED;
+        *outBits = HO_PAT_WC_PTE_BITS;
+        return EC_SUCCESS;
+    default:
+        return EC_ILLEGAL_ARGUMENT;
+    }
+}
+
 HO_KERNEL_API HO_NODISCARD HO_STATUS
 KePtMapPage(const KE_KERNEL_ADDRESS_SPACE *space,
             HO_VIRTUAL_ADDRESS virtAddr,
             HO_PHYSICAL_ADDRESS physAddr,
-            uint64_t attributes)
+            uint64_t attributes,
+            KE_MEMORY_TYPE memoryType)
 {
     if (!space)
         return EC_ILLEGAL_ARGUMENT;
@@ -842,6 +868,12 @@ KePtMapPage(const KE_KERNEL_ADDRESS_SPACE *space,
     if (!HO_IS_ALIGNED(virtAddr, PAGE_4KB) || !HO_IS_ALIGNED(physAddr, PAGE_4KB))
         return EC_ILLEGAL_ARGUMENT;
 
+    uint64_t cacheBits = 0;
+    HO_STATUS status = KiMemoryTypeToLeafBits(memoryType, &cacheBits);
+    if (status != EC_SUCCESS)
+        return status;
+    attributes &= ~PTE_CACHE_MASK;
+
     KE_NEW_TABLE newTables[3];
     uint32_t newTableCount = 0;
     KE_ENTRY_FLAG_PROMOTION promotions[3];
@@ -853,7 +885,7 @@ KePtMapPage(const KE_KERNEL_ADDRESS_SPACE *space,
     PAGE_TABLE_ENTRY *pml4Entry = &pml4[PML4_INDEX(virtAddr)];
     PAGE_TABLE_ENTRY *pdpt = NULL;
 
-    HO_STATUS status = KiEnsureChildTable(
+    status = KiEnsureChildTable(
         pml4Entry, attributes, newTables, &newTableCount, promotions, &promotionCount, &pdpt);
     if (status != EC_SUCCESS)
         return status;
@@ -884,7 +916,7 @@ KePtMapPage(const KE_KERNEL_ADDRESS_SPACE *space,
         return EC_INVALID_STATE;
     }
 
-    *ptEntry = (physAddr & PAGE_MASK) | (attributes & KE_PT_ALLOWED_LEAF_FLAGS) | PTE_PRESENT;
+    *ptEntry = (physAddr & PAGE_MASK) | (attributes & KE_PT_ALLOWED_LEAF_FLAGS) | cacheBits | PTE_PRESENT;
 
     if (KiReadCr3() == space->RootPageTablePhys)
         KiInvalidatePage(virtAddr);
@@ -892,8 +924,8 @@ KePtMapPage(const KE_KERNEL_ADDRESS_SPACE *space,
     return EC_SUCCESS;
 }
 
-HO_KERNEL_API HO_NODISCARD HO_STATUS
-KePtUnmapPage(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAddr)
+static HO_STATUS
+KiClearLeafEntry(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAddr)
 {
     if (!space)
         return EC_ILLEGAL_ARGUMENT;
@@ -908,6 +940,15 @@ KePtUnmapPage(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAddr)
         return EC_NOT_SUPPORTED;
 
     *walk.LeafEntry = 0;
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API HO_NODISCARD HO_STATUS
+KePtUnmapPage(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAddr)
+{
+    HO_STATUS status = KiClearLeafEntry(space, virtAddr);
+    if (status != EC_SUCCESS)
+        return status;
 
     if (KiReadCr3() == space->RootPageTablePhys)
         KiInvalidatePage(virtAddr);
@@ -915,6 +956,37 @@ KePtUnmapPage(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAddr)
     return EC_SUCCESS;
 }
 
+HO_KERNEL_API HO_NODISCARD HO_STATUS
+KePtUnmapPageDeferred(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAddr)
+{
+    return KiClearLeafEntry(space, virtAddr);
+}
+
+HO_KERNEL_API void
+KeFlushTlbPage(HO_VIRTUAL_ADDRESS virtAddr)
+{
+    KiInvalidatePage(virtAddr);
+}
+
+HO_KERNEL_API void
+KeFlushTlbAll(void)
+{
+    uint64_t cr4;
+    __asm__ __volatile__("mov %%cr4, %0" : "=r"(cr4));
+
+    if ((cr4 & KE_CR4_PGE) != 0)
+    {
+        // Toggling CR4.PGE drops global entries too; a CR3 reload alone would not.
+        __asm__ __volatile__("mov %0, %%cr4" : : "r"(cr4 & ~KE_CR4_PGE) : "memory");
+        __asm__ __volatile__("mov %0, %%cr4" : : "r"(cr4) : "memory");
+        return;
+    }
+
+    uint64_t cr3;
+    __asm__ __volatile__("mov %%cr3, %0" : "=r"(cr3));
+    __asm__ __volatile__("mov %0, %%cr3" : : "r"(cr3) : "memory");
+}
+
 HO_KERNEL_API HO_NODISCARD HO_STATUS
 KePtProtectPage(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAddr, uint64_t attributes)
 {
@@ -930,8 +1002,9 @@ KePtProtectPage(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAdd
     if (walk.Level != 1)
         return EC_NOT_SUPPORTED;
 
-    uint64_t preserved = (walk.LeafValue & KE_PT_PHYS_ADDR_MASK) | (walk.LeafValue & (PTE_ACCESSED | PTE_DIRTY));
-    *walk.LeafEntry = preserved | (attributes & KE_PT_ALLOWED_LEAF_FLAGS) | PTE_PRESENT;
+    uint64_t preserved = (walk.LeafValue & KE_PT_PHYS_ADDR_MASK) |
+                         (walk.LeafValue & (PTE_ACCESSED | PTE_DIRTY | PTE_CACHE_MASK | PTE_PAT_4KB));
+    *walk.LeafEntry = preserved | (attributes & KE_PT_ALLOWED_LEAF_FLAGS & ~PTE_CACHE_MASK) | PTE_PRESENT;
 
     if (KiReadCr3() == space->RootPageTablePhys)
         KiInvalidatePage(virtAddr);
@@ -939,6 +1012,82 @@ KePtProtectPage(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAdd
     return EC_SUCCESS;
 }
 
+HO_KERNEL_API HO_NODISCARD HO_STATUS
+KePtRetypePage(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAddr, KE_MEMORY_TYPE memoryType)
+{
+    if (!space)
+        return EC_ILLEGAL_ARGUMENT;
+
+    uint64_t cacheBits = 0;
+    HO_STATUS status = KiMemoryTypeToLeafBits(memoryType, &cacheBits);
+    if (status != EC_SUCCESS)
+        return status;
+
+    KE_PT_WALK walk;
+    status = KiWalkImportedRoot(space, virtAddr, &walk);
+    if (status != EC_SUCCESS)
+        return status;
+    if (!walk.LeafEntry)
+        return EC_INVALID_STATE;
+    if (walk.Level != 1)
+        return EC_NOT_SUPPORTED;
+
+    *walk.LeafEntry = (walk.LeafValue & ~(PTE_CACHE_MASK | PTE_PAT_4KB)) | cacheBits;
+
+    if (KiReadCr3() == space->RootPageTablePhys)
+        KiInvalidatePage(virtAddr);
+
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API HO_NODISCARD HO_STATUS
+KePtUnmapRange(const KE_KERNEL_ADDRESS_SPACE *space, HO_VIRTUAL_ADDRESS virtAddr, uint64_t size)
+{
+    if (!space || size == 0)
+        return EC_ILLEGAL_ARGUMENT;
+    if (!HO_IS_ALIGNED(virtAddr, PAGE_4KB) || !HO_IS_ALIGNED(size, PAGE_4KB) || virtAddr + size < virtAddr)
+        return EC_ILLEGAL_ARGUMENT;
+
+    const HO_VIRTUAL_ADDRESS end = virtAddr + size;
+    KE_PT_WALK walk;
+    HO_STATUS status;
+
+    // Validate every leaf first so a straddling large leaf leaves the range untouched.
+    for (HO_VIRTUAL_ADDRESS cursor = virtAddr; cursor < end;)
+    {
+        status = KiWalkImportedRoot(space, cursor, &walk);
+        if (status != EC_SUCCESS)
+            return status;
+        if (!walk.LeafEntry)
+        {
+            cursor += PAGE_4KB;
+            continue;
+        }
+        if (walk.LeafVirtBase < virtAddr || walk.LeafVirtBase + walk.PageSize > end)
+            return EC_NOT_SUPPORTED;
+        cursor = walk.LeafVirtBase + walk.PageSize;
+    }
+
+    for (HO_VIRTUAL_ADDRESS cursor = virtAddr; cursor < end;)
+    {
+        status = KiWalkImportedRoot(space, cursor, &walk);
+        if (status != EC_SUCCESS)
+            return status;
+        if (!walk.LeafEntry)
+        {
+            cursor += PAGE_4KB;
+            continue;
+        }
+        *walk.LeafEntry = 0;
+        cursor = walk.LeafVirtBase + walk.PageSize;
+    }
+
+    if (KiReadCr3() == space->RootPageTablePhys)
+        KeFlushTlbAll();
+
+    return EC_SUCCESS;
+}
+
 HO_KERNEL_API HO_NODISCARD HO_STATUS
 KePtSelfTest(void)
 {
@@ -980,7 +1129,7 @@ KePtSelfTest(void)
         goto cleanup_page;
     }
 
-    status = KePtMapPage(space, scratchVirt, scratchPhys, PTE_WRITABLE | PTE_NO_EXECUTE);
+    status = KePtMapPage(space, scratchVirt, scratchPhys, PTE_WRITABLE | PTE_NO_EXECUTE, KE_MEMORY_TYPE_WRITE_BACK);
     if (status != EC_SUCCESS)
         goto cleanup_page;
 
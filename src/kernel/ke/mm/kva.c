@@ -307,8 +307,46 @@ KiKvaFindRecordById(const KE_KVA_RANGE *range)
     return record;
 }
 
+typedef struct KE_KVA_FLUSH_BATCH
+{
+    HO_VIRTUAL_ADDRESS Pages[KE_KVA_BATCH_FLUSH_ALL_PAGES];
+    uint32_t PageCount;
+    BOOL FlushAll;
+} KE_KVA_FLUSH_BATCH;
+
+static void
+KiKvaDeferFlush(KE_KVA_FLUSH_BATCH *batch, HO_VIRTUAL_ADDRESS virtAddr)
+{
+    if (batch->FlushAll)
+        return;
+
+    if (batch->PageCount == KE_KVA_BATCH_FLUSH_ALL_PAGES)
+    {
+        batch->FlushAll = TRUE;
+        return;
+    }
+
+    batch->Pages[batch->PageCount++] = virtAddr;
+}
+
+static void
+KiKvaCompleteFlush(const KE_KVA_FLUSH_BATCH *batch)
+{
+    if (batch->FlushAll)
+    {
+        KeFlushTlbAll();
+        return;
+    }
+
+    for (uint32_t idx = 0; idx < batch->PageCount; ++idx)
+        KeFlushTlbPage(batch->Pages[idx]);
+}
+
+// With @flushBatch set, leaves are cleared without invalidation and freed frames
+// stay unreachable only because the caller still holds the critical section;
+// the caller must run KiKvaCompleteFlush() before leaving it.
 static HO_STATUS
-KiKvaReleaseRecord(KE_KVA_RANGE_RECORD *record, const KE_KVA_ARENA_STATE *arena)
+KiKvaReleaseRecord(KE_KVA_RANGE_RECORD *record, const KE_KVA_ARENA_STATE *arena, KE_KVA_FLUSH_BATCH *flushBatch)
 {
     if (!record || !arena)
         return EC_ILLEGAL_ARGUMENT;
@@ -341,7 +379,15 @@ KiKvaReleaseRecord(KE_KVA_RANGE_RECORD *record, const KE_KVA_ARENA_STATE *arena)
         }
 
         teardownStarted = TRUE;
-        status = KePtUnmapPage(KeGetKernelAddressSpace(), virtAddr);
+        if (flushBatch)
+        {
+            status = KePtUnmapPageDeferred(KeGetKernelAddressSpace(), virtAddr);
+            KiKvaDeferFlush(flushBatch, virtAddr);
+        }
+        else
+        {
+            status = KePtUnmapPage(KeGetKernelAddressSpace(), virtAddr);
+        }
         if (status != EC_SUCCESS)
             HO_KPANIC(status, "KVA teardown failed after unmapping started");
 
@@ -600,7 +646,11 @@ cleanup:
 }
 
 HO_KERNEL_API HO_NODISCARD HO_STATUS
-KeKvaMapPage(const KE_KVA_RANGE *range, uint64_t usablePageIndex, HO_PHYSICAL_ADDRESS physAddr, uint64_t attributes)
+KeKvaMapPage(const KE_KVA_RANGE *range,
+             uint64_t usablePageIndex,
+             HO_PHYSICAL_ADDRESS physAddr,
+             uint64_t attributes,
+             KE_MEMORY_TYPE memoryType)
 {
     if (!gKvaInitialized)
         return EC_INVALID_STATE;
@@ -624,7 +674,7 @@ KeKvaMapPage(const KE_KVA_RANGE *range, uint64_t usablePageIndex, HO_PHYSICAL_AD
     }
 
     HO_VIRTUAL_ADDRESS virtAddr = range->UsableBase + usablePageIndex * PAGE_4KB;
-    status = KePtMapPage(KeGetKernelAddressSpace(), virtAddr, physAddr, attributes);
+    status = KePtMapPage(KeGetKernelAddressSpace(), virtAddr, physAddr, attributes, memoryType);
 
 cleanup:
     KeLeaveCriticalSection(&criticalSection);
@@ -666,7 +716,7 @@ KeKvaMapOwnedPages(const KE_KVA_RANGE *range, uint64_t attributes)
             return status;
         }
 
-        status = KeKvaMapPage(range, pageIdx, physAddr, attributes);
+        status = KeKvaMapPage(range, pageIdx, physAddr, attributes, KE_MEMORY_TYPE_WRITE_BACK);
         if (status != EC_SUCCESS)
         {
             (void)KePmmFreePages(physAddr, 1);
@@ -710,13 +760,46 @@ KeKvaReleaseRangeHandle(const KE_KVA_RANGE *range)
         goto cleanup;
     }
 
-    status = KiKvaReleaseRecord(record, arena);
+    status = KiKvaReleaseRecord(record, arena, NULL);
 
 cleanup:
     KeLeaveCriticalSection(&criticalSection);
     return status;
 }
 
+HO_KERNEL_API HO_NODISCARD HO_STATUS
+KeKvaReleaseRangeHandles(const KE_KVA_RANGE *const *ranges, uint32_t count)
+{
+    if (!gKvaInitialized)
+        return EC_INVALID_STATE;
+    if (!ranges && count != 0)
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_KVA_FLUSH_BATCH flushBatch = {0};
+    KE_CRITICAL_SECTION criticalSection = {0};
+    HO_STATUS firstFailure = EC_SUCCESS;
+    KeEnterCriticalSection(&criticalSection);
+
+    for (uint32_t idx = 0; idx < count; ++idx)
+    {
+        HO_STATUS status = EC_INVALID_STATE;
+        KE_KVA_RANGE_RECORD *record = ranges[idx] ? KiKvaFindRecordById(ranges[idx]) : NULL;
+        KE_KVA_ARENA_STATE *arena = record ? KiKvaArenaState(record->Arena) : NULL;
+
+        if (!ranges[idx])
+            status = EC_ILLEGAL_ARGUMENT;
+        else if (arena)
+            status = KiKvaReleaseRecord(record, arena, &flushBatch);
+
+        if (status != EC_SUCCESS && firstFailure == EC_SUCCESS)
+            firstFailure = status;
+    }
+
+    KiKvaCompleteFlush(&flushBatch);
+    KeLeaveCriticalSection(&criticalSection);
+    return firstFailure;
+}
+
 HO_KERNEL_API HO_NODISCARD HO_STATUS
 KeKvaReleaseRange(HO_VIRTUAL_ADDRESS usableBase)
 {
@@ -743,7 +826,7 @@ KeKvaReleaseRange(HO_VIRTUAL_ADDRESS usableBase)
         goto cleanup;
     }
 
-    status = KiKvaReleaseRecord(record, arena);
+    status = KiKvaReleaseRecord(record, arena, NULL);
 
 cleanup:
     KeLeaveCriticalSection(&criticalSection);
@@ -1049,7 +1132,8 @@ KeFixmapAcquire(HO_PHYSICAL_ADDRESS physAddr,
             goto cleanup;
         }
 
-        status = KePtMapPage(KeGetKernelAddressSpace(), range.UsableBase, physAddr, attributes);
+        status =
+            KePtMapPage(KeGetKernelAddressSpace(), range.UsableBase, physAddr, attributes, KE_MEMORY_TYPE_WRITE_BACK);
         if (status != EC_SUCCESS)
         {
             outHandle->Token = 0;
@@ -1117,7 +1201,7 @@ KeTempPhysMapRelease(KE_TEMP_PHYS_MAP_HANDLE *handle)
         return EC_INVALID_STATE;
     }
 
-    status = KiKvaReleaseRecord(record, KiKvaArenaState(record->Arena));
+    status = KiKvaReleaseRecord(record, KiKvaArenaState(record->Arena), NULL);
     KeLeaveCriticalSection(&criticalSection);
     if (status == EC_SUCCESS)
         handle->Token = 0;
@@ -0,0 +1,81 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/sysinfo/interrupt.c
+ * Description:
+ * Interrupt, DPC and work-queue system information query handlers.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "sysinfo_internal.h"
+
+#include <kernel/ke/work_queue.h>
+
+HO_STATUS
+QueryInterrupt(void *Buffer, size_t BufferSize, size_t *RequiredSize)
+{
+    const size_t required = sizeof(SYSINFO_INTERRUPT);
+
+    if (RequiredSize)
+        *RequiredSize = required;
+
+    if (!Buffer)
+        return EC_SUCCESS;
+
+    if (BufferSize < required)
+        return EC_NOT_ENOUGH_MEMORY;
+
+    SYSINFO_INTERRUPT *info = (SYSINFO_INTERRUPT *)Buffer;
+    memset(info, 0, sizeof(*info));
+
+    // Exceptions (0-31) and the synchronous syscall trap never go through the
+    // interrupt-context accounting path, so only registered IRQ vectors are listed.
+    for (uint32_t vector = 32; vector < 256U; ++vector)
+    {
+        IDT_VECTOR_STATS stats = {0};
+
+        if (!IdtIsInterruptHandlerRegistered((uint8_t)vector))
+            continue;
+
+        HO_STATUS status = IdtQueryVectorStats((uint8_t)vector, &stats);
+        if (status != EC_SUCCESS)
+            return status;
+
+        if (stats.Count == 0)
+            continue;
+
+        if (info->ReturnedVectorCount >= SYSINFO_INTERRUPT_VECTOR_MAX)
+        {
+            info->Truncated = TRUE;
+            break;
+        }
+
+        SYSINFO_INTERRUPT_VECTOR *entry = &info->Vectors[info->ReturnedVectorCount++];
+        entry->VectorNumber = (uint8_t)vector;
+        entry->Count = stats.Count;
+        entry->TotalHandlerCycles = stats.TotalHandlerCycles;
+        entry->MaxHandlerCycles = stats.MaxHandlerCycles;
+        entry->TotalInterruptOffCycles = stats.TotalInterruptOffCycles;
+        entry->MaxInterruptOffCycles = stats.MaxInterruptOffCycles;
+        entry->SwitchedCount = stats.SwitchedCount;
+    }
+
+    KeQueryDpcStats(&info->Dpc);
+
+    info->WorkQueueReady = KeWorkQueueIsReady();
+    for (uint32_t lane = 0; lane < SYSINFO_WORK_QUEUE_LANE_COUNT && lane < KE_WORK_QUEUE_LANE_COUNT; ++lane)
+    {
+        KE_WORK_QUEUE_LANE_STATS laneStats = {0};
+        HO_STATUS status = KeQueryWorkQueueLaneStats((uint8_t)lane, &laneStats);
+        if (status != EC_SUCCESS)
+            return status;
+
+        info->WorkQueueLanes[lane].QueuedCount = laneStats.QueuedCount;
+        info->WorkQueueLanes[lane].ExecutedCount = laneStats.ExecutedCount;
+        info->WorkQueueLanes[lane].PendingDepth = laneStats.PendingDepth;
+        info->WorkQueueLanes[lane].MaxPendingDepth = laneStats.MaxPendingDepth;
+        info->WorkQueueLanes[lane].WorkerCount = laneStats.WorkerCount;
+    }
+
+    return EC_SUCCESS;
+}
@@ -0,0 +1,31 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/sysinfo/lock.c
+ * Description:
+ * Lock contention profiler system information query handler.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "sysinfo_internal.h"
+
+HO_STATUS
+QueryLockProfile(void *Buffer, size_t BufferSize, size_t *RequiredSize)
+{
+    const size_t required = sizeof(SYSINFO_LOCK_PROFILE);
+
+    if (RequiredSize)
+        *RequiredSize = required;
+
+    if (!Buffer)
+        return EC_SUCCESS;
+
+    if (BufferSize < required)
+        return EC_NOT_ENOUGH_MEMORY;
+
+    SYSINFO_LOCK_PROFILE *info = (SYSINFO_LOCK_PROFILE *)Buffer;
+    memset(info, 0, sizeof(*info));
+
+    info->ReturnedCount = KeQueryLockProfile(info->Entries, SYSINFO_LOCK_PROFILE_ENTRY_MAX, &info->Summary);
+    return EC_SUCCESS;
+}
@@ -0,0 +1,32 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/sysinfo/log.c
+ * Description:
+ * klog ring system information query handler.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "sysinfo_internal.h"
+
+HO_STATUS
+QueryKlog(void *Buffer, size_t BufferSize, size_t *RequiredSize)
+{
+    const size_t required = sizeof(SYSINFO_KLOG);
+
+    if (RequiredSize)
+        *RequiredSize = required;
+
+    if (!Buffer)
+        return EC_SUCCESS;
+
+    if (BufferSize < required)
+        return EC_NOT_ENOUGH_MEMORY;
+
+    SYSINFO_KLOG *info = (SYSINFO_KLOG *)Buffer;
+    memset(info, 0, sizeof(*info));
+
+    KLogQueryStats(&info->Stats);
+    info->TextLength = KLogReadRecent(info->Text, sizeof(info->Text));
+    return EC_SUCCESS;
+}
@@ -118,6 +118,15 @@ KeQuerySystemInformation(KE_SYSINFO_CLASS Class, void *Buffer, size_t BufferSize
     case KE_SYSINFO_ACTIVE_KVA_RANGES:
         return QueryActiveKvaRanges(Buffer, BufferSize, RequiredSize);
 
+    case KE_SYSINFO_INTERRUPT:
+        return QueryInterrupt(Buffer, BufferSize, RequiredSize);
+
+    case KE_SYSINFO_LOCK_PROFILE:
+        return QueryLockProfile(Buffer, BufferSize, RequiredSize);
+
+    case KE_SYSINFO_KLOG:
+        return QueryKlog(Buffer, BufferSize, RequiredSize);
+
     default:
         return EC_ILLEGAL_ARGUMENT;
     }
@@ -16,6 +16,7 @@
 #include <kernel/hodefs.h>
 #include <kernel/init.h>
 #include <arch/arch.h>
+#include <arch/amd64/idt.h>
 #include <libc/string.h>
 
 static inline uint64_t
@@ -32,12 +33,6 @@ StorGdt(GDT_PTR *gdtPtr)
     __asm__ volatile("sgdt %0" : "=m"(*gdtPtr));
 }
 
-typedef struct
-{
-    uint16_t Limit;
-    uint64_t Base;
-} __attribute__((packed)) IDT_PTR;
-
 static inline void
 StorIdt(IDT_PTR *idtPtr)
 {
@@ -69,3 +64,6 @@ HO_STATUS QuerySystemVersion(void *Buffer, size_t BufferSize, size_t *RequiredSi
 HO_STATUS QueryClockEvent(void *Buffer, size_t BufferSize, size_t *RequiredSize);
 HO_STATUS QueryScheduler(void *Buffer, size_t BufferSize, size_t *RequiredSize);
 HO_STATUS QueryActiveKvaRanges(void *Buffer, size_t BufferSize, size_t *RequiredSize);
+HO_STATUS QueryInterrupt(void *Buffer, size_t BufferSize, size_t *RequiredSize);
+HO_STATUS QueryLockProfile(void *Buffer, size_t BufferSize, size_t *RequiredSize);
+HO_STATUS QueryKlog(void *Buffer, size_t BufferSize, size_t *RequiredSize);
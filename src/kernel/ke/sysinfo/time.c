@@ -55,7 +55,8 @@ QueryTimeSource(void *Buffer, size_t BufferSize, size_t *RequiredSize)
     info->Name[nameLen] = '\0';
 
     info->Frequency = KeGetTimeSourceFrequency();
-    info->Features = 0;
+    info->Features = KeIsUserTimePageFastPath() ? SYSINFO_TIME_SOURCE_FEATURE_USER_TIME_PAGE : 0;
+    KeQueryTimeSourceRecalibration(&info->RecalibrationCount, &info->RejectedRecalibrationCount);
 
     return EC_SUCCESS;
 }
@@ -78,8 +79,7 @@ QueryUptime(void *Buffer, size_t BufferSize, size_t *RequiredSize)
         return EC_INVALID_STATE;
 
     SYSINFO_UPTIME *info = (SYSINFO_UPTIME *)Buffer;
-    // KeGetSystemUpRealTime returns microseconds, convert to nanoseconds
-    info->Nanoseconds = KeGetSystemUpRealTime() * 1000ULL;
+    info->Nanoseconds = KeGetSystemUpTimeNs();
 
     return EC_SUCCESS;
 }
@@ -106,10 +106,17 @@ QueryClockEvent(void *Buffer, size_t BufferSize, size_t *RequiredSize)
     if (!info->Ready)
         return EC_SUCCESS;
 
+    info->Mode = KeClockEventGetMode() == KE_CLOCK_EVENT_MODE_TSC_DEADLINE ? SYSINFO_CLOCK_EVENT_MODE_TSC_DEADLINE
+                                                                         : SYSINFO_CLOCK_EVENT_MODE_ONE_SHOT;
+    info->TscDeadlineSupported = KeClockEventIsTscDeadlineSupported();
     info->FreqHz = KeClockEventGetFrequency();
     info->InterruptCount = KeClockEventGetInterruptCount();
+    info->TimeoutExpiryCount = KeClockEventGetTimeoutExpiryCount();
+    info->SavedInterruptCount = KeClockEventGetSavedInterruptCount();
     info->MinDeltaNs = KeClockEventGetMinDeltaNs();
     info->MaxDeltaNs = KeClockEventGetMaxDeltaNs();
+    KeClockEventGetLateness(&info->LatenessSampleCount, &info->TotalLatenessCycles, &info->MaxLatenessCycles,
+                            &info->EarlyFireCount);
     info->VectorNumber = KeClockEventGetVector();
 
     const char *name = KeClockEventGetSourceName();
@@ -52,8 +52,10 @@ KiInitializeThreadWaitBlock(KTHREAD *thread)
     LinkedListInit(&thread->WaitBlock.WaitListLink);
     LinkedListInit(&thread->WaitBlock.TimeoutLink);
     thread->WaitBlock.DeadlineNs = 0;
+    thread->WaitBlock.SlackNs = 0;
     thread->WaitBlock.CompletionStatus = EC_SUCCESS;
     thread->WaitBlock.Completed = FALSE;
+    thread->WaitBlock.SharedAcquire = FALSE;
 }
 
 static void
@@ -119,8 +121,12 @@ KiThreadCreateInternal(KTHREAD **outThread,
     thread->StackRange = stackRange;
 
     thread->Priority = KTHREAD_DEFAULT_PRIORITY;
+    thread->BasePriority = KTHREAD_DEFAULT_PRIORITY;
     thread->Quantum = KE_DEFAULT_QUANTUM_NS;
+    memset(&thread->Deadline, 0, sizeof(thread->Deadline));
+    thread->TimerSlackNs = KE_TIMER_SLACK_DEFAULT;
     thread->OwnedMutexCount = 0;
+    LinkedListInit(&thread->OwnedMutexList);
     KeInitializeIrqlState(&thread->IrqlState);
 
     KiInitializeThreadWaitBlock(thread);
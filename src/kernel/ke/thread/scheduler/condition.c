@@ -0,0 +1,167 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/thread/scheduler/condition.c
+ * Description: Condition variable (KCONDITION) on the unified wait model.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "scheduler_internal.h"
+
+static void KiAssertConditionState(const KCONDITION *condition);
+static uint32_t KiWakeConditionWaiters(KCONDITION *condition, uint32_t maxCount);
+
+// Internal: validate runtime condition invariants
+static void
+KiAssertConditionState(const KCONDITION *condition)
+{
+    HO_KASSERT(condition != NULL, EC_ILLEGAL_ARGUMENT);
+    HO_KASSERT(condition->Header.Signature == KDISPATCHER_SIGNATURE, EC_INVALID_STATE);
+    HO_KASSERT(condition->Header.Type == DISPATCHER_TYPE_CONDITION, EC_NOT_SUPPORTED);
+    HO_KASSERT(condition->Header.SignalState == 0, EC_INVALID_STATE);
+}
+
+// Internal: wake up to maxCount waiters from the head of the priority-ordered list.
+static uint32_t
+KiWakeConditionWaiters(KCONDITION *condition, uint32_t maxCount)
+{
+    KE_IRQL_GUARD irqlGuard = {0};
+    KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    KiAssertConditionState(condition);
+
+    uint32_t wokenCount = 0;
+    while (wokenCount < maxCount && !LinkedListIsEmpty(&condition->Header.WaitListHead))
+    {
+        LINKED_LIST_TAG *entry = condition->Header.WaitListHead.Flink;
+        KWAIT_BLOCK *block = CONTAINING_RECORD(entry, KWAIT_BLOCK, WaitListLink);
+        KiCompleteWait(block, EC_SUCCESS);
+        wokenCount++;
+    }
+
+    // Like KeSetEvent: the woken threads normally wait for the signaler to yield,
+    // except that an idle CPU switches to them immediately.
+    BOOL needSchedule = (gCurrentThread == gIdleThread && KiHasAnyReadyThread());
+
+    klog(KLOG_LEVEL_DEBUG, "[CONDITION] Wake(max=%u, woke=%u)\n", maxCount, wokenCount);
+
+    KeLeaveCriticalSection(&criticalSection);
+
+    if (needSchedule)
+        KiSchedule();
+
+    KeReleaseIrqlGuard(&irqlGuard);
+    return wokenCount;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeInitializeCondition
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API void
+KeInitializeCondition(KCONDITION *condition)
+{
+    HO_KASSERT(condition != NULL, EC_ILLEGAL_ARGUMENT);
+
+    condition->Header.Signature = KDISPATCHER_SIGNATURE;
+    condition->Header.Type = DISPATCHER_TYPE_CONDITION;
+    condition->Header.SignalState = 0;
+    LinkedListInit(&condition->Header.WaitListHead);
+    KiInitLockProfileHeader(&condition->Header);
+
+    klog(KLOG_LEVEL_DEBUG, "[CONDITION] Initialized\n");
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeWaitForCondition
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeWaitForCondition(KCONDITION *condition, void *lock, uint64_t timeoutNs)
+{
+    KiAssertBlockingAllowed();
+
+    if (condition == NULL || lock == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+
+    HO_KASSERT(gCurrentThread != gIdleThread, EC_INVALID_STATE);
+
+    KDISPATCHER_HEADER *lockHeader = (KDISPATCHER_HEADER *)lock;
+    HO_STATUS validationStatus = KiValidateDispatcherHeader(lockHeader);
+    if (validationStatus != EC_SUCCESS)
+        return validationStatus;
+
+    if (lockHeader->Type != DISPATCHER_TYPE_MUTEX && lockHeader->Type != DISPATCHER_TYPE_RWLOCK)
+        return EC_ILLEGAL_ARGUMENT;
+
+    uint64_t profileStart = KiLockProfileWaitBegin(&condition->Header);
+    KE_IRQL_GUARD irqlGuard = {0};
+    KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    KiAssertConditionState(condition);
+
+    BOOL owned = lockHeader->Type == DISPATCHER_TYPE_MUTEX ? ((KMUTEX *)lock)->OwnerThread == gCurrentThread
+                                                           : ((KRWLOCK *)lock)->OwnerThread == gCurrentThread;
+    if (!owned)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        KeReleaseIrqlGuard(&irqlGuard);
+        return EC_INVALID_STATE;
+    }
+
+    // Release the lock and queue on the condition inside one critical section, so a
+    // signal issued by the next lock holder cannot slip in between and be lost.
+    if (lockHeader->Type == DISPATCHER_TYPE_MUTEX)
+        KiReleaseMutexLocked((KMUTEX *)lock);
+    else
+        KiRwLockReleaseExclusiveLocked((KRWLOCK *)lock);
+
+    HO_STATUS waitStatus = EC_TIMEOUT;
+    if (timeoutNs != 0)
+    {
+        KiPrepareBlockingWait(&condition->Header, timeoutNs, TRUE);
+        KeLeaveCriticalSection(&criticalSection);
+        KiSchedule();
+        waitStatus = gCurrentThread->WaitBlock.CompletionStatus;
+        KiLockProfileWaitEnd(&condition->Header, profileStart, TRUE, waitStatus);
+    }
+    else
+    {
+        KiLockProfileWaitEnd(&condition->Header, profileStart, FALSE, EC_TIMEOUT);
+        KeLeaveCriticalSection(&criticalSection);
+    }
+
+    KeReleaseIrqlGuard(&irqlGuard);
+
+    // Mesa semantics: the lock is reacquired without a timeout and the caller
+    // re-checks its predicate, whether this wait was signaled or timed out.
+    HO_STATUS reacquireStatus = KeWaitForSingleObject(lock, KE_WAIT_INFINITE);
+    HO_KASSERT(reacquireStatus == EC_SUCCESS, reacquireStatus);
+
+    klog(KLOG_LEVEL_DEBUG, "[CONDITION] Thread %u resumed (%s)\n", gCurrentThread->ThreadId,
+         waitStatus == EC_SUCCESS ? "signaled" : "timeout");
+    return waitStatus;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeSignalCondition / KeBroadcastCondition
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API uint32_t
+KeSignalCondition(KCONDITION *condition)
+{
+    HO_KASSERT(condition != NULL, EC_ILLEGAL_ARGUMENT);
+    return KiWakeConditionWaiters(condition, 1U);
+}
+
+HO_KERNEL_API uint32_t
+KeBroadcastCondition(KCONDITION *condition)
+{
+    HO_KASSERT(condition != NULL, EC_ILLEGAL_ARGUMENT);
+    return KiWakeConditionWaiters(condition, 0xFFFFFFFFU);
+}
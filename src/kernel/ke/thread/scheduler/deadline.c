@@ -0,0 +1,373 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/thread/scheduler/deadline.c
+ * Description: Deadline (EDF) scheduling class. Deadline threads receive a
+ *              runtime budget per period, run ahead of the RR priority queues
+ *              in absolute-deadline order, and are throttled once the budget
+ *              is spent until a replenishment programmed on the one-shot
+ *              clock event.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "scheduler_internal.h"
+
+// When the running thread was last charged; every dispatch passes through
+// KiDeadlineCharge, so this is also the dispatch time of gCurrentThread.
+static uint64_t gDeadlineChargeStartNs;
+
+static uint64_t
+KiDeadlineKey(const KTHREAD *thread, BOOL byReplenish)
+{
+    return byReplenish ? thread->Deadline.NextReplenishNs : thread->Deadline.AbsoluteDeadlineNs;
+}
+
+// Internal: insert into a deadline list ordered by key, FIFO among equal keys.
+static void
+KiDeadlineInsertSorted(LINKED_LIST_TAG *head, KTHREAD *thread, BOOL byReplenish)
+{
+    uint64_t key = KiDeadlineKey(thread, byReplenish);
+    LINKED_LIST_TAG *pos;
+
+    for (pos = head->Flink; pos != head; pos = pos->Flink)
+    {
+        if (KiDeadlineKey(CONTAINING_RECORD(pos, KTHREAD, ReadyLink), byReplenish) > key)
+            break;
+    }
+
+    // Inserting at the tail of pos links the thread just before it.
+    LinkedListInsertTail(pos, &thread->ReadyLink);
+}
+
+static void
+KiDeadlineStartJob(KTHREAD *thread, uint64_t releaseNs)
+{
+    KTHREAD_DEADLINE *deadline = &thread->Deadline;
+
+    deadline->JobDeadlineNs = releaseNs + deadline->RelativeDeadlineNs;
+    deadline->AbsoluteDeadlineNs = deadline->JobDeadlineNs;
+    deadline->NextReplenishNs = releaseNs + deadline->PeriodNs;
+    deadline->RemainingNs = deadline->RuntimeNs;
+    deadline->JobCount++;
+    gStats.DeadlineJobCount++;
+}
+
+static uint32_t
+KiDeadlineDensityPpm(const KE_DEADLINE_PARAMS *params)
+{
+    return (uint32_t)((params->RuntimeNs * KE_DEADLINE_PPM_SCALE + params->DeadlineNs - 1U) / params->DeadlineNs);
+}
+
+// Internal: make a ready thread runnable in whichever class it belongs to.
+void
+KiInsertReadyThread(KTHREAD *thread)
+{
+    if (!KiIsDeadlineThread(thread))
+    {
+        LinkedListInsertTail(KiGetReadyQueueForThread(thread), &thread->ReadyLink);
+        return;
+    }
+
+    KTHREAD_DEADLINE *deadline = &thread->Deadline;
+    uint64_t nowNs = KiNowNs();
+
+    // Past the replenishment point a new job begins. A periodic waiter releases
+    // exactly on its period boundary; any other wakeup releases now.
+    if (nowNs >= deadline->NextReplenishNs)
+        KiDeadlineStartJob(thread, deadline->PeriodicWait ? deadline->NextReplenishNs : nowNs);
+
+    deadline->PeriodicWait = FALSE;
+    KiDeadlineInsertSorted(&gDeadlineReadyQueue, thread, FALSE);
+
+    // Pull the clock event in so the expiry DPC preempts the running thread
+    // now rather than at the end of its slice.
+    if (gCurrentThread != NULL && gCurrentThread != gIdleThread && gCurrentThread != thread &&
+        KiDeadlineShouldPreempt(gCurrentThread))
+    {
+        gNextProgrammedDeadlineNs = nowNs;
+        KiArmClockEvent(KeClockEventGetMinDeltaNs());
+    }
+}
+
+void
+KiDeadlineCharge(KTHREAD *thread, uint64_t nowNs)
+{
+    uint64_t elapsedNs = nowNs > gDeadlineChargeStartNs ? nowNs - gDeadlineChargeStartNs : 0;
+    gDeadlineChargeStartNs = nowNs;
+
+    if (thread == NULL || !KiIsDeadlineThread(thread))
+        return;
+
+    KTHREAD_DEADLINE *deadline = &thread->Deadline;
+    deadline->RemainingNs = elapsedNs < deadline->RemainingNs ? deadline->RemainingNs - elapsedNs : 0;
+}
+
+BOOL
+KiDeadlineShouldPreempt(const KTHREAD *current)
+{
+    if (LinkedListIsEmpty(&gDeadlineReadyQueue))
+        return FALSE;
+
+    if (!KiIsDeadlineThread(current))
+        return TRUE;
+
+    const KTHREAD *head = CONTAINING_RECORD(gDeadlineReadyQueue.Flink, KTHREAD, ReadyLink);
+    return head->Deadline.AbsoluteDeadlineNs < current->Deadline.AbsoluteDeadlineNs;
+}
+
+// Internal: park a thread whose budget ran out until its next replenishment.
+void
+KiDeadlineThrottle(KTHREAD *thread)
+{
+    thread->State = KTHREAD_STATE_BLOCKED;
+    thread->Deadline.Throttled = TRUE;
+    thread->Deadline.ThrottleCount++;
+    gStats.DeadlineThrottleCount++;
+    KiDeadlineInsertSorted(&gDeadlineThrottledList, thread, TRUE);
+}
+
+// Internal: refill throttled threads whose replenishment time has come. The
+// job keeps its own deadline; only the EDF key moves back one period, so an
+// overrunning job cannot starve threads that stayed within budget.
+void
+KiDeadlineReplenish(uint64_t nowNs)
+{
+    while (!LinkedListIsEmpty(&gDeadlineThrottledList))
+    {
+        KTHREAD *thread = CONTAINING_RECORD(gDeadlineThrottledList.Flink, KTHREAD, ReadyLink);
+        KTHREAD_DEADLINE *deadline = &thread->Deadline;
+
+        if (deadline->NextReplenishNs > nowNs)
+            break;
+
+        LinkedListRemove(&thread->ReadyLink);
+        deadline->Throttled = FALSE;
+        deadline->RemainingNs = deadline->RuntimeNs;
+        deadline->AbsoluteDeadlineNs = deadline->NextReplenishNs + deadline->RelativeDeadlineNs;
+        deadline->NextReplenishNs += deadline->PeriodNs;
+        gStats.DeadlineReplenishCount++;
+
+        thread->State = KTHREAD_STATE_READY;
+        KiDeadlineInsertSorted(&gDeadlineReadyQueue, thread, FALSE);
+    }
+}
+
+uint64_t
+KiDeadlineEarliestReplenishNs(void)
+{
+    if (LinkedListIsEmpty(&gDeadlineThrottledList))
+        return 0;
+
+    return CONTAINING_RECORD(gDeadlineThrottledList.Flink, KTHREAD, ReadyLink)->Deadline.NextReplenishNs;
+}
+
+// Internal: drop a thread out of the deadline class and return its density.
+// The caller requeues the thread if it is parked on a deadline list.
+void
+KiDeadlineReleaseThread(KTHREAD *thread)
+{
+    KTHREAD_DEADLINE *deadline = &thread->Deadline;
+
+    if (!deadline->Active)
+        return;
+
+    gStats.DeadlineDensityPpm -= deadline->DensityPpm;
+    gStats.DeadlineThreadCount--;
+    deadline->Active = FALSE;
+    deadline->Throttled = FALSE;
+    deadline->PeriodicWait = FALSE;
+    deadline->DensityPpm = 0;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeThreadSetDeadline
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeThreadSetDeadline(KTHREAD *thread, const KE_DEADLINE_PARAMS *params)
+{
+    if (!thread)
+        return EC_ILLEGAL_ARGUMENT;
+
+    BOOL enable = params != NULL && params->RuntimeNs != 0;
+    KE_DEADLINE_PARAMS effective = {0};
+    uint32_t densityPpm = 0;
+
+    if (enable)
+    {
+        effective = *params;
+        if (effective.DeadlineNs == 0)
+            effective.DeadlineNs = effective.PeriodNs;
+
+        if (effective.RuntimeNs < KE_DEADLINE_MIN_RUNTIME_NS || effective.PeriodNs < KE_DEADLINE_MIN_PERIOD_NS ||
+            effective.PeriodNs > KE_DEADLINE_MAX_PERIOD_NS || effective.RuntimeNs > effective.DeadlineNs ||
+            effective.DeadlineNs > effective.PeriodNs)
+        {
+            return EC_ILLEGAL_ARGUMENT;
+        }
+
+        densityPpm = KiDeadlineDensityPpm(&effective);
+    }
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (thread == gIdleThread || thread->State == KTHREAD_STATE_TERMINATED)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        return EC_INVALID_STATE;
+    }
+
+    KTHREAD_DEADLINE *deadline = &thread->Deadline;
+    BOOL wasActive = deadline->Active;
+
+    if (enable)
+    {
+        uint32_t otherPpm = gStats.DeadlineDensityPpm - (wasActive ? deadline->DensityPpm : 0);
+        if ((uint64_t)otherPpm + densityPpm > KE_DEADLINE_MAX_DENSITY_PPM)
+        {
+            gStats.DeadlineRejectCount++;
+            KeLeaveCriticalSection(&criticalSection);
+            klog(KLOG_LEVEL_WARNING, "[SCHED] Thread %u deadline admission rejected (density=%u admitted=%u ppm)\n",
+                 thread->ThreadId, densityPpm, otherPpm);
+            return EC_OUT_OF_RESOURCE;
+        }
+    }
+    else if (!wasActive)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        return EC_SUCCESS;
+    }
+
+    // Take the thread off whichever queue it is parked on; it is requeued
+    // under its new class below.
+    BOOL requeue = FALSE;
+    if (thread->State == KTHREAD_STATE_READY)
+    {
+        LinkedListRemove(&thread->ReadyLink);
+        requeue = TRUE;
+    }
+    else if (wasActive && deadline->Throttled)
+    {
+        LinkedListRemove(&thread->ReadyLink);
+        thread->State = KTHREAD_STATE_READY;
+        requeue = TRUE;
+    }
+
+    uint64_t nowNs = KiNowNs();
+    if (thread == gCurrentThread)
+        KiDeadlineCharge(thread, nowNs);
+
+    KiDeadlineReleaseThread(thread);
+
+    if (enable)
+    {
+        deadline->Active = TRUE;
+        deadline->DensityPpm = densityPpm;
+        deadline->RuntimeNs = effective.RuntimeNs;
+        deadline->PeriodNs = effective.PeriodNs;
+        deadline->RelativeDeadlineNs = effective.DeadlineNs;
+        deadline->NextReplenishNs = 0; // The next enqueue releases a fresh job
+        gStats.DeadlineDensityPpm += densityPpm;
+        gStats.DeadlineThreadCount++;
+        gStats.DeadlineAdmitCount++;
+
+        if (thread == gCurrentThread)
+            KiDeadlineStartJob(thread, nowNs);
+    }
+
+    if (requeue)
+        KiInsertReadyThread(thread);
+
+    // The running thread's slice is now its budget (or back to the RR quantum).
+    if (thread == gCurrentThread)
+        KiArmForNextEvent(nowNs, thread);
+
+    KeLeaveCriticalSection(&criticalSection);
+
+    klog(KLOG_LEVEL_INFO, "[SCHED] Thread %u deadline class %s (runtime=%lu period=%lu deadline=%lu ns)\n",
+         thread->ThreadId, enable ? "set" : "cleared", (unsigned long)effective.RuntimeNs,
+         (unsigned long)effective.PeriodNs, (unsigned long)effective.DeadlineNs);
+    return EC_SUCCESS;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeThreadWaitNextPeriod
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeThreadWaitNextPeriod(void)
+{
+    KiAssertBlockingAllowed();
+
+    KTHREAD *thread = gCurrentThread;
+
+    KE_IRQL_GUARD irqlGuard = {0};
+    KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (thread == gIdleThread || !KiIsDeadlineThread(thread))
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        KeReleaseIrqlGuard(&irqlGuard);
+        return EC_INVALID_STATE;
+    }
+
+    KTHREAD_DEADLINE *deadline = &thread->Deadline;
+    uint64_t nowNs = KiNowNs();
+
+    if (nowNs > deadline->JobDeadlineNs)
+    {
+        uint64_t latenessNs = nowNs - deadline->JobDeadlineNs;
+        deadline->MissCount++;
+        gStats.DeadlineMissCount++;
+        if (latenessNs > deadline->MaxLatenessNs)
+            deadline->MaxLatenessNs = latenessNs;
+    }
+
+    // Skip releases the job already overran; the next job starts on the first
+    // period boundary still ahead.
+    uint64_t releaseNs = deadline->NextReplenishNs;
+    while (releaseNs <= nowNs)
+        releaseNs += deadline->PeriodNs;
+
+    deadline->NextReplenishNs = releaseNs;
+    deadline->PeriodicWait = TRUE;
+
+    KWAIT_BLOCK *wb = &thread->WaitBlock;
+    KiInitWaitBlock(wb);
+    wb->DeadlineNs = releaseNs;
+
+    thread->State = KTHREAD_STATE_BLOCKED;
+    KiInsertTimeoutQueue(wb);
+
+    KeLeaveCriticalSection(&criticalSection);
+    KiSchedule();
+    KeReleaseIrqlGuard(&irqlGuard);
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API HO_STATUS
+KeThreadQueryDeadline(KTHREAD *thread, KE_DEADLINE_THREAD_STATS *outStats)
+{
+    if (!thread || !outStats)
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    const KTHREAD_DEADLINE *deadline = &thread->Deadline;
+    outStats->Active = deadline->Active;
+    outStats->Throttled = deadline->Throttled;
+    outStats->JobCount = deadline->JobCount;
+    outStats->MissCount = deadline->MissCount;
+    outStats->ThrottleCount = deadline->ThrottleCount;
+    outStats->MaxLatenessNs = deadline->MaxLatenessNs;
+    outStats->RemainingNs = deadline->RemainingNs;
+    outStats->AbsoluteDeadlineNs = deadline->AbsoluteDeadlineNs;
+
+    KeLeaveCriticalSection(&criticalSection);
+    return EC_SUCCESS;
+}
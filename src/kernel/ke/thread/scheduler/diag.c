@@ -67,6 +67,28 @@ KeQuerySchedulerInfo(KE_SYSINFO_SCHEDULER_DATA *out)
     out->YieldCount = gStats.YieldCount;
     out->SleepWakeCount = gStats.SleepWakeCount;
     out->TotalThreadsCreated = gStats.TotalThreadsCreated;
+    out->PriorityBoostCount = gStats.PriorityBoostCount;
+    out->ReaperThreadId = gReaperThread ? gReaperThread->ThreadId : 0;
+    out->ReaperBacklogDepth = gStats.ReaperBacklogDepth;
+    out->MaxReaperBacklogDepth = gStats.MaxReaperBacklogDepth;
+    out->ReaperWakeCount = gStats.ReaperWakeCount;
+    out->ReaperHandOffCount = gStats.ReaperHandOffCount;
+    out->ReaperBatchCount = gStats.ReaperBatchCount;
+    out->ReapedThreadCount = gStats.ReapedThreadCount;
+    out->ReclaimLatencyTotalNs = gStats.ReclaimLatencyTotalNs;
+    out->ReclaimLatencyMaxNs = gStats.ReclaimLatencyMaxNs;
+    out->DeadlineThreadCount = gStats.DeadlineThreadCount;
+    out->DeadlineDensityPpm = gStats.DeadlineDensityPpm;
+    out->DeadlineReadyDepth = KiCountQueueDepth(&gDeadlineReadyQueue);
+    out->DeadlineThrottledDepth = KiCountQueueDepth(&gDeadlineThrottledList);
+    out->DeadlineAdmitCount = gStats.DeadlineAdmitCount;
+    out->DeadlineRejectCount = gStats.DeadlineRejectCount;
+    out->DeadlineJobCount = gStats.DeadlineJobCount;
+    out->DeadlineMissCount = gStats.DeadlineMissCount;
+    out->DeadlineThrottleCount = gStats.DeadlineThrottleCount;
+    out->DeadlineReplenishCount = gStats.DeadlineReplenishCount;
+    out->DeadlinePreemptionCount = gStats.DeadlinePreemptionCount;
+    KeQueryIdleStats(&out->Idle);
     out->ActiveThreadCount = gStats.ActiveThreadCount;
 
     KeLeaveCriticalSection(&criticalSection);
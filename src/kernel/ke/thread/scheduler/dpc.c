@@ -0,0 +1,172 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/thread/scheduler/dpc.c
+ * Description: Per-CPU deferred procedure call queue.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "scheduler_internal.h"
+
+#include <kernel/ke/dpc.h>
+#include <kernel/ke/work_queue.h>
+#include <arch/amd64/asm.h>
+
+// UP kernel: the single DPC queue is the per-CPU queue of CPU 0.
+static LINKED_LIST_TAG gDpcQueue = {&gDpcQueue, &gDpcQueue};
+static KE_DPC_STATS gDpcStats;
+
+static void
+KiAssertDpc(const KDPC *dpc)
+{
+    HO_KASSERT(dpc != NULL, EC_ILLEGAL_ARGUMENT);
+    HO_KASSERT(dpc->Signature == KDPC_SIGNATURE, EC_INVALID_STATE);
+    HO_KASSERT(dpc->Routine != NULL, EC_INVALID_STATE);
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeInitializeDpc
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API void
+KeInitializeDpc(KDPC *dpc, KDPC_ROUTINE routine, void *context)
+{
+    HO_KASSERT(dpc != NULL, EC_ILLEGAL_ARGUMENT);
+    HO_KASSERT(routine != NULL, EC_ILLEGAL_ARGUMENT);
+
+    dpc->Signature = KDPC_SIGNATURE;
+    dpc->Queued = FALSE;
+    LinkedListInit(&dpc->QueueLink);
+    dpc->Routine = routine;
+    dpc->Context = context;
+    dpc->InsertTsc = 0;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeInsertQueueDpc / KeRemoveQueueDpc
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API BOOL
+KeInsertQueueDpc(KDPC *dpc)
+{
+    KiAssertDpc(dpc);
+
+    // Leaving the critical section retires the queue only when it is the
+    // outermost guard and interrupts were enabled on entry; inside an ISR or
+    // another guard the DPC waits for that outer exit.
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (dpc->Queued)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        return FALSE;
+    }
+
+    dpc->Queued = TRUE;
+    dpc->InsertTsc = rdtsc();
+    LinkedListInsertTail(&gDpcQueue, &dpc->QueueLink);
+
+    gDpcStats.QueuedCount++;
+    gDpcStats.QueueDepth++;
+    if (gDpcStats.QueueDepth > gDpcStats.MaxQueueDepth)
+        gDpcStats.MaxQueueDepth = gDpcStats.QueueDepth;
+
+    KeLeaveCriticalSection(&criticalSection);
+    return TRUE;
+}
+
+HO_KERNEL_API BOOL
+KeRemoveQueueDpc(KDPC *dpc)
+{
+    KiAssertDpc(dpc);
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    BOOL wasQueued = dpc->Queued;
+    if (wasQueued)
+    {
+        LinkedListRemove(&dpc->QueueLink);
+        LinkedListInit(&dpc->QueueLink);
+        dpc->Queued = FALSE;
+        HO_KASSERT(gDpcStats.QueueDepth != 0, EC_INVALID_STATE);
+        gDpcStats.QueueDepth--;
+    }
+
+    KeLeaveCriticalSection(&criticalSection);
+    return wasQueued;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KiRetireDpcQueue — called by the IRQL layer on the drop to DISPATCH
+// ─────────────────────────────────────────────────────────────
+
+BOOL
+KiRetireDpcQueue(void)
+{
+    if (LinkedListIsEmpty(&gDpcQueue) && !KiWorkQueueHasDeferredWakes())
+        return TRUE;
+
+    KiAssertDispatchLevel();
+    HO_KASSERT(!ArchGetInterruptState().MaskableInterruptEnabled, EC_INVALID_STATE);
+
+    gDpcStats.RetireCount++;
+    uint64_t entrySwitchCount = gStats.ContextSwitchCount;
+
+    // A routine may reschedule (e.g. KeSetEvent while idle). Whichever thread
+    // reaches the next retirement point picks up the remainder; each pop is
+    // atomic because interrupts stay disabled.
+    while (!LinkedListIsEmpty(&gDpcQueue))
+    {
+        LINKED_LIST_TAG *entry = gDpcQueue.Flink;
+        KDPC *dpc = CONTAINING_RECORD(entry, KDPC, QueueLink);
+
+        LinkedListRemove(entry);
+        LinkedListInit(entry);
+        dpc->Queued = FALSE;
+        HO_KASSERT(gDpcStats.QueueDepth != 0, EC_INVALID_STATE);
+        gDpcStats.QueueDepth--;
+
+        uint64_t startTsc = rdtsc();
+        uint64_t queueCycles = startTsc - dpc->InsertTsc;
+        gDpcStats.TotalQueueCycles += queueCycles;
+        if (queueCycles > gDpcStats.MaxQueueCycles)
+            gDpcStats.MaxQueueCycles = queueCycles;
+
+        uint64_t switchCount = gStats.ContextSwitchCount;
+        dpc->Routine(dpc, dpc->Context);
+        gDpcStats.ExecutedCount++;
+
+        // Samples that spanned a context switch measure another thread's run.
+        if (switchCount == gStats.ContextSwitchCount)
+        {
+            uint64_t routineCycles = rdtsc() - startTsc;
+            gDpcStats.TotalRoutineCycles += routineCycles;
+            if (routineCycles > gDpcStats.MaxRoutineCycles)
+                gDpcStats.MaxRoutineCycles = routineCycles;
+        }
+    }
+
+    // Work items queued by the ISR or by the routines above wake their workers only now, so a wake that switches
+    // threads never leaves DPCs stranded behind it.
+    KiWorkQueueFlushDeferredWakes();
+
+    return entrySwitchCount == gStats.ContextSwitchCount;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeQueryDpcStats
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API void
+KeQueryDpcStats(KE_DPC_STATS *out)
+{
+    HO_KASSERT(out != NULL, EC_ILLEGAL_ARGUMENT);
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    *out = gDpcStats;
+    KeLeaveCriticalSection(&criticalSection);
+}
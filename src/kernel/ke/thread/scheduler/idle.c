@@ -0,0 +1,230 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/thread/scheduler/idle.c
+ * Description: Idle driver — MONITOR/MWAIT or HLT, with residency and
+ *              exit-latency accounting.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "scheduler_internal.h"
+
+#include <kernel/ke/idle.h>
+#include <arch/amd64/asm.h>
+
+#define KE_CPUID_LEAF_FEATURES   1U
+#define KE_CPUID_LEAF_MONITOR    5U
+#define KE_CPUID_ECX_MONITOR     (1U << 3)
+#define KE_MWAIT_HINT_C1         0U
+#define KE_IDLE_FIRST_BUCKET_NS  10000ULL // 10 us
+
+typedef struct KE_IDLE_PRCB
+{
+    // Monitored word. It leads a cache-line aligned block so unrelated stores
+    // to the bookkeeping below do not trip the monitor.
+    volatile uint32_t NeedResched;
+    uint8_t MonitorPad[60];
+
+    uint64_t RequestTsc; // TSC of the store that set NeedResched
+
+    BOOL Halted;      // Between idle entry and the wake event
+    BOOL ExitPending; // Wake stamped, exit latency not yet closed
+    uint64_t EntryNs;
+    uint64_t WakeTsc;
+    KE_IDLE_STATS Stats;
+} KE_IDLE_PRCB;
+
+// UP kernel: the single idle PRCB belongs to CPU 0.
+static KE_IDLE_PRCB gIdlePrcb __attribute__((aligned(64)));
+static BOOL gIdleDetected;
+
+static inline void
+KiMonitor(const volatile void *address)
+{
+    __asm__ __volatile__("monitor" : : "a"(address), "c"(0U), "d"(0U) : "memory");
+}
+
+static void
+KiIdleDetect(void)
+{
+    uint32_t eax, ebx, ecx, edx;
+
+    gIdlePrcb.Stats.Method = KE_IDLE_METHOD_HLT;
+    gIdlePrcb.Stats.MonitorLineSize = 0;
+
+    cpuid(0, &eax, &ebx, &ecx, &edx);
+    uint32_t maxLeaf = eax;
+
+    cpuid(KE_CPUID_LEAF_FEATURES, &eax, &ebx, &ecx, &edx);
+    if ((ecx & KE_CPUID_ECX_MONITOR) != 0 && maxLeaf >= KE_CPUID_LEAF_MONITOR)
+    {
+        cpuid(KE_CPUID_LEAF_MONITOR, &eax, &ebx, &ecx, &edx);
+        uint32_t lineSize = ebx & 0xFFFFU;
+
+        // A monitor line wider than the padded block would let bookkeeping
+        // stores wake the CPU; HLT is the better choice there.
+        if (lineSize != 0 && lineSize <= 64U)
+        {
+            gIdlePrcb.Stats.Method = KE_IDLE_METHOD_MWAIT;
+            gIdlePrcb.Stats.MonitorLineSize = lineSize;
+        }
+    }
+
+    gIdleDetected = TRUE;
+    klog(KLOG_LEVEL_INFO, "[IDLE] method=%s monitor_line=%u\n",
+         gIdlePrcb.Stats.Method == KE_IDLE_METHOD_MWAIT ? "mwait" : "hlt", gIdlePrcb.Stats.MonitorLineSize);
+}
+
+static void
+KiIdleRecordResidency(uint64_t residencyNs)
+{
+    KE_IDLE_STATS *stats = &gIdlePrcb.Stats;
+    uint64_t bound = KE_IDLE_FIRST_BUCKET_NS;
+    uint32_t bucket = 0;
+
+    while (bucket < KE_IDLE_RESIDENCY_BUCKETS - 1U && residencyNs >= bound)
+    {
+        bound *= 10ULL;
+        bucket++;
+    }
+
+    stats->ResidencyHistogram[bucket]++;
+    stats->TotalResidencyNs += residencyNs;
+    if (residencyNs > stats->MaxResidencyNs)
+        stats->MaxResidencyNs = residencyNs;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Wake / exit hooks
+// ─────────────────────────────────────────────────────────────
+
+void
+KiRequestIdleReschedule(void)
+{
+    if (gIdlePrcb.NeedResched != 0)
+        return;
+
+    gIdlePrcb.RequestTsc = rdtsc();
+    gIdlePrcb.NeedResched = 1U;
+}
+
+void
+KiIdleNoteInterrupt(void)
+{
+    if (!gIdlePrcb.Halted)
+        return;
+
+    gIdlePrcb.Halted = FALSE;
+    gIdlePrcb.WakeTsc = rdtsc();
+    gIdlePrcb.ExitPending = TRUE;
+    gIdlePrcb.Stats.InterruptWakeCount++;
+    KiIdleRecordResidency(KiNowNs() - gIdlePrcb.EntryNs);
+}
+
+void
+KiIdleNoteExit(void)
+{
+    if (!gIdlePrcb.ExitPending)
+        return;
+
+    gIdlePrcb.ExitPending = FALSE;
+
+    KE_IDLE_STATS *stats = &gIdlePrcb.Stats;
+    uint64_t cycles = rdtsc() - gIdlePrcb.WakeTsc;
+    stats->ExitLatencySamples++;
+    stats->TotalExitLatencyCycles += cycles;
+    if (cycles > stats->MaxExitLatencyCycles)
+        stats->MaxExitLatencyCycles = cycles;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KiIdleHalt — one idle entry, called from KeIdleLoop
+// ─────────────────────────────────────────────────────────────
+
+static void
+KiIdleDispatch(void)
+{
+    KE_IRQL_GUARD irqlGuard = {0};
+    KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    gIdlePrcb.NeedResched = 0;
+    BOOL needSchedule = KiHasAnyReadyThread();
+
+    KeLeaveCriticalSection(&criticalSection);
+
+    if (needSchedule)
+        KiSchedule();
+
+    KeReleaseIrqlGuard(&irqlGuard);
+}
+
+void
+KiIdleHalt(void)
+{
+    if (!gIdleDetected)
+        KiIdleDetect();
+
+    BOOL useMwait = gIdlePrcb.Stats.Method == KE_IDLE_METHOD_MWAIT;
+
+    x64_Cli();
+
+    if (useMwait)
+        KiMonitor(&gIdlePrcb.NeedResched);
+
+    // Checked after arming: a store that lands from here on wakes MWAIT, and an
+    // interrupt is held pending until the STI shadow ends inside MWAIT/HLT.
+    if (gIdlePrcb.NeedResched != 0)
+    {
+        gIdlePrcb.Stats.SkippedCount++;
+        x64_Sti();
+        KiIdleDispatch();
+        return;
+    }
+
+    gIdlePrcb.Stats.EntryCount++;
+    gIdlePrcb.EntryNs = KiNowNs();
+    gIdlePrcb.Halted = TRUE;
+
+    if (useMwait)
+        __asm__ __volatile__("sti; mwait" : : "a"(KE_MWAIT_HINT_C1), "c"(0U) : "memory");
+    else
+        __asm__ __volatile__("sti; hlt" ::: "memory");
+
+    x64_Cli();
+
+    // Still marked halted: no interrupt ran, so the monitor (or a spurious
+    // MWAIT exit) woke the CPU.
+    if (gIdlePrcb.Halted)
+    {
+        gIdlePrcb.Halted = FALSE;
+        gIdlePrcb.WakeTsc = gIdlePrcb.NeedResched != 0 ? gIdlePrcb.RequestTsc : rdtsc();
+        gIdlePrcb.ExitPending = TRUE;
+        gIdlePrcb.Stats.MonitorWakeCount++;
+        KiIdleRecordResidency(KiNowNs() - gIdlePrcb.EntryNs);
+    }
+
+    KiIdleNoteExit();
+    BOOL needResched = gIdlePrcb.NeedResched != 0;
+    x64_Sti();
+
+    if (needResched)
+        KiIdleDispatch();
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeQueryIdleStats
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API void
+KeQueryIdleStats(KE_IDLE_STATS *out)
+{
+    HO_KASSERT(out != NULL, EC_ILLEGAL_ARGUMENT);
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    *out = gIdlePrcb.Stats;
+    KeLeaveCriticalSection(&criticalSection);
+}
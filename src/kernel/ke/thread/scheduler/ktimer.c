@@ -0,0 +1,201 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/thread/scheduler/ktimer.c
+ * Description: Kernel timer object (KTIMER) on the unified wait model. An armed
+ *              timer is an entry in the scheduler timeout queue and expires from
+ *              the same clock-event DPC that retires sleeps and timed waits.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "scheduler_internal.h"
+
+static void KiAssertTimerState(const KTIMER *timer);
+static void KiInsertTimer(KTIMER *timer, uint64_t deadlineNs);
+static void KiRemoveTimer(KTIMER *timer);
+
+// Internal: validate runtime timer invariants
+static void
+KiAssertTimerState(const KTIMER *timer)
+{
+    HO_KASSERT(timer != NULL, EC_ILLEGAL_ARGUMENT);
+    HO_KASSERT(timer->Header.Signature == KDISPATCHER_SIGNATURE, EC_INVALID_STATE);
+    HO_KASSERT(timer->Header.Type == DISPATCHER_TYPE_TIMER, EC_NOT_SUPPORTED);
+    HO_KASSERT(timer->Header.SignalState == 0 || timer->Header.SignalState == 1, EC_INVALID_STATE);
+    HO_KASSERT(timer->TimeoutEntry.Timer == timer, EC_INVALID_STATE);
+}
+
+// Internal: queue the timer entry; a deadline of 0 would read as "no timeout".
+static void
+KiInsertTimer(KTIMER *timer, uint64_t deadlineNs)
+{
+    timer->TimeoutEntry.DeadlineNs = deadlineNs != 0 ? deadlineNs : 1;
+    timer->TimeoutEntry.SlackNs = 0;
+    KiInsertTimeoutQueue(&timer->TimeoutEntry);
+    timer->Armed = TRUE;
+}
+
+static void
+KiRemoveTimer(KTIMER *timer)
+{
+    LinkedListRemove(&timer->TimeoutEntry.TimeoutLink);
+    LinkedListInit(&timer->TimeoutEntry.TimeoutLink);
+    timer->Armed = FALSE;
+}
+
+// Internal: expire a timer whose entry reached the head of the timeout queue.
+// Runs from KiWakeTimeouts at DISPATCH_LEVEL; the caller decides whether the
+// released waiters preempt the current thread.
+void
+KiExpireTimer(KTIMER *timer, uint64_t nowNs)
+{
+    KiAssertTimerState(timer);
+    HO_KASSERT(timer->Armed, EC_INVALID_STATE);
+
+    uint64_t deadlineNs = timer->TimeoutEntry.DeadlineNs;
+    KiRemoveTimer(timer);
+    timer->ExpiryCount++;
+
+    if (timer->Type == KTIMER_NOTIFICATION)
+    {
+        timer->Header.SignalState = 1;
+        while (!LinkedListIsEmpty(&timer->Header.WaitListHead))
+        {
+            KWAIT_BLOCK *block = CONTAINING_RECORD(timer->Header.WaitListHead.Flink, KWAIT_BLOCK, WaitListLink);
+            KiCompleteWait(block, EC_SUCCESS);
+        }
+    }
+    else if (!LinkedListIsEmpty(&timer->Header.WaitListHead))
+    {
+        // The wait list is priority-ordered; the head waiter consumes this expiry.
+        KWAIT_BLOCK *block = CONTAINING_RECORD(timer->Header.WaitListHead.Flink, KWAIT_BLOCK, WaitListLink);
+        KiCompleteWait(block, EC_SUCCESS);
+    }
+    else
+    {
+        timer->Header.SignalState = 1;
+    }
+
+    if (timer->PeriodNs != 0)
+    {
+        // Periods missed entirely (a long DISPATCH section) are skipped, not replayed as a burst.
+        uint64_t nextNs = deadlineNs + timer->PeriodNs;
+        if (nextNs <= nowNs)
+            nextNs = deadlineNs + ((nowNs - deadlineNs) / timer->PeriodNs + 1U) * timer->PeriodNs;
+        KiInsertTimer(timer, nextNs);
+    }
+
+    if (timer->Dpc != NULL)
+        (void)KeInsertQueueDpc(timer->Dpc);
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeInitializeTimer
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API void
+KeInitializeTimer(KTIMER *timer, KTIMER_TYPE type)
+{
+    HO_KASSERT(timer != NULL, EC_ILLEGAL_ARGUMENT);
+    HO_KASSERT(type == KTIMER_NOTIFICATION || type == KTIMER_SYNCHRONIZATION, EC_ILLEGAL_ARGUMENT);
+
+    timer->Header.Signature = KDISPATCHER_SIGNATURE;
+    timer->Header.Type = DISPATCHER_TYPE_TIMER;
+    timer->Header.SignalState = 0;
+    LinkedListInit(&timer->Header.WaitListHead);
+    KiInitLockProfileHeader(&timer->Header);
+    timer->Type = type;
+    KiInitWaitBlock(&timer->TimeoutEntry);
+    timer->TimeoutEntry.Timer = timer;
+    timer->PeriodNs = 0;
+    timer->Dpc = NULL;
+    timer->Armed = FALSE;
+    timer->ExpiryCount = 0;
+
+    klog(KLOG_LEVEL_DEBUG, "[TIMER] Initialized (type=%s)\n",
+         type == KTIMER_NOTIFICATION ? "notification" : "synchronization");
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeSetTimer
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeSetTimer(KTIMER *timer, uint64_t dueTimeNs, uint64_t periodNs, KDPC *dpc, uint32_t flags)
+{
+    if (timer == NULL || (flags & ~KTIMER_FLAG_ABSOLUTE) != 0)
+        return EC_ILLEGAL_ARGUMENT;
+
+    if (dpc != NULL && dpc->Signature != KDPC_SIGNATURE)
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    KiAssertTimerState(timer);
+
+    uint64_t deadlineNs = dueTimeNs;
+    if ((flags & KTIMER_FLAG_ABSOLUTE) == 0)
+    {
+        uint64_t nowNs = KiNowNs();
+        if (dueTimeNs > 0xFFFFFFFFFFFFFFFFULL - nowNs)
+        {
+            KeLeaveCriticalSection(&criticalSection);
+            return EC_ILLEGAL_ARGUMENT;
+        }
+        deadlineNs = nowNs + dueTimeNs;
+    }
+
+    if (timer->Armed)
+        KiRemoveTimer(timer);
+
+    timer->Header.SignalState = 0;
+    timer->PeriodNs = periodNs;
+    timer->Dpc = dpc;
+    KiInsertTimer(timer, deadlineNs);
+    KiArmForEarlierDeadline(timer->TimeoutEntry.DeadlineNs);
+
+    klog(KLOG_LEVEL_DEBUG, "[TIMER] Set (deadline=%lu period=%lu dpc=%u)\n", (unsigned long)deadlineNs,
+         (unsigned long)periodNs, dpc != NULL ? 1U : 0U);
+
+    KeLeaveCriticalSection(&criticalSection);
+    return EC_SUCCESS;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeCancelTimer
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API BOOL
+KeCancelTimer(KTIMER *timer)
+{
+    HO_KASSERT(timer != NULL, EC_ILLEGAL_ARGUMENT);
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    KiAssertTimerState(timer);
+
+    // The programmed clock event is left alone; if it was this timer's, the
+    // expiry DPC finds nothing due and re-arms for the next entry.
+    BOOL wasArmed = timer->Armed;
+    if (wasArmed)
+        KiRemoveTimer(timer);
+
+    KeLeaveCriticalSection(&criticalSection);
+    return wasArmed;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeReadStateTimer
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API BOOL
+KeReadStateTimer(KTIMER *timer)
+{
+    HO_KASSERT(timer != NULL, EC_ILLEGAL_ARGUMENT);
+    HO_KASSERT(timer->Header.Type == DISPATCHER_TYPE_TIMER, EC_NOT_SUPPORTED);
+
+    return timer->Header.SignalState != 0;
+}
@@ -0,0 +1,416 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/thread/scheduler/rwlock.c
+ * Description: Writer-preferring reader-writer lock (KRWLOCK) on the unified wait model.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "scheduler_internal.h"
+
+#define KI_RWLOCK_EXCLUSIVE (-1)
+
+static void KiAssertRwLockState(const KRWLOCK *lock);
+static void KiRwLockGrantWaiters(KRWLOCK *lock);
+static HO_STATUS KiRwLockAcquire(KRWLOCK *lock, uint64_t timeoutNs, BOOL shared);
+static HO_STATUS KiRwLockRelease(KRWLOCK *lock, BOOL shared);
+
+// Internal: validate runtime reader-writer lock invariants
+static void
+KiAssertRwLockState(const KRWLOCK *lock)
+{
+    HO_KASSERT(lock != NULL, EC_ILLEGAL_ARGUMENT);
+    HO_KASSERT(lock->Header.Signature == KDISPATCHER_SIGNATURE, EC_INVALID_STATE);
+    HO_KASSERT(lock->Header.Type == DISPATCHER_TYPE_RWLOCK, EC_NOT_SUPPORTED);
+    HO_KASSERT(lock->Header.SignalState >= KI_RWLOCK_EXCLUSIVE, EC_INVALID_STATE);
+
+    if (lock->Header.SignalState == KI_RWLOCK_EXCLUSIVE)
+    {
+        HO_KASSERT(lock->OwnerThread != NULL, EC_INVALID_STATE);
+        HO_KASSERT(lock->UpgradeWaiter == NULL, EC_INVALID_STATE);
+    }
+    else
+    {
+        HO_KASSERT(lock->OwnerThread == NULL, EC_INVALID_STATE);
+    }
+
+    // An upgrader still counts as one of the shared holders it is waiting on.
+    if (lock->UpgradeWaiter != NULL)
+        HO_KASSERT(lock->Header.SignalState >= 1, EC_INVALID_STATE);
+}
+
+// Internal: test whether the lock can be granted in the requested mode right now
+// and consume the grant if so. Shared requests queue behind any pending writer or
+// upgrade so that a steady stream of readers cannot starve them.
+HO_STATUS
+KiRwLockTryAcquire(KRWLOCK *lock, KTHREAD *thread, BOOL shared, BOOL *acquired)
+{
+    HO_KASSERT(acquired != NULL, EC_ILLEGAL_ARGUMENT);
+    KiAssertRwLockState(lock);
+
+    *acquired = FALSE;
+
+    if (lock->OwnerThread == thread)
+        return EC_INVALID_STATE;
+
+    if (shared)
+    {
+        if (lock->Header.SignalState < 0 || lock->ExclusiveWaiterCount != 0 || lock->UpgradeWaiter != NULL)
+            return EC_SUCCESS;
+
+        lock->Header.SignalState++;
+        *acquired = TRUE;
+        return EC_SUCCESS;
+    }
+
+    if (lock->Header.SignalState != 0)
+        return EC_SUCCESS;
+
+    lock->Header.SignalState = KI_RWLOCK_EXCLUSIVE;
+    lock->OwnerThread = thread;
+    KiLockProfileHoldBegin(&lock->Header);
+    *acquired = TRUE;
+    return EC_SUCCESS;
+}
+
+// Internal: hand the lock to whoever is next after a release, downgrade, or a waiter
+// leaving. A pending upgrade goes first and holds everyone else back; otherwise the
+// wait list head decides: one writer, or the run of readers queued ahead of the first
+// writer. Readers only join an already-shared lock when no writer is queued.
+static void
+KiRwLockGrantWaiters(KRWLOCK *lock)
+{
+    KiAssertRwLockState(lock);
+
+    if (lock->UpgradeWaiter != NULL)
+    {
+        if (lock->Header.SignalState == 1)
+        {
+            KTHREAD *upgrader = lock->UpgradeWaiter;
+            lock->Header.SignalState = KI_RWLOCK_EXCLUSIVE;
+            lock->OwnerThread = upgrader;
+            KiLockProfileHoldBegin(&lock->Header);
+            KiCompleteWait(&upgrader->WaitBlock, EC_SUCCESS);
+            klog(KLOG_LEVEL_DEBUG, "[RWLOCK] Upgrade granted (thread=%u)\n", upgrader->ThreadId);
+        }
+        return;
+    }
+
+    BOOL freshGrant = lock->Header.SignalState == 0;
+
+    while (!LinkedListIsEmpty(&lock->Header.WaitListHead))
+    {
+        LINKED_LIST_TAG *entry = lock->Header.WaitListHead.Flink;
+        KWAIT_BLOCK *block = CONTAINING_RECORD(entry, KWAIT_BLOCK, WaitListLink);
+        KTHREAD *waiter = CONTAINING_RECORD(block, KTHREAD, WaitBlock);
+
+        if (!block->SharedAcquire)
+        {
+            if (lock->Header.SignalState != 0)
+                break;
+
+            lock->Header.SignalState = KI_RWLOCK_EXCLUSIVE;
+            lock->OwnerThread = waiter;
+            KiLockProfileHoldBegin(&lock->Header);
+            KiCompleteWait(block, EC_SUCCESS);
+            break;
+        }
+
+        if (lock->Header.SignalState < 0 || (!freshGrant && lock->ExclusiveWaiterCount != 0))
+            break;
+
+        lock->Header.SignalState++;
+        KiCompleteWait(block, EC_SUCCESS);
+    }
+
+    KiAssertRwLockState(lock);
+}
+
+// Internal: bookkeeping when a waiter leaves the lock, called from KiCompleteWait.
+// A writer or upgrader that timed out was holding readers back, so re-run the grant.
+void
+KiRwLockWaiterLeft(KRWLOCK *lock, KWAIT_BLOCK *block, HO_STATUS status)
+{
+    KTHREAD *thread = CONTAINING_RECORD(block, KTHREAD, WaitBlock);
+
+    if (lock->UpgradeWaiter == thread)
+    {
+        lock->UpgradeWaiter = NULL;
+    }
+    else if (!block->SharedAcquire)
+    {
+        HO_KASSERT(lock->ExclusiveWaiterCount != 0, EC_INVALID_STATE);
+        lock->ExclusiveWaiterCount--;
+    }
+
+    if (status == EC_TIMEOUT)
+        KiRwLockGrantWaiters(lock);
+}
+
+// Internal: drop exclusive ownership held by the current thread. Caller holds the
+// dispatcher critical section (KeWaitForCondition relies on this).
+void
+KiRwLockReleaseExclusiveLocked(KRWLOCK *lock)
+{
+    KiAssertRwLockState(lock);
+    HO_KASSERT(lock->OwnerThread == gCurrentThread, EC_INVALID_STATE);
+
+    KiLockProfileHoldEnd(&lock->Header);
+    lock->OwnerThread = NULL;
+    lock->Header.SignalState = 0;
+    KiRwLockGrantWaiters(lock);
+}
+
+static HO_STATUS
+KiRwLockAcquire(KRWLOCK *lock, uint64_t timeoutNs, BOOL shared)
+{
+    if (lock == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+
+    // A zero timeout never blocks, so it is a valid try-acquire at DISPATCH_LEVEL too.
+    if (timeoutNs != 0)
+    {
+        KiAssertBlockingAllowed();
+        HO_KASSERT(gCurrentThread != gIdleThread, EC_INVALID_STATE);
+    }
+
+    uint64_t profileStart = KiLockProfileWaitBegin(&lock->Header);
+    KE_IRQL_GUARD irqlGuard = {0};
+    KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    BOOL acquired = FALSE;
+    HO_STATUS status = KiRwLockTryAcquire(lock, gCurrentThread, shared, &acquired);
+    if (status != EC_SUCCESS || acquired || timeoutNs == 0)
+    {
+        if (status == EC_SUCCESS)
+            KiLockProfileWaitEnd(&lock->Header, profileStart, FALSE, acquired ? EC_SUCCESS : EC_TIMEOUT);
+        KeLeaveCriticalSection(&criticalSection);
+        KeReleaseIrqlGuard(&irqlGuard);
+        return status != EC_SUCCESS ? status : (acquired ? EC_SUCCESS : EC_TIMEOUT);
+    }
+
+    KiPrepareBlockingWait(&lock->Header, timeoutNs, TRUE);
+    gCurrentThread->WaitBlock.SharedAcquire = shared;
+    if (!shared)
+        lock->ExclusiveWaiterCount++;
+
+    KeLeaveCriticalSection(&criticalSection);
+    KiSchedule();
+
+    status = gCurrentThread->WaitBlock.CompletionStatus;
+    KiLockProfileWaitEnd(&lock->Header, profileStart, TRUE, status);
+    KeReleaseIrqlGuard(&irqlGuard);
+    return status;
+}
+
+static HO_STATUS
+KiRwLockRelease(KRWLOCK *lock, BOOL shared)
+{
+    if (lock == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+
+    BOOL preemptAllowed = KeIsBlockingAllowed();
+    KE_IRQL_GUARD irqlGuard = {0};
+    KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    KiAssertRwLockState(lock);
+
+    // Shared holders are anonymous: only the mode can be checked, not the caller.
+    BOOL valid = shared ? lock->Header.SignalState > 0 : lock->OwnerThread == gCurrentThread;
+    if (!valid)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        KeReleaseIrqlGuard(&irqlGuard);
+        return EC_INVALID_STATE;
+    }
+
+    if (shared)
+    {
+        lock->Header.SignalState--;
+        KiRwLockGrantWaiters(lock);
+    }
+    else
+    {
+        KiRwLockReleaseExclusiveLocked(lock);
+    }
+
+    klog(KLOG_LEVEL_DEBUG, "[RWLOCK] Release(%s, thread=%u, state=%ld)\n", shared ? "shared" : "exclusive",
+         gCurrentThread->ThreadId, (long)lock->Header.SignalState);
+
+    BOOL needSchedule = KiPreemptAfterRelease(preemptAllowed);
+
+    KeLeaveCriticalSection(&criticalSection);
+
+    if (needSchedule)
+        KiSchedule();
+
+    KeReleaseIrqlGuard(&irqlGuard);
+    return EC_SUCCESS;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeInitializeRwLock
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API void
+KeInitializeRwLock(KRWLOCK *lock)
+{
+    HO_KASSERT(lock != NULL, EC_ILLEGAL_ARGUMENT);
+
+    lock->Header.Signature = KDISPATCHER_SIGNATURE;
+    lock->Header.Type = DISPATCHER_TYPE_RWLOCK;
+    lock->Header.SignalState = 0;
+    LinkedListInit(&lock->Header.WaitListHead);
+    KiInitLockProfileHeader(&lock->Header);
+    lock->OwnerThread = NULL;
+    lock->ExclusiveWaiterCount = 0;
+    lock->UpgradeWaiter = NULL;
+
+    KiAssertRwLockState(lock);
+    klog(KLOG_LEVEL_DEBUG, "[RWLOCK] Initialized\n");
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeAcquireRwLockShared / KeAcquireRwLockExclusive
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeAcquireRwLockShared(KRWLOCK *lock, uint64_t timeoutNs)
+{
+    return KiRwLockAcquire(lock, timeoutNs, TRUE);
+}
+
+HO_KERNEL_API HO_STATUS
+KeAcquireRwLockExclusive(KRWLOCK *lock, uint64_t timeoutNs)
+{
+    return KiRwLockAcquire(lock, timeoutNs, FALSE);
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeReleaseRwLockShared / KeReleaseRwLockExclusive
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeReleaseRwLockShared(KRWLOCK *lock)
+{
+    return KiRwLockRelease(lock, TRUE);
+}
+
+HO_KERNEL_API HO_STATUS
+KeReleaseRwLockExclusive(KRWLOCK *lock)
+{
+    return KiRwLockRelease(lock, FALSE);
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeUpgradeRwLock
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeUpgradeRwLock(KRWLOCK *lock, uint64_t timeoutNs)
+{
+    if (lock == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+
+    if (timeoutNs != 0)
+    {
+        KiAssertBlockingAllowed();
+        HO_KASSERT(gCurrentThread != gIdleThread, EC_INVALID_STATE);
+    }
+
+    uint64_t profileStart = KiLockProfileWaitBegin(&lock->Header);
+    KE_IRQL_GUARD irqlGuard = {0};
+    KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    KiAssertRwLockState(lock);
+
+    // Two upgraders would each wait for the other's shared hold to drain.
+    if (lock->Header.SignalState <= 0 || lock->UpgradeWaiter != NULL)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        KeReleaseIrqlGuard(&irqlGuard);
+        return EC_INVALID_STATE;
+    }
+
+    if (lock->Header.SignalState == 1)
+    {
+        lock->Header.SignalState = KI_RWLOCK_EXCLUSIVE;
+        lock->OwnerThread = gCurrentThread;
+        KiLockProfileHoldBegin(&lock->Header);
+        KiLockProfileWaitEnd(&lock->Header, profileStart, FALSE, EC_SUCCESS);
+        KeLeaveCriticalSection(&criticalSection);
+        KeReleaseIrqlGuard(&irqlGuard);
+        return EC_SUCCESS;
+    }
+
+    if (timeoutNs == 0)
+    {
+        KiLockProfileWaitEnd(&lock->Header, profileStart, FALSE, EC_TIMEOUT);
+        KeLeaveCriticalSection(&criticalSection);
+        KeReleaseIrqlGuard(&irqlGuard);
+        return EC_TIMEOUT;
+    }
+
+    // The upgrader keeps its shared hold while it waits, so it parks off the wait list:
+    // the last other reader to leave grants it directly in KiRwLockGrantWaiters.
+    lock->UpgradeWaiter = gCurrentThread;
+    KiPrepareBlockingWait(&lock->Header, timeoutNs, FALSE);
+
+    KeLeaveCriticalSection(&criticalSection);
+    KiSchedule();
+
+    HO_STATUS status = gCurrentThread->WaitBlock.CompletionStatus;
+    KiLockProfileWaitEnd(&lock->Header, profileStart, TRUE, status);
+    klog(KLOG_LEVEL_DEBUG, "[RWLOCK] Thread %u upgrade %s\n", gCurrentThread->ThreadId,
+         status == EC_SUCCESS ? "granted" : "timed out (still shared)");
+    KeReleaseIrqlGuard(&irqlGuard);
+    return status;
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeDowngradeRwLock
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeDowngradeRwLock(KRWLOCK *lock)
+{
+    if (lock == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+
+    BOOL preemptAllowed = KeIsBlockingAllowed();
+    KE_IRQL_GUARD irqlGuard = {0};
+    KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    KiAssertRwLockState(lock);
+
+    if (lock->OwnerThread != gCurrentThread)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        KeReleaseIrqlGuard(&irqlGuard);
+        return EC_INVALID_STATE;
+    }
+
+    KiLockProfileHoldEnd(&lock->Header);
+    lock->OwnerThread = NULL;
+    lock->Header.SignalState = 1;
+    KiRwLockGrantWaiters(lock);
+
+    BOOL needSchedule = KiPreemptAfterRelease(preemptAllowed);
+
+    KeLeaveCriticalSection(&criticalSection);
+
+    if (needSchedule)
+        KiSchedule();
+
+    KeReleaseIrqlGuard(&irqlGuard);
+    return EC_SUCCESS;
+}
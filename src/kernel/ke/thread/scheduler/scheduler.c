@@ -16,16 +16,22 @@
 // ─────────────────────────────────────────────────────────────
 
 LINKED_LIST_TAG gReadyQueues[KTHREAD_PRIORITY_COUNT];
+LINKED_LIST_TAG gDeadlineReadyQueue;
+LINKED_LIST_TAG gDeadlineThrottledList;
 LINKED_LIST_TAG gTimeoutQueue;
 LINKED_LIST_TAG gTerminatedList;
 
 KTHREAD *gCurrentThread;
 KTHREAD *gIdleThread;
+KTHREAD *gReaperThread;
 BOOL gSchedulerEnabled;
 
 uint64_t gQuantumDeadlineNs;
 uint64_t gNextProgrammedDeadlineNs;
 
+static KEVENT gReaperWakeEvent;
+static BOOL gReaperBoosted;
+
 // ─────────────────────────────────────────────────────────────
 // Thread trampoline — first entry point for new threads
 // ─────────────────────────────────────────────────────────────
@@ -84,8 +90,12 @@ KeSchedulerInit(void)
     gIdleThread->StackOwnedByKva = FALSE;
     memset(&gIdleThread->StackRange, 0, sizeof(gIdleThread->StackRange));
     gIdleThread->Priority = KTHREAD_DEFAULT_PRIORITY;
+    gIdleThread->BasePriority = KTHREAD_DEFAULT_PRIORITY;
     gIdleThread->Quantum = 0;
+    memset(&gIdleThread->Deadline, 0, sizeof(gIdleThread->Deadline));
+    gIdleThread->TimerSlackNs = 0;
     gIdleThread->OwnedMutexCount = 0;
+    LinkedListInit(&gIdleThread->OwnedMutexList);
     KeInitializeIrqlState(&gIdleThread->IrqlState);
     KiInitWaitBlock(&gIdleThread->WaitBlock);
     KeInitializeEvent(&gIdleThread->TerminationCompletion, FALSE);
@@ -102,6 +112,7 @@ KeSchedulerInit(void)
     gStats.ActiveThreadCount = 1;
 
     // Replace timer ISR with scheduler entry
+    KiInitSchedulerTimerDpc();
     uint8_t timerVector = KeClockEventGetVector();
     HO_STATUS status = IdtRegisterInterruptHandler(timerVector, KiSchedulerTimerISR, NULL);
     if (status != EC_SUCCESS)
@@ -133,7 +144,7 @@ KeThreadStart(KTHREAD *thread)
     KeEnterCriticalSection(&criticalSection);
 
     thread->State = KTHREAD_STATE_READY;
-    LinkedListInsertTail(KiGetReadyQueueForThread(thread), &thread->ReadyLink);
+    KiInsertReadyThread(thread);
     gStats.TotalThreadsCreated++;
     gStats.ActiveThreadCount++;
 
@@ -145,6 +156,9 @@ KeThreadStart(KTHREAD *thread)
         KiArmClockEvent(KeClockEventGetMinDeltaNs());
     }
 
+    if (gCurrentThread == gIdleThread)
+        KiRequestIdleReschedule();
+
     KeLeaveCriticalSection(&criticalSection);
 
     klog(KLOG_LEVEL_INFO, "[SCHED] Thread %u started\n", thread->ThreadId);
@@ -175,7 +189,7 @@ KeYield(void)
     }
 
     gCurrentThread->State = KTHREAD_STATE_READY;
-    LinkedListInsertTail(KiGetReadyQueueForThread(gCurrentThread), &gCurrentThread->ReadyLink);
+    KiInsertReadyThread(gCurrentThread);
 
     KeLeaveCriticalSection(&criticalSection);
     KiSchedule();
@@ -210,12 +224,13 @@ KeSleep(uint64_t durationNs)
     KWAIT_BLOCK *wb = &gCurrentThread->WaitBlock;
     KiInitWaitBlock(wb);
     wb->DeadlineNs = nowNs + durationNs;
+    wb->SlackNs = KiTimerSlackForWait(gCurrentThread, durationNs);
 
     gCurrentThread->State = KTHREAD_STATE_BLOCKED;
     KiInsertTimeoutQueue(wb);
 
-    klog(KLOG_LEVEL_DEBUG, "[SCHED] Thread %u sleep %lu ns (deadline=%lu)\n", gCurrentThread->ThreadId,
-         (unsigned long)durationNs, (unsigned long)wb->DeadlineNs);
+    klog(KLOG_LEVEL_DEBUG, "[SCHED] Thread %u sleep %lu ns (deadline=%lu slack=%lu)\n", gCurrentThread->ThreadId,
+         (unsigned long)durationNs, (unsigned long)wb->DeadlineNs, (unsigned long)wb->SlackNs);
 
     KeLeaveCriticalSection(&criticalSection);
     KiSchedule();
@@ -238,7 +253,8 @@ KiIsThreadQueuedForReaper(KTHREAD *thread)
     return thread->ReadyLink.Flink != &thread->ReadyLink || thread->ReadyLink.Blink != &thread->ReadyLink;
 }
 
-static void
+// Returns TRUE once the backlog is deep enough that the reaper should be woken.
+static BOOL
 KiQueueDetachedThreadForReaper(KTHREAD *thread)
 {
     HO_KASSERT(thread != NULL, EC_ILLEGAL_ARGUMENT);
@@ -251,10 +267,41 @@ KiQueueDetachedThreadForReaper(KTHREAD *thread)
 
     if (KiIsThreadQueuedForReaper(thread))
     {
-        return;
+        return FALSE;
     }
 
+    thread->ReapQueuedNs = KiNowNs();
     LinkedListInsertTail(&gTerminatedList, &thread->ReadyLink);
+
+    gStats.ReaperBacklogDepth++;
+    if (gStats.ReaperBacklogDepth > gStats.MaxReaperBacklogDepth)
+        gStats.MaxReaperBacklogDepth = gStats.ReaperBacklogDepth;
+
+    return gReaperThread != NULL && gStats.ReaperBacklogDepth >= KE_REAPER_WAKE_THRESHOLD;
+}
+
+// Called outside the critical section: waking or boosting the reaper may reschedule.
+static void
+KiWakeReaper(void)
+{
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    BOOL boost = !gReaperBoosted && gStats.ReaperBacklogDepth >= KE_REAPER_BOOST_THRESHOLD;
+    BOOL signal = gReaperWakeEvent.Header.SignalState == 0;
+    if (boost)
+        gReaperBoosted = TRUE;
+
+    KeLeaveCriticalSection(&criticalSection);
+
+    if (boost)
+    {
+        HO_STATUS status = KeThreadSetPriority(gReaperThread, KTHREAD_PRIORITY_NORMAL);
+        HO_KASSERT(status == EC_SUCCESS, status);
+    }
+
+    if (signal)
+        KeSetEvent(&gReaperWakeEvent);
 }
 
 static HO_STATUS
@@ -329,8 +376,8 @@ KiResolveDispatchRoot(const KTHREAD *thread)
     return rootPageTablePhys;
 }
 
-void
-KiFinalizeThread(KTHREAD *thread)
+static void
+KiReleaseThreadUserRuntime(KTHREAD *thread)
 {
     HO_KASSERT(thread != NULL, EC_ILLEGAL_ARGUMENT);
     HO_KASSERT(thread != gIdleThread, EC_INVALID_STATE);
@@ -351,6 +398,12 @@ KiFinalizeThread(KTHREAD *thread)
             HO_KPANIC(finalizeStatus, "Failed to release terminated KTHREAD user-runtime resources");
         }
     }
+}
+
+void
+KiFinalizeThread(KTHREAD *thread)
+{
+    KiReleaseThreadUserRuntime(thread);
 
     if (thread->StackOwnedByKva)
     {
@@ -384,6 +437,7 @@ KeThreadExit(void)
 
     thread->State = KTHREAD_STATE_TERMINATED;
     gStats.ActiveThreadCount--;
+    KiDeadlineReleaseThread(thread);
 
     klog(KLOG_LEVEL_INFO, "[SCHED] Thread %u terminated\n", thread->ThreadId);
 
@@ -393,12 +447,17 @@ KeThreadExit(void)
 
     KeEnterCriticalSection(&criticalSection);
 
+    BOOL wakeReaper = FALSE;
     if (thread->TerminationMode == KTHREAD_TERMINATION_MODE_DETACHED)
     {
-        KiQueueDetachedThreadForReaper(thread);
+        wakeReaper = KiQueueDetachedThreadForReaper(thread);
     }
 
     KeLeaveCriticalSection(&criticalSection);
+
+    if (wakeReaper)
+        KiWakeReaper();
+
     KiSchedule();
     __builtin_unreachable();
 }
@@ -554,16 +613,47 @@ KeThreadDetach(KTHREAD *thread)
 
     thread->TerminationMode = KTHREAD_TERMINATION_MODE_DETACHED;
     // Keep completion publication ahead of detached reaper handoff.
+    BOOL wakeReaper = FALSE;
     if (thread->State == KTHREAD_STATE_TERMINATED && KiIsThreadTerminationCompletionPublished(thread))
     {
-        KiQueueDetachedThreadForReaper(thread);
+        wakeReaper = KiQueueDetachedThreadForReaper(thread);
     }
 
     KeLeaveCriticalSection(&criticalSection);
+
+    if (wakeReaper)
+        KiWakeReaper();
+
     KeReleaseIrqlGuard(&irqlGuard);
     return EC_SUCCESS;
 }
 
+// ─────────────────────────────────────────────────────────────
+// KeThreadSetPriority
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeThreadSetPriority(KTHREAD *thread, uint8_t priority)
+{
+    if (!thread || !KiIsValidThreadPriority(priority))
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (thread == gIdleThread || thread->State == KTHREAD_STATE_TERMINATED)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        return EC_INVALID_STATE;
+    }
+
+    thread->BasePriority = priority;
+    KiRefreshPriorityChain(thread);
+
+    KeLeaveCriticalSection(&criticalSection);
+    return EC_SUCCESS;
+}
+
 // ─────────────────────────────────────────────────────────────
 // KeGetCurrentThread
 // ─────────────────────────────────────────────────────────────
@@ -586,6 +676,9 @@ KiSchedule(void)
     KTHREAD *prev = gCurrentThread;
     KTHREAD *next;
 
+    uint64_t nowNs = KiNowNs();
+    KiDeadlineCharge(prev, nowNs);
+
     LINKED_LIST_TAG *readyQueue = KiGetHighestPriorityReadyQueue();
 
     if (readyQueue != NULL)
@@ -605,11 +698,13 @@ KiSchedule(void)
         next->State = KTHREAD_STATE_RUNNING;
 
         // Same thread, just re-arm and continue
-        uint64_t nowNs = KiNowNs();
         KiArmForNextEvent(nowNs, next);
         return;
     }
 
+    if (prev == gIdleThread)
+        KiIdleNoteExit();
+
     HO_PHYSICAL_ADDRESS nextRootPageTablePhys = KiResolveDispatchRoot(next);
 
     next->State = KTHREAD_STATE_RUNNING;
@@ -624,7 +719,6 @@ KiSchedule(void)
 #endif
 
     // Arm clock event for next deadline
-    uint64_t nowNs = KiNowNs();
     KiArmForNextEvent(nowNs, next);
 
     HO_STATUS switchStatus = KeSwitchAddressSpace(nextRootPageTablePhys);
@@ -641,39 +735,177 @@ KiSchedule(void)
 }
 
 // ─────────────────────────────────────────────────────────────
-// IdleThread reaper — reclaims terminated thread resources
+// Reaper — reclaims terminated thread resources in batches
 // ─────────────────────────────────────────────────────────────
 
 void
 KiReapTerminatedThreads(void)
 {
+    // Idle may not wait, but user-runtime teardown takes the Ex runtime table lock
+    // exclusively. Idle leaves those threads queued for the reaper thread, and before
+    // KeReaperInit() they simply stay queued until the reaper exists.
+    BOOL idleReap = gCurrentThread == gIdleThread;
+    BOOL handOff = FALSE;
+
     while (TRUE)
     {
-        KTHREAD *thread = NULL;
+        KTHREAD *batch[KE_REAPER_BATCH_SIZE];
+        const KE_KVA_RANGE *stackRanges[KE_REAPER_BATCH_SIZE];
+        BOOL userRuntimeOwned[KE_REAPER_BATCH_SIZE];
+        uint32_t batchCount = 0;
+        uint32_t stackCount = 0;
+
         KE_CRITICAL_SECTION criticalSection = {0};
         KeEnterCriticalSection(&criticalSection);
 
-        if (!LinkedListIsEmpty(&gTerminatedList))
+        LINKED_LIST_TAG *entry = gTerminatedList.Flink;
+        while (batchCount < KE_REAPER_BATCH_SIZE && entry != &gTerminatedList)
         {
-            LINKED_LIST_TAG *entry = gTerminatedList.Flink;
-            LinkedListRemove(entry);
-            thread = CONTAINING_RECORD(entry, KTHREAD, ReadyLink);
+            KTHREAD *thread = CONTAINING_RECORD(entry, KTHREAD, ReadyLink);
+            entry = entry->Flink;
+
+            if (idleReap && KiIsUserRuntimeOwnedThread(thread))
+            {
+                handOff = TRUE;
+                continue;
+            }
+
+            LinkedListRemove(&thread->ReadyLink);
             KiMarkThreadTerminationConsumed(thread);
+
+            HO_KASSERT(gStats.ReaperBacklogDepth != 0, EC_INVALID_STATE);
+            gStats.ReaperBacklogDepth--;
+            batch[batchCount++] = thread;
         }
 
         KeLeaveCriticalSection(&criticalSection);
-        if (!thread)
-            return;
+        if (batchCount == 0)
+            break;
 
-        BOOL userRuntimeOwned = KiIsUserRuntimeOwnedThread(thread);
-        uint32_t threadId = thread->ThreadId;
-        KiFinalizeThread(thread);
+        for (uint32_t idx = 0; idx < batchCount; ++idx)
+        {
+            userRuntimeOwned[idx] = KiIsUserRuntimeOwnedThread(batch[idx]);
+            KiReleaseThreadUserRuntime(batch[idx]);
 
-        if (userRuntimeOwned)
+            if (batch[idx]->StackOwnedByKva)
+                stackRanges[stackCount++] = &batch[idx]->StackRange;
+        }
+
+        // One KVA critical section and one TLB pass for every stack in the batch.
+        HO_STATUS status = KeKvaReleaseRangeHandles(stackRanges, stackCount);
+        if (status != EC_SUCCESS)
+        {
+            HO_KPANIC(status, "Failed to release terminated KTHREAD stacks");
+        }
+
+        uint64_t nowNs = KiNowNs();
+        KeEnterCriticalSection(&criticalSection);
+
+        gStats.ReaperBatchCount++;
+        gStats.ReapedThreadCount += batchCount;
+        for (uint32_t idx = 0; idx < batchCount; ++idx)
         {
-            klog(KLOG_LEVEL_INFO, "[USERRT] idle/reaper reclaimed user runtime thread thread=%u\n", threadId);
+            uint64_t latencyNs = nowNs - batch[idx]->ReapQueuedNs;
+            gStats.ReclaimLatencyTotalNs += latencyNs;
+            if (latencyNs > gStats.ReclaimLatencyMaxNs)
+                gStats.ReclaimLatencyMaxNs = latencyNs;
+        }
+
+        KeLeaveCriticalSection(&criticalSection);
+
+        for (uint32_t idx = 0; idx < batchCount; ++idx)
+        {
+            uint32_t threadId = batch[idx]->ThreadId;
+            KePoolFree(&gKThreadPool, batch[idx]);
+
+            if (userRuntimeOwned[idx])
+            {
+                klog(KLOG_LEVEL_INFO, "[USERRT] idle/reaper reclaimed user runtime thread thread=%u\n", threadId);
+            }
         }
     }
+
+    if (handOff && gReaperThread != NULL)
+    {
+        KE_CRITICAL_SECTION criticalSection = {0};
+        KeEnterCriticalSection(&criticalSection);
+        gStats.ReaperHandOffCount++;
+        KeLeaveCriticalSection(&criticalSection);
+
+        KiWakeReaper();
+    }
+}
+
+static void
+KiReaperThread(void *arg)
+{
+    (void)arg;
+
+    for (;;)
+    {
+        HO_STATUS status = KeWaitForSingleObject(&gReaperWakeEvent, KE_WAIT_INFINITE);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "Reaper wait failed");
+
+        // Reset before draining: a wake posted during the drain leaves the
+        // event signaled and simply costs one more empty pass.
+        KeResetEvent(&gReaperWakeEvent);
+
+        KE_CRITICAL_SECTION criticalSection = {0};
+        KeEnterCriticalSection(&criticalSection);
+        gStats.ReaperWakeCount++;
+        KeLeaveCriticalSection(&criticalSection);
+
+        KiReapTerminatedThreads();
+
+        KeEnterCriticalSection(&criticalSection);
+        BOOL unboost = gReaperBoosted;
+        gReaperBoosted = FALSE;
+        KeLeaveCriticalSection(&criticalSection);
+
+        if (unboost)
+        {
+            status = KeThreadSetPriority(gReaperThread, KTHREAD_PRIORITY_LOW);
+            HO_KASSERT(status == EC_SUCCESS, status);
+        }
+    }
+}
+
+HO_KERNEL_API HO_STATUS
+KeReaperInit(void)
+{
+    if (gReaperThread != NULL)
+        return EC_INVALID_STATE;
+
+    KeInitializeEvent(&gReaperWakeEvent, FALSE);
+    (void)KeRegisterLockProfile(&gReaperWakeEvent, "ke.reaper.wake");
+    gReaperBoosted = FALSE;
+
+    KTHREAD *reaper = NULL;
+    HO_STATUS status = KeThreadCreate(&reaper, KiReaperThread, NULL);
+    if (status != EC_SUCCESS)
+        return status;
+
+    status = KeThreadSetPriority(reaper, KTHREAD_PRIORITY_LOW);
+    if (status != EC_SUCCESS)
+        return status;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    gReaperThread = reaper;
+    BOOL wakeNow = gStats.ReaperBacklogDepth >= KE_REAPER_WAKE_THRESHOLD;
+    KeLeaveCriticalSection(&criticalSection);
+
+    status = KeThreadStart(reaper);
+    if (status != EC_SUCCESS)
+        return status;
+
+    if (wakeNow)
+        KiWakeReaper();
+
+    klog(KLOG_LEVEL_INFO, "[SCHED] reaper ready thread=%u wake=%u boost=%u batch=%u\n", reaper->ThreadId,
+         KE_REAPER_WAKE_THRESHOLD, KE_REAPER_BOOST_THRESHOLD, KE_REAPER_BATCH_SIZE);
+    return EC_SUCCESS;
 }
 
 // ─────────────────────────────────────────────────────────────
@@ -686,6 +918,6 @@ KeIdleLoop(void)
     while (TRUE)
     {
         KiReapTerminatedThreads();
-        __asm__ __volatile__("sti; hlt" ::: "memory");
+        KiIdleHalt();
     }
 }
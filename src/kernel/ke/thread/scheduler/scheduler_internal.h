@@ -14,8 +14,12 @@
 #include <kernel/ke/event.h>
 #include <kernel/ke/mutex.h>
 #include <kernel/ke/semaphore.h>
+#include <kernel/ke/timer.h>
 #include <kernel/ke/clock_event.h>
 #include <kernel/ke/critical_section.h>
+#include <kernel/ke/lock_profile.h>
+#include <kernel/ke/dpc.h>
+#include <kernel/ke/idle.h>
 #include <kernel/ke/irql.h>
 #include <kernel/ke/time_source.h>
 #include <kernel/ke/mm.h>
@@ -27,11 +31,14 @@
 #include <libc/string.h>
 
 extern LINKED_LIST_TAG gReadyQueues[KTHREAD_PRIORITY_COUNT];
+extern LINKED_LIST_TAG gDeadlineReadyQueue;    // Deadline class, ordered by absolute deadline
+extern LINKED_LIST_TAG gDeadlineThrottledList; // Budget-exhausted deadline threads, ordered by replenish time
 extern LINKED_LIST_TAG gTimeoutQueue;
 extern LINKED_LIST_TAG gTerminatedList;
 
 extern KTHREAD *gCurrentThread;
 extern KTHREAD *gIdleThread;
+extern KTHREAD *gReaperThread;
 extern BOOL gSchedulerEnabled;
 
 extern KE_SCHEDULER_STATS gStats;
@@ -45,6 +52,12 @@ KiIsValidThreadPriority(uint8_t priority)
     return priority < (uint8_t)KTHREAD_PRIORITY_COUNT;
 }
 
+static inline BOOL
+KiIsDeadlineThread(const KTHREAD *thread)
+{
+    return thread->Deadline.Active;
+}
+
 static inline LINKED_LIST_TAG *
 KiGetReadyQueueForPriority(uint8_t priority)
 {
@@ -74,6 +87,9 @@ KiInitReadyQueues(void)
     {
         LinkedListInit(&gReadyQueues[priority]);
     }
+
+    LinkedListInit(&gDeadlineReadyQueue);
+    LinkedListInit(&gDeadlineThrottledList);
 }
 
 static inline BOOL
@@ -81,6 +97,9 @@ KiHasAnyReadyThread(void)
 {
     uint32_t priority;
 
+    if (!LinkedListIsEmpty(&gDeadlineReadyQueue))
+        return TRUE;
+
     for (priority = 0; priority < (uint32_t)KTHREAD_PRIORITY_COUNT; priority++)
     {
         if (!LinkedListIsEmpty(&gReadyQueues[priority]))
@@ -95,6 +114,10 @@ KiGetHighestPriorityReadyQueue(void)
 {
     int priority;
 
+    // The deadline class sits above every RR priority.
+    if (!LinkedListIsEmpty(&gDeadlineReadyQueue))
+        return &gDeadlineReadyQueue;
+
     for (priority = (int)KTHREAD_PRIORITY_HIGH; priority >= (int)KTHREAD_PRIORITY_LOW; priority--)
     {
         if (!LinkedListIsEmpty(&gReadyQueues[priority]))
@@ -104,6 +127,23 @@ KiGetHighestPriorityReadyQueue(void)
     return NULL;
 }
 
+static inline BOOL
+KiHasReadyThreadAbovePriority(uint8_t priority)
+{
+    int level;
+
+    if (!LinkedListIsEmpty(&gDeadlineReadyQueue))
+        return TRUE;
+
+    for (level = (int)KTHREAD_PRIORITY_HIGH; level > (int)priority; level--)
+    {
+        if (!LinkedListIsEmpty(&gReadyQueues[level]))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
 static inline uint32_t
 KiCountAllReadyThreads(void)
 {
@@ -116,19 +156,27 @@ KiCountAllReadyThreads(void)
             count++;
     }
 
+    for (LINKED_LIST_TAG *entry = gDeadlineReadyQueue.Flink; entry != &gDeadlineReadyQueue; entry = entry->Flink)
+        count++;
+
     return count;
 }
 
 void KiSchedule(void);
 void KiSchedulerTimerISR(void *frame, void *context);
+void KiInitSchedulerTimerDpc(void);
 void KiWakeTimeouts(uint64_t nowNs);
 void KiArmClockEvent(uint64_t deltaNs);
 void KiArmForNextEvent(uint64_t nowNs, KTHREAD *next);
+void KiArmForEarlierDeadline(uint64_t deadlineNs);
+void KiExpireTimer(KTIMER *timer, uint64_t nowNs);
 void KiFinalizeThread(KTHREAD *thread);
 void KiReapTerminatedThreads(void);
+void KiIdleHalt(void);
 uint32_t KiCountQueueDepth(LINKED_LIST_TAG *head);
 void KiCompleteWait(KWAIT_BLOCK *block, HO_STATUS status);
 void KiInsertTimeoutQueue(KWAIT_BLOCK *block);
+uint64_t KiTimerSlackForWait(const KTHREAD *thread, uint64_t durationNs);
 void KiInitWaitBlock(KWAIT_BLOCK *block);
 void KiAssertBlockingAllowed(void);
 void KiAssertDispatchLevel(void);
@@ -140,6 +188,22 @@ void KiDecrementOwnedMutexCount(KTHREAD *thread);
 void KiAcquireMutexOwnership(KMUTEX *mutex, KTHREAD *thread);
 void KiReleaseMutexOwnership(KMUTEX *mutex);
 void KiHandOffMutexOwnership(KMUTEX *mutex, KTHREAD *thread);
+uint8_t KiComputeEffectivePriority(const KTHREAD *thread);
+void KiRefreshPriorityChain(KTHREAD *thread);
+void KiInsertWaitListByPriority(KDISPATCHER_HEADER *header, KWAIT_BLOCK *block);
 HO_STATUS KiTryAcquireDispatcherObject(KDISPATCHER_HEADER *header, KTHREAD *thread, BOOL *acquired);
+void KiPrepareBlockingWait(KDISPATCHER_HEADER *header, uint64_t timeoutNs, BOOL queueOnObject);
+void KiReleaseMutexLocked(KMUTEX *mutex);
+BOOL KiPreemptAfterRelease(BOOL preemptAllowed);
+HO_STATUS KiRwLockTryAcquire(KRWLOCK *lock, KTHREAD *thread, BOOL shared, BOOL *acquired);
+void KiRwLockReleaseExclusiveLocked(KRWLOCK *lock);
+void KiRwLockWaiterLeft(KRWLOCK *lock, KWAIT_BLOCK *block, HO_STATUS status);
 void KiThreadTrampoline(void);
 uint64_t KiNowNs(void);
+void KiInsertReadyThread(KTHREAD *thread);
+void KiDeadlineCharge(KTHREAD *thread, uint64_t nowNs);
+BOOL KiDeadlineShouldPreempt(const KTHREAD *current);
+void KiDeadlineThrottle(KTHREAD *thread);
+void KiDeadlineReplenish(uint64_t nowNs);
+uint64_t KiDeadlineEarliestReplenishNs(void);
+void KiDeadlineReleaseThread(KTHREAD *thread);
@@ -68,6 +68,8 @@ KiAcquireMutexOwnership(KMUTEX *mutex, KTHREAD *thread)
     mutex->OwnerThread = thread;
     mutex->Header.SignalState = 0;
     KiIncrementOwnedMutexCount(thread);
+    LinkedListInsertTail(&thread->OwnedMutexList, &mutex->OwnerLink);
+    KiLockProfileHoldBegin(&mutex->Header);
     KiAssertMutexState(mutex);
 }
 
@@ -82,8 +84,11 @@ KiReleaseMutexOwnership(KMUTEX *mutex)
     HO_KASSERT(owner != NULL, EC_INVALID_STATE);
 
     KiDecrementOwnedMutexCount(owner);
+    LinkedListRemove(&mutex->OwnerLink);
+    LinkedListInit(&mutex->OwnerLink);
     mutex->OwnerThread = NULL;
     mutex->Header.SignalState = 1;
+    KiLockProfileHoldEnd(&mutex->Header);
     KiAssertMutexState(mutex);
 }
 
@@ -100,12 +105,104 @@ KiHandOffMutexOwnership(KMUTEX *mutex, KTHREAD *thread)
     HO_KASSERT(owner != thread, EC_INVALID_STATE);
 
     KiDecrementOwnedMutexCount(owner);
+    LinkedListRemove(&mutex->OwnerLink);
     mutex->OwnerThread = thread;
     mutex->Header.SignalState = 0;
     KiIncrementOwnedMutexCount(thread);
+    LinkedListInsertTail(&thread->OwnedMutexList, &mutex->OwnerLink);
+    KiLockProfileHoldEnd(&mutex->Header);
+    KiLockProfileHoldBegin(&mutex->Header);
     KiAssertMutexState(mutex);
 }
 
+// ─────────────────────────────────────────────────────────────
+// Priority inheritance
+// ─────────────────────────────────────────────────────────────
+
+// Internal: effective priority = max(base, highest waiter on any owned mutex).
+// Mutex wait lists are priority-ordered, so the head waiter is the highest one.
+uint8_t
+KiComputeEffectivePriority(const KTHREAD *thread)
+{
+    HO_KASSERT(thread != NULL, EC_ILLEGAL_ARGUMENT);
+
+    uint8_t priority = thread->BasePriority;
+
+    for (LINKED_LIST_TAG *entry = thread->OwnedMutexList.Flink; entry != &thread->OwnedMutexList;
+         entry = entry->Flink)
+    {
+        KMUTEX *mutex = CONTAINING_RECORD(entry, KMUTEX, OwnerLink);
+        if (LinkedListIsEmpty(&mutex->Header.WaitListHead))
+            continue;
+
+        KWAIT_BLOCK *head = CONTAINING_RECORD(mutex->Header.WaitListHead.Flink, KWAIT_BLOCK, WaitListLink);
+        KTHREAD *waiter = CONTAINING_RECORD(head, KTHREAD, WaitBlock);
+        if (waiter->Priority > priority)
+            priority = waiter->Priority;
+    }
+
+    return priority;
+}
+
+// Internal: change a thread's effective priority and requeue it wherever it is parked.
+static void
+KiApplyEffectivePriority(KTHREAD *thread, uint8_t priority)
+{
+    HO_KASSERT(KiIsValidThreadPriority(priority), EC_ILLEGAL_ARGUMENT);
+
+    if (thread->Priority == priority)
+        return;
+
+    if (priority > thread->Priority)
+        gStats.PriorityBoostCount++;
+
+    klog(KLOG_LEVEL_DEBUG, "[MUTEX] Thread %u priority %u -> %u (base=%u)\n", thread->ThreadId, thread->Priority,
+         priority, thread->BasePriority);
+
+    thread->Priority = priority;
+
+    // Deadline threads are ordered by deadline, not priority, so stay put.
+    if (thread->State == KTHREAD_STATE_READY && !KiIsDeadlineThread(thread))
+    {
+        LinkedListRemove(&thread->ReadyLink);
+        LinkedListInsertTail(KiGetReadyQueueForThread(thread), &thread->ReadyLink);
+    }
+    else if (thread->State == KTHREAD_STATE_BLOCKED && thread->WaitBlock.Dispatcher != NULL &&
+             !thread->WaitBlock.Completed && !LinkedListIsEmpty(&thread->WaitBlock.WaitListLink))
+    {
+        // A pending KRWLOCK upgrade is parked off the wait list and has nothing to requeue.
+        LinkedListRemove(&thread->WaitBlock.WaitListLink);
+        KiInsertWaitListByPriority(thread->WaitBlock.Dispatcher, &thread->WaitBlock);
+    }
+}
+
+// Internal: re-evaluate the effective priority of a thread and propagate the
+// result along the chain of mutex owners it (transitively) blocks on.
+void
+KiRefreshPriorityChain(KTHREAD *thread)
+{
+    uint32_t depth = 0;
+
+    while (thread != NULL && thread != gIdleThread && depth < KE_MAX_THREADS)
+    {
+        uint8_t priority = KiComputeEffectivePriority(thread);
+        if (priority == thread->Priority)
+            return;
+
+        KiApplyEffectivePriority(thread, priority);
+
+        KDISPATCHER_HEADER *blockedOn = thread->WaitBlock.Dispatcher;
+        if (thread->State != KTHREAD_STATE_BLOCKED || thread->WaitBlock.Completed || blockedOn == NULL ||
+            blockedOn->Type != DISPATCHER_TYPE_MUTEX)
+        {
+            return;
+        }
+
+        thread = ((KMUTEX *)blockedOn)->OwnerThread;
+        depth++;
+    }
+}
+
 // ─────────────────────────────────────────────────────────────
 // KeInitializeEvent
 // ─────────────────────────────────────────────────────────────
@@ -119,6 +216,7 @@ KeInitializeEvent(KEVENT *event, BOOL initialState)
     event->Header.Type = DISPATCHER_TYPE_EVENT;
     event->Header.SignalState = initialState ? 1 : 0;
     LinkedListInit(&event->Header.WaitListHead);
+    KiInitLockProfileHeader(&event->Header);
 
     klog(KLOG_LEVEL_DEBUG, "[EVENT] Initialized (signaled=%u)\n", (unsigned)initialState);
 }
@@ -202,6 +300,7 @@ KeInitializeSemaphore(KSEMAPHORE *semaphore, int32_t initialCount, int32_t limit
     semaphore->Header.Type = DISPATCHER_TYPE_SEMAPHORE;
     semaphore->Header.SignalState = initialCount;
     LinkedListInit(&semaphore->Header.WaitListHead);
+    KiInitLockProfileHeader(&semaphore->Header);
     semaphore->Limit = limit;
 
     klog(KLOG_LEVEL_DEBUG, "[SEMAPHORE] Initialized (count=%ld, limit=%ld)\n", (long)initialCount, (long)limit);
@@ -221,7 +320,9 @@ KeInitializeMutex(KMUTEX *mutex)
     mutex->Header.Type = DISPATCHER_TYPE_MUTEX;
     mutex->Header.SignalState = 1;
     LinkedListInit(&mutex->Header.WaitListHead);
+    KiInitLockProfileHeader(&mutex->Header);
     mutex->OwnerThread = NULL;
+    LinkedListInit(&mutex->OwnerLink);
 
     KiAssertMutexState(mutex);
     klog(KLOG_LEVEL_DEBUG, "[MUTEX] Initialized (available=1)\n");
@@ -288,6 +389,61 @@ KeReleaseSemaphore(KSEMAPHORE *semaphore, int32_t releaseCount)
     return EC_SUCCESS;
 }
 
+// Internal: release or hand off a mutex owned by the current thread. Caller holds
+// the dispatcher critical section; KeWaitForCondition uses this to drop the lock
+// and queue on the condition without a window in between.
+void
+KiReleaseMutexLocked(KMUTEX *mutex)
+{
+    KiAssertMutexState(mutex);
+    HO_KASSERT(mutex->OwnerThread == gCurrentThread, EC_INVALID_STATE);
+
+    if (LinkedListIsEmpty(&mutex->Header.WaitListHead))
+    {
+        KiReleaseMutexOwnership(mutex);
+        klog(KLOG_LEVEL_DEBUG, "[MUTEX] Release(owner=%u, handoff=none)\n", gCurrentThread->ThreadId);
+    }
+    else
+    {
+        // Wait list is priority-ordered: the head is the highest-priority waiter.
+        LINKED_LIST_TAG *entry = mutex->Header.WaitListHead.Flink;
+        KWAIT_BLOCK *block = CONTAINING_RECORD(entry, KWAIT_BLOCK, WaitListLink);
+        KTHREAD *nextOwner = CONTAINING_RECORD(block, KTHREAD, WaitBlock);
+
+        KiHandOffMutexOwnership(mutex, nextOwner);
+        KiCompleteWait(block, EC_SUCCESS);
+
+        // The new owner inherits from the waiters still queued behind it.
+        KiRefreshPriorityChain(nextOwner);
+        klog(KLOG_LEVEL_DEBUG, "[MUTEX] Release(owner=%u, handoff=%u)\n", gCurrentThread->ThreadId,
+             nextOwner->ThreadId);
+    }
+
+    // Drop any boost that was lent through this mutex.
+    KiRefreshPriorityChain(gCurrentThread);
+}
+
+// Internal: after a release woke waiters, decide whether the releasing thread should
+// yield at once. When it should, the thread is already requeued as READY and the
+// caller runs KiSchedule after leaving its critical section.
+BOOL
+KiPreemptAfterRelease(BOOL preemptAllowed)
+{
+    // A de-boosted owner yields at once to the waiter it was running on behalf of,
+    // rather than holding the CPU at its base priority until quantum expiry.
+    BOOL needSchedule = preemptAllowed && gCurrentThread != gIdleThread &&
+                        (KiIsDeadlineThread(gCurrentThread) ? KiDeadlineShouldPreempt(gCurrentThread)
+                                                            : KiHasReadyThreadAbovePriority(gCurrentThread->Priority));
+    if (needSchedule)
+    {
+        gCurrentThread->State = KTHREAD_STATE_READY;
+        KiInsertReadyThread(gCurrentThread);
+        gStats.PreemptionCount++;
+    }
+
+    return needSchedule;
+}
+
 // ─────────────────────────────────────────────────────────────
 // KeReleaseMutex
 // ─────────────────────────────────────────────────────────────
@@ -298,6 +454,7 @@ KeReleaseMutex(KMUTEX *mutex)
     if (mutex == NULL)
         return EC_ILLEGAL_ARGUMENT;
 
+    BOOL preemptAllowed = KeIsBlockingAllowed();
     KE_IRQL_GUARD irqlGuard = {0};
     KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
     KE_CRITICAL_SECTION criticalSection = {0};
@@ -312,24 +469,15 @@ KeReleaseMutex(KMUTEX *mutex)
         return EC_INVALID_STATE;
     }
 
-    if (LinkedListIsEmpty(&mutex->Header.WaitListHead))
-    {
-        KiReleaseMutexOwnership(mutex);
-        klog(KLOG_LEVEL_DEBUG, "[MUTEX] Release(owner=%u, handoff=none)\n", gCurrentThread->ThreadId);
-    }
-    else
-    {
-        LINKED_LIST_TAG *entry = mutex->Header.WaitListHead.Flink;
-        KWAIT_BLOCK *block = CONTAINING_RECORD(entry, KWAIT_BLOCK, WaitListLink);
-        KTHREAD *nextOwner = CONTAINING_RECORD(block, KTHREAD, WaitBlock);
+    KiReleaseMutexLocked(mutex);
 
-        KiHandOffMutexOwnership(mutex, nextOwner);
-        KiCompleteWait(block, EC_SUCCESS);
-        klog(KLOG_LEVEL_DEBUG, "[MUTEX] Release(owner=%u, handoff=%u)\n", gCurrentThread->ThreadId,
-             nextOwner->ThreadId);
-    }
+    BOOL needSchedule = KiPreemptAfterRelease(preemptAllowed);
 
     KeLeaveCriticalSection(&criticalSection);
+
+    if (needSchedule)
+        KiSchedule();
+
     KeReleaseIrqlGuard(&irqlGuard);
     return EC_SUCCESS;
 }
@@ -14,13 +14,23 @@
 uint64_t
 KiNowNs(void)
 {
-    return KeGetSystemUpRealTime() * 1000ULL;
+    return KeGetSystemUpTimeNs();
 }
 
 // ─────────────────────────────────────────────────────────────
-// Timer ISR — scheduler entry from interrupt
+// Timer ISR — acknowledge, then defer expiry processing to a DPC
 // ─────────────────────────────────────────────────────────────
 
+static KDPC gClockExpiryDpc;
+
+static void KiClockExpiryDpcRoutine(KDPC *dpc, void *context);
+
+void
+KiInitSchedulerTimerDpc(void)
+{
+    KeInitializeDpc(&gClockExpiryDpc, KiClockExpiryDpcRoutine, NULL);
+}
+
 void
 KiSchedulerTimerISR(void *frame, void *context)
 {
@@ -36,6 +46,7 @@ KiSchedulerTimerISR(void *frame, void *context)
 
     KiAssertDispatchLevel();
 
+    // The observe hook needs the interrupted frame, so it stays in the ISR.
     if (interruptedFromUserMode)
     {
         KE_USER_RUNTIME_OBSERVE_TIMER_HOOK observeTimerFn = KiGetUserRuntimeObserveTimerHook();
@@ -50,6 +61,19 @@ KiSchedulerTimerISR(void *frame, void *context)
         }
     }
 
+    // Timeout expiry, quantum accounting and the reschedule run from the DPC
+    // retired on the way out of this interrupt.
+    (void)KeInsertQueueDpc(&gClockExpiryDpc);
+}
+
+static void
+KiClockExpiryDpcRoutine(KDPC *dpc, void *context)
+{
+    (void)dpc;
+    (void)context;
+
+    KiAssertDispatchLevel();
+
     uint64_t nowNs = KiNowNs();
 
     // Segmented re-arm: if we haven't reached the real deadline, re-arm remainder
@@ -59,8 +83,11 @@ KiSchedulerTimerISR(void *frame, void *context)
         return;
     }
 
-    // Wake timed-out wait blocks whose deadlines have passed
+    // Wake timed-out wait blocks whose deadlines have passed, then refill
+    // throttled deadline threads whose replenishment time has come.
     KiWakeTimeouts(nowNs);
+    KiDeadlineReplenish(nowNs);
+    KiDeadlineCharge(gCurrentThread, nowNs);
 
     BOOL needReschedule = FALSE;
 
@@ -69,11 +96,24 @@ KiSchedulerTimerISR(void *frame, void *context)
     {
         needReschedule = TRUE;
     }
-    // If current thread's quantum expired, preempt
-    else if (gCurrentThread != gIdleThread && nowNs >= gQuantumDeadlineNs)
+    // If current thread's quantum (or deadline budget) expired, or an earlier
+    // deadline became ready, preempt
+    else if (gCurrentThread != gIdleThread &&
+             (nowNs >= gQuantumDeadlineNs || KiDeadlineShouldPreempt(gCurrentThread)))
     {
-        gCurrentThread->State = KTHREAD_STATE_READY;
-        LinkedListInsertTail(KiGetReadyQueueForThread(gCurrentThread), &gCurrentThread->ReadyLink);
+        if (nowNs < gQuantumDeadlineNs)
+            gStats.DeadlinePreemptionCount++;
+
+        if (KiIsDeadlineThread(gCurrentThread) && gCurrentThread->Deadline.RemainingNs == 0)
+        {
+            KiDeadlineThrottle(gCurrentThread);
+        }
+        else
+        {
+            gCurrentThread->State = KTHREAD_STATE_READY;
+            KiInsertReadyThread(gCurrentThread);
+        }
+
         gStats.PreemptionCount++;
         needReschedule = TRUE;
     }
@@ -106,18 +146,108 @@ KiInsertTimeoutQueue(KWAIT_BLOCK *block)
     pos->Blink = &block->TimeoutLink;
 }
 
-// Internal: process timed-out wait blocks
+// Internal: process timed-out wait blocks and expired timers
 void
 KiWakeTimeouts(uint64_t nowNs)
 {
+    uint32_t expiredCount = 0;
+    uint32_t savedCount = 0;
+    uint64_t lastDeadlineNs = 0;
+    BOOL groupSaved = FALSE;
+
     while (!LinkedListIsEmpty(&gTimeoutQueue))
     {
         KWAIT_BLOCK *block = CONTAINING_RECORD(gTimeoutQueue.Flink, KWAIT_BLOCK, TimeoutLink);
         if (block->DeadlineNs > nowNs)
             break;
 
-        KiCompleteWait(block, EC_TIMEOUT);
+        // The queue is sorted, so a new deadline value starts a new group.
+        if (expiredCount == 0 || block->DeadlineNs != lastDeadlineNs)
+            groupSaved = FALSE;
+        lastDeadlineNs = block->DeadlineNs;
+        expiredCount++;
+
+        // A deadline whose slack window is still open rode on an interrupt armed
+        // for someone else. One already past its window, including the block this
+        // interrupt was armed for, was merely served late and saved nothing.
+        if (!groupSaved && nowNs < block->DeadlineNs + block->SlackNs)
+        {
+            groupSaved = TRUE;
+            savedCount++;
+        }
+
+        if (block->Timer != NULL)
+            KiExpireTimer(block->Timer, nowNs);
+        else
+            KiCompleteWait(block, EC_TIMEOUT);
     }
+
+    KeClockEventRecordTimeoutExpiry(expiredCount, savedCount);
+}
+
+// ─────────────────────────────────────────────────────────────
+// Timer slack
+// ─────────────────────────────────────────────────────────────
+
+// Internal: slack granted to a sleep or timed wait of durationNs
+uint64_t
+KiTimerSlackForWait(const KTHREAD *thread, uint64_t durationNs)
+{
+    if (thread == NULL || KiIsDeadlineThread(thread))
+        return 0;
+
+    if (thread->TimerSlackNs != KE_TIMER_SLACK_DEFAULT)
+        return thread->TimerSlackNs;
+
+    uint64_t slackNs = durationNs / 100U * KE_TIMER_SLACK_DEFAULT_PERCENT;
+    return slackNs < KE_TIMER_SLACK_DEFAULT_MAX_NS ? slackNs : KE_TIMER_SLACK_DEFAULT_MAX_NS;
+}
+
+// Internal: expiry time for the head of the timeout queue. Sorted blocks are
+// gathered while each deadline still falls inside every gathered block's slack
+// window; the interrupt lands at the earliest window end, so one expiry retires
+// the whole batch and no block is woken later than its own deadline plus slack.
+static uint64_t
+KiCoalescedTimeoutNs(void)
+{
+    uint64_t windowEndNs = 0;
+
+    for (LINKED_LIST_TAG *pos = gTimeoutQueue.Flink; pos != &gTimeoutQueue; pos = pos->Flink)
+    {
+        KWAIT_BLOCK *block = CONTAINING_RECORD(pos, KWAIT_BLOCK, TimeoutLink);
+        if (windowEndNs != 0 && block->DeadlineNs > windowEndNs)
+            break;
+
+        uint64_t blockEndNs = block->DeadlineNs + block->SlackNs;
+        if (blockEndNs < block->DeadlineNs)
+            blockEndNs = block->DeadlineNs;
+
+        if (windowEndNs == 0 || blockEndNs < windowEndNs)
+            windowEndNs = blockEndNs;
+    }
+
+    return windowEndNs;
+}
+
+HO_KERNEL_API HO_STATUS
+KeThreadSetTimerSlack(KTHREAD *thread, uint64_t slackNs)
+{
+    if (!thread || (slackNs > KE_TIMER_SLACK_MAX_NS && slackNs != KE_TIMER_SLACK_DEFAULT))
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (thread == gIdleThread || thread->State == KTHREAD_STATE_TERMINATED)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        return EC_INVALID_STATE;
+    }
+
+    thread->TimerSlackNs = slackNs;
+
+    KeLeaveCriticalSection(&criticalSection);
+    return EC_SUCCESS;
 }
 
 // Internal: arm clock event with clamping
@@ -142,18 +272,41 @@ KiArmClockEvent(uint64_t deltaNs)
     }
 }
 
+// Internal: pull the programmed clock event forward when a new timeout-queue
+// entry is due before it. Later entries are picked up by the next re-arm.
+void
+KiArmForEarlierDeadline(uint64_t deadlineNs)
+{
+    if (!gSchedulerEnabled)
+        return;
+
+    if (gNextProgrammedDeadlineNs != 0 && deadlineNs >= gNextProgrammedDeadlineNs)
+        return;
+
+    uint64_t nowNs = KiNowNs();
+    gNextProgrammedDeadlineNs = deadlineNs;
+    KiArmClockEvent(deadlineNs > nowNs ? deadlineNs - nowNs : 1);
+}
+
 // Internal: compute and arm next event for a thread
 void
 KiArmForNextEvent(uint64_t nowNs, KTHREAD *next)
 {
+    uint64_t replenishNs = KiDeadlineEarliestReplenishNs();
+    uint64_t timeoutNs = KiCoalescedTimeoutNs();
+
     if (next == gIdleThread)
     {
-        // IdleThread: arm for earliest timeout deadline only
-        if (!LinkedListIsEmpty(&gTimeoutQueue))
+        // IdleThread: arm for the coalesced timeout expiry or deadline replenishment only
+        uint64_t targetDeadline = replenishNs;
+
+        if (timeoutNs != 0 && (targetDeadline == 0 || timeoutNs < targetDeadline))
+            targetDeadline = timeoutNs;
+
+        if (targetDeadline != 0)
         {
-            KWAIT_BLOCK *block = CONTAINING_RECORD(gTimeoutQueue.Flink, KWAIT_BLOCK, TimeoutLink);
-            uint64_t delta = block->DeadlineNs > nowNs ? block->DeadlineNs - nowNs : 1;
-            gNextProgrammedDeadlineNs = block->DeadlineNs;
+            uint64_t delta = targetDeadline > nowNs ? targetDeadline - nowNs : 1;
+            gNextProgrammedDeadlineNs = targetDeadline;
             KiArmClockEvent(delta);
         }
         else
@@ -164,18 +317,20 @@ KiArmForNextEvent(uint64_t nowNs, KTHREAD *next)
     }
     else
     {
-        // Set quantum deadline for the scheduled thread
-        next->Quantum = KE_DEFAULT_QUANTUM_NS;
-        gQuantumDeadlineNs = nowNs + KE_DEFAULT_QUANTUM_NS;
+        // Set quantum deadline for the scheduled thread; a deadline thread's
+        // slice is whatever budget it has left this period
+        uint64_t sliceNs = KiIsDeadlineThread(next) ? next->Deadline.RemainingNs : KE_DEFAULT_QUANTUM_NS;
+        next->Quantum = sliceNs;
+        gQuantumDeadlineNs = nowNs + sliceNs;
 
         uint64_t targetDeadline = gQuantumDeadlineNs;
 
-        if (!LinkedListIsEmpty(&gTimeoutQueue))
-        {
-            KWAIT_BLOCK *block = CONTAINING_RECORD(gTimeoutQueue.Flink, KWAIT_BLOCK, TimeoutLink);
-            if (block->DeadlineNs < targetDeadline)
-                targetDeadline = block->DeadlineNs;
-        }
+        // Timeouts whose slack reaches the quantum boundary ride on its interrupt.
+        if (timeoutNs != 0 && timeoutNs < targetDeadline)
+            targetDeadline = timeoutNs;
+
+        if (replenishNs != 0 && replenishNs < targetDeadline)
+            targetDeadline = replenishNs;
 
         uint64_t delta = targetDeadline > nowNs ? targetDeadline - nowNs : 1;
         gNextProgrammedDeadlineNs = targetDeadline;
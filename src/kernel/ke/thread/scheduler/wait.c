@@ -29,8 +29,11 @@ KiInitWaitBlock(KWAIT_BLOCK *block)
     LinkedListInit(&block->WaitListLink);
     LinkedListInit(&block->TimeoutLink);
     block->DeadlineNs = 0;
+    block->SlackNs = 0;
     block->CompletionStatus = EC_SUCCESS;
     block->Completed = FALSE;
+    block->SharedAcquire = FALSE;
+    block->Timer = NULL;
 }
 
 // Internal: validate dispatcher headers before generic wait logic
@@ -48,6 +51,9 @@ KiValidateDispatcherHeader(const KDISPATCHER_HEADER *header)
     case DISPATCHER_TYPE_EVENT:
     case DISPATCHER_TYPE_SEMAPHORE:
     case DISPATCHER_TYPE_MUTEX:
+    case DISPATCHER_TYPE_RWLOCK:
+    case DISPATCHER_TYPE_CONDITION:
+    case DISPATCHER_TYPE_TIMER:
         return EC_SUCCESS;
     default:
         return EC_NOT_SUPPORTED;
@@ -98,11 +104,50 @@ KiTryAcquireDispatcherObject(KDISPATCHER_HEADER *header, KTHREAD *thread, BOOL *
         return EC_SUCCESS;
     }
 
+    case DISPATCHER_TYPE_RWLOCK:
+        // A plain wait on a reader-writer lock asks for exclusive access.
+        return KiRwLockTryAcquire((KRWLOCK *)header, thread, FALSE, acquired);
+
+    case DISPATCHER_TYPE_CONDITION:
+        // Conditions carry no state: a waiter is only ever satisfied by a later signal.
+        return EC_SUCCESS;
+
+    case DISPATCHER_TYPE_TIMER:
+        if (header->SignalState == 0)
+            return EC_SUCCESS;
+
+        // A synchronization timer's expiry satisfies exactly one wait.
+        if (((KTIMER *)header)->Type == KTIMER_SYNCHRONIZATION)
+            header->SignalState = 0;
+        *acquired = TRUE;
+        return EC_SUCCESS;
+
     default:
         return EC_NOT_SUPPORTED;
     }
 }
 
+// Internal: insert a wait block behind every waiter of equal or higher priority,
+// so release paths that take the list head serve waiters by priority and FIFO within a level.
+void
+KiInsertWaitListByPriority(KDISPATCHER_HEADER *header, KWAIT_BLOCK *block)
+{
+    KTHREAD *thread = CONTAINING_RECORD(block, KTHREAD, WaitBlock);
+    LINKED_LIST_TAG *pos;
+
+    for (pos = header->WaitListHead.Flink; pos != &header->WaitListHead; pos = pos->Flink)
+    {
+        KWAIT_BLOCK *existing = CONTAINING_RECORD(pos, KWAIT_BLOCK, WaitListLink);
+        KTHREAD *waiter = CONTAINING_RECORD(existing, KTHREAD, WaitBlock);
+        if (waiter->Priority < thread->Priority)
+            break;
+    }
+    block->WaitListLink.Flink = pos;
+    block->WaitListLink.Blink = pos->Blink;
+    pos->Blink->Flink = &block->WaitListLink;
+    pos->Blink = &block->WaitListLink;
+}
+
 // Internal: unified wait completion — signal or timeout
 void
 KiCompleteWait(KWAIT_BLOCK *block, HO_STATUS status)
@@ -114,7 +159,8 @@ KiCompleteWait(KWAIT_BLOCK *block, HO_STATUS status)
     block->CompletionStatus = status;
 
     // Remove from dispatcher wait list if attached
-    if (block->Dispatcher != NULL)
+    KDISPATCHER_HEADER *dispatcher = block->Dispatcher;
+    if (dispatcher != NULL)
     {
         LinkedListRemove(&block->WaitListLink);
         LinkedListInit(&block->WaitListLink);
@@ -129,14 +175,62 @@ KiCompleteWait(KWAIT_BLOCK *block, HO_STATUS status)
 
     KTHREAD *thread = CONTAINING_RECORD(block, KTHREAD, WaitBlock);
     thread->State = KTHREAD_STATE_READY;
-    LinkedListInsertTail(KiGetReadyQueueForThread(thread), &thread->ReadyLink);
+    KiInsertReadyThread(thread);
+    if (gCurrentThread == gIdleThread)
+        KiRequestIdleReschedule();
     if (status == EC_TIMEOUT)
         gStats.SleepWakeCount++;
 
+    // A waiter leaving a mutex (timeout) may have been the source of the owner's boost.
+    if (dispatcher != NULL && dispatcher->Type == DISPATCHER_TYPE_MUTEX)
+    {
+        KTHREAD *owner = ((KMUTEX *)dispatcher)->OwnerThread;
+        if (owner != NULL && owner != thread)
+            KiRefreshPriorityChain(owner);
+    }
+    else if (dispatcher != NULL && dispatcher->Type == DISPATCHER_TYPE_RWLOCK)
+    {
+        KiRwLockWaiterLeft((KRWLOCK *)dispatcher, block, status);
+    }
+
     klog(KLOG_LEVEL_DEBUG, "[SCHED] Thread %u wait completed (%s)\n", thread->ThreadId,
          status == EC_SUCCESS ? "signaled" : "timeout");
 }
 
+// Internal: park the current thread on a dispatcher object. The caller holds the
+// dispatcher critical section, leaves it, and then calls KiSchedule. When queueOnObject
+// is FALSE the wait block stays off the wait list (KRWLOCK upgrade) and only a direct
+// KiCompleteWait or the timeout can end the wait.
+void
+KiPrepareBlockingWait(KDISPATCHER_HEADER *header, uint64_t timeoutNs, BOOL queueOnObject)
+{
+    KWAIT_BLOCK *wb = &gCurrentThread->WaitBlock;
+    KiInitWaitBlock(wb);
+    wb->Dispatcher = header;
+
+    // Attach to dispatcher's wait list (priority-ordered)
+    if (queueOnObject)
+        KiInsertWaitListByPriority(header, wb);
+
+    // Set up timeout if not infinite
+    if (timeoutNs != KE_WAIT_INFINITE)
+    {
+        uint64_t nowNs = KiNowNs();
+        wb->DeadlineNs = nowNs + timeoutNs;
+        wb->SlackNs = KiTimerSlackForWait(gCurrentThread, timeoutNs);
+        KiInsertTimeoutQueue(wb);
+    }
+
+    gCurrentThread->State = KTHREAD_STATE_BLOCKED;
+
+    // Lend our priority to the mutex owner chain while we are blocked on it.
+    if (header->Type == DISPATCHER_TYPE_MUTEX)
+        KiRefreshPriorityChain(((KMUTEX *)header)->OwnerThread);
+
+    klog(KLOG_LEVEL_DEBUG, "[WAIT] Thread %u blocking (type=%d, timeout=%lu)\n", gCurrentThread->ThreadId, header->Type,
+         (unsigned long)timeoutNs);
+}
+
 // KeWaitForSingleObject
 HO_KERNEL_API HO_STATUS
 KeWaitForSingleObject(void *object, uint64_t timeoutNs)
@@ -153,6 +247,11 @@ KeWaitForSingleObject(void *object, uint64_t timeoutNs)
     if (validationStatus != EC_SUCCESS)
         return validationStatus;
 
+    // Reader-writer locks track the intent of each waiter; a plain wait is an exclusive acquire.
+    if (header->Type == DISPATCHER_TYPE_RWLOCK)
+        return KeAcquireRwLockExclusive((KRWLOCK *)header, timeoutNs);
+
+    uint64_t profileStart = KiLockProfileWaitBegin(header);
     KE_IRQL_GUARD irqlGuard = {0};
     KeAcquireIrqlGuard(&irqlGuard, KE_IRQL_DISPATCH_LEVEL);
     KE_CRITICAL_SECTION criticalSection = {0};
@@ -172,6 +271,7 @@ KeWaitForSingleObject(void *object, uint64_t timeoutNs)
     {
         klog(KLOG_LEVEL_DEBUG, "[WAIT] Thread %u immediate satisfy (type=%d, state=%ld)\n", gCurrentThread->ThreadId,
              header->Type, (long)header->SignalState);
+        KiLockProfileWaitEnd(header, profileStart, FALSE, EC_SUCCESS);
         KeLeaveCriticalSection(&criticalSection);
         KeReleaseIrqlGuard(&irqlGuard);
         return EC_SUCCESS;
@@ -182,36 +282,20 @@ KeWaitForSingleObject(void *object, uint64_t timeoutNs)
     {
         klog(KLOG_LEVEL_DEBUG, "[WAIT] Thread %u zero-timeout poll miss (type=%d, state=%ld)\n",
              gCurrentThread->ThreadId, header->Type, (long)header->SignalState);
+        KiLockProfileWaitEnd(header, profileStart, FALSE, EC_TIMEOUT);
         KeLeaveCriticalSection(&criticalSection);
         KeReleaseIrqlGuard(&irqlGuard);
         return EC_TIMEOUT;
     }
 
     // Path 3: blocking wait
-    KWAIT_BLOCK *wb = &gCurrentThread->WaitBlock;
-    KiInitWaitBlock(wb);
-    wb->Dispatcher = header;
-
-    // Attach to dispatcher's wait list
-    LinkedListInsertTail(&header->WaitListHead, &wb->WaitListLink);
-
-    // Set up timeout if not infinite
-    if (timeoutNs != KE_WAIT_INFINITE)
-    {
-        uint64_t nowNs = KiNowNs();
-        wb->DeadlineNs = nowNs + timeoutNs;
-        KiInsertTimeoutQueue(wb);
-    }
-
-    gCurrentThread->State = KTHREAD_STATE_BLOCKED;
-
-    klog(KLOG_LEVEL_DEBUG, "[WAIT] Thread %u blocking (type=%d, timeout=%lu)\n", gCurrentThread->ThreadId, header->Type,
-         (unsigned long)timeoutNs);
+    KiPrepareBlockingWait(header, timeoutNs, TRUE);
 
     KeLeaveCriticalSection(&criticalSection);
     KiSchedule();
 
     HO_STATUS completionStatus = gCurrentThread->WaitBlock.CompletionStatus;
+    KiLockProfileWaitEnd(header, profileStart, TRUE, completionStatus);
     klog(KLOG_LEVEL_DEBUG, "[WAIT] Thread %u resumed (%s)\n", gCurrentThread->ThreadId,
          completionStatus == EC_SUCCESS ? "signaled" : "timeout");
     KeReleaseIrqlGuard(&irqlGuard);
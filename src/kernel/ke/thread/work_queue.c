@@ -0,0 +1,254 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/thread/work_queue.c
+ * Description:
+ * Ke Layer - Priority-laned kernel work queue served by a small worker pool.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include <kernel/ke/work_queue.h>
+#include <kernel/ke/critical_section.h>
+#include <kernel/ke/lock_profile.h>
+#include <kernel/ke/scheduler.h>
+#include <kernel/ke/semaphore.h>
+#include <kernel/hodbg.h>
+#include <libc/string.h>
+
+#define KE_WORK_QUEUE_SEMAPHORE_LIMIT 0x7FFFFFFF
+
+typedef struct KE_WORK_QUEUE_LANE
+{
+    uint8_t Priority;
+    LINKED_LIST_TAG ItemList;
+    KSEMAPHORE ItemSemaphore;
+    KTHREAD *Workers[KE_WORK_QUEUE_WORKERS_PER_LANE];
+    int32_t DeferredWakes; // Semaphore releases owed for items queued above PASSIVE_LEVEL
+    KE_WORK_QUEUE_LANE_STATS Stats;
+} KE_WORK_QUEUE_LANE;
+
+static KE_WORK_QUEUE_LANE gWorkQueueLanes[KE_WORK_QUEUE_LANE_COUNT];
+static BOOL gWorkQueueReady;
+static BOOL gWorkQueueWakesDeferred;
+static const char *const gWorkQueueProfileNames[KE_WORK_QUEUE_LANE_COUNT] = {
+    "ke.workq.low",
+    "ke.workq.normal",
+    "ke.workq.high",
+};
+
+static void KiWorkQueueWorkerThread(void *arg);
+
+static KWORK_ITEM *
+KiDequeueWorkItem(KE_WORK_QUEUE_LANE *lane)
+{
+    KWORK_ITEM *item = NULL;
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (!LinkedListIsEmpty(&lane->ItemList))
+    {
+        LINKED_LIST_TAG *entry = lane->ItemList.Flink;
+        LinkedListRemove(entry);
+        LinkedListInit(entry);
+        item = CONTAINING_RECORD(entry, KWORK_ITEM, QueueLink);
+        item->Queued = FALSE;
+        HO_KASSERT(lane->Stats.PendingDepth != 0, EC_INVALID_STATE);
+        lane->Stats.PendingDepth--;
+    }
+
+    KeLeaveCriticalSection(&criticalSection);
+    return item;
+}
+
+static void
+KiWorkQueueWorkerThread(void *arg)
+{
+    KE_WORK_QUEUE_LANE *lane = (KE_WORK_QUEUE_LANE *)arg;
+
+    HO_KASSERT(lane != NULL, EC_ILLEGAL_ARGUMENT);
+
+    for (;;)
+    {
+        HO_STATUS status = KeWaitForSingleObject(&lane->ItemSemaphore, KE_WAIT_INFINITE);
+        if (status != EC_SUCCESS)
+            HO_KPANIC(status, "Work queue worker wait failed");
+
+        KWORK_ITEM *item = KiDequeueWorkItem(lane);
+        if (item == NULL)
+            continue;
+
+        item->Routine(item, item->Context);
+
+        KE_CRITICAL_SECTION criticalSection = {0};
+        KeEnterCriticalSection(&criticalSection);
+        lane->Stats.ExecutedCount++;
+        KeLeaveCriticalSection(&criticalSection);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────
+// KeWorkQueueInit
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API HO_STATUS
+KeWorkQueueInit(void)
+{
+    uint32_t laneIndex;
+    uint32_t workerIndex;
+
+    if (gWorkQueueReady)
+        return EC_INVALID_STATE;
+
+    memset(gWorkQueueLanes, 0, sizeof(gWorkQueueLanes));
+
+    for (laneIndex = 0; laneIndex < KE_WORK_QUEUE_LANE_COUNT; ++laneIndex)
+    {
+        KE_WORK_QUEUE_LANE *lane = &gWorkQueueLanes[laneIndex];
+
+        lane->Priority = (uint8_t)laneIndex;
+        LinkedListInit(&lane->ItemList);
+
+        HO_STATUS status = KeInitializeSemaphore(&lane->ItemSemaphore, 0, KE_WORK_QUEUE_SEMAPHORE_LIMIT);
+        if (status != EC_SUCCESS)
+            return status;
+        (void)KeRegisterLockProfile(&lane->ItemSemaphore, gWorkQueueProfileNames[laneIndex]);
+
+        for (workerIndex = 0; workerIndex < KE_WORK_QUEUE_WORKERS_PER_LANE; ++workerIndex)
+        {
+            KTHREAD *worker = NULL;
+
+            status = KeThreadCreate(&worker, KiWorkQueueWorkerThread, lane);
+            if (status != EC_SUCCESS)
+                return status;
+
+            status = KeThreadSetPriority(worker, lane->Priority);
+            if (status != EC_SUCCESS)
+                return status;
+
+            status = KeThreadStart(worker);
+            if (status != EC_SUCCESS)
+                return status;
+
+            lane->Workers[workerIndex] = worker;
+            lane->Stats.WorkerCount++;
+        }
+    }
+
+    gWorkQueueReady = TRUE;
+    klog(KLOG_LEVEL_INFO, "[WORKQ] ready lanes=%u workers/lane=%u\n", KE_WORK_QUEUE_LANE_COUNT,
+         KE_WORK_QUEUE_WORKERS_PER_LANE);
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API BOOL
+KeWorkQueueIsReady(void)
+{
+    return gWorkQueueReady;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Work items
+// ─────────────────────────────────────────────────────────────
+
+HO_KERNEL_API void
+KeInitializeWorkItem(KWORK_ITEM *item, KWORK_ROUTINE routine, void *context)
+{
+    HO_KASSERT(item != NULL, EC_ILLEGAL_ARGUMENT);
+    HO_KASSERT(routine != NULL, EC_ILLEGAL_ARGUMENT);
+
+    item->Signature = KE_WORK_ITEM_SIGNATURE;
+    item->Queued = FALSE;
+    item->Lane = KTHREAD_DEFAULT_PRIORITY;
+    LinkedListInit(&item->QueueLink);
+    item->Routine = routine;
+    item->Context = context;
+}
+
+HO_KERNEL_API HO_STATUS
+KeQueueWorkItem(KWORK_ITEM *item, uint8_t priority)
+{
+    if (item == NULL || item->Signature != KE_WORK_ITEM_SIGNATURE || item->Routine == NULL ||
+        priority >= KE_WORK_QUEUE_LANE_COUNT)
+    {
+        return EC_ILLEGAL_ARGUMENT;
+    }
+
+    KE_WORK_QUEUE_LANE *lane = &gWorkQueueLanes[priority];
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+
+    if (!gWorkQueueReady || item->Queued)
+    {
+        KeLeaveCriticalSection(&criticalSection);
+        return EC_INVALID_STATE;
+    }
+
+    item->Queued = TRUE;
+    item->Lane = priority;
+    LinkedListInsertTail(&lane->ItemList, &item->QueueLink);
+
+    lane->Stats.QueuedCount++;
+    lane->Stats.PendingDepth++;
+    if (lane->Stats.PendingDepth > lane->Stats.MaxPendingDepth)
+        lane->Stats.MaxPendingDepth = lane->Stats.PendingDepth;
+
+    // Waking a worker from the idle thread switches to it. Above PASSIVE_LEVEL that would happen in the middle of
+    // an ISR or a DPC drain, so the wake waits for KiWorkQueueFlushDeferredWakes().
+    BOOL deferWake = !KeIsBlockingAllowed();
+    if (deferWake)
+    {
+        lane->DeferredWakes++;
+        gWorkQueueWakesDeferred = TRUE;
+    }
+
+    KeLeaveCriticalSection(&criticalSection);
+
+    if (!deferWake)
+    {
+        // Released outside the critical section: waking a worker may reschedule.
+        HO_STATUS status = KeReleaseSemaphore(&lane->ItemSemaphore, 1);
+        HO_KASSERT(status == EC_SUCCESS, status);
+    }
+    return EC_SUCCESS;
+}
+
+BOOL
+KiWorkQueueHasDeferredWakes(void)
+{
+    return gWorkQueueWakesDeferred;
+}
+
+void
+KiWorkQueueFlushDeferredWakes(void)
+{
+    HO_KASSERT(!ArchGetInterruptState().MaskableInterruptEnabled, EC_INVALID_STATE);
+
+    if (!gWorkQueueWakesDeferred)
+        return;
+
+    gWorkQueueWakesDeferred = FALSE;
+    for (uint32_t laneIndex = 0; laneIndex < KE_WORK_QUEUE_LANE_COUNT; ++laneIndex)
+    {
+        KE_WORK_QUEUE_LANE *lane = &gWorkQueueLanes[laneIndex];
+        int32_t wakes = lane->DeferredWakes;
+        if (wakes == 0)
+            continue;
+
+        lane->DeferredWakes = 0;
+        HO_STATUS status = KeReleaseSemaphore(&lane->ItemSemaphore, wakes);
+        HO_KASSERT(status == EC_SUCCESS, status);
+    }
+}
+
+HO_KERNEL_API HO_STATUS
+KeQueryWorkQueueLaneStats(uint8_t priority, KE_WORK_QUEUE_LANE_STATS *out)
+{
+    if (out == NULL || priority >= KE_WORK_QUEUE_LANE_COUNT)
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_CRITICAL_SECTION criticalSection = {0};
+    KeEnterCriticalSection(&criticalSection);
+    *out = gWorkQueueLanes[priority].Stats;
+    KeLeaveCriticalSection(&criticalSection);
+    return EC_SUCCESS;
+}
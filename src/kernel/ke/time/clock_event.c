@@ -9,8 +9,10 @@
 
 #include <kernel/ke/clock_event.h>
 #include <arch/arch.h>
+#include <arch/amd64/asm.h>
 #include <arch/amd64/idt.h>
 #include <kernel/hodbg.h>
+#include <kernel/ke/time_convert.h>
 #include <kernel/ke/time_source.h>
 #include <libc/string.h>
 
@@ -29,6 +31,9 @@ static void LapicTimerInterruptHandler(void *frame, void *context);
 static void LapicSpuriousInterruptHandler(void *frame, void *context);
 static HO_STATUS ClockEventSelfTest(void);
 static HO_STATUS WaitForTickAdvance(uint64_t baseCount, uint64_t neededDelta, uint64_t timeoutUs);
+static void ClockEventResetStats(uint32_t cpuIndex);
+static void ClockEventApplyMode(KE_CLOCK_EVENT_MODE mode);
+static const char *ClockEventModeName(KE_CLOCK_EVENT_MODE mode);
 
 static void
 LapicTimerInterruptHandler(void *frame, void *context)
@@ -64,9 +69,50 @@ WaitForTickAdvance(uint64_t baseCount, uint64_t neededDelta, uint64_t timeoutUs)
     return EC_FAILURE;
 }
 
+static void
+ClockEventResetStats(uint32_t cpuIndex)
+{
+    KE_CLOCK_EVENT_PERCPU_STATE *state = &gClockEventDevice.PerCpu[cpuIndex];
+
+    state->InterruptCount = 0;
+    state->TimeoutExpiryCount = 0;
+    state->SavedInterruptCount = 0;
+    state->LatenessSampleCount = 0;
+    state->TotalLatenessCycles = 0;
+    state->MaxLatenessCycles = 0;
+    state->EarlyFireCount = 0;
+}
+
+static void
+ClockEventApplyMode(KE_CLOCK_EVENT_MODE mode)
+{
+    gClockEventDevice.Mode = mode;
+    gClockEventDevice.FreqHz =
+        mode == KE_CLOCK_EVENT_MODE_TSC_DEADLINE ? gLapicClockEventSink.TscFreqHz : gLapicClockEventSink.TicksPerSec;
+}
+
+static const char *
+ClockEventModeName(KE_CLOCK_EVENT_MODE mode)
+{
+    return mode == KE_CLOCK_EVENT_MODE_TSC_DEADLINE ? "tsc-deadline" : "one-shot";
+}
+
 static HO_STATUS
 ClockEventSelfTest(void)
 {
+    HO_STATUS convStatus;
+    if (gClockEventDevice.Mode == KE_CLOCK_EVENT_MODE_TSC_DEADLINE)
+        convStatus = KeTimeConversionCheck(&gLapicClockEventSink.NsToTsc, 1000000000ULL, gLapicClockEventSink.TscFreqHz,
+                                           gLapicClockEventSink.TscMaxDeltaNs);
+    else
+        convStatus = KeTimeConversionCheck(&gLapicClockEventSink.NsToTick, 1000000000ULL,
+                                           gLapicClockEventSink.TicksPerSec, gLapicClockEventSink.MaxDeltaNs);
+    if (convStatus != EC_SUCCESS)
+    {
+        klog(KLOG_LEVEL_ERROR, "[CLKEV] ns->tick conversion disagrees with the divide path\n");
+        return convStatus;
+    }
+
     uint64_t startCount = gClockEventDevice.PerCpu[0].InterruptCount;
     HO_STATUS testStatus = EC_SUCCESS;
     ARCH_INTERRUPT_STATE savedInterruptState = ArchDisableInterrupts();
@@ -133,12 +179,19 @@ KeClockEventInit(void)
         return status;
     }
 
+    // Lateness sampling and TSC-deadline mode both need a calibrated, invariant TSC.
+    if (KeGetTimeSourceKind() == TIME_SOURCE_TSC)
+    {
+        status = KeLapicClockEventSinkSetTscRate(&gLapicClockEventSink, KeGetTimeSourceFrequency());
+        if (status != EC_SUCCESS)
+            klog(KLOG_LEVEL_WARNING, "[CLKEV] TSC rate rejected, lateness sampling disabled: %ke\n", status);
+    }
+
     gClockEventDevice.ActiveSink = &gLapicClockEventSink.Base;
     gClockEventDevice.ActiveSinkContext = &gLapicClockEventSink;
-    gClockEventDevice.Mode = KE_CLOCK_EVENT_MODE_ONE_SHOT;
     gClockEventDevice.Kind = KE_CLOCK_EVENT_LAPIC_TIMER;
-    gClockEventDevice.FreqHz = gLapicClockEventSink.TicksPerSec;
     gClockEventDevice.VectorNumber = LAPIC_TIMER_VECTOR;
+    ClockEventApplyMode(KE_CLOCK_EVENT_MODE_ONE_SHOT);
 
     status = KeClockEventPerCpuInit(0);
     if (status != EC_SUCCESS)
@@ -157,11 +210,34 @@ KeClockEventInit(void)
         return status;
     }
 
-    gClockEventDevice.PerCpu[0].InterruptCount = 0;
+    // Prefer TSC-deadline: arming is one MSR write of an absolute TSC, with no divider or count range.
+    if (KeClockEventIsTscDeadlineSupported())
+    {
+        status = KeLapicClockEventSinkSetMode(&gLapicClockEventSink, KE_CLOCK_EVENT_MODE_TSC_DEADLINE);
+        if (status == EC_SUCCESS)
+        {
+            ClockEventApplyMode(KE_CLOCK_EVENT_MODE_TSC_DEADLINE);
+            status = ClockEventSelfTest();
+        }
+
+        if (status != EC_SUCCESS)
+        {
+            klog(KLOG_LEVEL_WARNING, "[CLKEV] TSC-deadline self-test failed, staying one-shot: %ke\n", status);
+            HO_STATUS revertStatus = KeLapicClockEventSinkSetMode(&gLapicClockEventSink, KE_CLOCK_EVENT_MODE_ONE_SHOT);
+            if (revertStatus != EC_SUCCESS)
+            {
+                gClockEventDevice.Initialized = FALSE;
+                return revertStatus;
+            }
+            ClockEventApplyMode(KE_CLOCK_EVENT_MODE_ONE_SHOT);
+        }
+    }
+
+    ClockEventResetStats(0);
 
-    klog(KLOG_LEVEL_INFO, "[CLKEV] %s one-shot ready @ %lu Hz (vector=%u)\n",
-         gClockEventDevice.ActiveSink->GetName(gClockEventDevice.ActiveSinkContext), gClockEventDevice.FreqHz,
-         gClockEventDevice.VectorNumber);
+    klog(KLOG_LEVEL_INFO, "[CLKEV] %s %s ready @ %lu Hz (vector=%u)\n",
+         gClockEventDevice.ActiveSink->GetName(gClockEventDevice.ActiveSinkContext),
+         ClockEventModeName(gClockEventDevice.Mode), gClockEventDevice.FreqHz, gClockEventDevice.VectorNumber);
     return EC_SUCCESS;
 }
 
@@ -174,12 +250,10 @@ KeClockEventPerCpuInit(uint32_t cpuIndex)
     if (!gLapicClockEventSink.Initialized || gLapicClockEventSink.TicksPerSec == 0)
         return EC_INVALID_STATE;
 
-    LapicTimerConfigureOneShot(gLapicClockEventSink.BaseVirt, gLapicClockEventSink.VectorNumber,
-                               gLapicClockEventSink.DividerValue, TRUE);
-    LapicTimerSetInitialCount(gLapicClockEventSink.BaseVirt, 0U);
+    KeLapicClockEventSinkStop(&gLapicClockEventSink);
 
     gClockEventDevice.PerCpu[cpuIndex].Initialized = TRUE;
-    gClockEventDevice.PerCpu[cpuIndex].InterruptCount = 0;
+    ClockEventResetStats(cpuIndex);
     return EC_SUCCESS;
 }
 
@@ -213,12 +287,132 @@ KeClockEventGetInterruptCount(void)
 HO_KERNEL_API void
 KeClockEventOnInterrupt(void)
 {
-    if (gClockEventDevice.PerCpu[0].Initialized)
-        gClockEventDevice.PerCpu[0].InterruptCount++;
+    KE_CLOCK_EVENT_PERCPU_STATE *state = &gClockEventDevice.PerCpu[0];
+
+    if (state->Initialized)
+    {
+        state->InterruptCount++;
+
+        uint64_t targetTsc = gLapicClockEventSink.TargetTsc;
+        if (targetTsc != 0)
+        {
+            uint64_t nowTsc = rdtsc();
+            gLapicClockEventSink.TargetTsc = 0;
+
+            if (nowTsc < targetTsc)
+            {
+                state->EarlyFireCount++;
+            }
+            else
+            {
+                uint64_t lateness = nowTsc - targetTsc;
+                state->LatenessSampleCount++;
+                state->TotalLatenessCycles += lateness;
+                if (lateness > state->MaxLatenessCycles)
+                    state->MaxLatenessCycles = lateness;
+            }
+        }
+    }
 
     KeLapicClockEventSinkSendEoi(&gLapicClockEventSink);
 }
 
+HO_KERNEL_API void
+KeClockEventRecordTimeoutExpiry(uint32_t expiredCount, uint32_t savedCount)
+{
+    if (!gClockEventDevice.PerCpu[0].Initialized || expiredCount == 0)
+        return;
+
+    gClockEventDevice.PerCpu[0].TimeoutExpiryCount += expiredCount;
+    gClockEventDevice.PerCpu[0].SavedInterruptCount += savedCount;
+}
+
+HO_KERNEL_API uint64_t
+KeClockEventGetTimeoutExpiryCount(void)
+{
+    return gClockEventDevice.PerCpu[0].TimeoutExpiryCount;
+}
+
+HO_KERNEL_API uint64_t
+KeClockEventGetSavedInterruptCount(void)
+{
+    return gClockEventDevice.PerCpu[0].SavedInterruptCount;
+}
+
+HO_KERNEL_API void
+KeClockEventGetLateness(uint64_t *sampleCount, uint64_t *totalCycles, uint64_t *maxCycles, uint64_t *earlyCount)
+{
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+    const KE_CLOCK_EVENT_PERCPU_STATE *state = &gClockEventDevice.PerCpu[0];
+
+    if (sampleCount)
+        *sampleCount = state->LatenessSampleCount;
+    if (totalCycles)
+        *totalCycles = state->TotalLatenessCycles;
+    if (maxCycles)
+        *maxCycles = state->MaxLatenessCycles;
+    if (earlyCount)
+        *earlyCount = state->EarlyFireCount;
+
+    ArchRestoreInterruptState(interruptState);
+}
+
+HO_KERNEL_API KE_CLOCK_EVENT_MODE
+KeClockEventGetMode(void)
+{
+    return gClockEventDevice.Mode;
+}
+
+HO_KERNEL_API BOOL
+KeClockEventIsTscDeadlineSupported(void)
+{
+    return gLapicClockEventSink.TscDeadlineSupported && gLapicClockEventSink.TscFreqHz != 0;
+}
+
+HO_KERNEL_API HO_STATUS
+KeClockEventSetMode(KE_CLOCK_EVENT_MODE mode)
+{
+    if (!gClockEventDevice.Initialized)
+        return EC_INVALID_STATE;
+
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+
+    HO_STATUS status = KeLapicClockEventSinkSetMode(&gLapicClockEventSink, mode);
+    if (status == EC_SUCCESS)
+    {
+        ClockEventApplyMode(mode);
+
+        // The old mode's event is gone; fire promptly so the scheduler re-arms in the new one.
+        status = gClockEventDevice.ActiveSink->SetNextEventNs(gClockEventDevice.ActiveSinkContext,
+                                                              KeClockEventGetMinDeltaNs());
+    }
+
+    ArchRestoreInterruptState(interruptState);
+
+    if (status == EC_SUCCESS)
+        klog(KLOG_LEVEL_INFO, "[CLKEV] mode switched to %s @ %lu Hz\n", ClockEventModeName(mode),
+             gClockEventDevice.FreqHz);
+    return status;
+}
+
+HO_KERNEL_API void
+KeClockEventUpdateTscRate(uint64_t tscFreqHz)
+{
+    if (!gLapicClockEventSink.Initialized || gLapicClockEventSink.TscFreqHz == 0)
+        return;
+
+    ARCH_INTERRUPT_STATE interruptState = ArchDisableInterrupts();
+
+    HO_STATUS status = KeLapicClockEventSinkSetTscRate(&gLapicClockEventSink, tscFreqHz);
+    if (status == EC_SUCCESS)
+        ClockEventApplyMode(gClockEventDevice.Mode);
+
+    ArchRestoreInterruptState(interruptState);
+
+    if (status != EC_SUCCESS)
+        klog(KLOG_LEVEL_WARNING, "[CLKEV] TSC rate update rejected: %ke\n", status);
+}
+
 HO_KERNEL_API uint64_t
 KeClockEventGetFrequency(void)
 {
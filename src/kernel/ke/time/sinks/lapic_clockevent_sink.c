@@ -8,33 +8,20 @@
  */
 
 #include "lapic_clockevent_sink.h"
+#include <arch/amd64/asm.h>
+#include <kernel/ke/time_convert.h>
 #include <kernel/ke/time_source.h>
 #include <libc/string.h>
 
-static uint64_t Div128By64(uint64_t hi, uint64_t lo, uint64_t div);
-static uint64_t Mul64Div64(uint64_t value, uint64_t mul, uint64_t div);
+#define LAPIC_CLOCK_EVENT_NS_PER_SEC 1000000000ULL
+#define LAPIC_CLOCK_EVENT_MAX_TICKS  0xFFFFFFFFULL
+#define LAPIC_TSC_DEADLINE_MAX_TICKS (1ULL << 48) // Keeps ns->TSC products exact for any real TSC rate
+
 static HO_STATUS LapicClockEventSetNextEventNs(void *self, uint64_t deltaNs);
 static uint64_t LapicClockEventGetMinDeltaNs(void *self);
 static uint64_t LapicClockEventGetMaxDeltaNs(void *self);
 static const char *LapicClockEventGetName(void *self);
 
-static uint64_t
-Div128By64(uint64_t hi, uint64_t lo, uint64_t div)
-{
-    uint64_t quot;
-    __asm__ __volatile__("divq %3" : "=a"(quot) : "d"(hi), "a"(lo), "r"(div));
-    return quot;
-}
-
-static uint64_t
-Mul64Div64(uint64_t value, uint64_t mul, uint64_t div)
-{
-    __uint128_t product = (__uint128_t)value * mul;
-    uint64_t hi = (uint64_t)(product >> 64);
-    uint64_t lo = (uint64_t)product;
-    return Div128By64(hi, lo, div);
-}
-
 static HO_STATUS
 LapicClockEventSetNextEventNs(void *self, uint64_t deltaNs)
 {
@@ -49,12 +36,34 @@ LapicClockEventSetNextEventNs(void *self, uint64_t deltaNs)
     if (deltaNs == 0)
         deltaNs = 1;
 
-    uint64_t ticks = Mul64Div64(deltaNs, sink->TicksPerSec, 1000000000ULL);
+    if (sink->Mode == KE_CLOCK_EVENT_MODE_TSC_DEADLINE)
+    {
+        if (deltaNs > sink->TscMaxDeltaNs)
+            deltaNs = sink->TscMaxDeltaNs;
+
+        // A deadline already in the past fires immediately, so no minimum applies.
+        uint64_t target = rdtsc() + KeTimeConvert(&sink->NsToTsc, deltaNs);
+        if (target == 0)
+            target = 1; // 0 disarms the timer
+        sink->TargetTsc = target;
+        LapicTimerSetTscDeadline(target);
+        return EC_SUCCESS;
+    }
+
+    // Clamp before converting so the product stays in range.
+    if (deltaNs > sink->MaxDeltaNs)
+        deltaNs = sink->MaxDeltaNs;
+
+    uint64_t ticks = KeTimeConvert(&sink->NsToTick, deltaNs);
     if (ticks == 0)
         ticks = 1;
 
-    if (ticks > 0xFFFFFFFFULL)
-        ticks = 0xFFFFFFFFULL;
+    if (ticks > LAPIC_CLOCK_EVENT_MAX_TICKS)
+        ticks = LAPIC_CLOCK_EVENT_MAX_TICKS;
+
+    // With a known TSC rate, record when the event should fire so lateness is comparable across modes.
+    if (sink->TscFreqHz != 0)
+        sink->TargetTsc = rdtsc() + KeTimeConvert(&sink->NsToTsc, deltaNs);
 
     LapicTimerConfigureOneShot(sink->BaseVirt, sink->VectorNumber, sink->DividerValue, FALSE);
     LapicTimerSetInitialCount(sink->BaseVirt, (uint32_t)ticks);
@@ -69,7 +78,10 @@ LapicClockEventGetMinDeltaNs(void *self)
     if (sink == NULL || sink->TicksPerSec == 0)
         return 0;
 
-    return (1000000000ULL + sink->TicksPerSec - 1) / sink->TicksPerSec;
+    if (sink->Mode == KE_CLOCK_EVENT_MODE_TSC_DEADLINE)
+        return sink->TscMinDeltaNs;
+
+    return sink->MinDeltaNs;
 }
 
 static uint64_t
@@ -80,7 +92,10 @@ LapicClockEventGetMaxDeltaNs(void *self)
     if (sink == NULL || sink->TicksPerSec == 0)
         return 0;
 
-    return Mul64Div64(0xFFFFFFFFULL, 1000000000ULL, sink->TicksPerSec);
+    if (sink->Mode == KE_CLOCK_EVENT_MODE_TSC_DEADLINE)
+        return sink->TscMaxDeltaNs;
+
+    return sink->MaxDeltaNs;
 }
 
 static const char *
@@ -108,6 +123,8 @@ KeLapicClockEventSinkInit(KE_LAPIC_CLOCK_EVENT_SINK *sink, uint8_t vectorNumber)
 
     sink->DividerValue = LAPIC_TIMER_DIVIDE_BY_16;
     sink->VectorNumber = vectorNumber;
+    sink->Mode = KE_CLOCK_EVENT_MODE_ONE_SHOT;
+    sink->TscDeadlineSupported = LapicTimerSupportsTscDeadline();
 
     LapicSetSpuriousVector(sink->BaseVirt, 0xFFU);
     LapicTimerConfigureOneShot(sink->BaseVirt, sink->VectorNumber, sink->DividerValue, TRUE);
@@ -128,7 +145,8 @@ KeLapicClockEventSinkCalibrate(KE_LAPIC_CLOCK_EVENT_SINK *sink, uint64_t windowU
     if (sink == NULL || windowUs == 0)
         return EC_ILLEGAL_ARGUMENT;
 
-    if (!sink->Initialized)
+    // The divider rate is measured by counting down, which only one-shot mode does.
+    if (!sink->Initialized || sink->Mode != KE_CLOCK_EVENT_MODE_ONE_SHOT)
         return EC_INVALID_STATE;
 
     LapicTimerConfigureOneShot(sink->BaseVirt, sink->VectorNumber, sink->DividerValue, FALSE);
@@ -154,10 +172,19 @@ KeLapicClockEventSinkCalibrate(KE_LAPIC_CLOCK_EVENT_SINK *sink, uint64_t windowU
         return EC_FAILURE;
 
     uint64_t consumedTicks = (uint64_t)(startCount - endCount);
-    uint64_t ticksPerSec = Mul64Div64(consumedTicks, 1000000ULL, elapsedUs);
+    uint64_t ticksPerSec = KeTimeMulDiv(consumedTicks, 1000000ULL, elapsedUs);
     if (ticksPerSec == 0)
         return EC_FAILURE;
 
+    KE_TIME_CONVERSION nsToTick;
+    HO_STATUS status = KeTimeConversionInit(&nsToTick, LAPIC_CLOCK_EVENT_NS_PER_SEC, ticksPerSec);
+    if (status != EC_SUCCESS)
+        return status;
+
+    // The envelope uses the exact divide once here instead of on every event.
+    sink->MinDeltaNs = (LAPIC_CLOCK_EVENT_NS_PER_SEC + ticksPerSec - 1) / ticksPerSec;
+    sink->MaxDeltaNs = KeTimeMulDiv(LAPIC_CLOCK_EVENT_MAX_TICKS, LAPIC_CLOCK_EVENT_NS_PER_SEC, ticksPerSec);
+    sink->NsToTick = nsToTick;
     sink->TicksPerSec = ticksPerSec;
     return EC_SUCCESS;
 }
@@ -170,3 +197,63 @@ KeLapicClockEventSinkSendEoi(KE_LAPIC_CLOCK_EVENT_SINK *sink)
 
     LapicSendEoi(sink->BaseVirt);
 }
+
+HO_STATUS
+KeLapicClockEventSinkSetTscRate(KE_LAPIC_CLOCK_EVENT_SINK *sink, uint64_t tscFreqHz)
+{
+    if (sink == NULL || tscFreqHz == 0)
+        return EC_ILLEGAL_ARGUMENT;
+
+    KE_TIME_CONVERSION nsToTsc;
+    HO_STATUS status = KeTimeConversionInit(&nsToTsc, LAPIC_CLOCK_EVENT_NS_PER_SEC, tscFreqHz);
+    if (status != EC_SUCCESS)
+        return status;
+
+    sink->TscMinDeltaNs = (LAPIC_CLOCK_EVENT_NS_PER_SEC + tscFreqHz - 1) / tscFreqHz;
+    sink->TscMaxDeltaNs = KeTimeMulDiv(LAPIC_TSC_DEADLINE_MAX_TICKS, LAPIC_CLOCK_EVENT_NS_PER_SEC, tscFreqHz);
+    sink->NsToTsc = nsToTsc;
+    sink->TscFreqHz = tscFreqHz;
+    return EC_SUCCESS;
+}
+
+HO_STATUS
+KeLapicClockEventSinkSetMode(KE_LAPIC_CLOCK_EVENT_SINK *sink, KE_CLOCK_EVENT_MODE mode)
+{
+    if (sink == NULL)
+        return EC_ILLEGAL_ARGUMENT;
+
+    if (mode != KE_CLOCK_EVENT_MODE_ONE_SHOT && mode != KE_CLOCK_EVENT_MODE_TSC_DEADLINE)
+        return EC_ILLEGAL_ARGUMENT;
+
+    if (!sink->Initialized)
+        return EC_INVALID_STATE;
+
+    if (mode == KE_CLOCK_EVENT_MODE_TSC_DEADLINE && (!sink->TscDeadlineSupported || sink->TscFreqHz == 0))
+        return EC_NOT_SUPPORTED;
+
+    // Disarm in the old mode, then park the timer in the new one.
+    KeLapicClockEventSinkStop(sink);
+    sink->Mode = mode;
+    KeLapicClockEventSinkStop(sink);
+    return EC_SUCCESS;
+}
+
+void
+KeLapicClockEventSinkStop(KE_LAPIC_CLOCK_EVENT_SINK *sink)
+{
+    if (sink == NULL || !sink->Initialized)
+        return;
+
+    sink->TargetTsc = 0;
+
+    if (sink->Mode == KE_CLOCK_EVENT_MODE_TSC_DEADLINE)
+    {
+        // The LVT stays unmasked so arming is a single MSR write; a zero deadline is disarmed.
+        LapicTimerConfigureTscDeadline(sink->BaseVirt, sink->VectorNumber, FALSE);
+        LapicTimerSetTscDeadline(0);
+        return;
+    }
+
+    LapicTimerConfigureOneShot(sink->BaseVirt, sink->VectorNumber, sink->DividerValue, TRUE);
+    LapicTimerSetInitialCount(sink->BaseVirt, 0U);
+}
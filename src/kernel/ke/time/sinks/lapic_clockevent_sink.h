@@ -11,6 +11,8 @@
 
 #include <kernel/ke/sinks/clock_event_sink.h>
 #include <drivers/time/lapic_timer_driver.h>
+#include <kernel/ke/clock_event.h>
+#include <kernel/ke/time_convert.h>
 
 typedef struct KE_LAPIC_CLOCK_EVENT_SINK
 {
@@ -18,11 +20,26 @@ typedef struct KE_LAPIC_CLOCK_EVENT_SINK
     HO_PHYSICAL_ADDRESS BasePhys;
     HO_VIRTUAL_ADDRESS BaseVirt;
     uint64_t TicksPerSec;
+    KE_TIME_CONVERSION NsToTick; // Precomputed with TicksPerSec at calibration
+    uint64_t MinDeltaNs;
+    uint64_t MaxDeltaNs;
     uint32_t DividerValue;
     uint8_t VectorNumber;
     BOOL Initialized;
+
+    // TSC-deadline mode: events are absolute TSC values written to IA32_TSC_DEADLINE.
+    KE_CLOCK_EVENT_MODE Mode;
+    BOOL TscDeadlineSupported;  // CPUID.01H:ECX[24]
+    uint64_t TscFreqHz;         // 0 when the TSC is not the calibrated time source
+    KE_TIME_CONVERSION NsToTsc; // Precomputed with TscFreqHz
+    uint64_t TscMinDeltaNs;
+    uint64_t TscMaxDeltaNs;
+    volatile uint64_t TargetTsc; // TSC the armed event is due at; 0 when unknown
 } KE_LAPIC_CLOCK_EVENT_SINK;
 
 HO_STATUS KeLapicClockEventSinkInit(KE_LAPIC_CLOCK_EVENT_SINK *sink, uint8_t vectorNumber);
 HO_STATUS KeLapicClockEventSinkCalibrate(KE_LAPIC_CLOCK_EVENT_SINK *sink, uint64_t windowUs);
 void KeLapicClockEventSinkSendEoi(KE_LAPIC_CLOCK_EVENT_SINK *sink);
+HO_STATUS KeLapicClockEventSinkSetTscRate(KE_LAPIC_CLOCK_EVENT_SINK *sink, uint64_t tscFreqHz);
+HO_STATUS KeLapicClockEventSinkSetMode(KE_LAPIC_CLOCK_EVENT_SINK *sink, KE_CLOCK_EVENT_MODE mode);
+void KeLapicClockEventSinkStop(KE_LAPIC_CLOCK_EVENT_SINK *sink);
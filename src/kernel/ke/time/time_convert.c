@@ -0,0 +1,94 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: ke/time/time_convert.c
+ * Description:
+ * Ke Layer - Division-free frequency conversion setup and reference path.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include <kernel/ke/time_convert.h>
+
+#define KI_TIME_CONVERSION_MAX_SHIFT 63U
+#define KI_TIME_CONVERSION_MULT_LIMIT (1ULL << 63)
+
+// 128-bit by 64-bit division using x86-64 div instruction
+// Computes (hi:lo) / div, returns quotient; hi must be below div
+static uint64_t
+Div128By64(uint64_t hi, uint64_t lo, uint64_t div)
+{
+    uint64_t quot;
+    __asm__ __volatile__("divq %3" : "=a"(quot) : "d"(hi), "a"(lo), "r"(div));
+    return quot;
+}
+
+static BOOL
+KiTimeConversionSampleOk(const KE_TIME_CONVERSION *conversion, uint64_t fromHz, uint64_t toHz, uint64_t value)
+{
+    uint64_t exact = KeTimeMulDiv(value, toHz, fromHz);
+    uint64_t fast = KeTimeConvert(conversion, value);
+    return fast <= exact && (exact - fast) <= 1;
+}
+
+HO_KERNEL_API HO_STATUS
+KeTimeConversionInit(KE_TIME_CONVERSION *conversion, uint64_t fromHz, uint64_t toHz)
+{
+    if (!conversion || fromHz == 0 || toHz == 0)
+        return EC_ILLEGAL_ARGUMENT;
+
+    for (int32_t shift = KI_TIME_CONVERSION_MAX_SHIFT; shift >= 0; --shift)
+    {
+        __uint128_t numerator = (__uint128_t)toHz << shift;
+        uint64_t hi = (uint64_t)(numerator >> 64);
+        if (hi >= fromHz)
+            continue;
+
+        uint64_t mult = Div128By64(hi, (uint64_t)numerator, fromHz);
+        if (mult >= KI_TIME_CONVERSION_MULT_LIMIT)
+            continue;
+        if (mult == 0)
+            return EC_ILLEGAL_ARGUMENT;
+
+        conversion->Mult = mult;
+        conversion->Shift = (uint32_t)shift;
+        return EC_SUCCESS;
+    }
+
+    return EC_ILLEGAL_ARGUMENT;
+}
+
+HO_KERNEL_API uint64_t
+KeTimeMulDiv(uint64_t value, uint64_t mul, uint64_t div)
+{
+    __uint128_t product = (__uint128_t)value * mul;
+    uint64_t hi = (uint64_t)(product >> 64);
+    uint64_t lo = (uint64_t)product;
+    return Div128By64(hi, lo, div);
+}
+
+HO_KERNEL_API HO_STATUS
+KeTimeConversionCheck(const KE_TIME_CONVERSION *conversion, uint64_t fromHz, uint64_t toHz, uint64_t maxValue)
+{
+    if (!conversion || fromHz == 0 || toHz == 0)
+        return EC_ILLEGAL_ARGUMENT;
+
+    const uint64_t fixedSamples[] = {0, 1, 2, 999, 1000, fromHz - 1, fromHz, fromHz + 1, toHz};
+    for (uint32_t index = 0; index < sizeof(fixedSamples) / sizeof(fixedSamples[0]); ++index)
+    {
+        uint64_t value = fixedSamples[index];
+        if (value <= maxValue && !KiTimeConversionSampleOk(conversion, fromHz, toHz, value))
+            return EC_FAILURE;
+    }
+
+    // Halve down from the limit, also probing a non-power-of-two neighbour.
+    for (uint64_t value = maxValue; value != 0; value >>= 1)
+    {
+        if (!KiTimeConversionSampleOk(conversion, fromHz, toHz, value) ||
+            !KiTimeConversionSampleOk(conversion, fromHz, toHz, value - (value >> 3)))
+        {
+            return EC_FAILURE;
+        }
+    }
+
+    return EC_SUCCESS;
+}
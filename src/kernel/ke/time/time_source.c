@@ -9,8 +9,12 @@
 
 #include <kernel/ke/time_source.h>
 #include <arch/amd64/asm.h>
+#include <arch/amd64/pm.h>
 #include <arch/arch.h>
+#include <kernel/ex/user_time_abi.h>
 #include <kernel/hodbg.h>
+#include <kernel/ke/clock_event.h>
+#include <kernel/ke/mm.h>
 #include <libc/string.h>
 
 #include "sinks/hpet_sink.h"
@@ -30,28 +34,151 @@ static KE_PMTIMER_TIME_SINK gPmTimerSink;
 static KE_TSC_TIME_SINK gTscSink;
 
 //
-// Math Helpers
+// User Time Page
 //
+static EX_USER_TIME_PAGE *gUserTimePage;
+static HO_PHYSICAL_ADDRESS gUserTimePagePhys;
 
-// 128-bit by 64-bit division using x86-64 div instruction
-// Computes (hi:lo) / div, returns quotient
-static uint64_t
-Div128By64(uint64_t hi, uint64_t lo, uint64_t div)
+#define KI_NS_PER_SEC 1000000000ULL
+#define KI_US_PER_SEC 1000000ULL
+
+// A recalibration that moves the frequency further than this is treated as a
+// bad measurement (for example a preempted calibration window) and dropped.
+#define KI_RECALIBRATE_MAX_DRIFT_PPM 10000ULL
+
+// Self-test span: conversions must hold for a year of uptime.
+#define KI_SELFTEST_SPAN_SEC (365ULL * 24ULL * 3600ULL)
+#define KI_SELFTEST_READS    64U
+
+//
+// User Time Page
+//
+
+// Seqlock writer. Stores on x86 are not reordered with each other, so compiler
+// barriers around the payload are enough for a reader on the same CPU.
+static void
+KiPublishUserTimePage(void)
 {
-    uint64_t quot;
-    __asm__ __volatile__("divq %3" : "=a"(quot) : "d"(hi), "a"(lo), "r"(div));
-    return quot;
+    EX_USER_TIME_PAGE *page = gUserTimePage;
+    if (!page)
+        return;
+
+    BOOL tscFastPath = gTimeDevice.Kind == TIME_SOURCE_TSC && gTscSink.IsInvariant && gTimeDevice.FreqHz != 0;
+
+    page->Sequence++;
+    __asm__ __volatile__("" ::: "memory");
+
+    page->Version = EX_USER_TIME_PAGE_VERSION;
+    page->Flags = tscFastPath ? EX_USER_TIME_PAGE_FLAG_TSC : 0;
+    page->Shift = tscFastPath ? gTimeDevice.TickToNs.Shift : 0;
+    page->TscFrequencyHz = tscFastPath ? gTimeDevice.FreqHz : 0;
+    page->Mult = tscFastPath ? gTimeDevice.TickToNs.Mult : 0;
+    page->BaseTick = gTimeDevice.BaseTick;
+    page->BaseNs = gTimeDevice.BaseNs;
+
+    __asm__ __volatile__("" ::: "memory");
+    page->Sequence++;
+}
+
+static HO_STATUS
+KiCreateUserTimePage(void)
+{
+    HO_VIRTUAL_ADDRESS pageVirt = 0;
+    HO_STATUS status = KeHeapAllocPages(1, &pageVirt);
+    if (status != EC_SUCCESS)
+        return status;
+
+    KE_PT_MAPPING mapping;
+    status = KePtQueryPage(KeGetKernelAddressSpace(), pageVirt, &mapping);
+    if (status == EC_SUCCESS && (!mapping.Present || mapping.LargeLeaf))
+        status = EC_INVALID_STATE;
+    if (status != EC_SUCCESS)
+    {
+        HO_STATUS freeStatus = KeHeapFreePages(pageVirt);
+        return freeStatus != EC_SUCCESS ? freeStatus : status;
+    }
+
+    gUserTimePage = (EX_USER_TIME_PAGE *)(uint64_t)pageVirt;
+    gUserTimePagePhys = mapping.PhysicalBase;
+    memset(gUserTimePage, 0, PAGE_4KB);
+    return EC_SUCCESS;
+}
+
+//
+// Conversion State
+//
+
+static HO_STATUS
+KiComputeConversions(uint64_t freqHz, KE_TIME_CONVERSION *tickToNs, KE_TIME_CONVERSION *usToTick)
+{
+    HO_STATUS status = KeTimeConversionInit(tickToNs, freqHz, KI_NS_PER_SEC);
+    if (status != EC_SUCCESS)
+        return status;
+
+    return KeTimeConversionInit(usToTick, KI_US_PER_SEC, freqHz);
 }
 
-// Multiply then divide: (value * mul) / div
-// Uses 128-bit intermediate to avoid overflow
+// Seqlock reader. A reader preempted by a rebase sees the sequence move and
+// retries; the writer runs with interrupts off, so an ISR never spins here.
 static uint64_t
-Mul64Div64(uint64_t value, uint64_t mul, uint64_t div)
+KiReadUptimeNs(void)
 {
-    __uint128_t product = (__uint128_t)value * mul;
-    uint64_t hi = (uint64_t)(product >> 64);
-    uint64_t lo = (uint64_t)product;
-    return Div128By64(hi, lo, div);
+    for (;;)
+    {
+        uint32_t sequence = __atomic_load_n(&gTimeDevice.Sequence, __ATOMIC_ACQUIRE);
+        if ((sequence & 1U) != 0)
+        {
+            __asm__ __volatile__("pause");
+            continue;
+        }
+
+        uint64_t baseTick = gTimeDevice.BaseTick;
+        uint64_t baseNs = gTimeDevice.BaseNs;
+        KE_TIME_CONVERSION tickToNs = gTimeDevice.TickToNs;
+        uint64_t currentTick = gTimeDevice.ActiveSink->ReadCounter(gTimeDevice.ActiveSink);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&gTimeDevice.Sequence, __ATOMIC_RELAXED) != sequence)
+            continue;
+
+        return baseNs + KeTimeConvert(&tickToNs, currentTick - baseTick);
+    }
+}
+
+// Seqlock writer. Moves the base to the current tick so uptime stays
+// continuous across the frequency change, then republishes the user page.
+static void
+KiRebaseTimeDevice(uint64_t freqHz, const KE_TIME_CONVERSION *tickToNs, const KE_TIME_CONVERSION *usToTick)
+{
+    ARCH_INTERRUPT_STATE savedState = ArchDisableInterrupts();
+
+    uint64_t currentTick = gTimeDevice.ActiveSink->ReadCounter(gTimeDevice.ActiveSink);
+    uint64_t nowNs = gTimeDevice.BaseNs + KeTimeConvert(&gTimeDevice.TickToNs, currentTick - gTimeDevice.BaseTick);
+
+    gTimeDevice.Sequence++;
+    __asm__ __volatile__("" ::: "memory");
+
+    gTimeDevice.BaseTick = currentTick;
+    gTimeDevice.BaseNs = nowNs;
+    gTimeDevice.FreqHz = freqHz;
+    gTimeDevice.TickToNs = *tickToNs;
+    gTimeDevice.UsToTick = *usToTick;
+
+    __asm__ __volatile__("" ::: "memory");
+    gTimeDevice.Sequence++;
+
+    KiPublishUserTimePage();
+    ArchRestoreInterruptState(savedState);
+}
+
+static KE_TIME_SINK *
+KiSelectCalibrationReference(void)
+{
+    if (gPmTimerSink.Initialized)
+        return &gPmTimerSink.Base;
+    if (gHpetSink.Initialized)
+        return &gHpetSink.Base;
+    return NULL;
 }
 
 //
@@ -73,13 +200,9 @@ KeTimeSourceInit(HO_PHYSICAL_ADDRESS acpiRsdpPhys)
     if (tscStatus == EC_SUCCESS)
     {
         KE_TIME_SINK *refSink = NULL;
-        if (pmtStatus == EC_SUCCESS && gPmTimerSink.Initialized)
+        if (pmtStatus == EC_SUCCESS || hpetStatus == EC_SUCCESS)
         {
-            refSink = &gPmTimerSink.Base;
-        }
-        else if (hpetStatus == EC_SUCCESS && gHpetSink.Initialized)
-        {
-            refSink = &gHpetSink.Base;
+            refSink = KiSelectCalibrationReference();
         }
 
         if (refSink)
@@ -140,11 +263,32 @@ KeTimeSourceInit(HO_PHYSICAL_ADDRESS acpiRsdpPhys)
     gTimeDevice.ActiveSink = selectedSink;
     gTimeDevice.Kind = kind;
     gTimeDevice.FreqHz = selectedSink->GetFrequency(selectedSink);
+
+    HO_STATUS convStatus = KiComputeConversions(gTimeDevice.FreqHz, &gTimeDevice.TickToNs, &gTimeDevice.UsToTick);
+    if (convStatus != EC_SUCCESS)
+    {
+        klog(KLOG_LEVEL_ERROR, "[TIME] No conversion for %lu Hz\n", gTimeDevice.FreqHz);
+        return convStatus;
+    }
+
     gTimeDevice.StartTick = selectedSink->ReadCounter(selectedSink);
+    gTimeDevice.BaseTick = gTimeDevice.StartTick;
+    gTimeDevice.BaseNs = 0;
     gTimeDevice.Initialized = TRUE;
 
     klog(KLOG_LEVEL_INFO, "[TIME] Source: %s @ %lu Hz\n", selectedSink->GetName(selectedSink), gTimeDevice.FreqHz);
 
+    HO_STATUS pageStatus = KiCreateUserTimePage();
+    if (pageStatus != EC_SUCCESS)
+    {
+        klog(KLOG_LEVEL_ERROR, "[TIME] Failed to create user time page: %s\n", KrGetStatusMessage(pageStatus));
+        return pageStatus;
+    }
+
+    KiPublishUserTimePage();
+    klog(KLOG_LEVEL_INFO, "[TIME] User time page: %s\n",
+         (gUserTimePage->Flags & EX_USER_TIME_PAGE_FLAG_TSC) ? "invariant TSC fast path" : "syscall fallback");
+
     return EC_SUCCESS;
 }
 
@@ -154,10 +298,16 @@ KeGetSystemUpRealTime(void)
     if (!gTimeDevice.Initialized || !gTimeDevice.ActiveSink)
         return 0;
 
-    uint64_t currentTick = gTimeDevice.ActiveSink->ReadCounter(gTimeDevice.ActiveSink);
-    uint64_t elapsed = currentTick - gTimeDevice.StartTick;
+    return KiReadUptimeNs() / 1000ULL;
+}
+
+HO_KERNEL_API uint64_t
+KeGetSystemUpTimeNs(void)
+{
+    if (!gTimeDevice.Initialized || !gTimeDevice.ActiveSink)
+        return 0;
 
-    return Mul64Div64(elapsed, 1000000ULL, gTimeDevice.FreqHz);
+    return KiReadUptimeNs();
 }
 
 HO_KERNEL_API BOOL
@@ -180,7 +330,7 @@ KeBusyWaitUs(uint64_t microsec)
         return;
     }
 
-    uint64_t ticksToWait = Mul64Div64(microsec, gTimeDevice.FreqHz, 1000000ULL);
+    uint64_t ticksToWait = KeTimeConvert(&gTimeDevice.UsToTick, microsec);
     if (ticksToWait == 0)
         ticksToWait = 1;
 
@@ -199,3 +349,108 @@ KeGetTimeSourceFrequency(void)
         return 0;
     return gTimeDevice.FreqHz;
 }
+
+HO_KERNEL_API BOOL
+KeIsUserTimePageFastPath(void)
+{
+    return gUserTimePage != NULL && (gUserTimePage->Flags & EX_USER_TIME_PAGE_FLAG_TSC) != 0;
+}
+
+HO_KERNEL_API HO_PHYSICAL_ADDRESS
+KeGetUserTimePagePhys(void)
+{
+    return gUserTimePagePhys;
+}
+
+HO_KERNEL_API HO_STATUS
+KeTimeSourceRecalibrate(void)
+{
+    if (!gTimeDevice.Initialized)
+        return EC_INVALID_STATE;
+
+    if (gTimeDevice.Kind != TIME_SOURCE_TSC)
+        return EC_NOT_SUPPORTED;
+
+    KE_TIME_SINK *refSink = KiSelectCalibrationReference();
+    if (!refSink)
+        return EC_NOT_SUPPORTED;
+
+    // Measure on a copy; the live sink keeps serving readers meanwhile.
+    KE_TSC_TIME_SINK probe = gTscSink;
+    HO_STATUS status = KeTscTimeSinkCalibrate(&probe, refSink);
+    if (status != EC_SUCCESS)
+        return status;
+
+    uint64_t oldFreqHz = gTimeDevice.FreqHz;
+    uint64_t newFreqHz = probe.FreqHz;
+    uint64_t drift = newFreqHz > oldFreqHz ? newFreqHz - oldFreqHz : oldFreqHz - newFreqHz;
+    if (newFreqHz == 0 || KeTimeMulDiv(drift, 1000000ULL, oldFreqHz) > KI_RECALIBRATE_MAX_DRIFT_PPM)
+    {
+        gTimeDevice.RejectedRecalibrationCount++;
+        klog(KLOG_LEVEL_WARNING, "[TIME] TSC recalibration rejected: %lu -> %lu Hz\n", oldFreqHz, newFreqHz);
+        return EC_FAILURE;
+    }
+
+    KE_TIME_CONVERSION tickToNs;
+    KE_TIME_CONVERSION usToTick;
+    status = KiComputeConversions(newFreqHz, &tickToNs, &usToTick);
+    if (status != EC_SUCCESS)
+        return status;
+
+    gTscSink.FreqHz = newFreqHz;
+    KiRebaseTimeDevice(newFreqHz, &tickToNs, &usToTick);
+    gTimeDevice.RecalibrationCount++;
+    KeClockEventUpdateTscRate(newFreqHz);
+
+    klog(KLOG_LEVEL_INFO, "[TIME] TSC recalibrated by %s: %lu -> %lu Hz\n", refSink->GetName(refSink), oldFreqHz,
+         newFreqHz);
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API HO_NODISCARD HO_STATUS
+KeTimeSourceSelfTest(void)
+{
+    if (!gTimeDevice.Initialized)
+        return EC_INVALID_STATE;
+
+    uint64_t freqHz = gTimeDevice.FreqHz;
+    HO_STATUS status =
+        KeTimeConversionCheck(&gTimeDevice.TickToNs, freqHz, KI_NS_PER_SEC, freqHz * KI_SELFTEST_SPAN_SEC);
+    if (status != EC_SUCCESS)
+    {
+        klog(KLOG_LEVEL_ERROR, "[TIME] tick->ns conversion disagrees with the divide path\n");
+        return status;
+    }
+
+    status = KeTimeConversionCheck(&gTimeDevice.UsToTick, KI_US_PER_SEC, freqHz, KI_US_PER_SEC * KI_SELFTEST_SPAN_SEC);
+    if (status != EC_SUCCESS)
+    {
+        klog(KLOG_LEVEL_ERROR, "[TIME] us->tick conversion disagrees with the divide path\n");
+        return status;
+    }
+
+    uint64_t previousNs = KeGetSystemUpTimeNs();
+    for (uint32_t index = 0; index < KI_SELFTEST_READS; ++index)
+    {
+        uint64_t nowNs = KeGetSystemUpTimeNs();
+        if (nowNs < previousNs)
+        {
+            klog(KLOG_LEVEL_ERROR, "[TIME] uptime went backwards\n");
+            return EC_FAILURE;
+        }
+        previousNs = nowNs;
+    }
+
+    klog(KLOG_LEVEL_INFO, "[TIME] conversion self-test passed (tick->ns mult=%lu shift=%u)\n",
+         (unsigned long)gTimeDevice.TickToNs.Mult, gTimeDevice.TickToNs.Shift);
+    return EC_SUCCESS;
+}
+
+HO_KERNEL_API void
+KeQueryTimeSourceRecalibration(uint64_t *acceptedCount, uint64_t *rejectedCount)
+{
+    if (acceptedCount)
+        *acceptedCount = gTimeDevice.RecalibrationCount;
+    if (rejectedCount)
+        *rejectedCount = gTimeDevice.RejectedRecalibrationCount;
+}
@@ -10,13 +10,15 @@
 #include <kernel/ex/ex_user_runtime.h>
 #include <kernel/ex/user_image_abi.h>
 #include <kernel/ex/user_regression_anchors.h>
+#include <kernel/ex/user_time_abi.h>
 #include <kernel/ke/mm.h>
 #include <kernel/ke/scheduler.h>
+#include <kernel/ke/time_source.h>
 #include <kernel/ke/user_mode.h>
 #include <kernel/hodbg.h>
 #include <libc/string.h>
 
-#define KE_USER_MODE_MAX_MAPPINGS 3U
+#define KE_USER_MODE_MAX_MAPPINGS 4U
 #define KE_USER_MODE_INITIAL_RFLAGS 0x202ULL
 
 typedef enum KE_USER_MODE_MAPPING_KIND
@@ -24,6 +26,7 @@ typedef enum KE_USER_MODE_MAPPING_KIND
     KE_USER_MODE_MAPPING_KIND_CODE = 0,
     KE_USER_MODE_MAPPING_KIND_CONST,
     KE_USER_MODE_MAPPING_KIND_STACK,
+    KE_USER_MODE_MAPPING_KIND_TIME, // Shared read-only time page, never freed with the staging
 } KE_USER_MODE_MAPPING_KIND;
 
 typedef struct KE_USER_MODE_MAPPING_RECORD
@@ -68,6 +71,7 @@ static HO_STATUS KiAllocateAndMapUserPage(const KE_KERNEL_ADDRESS_SPACE *space,
                                           uint64_t attributes,
                                           const void *bytes,
                                           uint64_t byteCount);
+static HO_STATUS KiMapUserTimePage(const KE_KERNEL_ADDRESS_SPACE *space, KE_USER_MODE_STAGING *staging);
 static const KE_USER_MODE_MAPPING_RECORD *KiFindMappedPage(const KE_USER_MODE_STAGING *staging,
                                                                 KE_USER_MODE_MAPPING_KIND kind);
 static KE_USER_MODE_STAGING *KiGetCurrentThreadStaging(void);
@@ -178,7 +182,7 @@ KiAllocateAndMapUserPage(const KE_KERNEL_ADDRESS_SPACE *space,
         return status;
     }
 
-    status = KePtMapPage(space, virtAddr, physAddr, attributes);
+    status = KePtMapPage(space, virtAddr, physAddr, attributes, KE_MEMORY_TYPE_WRITE_BACK);
     if (status != EC_SUCCESS)
     {
         (void)KePmmFreePages(physAddr, 1);
@@ -200,6 +204,31 @@ KiAllocateAndMapUserPage(const KE_KERNEL_ADDRESS_SPACE *space,
     return EC_SUCCESS;
 }
 
+static HO_STATUS
+KiMapUserTimePage(const KE_KERNEL_ADDRESS_SPACE *space, KE_USER_MODE_STAGING *staging)
+{
+    HO_PHYSICAL_ADDRESS physAddr = KeGetUserTimePagePhys();
+    if (physAddr == 0)
+        return EC_INVALID_STATE;
+
+    HO_STATUS status =
+        KePtMapPage(space, EX_USER_TIME_PAGE_BASE, physAddr, PTE_USER | PTE_NO_EXECUTE, KE_MEMORY_TYPE_WRITE_BACK);
+    if (status != EC_SUCCESS)
+        return status;
+
+    status = KiRecordMappedPage(staging, KE_USER_MODE_MAPPING_KIND_TIME, EX_USER_TIME_PAGE_BASE, physAddr,
+                                PTE_USER | PTE_NO_EXECUTE);
+    if (status != EC_SUCCESS)
+    {
+        HO_STATUS cleanupStatus = KePtUnmapPage(space, EX_USER_TIME_PAGE_BASE);
+        if (cleanupStatus != EC_SUCCESS && cleanupStatus != EC_INVALID_STATE)
+            return cleanupStatus;
+        return status;
+    }
+
+    return EC_SUCCESS;
+}
+
 static const KE_USER_MODE_MAPPING_RECORD *
 KiFindMappedPage(const KE_USER_MODE_STAGING *staging, KE_USER_MODE_MAPPING_KIND kind)
 {
@@ -280,6 +309,10 @@ KeUserModeCreateStaging(const KE_USER_MODE_CREATE_PARAMS *params,
     if (status != EC_SUCCESS)
         return status;
 
+    status = KiValidateUserModeHole(space, EX_USER_TIME_PAGE_BASE);
+    if (status != EC_SUCCESS)
+        return status;
+
     KE_USER_MODE_STAGING *staging = (KE_USER_MODE_STAGING *)kzalloc(sizeof(*staging));
     if (!staging)
         return EC_OUT_OF_RESOURCE;
@@ -323,6 +356,10 @@ KeUserModeCreateStaging(const KE_USER_MODE_CREATE_PARAMS *params,
     if (status != EC_SUCCESS)
         goto cleanup;
 
+    status = KiMapUserTimePage(space, staging);
+    if (status != EC_SUCCESS)
+        goto cleanup;
+
     status = KiValidateUserModeHole(space, staging->GuardBase);
     if (status != EC_SUCCESS)
         goto cleanup;
@@ -364,7 +401,7 @@ KeUserModeDestroyStaging(KE_USER_MODE_STAGING *staging)
             HO_STATUS unmapStatus = KePtUnmapPage(space, record->VirtualBase);
             if (unmapStatus == EC_SUCCESS || unmapStatus == EC_INVALID_STATE)
             {
-                canFreeBackingPage = TRUE;
+                canFreeBackingPage = record->Kind != KE_USER_MODE_MAPPING_KIND_TIME;
             }
             else if (firstError == EC_SUCCESS)
             {
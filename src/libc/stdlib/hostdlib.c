@@ -5,6 +5,41 @@
 #define ITOA_32_BUFFER_SIZE 33
 #define ITOA_64_BUFFER_SIZE 65
 
+// Two decimal digits per entry, so conversion divides once per pair.
+static const char gDecimalDigitPairs[200] = "00010203040506070809"
+                                            "10111213141516171819"
+                                            "20212223242526272829"
+                                            "30313233343536373839"
+                                            "40414243444546474849"
+                                            "50515253545556575859"
+                                            "60616263646566676869"
+                                            "70717273747576777879"
+                                            "80818283848586878889"
+                                            "90919293949596979899";
+
+static const uint64_t gPowersOfTen[20] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
 static void WriteIntDecimal(uint64_t num, char *buf, uint8_t digitSize);
 static void WriteIntTwoBase(uint64_t num, char *buf, uint8_t digitSize, int base);
 
@@ -109,45 +144,12 @@ Int64ToStringEx(int64_t val, char *buf, int32_t padding, char padChar)
 uint8_t
 CountDecDigit(uint64_t n)
 {
-    if (n < 10)
+    if (n == 0)
         return 1;
-    if (n < 100)
-        return 2;
-    if (n < 1000)
-        return 3;
-    if (n < 10000)
-        return 4;
-    if (n < 100000)
-        return 5;
-    if (n < 1000000)
-        return 6;
-    if (n < 10000000)
-        return 7;
-    if (n < 100000000)
-        return 8;
-    if (n < 1000000000)
-        return 9;
-    if (n < 10000000000)
-        return 10;
-    if (n < 100000000000)
-        return 11;
-    if (n < 1000000000000)
-        return 12;
-    if (n < 10000000000000)
-        return 13;
-    if (n < 100000000000000)
-        return 14;
-    if (n < 1000000000000000)
-        return 15;
-    if (n < 10000000000000000)
-        return 16;
-    if (n < 100000000000000000)
-        return 17;
-    if (n < 1000000000000000000)
-        return 18;
-    if (n < 10000000000000000000ull)
-        return 19;
-    return 20;
+
+    // bits * log10(2), close enough to be off by at most one below the answer.
+    uint32_t estimate = ((uint32_t)(64 - __builtin_clzll(n)) * 1233U) >> 12;
+    return (uint8_t)(estimate + (n >= gPowersOfTen[estimate]));
 }
 
 int
@@ -174,15 +176,21 @@ static void
 WriteIntDecimal(uint64_t num, char *buf, uint8_t digitSize)
 {
     char *end = buf + digitSize;
-    if (num == 0)
+    while (num >= 100)
     {
-        *(--end) = '0';
-        return;
+        const char *pair = &gDecimalDigitPairs[(num % 100) * 2];
+        num /= 100;
+        *(--end) = pair[1];
+        *(--end) = pair[0];
     }
-    while (num > 0)
+    if (num >= 10)
+    {
+        *(--end) = gDecimalDigitPairs[num * 2 + 1];
+        *(--end) = gDecimalDigitPairs[num * 2];
+    }
+    else
     {
-        *(--end) = DIGITS_STR[num % 10];
-        num /= 10;
+        *(--end) = (char)('0' + num);
     }
 }
 
@@ -0,0 +1,148 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: libc/string/mem_dispatch.c
+ * Description: CPU feature detection behind memcpy, memmove and memset. The same
+ *              code runs in the kernel and in the EFI loader; vector loops are
+ *              only offered where the build may touch vector registers (the
+ *              kernel is built general-registers-only and does not save them).
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "mem_internal.h"
+
+#include <arch/amd64/asm.h>
+
+#define MEM_CPUID_1_EDX_SSE2     (1U << 26)
+#define MEM_CPUID_1_ECX_OSXSAVE  (1U << 27)
+#define MEM_CPUID_1_ECX_AVX      (1U << 28)
+#define MEM_CPUID_7_EBX_AVX2     (1U << 5)
+#define MEM_CPUID_7_EBX_ERMS     (1U << 9)
+#define MEM_CPUID_7_EDX_FSRM     (1U << 4)
+#define MEM_XCR0_SSE_AVX         0x6U
+#define MEM_CPUID_4_TYPE_NULL    0U
+#define MEM_CPUID_4_MAX_SUBLEAFS 8U
+
+MEM_DISPATCH gMemDispatch;
+
+#if defined(__SSE2__)
+static BOOL
+MemOsSavesYmm(void)
+{
+    uint32_t lo, hi;
+    __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    (void)hi;
+    return (lo & MEM_XCR0_SSE_AVX) == MEM_XCR0_SSE_AVX;
+}
+#endif
+
+// Size of the largest cache CPUID describes, or 0 if it describes none.
+static size_t
+MemLastLevelCacheSize(uint32_t maxLeaf)
+{
+    uint32_t eax, ebx, ecx, edx;
+    size_t largest = 0;
+
+    // Deterministic cache parameters (Intel); AMD reports nothing here.
+    if (maxLeaf >= 4)
+    {
+        for (uint32_t subleaf = 0; subleaf < MEM_CPUID_4_MAX_SUBLEAFS; ++subleaf)
+        {
+            cpuidex(4, subleaf, &eax, &ebx, &ecx, &edx);
+            if ((eax & 0x1FU) == MEM_CPUID_4_TYPE_NULL)
+                break;
+            size_t ways = ((ebx >> 22) & 0x3FFU) + 1U;
+            size_t partitions = ((ebx >> 12) & 0x3FFU) + 1U;
+            size_t lineSize = (ebx & 0xFFFU) + 1U;
+            size_t sets = (size_t)ecx + 1U;
+            size_t size = ways * partitions * lineSize * sets;
+            if (size > largest)
+                largest = size;
+        }
+    }
+    if (largest != 0)
+        return largest;
+
+    cpuid(0x80000000U, &eax, &ebx, &ecx, &edx);
+    if (eax >= 0x80000006U)
+    {
+        cpuid(0x80000006U, &eax, &ebx, &ecx, &edx);
+        if ((edx >> 18) != 0)
+            return (size_t)(edx >> 18) * 512U * 1024U; // L3, 512 KiB units
+        return (size_t)(ecx >> 16) * 1024U;            // L2, KiB
+    }
+    return 0;
+}
+
+void
+MemDetectFeatures(void)
+{
+    uint32_t eax, ebx, ecx, edx;
+    uint32_t features = MEM_FEATURE_DETECTED;
+
+    cpuid(0, &eax, &ebx, &ecx, &edx);
+    uint32_t maxLeaf = eax;
+
+    cpuid(1, &eax, &ebx, &ecx, &edx);
+    // movnti is an SSE2 instruction but stores from a general register.
+    if ((edx & MEM_CPUID_1_EDX_SSE2) != 0)
+        features |= MEM_FEATURE_NONTEMPORAL;
+#if defined(__SSE2__)
+    if ((edx & MEM_CPUID_1_EDX_SSE2) != 0)
+        features |= MEM_FEATURE_SSE2;
+    BOOL avxUsable = (ecx & MEM_CPUID_1_ECX_OSXSAVE) != 0 && (ecx & MEM_CPUID_1_ECX_AVX) != 0 && MemOsSavesYmm();
+#endif
+
+    if (maxLeaf >= 7)
+    {
+        cpuidex(7, 0, &eax, &ebx, &ecx, &edx);
+        if ((ebx & MEM_CPUID_7_EBX_ERMS) != 0)
+            features |= MEM_FEATURE_ERMS;
+        if ((edx & MEM_CPUID_7_EDX_FSRM) != 0)
+            features |= MEM_FEATURE_FSRM;
+#if defined(__SSE2__)
+        if (avxUsable && (ebx & MEM_CPUID_7_EBX_AVX2) != 0)
+            features |= MEM_FEATURE_AVX2;
+#endif
+    }
+
+    size_t threshold = MemLastLevelCacheSize(maxLeaf) / 4U * 3U;
+    if (threshold == 0)
+        threshold = MEM_NONTEMPORAL_DEFAULT_THRESHOLD;
+    else if (threshold < MEM_NONTEMPORAL_MIN_THRESHOLD)
+        threshold = MEM_NONTEMPORAL_MIN_THRESHOLD;
+
+    gMemDispatch.DefaultNonTemporalThreshold = threshold;
+    gMemDispatch.NonTemporalThreshold = threshold;
+    gMemDispatch.Enabled = features;
+    // Callers test Detected alone, so it is published last.
+    __asm__ __volatile__("" : : : "memory");
+    gMemDispatch.Detected = features;
+}
+
+HO_PUBLIC_API uint32_t
+MemQueryFeatures(uint32_t *outDetected)
+{
+    uint32_t enabled = MemFeatures();
+    if (outDetected != NULL)
+        *outDetected = gMemDispatch.Detected;
+    return enabled;
+}
+
+HO_PUBLIC_API uint32_t
+MemRestrictFeatures(uint32_t mask)
+{
+    uint32_t previous = MemFeatures();
+    gMemDispatch.Enabled = (gMemDispatch.Detected & mask) | MEM_FEATURE_DETECTED;
+    return previous;
+}
+
+HO_PUBLIC_API size_t
+MemSetNonTemporalThreshold(size_t bytes)
+{
+    (void)MemFeatures();
+    size_t previous = gMemDispatch.NonTemporalThreshold;
+    gMemDispatch.NonTemporalThreshold = bytes != 0 ? bytes : gMemDispatch.DefaultNonTemporalThreshold;
+    return previous;
+}
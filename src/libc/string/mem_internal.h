@@ -0,0 +1,129 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: libc/string/mem_internal.h
+ * Description: Shared pieces of the libc string routines: the dispatch state of
+ *              memcpy, memmove and memset, the small-size copy every strategy
+ *              finishes with, and the word-at-a-time byte tests.
+ *
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#pragma once
+
+#include "_hobase.h"
+#include <hostdlib.h>
+
+// From this size on ERMS makes rep movsb/stosb the best choice. Below it the start-up cost of the string
+// instruction dominates, unless FSRM says short ones are fast too (and no vector loop is available).
+#define MEM_REP_THRESHOLD 512U
+
+// Streaming stores pay off once the destination would push the rest of the working set out of the last-level
+// cache. Used when CPUID does not report the cache size.
+#define MEM_NONTEMPORAL_DEFAULT_THRESHOLD (1024U * 1024U)
+#define MEM_NONTEMPORAL_MIN_THRESHOLD     (256U * 1024U)
+
+#define MEM_FEATURE_VECTOR (MEM_FEATURE_SSE2 | MEM_FEATURE_AVX2)
+
+typedef uint64_t MEM_U64 __attribute__((__may_alias__, __aligned__(1)));
+typedef uint32_t MEM_U32 __attribute__((__may_alias__, __aligned__(1)));
+typedef uint16_t MEM_U16 __attribute__((__may_alias__, __aligned__(1)));
+
+typedef struct MEM_DISPATCH
+{
+    uint32_t Detected; // 0 until the first call detects
+    uint32_t Enabled;
+    size_t NonTemporalThreshold;
+    size_t DefaultNonTemporalThreshold;
+} MEM_DISPATCH;
+
+extern MEM_DISPATCH gMemDispatch;
+
+void MemDetectFeatures(void);
+
+// Enabled features, detecting them on the first call.
+MAYBE_UNUSED static inline uint32_t
+MemFeatures(void)
+{
+    if (gMemDispatch.Detected == 0)
+        MemDetectFeatures();
+    return gMemDispatch.Enabled;
+}
+
+// Copy forward. Also correct for overlapping buffers when dst <= src, which memmove relies on; pass features
+// without MEM_FEATURE_NONTEMPORAL for those.
+void *MemCopyForward(void *dst, const void *src, size_t n, uint32_t features);
+
+// Copy n < 32 bytes. Every load happens before the first store, so any overlap is fine.
+MAYBE_UNUSED static inline void
+MemCopySmall(uint8_t *d, const uint8_t *s, size_t n)
+{
+    if (n >= 16)
+    {
+        uint64_t a = *(const MEM_U64 *)s;
+        uint64_t b = *(const MEM_U64 *)(s + 8);
+        uint64_t c = *(const MEM_U64 *)(s + n - 16);
+        uint64_t e = *(const MEM_U64 *)(s + n - 8);
+        *(MEM_U64 *)d = a;
+        *(MEM_U64 *)(d + 8) = b;
+        *(MEM_U64 *)(d + n - 16) = c;
+        *(MEM_U64 *)(d + n - 8) = e;
+    }
+    else if (n >= 8)
+    {
+        uint64_t a = *(const MEM_U64 *)s;
+        uint64_t b = *(const MEM_U64 *)(s + n - 8);
+        *(MEM_U64 *)d = a;
+        *(MEM_U64 *)(d + n - 8) = b;
+    }
+    else if (n >= 4)
+    {
+        uint32_t a = *(const MEM_U32 *)s;
+        uint32_t b = *(const MEM_U32 *)(s + n - 4);
+        *(MEM_U32 *)d = a;
+        *(MEM_U32 *)(d + n - 4) = b;
+    }
+    else if (n >= 2)
+    {
+        uint16_t a = *(const MEM_U16 *)s;
+        uint16_t b = *(const MEM_U16 *)(s + n - 2);
+        *(MEM_U16 *)d = a;
+        *(MEM_U16 *)(d + n - 2) = b;
+    }
+    else if (n == 1)
+    {
+        *d = *s;
+    }
+}
+
+// Word-at-a-time scans load whole 8- or 16-byte words. A load that stays inside one page cannot fault even when
+// it reaches past the end of the string, so scans either align their loads or step bytewise near a page end.
+#define MEM_PAGE_SIZE  4096U
+#define MEM_SWAR_ONES  0x0101010101010101ULL
+#define MEM_SWAR_LOW7  0x7F7F7F7F7F7F7F7FULL
+#define MEM_SWAR_HIGHS 0x8080808080808080ULL
+
+// TRUE when a span-byte load at ptr would reach into the next page.
+#define MEM_NEAR_PAGE_END(ptr, span) (((uint64_t)(ptr) & (MEM_PAGE_SIZE - 1U)) > MEM_PAGE_SIZE - (span))
+
+// High bit set in the lowest zero byte of word. Bytes above it may be flagged falsely, so only the lowest set
+// bit is meaningful.
+MAYBE_UNUSED static inline uint64_t
+MemSwarZeroBytes(uint64_t word)
+{
+    return (word - MEM_SWAR_ONES) & ~word & MEM_SWAR_HIGHS;
+}
+
+// High bit set in exactly the non-zero bytes of word.
+MAYBE_UNUSED static inline uint64_t
+MemSwarNonZeroBytes(uint64_t word)
+{
+    return (((word & MEM_SWAR_LOW7) + MEM_SWAR_LOW7) | word) & MEM_SWAR_HIGHS;
+}
+
+// Byte at index of a little-endian word, where index comes from the lowest set bit of a SWAR mask.
+MAYBE_UNUSED static inline int
+MemSwarByteAt(uint64_t word, uint64_t mask)
+{
+    return (int)((word >> (__builtin_ctzll(mask) & ~7U)) & 0xFFU);
+}
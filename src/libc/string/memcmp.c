@@ -1,4 +1,5 @@
 #include "libc/string.h"
+#include "mem_internal.h"
 
 int
 memcmp(const void *s1, const void *s2, size_t n)
@@ -6,6 +7,38 @@ memcmp(const void *s1, const void *s2, size_t n)
     const unsigned char *p1 = s1;
     const unsigned char *p2 = s2;
 
+#if defined(__SSE2__)
+    while (n >= 16U)
+    {
+        uint32_t equal;
+        __asm__("movdqu (%1), %%xmm0\n\t"
+                "movdqu (%2), %%xmm1\n\t"
+                "pcmpeqb %%xmm1, %%xmm0\n\t"
+                "pmovmskb %%xmm0, %0"
+                : "=r"(equal)
+                : "r"(p1), "r"(p2), "m"(*(const char(*)[16])p1), "m"(*(const char(*)[16])p2)
+                : "xmm0", "xmm1");
+        if (equal != 0xFFFFU)
+        {
+            uint32_t index = (uint32_t)__builtin_ctz(~equal);
+            return p1[index] - p2[index];
+        }
+        p1 += 16;
+        p2 += 16;
+        n -= 16U;
+    }
+#endif
+    while (n >= 8U)
+    {
+        uint64_t w1 = *(const MEM_U64 *)p1;
+        uint64_t w2 = *(const MEM_U64 *)p2;
+        if (w1 != w2)
+            return MemSwarByteAt(w1, w1 ^ w2) - MemSwarByteAt(w2, w1 ^ w2);
+        p1 += 8;
+        p2 += 8;
+        n -= 8U;
+    }
+
     while (n--)
     {
         if (*p1 != *p2)
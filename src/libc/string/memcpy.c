@@ -1,15 +1,199 @@
 #include "libc/string.h"
+#include "mem_internal.h"
+
+// Copy whole 32-byte blocks with general registers; leaves the remainder in *n.
+static void
+MemCopyQwordBlocks(uint8_t **d, const uint8_t **s, size_t *n)
+{
+    size_t blocks = *n / 32U;
+    uint8_t *dst = *d;
+    const uint8_t *src = *s;
+
+    __asm__ __volatile__("1:\n\t"
+                         "movq (%1), %%r8\n\t"
+                         "movq 8(%1), %%r9\n\t"
+                         "movq 16(%1), %%r10\n\t"
+                         "movq 24(%1), %%r11\n\t"
+                         "movq %%r8, (%0)\n\t"
+                         "movq %%r9, 8(%0)\n\t"
+                         "movq %%r10, 16(%0)\n\t"
+                         "movq %%r11, 24(%0)\n\t"
+                         "addq $32, %1\n\t"
+                         "addq $32, %0\n\t"
+                         "decq %2\n\t"
+                         "jnz 1b"
+                         : "+r"(dst), "+r"(src), "+r"(blocks)
+                         :
+                         : "r8", "r9", "r10", "r11", "memory", "cc");
+
+    *d = dst;
+    *s = src;
+    *n %= 32U;
+}
+
+#if defined(__SSE2__)
+static void
+MemCopySse2Blocks(uint8_t **d, const uint8_t **s, size_t *n)
+{
+    size_t blocks = *n / 64U;
+    uint8_t *dst = *d;
+    const uint8_t *src = *s;
+
+    __asm__ __volatile__("1:\n\t"
+                         "movdqu (%1), %%xmm0\n\t"
+                         "movdqu 16(%1), %%xmm1\n\t"
+                         "movdqu 32(%1), %%xmm2\n\t"
+                         "movdqu 48(%1), %%xmm3\n\t"
+                         "movdqu %%xmm0, (%0)\n\t"
+                         "movdqu %%xmm1, 16(%0)\n\t"
+                         "movdqu %%xmm2, 32(%0)\n\t"
+                         "movdqu %%xmm3, 48(%0)\n\t"
+                         "addq $64, %1\n\t"
+                         "addq $64, %0\n\t"
+                         "decq %2\n\t"
+                         "jnz 1b"
+                         : "+r"(dst), "+r"(src), "+r"(blocks)
+                         :
+                         : "xmm0", "xmm1", "xmm2", "xmm3", "memory", "cc");
+
+    *d = dst;
+    *s = src;
+    *n %= 64U;
+}
+
+static void
+MemCopyAvx2Blocks(uint8_t **d, const uint8_t **s, size_t *n)
+{
+    size_t blocks = *n / 128U;
+    uint8_t *dst = *d;
+    const uint8_t *src = *s;
+
+    __asm__ __volatile__("1:\n\t"
+                         "vmovdqu (%1), %%ymm0\n\t"
+                         "vmovdqu 32(%1), %%ymm1\n\t"
+                         "vmovdqu 64(%1), %%ymm2\n\t"
+                         "vmovdqu 96(%1), %%ymm3\n\t"
+                         "vmovdqu %%ymm0, (%0)\n\t"
+                         "vmovdqu %%ymm1, 32(%0)\n\t"
+                         "vmovdqu %%ymm2, 64(%0)\n\t"
+                         "vmovdqu %%ymm3, 96(%0)\n\t"
+                         "addq $128, %1\n\t"
+                         "addq $128, %0\n\t"
+                         "decq %2\n\t"
+                         "jnz 1b\n\t"
+                         "vzeroupper"
+                         : "+r"(dst), "+r"(src), "+r"(blocks)
+                         :
+                         : "xmm0", "xmm1", "xmm2", "xmm3", "memory", "cc");
+
+    *d = dst;
+    *s = src;
+    *n %= 128U;
+}
+#endif
+
+// Streaming copy for buffers larger than the cache; the destination is aligned first.
+static void
+MemCopyNonTemporal(uint8_t *d, const uint8_t *s, size_t n, uint32_t features)
+{
+    size_t head = (size_t)(-(uint64_t)d & 15U);
+    MemCopySmall(d, s, head);
+    d += head;
+    s += head;
+    n -= head;
+
+#if defined(__SSE2__)
+    if ((features & MEM_FEATURE_SSE2) != 0 && n >= 64U)
+    {
+        size_t blocks = n / 64U;
+        __asm__ __volatile__("1:\n\t"
+                             "movdqu (%1), %%xmm0\n\t"
+                             "movdqu 16(%1), %%xmm1\n\t"
+                             "movdqu 32(%1), %%xmm2\n\t"
+                             "movdqu 48(%1), %%xmm3\n\t"
+                             "movntdq %%xmm0, (%0)\n\t"
+                             "movntdq %%xmm1, 16(%0)\n\t"
+                             "movntdq %%xmm2, 32(%0)\n\t"
+                             "movntdq %%xmm3, 48(%0)\n\t"
+                             "addq $64, %1\n\t"
+                             "addq $64, %0\n\t"
+                             "decq %2\n\t"
+                             "jnz 1b"
+                             : "+r"(d), "+r"(s), "+r"(blocks)
+                             :
+                             : "xmm0", "xmm1", "xmm2", "xmm3", "memory", "cc");
+        n %= 64U;
+    }
+#else
+    (void)features;
+#endif
+    if (n >= 32U)
+    {
+        size_t blocks = n / 32U;
+        __asm__ __volatile__("1:\n\t"
+                             "movq (%1), %%r8\n\t"
+                             "movq 8(%1), %%r9\n\t"
+                             "movq 16(%1), %%r10\n\t"
+                             "movq 24(%1), %%r11\n\t"
+                             "movnti %%r8, (%0)\n\t"
+                             "movnti %%r9, 8(%0)\n\t"
+                             "movnti %%r10, 16(%0)\n\t"
+                             "movnti %%r11, 24(%0)\n\t"
+                             "addq $32, %1\n\t"
+                             "addq $32, %0\n\t"
+                             "decq %2\n\t"
+                             "jnz 1b"
+                             : "+r"(d), "+r"(s), "+r"(blocks)
+                             :
+                             : "r8", "r9", "r10", "r11", "memory", "cc");
+        n %= 32U;
+    }
+
+    // Streaming stores are weakly ordered; fence them before anyone else can look.
+    __asm__ __volatile__("sfence" : : : "memory");
+    MemCopySmall(d, s, n);
+}
 
 void *
-memcpy(void *dest, const void *src, size_t n)
+MemCopyForward(void *dst, const void *src, size_t n, uint32_t features)
 {
-    char *d = dest;
-    const char *s = src;
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+
+    if (n < 32U)
+    {
+        MemCopySmall(d, s, n);
+        return dst;
+    }
 
-    while (n--)
+    if ((features & MEM_FEATURE_NONTEMPORAL) != 0 && n >= gMemDispatch.NonTemporalThreshold)
     {
-        *d++ = *s++;
+        MemCopyNonTemporal(d, s, n, features);
+        return dst;
     }
 
-    return dest;
+    BOOL useRep = n >= MEM_REP_THRESHOLD ? (features & MEM_FEATURE_ERMS) != 0
+                                         : (features & (MEM_FEATURE_FSRM | MEM_FEATURE_VECTOR)) == MEM_FEATURE_FSRM;
+    if (useRep)
+    {
+        __asm__ __volatile__("rep movsb" : "+D"(d), "+S"(s), "+c"(n) : : "memory");
+        return dst;
+    }
+
+#if defined(__SSE2__)
+    if ((features & MEM_FEATURE_AVX2) != 0 && n >= 128U)
+        MemCopyAvx2Blocks(&d, &s, &n);
+    if ((features & MEM_FEATURE_SSE2) != 0 && n >= 64U)
+        MemCopySse2Blocks(&d, &s, &n);
+#endif
+    if (n >= 32U)
+        MemCopyQwordBlocks(&d, &s, &n);
+    MemCopySmall(d, s, n);
+    return dst;
+}
+
+void *
+memcpy(void *dest, const void *src, size_t n)
+{
+    return MemCopyForward(dest, src, n, MemFeatures());
 }
@@ -1,24 +1,52 @@
 #include "libc/string.h"
+#include "mem_internal.h"
+
+// Copy whole 32-byte blocks from the end down; d and s point one past the last byte. Each block is loaded before
+// it is stored, so a destination above the source never overwrites bytes still to be read.
+static void
+MemCopyQwordBlocksBackward(uint8_t *d, const uint8_t *s, size_t blocks)
+{
+    __asm__ __volatile__("1:\n\t"
+                         "subq $32, %1\n\t"
+                         "subq $32, %0\n\t"
+                         "movq (%1), %%r8\n\t"
+                         "movq 8(%1), %%r9\n\t"
+                         "movq 16(%1), %%r10\n\t"
+                         "movq 24(%1), %%r11\n\t"
+                         "movq %%r8, (%0)\n\t"
+                         "movq %%r9, 8(%0)\n\t"
+                         "movq %%r10, 16(%0)\n\t"
+                         "movq %%r11, 24(%0)\n\t"
+                         "decq %2\n\t"
+                         "jnz 1b"
+                         : "+r"(d), "+r"(s), "+r"(blocks)
+                         :
+                         : "r8", "r9", "r10", "r11", "memory", "cc");
+}
 
 void *
 memmove(void *dst, const void *src, size_t n)
 {
-    size_t i;
-    uint8_t *p = dst, *q = (uint8_t *)src;
+    uint8_t *d = dst;
+    const uint8_t *s = src;
 
-    // maybe better pipeline?
-    if (src >= dst || src + n <= dst)
+    if (d == s || n < 32U)
     {
-        for (i = 0; i < n; ++i)
-            *p++ = *q++;
+        MemCopySmall(d, s, n);
+        return dst;
     }
-    else
+
+    // Destination below the source, or no overlap at all: the forward copy handles both.
+    if ((uint64_t)d - (uint64_t)s >= n)
     {
-        p += n;
-        q += n;
-        while (n-- > 0)
-            *--p = *--q;
+        uint32_t features = MemFeatures();
+        if ((uint64_t)s - (uint64_t)d < n)
+            features &= ~MEM_FEATURE_NONTEMPORAL;
+        return MemCopyForward(dst, src, n, features);
     }
 
+    // Backward rep movsb is slow on every CPU that has ERMS, so the overlapping case stays on the block loop.
+    MemCopyQwordBlocksBackward(d + n, s + n, n / 32U);
+    MemCopySmall(d, s, n % 32U);
     return dst;
 }
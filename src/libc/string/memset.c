@@ -1,12 +1,192 @@
 #include "libc/string.h"
+#include "mem_internal.h"
+
+// Fill n < 32 bytes with overlapping stores of the replicated byte.
+static void
+MemFillSmall(uint8_t *p, uint64_t pattern, size_t n)
+{
+    if (n >= 16U)
+    {
+        *(MEM_U64 *)p = pattern;
+        *(MEM_U64 *)(p + 8) = pattern;
+        *(MEM_U64 *)(p + n - 16) = pattern;
+        *(MEM_U64 *)(p + n - 8) = pattern;
+    }
+    else if (n >= 8U)
+    {
+        *(MEM_U64 *)p = pattern;
+        *(MEM_U64 *)(p + n - 8) = pattern;
+    }
+    else if (n >= 4U)
+    {
+        *(MEM_U32 *)p = (uint32_t)pattern;
+        *(MEM_U32 *)(p + n - 4) = (uint32_t)pattern;
+    }
+    else if (n >= 2U)
+    {
+        *(MEM_U16 *)p = (uint16_t)pattern;
+        *(MEM_U16 *)(p + n - 2) = (uint16_t)pattern;
+    }
+    else if (n == 1U)
+    {
+        *p = (uint8_t)pattern;
+    }
+}
+
+// Fill whole 32-byte blocks from a general register; leaves the remainder in *n.
+static void
+MemFillQwordBlocks(uint8_t **p, uint64_t pattern, size_t *n, BOOL nonTemporal)
+{
+    size_t blocks = *n / 32U;
+    uint8_t *dst = *p;
+
+    if (nonTemporal)
+    {
+        __asm__ __volatile__("1:\n\t"
+                             "movnti %2, (%0)\n\t"
+                             "movnti %2, 8(%0)\n\t"
+                             "movnti %2, 16(%0)\n\t"
+                             "movnti %2, 24(%0)\n\t"
+                             "addq $32, %0\n\t"
+                             "decq %1\n\t"
+                             "jnz 1b"
+                             : "+r"(dst), "+r"(blocks)
+                             : "r"(pattern)
+                             : "memory", "cc");
+    }
+    else
+    {
+        __asm__ __volatile__("1:\n\t"
+                             "movq %2, (%0)\n\t"
+                             "movq %2, 8(%0)\n\t"
+                             "movq %2, 16(%0)\n\t"
+                             "movq %2, 24(%0)\n\t"
+                             "addq $32, %0\n\t"
+                             "decq %1\n\t"
+                             "jnz 1b"
+                             : "+r"(dst), "+r"(blocks)
+                             : "r"(pattern)
+                             : "memory", "cc");
+    }
+
+    *p = dst;
+    *n %= 32U;
+}
+
+#if defined(__SSE2__)
+static void
+MemFillSse2Blocks(uint8_t **p, uint64_t pattern, size_t *n, BOOL nonTemporal)
+{
+    size_t blocks = *n / 64U;
+    uint8_t *dst = *p;
+
+    if (nonTemporal)
+    {
+        __asm__ __volatile__("movq %2, %%xmm0\n\t"
+                             "punpcklqdq %%xmm0, %%xmm0\n\t"
+                             "1:\n\t"
+                             "movntdq %%xmm0, (%0)\n\t"
+                             "movntdq %%xmm0, 16(%0)\n\t"
+                             "movntdq %%xmm0, 32(%0)\n\t"
+                             "movntdq %%xmm0, 48(%0)\n\t"
+                             "addq $64, %0\n\t"
+                             "decq %1\n\t"
+                             "jnz 1b"
+                             : "+r"(dst), "+r"(blocks)
+                             : "r"(pattern)
+                             : "xmm0", "memory", "cc");
+    }
+    else
+    {
+        __asm__ __volatile__("movq %2, %%xmm0\n\t"
+                             "punpcklqdq %%xmm0, %%xmm0\n\t"
+                             "1:\n\t"
+                             "movdqu %%xmm0, (%0)\n\t"
+                             "movdqu %%xmm0, 16(%0)\n\t"
+                             "movdqu %%xmm0, 32(%0)\n\t"
+                             "movdqu %%xmm0, 48(%0)\n\t"
+                             "addq $64, %0\n\t"
+                             "decq %1\n\t"
+                             "jnz 1b"
+                             : "+r"(dst), "+r"(blocks)
+                             : "r"(pattern)
+                             : "xmm0", "memory", "cc");
+    }
+
+    *p = dst;
+    *n %= 64U;
+}
+
+static void
+MemFillAvx2Blocks(uint8_t **p, uint64_t pattern, size_t *n)
+{
+    size_t blocks = *n / 128U;
+    uint8_t *dst = *p;
+
+    __asm__ __volatile__("vmovq %2, %%xmm0\n\t"
+                         "vpbroadcastq %%xmm0, %%ymm0\n\t"
+                         "1:\n\t"
+                         "vmovdqu %%ymm0, (%0)\n\t"
+                         "vmovdqu %%ymm0, 32(%0)\n\t"
+                         "vmovdqu %%ymm0, 64(%0)\n\t"
+                         "vmovdqu %%ymm0, 96(%0)\n\t"
+                         "addq $128, %0\n\t"
+                         "decq %1\n\t"
+                         "jnz 1b\n\t"
+                         "vzeroupper"
+                         : "+r"(dst), "+r"(blocks)
+                         : "r"(pattern)
+                         : "xmm0", "memory", "cc");
+
+    *p = dst;
+    *n %= 128U;
+}
+#endif
 
 void *
 memset(void *ptr, int value, size_t num)
 {
-    unsigned char *p = ptr;
-    while (num--)
+    uint8_t *p = ptr;
+    uint64_t pattern = (uint64_t)(uint8_t)value * 0x0101010101010101ULL;
+
+    if (num < 32U)
     {
-        *p++ = (unsigned char)value;
+        MemFillSmall(p, pattern, num);
+        return ptr;
     }
+
+    uint32_t features = MemFeatures();
+    if ((features & MEM_FEATURE_NONTEMPORAL) != 0 && num >= gMemDispatch.NonTemporalThreshold)
+    {
+        size_t head = (size_t)(-(uint64_t)p & 15U);
+        MemFillSmall(p, pattern, head);
+        p += head;
+        num -= head;
+#if defined(__SSE2__)
+        if ((features & MEM_FEATURE_SSE2) != 0 && num >= 64U)
+            MemFillSse2Blocks(&p, pattern, &num, TRUE);
+#endif
+        if (num >= 32U)
+            MemFillQwordBlocks(&p, pattern, &num, TRUE);
+        __asm__ __volatile__("sfence" : : : "memory");
+        MemFillSmall(p, pattern, num);
+        return ptr;
+    }
+
+    if (num >= MEM_REP_THRESHOLD && (features & MEM_FEATURE_ERMS) != 0)
+    {
+        __asm__ __volatile__("rep stosb" : "+D"(p), "+c"(num) : "a"(value) : "memory");
+        return ptr;
+    }
+
+#if defined(__SSE2__)
+    if ((features & MEM_FEATURE_AVX2) != 0 && num >= 128U)
+        MemFillAvx2Blocks(&p, pattern, &num);
+    if ((features & MEM_FEATURE_SSE2) != 0 && num >= 64U)
+        MemFillSse2Blocks(&p, pattern, &num, FALSE);
+#endif
+    if (num >= 32U)
+        MemFillQwordBlocks(&p, pattern, &num, FALSE);
+    MemFillSmall(p, pattern, num);
     return ptr;
 }
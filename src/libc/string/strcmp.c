@@ -1,12 +1,56 @@
 #include "libc/string.h"
+#include "mem_internal.h"
 
+// Whole words are compared while neither string is near the end of its page; a word load may read past the
+// terminator, but never into a page that might be unmapped. Near a page end the loop steps one byte.
 int
 strcmp(const char *a, const char *b)
 {
-    while (*a && *b && *a == *b)
+    const uint8_t *s1 = (const uint8_t *)a;
+    const uint8_t *s2 = (const uint8_t *)b;
+
+    for (;;)
     {
-        a++;
-        b++;
+#if defined(__SSE2__)
+        if (!MEM_NEAR_PAGE_END(s1, 16U) && !MEM_NEAR_PAGE_END(s2, 16U))
+        {
+            uint32_t equal, zeros;
+            __asm__("movdqu (%2), %%xmm0\n\t"
+                    "movdqu (%3), %%xmm1\n\t"
+                    "pxor %%xmm2, %%xmm2\n\t"
+                    "pcmpeqb %%xmm0, %%xmm2\n\t"
+                    "pcmpeqb %%xmm0, %%xmm1\n\t"
+                    "pmovmskb %%xmm1, %0\n\t"
+                    "pmovmskb %%xmm2, %1"
+                    : "=r"(equal), "=r"(zeros)
+                    : "r"(s1), "r"(s2), "m"(*(const char(*)[16])s1), "m"(*(const char(*)[16])s2)
+                    : "xmm0", "xmm1", "xmm2");
+            uint32_t stop = (~equal & 0xFFFFU) | zeros;
+            if (stop != 0)
+            {
+                uint32_t index = (uint32_t)__builtin_ctz(stop);
+                return (int)s1[index] - (int)s2[index];
+            }
+            s1 += 16;
+            s2 += 16;
+            continue;
+        }
+#else
+        if (!MEM_NEAR_PAGE_END(s1, 8U) && !MEM_NEAR_PAGE_END(s2, 8U))
+        {
+            uint64_t w1 = *(const MEM_U64 *)s1;
+            uint64_t w2 = *(const MEM_U64 *)s2;
+            uint64_t stop = MemSwarNonZeroBytes(w1 ^ w2) | MemSwarZeroBytes(w1);
+            if (stop != 0)
+                return MemSwarByteAt(w1, stop) - MemSwarByteAt(w2, stop);
+            s1 += 8;
+            s2 += 8;
+            continue;
+        }
+#endif
+        if (*s1 != *s2 || *s1 == '\0')
+            return (int)*s1 - (int)*s2;
+        s1++;
+        s2++;
     }
-    return (unsigned char)(*a) - (unsigned char)(*b);
 }
@@ -1,10 +1,44 @@
 #include <string.h>
+#include "mem_internal.h"
 
+// Loads are aligned, so none crosses a page. Bytes of the first load that lie before str are ignored.
 size_t
 strlen(const char *str)
 {
-    const char *s = str;
-    while (*s)
-        s++;
-    return s - str;
-}
\ No newline at end of file
+#if defined(__SSE2__)
+    uint64_t offset = (uint64_t)str & 15U;
+    const uint8_t *p = (const uint8_t *)str - offset;
+
+    // x86-64 always has SSE2; only the kernel build keeps its hands off vector registers.
+    uint32_t zeros;
+    __asm__("pxor %%xmm0, %%xmm0\n\t"
+            "pcmpeqb (%1), %%xmm0\n\t"
+            "pmovmskb %%xmm0, %0"
+            : "=r"(zeros)
+            : "r"(p), "m"(*(const char(*)[16])p)
+            : "xmm0");
+    zeros &= ~0U << offset;
+    while (zeros == 0)
+    {
+        p += 16;
+        __asm__("pxor %%xmm0, %%xmm0\n\t"
+                "pcmpeqb (%1), %%xmm0\n\t"
+                "pmovmskb %%xmm0, %0"
+                : "=r"(zeros)
+                : "r"(p), "m"(*(const char(*)[16])p)
+                : "xmm0");
+    }
+    return (size_t)(p - (const uint8_t *)str) + (size_t)__builtin_ctz(zeros);
+#else
+    uint64_t offset = (uint64_t)str & 7U;
+    const uint8_t *p = (const uint8_t *)str - offset;
+
+    uint64_t zeros = MemSwarZeroBytes(*(const MEM_U64 *)p | ((1ULL << (offset * 8U)) - 1U));
+    while (zeros == 0)
+    {
+        p += 8;
+        zeros = MemSwarZeroBytes(*(const MEM_U64 *)p);
+    }
+    return (size_t)(p - (const uint8_t *)str) + (size_t)(__builtin_ctzll(zeros) / 8U);
+#endif
+}
@@ -0,0 +1,72 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: user/deadline_probe/main.c
+ * Description: Deadline-class ABI probe. Drives the SYS_SET_DEADLINE rejection
+ *              and admission paths, runs a short periodic loop on
+ *              SYS_WAIT_PERIOD, and returns the thread to the RR class.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "libsys.h"
+
+#define DEADLINE_PROBE_RUNTIME_US  1000U
+#define DEADLINE_PROBE_PERIOD_US   10000U
+#define DEADLINE_PROBE_DEADLINE_US 5000U
+#define DEADLINE_PROBE_JOBS        20U
+#define DEADLINE_PROBE_WORK_LOOPS  10000U
+
+static const char gKiDeadlineProbeRejects[] = "[DEADLINEPROBE] invalid and overload requests rejected\n";
+static const char gKiDeadlineProbePeriodic[] = "[DEADLINEPROBE] periodic loop ok\n";
+static const char gKiDeadlineProbePassed[] = "[DEADLINEPROBE] deadline probe passed\n";
+
+static void
+KiDeadlineProbeWrite(const char *line, uint64_t length)
+{
+    if (HoUserWriteStdout(line, length) != (int64_t)length)
+        HoUserAbort();
+}
+
+int
+main(void)
+{
+    volatile uint32_t work = 0;
+
+    if (!HoUserCurrentCapabilitySeedBlockIsValid())
+        HoUserAbort();
+
+    // Outside the class there is no period to wait for.
+    if (HoUserWaitPeriod() != -(int64_t)EC_INVALID_STATE)
+        HoUserAbort();
+
+    // Runtime above the deadline, and a request past the admission cap.
+    if (HoUserSetDeadline(DEADLINE_PROBE_DEADLINE_US + 1U, DEADLINE_PROBE_PERIOD_US, DEADLINE_PROBE_DEADLINE_US) !=
+        -(int64_t)EC_ILLEGAL_ARGUMENT)
+    {
+        HoUserAbort();
+    }
+
+    if (HoUserSetDeadline(DEADLINE_PROBE_PERIOD_US, DEADLINE_PROBE_PERIOD_US, 0) != -(int64_t)EC_OUT_OF_RESOURCE)
+        HoUserAbort();
+
+    KiDeadlineProbeWrite(gKiDeadlineProbeRejects, sizeof(gKiDeadlineProbeRejects) - 1U);
+
+    if (HoUserSetDeadline(DEADLINE_PROBE_RUNTIME_US, DEADLINE_PROBE_PERIOD_US, DEADLINE_PROBE_DEADLINE_US) != 0)
+        HoUserAbort();
+
+    for (uint32_t job = 0; job < DEADLINE_PROBE_JOBS; ++job)
+    {
+        for (uint32_t loop = 0; loop < DEADLINE_PROBE_WORK_LOOPS; ++loop)
+            work++;
+
+        if (HoUserWaitPeriod() != 0)
+            HoUserAbort();
+    }
+
+    if (HoUserSetDeadline(0, 0, 0) != 0 || HoUserWaitPeriod() != -(int64_t)EC_INVALID_STATE)
+        HoUserAbort();
+
+    KiDeadlineProbeWrite(gKiDeadlineProbePeriodic, sizeof(gKiDeadlineProbePeriodic) - 1U);
+    KiDeadlineProbeWrite(gKiDeadlineProbePassed, sizeof(gKiDeadlineProbePassed) - 1U);
+    HoUserExit(0);
+}
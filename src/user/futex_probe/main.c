@@ -0,0 +1,100 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: user/futex_probe/main.c
+ * Description: Futex ABI probe. Checks that uncontended libsys mutex and
+ *              condition-variable operations never enter the kernel, then
+ *              drives the SYS_FUTEX_WAIT mismatch, timeout, and rejection
+ *              paths and the SYS_FUTEX_WAKE count.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "libsys.h"
+
+#define FUTEX_PROBE_UNCONTENDED_ROUNDS 1000U
+#define FUTEX_PROBE_TIMEOUT_MS         5U
+
+static const char gKiFutexProbeFastPath[] = "[FUTEXPROBE] uncontended lock made no syscall\n";
+static const char gKiFutexProbeSlowPath[] = "[FUTEXPROBE] wait/wake paths ok\n";
+static const char gKiFutexProbePassed[] = "[FUTEXPROBE] futex probe passed\n";
+
+static void
+KiFutexProbeWrite(const char *line, uint64_t length)
+{
+    if (HoUserWriteStdout(line, length) != (int64_t)length)
+        HoUserAbort();
+}
+
+static void
+KiFutexProbeQuery(EX_SYSINFO_FUTEX_STATS *stats)
+{
+    if (HoUserQuerySysinfoFutexStats(stats) != (int64_t)sizeof(*stats))
+        HoUserAbort();
+}
+
+int
+main(void)
+{
+    EX_SYSINFO_FUTEX_STATS before = {0};
+    EX_SYSINFO_FUTEX_STATS after = {0};
+    HO_USER_MUTEX mutex = HO_USER_MUTEX_INIT;
+    HO_USER_CONDVAR condVar = HO_USER_CONDVAR_INIT;
+    volatile uint32_t word = 1U;
+
+    if (!HoUserCurrentCapabilitySeedBlockIsValid())
+        HoUserAbort();
+
+    // Fast path: no futex syscall may be charged.
+    KiFutexProbeQuery(&before);
+    for (uint32_t round = 0; round < FUTEX_PROBE_UNCONTENDED_ROUNDS; ++round)
+    {
+        HoUserMutexLock(&mutex);
+        HoUserCondVarSignal(&condVar);
+        HoUserMutexUnlock(&mutex);
+        HoUserCondVarBroadcast(&condVar);
+    }
+    KiFutexProbeQuery(&after);
+
+    if (after.WaitCount != before.WaitCount || after.WakeCount != before.WakeCount ||
+        mutex.State != HO_USER_MUTEX_UNLOCKED)
+    {
+        HoUserAbort();
+    }
+    KiFutexProbeWrite(gKiFutexProbeFastPath, sizeof(gKiFutexProbeFastPath) - 1U);
+
+    // Slow paths.
+    before = after;
+
+    if (HoUserFutexWait(&word, 0U, FUTEX_PROBE_TIMEOUT_MS) != -(int64_t)EC_INVALID_STATE)
+        HoUserAbort();
+
+    if (HoUserFutexWait(&word, 1U, FUTEX_PROBE_TIMEOUT_MS) != -(int64_t)EC_TIMEOUT)
+        HoUserAbort();
+
+    if (HoUserFutexWait((volatile uint32_t *)((uint64_t)&word + 1U), 1U, 0) != -(int64_t)EC_ILLEGAL_ARGUMENT)
+        HoUserAbort();
+
+    if (HoUserFutexWake(&word, 1U) != 0)
+        HoUserAbort();
+
+    HoUserMutexLock(&mutex);
+    if (HoUserCondVarTimedWait(&condVar, &mutex, FUTEX_PROBE_TIMEOUT_MS) != -(int64_t)EC_TIMEOUT)
+        HoUserAbort();
+
+    // The timed wait relocks as contended, so this unlock issues one wake.
+    if (mutex.State != HO_USER_MUTEX_CONTENDED || condVar.Waiters != 0)
+        HoUserAbort();
+    HoUserMutexUnlock(&mutex);
+
+    KiFutexProbeQuery(&after);
+    if (after.MismatchCount - before.MismatchCount != 1U || after.TimeoutCount - before.TimeoutCount != 2U ||
+        after.BlockCount - before.BlockCount != 2U || after.WakeCount - before.WakeCount != 2U ||
+        after.WokenCount != before.WokenCount || after.ActiveWaiters != 0)
+    {
+        HoUserAbort();
+    }
+    KiFutexProbeWrite(gKiFutexProbeSlowPath, sizeof(gKiFutexProbeSlowPath) - 1U);
+
+    KiFutexProbeWrite(gKiFutexProbePassed, sizeof(gKiFutexProbePassed) - 1U);
+    HoUserExit(0);
+}
@@ -23,7 +23,8 @@ typedef struct HO_HSH_JOB
     BOOL Alive;
 } HO_HSH_JOB;
 
-static const char gHelpText[] = "help\nsysinfo\nmemmap\nps\nexit\ncalc\nfault_de\nfault_pf\n& tick1s\nkill <pid>\n";
+static const char gHelpText[] =
+    "help\nsysinfo\nmemmap\nps\nexit\ncalc\nfault_de\nfault_pf\nloglevel\n& tick1s\nkill <pid>\n";
 static const char gTick1sName[] = "tick1s";
 static const char gStartedPrefix[] = "[HSH] started pid=";
 static const char gStartedNamePrefix[] = " name=";
@@ -358,39 +359,11 @@ main(void)
             return 0;
         }
 
-        if (HoHshLineEquals(line, (uint64_t)status, "calc"))
+        // Foreground programs are spawned by the name typed, so the line is the program name.
+        if (HoHshLineEquals(line, (uint64_t)status, "calc") || HoHshLineEquals(line, (uint64_t)status, "fault_de") ||
+            HoHshLineEquals(line, (uint64_t)status, "fault_pf") || HoHshLineEquals(line, (uint64_t)status, "loglevel"))
         {
-            int64_t pid = HoUserSpawnProgramLiteral("calc", EX_USER_SPAWN_FLAG_FOREGROUND);
-            if (pid < 0)
-            {
-                HoHshMustWriteLiteral(gSpawnFailed);
-                continue;
-            }
-
-            if (HoUserWaitPid((uint64_t)pid) < 0)
-                HoUserAbort();
-
-            continue;
-        }
-
-        if (HoHshLineEquals(line, (uint64_t)status, "fault_de"))
-        {
-            int64_t pid = HoUserSpawnProgramLiteral("fault_de", EX_USER_SPAWN_FLAG_FOREGROUND);
-            if (pid < 0)
-            {
-                HoHshMustWriteLiteral(gSpawnFailed);
-                continue;
-            }
-
-            if (HoUserWaitPid((uint64_t)pid) < 0)
-                HoUserAbort();
-
-            continue;
-        }
-
-        if (HoHshLineEquals(line, (uint64_t)status, "fault_pf"))
-        {
-            int64_t pid = HoUserSpawnProgramLiteral("fault_pf", EX_USER_SPAWN_FLAG_FOREGROUND);
+            int64_t pid = HoUserSpawnProgram(line, (uint64_t)status, EX_USER_SPAWN_FLAG_FOREGROUND);
             if (pid < 0)
             {
                 HoHshMustWriteLiteral(gSpawnFailed);
@@ -13,6 +13,7 @@
 #include <kernel/ex/user_image_abi.h>
 #include <kernel/ex/user_syscall_abi.h>
 #include <kernel/ex/user_sysinfo_abi.h>
+#include <kernel/ex/user_time_abi.h>
 
 #define HO_USER_STRINGIFY_INNER(value) #value
 #define HO_USER_STRINGIFY(value)       HO_USER_STRINGIFY_INNER(value)
@@ -172,5 +173,238 @@ HoUserQuerySysinfoThreadList(EX_SYSINFO_THREAD_LIST *threadList)
     return HoUserQuerySysinfo(EX_SYSINFO_CLASS_THREAD_LIST, threadList, sizeof(*threadList));
 }
 
+static inline int64_t
+HoUserQuerySysinfoSpawnStats(EX_SYSINFO_SPAWN_STATS *spawnStats)
+{
+    return HoUserQuerySysinfo(EX_SYSINFO_CLASS_SPAWN_STATS, spawnStats, sizeof(*spawnStats));
+}
+
+static inline int64_t
+HoUserQuerySysinfoFutexStats(EX_SYSINFO_FUTEX_STATS *futexStats)
+{
+    return HoUserQuerySysinfo(EX_SYSINFO_CLASS_FUTEX_STATS, futexStats, sizeof(*futexStats));
+}
+
+static inline int64_t
+HoUserFutexWait(volatile uint32_t *address, uint32_t expected, uint64_t timeoutMs)
+{
+    return HoUserSyscall3(EX_USER_SYS_FUTEX_WAIT, (uint64_t)(volatile void *)address, expected, timeoutMs);
+}
+
+static inline int64_t
+HoUserFutexWake(volatile uint32_t *address, uint32_t count)
+{
+    return HoUserSyscall3(EX_USER_SYS_FUTEX_WAKE, (uint64_t)(volatile void *)address, count, 0);
+}
+
+static inline int64_t
+HoUserSetDeadline(uint64_t runtimeUs, uint64_t periodUs, uint64_t deadlineUs)
+{
+    return HoUserSyscall3(EX_USER_SYS_SET_DEADLINE, runtimeUs, periodUs, deadlineUs);
+}
+
+static inline int64_t
+HoUserWaitPeriod(void)
+{
+    return HoUserSyscall3(EX_USER_SYS_WAIT_PERIOD, 0, 0, 0);
+}
+
+static inline int64_t
+HoUserSetTimerSlack(uint64_t slackUs)
+{
+    return HoUserSyscall3(EX_USER_SYS_SET_TIMER_SLACK, slackUs, 0, 0);
+}
+
+static inline int64_t
+HoUserSetLogLevel(const char *spec, uint64_t length)
+{
+    return HoUserSyscall3(EX_USER_SYS_SET_LOG_LEVEL, (uint64_t)(const void *)spec, length, 0);
+}
+
+/*
+ * Uptime through EX_USER_SYS_QUERY_SYSINFO. Returns 0 if the kernel could not
+ * report it.
+ */
+static inline uint64_t
+HoUserNowNsSyscall(void)
+{
+    EX_SYSINFO_OVERVIEW overview;
+
+    if (HoUserQuerySysinfoOverview(&overview) != 0 || (overview.ValidMask & EX_SYSINFO_OVERVIEW_VALID_UPTIME) == 0)
+        return 0;
+    return overview.UptimeNanoseconds;
+}
+
+static inline const volatile EX_USER_TIME_PAGE *
+HoUserTimePage(void)
+{
+    return (const volatile EX_USER_TIME_PAGE *)(uint64_t)EX_USER_TIME_PAGE_BASE;
+}
+
+static inline BOOL
+HoUserTimePageIsFast(void)
+{
+    const volatile EX_USER_TIME_PAGE *page = HoUserTimePage();
+
+    return page->Version == EX_USER_TIME_PAGE_VERSION && (page->Flags & EX_USER_TIME_PAGE_FLAG_TSC) != 0;
+}
+
+/*
+ * Uptime in nanoseconds. Reads the TSC against the kernel-published time page
+ * and stays in user space while the active source is an invariant TSC;
+ * otherwise falls back to the sysinfo syscall.
+ */
+static inline uint64_t
+HoUserNowNs(void)
+{
+    const volatile EX_USER_TIME_PAGE *page = HoUserTimePage();
+
+    for (;;)
+    {
+        uint32_t sequence = __atomic_load_n(&page->Sequence, __ATOMIC_ACQUIRE);
+        if ((sequence & 1U) != 0)
+        {
+            __asm__ volatile("pause");
+            continue;
+        }
+
+        if (page->Version != EX_USER_TIME_PAGE_VERSION || (page->Flags & EX_USER_TIME_PAGE_FLAG_TSC) == 0)
+            break;
+
+        uint64_t mult = page->Mult;
+        uint32_t shift = page->Shift;
+        uint64_t baseTick = page->BaseTick;
+        uint64_t baseNs = page->BaseNs;
+        uint32_t lo;
+        uint32_t hi;
+
+        // lfence keeps rdtsc from executing ahead of the field loads.
+        __asm__ volatile("lfence\n\trdtsc" : "=a"(lo), "=d"(hi) : : "memory");
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&page->Sequence, __ATOMIC_RELAXED) != sequence)
+            continue;
+
+        uint64_t delta = (((uint64_t)hi << 32) | lo) - baseTick;
+        return baseNs + (uint64_t)(((__uint128_t)delta * mult) >> shift);
+    }
+
+    return HoUserNowNsSyscall();
+}
+
+/*
+ * Futex-backed mutex. State: 0 unlocked, 1 locked, 2 locked with possible
+ * waiters. Lock and unlock stay in user space unless the state reaches 2.
+ */
+#define HO_USER_MUTEX_UNLOCKED  0U
+#define HO_USER_MUTEX_LOCKED    1U
+#define HO_USER_MUTEX_CONTENDED 2U
+
+typedef struct HO_USER_MUTEX
+{
+    volatile uint32_t State;
+} HO_USER_MUTEX;
+
+#define HO_USER_MUTEX_INIT {HO_USER_MUTEX_UNLOCKED}
+
+static inline void
+HoUserMutexInit(HO_USER_MUTEX *mutex)
+{
+    __atomic_store_n(&mutex->State, HO_USER_MUTEX_UNLOCKED, __ATOMIC_RELEASE);
+}
+
+static inline BOOL
+HoUserMutexTryLock(HO_USER_MUTEX *mutex)
+{
+    uint32_t expected = HO_USER_MUTEX_UNLOCKED;
+
+    return __atomic_compare_exchange_n(&mutex->State, &expected, HO_USER_MUTEX_LOCKED, FALSE, __ATOMIC_ACQUIRE,
+                                       __ATOMIC_RELAXED);
+}
+
+// Slow path: advertise a waiter and sleep until the holder hands the lock back.
+static inline void
+HoUserMutexLockContended(HO_USER_MUTEX *mutex)
+{
+    while (__atomic_exchange_n(&mutex->State, HO_USER_MUTEX_CONTENDED, __ATOMIC_ACQUIRE) != HO_USER_MUTEX_UNLOCKED)
+        (void)HoUserFutexWait(&mutex->State, HO_USER_MUTEX_CONTENDED, EX_USER_FUTEX_TIMEOUT_INFINITE);
+}
+
+static inline void
+HoUserMutexLock(HO_USER_MUTEX *mutex)
+{
+    if (!HoUserMutexTryLock(mutex))
+        HoUserMutexLockContended(mutex);
+}
+
+static inline void
+HoUserMutexUnlock(HO_USER_MUTEX *mutex)
+{
+    if (__atomic_exchange_n(&mutex->State, HO_USER_MUTEX_UNLOCKED, __ATOMIC_RELEASE) == HO_USER_MUTEX_CONTENDED)
+        (void)HoUserFutexWake(&mutex->State, 1U);
+}
+
+/*
+ * Condition variable over a wake sequence word. Signal and broadcast only
+ * enter the kernel when a waiter is registered.
+ */
+typedef struct HO_USER_CONDVAR
+{
+    volatile uint32_t Sequence;
+    volatile uint32_t Waiters;
+} HO_USER_CONDVAR;
+
+#define HO_USER_CONDVAR_INIT {0U, 0U}
+
+static inline void
+HoUserCondVarInit(HO_USER_CONDVAR *condVar)
+{
+    __atomic_store_n(&condVar->Sequence, 0U, __ATOMIC_RELAXED);
+    __atomic_store_n(&condVar->Waiters, 0U, __ATOMIC_RELEASE);
+}
+
+/*
+ * Releases mutex, waits for a signal or timeoutMs, and reacquires mutex before
+ * returning. Returns 0 when signaled (or on a spurious wake) and
+ * -EC_TIMEOUT when the timeout elapsed; callers recheck their predicate.
+ */
+static inline int64_t
+HoUserCondVarTimedWait(HO_USER_CONDVAR *condVar, HO_USER_MUTEX *mutex, uint64_t timeoutMs)
+{
+    __atomic_add_fetch(&condVar->Waiters, 1U, __ATOMIC_SEQ_CST);
+    uint32_t sequence = __atomic_load_n(&condVar->Sequence, __ATOMIC_SEQ_CST);
+
+    HoUserMutexUnlock(mutex);
+    int64_t status = HoUserFutexWait(&condVar->Sequence, sequence, timeoutMs);
+
+    // Another waiter may still be parked on the mutex, so relock as contended.
+    HoUserMutexLockContended(mutex);
+    __atomic_sub_fetch(&condVar->Waiters, 1U, __ATOMIC_SEQ_CST);
+
+    return status == -(int64_t)EC_TIMEOUT ? status : 0;
+}
+
+static inline void
+HoUserCondVarWait(HO_USER_CONDVAR *condVar, HO_USER_MUTEX *mutex)
+{
+    (void)HoUserCondVarTimedWait(condVar, mutex, EX_USER_FUTEX_TIMEOUT_INFINITE);
+}
+
+static inline void
+HoUserCondVarSignal(HO_USER_CONDVAR *condVar)
+{
+    __atomic_add_fetch(&condVar->Sequence, 1U, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&condVar->Waiters, __ATOMIC_SEQ_CST) != 0)
+        (void)HoUserFutexWake(&condVar->Sequence, 1U);
+}
+
+static inline void
+HoUserCondVarBroadcast(HO_USER_CONDVAR *condVar)
+{
+    __atomic_add_fetch(&condVar->Sequence, 1U, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&condVar->Waiters, __ATOMIC_SEQ_CST) != 0)
+        (void)HoUserFutexWake(&condVar->Sequence, (uint32_t)EX_USER_FUTEX_WAKE_ALL);
+}
+
 #undef HO_USER_STRINGIFY
 #undef HO_USER_STRINGIFY_INNER
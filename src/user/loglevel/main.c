@@ -0,0 +1,66 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: user/loglevel/main.c
+ * Description: Runtime klog level control spawned by the hsh "loglevel" command.
+ *              Prints the current levels, then forwards each entered spec to the
+ *              kernel, which parses and validates it. An empty line exits.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "libsys.h"
+
+static const char gLogLevelPrompt[] = "loglevel> ";
+static const char gLogLevelQueryFailed[] = "[LOGLEVEL] query failed\n";
+static const char gLogLevelRejected[] = "[LOGLEVEL] spec rejected\n";
+
+static void
+HoLogLevelMustWrite(const char *buffer, uint64_t length)
+{
+    if (HoUserWriteStdout(buffer, length) != (int64_t)length)
+        HoUserAbort();
+}
+
+static void
+HoLogLevelWriteLevels(void)
+{
+    char levelsText[EX_SYSINFO_TEXT_MAX_LENGTH];
+    int64_t levelsLength = HoUserQuerySysinfo(EX_SYSINFO_CLASS_LOG_LEVELS_TEXT, levelsText, sizeof(levelsText));
+
+    if (levelsLength < 0)
+    {
+        HoLogLevelMustWrite(gLogLevelQueryFailed, sizeof(gLogLevelQueryFailed) - 1U);
+        return;
+    }
+
+    HoLogLevelMustWrite(levelsText, (uint64_t)levelsLength);
+}
+
+int
+main(void)
+{
+    char line[EX_USER_READLINE_MAX_LENGTH];
+
+    HoLogLevelWriteLevels();
+
+    for (;;)
+    {
+        HoLogLevelMustWrite(gLogLevelPrompt, sizeof(gLogLevelPrompt) - 1U);
+
+        int64_t status = HoUserReadLine(line, sizeof(line));
+        if (status == -(int64_t)EC_INVALID_STATE)
+            continue;
+        if (status < 0)
+            HoUserAbort();
+        if (status == 0)
+            HoUserExit(0);
+
+        if (HoUserSetLogLevel(line, (uint64_t)status) < 0)
+        {
+            HoLogLevelMustWrite(gLogLevelRejected, sizeof(gLogLevelRejected) - 1U);
+            continue;
+        }
+
+        HoLogLevelWriteLevels();
+    }
+}
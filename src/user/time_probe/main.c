@@ -0,0 +1,109 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: user/time_probe/main.c
+ * Description: User time page probe. Checks that HoUserNowNs() is monotonic,
+ *              agrees with the sysinfo uptime it replaces, tracks a sleep, and
+ *              that the fast path is cheaper than the syscall when the kernel
+ *              advertises an invariant TSC.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "libsys.h"
+
+#define TIME_PROBE_MONOTONIC_READS 1000U
+#define TIME_PROBE_COST_ROUNDS     64U
+#define TIME_PROBE_SLEEP_MS        10U
+#define TIME_PROBE_SKEW_NS         1000ULL // Slack for conversion rounding between the two paths
+
+static const char gKiTimeProbeFast[] = "[TIMEPROBE] mode=tsc fast path\n";
+static const char gKiTimeProbeFallback[] = "[TIMEPROBE] mode=syscall fallback\n";
+static const char gKiTimeProbeMonotonic[] = "[TIMEPROBE] monotonic and consistent with sysinfo\n";
+static const char gKiTimeProbeCheaper[] = "[TIMEPROBE] fast path cheaper than syscall\n";
+static const char gKiTimeProbePassed[] = "[TIMEPROBE] time probe passed\n";
+
+static void
+KiTimeProbeWrite(const char *line, uint64_t length)
+{
+    if (HoUserWriteStdout(line, length) != (int64_t)length)
+        HoUserAbort();
+}
+
+static uint64_t
+KiTimeProbeReadTsc(void)
+{
+    uint32_t lo;
+    uint32_t hi;
+
+    __asm__ volatile("lfence\n\trdtsc" : "=a"(lo), "=d"(hi) : : "memory");
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static void
+KiTimeProbeCheckConsistency(void)
+{
+    uint64_t previous = HoUserNowNs();
+
+    for (uint32_t index = 0; index < TIME_PROBE_MONOTONIC_READS; ++index)
+    {
+        uint64_t now = HoUserNowNs();
+        if (now < previous)
+            HoUserAbort();
+        previous = now;
+    }
+
+    // The page read must land between the two syscall reads.
+    uint64_t before = HoUserNowNsSyscall();
+    uint64_t now = HoUserNowNs();
+    uint64_t after = HoUserNowNsSyscall();
+    if (before == 0 || now + TIME_PROBE_SKEW_NS < before || now > after + TIME_PROBE_SKEW_NS)
+        HoUserAbort();
+
+    uint64_t sleepStart = HoUserNowNs();
+    if (HoUserSleepMs(TIME_PROBE_SLEEP_MS) != 0)
+        HoUserAbort();
+    if (HoUserNowNs() - sleepStart < (uint64_t)TIME_PROBE_SLEEP_MS * 1000000ULL)
+        HoUserAbort();
+}
+
+static void
+KiTimeProbeCheckCost(void)
+{
+    uint64_t start = KiTimeProbeReadTsc();
+    for (uint32_t index = 0; index < TIME_PROBE_COST_ROUNDS; ++index)
+        (void)HoUserNowNs();
+    uint64_t fastCycles = KiTimeProbeReadTsc() - start;
+
+    start = KiTimeProbeReadTsc();
+    for (uint32_t index = 0; index < TIME_PROBE_COST_ROUNDS; ++index)
+        (void)HoUserNowNsSyscall();
+    uint64_t syscallCycles = KiTimeProbeReadTsc() - start;
+
+    if (fastCycles >= syscallCycles)
+        HoUserAbort();
+}
+
+int
+main(void)
+{
+    if (!HoUserCurrentCapabilitySeedBlockIsValid())
+        HoUserAbort();
+
+    BOOL fast = HoUserTimePageIsFast();
+    if (fast)
+        KiTimeProbeWrite(gKiTimeProbeFast, sizeof(gKiTimeProbeFast) - 1U);
+    else
+        KiTimeProbeWrite(gKiTimeProbeFallback, sizeof(gKiTimeProbeFallback) - 1U);
+
+    KiTimeProbeCheckConsistency();
+    KiTimeProbeWrite(gKiTimeProbeMonotonic, sizeof(gKiTimeProbeMonotonic) - 1U);
+
+    if (fast)
+    {
+        KiTimeProbeCheckCost();
+        KiTimeProbeWrite(gKiTimeProbeCheaper, sizeof(gKiTimeProbeCheaper) - 1U);
+    }
+
+    KiTimeProbeWrite(gKiTimeProbePassed, sizeof(gKiTimeProbePassed) - 1U);
+    HoUserExit(0);
+}
@@ -0,0 +1,57 @@
+/**
+ * HimuOperatingSystem
+ *
+ * File: user/timer_slack_probe/main.c
+ * Description: Timer slack ABI probe. Drives the SYS_SET_TIMER_SLACK rejection
+ *              path, sleeps with an explicit and an exact slack, and restores
+ *              the kernel default.
+ * Copyright(c) 2024-2026 HimuOS, ONLY FOR EDUCATIONAL PURPOSES.
+ */
+
+#include "libsys.h"
+
+#define TIMER_SLACK_PROBE_SLACK_US 2000U
+#define TIMER_SLACK_PROBE_SLEEP_MS 5U
+#define TIMER_SLACK_PROBE_ROUNDS   4U
+
+static const char gKiTimerSlackProbeRejects[] = "[TIMERSLACKPROBE] invalid slack rejected\n";
+static const char gKiTimerSlackProbeSleeps[] = "[TIMERSLACKPROBE] slack sleeps ok\n";
+static const char gKiTimerSlackProbePassed[] = "[TIMERSLACKPROBE] timer slack probe passed\n";
+
+static void
+KiTimerSlackProbeWrite(const char *line, uint64_t length)
+{
+    if (HoUserWriteStdout(line, length) != (int64_t)length)
+        HoUserAbort();
+}
+
+int
+main(void)
+{
+    if (!HoUserCurrentCapabilitySeedBlockIsValid())
+        HoUserAbort();
+
+    if (HoUserSetTimerSlack(EX_USER_TIMER_SLACK_MAX_US + 1U) != -(int64_t)EC_ILLEGAL_ARGUMENT)
+        HoUserAbort();
+
+    KiTimerSlackProbeWrite(gKiTimerSlackProbeRejects, sizeof(gKiTimerSlackProbeRejects) - 1U);
+
+    if (HoUserSetTimerSlack(TIMER_SLACK_PROBE_SLACK_US) != 0)
+        HoUserAbort();
+
+    for (uint32_t round = 0; round < TIMER_SLACK_PROBE_ROUNDS; ++round)
+    {
+        if (HoUserSleepMs(TIMER_SLACK_PROBE_SLEEP_MS) != 0)
+            HoUserAbort();
+    }
+
+    if (HoUserSetTimerSlack(0) != 0 || HoUserSleepMs(TIMER_SLACK_PROBE_SLEEP_MS) != 0)
+        HoUserAbort();
+
+    if (HoUserSetTimerSlack(EX_USER_TIMER_SLACK_DEFAULT) != 0)
+        HoUserAbort();
+
+    KiTimerSlackProbeWrite(gKiTimerSlackProbeSleeps, sizeof(gKiTimerSlackProbeSleeps) - 1U);
+    KiTimerSlackProbeWrite(gKiTimerSlackProbePassed, sizeof(gKiTimerSlackProbePassed) - 1U);
+    HoUserExit(0);
+}